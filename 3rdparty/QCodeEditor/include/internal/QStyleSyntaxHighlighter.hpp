@@ -2,6 +2,13 @@
 
 // Qt
 #include <QSyntaxHighlighter> // Required for inheritance
+#include <QElapsedTimer>
+#include <QPair>
+#include <QTextCursor>
+#include <QTimer>
+
+// STL
+#include <functional>
 
 class QSyntaxStyle;
 
@@ -35,7 +42,46 @@ public:
      */
     QSyntaxStyle* syntaxStyle() const;
 
+    /**
+     * @brief Provider of the range of block numbers (first, last)
+     * currently visible in the editor's viewport. When set, visible
+     * blocks are never deferred by the highlighting time budget.
+     */
+    void setVisibleRangeProvider(std::function<QPair<int, int>()> provider);
+
+protected:
+
+    /**
+     * @brief Must be called at the top of highlightBlock() by subclasses
+     * that opt into budgeted highlighting. Each synchronous highlighting
+     * pass (a document change, a rehighlight() after a style change...)
+     * may only lex for a few milliseconds; blocks beyond that budget are
+     * queued and finished by an idle timer, one slice at a time, so that
+     * pasting a large script never freezes the editor.
+     * @return false if the block was deferred and must not be lexed now.
+     */
+    bool beginBlockHighlight();
+
 private:
+
+    void deferBlock(const QTextBlock& block);
+
+    void processDeferred();
+
     QSyntaxStyle* m_syntaxStyle;
+
+    std::function<QPair<int, int>()> m_visibleRangeProvider;
+
+    // budget of the synchronous pass currently in flight
+    bool m_passActive = false;
+    QElapsedTimer m_passTimer;
+    bool m_visibleCacheValid = false;
+    QPair<int, int> m_visibleCache;
+
+    // blocks whose highlighting was deferred; cursors track document
+    // edits, so the range stays valid while the idle pass catches up
+    QTextCursor m_deferredStart;
+    QTextCursor m_deferredEnd;
+    QTimer m_idleTimer;
 };
 
@@ -109,6 +109,14 @@ void QCodeEditor::setHighlighter(QStyleSyntaxHighlighter* highlighter)
     {
         m_highlighter->setSyntaxStyle(m_syntaxStyle);
         m_highlighter->setDocument(document());
+
+        // lets budgeted highlighters keep the blocks in the viewport
+        // highlighted synchronously while offscreen text is deferred
+        m_highlighter->setVisibleRangeProvider([this]() {
+            const int first = getFirstVisibleBlock();
+            const int lines = viewport()->height() / fontMetrics().height() + 1;
+            return QPair<int, int>(first, first + lines);
+        });
     }
 }
 
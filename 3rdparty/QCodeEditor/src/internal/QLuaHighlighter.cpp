@@ -84,6 +84,13 @@ QLuaHighlighter::QLuaHighlighter(QTextDocument* document) :
 
 void QLuaHighlighter::highlightBlock(const QString& text)
 {
+    if (!beginBlockHighlight())
+    {
+        // over the time budget of this pass: the block was queued and
+        // will be lexed by the idle pass instead
+        return;
+    }
+
     { // Checking for require
         auto matchIterator = m_requirePattern.globalMatch(text);
 
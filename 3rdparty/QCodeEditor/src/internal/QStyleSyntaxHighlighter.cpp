@@ -1,11 +1,23 @@
 // QCodeEditor
 #include <QStyleSyntaxHighlighter>
 
-QStyleSyntaxHighlighter::QStyleSyntaxHighlighter(QTextDocument* document) : 
+// Qt
+#include <QTextBlock>
+#include <QTextDocument>
+
+namespace
+{
+// how long a single synchronous highlighting pass may lex before the
+// remaining blocks are handed over to the idle timer
+constexpr int SYNC_BUDGET_MS = 5;
+}
+
+QStyleSyntaxHighlighter::QStyleSyntaxHighlighter(QTextDocument* document) :
     QSyntaxHighlighter(document),
     m_syntaxStyle(nullptr)
 {
-
+    m_idleTimer.setInterval(0);
+    connect(&m_idleTimer, &QTimer::timeout, this, &QStyleSyntaxHighlighter::processDeferred);
 }
 
 void QStyleSyntaxHighlighter::setSyntaxStyle(QSyntaxStyle* style)
@@ -17,3 +29,120 @@ QSyntaxStyle* QStyleSyntaxHighlighter::syntaxStyle() const
 {
     return m_syntaxStyle;
 }
+
+void QStyleSyntaxHighlighter::setVisibleRangeProvider(std::function<QPair<int, int>()> provider)
+{
+    m_visibleRangeProvider = std::move(provider);
+}
+
+bool QStyleSyntaxHighlighter::beginBlockHighlight()
+{
+    if (!m_passActive)
+    {
+        // first block of a new synchronous pass: arm the budget and let a
+        // zero-timer mark the end of the pass once control returns to the
+        // event loop
+        m_passActive = true;
+        m_visibleCacheValid = false;
+        m_passTimer.start();
+        QTimer::singleShot(0, this, [this]() { m_passActive = false; });
+    }
+
+    if (m_passTimer.elapsed() < SYNC_BUDGET_MS)
+    {
+        return true;
+    }
+
+    // over budget: still lex what the user can actually see
+    if (m_visibleRangeProvider)
+    {
+        if (!m_visibleCacheValid)
+        {
+            // the provider may be costly, query it once per pass
+            m_visibleCache = m_visibleRangeProvider();
+            m_visibleCacheValid = true;
+        }
+
+        const int number = currentBlock().blockNumber();
+        if (number >= m_visibleCache.first && number <= m_visibleCache.second)
+        {
+            return true;
+        }
+    }
+
+    deferBlock(currentBlock());
+    return false;
+}
+
+void QStyleSyntaxHighlighter::deferBlock(const QTextBlock& block)
+{
+    auto doc = document();
+    const int begin = block.position();
+    const int end = qMin(begin + block.length(), doc->characterCount() - 1);
+
+    if (m_deferredStart.isNull() || m_deferredStart.document() != doc)
+    {
+        m_deferredStart = QTextCursor(doc);
+        m_deferredStart.setPosition(begin);
+        m_deferredEnd = QTextCursor(doc);
+        m_deferredEnd.setPosition(end);
+    }
+    else
+    {
+        if (begin < m_deferredStart.position())
+        {
+            m_deferredStart.setPosition(begin);
+        }
+        if (end > m_deferredEnd.position())
+        {
+            m_deferredEnd.setPosition(end);
+        }
+    }
+
+    if (!m_idleTimer.isActive())
+    {
+        m_idleTimer.start();
+    }
+}
+
+void QStyleSyntaxHighlighter::processDeferred()
+{
+    auto doc = document();
+
+    if (!doc ||
+        m_deferredStart.isNull() ||
+        m_deferredStart.document() != doc ||
+        m_deferredStart.position() >= m_deferredEnd.position())
+    {
+        m_idleTimer.stop();
+        m_deferredStart = QTextCursor();
+        m_deferredEnd = QTextCursor();
+        return;
+    }
+
+    // each rehighlightBlock() below re-enters beginBlockHighlight(), so
+    // the slice is bounded by the same budget; whatever does not fit is
+    // re-deferred and picked up on the next tick
+    QTextBlock block = doc->findBlock(m_deferredStart.position());
+
+    while (block.isValid() && block.position() < m_deferredEnd.position())
+    {
+        if (m_passActive && m_passTimer.elapsed() >= SYNC_BUDGET_MS)
+        {
+            break;
+        }
+        rehighlightBlock(block);
+        block = block.next();
+    }
+
+    if (block.isValid() && block.position() < m_deferredEnd.position())
+    {
+        m_deferredStart.setPosition(block.position());
+    }
+    else
+    {
+        m_idleTimer.stop();
+        m_deferredStart = QTextCursor();
+        m_deferredEnd = QTextCursor();
+    }
+}
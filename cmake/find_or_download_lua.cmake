@@ -1,5 +1,19 @@
 function(find_or_download_lua)
 
+  if(USE_LUAJIT)
+    # LuaJIT exposes the same C API (5.1 level, which sol2 supports), so
+    # the only difference is which runtime we link. We never download it:
+    # the JIT engine is an explicit opt-in on the machines that have it.
+    find_package(PkgConfig REQUIRED)
+    pkg_check_modules(LUAJIT REQUIRED IMPORTED_TARGET luajit)
+    message(STATUS "Using LuaJIT ${LUAJIT_VERSION} as the Lua engine")
+
+    add_library(lua::lua INTERFACE IMPORTED)
+    set_target_properties(lua::lua PROPERTIES INTERFACE_LINK_LIBRARIES
+                                              PkgConfig::LUAJIT)
+    return()
+  endif()
+
   find_package(Lua QUIET)
 
   if(LUA_FOUND)
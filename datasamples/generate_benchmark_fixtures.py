@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""Generate synthetic datafiles for the headless load-time benchmark:
+
+    plotjuggler -n --benchmark <fixture>
+
+Formats:
+
+    csv      plain CSV, no dependencies
+    ulog     minimal PX4 ULog, no dependencies
+    mcap     MCAP with JSON-encoded messages (requires: pip install mcap)
+    capture  PJCAPTURE message capture with JSON payloads, for the parser
+             benchmark (plotjuggler -n --benchmark_parser <fixture>)
+
+Examples:
+
+    ./generate_benchmark_fixtures.py csv  --rows 1000000 --columns 20 -o bench_1M.csv
+    ./generate_benchmark_fixtures.py ulog --rows 500000  --columns 8  -o bench.ulg
+    ./generate_benchmark_fixtures.py mcap --rows 200000  --topics 10  -o bench.mcap
+    ./generate_benchmark_fixtures.py capture --messages 200000 --fields 10 -o bench.pjcap
+
+The PJCAPTURE layout (version 1) is a text header - magic line, then
+"key: value" lines with encoding, topic, type and schema_size, then an
+empty line - followed by schema_size bytes of schema and the serialized
+messages back to back, each prefixed by its byte size as a little-endian
+uint32. Captures of other encodings (protobuf, ros1msg, ...) follow the
+same layout, with the matching schema blob and raw message bytes.
+
+The generators are deterministic (fixed seed), so two checkouts produce
+byte-identical fixtures and the timings are comparable.
+"""
+
+import argparse
+import math
+import random
+import struct
+import sys
+
+
+def sample_value(channel, row):
+    return math.sin(0.001 * row + channel) * 100.0 + random.uniform(-1.0, 1.0)
+
+
+def generate_csv(args):
+    random.seed(42)
+    dt = 0.001
+    with open(args.output, "w") as f:
+        header = ["timestamp"] + [f"channel_{c:02d}" for c in range(args.columns)]
+        f.write(",".join(header) + "\n")
+        for row in range(args.rows):
+            values = [f"{row * dt:.6f}"]
+            values += [f"{sample_value(c, row):.4f}" for c in range(args.columns)]
+            f.write(",".join(values) + "\n")
+    print(f"written {args.output}: {args.rows} rows x {args.columns} columns")
+
+
+def generate_ulog(args):
+    """Minimal ULog file: one message format with N float fields, logged at
+    1 kHz. Layout per the PX4 ULog specification (file header, flag bits,
+    format definition, subscription, data messages)."""
+    random.seed(42)
+
+    def message(msg_type, payload):
+        return struct.pack("<HB", len(payload), msg_type) + payload
+
+    with open(args.output, "wb") as f:
+        # file header: magic, version, timestamp
+        f.write(b"\x55\x4c\x6f\x67\x01\x12\x35" + bytes([1]) + struct.pack("<Q", 0))
+
+        # 'B': flag bitset (all zero: no appended data, no incompat flags)
+        f.write(message(ord("B"), bytes(8 + 8 + 3 * 8)))
+
+        # 'F': format definition
+        fields = "uint64_t timestamp;" + "".join(
+            f"float value_{c:02d};" for c in range(args.columns))
+        f.write(message(ord("F"), f"bench_data:{fields}".encode()))
+
+        # 'A': subscribe msg_id 0 to the format
+        f.write(message(ord("A"), struct.pack("<BH", 0, 0) + b"bench_data"))
+
+        # 'D': data messages (msg_id, then the fields of the format)
+        pack = struct.Struct("<HQ" + "f" * args.columns)
+        for row in range(args.rows):
+            timestamp_us = row * 1000
+            values = [sample_value(c, row) for c in range(args.columns)]
+            f.write(message(ord("D"), pack.pack(0, timestamp_us, *values)))
+    print(f"written {args.output}: {args.rows} rows x {args.columns} fields")
+
+
+def generate_mcap(args):
+    try:
+        from mcap.writer import Writer
+    except ImportError:
+        print("the 'mcap' python package is required: pip install mcap", file=sys.stderr)
+        return 1
+
+    import json
+
+    random.seed(42)
+    with open(args.output, "wb") as f:
+        writer = Writer(f)
+        writer.start()
+        schema_id = writer.register_schema(
+            name="bench_data",
+            encoding="jsonschema",
+            data=json.dumps({
+                "type": "object",
+                "properties": {
+                    "timestamp": {"type": "number"},
+                    "value": {"type": "number"},
+                },
+            }).encode())
+        channel_ids = [
+            writer.register_channel(
+                schema_id=schema_id,
+                topic=f"/bench/topic_{t:02d}",
+                message_encoding="json")
+            for t in range(args.topics)
+        ]
+        for row in range(args.rows):
+            timestamp_ns = row * 1000000
+            for t, channel_id in enumerate(channel_ids):
+                payload = json.dumps({
+                    "timestamp": row * 0.001,
+                    "value": sample_value(t, row),
+                }).encode()
+                writer.add_message(
+                    channel_id=channel_id,
+                    log_time=timestamp_ns,
+                    publish_time=timestamp_ns,
+                    data=payload)
+        writer.finish()
+    print(f"written {args.output}: {args.rows} rows x {args.topics} topics")
+    return 0
+
+
+def generate_capture(args):
+    """PJCAPTURE file with JSON payloads: flat objects with N numeric
+    fields plus a nested pose, roughly the shape of a telemetry packet."""
+    import json
+
+    random.seed(42)
+    total_bytes = 0
+    with open(args.output, "wb") as f:
+        header = (
+            "PJCAPTURE 1\n"
+            "encoding: json\n"
+            "topic: /bench/telemetry\n"
+            "type: bench_telemetry\n"
+            "schema_size: 0\n"
+            "\n"
+        )
+        f.write(header.encode())
+        for row in range(args.messages):
+            payload = {
+                "timestamp": row * 0.001,
+                "pose": {
+                    "x": sample_value(0, row),
+                    "y": sample_value(1, row),
+                    "yaw": sample_value(2, row) * 0.01,
+                },
+            }
+            for c in range(args.fields):
+                payload[f"value_{c:02d}"] = sample_value(3 + c, row)
+            data = json.dumps(payload).encode()
+            f.write(struct.pack("<I", len(data)) + data)
+            total_bytes += len(data)
+    print(f"written {args.output}: {args.messages} messages, {total_bytes} payload bytes")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="format", required=True)
+
+    csv_p = sub.add_parser("csv", help="plain CSV file")
+    csv_p.add_argument("--rows", type=int, default=1000000)
+    csv_p.add_argument("--columns", type=int, default=20)
+    csv_p.add_argument("-o", "--output", default="bench.csv")
+    csv_p.set_defaults(func=generate_csv)
+
+    ulog_p = sub.add_parser("ulog", help="minimal PX4 ULog file")
+    ulog_p.add_argument("--rows", type=int, default=500000)
+    ulog_p.add_argument("--columns", type=int, default=8)
+    ulog_p.add_argument("-o", "--output", default="bench.ulg")
+    ulog_p.set_defaults(func=generate_ulog)
+
+    mcap_p = sub.add_parser("mcap", help="MCAP with JSON messages (needs 'mcap' package)")
+    mcap_p.add_argument("--rows", type=int, default=200000)
+    mcap_p.add_argument("--topics", type=int, default=10)
+    mcap_p.add_argument("-o", "--output", default="bench.mcap")
+    mcap_p.set_defaults(func=generate_mcap)
+
+    capture_p = sub.add_parser("capture",
+                               help="PJCAPTURE with JSON payloads for --benchmark_parser")
+    capture_p.add_argument("--messages", type=int, default=200000)
+    capture_p.add_argument("--fields", type=int, default=10)
+    capture_p.add_argument("-o", "--output", default="bench.pjcap")
+    capture_p.set_defaults(func=generate_capture)
+
+    args = parser.parse_args()
+    return args.func(args) or 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
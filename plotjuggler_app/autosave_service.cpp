@@ -0,0 +1,319 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "autosave_service.h"
+
+#include <QDir>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QtConcurrent/QtConcurrent>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "PlotJuggler/session_dump.h"
+
+using namespace PJ;
+
+// past this many delta files the worker compacts them into one dump,
+// even when the disk budget is not exceeded yet
+static constexpr int kMaxDeltaFiles = 16;
+
+static QString SequenceFileName(const QDir& dir, int sequence)
+{
+  return dir.filePath(QString("data_%1.pjdata").arg(sequence, 3, 10, QLatin1Char('0')));
+}
+
+// Worker-thread side of a checkpoint: write the delta and the layout,
+// then compact the directory if it outgrew the budget. Returns the next
+// sequence number, or -1 on failure (the caller will retry the same
+// samples at the next tick).
+static int WriteCheckpoint(const PlotDataMapRef& delta, bool write_data,
+                           const QByteArray& layout, const QString& dir_path, int sequence,
+                           qint64 max_disk_bytes)
+{
+  QDir dir(dir_path);
+  if (!dir.exists() && !dir.mkpath("."))
+  {
+    return -1;
+  }
+
+  if (write_data)
+  {
+    const QString final_name = SequenceFileName(dir, sequence);
+    const QString temp_name = final_name + ".tmp";
+    // temp file + rename: a crash mid-write never leaves a torn dump
+    if (!SaveSessionDump(delta, temp_name))
+    {
+      QFile::remove(temp_name);
+      return -1;
+    }
+    QFile::remove(final_name);
+    if (!QFile::rename(temp_name, final_name))
+    {
+      QFile::remove(temp_name);
+      return -1;
+    }
+    sequence++;
+  }
+
+  QSaveFile layout_file(dir.filePath("layout.xml"));
+  if (!layout_file.open(QIODevice::WriteOnly))
+  {
+    return -1;
+  }
+  layout_file.write(layout);
+  if (!layout_file.commit())
+  {
+    return -1;
+  }
+
+  // --- bounded disk usage: compact the deltas on disk ---
+  const QStringList data_files = dir.entryList({ "data_*.pjdata" }, QDir::Files, QDir::Name);
+  qint64 total_bytes = 0;
+  for (const QString& name : data_files)
+  {
+    total_bytes += QFileInfo(dir.filePath(name)).size();
+  }
+  if (data_files.size() > kMaxDeltaFiles || total_bytes > max_disk_bytes)
+  {
+    // merge the dumps already written, the live data is not touched
+    PlotDataMapRef merged;
+    bool merged_ok = QFile::exists(dir.filePath("compacted.pjdata")) ?
+                         LoadSessionDump(dir.filePath("compacted.pjdata"), merged) :
+                         true;
+    for (const QString& name : data_files)
+    {
+      merged_ok = merged_ok && LoadSessionDump(dir.filePath(name), merged);
+    }
+    // "compacted.pjdata" loads before the data_* files at recovery, so
+    // every intermediate state of this sequence stays recoverable
+    if (merged_ok && SaveSessionDump(merged, dir.filePath("compacted.tmp")))
+    {
+      QFile::remove(dir.filePath("compacted.pjdata"));
+      if (QFile::rename(dir.filePath("compacted.tmp"), dir.filePath("compacted.pjdata")))
+      {
+        for (const QString& name : data_files)
+        {
+          QFile::remove(dir.filePath(name));
+        }
+        sequence = 0;
+      }
+    }
+    QFile::remove(dir.filePath("compacted.tmp"));
+  }
+  return sequence;
+}
+
+AutosaveService::AutosaveService(QObject* parent) : QObject(parent)
+{
+  connect(&_timer, &QTimer::timeout, this, &AutosaveService::checkpointRequested);
+  connect(&_write_watcher, &QFutureWatcher<int>::finished, this,
+          &AutosaveService::onWriteFinished);
+}
+
+AutosaveService::~AutosaveService()
+{
+  _write_watcher.waitForFinished();
+}
+
+QString AutosaveService::checkpointDirectory()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/autosave";
+}
+
+bool AutosaveService::hasRecoverableSession()
+{
+  QDir dir(checkpointDirectory());
+  return dir.exists() &&
+         !dir.entryList({ "data_*.pjdata", "compacted.pjdata" }, QDir::Files).isEmpty();
+}
+
+bool AutosaveService::replayCheckpoints(const QString& dir_path, PlotDataMapRef& destination)
+{
+  QDir dir(dir_path);
+
+  QStringList data_files = dir.entryList({ "data_*.pjdata" }, QDir::Files, QDir::Name);
+  if (QFile::exists(dir.filePath("compacted.pjdata")))
+  {
+    data_files.prepend("compacted.pjdata");
+  }
+  bool loaded_any = false;
+  for (const QString& name : data_files)
+  {
+    // each dump appends to the series of the previous ones
+    loaded_any |= LoadSessionDump(dir.filePath(name), destination);
+  }
+  return loaded_any;
+}
+
+QByteArray AutosaveService::recoverSession(PlotDataMapRef& destination)
+{
+  QDir dir(checkpointDirectory());
+  replayCheckpoints(checkpointDirectory(), destination);
+
+  QFile layout_file(dir.filePath("layout.xml"));
+  if (!layout_file.open(QIODevice::ReadOnly))
+  {
+    return {};
+  }
+  return layout_file.readAll();
+}
+
+void AutosaveService::start()
+{
+  QSettings settings;
+  const int interval_sec = settings.value("MainWindow.autosaveInterval", 120).toInt();
+  _max_disk_bytes = settings.value("MainWindow.autosaveMaxMB", 512).toLongLong() * 1024 * 1024;
+  if (interval_sec <= 0)
+  {
+    return;
+  }
+  _enabled = true;
+  _timer.start(interval_sec * 1000);
+}
+
+void AutosaveService::checkpoint(const QByteArray& layout_xml, const PlotDataMapRef& data)
+{
+  if (!_enabled || _write_watcher.isRunning())
+  {
+    return;
+  }
+
+  // tail copy: only the samples appended after the watermark of the
+  // last successful checkpoint. This runs on the GUI thread, where the
+  // streaming buffers are merged, so it needs no locking.
+  auto delta = std::make_shared<PlotDataMapRef>();
+  _pending_numeric.clear();
+  _pending_string.clear();
+  bool has_data = false;
+
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (const auto& [name, series] : data.numeric)
+  {
+    const size_t count = series.size();
+    if (count == 0)
+    {
+      continue;
+    }
+    const auto watermark = _numeric_watermark.find(name);
+    const double saved_up_to = (watermark == _numeric_watermark.end()) ?
+                                   std::numeric_limits<double>::lowest() :
+                                   watermark->second;
+    size_t begin = count;
+    while (begin > 0 && series[begin - 1].x > saved_up_to)
+    {
+      begin--;
+    }
+    if (begin == count)
+    {
+      continue;
+    }
+    xs.clear();
+    ys.clear();
+    xs.reserve(count - begin);
+    ys.reserve(count - begin);
+    for (size_t i = begin; i < count; i++)
+    {
+      xs.push_back(series[i].x);
+      ys.push_back(series[i].y);
+    }
+    delta->getOrCreateNumeric(name, series.group()).appendBatch(xs.data(), ys.data(), xs.size());
+    _pending_numeric[name] = series[count - 1].x;
+    has_data = true;
+  }
+
+  for (const auto& [name, series] : data.strings)
+  {
+    const size_t count = series.size();
+    if (count == 0)
+    {
+      continue;
+    }
+    const auto watermark = _string_watermark.find(name);
+    const double saved_up_to = (watermark == _string_watermark.end()) ?
+                                   std::numeric_limits<double>::lowest() :
+                                   watermark->second;
+    size_t begin = count;
+    while (begin > 0 && series[begin - 1].x > saved_up_to)
+    {
+      begin--;
+    }
+    if (begin == count)
+    {
+      continue;
+    }
+    auto& dest = delta->getOrCreateStringSeries(name, series.group());
+    for (size_t i = begin; i < count; i++)
+    {
+      const auto point = series[i];
+      const auto str = series.getString(point.y);
+      dest.pushBack({ point.x, StringRef(str.data(), str.size()) });
+    }
+    _pending_string[name] = series[count - 1].x;
+    has_data = true;
+  }
+
+  const bool layout_changed = (layout_xml != _last_layout);
+  if (!has_data && !layout_changed)
+  {
+    return;
+  }
+  _pending_layout = layout_xml;
+
+  const QString dir_path = checkpointDirectory();
+  const int sequence = _next_sequence;
+  const qint64 max_bytes = _max_disk_bytes;
+  _write_watcher.setFuture(
+      QtConcurrent::run([delta, has_data, layout_xml, dir_path, sequence, max_bytes]() -> int {
+        return WriteCheckpoint(*delta, has_data, layout_xml, dir_path, sequence, max_bytes);
+      }));
+}
+
+void AutosaveService::onWriteFinished()
+{
+  const int next_sequence = _write_watcher.result();
+  if (next_sequence < 0)
+  {
+    // the same samples will be retried at the next tick
+    return;
+  }
+  _next_sequence = next_sequence;
+  for (const auto& [name, time] : _pending_numeric)
+  {
+    _numeric_watermark[name] = time;
+  }
+  for (const auto& [name, time] : _pending_string)
+  {
+    _string_watermark[name] = time;
+  }
+  _last_layout = _pending_layout;
+}
+
+void AutosaveService::discardCheckpoints()
+{
+  _write_watcher.waitForFinished();
+  QDir dir(checkpointDirectory());
+  if (dir.exists())
+  {
+    dir.removeRecursively();
+  }
+}
+
+void AutosaveService::reset()
+{
+  discardCheckpoints();
+  _numeric_watermark.clear();
+  _string_watermark.clear();
+  _pending_numeric.clear();
+  _pending_string.clear();
+  _last_layout.clear();
+  _pending_layout.clear();
+  _next_sequence = 0;
+}
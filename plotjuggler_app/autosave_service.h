@@ -0,0 +1,104 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef AUTOSAVE_SERVICE_H
+#define AUTOSAVE_SERVICE_H
+
+#include <QByteArray>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include <map>
+#include <string>
+
+#include "PlotJuggler/plotdata.h"
+
+/**
+ * Periodic crash-recovery checkpoints of the current session.
+ *
+ * Every tick the service copies only the samples appended since the last
+ * successful checkpoint (a cheap tail copy, so ingestion is never
+ * blocked) and serializes them on a worker thread as an incremental
+ * ".pjdata" session dump, next to a copy of the layout XML. Restoring
+ * replays the dumps in order: LoadSessionDump() appends, so base plus
+ * deltas reproduces the full session.
+ *
+ * Disk usage is bounded: when the checkpoint directory grows past the
+ * configured budget (or accumulates too many delta files) the worker
+ * compacts the dumps on disk into a single one, without touching the
+ * live data. A clean shutdown discards the directory, so finding
+ * checkpoints at startup means the previous instance crashed.
+ *
+ * Settings: "MainWindow.autosaveInterval" (seconds, 0 disables, default
+ * 120) and "MainWindow.autosaveMaxMB" (default 512).
+ */
+class AutosaveService : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit AutosaveService(QObject* parent = nullptr);
+  ~AutosaveService() override;
+
+  static QString checkpointDirectory();
+
+  /// true when the previous instance left checkpoints behind (i.e. it
+  /// did not shut down cleanly)
+  static bool hasRecoverableSession();
+
+  /// Replay the checkpoints into destination. Returns the autosaved
+  /// layout XML, empty when there is none.
+  static QByteArray recoverSession(PJ::PlotDataMapRef& destination);
+
+  /// Replay the ".pjdata" dumps of a checkpoint directory into
+  /// destination, in sequence order. Besides crash recovery, this lets
+  /// another instance attach read-only to a session materialized by this
+  /// one (see MainWindow::attachSession): the dumps are written with
+  /// temp-file + rename, so a concurrent replay always sees consistent
+  /// files. Returns true when at least one dump was loaded.
+  static bool replayCheckpoints(const QString& dir_path, PJ::PlotDataMapRef& destination);
+
+  /// Read the settings and arm the periodic timer.
+  void start();
+
+  /// Copy the data appended since the last checkpoint and write it in
+  /// the background. Called on the GUI thread; skips the tick if the
+  /// previous write is still in flight.
+  void checkpoint(const QByteArray& layout_xml, const PJ::PlotDataMapRef& data);
+
+  /// Delete the checkpoints (clean shutdown: nothing to recover).
+  void discardCheckpoints();
+
+  /// Discard and start checkpointing from scratch, e.g. after the data
+  /// has been cleared or recovered.
+  void reset();
+
+signals:
+  /// Emitted by the internal timer: the owner answers with checkpoint().
+  void checkpointRequested();
+
+private:
+  void onWriteFinished();
+
+  QTimer _timer;
+  QFutureWatcher<int> _write_watcher;
+  bool _enabled = false;
+  int _next_sequence = 0;
+  qint64 _max_disk_bytes = 0;
+
+  // timestamp of the last checkpointed sample, per series
+  std::map<std::string, double> _numeric_watermark;
+  std::map<std::string, double> _string_watermark;
+  // applied to the maps above only when the write succeeds
+  std::map<std::string, double> _pending_numeric;
+  std::map<std::string, double> _pending_string;
+  QByteArray _last_layout;
+  QByteArray _pending_layout;
+};
+
+#endif  // AUTOSAVE_SERVICE_H
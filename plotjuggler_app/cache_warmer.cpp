@@ -0,0 +1,102 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "cache_warmer.h"
+
+#include <QMetaObject>
+#include <QPointer>
+
+#include "plotwidget.h"
+#include "PlotJuggler/thread_pool.h"
+#include "PlotJuggler/util/minmax_index.hpp"
+
+// Below this size the lazy, on-demand indexing is not a noticeable hitch
+static constexpr size_t MIN_SAMPLES_TO_WARM = 20000;
+
+CacheWarmer::CacheWarmer(QObject* parent) : QObject(parent)
+{
+}
+
+CacheWarmer::~CacheWarmer()
+{
+  cancelAndWait();
+}
+
+void CacheWarmer::start(const std::vector<PlotWidget*>& widgets)
+{
+  cancelAndWait();
+  const uint64_t epoch = _epoch.load();
+
+  for (PlotWidget* widget : widgets)
+  {
+    QPointer<PlotWidget> alive(widget);
+    for (const auto& info : widget->curveList())
+    {
+      auto* series = dynamic_cast<QwtTimeseries*>(info.curve->data());
+      if (!series)
+      {
+        continue;  // XY curves have no index to warm
+      }
+      const PlotData* data = series->timeseriesData();
+      if (!data || data->size() < MIN_SAMPLES_TO_WARM)
+      {
+        continue;
+      }
+      const QString title = info.curve->title().text();
+
+      _in_flight.fetch_add(1);
+      PJ::ThreadPool::instance().submit(
+          PJ::ThreadPool::Priority::RENDER_PREPARE, [this, epoch, alive, title, data]() {
+            if (_epoch.load() == epoch)
+            {
+              auto index = std::make_shared<PJ::MinMaxIndex>();
+              index->update(*data);
+              // adoption happens on the GUI thread, where the wrapper lives.
+              // The curve is located again by title: it may have been
+              // removed (or its widget closed) in the meantime.
+              QMetaObject::invokeMethod(
+                  this,
+                  [this, epoch, alive, title, data, index]() {
+                    if (_epoch.load() != epoch || alive.isNull())
+                    {
+                      return;
+                    }
+                    if (auto* info = alive->curveFromTitle(title))
+                    {
+                      if (auto* series = dynamic_cast<QwtTimeseries*>(info->curve->data()))
+                      {
+                        series->adoptWarmIndex(data, std::move(*index));
+                      }
+                    }
+                  },
+                  Qt::QueuedConnection);
+            }
+            taskFinished();
+          });
+    }
+  }
+}
+
+void CacheWarmer::cancelAndWait()
+{
+  _epoch.fetch_add(1);
+  if (_in_flight.load() == 0)
+  {
+    return;
+  }
+  // tasks from the stale epoch exit as soon as a worker picks them up
+  std::unique_lock<std::mutex> lock(_mutex);
+  _all_done.wait(lock, [this]() { return _in_flight.load() == 0; });
+}
+
+void CacheWarmer::taskFinished()
+{
+  if (_in_flight.fetch_sub(1) == 1)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _all_done.notify_all();
+  }
+}
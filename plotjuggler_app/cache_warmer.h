@@ -0,0 +1,59 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CACHE_WARMER_H
+#define CACHE_WARMER_H
+
+#include <QObject>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+class PlotWidget;
+
+/**
+ * Warms the visualization caches of freshly loaded curves while the user
+ * has not touched the mouse yet.
+ *
+ * Right after a bulk import, the first zoom or pan on each plot pays for
+ * every cold min/max pyramid at once (the transform pipelines and the
+ * envelope summaries are already computed synchronously by the load
+ * itself). start() walks the curves of the given widgets and builds the
+ * index of each large series on the shared pool, at RENDER_PREPARE
+ * priority so it never delays ingestion; the result is handed back to the
+ * wrapper on the GUI thread.
+ *
+ * The pool tasks only read the plotted series: cancelAndWait() MUST be
+ * called before anything mutates or deletes them. Cancellation is cheap
+ * when nothing is pending, so it is safe to call on every data update.
+ */
+class CacheWarmer : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit CacheWarmer(QObject* parent = nullptr);
+
+  ~CacheWarmer() override;
+
+  void start(const std::vector<PlotWidget*>& widgets);
+
+  void cancelAndWait();
+
+private:
+  void taskFinished();
+
+  /// bumped by cancelAndWait(): tasks and adoptions from an older epoch
+  /// do nothing
+  std::atomic<uint64_t> _epoch{ 0 };
+  std::atomic<size_t> _in_flight{ 0 };
+  std::mutex _mutex;
+  std::condition_variable _all_done;
+};
+
+#endif  // CACHE_WARMER_H
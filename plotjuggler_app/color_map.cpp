@@ -6,12 +6,14 @@
 
 #include "color_map.h"
 #include <QSettings>
+#include "PlotJuggler/util/lua_sandbox.hpp"
 
 sol::protected_function_result ColorMap::setScrip(QString text)
 {
   _lua_function = {};
   _lua_engine = {};
   _lua_engine.open_libraries();
+  PJ::SanitizeLuaEngine(_lua_engine);
   auto func = QString("function ColorMap(v)\n"
                       "%1\n"
                       "end\n")
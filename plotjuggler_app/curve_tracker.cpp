@@ -5,6 +5,7 @@
  */
 
 #include "curve_tracker.h"
+#include "timeseries_qwt.h"
 #include "qwt_series_data.h"
 #include "qwt_plot.h"
 #include "qwt_plot_curve.h"
@@ -35,6 +36,11 @@ CurveTracker::CurveTracker(QwtPlot* plot, QColor color) : QObject(plot), _plot(p
   _text_marker = new QwtPlotMarker();
   _text_marker->attach(plot);
 
+  // resolving the system fixed font goes through QFontDatabase every time;
+  // do it once instead of at every tracker move
+  _label_font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+  _label_font.setPointSize(9);
+
   _visible = true;
 }
 
@@ -79,6 +85,11 @@ void CurveTracker::setPosition(const QPointF& tracker_position)
 {
   const QwtPlotItemList curves = _plot->itemList(QwtPlotItem::Rtti_PlotCurve);
 
+  // batch the marker updates: a single replot at the end instead of one
+  // itemChanged() notification per marker
+  const bool auto_replot = _plot->autoReplot();
+  _plot->setAutoReplot(false);
+
   _line_marker->setValue(tracker_position);
 
   QRectF rect;
@@ -102,11 +113,13 @@ void CurveTracker::setPosition(const QPointF& tracker_position)
     _point_markers.push_back(new QwtPlotMarker);
     _point_markers[i]->attach(_plot);
   }
+  _cached_lines.resize(_point_markers.size());
 
   double text_X_offset = 0;
 
   struct LineParts
   {
+    int curve_index;
     QColor color;
     QString value;
     QString delta;
@@ -155,6 +168,7 @@ void CurveTracker::setPosition(const QPointF& tracker_position)
       visible_points++;
       double value = point.y();
       LineParts parts;
+      parts.curve_index = i;
       parts.value = QString::number(value, 'f', prec);
       if (maybe_reference)
       {
@@ -189,7 +203,6 @@ void CurveTracker::setPosition(const QPointF& tracker_position)
     }
   }
 
-  QwtText mark_text;
   QString text_marker_info;
 
   const QString time_str = QString::number(tracker_position.x(), 'f', prec);
@@ -214,42 +227,60 @@ void CurveTracker::setPosition(const QPointF& tracker_position)
     int count = 0;
     for (auto it = text_lines.rbegin(); it != text_lines.rend(); it++)
     {
-      LineParts parts = it->second;
-      QString line_str;
-      if (_param == VALUE)
-      {
-        line_str = QString("<font color=%1>%2%3</font>")
-                       .arg(parts.color.name())
-                       .arg(parts.value)
-                       .arg(parts.delta);
-      }
-      else if (_param == VALUE_NAME)
+      const LineParts& parts = it->second;
+      CachedLine& cached = _cached_lines[parts.curve_index];
+
+      // the per-line HTML is rebuilt only when one of its parts changed: on a
+      // drag over step-like data most values don't move between two events
+      if (cached.html.isEmpty() || cached.param != _param || cached.color != parts.color ||
+          cached.value != parts.value || cached.delta != parts.delta || cached.name != parts.name)
       {
-        line_str = QString("<font color=%1>%2%3 : %4</font>")
-                       .arg(parts.color.name())
-                       .arg(parts.value)
-                       .arg(parts.delta)
-                       .arg(parts.name);
+        cached.color = parts.color;
+        cached.value = parts.value;
+        cached.delta = parts.delta;
+        cached.name = parts.name;
+        cached.param = _param;
+        if (_param == VALUE)
+        {
+          cached.html = QString("<font color=%1>%2%3</font>")
+                            .arg(parts.color.name())
+                            .arg(parts.value)
+                            .arg(parts.delta);
+        }
+        else  // VALUE_NAME
+        {
+          cached.html = QString("<font color=%1>%2%3 : %4</font>")
+                            .arg(parts.color.name())
+                            .arg(parts.value)
+                            .arg(parts.delta)
+                            .arg(parts.name);
+        }
       }
 
-      text_marker_info += line_str;
+      text_marker_info += cached.html;
       if (count++ < text_lines.size() - 1)
       {
         text_marker_info += "<br>";
       }
     }
-    mark_text.setBorderPen(QColor(Qt::transparent));
-
-    QColor background_color = _plot->palette().background().color();
-    background_color.setAlpha(180);
-    mark_text.setBackgroundBrush(background_color);
-    mark_text.setText(text_marker_info);
-
-    QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
-    font.setPointSize(9);
-    mark_text.setFont(font);
-    mark_text.setRenderFlags(_param == VALUE ? Qt::AlignCenter : Qt::AlignLeft);
-    _text_marker->setLabel(mark_text);
+
+    // setText() discards the cached rich-text layout and textSize(); skip the
+    // whole rebuild when the assembled label is identical to the previous one
+    // (typical when redraw() is called by a replot without a tracker move)
+    if (text_marker_info != _cached_label_html)
+    {
+      _cached_label_html = text_marker_info;
+      _cached_label.setBorderPen(QColor(Qt::transparent));
+
+      QColor background_color = _plot->palette().background().color();
+      background_color.setAlpha(180);
+      _cached_label.setBackgroundBrush(background_color);
+      _cached_label.setText(text_marker_info);
+      _cached_label.setFont(_label_font);
+      _cached_label.setRenderFlags(_param == VALUE ? Qt::AlignCenter : Qt::AlignLeft);
+      _cached_label_width = _cached_label.textSize().width();
+      _text_marker->setLabel(_cached_label);
+    }
     _text_marker->setLabelAlignment(Qt::AlignRight);
     _text_marker->setXValue(tracker_position.x() + text_X_offset);
   }
@@ -260,7 +291,7 @@ void CurveTracker::setPosition(const QPointF& tracker_position)
   }
 
   double canvas_ratio = rect.width() / double(_plot->width());
-  double text_width = mark_text.textSize().width() * canvas_ratio;
+  double text_width = (_param != LINE_ONLY) ? _cached_label_width * canvas_ratio : 0.0;
   bool exceed_right = (_text_marker->boundingRect().right() + text_width) > rect.right();
 
   if (exceed_right)
@@ -271,6 +302,12 @@ void CurveTracker::setPosition(const QPointF& tracker_position)
   _text_marker->setVisible(visible_points > 0 && _visible && _param != LINE_ONLY);
 
   _prev_trackerpoint = tracker_position;
+
+  _plot->setAutoReplot(auto_replot);
+  if (auto_replot)
+  {
+    _plot->replot();
+  }
 }
 
 void CurveTracker::setReferencePosition(std::optional<QPointF> reference_pos)
@@ -281,20 +318,37 @@ void CurveTracker::setReferencePosition(std::optional<QPointF> reference_pos)
 
 std::optional<QPointF> curvePointAt(const QwtPlotCurve* curve, double x)
 {
+  // curves attached to the mirrored xTop axis hold samples in absolute time,
+  // while the caller works in the relative coordinates of the bottom axis
+  double offset = 0.0;
+  if (curve->xAxis() == QwtPlot::xTop)
+  {
+    if (auto series = dynamic_cast<const QwtTimeseries*>(curve->data()))
+    {
+      offset = series->timeOffset();
+    }
+  }
+  const double x_sample = x + offset;
+
   if (curve->dataSize() >= 2)
   {
-    int index = qwtUpperSampleIndex<QPointF>(*curve->data(), x, compareX());
+    int index = qwtUpperSampleIndex<QPointF>(*curve->data(), x_sample, compareX());
 
+    std::optional<QPointF> point;
     if (index > 0 && index < curve->dataSize())
     {
       auto p1 = (curve->sample(index - 1));
       auto p2 = (curve->sample(index));
       double middle_X = (p1.x() + p2.x()) / 2.0;
-      return (x < middle_X) ? p1 : p2;
+      point = (x_sample < middle_X) ? p1 : p2;
     }
     else if (index >= curve->dataSize())
     {
-      return curve->sample(curve->dataSize() - 1);
+      point = curve->sample(curve->dataSize() - 1);
+    }
+    if (point)
+    {
+      return QPointF(point->x() - offset, point->y());
     }
   }
   return std::nullopt;
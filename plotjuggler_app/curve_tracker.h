@@ -7,10 +7,12 @@
 #pragma once
 
 #include <QEvent>
+#include <QFont>
 #include <QPointF>
 #include <optional>
 #include "qwt_plot_picker.h"
 #include "qwt_plot_marker.h"
+#include "qwt_text.h"
 
 class QwtPlotCurve;
 
@@ -63,4 +65,26 @@ private:
   QwtPlot* _plot;
   Parameter _param;
   bool _visible;
+
+  /// Cached rich-text line of a single curve. Formatting the HTML with
+  /// QString::arg on every mouse move is surprisingly expensive on plots with
+  /// many curves; the line is rebuilt only when one of its parts changed.
+  struct CachedLine
+  {
+    QColor color;
+    QString value;
+    QString delta;
+    QString name;
+    Parameter param = LINE_ONLY;
+    QString html;
+  };
+  // parallel to _point_markers (one entry per attached curve)
+  std::vector<CachedLine> _cached_lines;
+
+  // the label rebuild (setText + layout + textSize) is skipped entirely when
+  // the assembled text did not change since the previous call
+  QwtText _cached_label;
+  QString _cached_label_html;
+  double _cached_label_width = 0;
+  QFont _label_font;
 };
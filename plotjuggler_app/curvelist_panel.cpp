@@ -7,6 +7,8 @@
 #include "curvelist_panel.h"
 #include "ui_curvelist_panel.h"
 #include "PlotJuggler/alphanum.hpp"
+#include "PlotJuggler/string_interner.h"
+#include "PlotJuggler/util/delayed_callback.hpp"
 #include <QDebug>
 #include <QLayoutItem>
 #include <QMenu>
@@ -76,17 +78,24 @@ CurveListPanel::CurveListPanel(PlotDataMapRef& mapped_plot_data,
   connect(_custom_view->selectionModel(), &QItemSelectionModel::selectionChanged, this,
           &CurveListPanel::onCustomSelectionChanged);
 
-  connect(_custom_view->verticalScrollBar(), &QScrollBar::valueChanged, this,
-          &CurveListPanel::refreshValues);
+  // scrolling and bulk expansion fire these once per row: coalesce the
+  // visible-value refresh to one pass per frame
+  PJ::CoalescingScheduler::instance().registerChannel("curvelist_values",
+                                                      [this]() { refreshValues(); });
+  auto deferred_refresh = []() {
+    PJ::CoalescingScheduler::instance().trigger("curvelist_values", 16);
+  };
+
+  connect(_custom_view->verticalScrollBar(), &QScrollBar::valueChanged, this, deferred_refresh);
 
-  connect(_tree_view->verticalScrollBar(), &QScrollBar::valueChanged, this,
-          &CurveListPanel::refreshValues);
+  connect(_tree_view->verticalScrollBar(), &QScrollBar::valueChanged, this, deferred_refresh);
 
-  connect(_tree_view, &QTreeWidget::itemExpanded, this, &CurveListPanel::refreshValues);
+  connect(_tree_view, &QTreeWidget::itemExpanded, this, deferred_refresh);
 }
 
 CurveListPanel::~CurveListPanel()
 {
+  PJ::CoalescingScheduler::instance().unregisterChannel("curvelist_values");
   delete ui;
 }
 
@@ -100,7 +109,9 @@ void CurveListPanel::clear()
 
 bool CurveListPanel::addCurve(const std::string& plot_name)
 {
-  QString plot_id = QString::fromStdString(plot_name);
+  // plot_name was interned when the series was created: reuse the
+  // cached QString instead of transcoding it again for every curve
+  const QString& plot_id = PJ::StringInterner::instance().qstring(plot_name);
   if (_tree_view_items.count(plot_name) > 0)
   {
     return false;
@@ -115,7 +126,7 @@ bool CurveListPanel::addCurve(const std::string& plot_name)
       auto& plot = it->second;
       if (plot.group())
       {
-        group_name = QString::fromStdString(plot.group()->name());
+        group_name = PJ::StringInterner::instance().qstring(plot.group()->name());
       }
       return true;
     }
@@ -291,12 +302,16 @@ void CurveListPanel::update2ndColumnValues(double tracker_time)
 
 void CurveListPanel::refreshValues()
 {
-  auto default_foreground = _custom_view->palette().foreground();
+  if (is2ndColumnHidden())
+  {
+    return;
+  }
 
-  auto FormattedNumber = [](double value) {
-    QSettings settings;
-    int prec = settings.value("Preferences::precision", 3).toInt();
-    QString num_text = QString::number(value, 'f', prec);
+  QSettings settings;
+  const int precision = settings.value("Preferences::precision", 3).toInt();
+
+  auto FormattedNumber = [precision](double value) {
+    QString num_text = QString::number(value, 'f', precision);
     if (num_text.contains('.'))
     {
       int idx = num_text.length() - 1;
@@ -354,34 +369,35 @@ void CurveListPanel::refreshValues()
   {
     const int vertical_height = tree_view->visibleRegion().boundingRect().height();
 
-    auto DisplayValue = [&](QTreeWidgetItem* cell) {
+    tree_view->setViewResizeEnabled(false);
+
+    // walk the view from the first visible row and stop at the bottom of the
+    // viewport, instead of traversing the whole tree: the cost of a refresh
+    // scales with the viewport height, not with the number of series
+    for (QTreeWidgetItem* cell = tree_view->itemAt(0, 0); cell; cell = tree_view->itemBelow(cell))
+    {
+      if (tree_view->visualItemRect(cell).top() > vertical_height)
+      {
+        break;
+      }
       if (!isCurveTreeItem(cell))
       {
-        return;
+        continue;
       }
 
       QString curve_name = cell->data(0, CustomRoles::Name).toString();
-
-      if (!curve_name.isEmpty())
+      if (curve_name.isEmpty())
       {
-        auto rect = cell->treeWidget()->visualItemRect(cell);
-
-        if (rect.bottom() < 0 || cell->isHidden() || rect.top() > vertical_height)
-        {
-          return;
-        }
-
-        if (!is2ndColumnHidden())
-        {
-          QString str_value = GetValue(curve_name.toStdString());
-          cell->setText(1, str_value);
-        }
+        continue;
       }
-    };
 
-    tree_view->setViewResizeEnabled(false);
-    tree_view->treeVisitor(DisplayValue);
-    // tree_view->setViewResizeEnabled(true);
+      QString str_value = GetValue(curve_name.toStdString());
+      // an identical setText would still emit dataChanged and dirty the view
+      if (cell->text(1) != str_value)
+      {
+        cell->setText(1, str_value);
+      }
+    }
   }
 }
 
@@ -474,12 +490,24 @@ void CurveListPanel::removeSelectedCurves()
 
 void CurveListPanel::removeCurve(const std::string& name)
 {
-  QString curve_name = QString::fromStdString(name);
+  const QString& curve_name = PJ::StringInterner::instance().qstring(name);
   _tree_view->removeCurve(curve_name);
   _tree_view_items.erase(name);
   _custom_view->removeCurve(curve_name);
 }
 
+void CurveListPanel::removeCurves(const std::set<std::string>& names)
+{
+  std::set<QString> curve_names;
+  for (const auto& name : names)
+  {
+    curve_names.insert(PJ::StringInterner::instance().qstring(name));
+    _tree_view_items.erase(name);
+  }
+  _tree_view->removeCurves(curve_names);
+  _custom_view->removeCurves(curve_names);
+}
+
 void CurveListPanel::on_buttonAddCustom_clicked()
 {
   std::array<CurvesView*, 2> views = { _tree_view, _custom_view };
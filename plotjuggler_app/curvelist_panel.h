@@ -14,6 +14,7 @@
 #include <QStandardItemModel>
 #include <QTableView>
 #include <QItemSelection>
+#include <set>
 #include <unordered_set>
 
 #include "transforms/custom_function.h"
@@ -46,6 +47,10 @@ public:
 
   void removeCurve(const std::string& name);
 
+  /// Batch version of removeCurve(): both views are updated with a
+  /// single pass for the whole set.
+  void removeCurves(const std::set<std::string>& names);
+
   void rebuildEntireList(const std::vector<std::string>& names);
 
   void updateFilter();
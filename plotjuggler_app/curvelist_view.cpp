@@ -12,6 +12,7 @@
 #include <QDebug>
 #include <QScrollBar>
 #include "curvelist_panel.h"
+#include "PlotJuggler/string_interner.h"
 
 CurveTableView::CurveTableView(CurveListPanel* parent) : QTableWidget(parent), CurvesView(parent)
 {
@@ -130,6 +131,22 @@ void CurveTableView::removeCurve(const QString& name)
   _inserted_curves.remove(name);
 }
 
+void CurveTableView::removeCurves(const std::set<QString>& names)
+{
+  // backwards, so that removing a row does not shift the ones still to visit
+  for (int row = model()->rowCount() - 1; row >= 0; row--)
+  {
+    if (names.count(item(row, 0)->text()) > 0)
+    {
+      removeRow(row);
+    }
+  }
+  for (const auto& name : names)
+  {
+    _inserted_curves.remove(name);
+  }
+}
+
 bool CurveTableView::applyVisibilityFilter(const QString& search_string)
 {
   setViewResizeEnabled(false);
@@ -265,7 +282,7 @@ bool CurvesView::eventFilterBase(QObject* object, QEvent* event)
 
       for (const auto& curve_name : selected_names)
       {
-        stream << QString::fromStdString(curve_name);
+        stream << PJ::StringInterner::instance().qstring(curve_name);
       }
 
       if (!_newX_modifier)
@@ -17,10 +17,11 @@
 #include <QStandardItem>
 #include <QStandardItemModel>
 #include <QTableWidget>
+#include <set>
 #include <vector>
 #include <QSet>
 
-#include "PlotJuggler/alphanum.hpp"
+#include "PlotJuggler/util/natural_sort_key.hpp"
 
 class CurveListPanel;
 
@@ -28,17 +29,19 @@ template <typename Item>
 class SortedTableItem : public Item
 {
 public:
-  SortedTableItem(const QString& name) : Item(name), str(name.toStdString())
+  SortedTableItem(const QString& name)
+    : Item(name), sort_key(PJ::NaturalSortKey(name.toStdString()))
   {
   }
 
   bool operator<(const SortedTableItem& other) const
   {
-    return doj::alphanum_impl(this->str.c_str(), other.str.c_str()) < 0;
+    // the key is computed once per item, so sorting is memcmp-based
+    return sort_key < other.sort_key;
   }
 
 protected:
-  std::string str;
+  std::string sort_key;
 };
 
 enum CustomRoles
@@ -75,6 +78,16 @@ public:
 
   virtual void removeCurve(const QString& name) = 0;
 
+  /// Batch version of removeCurve(): one pass over the view, whatever
+  /// the number of curves to delete.
+  virtual void removeCurves(const std::set<QString>& names)
+  {
+    for (const auto& name : names)
+    {
+      removeCurve(name);
+    }
+  }
+
   void setFontSize(int size)
   {
     _point_size = size;
@@ -110,6 +123,8 @@ public:
 
   void removeCurve(const QString& name) override;
 
+  void removeCurves(const std::set<QString>& names) override;
+
   bool applyVisibilityFilter(const QString& filter_string) override;
 
   bool eventFilter(QObject* object, QEvent* event) override
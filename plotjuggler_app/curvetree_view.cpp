@@ -13,6 +13,7 @@
 #include <QToolTip>
 #include <QKeySequence>
 #include <QClipboard>
+#include <numeric>
 
 namespace
 {
@@ -32,8 +33,27 @@ public:
 
   bool operator<(const QTreeWidgetItem& other) const
   {
-    return doj::alphanum_impl(this->text(0).toLocal8Bit(), other.text(0).toLocal8Bit()) < 0;
+    // all siblings are TreeWidgetItem: compare cached natural-sort keys
+    // instead of re-tokenizing both names on every comparison
+    return sortKey() < static_cast<const TreeWidgetItem&>(other).sortKey();
   }
+
+private:
+  // the text is set after construction, so the key is computed lazily
+  // and recomputed if the item is ever renamed
+  const std::string& sortKey() const
+  {
+    const QString name = text(0);
+    if (name != _key_source)
+    {
+      _key_source = name;
+      _sort_key = PJ::NaturalSortKey(name.toStdString());
+    }
+    return _sort_key;
+  }
+
+  mutable QString _key_source;
+  mutable std::string _sort_key;
 };
 
 CurveTreeView::CurveTreeView(CurveListPanel* parent) : QTreeWidget(parent), CurvesView(parent)
@@ -96,22 +116,23 @@ void CurveTreeView::clear()
   QTreeWidget::clear();
   _leaf_count = 0;
   _hidden_count = 0;
+  _filter_entries.clear();
+  _filter_entries_dirty = true;
+  _child_index.clear();
+  _use_separator.reset();
 }
 
 void CurveTreeView::addItem(const QString& group_name, const QString& tree_name,
                             const QString& plot_ID)
 {
-  QSettings settings; /*
-                       * This Source Code Form is subject to the terms of the Mozilla
-                       * Public License, v. 2.0. If a copy of the MPL was not distributed
-                       * with this file, You can obtain one at
-                       * https://mozilla.org/MPL/2.0/.
-                       */
-
-  bool use_separator = settings.value("Preferences::use_separator", true).toBool();
+  if (!_use_separator)
+  {
+    QSettings settings;
+    _use_separator = settings.value("Preferences::use_separator", true).toBool();
+  }
 
   QStringList parts;
-  if (use_separator)
+  if (*_use_separator)
   {
     parts = tree_name.split('/', PJ::SkipEmptyParts);
   }
@@ -149,6 +170,10 @@ void CurveTreeView::addItem(const QString& group_name, const QString& tree_name,
     parts = group_parts + parts;
   }
 
+  // the QFontDatabase lookups are the same for every inserted item
+  static const QFont general_font = QFontDatabase::systemFont(QFontDatabase::GeneralFont);
+  static const QFont fixed_font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+
   QTreeWidgetItem* tree_parent = this->invisibleRootItem();
 
   for (int i = 0; i < parts.size(); i++)
@@ -156,17 +181,17 @@ void CurveTreeView::addItem(const QString& group_name, const QString& tree_name,
     bool is_leaf = (i == parts.size() - 1);
     const auto& part = parts[i];
 
-    QTreeWidgetItem* matching_child = nullptr;
-
-    for (int c = 0; c < tree_parent->childCount(); c++)
+    // the per-parent hash is rebuilt on demand after clear()/removeCurve()
+    auto index_it = _child_index.find(tree_parent);
+    if (index_it == _child_index.end())
     {
-      QTreeWidgetItem* tree_child = tree_parent->child(c);
-      if (tree_child->text(0) == part)
+      index_it = _child_index.emplace(tree_parent, QHash<QString, QTreeWidgetItem*>()).first;
+      for (int c = 0; c < tree_parent->childCount(); c++)
       {
-        matching_child = tree_child;
-        break;
+        index_it->second.insert(tree_parent->child(c)->text(0), tree_parent->child(c));
       }
     }
+    QTreeWidgetItem* matching_child = index_it->second.value(part, nullptr);
 
     if (matching_child)
     {
@@ -181,17 +206,18 @@ void CurveTreeView::addItem(const QString& group_name, const QString& tree_name,
     else
     {
       QTreeWidgetItem* child_item = new TreeWidgetItem(tree_parent);
+      index_it->second.insert(part, child_item);
       child_item->setText(0, part);
       child_item->setText(1, is_leaf ? "-" : "");
 
       bool isGroupCell = (i < group_parts.size());
 
-      QFont font = QFontDatabase::systemFont(QFontDatabase::GeneralFont);
+      QFont font = general_font;
       font.setPointSize(_point_size);
       // font.setBold(isGroupCell);
       child_item->setFont(0, font);
 
-      font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+      font = fixed_font;
       font.setPointSize(_point_size - 2);
       child_item->setFont(1, font);
       child_item->setTextAlignment(1, Qt::AlignRight);
@@ -218,6 +244,7 @@ void CurveTreeView::addItem(const QString& group_name, const QString& tree_name,
     }
   }
   _leaf_count++;
+  _filter_entries_dirty = true;
 }
 
 void CurveTreeView::refreshColumns()
@@ -262,43 +289,65 @@ void CurveTreeView::refreshFontSize()
 bool CurveTreeView::applyVisibilityFilter(const QString& search_string)
 {
   bool updated = false;
-  _hidden_count = 0;
-
-  QStringList spaced_items = search_string.split(' ', PJ::SkipEmptyParts);
 
-  auto hideFunc = [&](QTreeWidgetItem* item) {
-    if (!isCurveItem(item))
-    {
-      return;
-    }
+  if (_filter_entries_dirty)
+  {
+    _filter_entries.clear();
+    _filter_entries.reserve(_leaf_count);
+    treeVisitor([&](QTreeWidgetItem* item) {
+      if (isCurveItem(item))
+      {
+        _filter_entries.push_back({ item, item->data(0, Qt::UserRole).toString().toLower() });
+      }
+    });
+    _filter_entries_dirty = false;
+    _last_filter_valid = false;
+  }
 
-    QString name = item->data(0, Qt::UserRole).toString();
-    bool toHide = false;
+  QStringList tokens = search_string.toLower().split(' ', PJ::SkipEmptyParts);
 
-    if (search_string.isEmpty() == false)
+  // When every previous token is contained in one of the new ones (the user
+  // typed more characters), the new result set is a subset of the previous
+  // one: only the previous matches need to be re-tested.
+  bool narrowing = _last_filter_valid;
+  for (const auto& prev_token : _last_filter_tokens)
+  {
+    bool contained = false;
+    for (const auto& token : tokens)
     {
-      for (const auto& spaced_item : spaced_items)
+      if (token.contains(prev_token))
       {
-        if (name.contains(spaced_item, Qt::CaseInsensitive) == false)
-        {
-          toHide = true;
-          break;
-        }
+        contained = true;
+        break;
       }
     }
-    if (toHide)
+    if (!contained)
     {
-      _hidden_count++;
+      narrowing = false;
+      break;
     }
+  }
 
-    if (toHide != item->isHidden())
+  std::vector<size_t> candidates;
+  if (narrowing)
+  {
+    candidates = std::move(_last_filter_matches);
+  }
+  else
+  {
+    candidates.resize(_filter_entries.size());
+    std::iota(candidates.begin(), candidates.end(), size_t(0));
+  }
+
+  auto setLeafHidden = [&](QTreeWidgetItem* item, bool hide) {
+    if (hide == item->isHidden())
     {
-      updated = true;
+      return;
     }
+    updated = true;
+    item->setHidden(hide);
 
-    item->setHidden(toHide);
-
-    // hide the parent if necessary
+    // hide or reveal the ancestors if necessary
     auto parent = item->parent();
     while (parent)
     {
@@ -324,8 +373,32 @@ bool CurveTreeView::applyVisibilityFilter(const QString& search_string)
     }
   };
 
-  treeVisitor(hideFunc);
-  //-------------
+  std::vector<size_t> matches;
+  matches.reserve(candidates.size());
+
+  for (size_t index : candidates)
+  {
+    const auto& entry = _filter_entries[index];
+    bool matched = true;
+    for (const auto& token : tokens)
+    {
+      if (!entry.lowercase_name.contains(token))
+      {
+        matched = false;
+        break;
+      }
+    }
+    if (matched)
+    {
+      matches.push_back(index);
+    }
+    setLeafHidden(entry.item, !matched);
+  }
+
+  _hidden_count = _leaf_count - int(matches.size());
+  _last_filter_tokens = tokens;
+  _last_filter_matches = std::move(matches);
+  _last_filter_valid = true;
 
   return updated;
 }
@@ -361,43 +434,63 @@ bool CurveTreeView::eventFilter(QObject* object, QEvent* event)
 
 void CurveTreeView::removeCurve(const QString& to_be_deleted)
 {
-  auto removeFunc = [&](QTreeWidgetItem* item) {
+  removeCurves({ to_be_deleted });
+}
+
+void CurveTreeView::removeCurves(const std::set<QString>& to_be_deleted)
+{
+  // A single traversal for the whole batch: deleting N curves costs one
+  // tree visit instead of N. The doomed leaves are collected first and
+  // detached afterwards, so that the traversal never iterates over
+  // children while they are being removed.
+  std::vector<QTreeWidgetItem*> doomed;
+
+  auto collectFunc = [&](QTreeWidgetItem* item) {
     QString curve_name = item->data(0, Qt::UserRole).toString();
-    if (curve_name == to_be_deleted)
+    if (!curve_name.isEmpty() && to_be_deleted.count(curve_name) > 0)
     {
       _leaf_count--;
 
       if (item->childCount() > 0)
       {
+        // an internal node that is also a curve: hollow it out, but keep
+        // its children
         item->setFlags(item->flags() & (~Qt::ItemIsSelectable));
         item->setData(0, Qt::UserRole, {});
         item->setText(1, "");
         return;
       }
+      doomed.push_back(item);
+    }
+  };
 
-      auto parent_item = item->parent();
+  // just in case
+  _tooltip_item = nullptr;
+  _filter_entries.clear();
+  _filter_entries_dirty = true;
+  _child_index.clear();
+  treeVisitor(collectFunc);
+
+  for (auto* item : doomed)
+  {
+    auto parent_item = item->parent();
+    if (!parent_item)
+    {
+      parent_item = invisibleRootItem();
+    }
+    parent_item->removeChild(item);
+
+    while (parent_item->childCount() == 0 && parent_item != invisibleRootItem())
+    {
+      auto prev_item = parent_item;
+      parent_item = parent_item->parent();
       if (!parent_item)
       {
         parent_item = invisibleRootItem();
       }
-      parent_item->removeChild(item);
-
-      while (parent_item->childCount() == 0 && parent_item != invisibleRootItem())
-      {
-        auto prev_item = parent_item;
-        parent_item = parent_item->parent();
-        if (!parent_item)
-        {
-          parent_item = invisibleRootItem();
-        }
-        parent_item->removeChild(prev_item);
-      }
+      parent_item->removeChild(prev_item);
     }
-  };
-
-  // just in case
-  _tooltip_item = nullptr;
-  treeVisitor(removeFunc);
+  }
 }
 
 void CurveTreeView::hideValuesColumn(bool hide)
@@ -9,7 +9,10 @@
 
 #include "curvelist_view.h"
 #include <QTreeWidget>
+#include <QHash>
 #include <functional>
+#include <optional>
+#include <unordered_map>
 
 class CurveTreeView : public QTreeWidget, public CurvesView
 {
@@ -32,6 +35,8 @@ public:
 
   void removeCurve(const QString& name) override;
 
+  void removeCurves(const std::set<QString>& names) override;
+
   std::pair<int, int> hiddenItemsCount() override
   {
     return { _hidden_count, _leaf_count };
@@ -53,6 +58,30 @@ private:
   int _hidden_count = 0;
   int _leaf_count = 0;
 
+  // Flat index of the leaves, rebuilt lazily when the tree changes.
+  // Filtering scans this vector instead of traversing the tree, and when a
+  // keystroke can only narrow the previous result, only the previous
+  // matches are re-tested.
+  struct FilterEntry
+  {
+    QTreeWidgetItem* item;
+    QString lowercase_name;
+  };
+  std::vector<FilterEntry> _filter_entries;
+  bool _filter_entries_dirty = true;
+  QStringList _last_filter_tokens;
+  std::vector<size_t> _last_filter_matches;
+  bool _last_filter_valid = false;
+
+  // Children of each internal node, keyed by their text: turns the sibling
+  // lookup in addItem() from a linear scan into a hash probe, which matters
+  // when a session inserts tens of thousands of series.
+  std::unordered_map<QTreeWidgetItem*, QHash<QString, QTreeWidgetItem*>> _child_index;
+
+  // "Preferences::use_separator", read once per rebuild instead of once
+  // per inserted series
+  std::optional<bool> _use_separator;
+
   QTimer* _tooltip_timer = nullptr;
   QTreeWidgetItem* _tooltip_item = nullptr;
   QPoint _tooltip_pos;
@@ -0,0 +1,200 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "event_query_dialog.h"
+
+#include <QCompleter>
+#include <QDoubleValidator>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+
+using namespace PJ;
+
+EventQueryDialog::EventQueryDialog(const PlotDataMapRef& data,
+                                   std::function<double()> tracker_time, QWidget* parent)
+  : QDialog(parent), _data(data), _tracker_time(std::move(tracker_time))
+{
+  setWindowTitle(tr("Find Events"));
+  setMinimumWidth(450);
+
+  _series_combo = new QComboBox(this);
+  _series_combo->setEditable(true);
+  _series_combo->setInsertPolicy(QComboBox::NoInsert);
+  _series_combo->completer()->setCompletionMode(QCompleter::PopupCompletion);
+  _series_combo->completer()->setFilterMode(Qt::MatchContains);
+  _series_combo->completer()->setCaseSensitivity(Qt::CaseInsensitive);
+
+  _predicate_combo = new QComboBox(this);
+  _predicate_combo->addItem(tr("rises above"), int(EventQuery::Predicate::GreaterThan));
+  _predicate_combo->addItem(tr("falls below"), int(EventQuery::Predicate::LessThan));
+  _predicate_combo->addItem(tr("enters range"), int(EventQuery::Predicate::InsideRange));
+  _predicate_combo->addItem(tr("leaves range"), int(EventQuery::Predicate::OutsideRange));
+
+  auto validator = new QDoubleValidator(this);
+  validator->setLocale(QLocale::c());
+  _value_low = new QLineEdit(this);
+  _value_low->setValidator(validator);
+  _value_low->setPlaceholderText(tr("value"));
+  _value_high = new QLineEdit(this);
+  _value_high->setValidator(validator);
+  _value_high->setPlaceholderText(tr("upper value"));
+  _value_high->setEnabled(false);
+
+  auto values_layout = new QHBoxLayout();
+  values_layout->addWidget(_predicate_combo);
+  values_layout->addWidget(_value_low);
+  values_layout->addWidget(_value_high);
+
+  _status = new QLabel(this);
+  _status->setText(tr("Pick a series and a condition"));
+
+  _prev_button = new QPushButton(tr("Previous"), this);
+  _next_button = new QPushButton(tr("Next"), this);
+  _next_button->setDefault(true);
+  auto close_button = new QPushButton(tr("Close"), this);
+
+  auto buttons_layout = new QHBoxLayout();
+  buttons_layout->addWidget(_status, 1);
+  buttons_layout->addWidget(_prev_button);
+  buttons_layout->addWidget(_next_button);
+  buttons_layout->addWidget(close_button);
+
+  auto form = new QFormLayout();
+  form->addRow(tr("Series:"), _series_combo);
+  form->addRow(tr("Condition:"), values_layout);
+
+  auto layout = new QVBoxLayout(this);
+  layout->addLayout(form);
+  layout->addLayout(buttons_layout);
+
+  connect(_prev_button, &QPushButton::clicked, this, &EventQueryDialog::findPrevious);
+  connect(_next_button, &QPushButton::clicked, this, &EventQueryDialog::findNext);
+  connect(close_button, &QPushButton::clicked, this, &QDialog::close);
+
+  connect(_series_combo, &QComboBox::currentTextChanged, this,
+          &EventQueryDialog::invalidateQuery);
+  connect(_predicate_combo, qOverload<int>(&QComboBox::currentIndexChanged), this, [this](int) {
+    const auto predicate = EventQuery::Predicate(_predicate_combo->currentData().toInt());
+    _value_high->setEnabled(predicate == EventQuery::Predicate::InsideRange ||
+                            predicate == EventQuery::Predicate::OutsideRange);
+    invalidateQuery();
+  });
+  connect(_value_low, &QLineEdit::textChanged, this, &EventQueryDialog::invalidateQuery);
+  connect(_value_high, &QLineEdit::textChanged, this, &EventQueryDialog::invalidateQuery);
+
+  refreshSeriesList();
+}
+
+void EventQueryDialog::refreshSeriesList()
+{
+  const QString current = _series_combo->currentText();
+
+  QStringList names;
+  names.reserve(int(_data.numeric.size()));
+  for (const auto& it : _data.numeric)
+  {
+    names.push_back(QString::fromStdString(it.first));
+  }
+  names.sort();
+
+  QSignalBlocker block(_series_combo);
+  _series_combo->clear();
+  _series_combo->addItems(names);
+  const int index = _series_combo->findText(current);
+  if (index >= 0)
+  {
+    _series_combo->setCurrentIndex(index);
+  }
+  else
+  {
+    invalidateQuery();
+  }
+}
+
+void EventQueryDialog::invalidateQuery()
+{
+  _query.reset();
+  _query_series.clear();
+}
+
+bool EventQueryDialog::ensureQuery()
+{
+  const std::string series_name = _series_combo->currentText().toStdString();
+  auto series_it = _data.numeric.find(series_name);
+  if (series_it == _data.numeric.end())
+  {
+    _status->setText(tr("Series not found"));
+    return false;
+  }
+  const auto& series = series_it->second;
+
+  bool low_ok = false;
+  const double low = _value_low->text().toDouble(&low_ok);
+  if (!low_ok)
+  {
+    _status->setText(tr("Enter a value"));
+    return false;
+  }
+  const auto predicate = EventQuery::Predicate(_predicate_combo->currentData().toInt());
+  double high = 0;
+  if (_value_high->isEnabled())
+  {
+    bool high_ok = false;
+    high = _value_high->text().toDouble(&high_ok);
+    if (!high_ok)
+    {
+      _status->setText(tr("Enter the upper value"));
+      return false;
+    }
+  }
+
+  // reuse the index while nothing changed; a streaming series that grew or
+  // was trimmed since the last search gets a fresh one
+  if (_query && _query_series == series_name && _query->indexedPoints() == series.size())
+  {
+    return true;
+  }
+  _query.emplace(series, predicate, low, high);
+  _query_series = series_name;
+  return true;
+}
+
+void EventQueryDialog::findNext()
+{
+  if (!ensureQuery())
+  {
+    return;
+  }
+  const auto match = _query->nextMatch(_tracker_time());
+  if (!match)
+  {
+    _status->setText(tr("No event after the tracker (%1 in total)").arg(_query->matchCount()));
+    return;
+  }
+  _status->setText(tr("Event at t = %1 (%2 in total)")
+                       .arg(*match, 0, 'f', 3)
+                       .arg(_query->matchCount()));
+  emit matchSelected(*match);
+}
+
+void EventQueryDialog::findPrevious()
+{
+  if (!ensureQuery())
+  {
+    return;
+  }
+  const auto match = _query->previousMatch(_tracker_time());
+  if (!match)
+  {
+    _status->setText(tr("No event before the tracker (%1 in total)").arg(_query->matchCount()));
+    return;
+  }
+  _status->setText(tr("Event at t = %1 (%2 in total)")
+                       .arg(*match, 0, 'f', 3)
+                       .arg(_query->matchCount()));
+  emit matchSelected(*match);
+}
@@ -0,0 +1,74 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef EVENT_QUERY_DIALOG_H
+#define EVENT_QUERY_DIALOG_H
+
+#include <QComboBox>
+#include <QDialog>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+
+#include <functional>
+#include <optional>
+
+#include "PlotJuggler/plotdata.h"
+#include "PlotJuggler/util/event_query.hpp"
+
+/**
+ * @brief Search box over the series data (Tools -> Find Events): pick a
+ * series and a predicate like "rises above 80" and step the time tracker
+ * between the matching events with Previous / Next.
+ *
+ * The heavy lifting is done by EventQuery, which prunes whole blocks of
+ * samples from their min/max summary; the index is built the first time a
+ * query runs and rebuilt transparently when the inputs or the series
+ * change, so the search stays interactive on very large sessions. The
+ * dialog is modeless: the plots remain usable while stepping.
+ */
+class EventQueryDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  EventQueryDialog(const PJ::PlotDataMapRef& data, std::function<double()> tracker_time,
+                   QWidget* parent = nullptr);
+
+  /// Refill the series list from the data map, keeping the current
+  /// selection when it still exists. Called every time the dialog is shown.
+  void refreshSeriesList();
+
+signals:
+  /// Emitted when a match is found: the main window moves the time tracker.
+  void matchSelected(double time);
+
+private slots:
+  void findNext();
+  void findPrevious();
+  void invalidateQuery();
+
+private:
+  /// Build (or reuse) the EventQuery for the current inputs.
+  /// Returns false, explaining in the status label, when that's impossible.
+  bool ensureQuery();
+
+  const PJ::PlotDataMapRef& _data;
+  std::function<double()> _tracker_time;
+
+  QComboBox* _series_combo;
+  QComboBox* _predicate_combo;
+  QLineEdit* _value_low;
+  QLineEdit* _value_high;
+  QLabel* _status;
+  QPushButton* _prev_button;
+  QPushButton* _next_button;
+
+  std::optional<PJ::EventQuery> _query;
+  std::string _query_series;
+};
+
+#endif  // EVENT_QUERY_DIALOG_H
@@ -0,0 +1,189 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "headless_benchmark.h"
+
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QDomDocument>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "plugin_manager.h"
+#include "PlotJuggler/dataloader_base.h"
+
+using namespace PJ;
+
+int RunHeadlessBenchmark(const QString& datafile, const QString& config_file,
+                         const QStringList& extra_plugin_folders)
+{
+  if (!QFileInfo::exists(datafile))
+  {
+    std::cerr << "Benchmark: file not found: " << datafile.toStdString() << std::endl;
+    return -1;
+  }
+
+  QJsonObject result;
+  result["file"] = datafile;
+  QJsonObject timings;
+  QElapsedTimer timer;
+
+  // ------ stage: plugin loading ------
+  timer.start();
+  PluginManager plugin_manager;
+  QStringList plugin_folders = extra_plugin_folders;
+  plugin_folders += QCoreApplication::applicationDirPath();
+  plugin_folders += PJ_PLUGIN_INSTALL_DIRECTORY;
+  plugin_folders.removeDuplicates();
+  for (const auto& folder : plugin_folders)
+  {
+    plugin_manager.loadPluginsFromFolder(folder);
+  }
+
+  // same wiring as MainWindow::initializePlugins(), limited to loaders
+  ParserFactories parser_factories;
+  for (const auto& [plugin_name, parser] : plugin_manager.parserFactories())
+  {
+    auto encodings = QString(parser->encoding()).split(";");
+    for (const auto& encoding : encodings)
+    {
+      parser_factories.insert(std::make_pair(encoding, parser));
+    }
+  }
+  for (const auto& [plugin_name, loader] : plugin_manager.dataLoaders())
+  {
+    loader->setParserFactories(&parser_factories);
+  }
+  timings["plugin_load_ms"] = double(timer.nsecsElapsed()) * 1e-6;
+
+  // ------ pick the loader by extension, like MainWindow::loadDataFromFile().
+  // With multiple candidates we take the first one (alphabetical by plugin
+  // name) instead of asking, to stay deterministic and headless.
+  const QString extension = QFileInfo(datafile).suffix().toLower();
+  DataLoaderPtr dataloader;
+  for (const auto& [plugin_name, loader] : plugin_manager.dataLoaders())
+  {
+    for (const char* ext : loader->compatibleFileExtensions())
+    {
+      if (extension == QString(ext).toLower())
+      {
+        dataloader = loader;
+        result["loader"] = plugin_name;
+        break;
+      }
+    }
+    if (dataloader)
+    {
+      break;
+    }
+  }
+  if (!dataloader)
+  {
+    std::cerr << "Benchmark: no DataLoader plugin accepts the extension [ "
+              << extension.toStdString() << " ]" << std::endl;
+    return -1;
+  }
+
+  FileLoadInfo info;
+  info.filename = datafile;
+
+  if (!config_file.isEmpty())
+  {
+    QFile file(config_file);
+    if (!file.open(QFile::ReadOnly | QFile::Text) || !info.plugin_config.setContent(&file))
+    {
+      std::cerr << "Benchmark: can't parse the plugin configuration: "
+                << config_file.toStdString() << std::endl;
+      return -1;
+    }
+    dataloader->xmlLoadState(info.plugin_config.firstChildElement());
+  }
+
+  // ------ stage: raw I/O ------
+  // Read the whole file once to separate disk/page-cache throughput from
+  // the parsing cost. Note that this also warms the cache for the parse
+  // stage, which is usually what we want when comparing two commits.
+  timer.restart();
+  {
+    QFile file(datafile);
+    if (!file.open(QFile::ReadOnly))
+    {
+      std::cerr << "Benchmark: cannot read file: " << datafile.toStdString() << std::endl;
+      return -1;
+    }
+    QByteArray content = file.readAll();
+    result["file_size_bytes"] = double(content.size());
+  }
+  timings["io_read_ms"] = double(timer.nsecsElapsed()) * 1e-6;
+
+  // ------ stage: parse ------
+  PlotDataMapRef loaded_data;
+  timer.restart();
+  if (!dataloader->readDataFromFile(&info, loaded_data))
+  {
+    std::cerr << "Benchmark: the plugin failed to parse the file" << std::endl;
+    return -1;
+  }
+  timings["parse_ms"] = double(timer.nsecsElapsed()) * 1e-6;
+
+  // ------ stage: map merge ------
+  // Same node-recycling pattern used by MainWindow::importPlotDataMap():
+  // series are moved into the destination map, never copied.
+  PlotDataMapRef destination;
+  timer.restart();
+  destination.groups = loaded_data.groups;
+  auto move_series = [](auto& source, auto& dest) {
+    while (!source.empty())
+    {
+      dest.insert(source.extract(source.begin()));
+    }
+  };
+  move_series(loaded_data.numeric, destination.numeric);
+  move_series(loaded_data.scatter_xy, destination.scatter_xy);
+  move_series(loaded_data.strings, destination.strings);
+  move_series(loaded_data.user_defined, destination.user_defined);
+  timings["map_merge_ms"] = double(timer.nsecsElapsed()) * 1e-6;
+
+  // ------ stage: range computation ------
+  size_t total_points = 0;
+  timer.restart();
+  for (auto& [name, series] : destination.numeric)
+  {
+    total_points += series.size();
+    auto range_x = series.rangeX();
+    auto range_y = series.rangeY();
+    (void)range_x;
+    (void)range_y;
+  }
+  for (auto& [name, series] : destination.strings)
+  {
+    total_points += series.size();
+    auto range_x = series.rangeX();
+    (void)range_x;
+  }
+  timings["range_ms"] = double(timer.nsecsElapsed()) * 1e-6;
+
+  double total_ms = 0;
+  for (const auto& key : timings.keys())
+  {
+    total_ms += timings[key].toDouble();
+  }
+  timings["total_ms"] = total_ms;
+
+  result["num_series"] =
+      double(destination.numeric.size() + destination.strings.size() +
+             destination.scatter_xy.size() + destination.user_defined.size());
+  result["num_points"] = double(total_points);
+  result["memory_usage_bytes"] = double(destination.memoryUsage());
+  result["timings"] = timings;
+
+  std::cout << QJsonDocument(result).toJson(QJsonDocument::Indented).toStdString() << std::endl;
+  return 0;
+}
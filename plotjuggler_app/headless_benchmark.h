@@ -0,0 +1,29 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef HEADLESS_BENCHMARK_H
+#define HEADLESS_BENCHMARK_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * Load a datafile through the DataLoader plugins without showing the UI,
+ * and print per-stage timings (I/O, parse, map merge, range computation)
+ * as JSON on stdout. Used to track load-time regressions per commit:
+ *
+ *   plotjuggler -n --benchmark datasamples/bench_1M.csv
+ *
+ * Loaders that need a configuration (e.g. the CSV timestamp column) will
+ * still open their dialog unless a saved plugin configuration is provided
+ * with --benchmark_config.
+ *
+ * @return the process exit code (0 on success).
+ */
+int RunHeadlessBenchmark(const QString& datafile, const QString& config_file,
+                         const QStringList& extra_plugin_folders);
+
+#endif  // HEADLESS_BENCHMARK_H
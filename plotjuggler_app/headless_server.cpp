@@ -0,0 +1,603 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "headless_server.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QTimer>
+#include <QWebSocket>
+#include <QWebSocketServer>
+#include <QtEndian>
+
+#include "plugin_manager.h"
+#include "PlotJuggler/dataloader_base.h"
+#include "PlotJuggler/datastreamer_base.h"
+
+using namespace PJ;
+
+// Wire format shared with DataStreamPlotJugglerBridge/websocket_client.cpp:
+// 16-byte little-endian header [magic][message_count][uncompressed_size][flags]
+// followed by repeated v1 blocks [u16 name_len][name][u64 ts_ns][u32 len][payload].
+// We always set FLAG_UNCOMPRESSED: the payloads are short JSON snippets and
+// skipping zstd keeps this file free of extra dependencies.
+static constexpr uint32_t PJRB_MAGIC = 0x42524A50;  // "PJRB"
+static constexpr uint32_t FLAG_UNCOMPRESSED = 0x2;
+static constexpr int FRAME_PAYLOAD_LIMIT = 256 * 1024;
+
+template <typename T>
+static void AppendLE(QByteArray& buffer, T value)
+{
+  T little_endian = qToLittleEndian(value);
+  buffer.append(reinterpret_cast<const char*>(&little_endian), sizeof(T));
+}
+
+/**
+ * Serves the numeric series of the loaded datafiles and of an optional
+ * streaming plugin to remote PlotJuggler instances, implementing the server
+ * side of the protocol expected by the DataStreamPlotJugglerBridge client:
+ * JSON text commands (get_topics / subscribe / pause / resume / heartbeat)
+ * plus binary PJRB data frames. Each series is exposed as one topic with
+ * encoding "json" and per-sample payload {"value": <number>}.
+ *
+ * A client that advertises "viewport_negotiation" at subscribe time may send
+ * "set_viewport" with its visible time range and horizontal pixel budget:
+ * batches are then decimated to one min/max pair per pixel column, and a
+ * zoom-in rewinds the cursors so the visible window is resent at the finer
+ * resolution.
+ */
+class HeadlessServer : public QObject
+{
+public:
+  explicit HeadlessServer(quint16 port)
+    : _port(port), _server("plotjuggler_headless", QWebSocketServer::NonSecureMode)
+  {
+  }
+
+  bool init(const QStringList& datafiles, const QString& config_file,
+            const QString& streamer_name, const QStringList& extra_plugin_folders)
+  {
+    QStringList plugin_folders = extra_plugin_folders;
+    plugin_folders += QCoreApplication::applicationDirPath();
+    plugin_folders += PJ_PLUGIN_INSTALL_DIRECTORY;
+    plugin_folders.removeDuplicates();
+    for (const auto& folder : plugin_folders)
+    {
+      _plugin_manager.loadPluginsFromFolder(folder);
+    }
+
+    // same wiring as MainWindow::initializePlugins()
+    for (const auto& [plugin_name, parser] : _plugin_manager.parserFactories())
+    {
+      auto encodings = QString(parser->encoding()).split(";");
+      for (const auto& encoding : encodings)
+      {
+        _parser_factories.insert(std::make_pair(encoding, parser));
+      }
+    }
+    for (const auto& [plugin_name, loader] : _plugin_manager.dataLoaders())
+    {
+      loader->setParserFactories(&_parser_factories);
+    }
+
+    for (const auto& datafile : datafiles)
+    {
+      if (!loadDatafile(datafile, config_file))
+      {
+        return false;
+      }
+    }
+
+    if (!streamer_name.isEmpty() && !startStreamer(streamer_name))
+    {
+      return false;
+    }
+
+    if (!_server.listen(QHostAddress::Any, _port))
+    {
+      std::cerr << "Headless server: can't listen on port " << _port << ": "
+                << _server.errorString().toStdString() << std::endl;
+      return false;
+    }
+    connect(&_server, &QWebSocketServer::newConnection, this,
+            [this]() { onNewConnection(); });
+
+    std::cout << "Headless server listening on port " << _port << std::endl;
+    return true;
+  }
+
+private:
+  struct ClientState
+  {
+    std::set<std::string> topics;
+    bool paused = false;
+    // incremental cursor: only samples newer than this are sent
+    std::map<std::string, double> last_sent_time;
+    // last viewport reported with "set_viewport", when negotiated
+    bool has_viewport = false;
+    double view_min = 0;
+    double view_max = 0;
+    int pixel_width = 0;
+  };
+
+  bool loadDatafile(const QString& datafile, const QString& config_file)
+  {
+    if (!QFileInfo::exists(datafile))
+    {
+      std::cerr << "Headless server: file not found: " << datafile.toStdString() << std::endl;
+      return false;
+    }
+
+    // pick the loader by extension, first candidate wins (see the same
+    // deterministic choice in RunHeadlessBenchmark)
+    const QString extension = QFileInfo(datafile).suffix().toLower();
+    DataLoaderPtr dataloader;
+    for (const auto& [plugin_name, loader] : _plugin_manager.dataLoaders())
+    {
+      for (const char* ext : loader->compatibleFileExtensions())
+      {
+        if (extension == QString(ext).toLower())
+        {
+          dataloader = loader;
+          break;
+        }
+      }
+      if (dataloader)
+      {
+        break;
+      }
+    }
+    if (!dataloader)
+    {
+      std::cerr << "Headless server: no DataLoader plugin accepts the extension [ "
+                << extension.toStdString() << " ]" << std::endl;
+      return false;
+    }
+
+    FileLoadInfo info;
+    info.filename = datafile;
+    if (!config_file.isEmpty())
+    {
+      QFile file(config_file);
+      if (!file.open(QFile::ReadOnly | QFile::Text) || !info.plugin_config.setContent(&file))
+      {
+        std::cerr << "Headless server: can't parse the plugin configuration: "
+                  << config_file.toStdString() << std::endl;
+        return false;
+      }
+      dataloader->xmlLoadState(info.plugin_config.firstChildElement());
+    }
+
+    PlotDataMapRef loaded;
+    if (!dataloader->readDataFromFile(&info, loaded))
+    {
+      std::cerr << "Headless server: the plugin failed to parse: " << datafile.toStdString()
+                << std::endl;
+      return false;
+    }
+
+    // move the series into the served map, never copy
+    auto move_series = [](auto& source, auto& dest) {
+      while (!source.empty())
+      {
+        dest.insert(source.extract(source.begin()));
+      }
+    };
+    _loaded_data.groups.insert(loaded.groups.begin(), loaded.groups.end());
+    move_series(loaded.numeric, _loaded_data.numeric);
+    move_series(loaded.scatter_xy, _loaded_data.scatter_xy);
+    move_series(loaded.strings, _loaded_data.strings);
+    move_series(loaded.user_defined, _loaded_data.user_defined);
+
+    std::cout << "Headless server: loaded " << datafile.toStdString() << " ("
+              << _loaded_data.numeric.size() << " numeric series)" << std::endl;
+    return true;
+  }
+
+  bool startStreamer(const QString& streamer_name)
+  {
+    auto it = _plugin_manager.dataStreamers().find(streamer_name);
+    if (it == _plugin_manager.dataStreamers().end())
+    {
+      std::cerr << "Headless server: streaming plugin not found: "
+                << streamer_name.toStdString() << std::endl;
+      for (const auto& [plugin_name, streamer] : _plugin_manager.dataStreamers())
+      {
+        std::cerr << "  available: " << plugin_name.toStdString() << std::endl;
+      }
+      return false;
+    }
+    _streamer = it->second;
+    _streamer->setParserFactories(&_parser_factories);
+    // generous buffer: clients may connect late and still want history
+    _streamer->setMaximumRangeX(600.0);
+
+    if (!_streamer->start(nullptr))
+    {
+      std::cerr << "Headless server: the streaming plugin failed to start" << std::endl;
+      _streamer.reset();
+      return false;
+    }
+
+    connect(_streamer.get(), &DataStreamer::closed, this, [this]() {
+      std::cerr << "Headless server: the streaming plugin closed" << std::endl;
+      _flush_timer.stop();
+    });
+
+    // push the new samples to the subscribed clients at a fixed rate,
+    // instead of once per dataReceived() signal
+    _flush_timer.setInterval(250);
+    connect(&_flush_timer, &QTimer::timeout, this, [this]() { flushAllClients(); });
+    _flush_timer.start();
+    return true;
+  }
+
+  void onNewConnection()
+  {
+    while (auto* socket = _server.nextPendingConnection())
+    {
+      _clients.emplace(socket, ClientState{});
+      connect(socket, &QWebSocket::textMessageReceived, this,
+              [this, socket](const QString& message) { onCommand(socket, message); });
+      connect(socket, &QWebSocket::disconnected, this, [this, socket]() {
+        _clients.erase(socket);
+        socket->deleteLater();
+      });
+    }
+  }
+
+  void onCommand(QWebSocket* socket, const QString& message)
+  {
+    auto client_it = _clients.find(socket);
+    if (client_it == _clients.end())
+    {
+      return;
+    }
+    ClientState& client = client_it->second;
+
+    QJsonParseError err;
+    const auto doc = QJsonDocument::fromJson(message.toUtf8(), &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject())
+    {
+      return;
+    }
+    const auto cmd_obj = doc.object();
+    const auto command = cmd_obj.value("command").toString();
+
+    QJsonObject reply;
+    reply["protocol_version"] = 1;
+    reply["id"] = cmd_obj.value("id").toString();
+    reply["status"] = "success";
+
+    if (command == "get_topics")
+    {
+      QJsonArray topics;
+      for (const auto& name : topicNames())
+      {
+        QJsonObject topic;
+        topic["name"] = QString::fromStdString(name);
+        topic["type"] = "numeric";
+        topics.append(topic);
+      }
+      reply["topics"] = topics;
+    }
+    else if (command == "subscribe")
+    {
+      const auto available = topicNames();
+      client.topics.clear();
+      client.last_sent_time.clear();
+
+      QJsonObject schemas;
+      for (const auto& value : cmd_obj.value("topics").toArray())
+      {
+        const auto name = value.toString().toStdString();
+        if (available.count(name) == 0)
+        {
+          continue;
+        }
+        client.topics.insert(name);
+        client.last_sent_time[name] = -std::numeric_limits<double>::max();
+
+        QJsonObject schema;
+        schema["name"] = "";
+        schema["encoding"] = "json";
+        schema["definition"] = "";
+        schemas[QString::fromStdString(name)] = schema;
+      }
+      // note: "binary_version" is deliberately not echoed; this server
+      // only produces v1 frames
+      reply["schemas"] = schemas;
+
+      // accept viewport-driven decimation when the client supports it
+      if (cmd_obj.value("viewport_negotiation").toBool(false))
+      {
+        reply["viewport_negotiation"] = true;
+      }
+    }
+    else if (command == "pause")
+    {
+      client.paused = true;
+    }
+    else if (command == "resume")
+    {
+      client.paused = false;
+    }
+    else if (command == "set_viewport")
+    {
+      const double min_time = cmd_obj.value("min_time").toDouble();
+      const double max_time = cmd_obj.value("max_time").toDouble();
+      const int pixel_width = cmd_obj.value("pixel_width").toInt();
+      if (pixel_width <= 0 || !(max_time > min_time))
+      {
+        reply["status"] = "error";
+        reply["message"] = "Invalid viewport";
+      }
+      else
+      {
+        // when the visible range moved meaningfully, rewind the cursors so
+        // the window is resent at the new resolution. The client merges
+        // samples by timestamp, so re-sending already-delivered points is
+        // harmless, and the resend is bounded by ~2 samples per pixel
+        const double span = max_time - min_time;
+        const bool range_changed = !client.has_viewport ||
+                                   std::abs(min_time - client.view_min) > span * 0.01 ||
+                                   std::abs(max_time - client.view_max) > span * 0.01;
+        client.has_viewport = true;
+        client.view_min = min_time;
+        client.view_max = max_time;
+        client.pixel_width = pixel_width;
+        if (range_changed)
+        {
+          for (auto& [topic, last_time] : client.last_sent_time)
+          {
+            last_time = std::min(last_time, min_time);
+          }
+        }
+      }
+    }
+    else if (command == "heartbeat")
+    {
+      // keep-alive only
+    }
+    else
+    {
+      reply["status"] = "error";
+      reply["message"] = QString("Unknown command [%1]").arg(command);
+    }
+
+    socket->sendTextMessage(
+        QString::fromUtf8(QJsonDocument(reply).toJson(QJsonDocument::Compact)));
+
+    if (command == "subscribe" || command == "resume" || command == "set_viewport")
+    {
+      // send the backlog right away, without waiting for the flush timer
+      flushClient(socket, client);
+    }
+  }
+
+  std::set<std::string> topicNames() const
+  {
+    std::set<std::string> names;
+    for (const auto& [name, series] : _loaded_data.numeric)
+    {
+      names.insert(name);
+    }
+    if (_streamer)
+    {
+      std::lock_guard<std::mutex> lock(_streamer->mutex());
+      for (const auto& [name, series] : _streamer->dataMap().numeric)
+      {
+        names.insert(name);
+      }
+    }
+    return names;
+  }
+
+  // append the samples of `series` newer than `last_time` to `out`,
+  // and advance the cursor
+  static void collectNewSamples(const PlotData& series, double& last_time,
+                                std::vector<PlotData::Point>& out)
+  {
+    // samples are sorted by time: binary search the first unseen one
+    size_t low = 0;
+    size_t high = series.size();
+    while (low < high)
+    {
+      const size_t mid = (low + high) / 2;
+      if (series.at(mid).x <= last_time)
+      {
+        low = mid + 1;
+      }
+      else
+      {
+        high = mid;
+      }
+    }
+    for (size_t i = low; i < series.size(); i++)
+    {
+      out.push_back(series.at(i));
+    }
+    if (!out.empty())
+    {
+      last_time = out.back().x;
+    }
+  }
+
+  // Reduce `samples` to the min and max of every bucket of `bucket_width`
+  // seconds (kept in time order): at one bucket per pixel column the drawn
+  // envelope of the series is unchanged. Buckets are aligned on absolute
+  // time, so consecutive flushes fall into the same grid. Samples newer
+  // than `live_edge` are passed through untouched: a stale viewport must
+  // never thin the live tail the client has not displayed yet.
+  static void decimateToBuckets(std::vector<PlotData::Point>& samples, double bucket_width,
+                                double live_edge)
+  {
+    if (bucket_width <= 0 || samples.size() < 3)
+    {
+      return;
+    }
+    std::vector<PlotData::Point> out;
+    out.reserve(samples.size());
+
+    size_t i = 0;
+    while (i < samples.size() && samples[i].x <= live_edge)
+    {
+      const double bucket_id = std::floor(samples[i].x / bucket_width);
+      size_t min_idx = i;
+      size_t max_idx = i;
+      size_t j = i;
+      while (j < samples.size() && samples[j].x <= live_edge &&
+             std::floor(samples[j].x / bucket_width) == bucket_id)
+      {
+        if (samples[j].y < samples[min_idx].y)
+        {
+          min_idx = j;
+        }
+        if (samples[j].y > samples[max_idx].y)
+        {
+          max_idx = j;
+        }
+        j++;
+      }
+      out.push_back(samples[std::min(min_idx, max_idx)]);
+      if (min_idx != max_idx)
+      {
+        out.push_back(samples[std::max(min_idx, max_idx)]);
+      }
+      i = j;
+    }
+    // the live tail, beyond the last viewport the client reported
+    for (; i < samples.size(); i++)
+    {
+      out.push_back(samples[i]);
+    }
+    samples = std::move(out);
+  }
+
+  void flushClient(QWebSocket* socket, ClientState& client)
+  {
+    if (client.paused || client.topics.empty())
+    {
+      return;
+    }
+
+    QByteArray payload;
+    uint32_t message_count = 0;
+
+    auto send_frame = [&]() {
+      if (message_count == 0)
+      {
+        return;
+      }
+      QByteArray frame;
+      frame.reserve(16 + payload.size());
+      AppendLE<uint32_t>(frame, PJRB_MAGIC);
+      AppendLE<uint32_t>(frame, message_count);
+      AppendLE<uint32_t>(frame, uint32_t(payload.size()));
+      AppendLE<uint32_t>(frame, FLAG_UNCOMPRESSED);
+      frame.append(payload);
+      socket->sendBinaryMessage(frame);
+      payload.clear();
+      message_count = 0;
+    };
+
+    std::vector<PlotData::Point> samples;
+    for (const auto& topic : client.topics)
+    {
+      double& last_time = client.last_sent_time[topic];
+      samples.clear();
+
+      auto loaded_it = _loaded_data.numeric.find(topic);
+      if (loaded_it != _loaded_data.numeric.end())
+      {
+        collectNewSamples(loaded_it->second, last_time, samples);
+      }
+      else if (_streamer)
+      {
+        std::lock_guard<std::mutex> lock(_streamer->mutex());
+        _streamer->drainStreamedSamples();
+        auto streamed_it = _streamer->dataMap().numeric.find(topic);
+        if (streamed_it != _streamer->dataMap().numeric.end())
+        {
+          collectNewSamples(streamed_it->second, last_time, samples);
+        }
+      }
+
+      // the cursor advanced on the raw samples above: decimation only
+      // affects what goes on the wire
+      if (client.has_viewport && client.pixel_width > 0 && client.view_max > client.view_min)
+      {
+        const double bucket_width = (client.view_max - client.view_min) / client.pixel_width;
+        decimateToBuckets(samples, bucket_width, client.view_max);
+      }
+
+      for (const auto& point : samples)
+      {
+        if (!std::isfinite(point.y))
+        {
+          continue;  // would not be representable in JSON
+        }
+        const uint64_t ts_ns = point.x > 0 ? uint64_t(point.x * 1e9) : 0;
+        const QByteArray json = "{\"value\":" + QByteArray::number(point.y, 'g', 17) + "}";
+
+        AppendLE<uint16_t>(payload, uint16_t(topic.size()));
+        payload.append(topic.data(), int(topic.size()));
+        AppendLE<uint64_t>(payload, ts_ns);
+        AppendLE<uint32_t>(payload, uint32_t(json.size()));
+        payload.append(json);
+        message_count++;
+
+        if (payload.size() >= FRAME_PAYLOAD_LIMIT)
+        {
+          send_frame();
+        }
+      }
+    }
+    send_frame();
+  }
+
+  void flushAllClients()
+  {
+    for (auto& [socket, client] : _clients)
+    {
+      flushClient(socket, client);
+    }
+  }
+
+  quint16 _port;
+  QWebSocketServer _server;
+  PluginManager _plugin_manager;
+  ParserFactories _parser_factories;
+  PlotDataMapRef _loaded_data;
+  DataStreamerPtr _streamer;
+  QTimer _flush_timer;
+  std::map<QWebSocket*, ClientState> _clients;
+};
+
+int RunHeadlessServer(quint16 port, const QStringList& datafiles, const QString& config_file,
+                      const QString& streamer_name, const QStringList& extra_plugin_folders)
+{
+  HeadlessServer server(port);
+  if (!server.init(datafiles, config_file, streamer_name, extra_plugin_folders))
+  {
+    return -1;
+  }
+  return QCoreApplication::exec();
+}
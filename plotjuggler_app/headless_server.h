@@ -0,0 +1,36 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef HEADLESS_SERVER_H
+#define HEADLESS_SERVER_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * Run PlotJuggler without instantiating the MainWindow widget tree: load the
+ * given datafiles through the DataLoader plugins, optionally start a streaming
+ * plugin, and republish every numeric series on a WebSocket server that speaks
+ * the same protocol as the DataStreamPlotJugglerBridge client plugin.
+ *
+ * A remote PlotJuggler can then connect with "WebSocket Client", discover the
+ * series as topics and subscribe; samples are delivered as PJRB v1 binary
+ * frames with encoding "json", so no extra parser plugin is needed on the
+ * client. This keeps ingestion and parsing next to the data, while analyst
+ * machines only receive the processed series:
+ *
+ *   plotjuggler -n --headless_server 9090 -d flight_log.csv
+ *
+ * Like --benchmark, loaders that need a configuration will still open their
+ * dialog unless a saved plugin configuration is provided with
+ * --benchmark_config.
+ *
+ * @return the process exit code (runs the event loop until terminated).
+ */
+int RunHeadlessServer(quint16 port, const QStringList& datafiles, const QString& config_file,
+                      const QString& streamer_name, const QStringList& extra_plugin_folders);
+
+#endif  // HEADLESS_SERVER_H
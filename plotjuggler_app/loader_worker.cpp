@@ -0,0 +1,128 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "loader_worker.h"
+
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+
+#include "plugin_manager.h"
+#include "PlotJuggler/dataloader_base.h"
+#include "PlotJuggler/session_dump.h"
+
+using namespace PJ;
+
+int RunLoaderWorker(const QString& datafile, const QString& output_file,
+                    const QString& plugin_name, const QString& config_file,
+                    const QStringList& extra_plugin_folders)
+{
+  if (!QFileInfo::exists(datafile))
+  {
+    std::cerr << "Loader worker: file not found: " << datafile.toStdString() << std::endl;
+    return -1;
+  }
+
+  // same plugin wiring as RunHeadlessBenchmark, limited to loaders
+  PluginManager plugin_manager;
+  QStringList plugin_folders = extra_plugin_folders;
+  plugin_folders += QCoreApplication::applicationDirPath();
+  plugin_folders += PJ_PLUGIN_INSTALL_DIRECTORY;
+  plugin_folders.removeDuplicates();
+  for (const auto& folder : plugin_folders)
+  {
+    plugin_manager.loadPluginsFromFolder(folder);
+  }
+
+  ParserFactories parser_factories;
+  for (const auto& [name, parser] : plugin_manager.parserFactories())
+  {
+    auto encodings = QString(parser->encoding()).split(";");
+    for (const auto& encoding : encodings)
+    {
+      parser_factories.insert(std::make_pair(encoding, parser));
+    }
+  }
+  for (const auto& [name, loader] : plugin_manager.dataLoaders())
+  {
+    loader->setParserFactories(&parser_factories);
+  }
+
+  DataLoaderPtr dataloader;
+  if (!plugin_name.isEmpty())
+  {
+    auto it = plugin_manager.dataLoaders().find(plugin_name);
+    if (it == plugin_manager.dataLoaders().end())
+    {
+      std::cerr << "Loader worker: plugin not found: " << plugin_name.toStdString() << std::endl;
+      return -1;
+    }
+    dataloader = it->second;
+  }
+  else
+  {
+    const QString extension = QFileInfo(datafile).suffix().toLower();
+    for (const auto& [name, loader] : plugin_manager.dataLoaders())
+    {
+      for (const char* ext : loader->compatibleFileExtensions())
+      {
+        if (extension == QString(ext).toLower())
+        {
+          dataloader = loader;
+          break;
+        }
+      }
+      if (dataloader)
+      {
+        break;
+      }
+    }
+    if (!dataloader)
+    {
+      std::cerr << "Loader worker: no DataLoader plugin accepts the file" << std::endl;
+      return -1;
+    }
+  }
+
+  FileLoadInfo info;
+  info.filename = datafile;
+  if (!config_file.isEmpty())
+  {
+    QFile file(config_file);
+    if (!file.open(QFile::ReadOnly | QFile::Text) || !info.plugin_config.setContent(&file))
+    {
+      std::cerr << "Loader worker: can't parse the plugin configuration: "
+                << config_file.toStdString() << std::endl;
+      return -1;
+    }
+    dataloader->xmlLoadState(info.plugin_config.firstChildElement());
+  }
+
+  PlotDataMapRef loaded_data;
+  try
+  {
+    if (!dataloader->readDataFromFile(&info, loaded_data))
+    {
+      std::cerr << "Loader worker: the plugin failed to parse the file" << std::endl;
+      return -1;
+    }
+  }
+  catch (std::exception& ex)
+  {
+    std::cerr << "Loader worker: exception from the plugin: " << ex.what() << std::endl;
+    return -1;
+  }
+
+  if (!SaveSessionDump(loaded_data, output_file))
+  {
+    std::cerr << "Loader worker: can't write the dump: " << output_file.toStdString()
+              << std::endl;
+    return -1;
+  }
+  return 0;
+}
@@ -0,0 +1,33 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LOADER_WORKER_H
+#define LOADER_WORKER_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * Entry point of the (internal) --loader_worker mode: run a DataLoader plugin
+ * on the given datafile and write the resulting series as a session dump to
+ * output_file.
+ *
+ * The main process spawns this as a child when "sandboxed loaders" is enabled
+ * in the Preferences, then maps the dump read-only with LoadSessionDump():
+ * a plugin that crashes on a malformed file kills only the worker, and the
+ * peak memory used while parsing is released when the worker exits.
+ *
+ * @param plugin_name exact DataLoader name chosen by the parent, or empty to
+ *                    pick the first loader compatible with the file extension.
+ * @param config_file optional XML with the loader configuration, same format
+ *                    as FileLoadInfo::plugin_config.
+ * @return the process exit code (0 on success).
+ */
+int RunLoaderWorker(const QString& datafile, const QString& output_file,
+                    const QString& plugin_name, const QString& config_file,
+                    const QStringList& extra_plugin_folders);
+
+#endif  // LOADER_WORKER_H
@@ -5,6 +5,10 @@
  */
 
 #include "mainwindow.h"
+#include "headless_benchmark.h"
+#include "parser_benchmark.h"
+#include "headless_server.h"
+#include "loader_worker.h"
 #include <iostream>
 #include <QApplication>
 #include <QSplashScreen>
@@ -224,6 +228,14 @@ int main(int argc, char* argv[])
                                    "Load a file containing the layout configuration", "file_path");
   parser.addOption(layout_option);
 
+  QCommandLineOption attach_option(
+      QStringList() << "attach",
+      "Attach read-only to an already materialized session: a \".pjdata\" dump "
+      "or the autosave checkpoint directory of another instance. The source is "
+      "never modified and the layout of this instance stays its own",
+      "path");
+  parser.addOption(attach_option);
+
   QCommandLineOption publish_option(QStringList() << "p"
                                                   << "publish",
                                     "Automatically start publisher when loading the "
@@ -273,6 +285,70 @@ int main(int argc, char* argv[])
                                   "window_title");
   parser.addOption(window_title);
 
+  QCommandLineOption benchmark_option(QStringList() << "benchmark",
+                                      "Load the given file headless (no UI) and print "
+                                      "per-stage timings as JSON on stdout",
+                                      "file_path");
+  parser.addOption(benchmark_option);
+
+  QCommandLineOption benchmark_parser_option(
+      QStringList() << "benchmark_parser",
+      "Replay the given PJCAPTURE message capture through the matching "
+      "MessageParser (no UI) and print msgs/sec and bytes/sec as JSON",
+      "file_path");
+  parser.addOption(benchmark_parser_option);
+
+  QCommandLineOption benchmark_loops_option(QStringList() << "benchmark_loops",
+                                            "Number of replay loops in --benchmark_parser "
+                                            "(default: 10)",
+                                            "count", "10");
+  parser.addOption(benchmark_loops_option);
+
+  QCommandLineOption benchmark_config_option(
+      QStringList() << "benchmark_config",
+      "XML file with the plugin configuration to use in benchmark or headless "
+      "server mode, to avoid the configuration dialog of loaders such as DataLoadCSV",
+      "file_path");
+  parser.addOption(benchmark_config_option);
+
+  QCommandLineOption headless_server_option(
+      QStringList() << "headless_server",
+      "Run without the main window: load the datafiles given with -d and/or "
+      "start the streaming plugin given with --streamer, and republish the series "
+      "on a WebSocket server compatible with the \"WebSocket Client\" plugin",
+      "port");
+  parser.addOption(headless_server_option);
+
+  QCommandLineOption streamer_name_option(
+      QStringList() << "streamer",
+      "Name of the streaming plugin to start in headless server mode", "plugin_name");
+  parser.addOption(streamer_name_option);
+
+  // internal options used by the "sandboxed loaders" worker process
+  QCommandLineOption loader_worker_option(QStringList() << "loader_worker",
+                                          "INTERNAL: parse the given datafile in worker mode",
+                                          "file_path");
+  loader_worker_option.setFlags(QCommandLineOption::HiddenFromHelp);
+  parser.addOption(loader_worker_option);
+
+  QCommandLineOption loader_output_option(QStringList() << "loader_output",
+                                          "INTERNAL: where the worker writes the session dump",
+                                          "file_path");
+  loader_output_option.setFlags(QCommandLineOption::HiddenFromHelp);
+  parser.addOption(loader_output_option);
+
+  QCommandLineOption loader_plugin_option(QStringList() << "loader_plugin",
+                                          "INTERNAL: name of the DataLoader plugin to use",
+                                          "plugin_name");
+  loader_plugin_option.setFlags(QCommandLineOption::HiddenFromHelp);
+  parser.addOption(loader_plugin_option);
+
+  QCommandLineOption loader_config_option(QStringList() << "loader_config",
+                                          "INTERNAL: XML file with the loader configuration",
+                                          "file_path");
+  loader_config_option.setFlags(QCommandLineOption::HiddenFromHelp);
+  parser.addOption(loader_config_option);
+
   parser.process(*qApp);
 
   if (parser.isSet(publish_option) && !parser.isSet(layout_option))
@@ -304,6 +380,70 @@ int main(int argc, char* argv[])
     }
   }
 
+  if (parser.isSet(loader_worker_option))
+  {
+    if (!parser.isSet(loader_output_option))
+    {
+      std::cerr << "Option [ --loader_worker ] requires [ --loader_output ]." << std::endl;
+      return -1;
+    }
+    QStringList extra_folders;
+    if (parser.isSet(folder_option))
+    {
+      extra_folders = parser.value(folder_option).split(";", PJ::SkipEmptyParts);
+    }
+    return RunLoaderWorker(parser.value(loader_worker_option), parser.value(loader_output_option),
+                           parser.value(loader_plugin_option), parser.value(loader_config_option),
+                           extra_folders);
+  }
+
+  if (parser.isSet(benchmark_option))
+  {
+    QStringList extra_folders;
+    if (parser.isSet(folder_option))
+    {
+      extra_folders = parser.value(folder_option).split(";", PJ::SkipEmptyParts);
+    }
+    return RunHeadlessBenchmark(parser.value(benchmark_option),
+                                parser.value(benchmark_config_option), extra_folders);
+  }
+
+  if (parser.isSet(benchmark_parser_option))
+  {
+    bool loops_ok = false;
+    const int loops = parser.value(benchmark_loops_option).toInt(&loops_ok);
+    if (!loops_ok || loops < 1)
+    {
+      std::cerr << "Option [ --benchmark_loops ] requires a positive number." << std::endl;
+      return -1;
+    }
+    QStringList extra_folders;
+    if (parser.isSet(folder_option))
+    {
+      extra_folders = parser.value(folder_option).split(";", PJ::SkipEmptyParts);
+    }
+    return RunParserBenchmark(parser.value(benchmark_parser_option), loops, extra_folders);
+  }
+
+  if (parser.isSet(headless_server_option))
+  {
+    bool port_ok = false;
+    const quint16 port = parser.value(headless_server_option).toUShort(&port_ok);
+    if (!port_ok || port == 0)
+    {
+      std::cerr << "Option [ --headless_server ] requires a valid port number." << std::endl;
+      return -1;
+    }
+    QStringList extra_folders;
+    if (parser.isSet(folder_option))
+    {
+      extra_folders = parser.value(folder_option).split(";", PJ::SkipEmptyParts);
+    }
+    return RunHeadlessServer(port, parser.values(loadfile_option),
+                             parser.value(benchmark_config_option),
+                             parser.value(streamer_name_option), extra_folders);
+  }
+
   QIcon app_icon("://resources/plotjuggler.svg");
   QApplication::setWindowIcon(app_icon);
 
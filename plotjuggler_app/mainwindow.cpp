@@ -4,7 +4,11 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <queue>
 #include <stdio.h>
 
@@ -12,7 +16,9 @@
 #include <QActionGroup>
 #include <QCheckBox>
 #include <QCommandLineParser>
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
 #include <QDesktopServices>
 #include <QDomDocument>
 #include <QDoubleSpinBox>
@@ -26,9 +32,13 @@
 #include <QMimeData>
 #include <QMouseEvent>
 #include <QPluginLoader>
+#include <QProcess>
+#include <QProgressDialog>
 #include <QPushButton>
 #include <QKeySequence>
+#include <QScreen>
 #include <QScrollBar>
+#include <QtConcurrent/QtConcurrent>
 #include <QSettings>
 #include <QStringListModel>
 #include <QStringRef>
@@ -43,6 +53,11 @@
 #include "curvelist_panel.h"
 #include "tabbedplotwidget.h"
 #include "PlotJuggler/plotdata.h"
+#include "PlotJuggler/session_dump.h"
+#include "autosave_service.h"
+#include "cache_warmer.h"
+#include "PlotJuggler/util/perf_monitor.hpp"
+#include "PlotJuggler/util/render_governor.hpp"
 #include "transforms/function_editor.h"
 #include "transforms/lua_custom_function.h"
 #include "utils.h"
@@ -51,6 +66,13 @@
 #include "PlotJuggler/svg_util.h"
 #include "PlotJuggler/reactive_function.h"
 #include "multifile_prefix.h"
+#include "topic_filter_dialog.h"
+#include "perf_overlay.h"
+#include "memory_profile_dialog.h"
+#include "event_query_dialog.h"
+#include "point_series_xy.h"
+#include "PlotJuggler/thread_pool.h"
+#include <chrono>
 
 #include "ui_aboutdialog.h"
 #include "ui_support_dialog.h"
@@ -158,10 +180,16 @@ MainWindow::MainWindow(const QCommandLineParser& commandline_parser, QWidget* pa
     _animated_streaming_movie->jumpToFrame(0);
   });
 
-  _tracker_delay.connectCallback([this]() {
+  // coalesced refresh channels: bursts of tracker moves or curve-list
+  // changes collapse into one refresh per frame
+  PJ::CoalescingScheduler::instance().registerChannel("tracker_values", [this]() {
     updatedDisplayTime();
     onUpdateLeftTableValues();
   });
+  PJ::CoalescingScheduler::instance().registerChannel("time_slider", [this]() {
+    updateTimeOffset();
+    updateTimeSlider();
+  });
 
   ui->labelStreamingAnimation->setMovie(_animated_streaming_movie);
   ui->labelStreamingAnimation->setHidden(true);
@@ -243,6 +271,43 @@ MainWindow::MainWindow(const QCommandLineParser& commandline_parser, QWidget* pa
   _replot_timer = new QTimer(this);
   connect(_replot_timer, &QTimer::timeout, this, [this]() { updateDataAndReplot(false); });
 
+  // tail-follow of datafiles still being written: debounce the filesystem
+  // notifications, since recorders often write many small chunks in a row
+  _tail_watcher = new QFileSystemWatcher(this);
+  connect(_tail_watcher, &QFileSystemWatcher::fileChanged, this, &MainWindow::onTailFileChanged);
+  _tail_debounce_timer = new QTimer(this);
+  _tail_debounce_timer->setSingleShot(true);
+  _tail_debounce_timer->setInterval(250);
+  connect(_tail_debounce_timer, &QTimer::timeout, this, &MainWindow::onTailDebounceTimeout);
+
+  _linked_zoom_timer = new QTimer(this);
+  _linked_zoom_timer->setSingleShot(true);
+  _linked_zoom_timer->setInterval(16);
+  connect(_linked_zoom_timer, &QTimer::timeout, this, [this]() {
+    if (_linked_zoom_pending)
+    {
+      _linked_zoom_pending = false;
+      propagateLinkedZoom();
+      _linked_zoom_timer->start();
+    }
+  });
+
+  // coalesce streaming redraws to the refresh rate of the display,
+  // instead of the historical hardcoded 25 Hz
+  if (auto screen = QGuiApplication::primaryScreen())
+  {
+    const double refresh_rate = screen->refreshRate();
+    if (refresh_rate > 1.0)
+    {
+      _replot_interval_ms = std::max(5, int(1000.0 / refresh_rate + 0.5));
+    }
+  }
+
+  connect(&_reactive_watcher, &QFutureWatcher<void>::finished, this,
+          &MainWindow::onReactiveCalculationFinished);
+  _reactive_time_budget_ms = settings.value("Preferences::reactive_time_budget_ms", 100).toInt();
+  _memory_budget_mb = settings.value("Preferences::memory_budget_mb", 0).toInt();
+
   _publish_timer = new QTimer(this);
   _publish_timer->setInterval(20);
   connect(_publish_timer, &QTimer::timeout, this, &MainWindow::onPlaybackLoop);
@@ -263,6 +328,10 @@ MainWindow::MainWindow(const QCommandLineParser& commandline_parser, QWidget* pa
     QStringList datafiles = commandline_parser.values("datafile");
     file_loaded = loadDataFromFiles(datafiles);
   }
+  if (commandline_parser.isSet("attach"))
+  {
+    file_loaded |= attachSession(commandline_parser.value("attach"));
+  }
   if (commandline_parser.isSet("layout"))
   {
     loadLayoutFromFile(commandline_parser.value("layout"));
@@ -326,20 +395,6 @@ MainWindow::MainWindow(const QCommandLineParser& commandline_parser, QWidget* pa
 
   forEachWidget([&](PlotWidget* plot) { plot->configureTracker(_tracker_param); });
 
-  auto editor_layout = new QVBoxLayout();
-  editor_layout->setMargin(0);
-  ui->formulaPage->setLayout(editor_layout);
-  _function_editor = new FunctionEditorWidget(_mapped_plot_data, _transform_functions, this);
-  editor_layout->addWidget(_function_editor);
-
-  connect(_function_editor, &FunctionEditorWidget::closed, this,
-          [this]() { ui->widgetStack->setCurrentIndex(0); });
-
-  connect(this, &MainWindow::stylesheetChanged, _function_editor,
-          &FunctionEditorWidget::on_stylesheetChanged);
-
-  connect(_function_editor, &FunctionEditorWidget::accept, this, &MainWindow::onCustomPlotCreated);
-
   QString theme = settings.value("Preferences::theme", "light").toString();
   if (theme != "dark")
   {
@@ -373,6 +428,14 @@ MainWindow::MainWindow(const QCommandLineParser& commandline_parser, QWidget* pa
 
 MainWindow::~MainWindow()
 {
+  PJ::CoalescingScheduler::instance().unregisterChannel("tracker_values");
+  PJ::CoalescingScheduler::instance().unregisterChannel("time_slider");
+
+  // reactive scripts may still be running on the QtConcurrent pool
+  _reactive_watcher.waitForFinished();
+  // ...and warming tasks on the shared pool, reading series about to die
+  _cache_warmer->cancelAndWait();
+
   // important: avoid problems with plugins
   _mapped_plot_data.user_defined.clear();
 
@@ -388,6 +451,17 @@ void MainWindow::onUndoableChange()
 
   int elapsed_ms = _undo_timer.restart();
 
+  // Keep the history as compressed snapshots: a hundred parsed
+  // QDomDocuments of a large layout hold megabytes, the compressed
+  // XML only a few KB each.
+  QByteArray state = qCompress(xmlSaveState().toByteArray(-1), 6);
+
+  // spurious notification, nothing actually changed
+  if (!_undo_states.empty() && _undo_states.back() == state)
+  {
+    return;
+  }
+
   // overwrite the previous
   if (elapsed_ms < 100)
   {
@@ -401,7 +475,7 @@ void MainWindow::onUndoableChange()
   {
     _undo_states.pop_front();
   }
-  _undo_states.push_back(xmlSaveState());
+  _undo_states.push_back(std::move(state));
   _redo_states.clear();
   // qDebug() << "undo " << _undo_states.size();
 }
@@ -416,14 +490,16 @@ void MainWindow::onRedoInvoked()
   _disable_undo_logging = true;
   if (_redo_states.size() > 0)
   {
-    QDomDocument state_document = _redo_states.back();
+    QByteArray state = _redo_states.back();
     while (_undo_states.size() >= 100)
     {
       _undo_states.pop_front();
     }
-    _undo_states.push_back(state_document);
+    _undo_states.push_back(state);
     _redo_states.pop_back();
 
+    QDomDocument state_document;
+    state_document.setContent(qUncompress(state));
     xmlLoadState(state_document);
   }
   // qDebug() << "undo " << _undo_states.size();
@@ -440,15 +516,15 @@ void MainWindow::onUndoInvoked()
   _disable_undo_logging = true;
   if (_undo_states.size() > 1)
   {
-    QDomDocument state_document = _undo_states.back();
     while (_redo_states.size() >= 100)
     {
       _redo_states.pop_front();
     }
-    _redo_states.push_back(state_document);
+    _redo_states.push_back(_undo_states.back());
     _undo_states.pop_back();
-    state_document = _undo_states.back();
 
+    QDomDocument state_document;
+    state_document.setContent(qUncompress(_undo_states.back()));
     xmlLoadState(state_document);
   }
   // qDebug() << "undo " << _undo_states.size();
@@ -479,7 +555,7 @@ void MainWindow::onTimeSlider_valueChanged(double abs_time)
 
 void MainWindow::onTrackerTimeUpdated(double absolute_time, bool do_replot)
 {
-  _tracker_delay.triggerSignal(100);
+  PJ::CoalescingScheduler::instance().trigger("tracker_values", 100);
 
   for (auto& it : _plugin_manager.statePublishers())
   {
@@ -518,6 +594,16 @@ void MainWindow::initializeActions()
   connect(open_help_shortcut, &QShortcut::activated,
           [this]() { ui->menuHelp->exec(ui->menuBar->mapToGlobal(QPoint(230, 25))); });
 
+  QShortcut* perf_overlay_shortcut = new QShortcut(QKeySequence(Qt::Key_F9), this);
+  perf_overlay_shortcut->setContext(Qt::ApplicationShortcut);
+  connect(perf_overlay_shortcut, &QShortcut::activated, this, [this]() {
+    if (!_perf_overlay)
+    {
+      _perf_overlay = new PerfOverlay(this);
+    }
+    _perf_overlay->toggle();
+  });
+
   //---------------------------------------------
 
   QSettings settings;
@@ -582,6 +668,16 @@ void MainWindow::loadAllPlugins(QStringList command_line_plugin_folders)
   }
   settings.setValue("Preferences::builtin_plugin_folders", builtin_folders);
   initializePlugins();
+
+  _cache_warmer = new CacheWarmer(this);
+
+  _autosave_service = new AutosaveService(this);
+  connect(_autosave_service, &AutosaveService::checkpointRequested, this, [this]() {
+    _autosave_service->checkpoint(xmlSaveState().toByteArray(-1), _mapped_plot_data);
+  });
+  _autosave_service->start();
+  // prompt once the window is visible and the event loop is running
+  QTimer::singleShot(0, this, &MainWindow::restoreAutosavedSession);
 }
 
 void MainWindow::initializePlugins()
@@ -676,7 +772,7 @@ void MainWindow::initializePlugins()
       if (isStreamingActive() && !_replot_timer->isActive())
       {
         _replot_timer->setSingleShot(true);
-        _replot_timer->start(40);
+        _replot_timer->start(_replot_interval_ms);
       }
     });
 
@@ -819,11 +915,12 @@ void MainWindow::onPlotAdded(PlotWidget* plot)
 
   connect(plot, &PlotWidget::trackerMoved, this, &MainWindow::onTrackerMovedFromWidget);
 
-  connect(this, &MainWindow::dataSourceRemoved, plot, &PlotWidget::onDataSourceRemoved);
+  connect(this, &MainWindow::dataSourcesRemoved, plot, &PlotWidget::onDataSourcesRemoved);
 
-  connect(plot, &PlotWidget::curveListChanged, this, [this]() {
-    updateTimeOffset();
-    updateTimeSlider();
+  connect(plot, &PlotWidget::curveListChanged, this, []() {
+    // dropping or deleting curves on several widgets at once emits this
+    // once per widget: coalesce into a single slider/offset update
+    PJ::CoalescingScheduler::instance().trigger("time_slider", 30);
   });
 
   connect(&_time_offset, &MonitoredValue::valueChanged, plot, &PlotWidget::on_changeTimeOffset);
@@ -849,6 +946,7 @@ void MainWindow::onPlotAdded(PlotWidget* plot)
   plot->on_changeDateTimeScale(ui->buttonUseDateTime->isChecked());
   plot->activateGrid(ui->buttonActivateGrid->isChecked());
   plot->enableTracker(!isStreamingActive());
+  plot->setScrollBlitEnabled(isStreamingActive());
   plot->setKeepRatioXY(ui->buttonRatio->isChecked());
   plot->configureTracker(_tracker_param);
   plot->onShowPlot(ui->buttonShowpoint->isChecked());
@@ -881,24 +979,44 @@ void MainWindow::onPlotZoomChanged(PlotWidget* modified_plot, QRectF new_range)
 {
   if (ui->buttonLink->isChecked())
   {
-    auto visitor = [=](PlotWidget* plot) {
-      if (plot != modified_plot && !plot->isEmpty() && !plot->isXYPlot() &&
-          plot->isZoomLinkEnabled())
-      {
-        QRectF bound_act = plot->currentBoundingRect();
-        bound_act.setLeft(new_range.left());
-        bound_act.setRight(new_range.right());
-        plot->setZoomRectangle(bound_act, false);
-        plot->on_zoomOutVertical_triggered(false);
-        plot->replot();
-      }
-    };
-    this->forEachWidget(visitor);
+    _linked_zoom_source = modified_plot;
+    _linked_zoom_range = new_range;
+    if (_linked_zoom_timer->isActive())
+    {
+      // a continuous gesture (wheel, drag): the timer applies the latest
+      // range in one pass per frame, instead of replotting every linked
+      // plot for every intermediate rectangle
+      _linked_zoom_pending = true;
+    }
+    else
+    {
+      propagateLinkedZoom();
+      _linked_zoom_timer->start();
+    }
   }
 
   onUndoableChange();
 }
 
+void MainWindow::propagateLinkedZoom()
+{
+  auto visitor = [this](PlotWidget* plot) {
+    // _linked_zoom_source is only compared, never dereferenced: the widget
+    // may have been deleted while the propagation was pending
+    if (plot != _linked_zoom_source && !plot->isEmpty() && !plot->isXYPlot() &&
+        plot->isZoomLinkEnabled())
+    {
+      QRectF bound_act = plot->currentBoundingRect();
+      bound_act.setLeft(_linked_zoom_range.left());
+      bound_act.setRight(_linked_zoom_range.right());
+      plot->setZoomRectangle(bound_act, false);
+      plot->on_zoomOutVertical_triggered(false);
+      plot->replot();
+    }
+  };
+  this->forEachWidget(visitor);
+}
+
 void MainWindow::onPlotTabAdded(PlotDocker* docker)
 {
   connect(docker, &PlotDocker::plotWidgetAdded, this, &MainWindow::onPlotAdded);
@@ -971,13 +1089,14 @@ void MainWindow::checkAllCurvesFromLayout(const QDomElement& root)
 
   std::vector<std::string> missing_curves;
 
+  // single pass over the maps, instead of one lookup per map per curve.
+  // It also avoids flagging a series as missing when it exists in a map
+  // different from the one checked first.
+  const auto existing_names = _mapped_plot_data.getAllNames();
+
   for (auto& curve_name : curves)
   {
-    if (_mapped_plot_data.numeric.count(curve_name) == 0)
-    {
-      missing_curves.push_back(curve_name);
-    }
-    if (_mapped_plot_data.strings.count(curve_name) == 0)
+    if (existing_names.count(curve_name) == 0)
     {
       missing_curves.push_back(curve_name);
     }
@@ -1069,6 +1188,8 @@ bool MainWindow::xmlLoadState(QDomDocument state_document)
 
 void MainWindow::onDeleteMultipleCurves(const std::vector<std::string>& curve_names)
 {
+  _cache_warmer->cancelAndWait();
+
   std::set<std::string> to_be_deleted;
   for (auto& name : curve_names)
   {
@@ -1091,10 +1212,12 @@ void MainWindow::onDeleteMultipleCurves(const std::vector<std::string>& curve_na
     }
   }
 
+  // one transaction: every widget is walked once and the panel views are
+  // rebuilt once, instead of once per deleted curve
+  emit dataSourcesRemoved(to_be_deleted);
+  _curvelist_widget->removeCurves(to_be_deleted);
   for (const auto& curve_name : to_be_deleted)
   {
-    emit dataSourceRemoved(curve_name);
-    _curvelist_widget->removeCurve(curve_name);
     _mapped_plot_data.erase(curve_name);
     _transform_functions.erase(curve_name);
   }
@@ -1184,8 +1307,71 @@ void MainWindow::updateRecentLayoutMenu(QStringList new_filenames)
   menu->setEnabled(new_filenames.size() > 0);
 }
 
+void MainWindow::restoreAutosavedSession()
+{
+  if (!AutosaveService::hasRecoverableSession())
+  {
+    return;
+  }
+  auto clicked = QMessageBox::question(
+      this, tr("Crash recovery"),
+      tr("PlotJuggler did not shut down cleanly and left autosaved checkpoints "
+         "behind.\nDo you want to restore the data and the layout?"),
+      QMessageBox::Yes | QMessageBox::No, QMessageBox::Yes);
+
+  if (clicked == QMessageBox::Yes)
+  {
+    const QByteArray layout = AutosaveService::recoverSession(_mapped_plot_data);
+    _curvelist_widget->refreshColumns();
+    updateDataAndReplot(true);
+
+    QDomDocument layout_doc;
+    if (!layout.isEmpty() && layout_doc.setContent(layout))
+    {
+      xmlLoadState(layout_doc);
+    }
+  }
+  // restored or declined, the old checkpoints are superseded by the
+  // ones of this instance
+  _autosave_service->reset();
+}
+
+bool MainWindow::attachSession(const QString& path)
+{
+  const QFileInfo info(path);
+  bool loaded = false;
+  if (info.isDir())
+  {
+    // the checkpoint directory of another (possibly still running)
+    // instance: the dumps are written with temp-file + rename, so the
+    // replay always sees consistent files
+    loaded = AutosaveService::replayCheckpoints(path, _mapped_plot_data);
+  }
+  else if (info.isFile())
+  {
+    loaded = PJ::LoadSessionDump(path, _mapped_plot_data);
+  }
+
+  if (!loaded)
+  {
+    QMessageBox::warning(this, tr("Attach to session"),
+                         tr("No session dump could be loaded from:\n%1").arg(path));
+    return false;
+  }
+
+  // read-only attach: the source is never registered among the loaded
+  // datafiles, so nothing here can re-save, reload or delete it, and
+  // the layout of this instance stays its own
+  _curvelist_widget->refreshColumns();
+  updateDataAndReplot(true);
+  setStatusBarMessage(tr("Attached (read-only) to the session: %1").arg(path));
+  return true;
+}
+
 void MainWindow::deleteAllData()
 {
+  _cache_warmer->cancelAndWait();
+
   forEachWidget([](PlotWidget* plot) { plot->removeAllCurves(); });
 
   _mapped_plot_data.clear();
@@ -1195,6 +1381,20 @@ void MainWindow::deleteAllData()
   _undo_states.clear();
   _redo_states.clear();
 
+  if (_autosave_service)
+  {
+    // the old checkpoints describe series that no longer exist
+    _autosave_service->reset();
+  }
+
+  if (!_tail_loaders.empty())
+  {
+    _tail_watcher->removePaths(_tail_watcher->files());
+    _tail_loaders.clear();
+    _tail_pending_files.clear();
+    _tail_debounce_timer->stop();
+  }
+
   bool stopped = false;
 
   for (int idx = 0; idx < ui->layoutPublishers->count(); idx++)
@@ -1223,6 +1423,8 @@ void MainWindow::deleteAllData()
 
 void MainWindow::importPlotDataMap(PlotDataMapRef& new_data, bool remove_old)
 {
+  _cache_warmer->cancelAndWait();
+
   if (remove_old)
   {
     auto ClearOldSeries = [](auto& prev_plot_data, auto& new_plot_data) {
@@ -1283,24 +1485,72 @@ bool MainWindow::loadDataFromFiles(QStringList filenames)
   QStringList loaded_filenames;
   _loaded_datafiles_previous.clear();
 
+  ui->buttonPlay->setChecked(false);
+
+  // Read every file into its own private shard first, then merge and
+  // replot once: with many files this skips the full curve rebuild and
+  // replot that loadDataFromFile() would trigger after each of them.
+  struct LoadedShard
+  {
+    PlotDataMapRef data;
+    FileLoadInfo info;
+    DataLoaderPtr loader;
+  };
+  std::deque<LoadedShard> shards;
+
+  QProgressDialog multifile_progress(tr("Loading datafiles"), tr("Cancel"), 0, filenames.size(),
+                                     this);
+  multifile_progress.setWindowModality(Qt::ApplicationModal);
+  multifile_progress.setMinimumDuration(0);
+  multifile_progress.setAutoClose(true);
+
   for (int i = 0; i < filenames.size(); i++)
   {
+    multifile_progress.setLabelText(tr("Loading %1 (%2 of %3)")
+                                        .arg(QFileInfo(filenames[i]).fileName())
+                                        .arg(i + 1)
+                                        .arg(filenames.size()));
+    multifile_progress.setValue(i);
+    QApplication::processEvents();
+    if (multifile_progress.wasCanceled())
+    {
+      break;
+    }
+
     FileLoadInfo info;
     info.filename = filenames[i];
     if (filename_prefix.count(info.filename) > 0)
     {
       info.prefix = filename_prefix[info.filename];
     }
-    auto added_names = loadDataFromFile(info, merge_data);
+
+    shards.emplace_back();
+    auto& shard = shards.back();
+    shard.loader = readDatafileIntoShard(info, shard.data, shard.info);
+    if (!shard.loader)
+    {
+      shards.pop_back();
+    }
+  }
+  multifile_progress.setValue(filenames.size());
+
+  //--- single merge and single replot for all the shards ---
+  for (auto& shard : shards)
+  {
+    auto added_names = shard.data.getAllNames();
+    importPlotDataMap(shard.data, !merge_data);
+    registerLoadedDatafile(shard.info, shard.loader);
+
     if (!added_names.empty())
     {
-      loaded_filenames.push_back(filenames[i]);
+      loaded_filenames.push_back(shard.info.filename);
     }
     for (const auto& name : added_names)
     {
       previous_names.erase(name);
     }
   }
+  finalizeLoadedData();
 
   bool data_replaced_entirely = false;
 
@@ -1347,11 +1597,9 @@ bool MainWindow::loadDataFromFiles(QStringList filenames)
   return false;
 }
 
-std::unordered_set<std::string> MainWindow::loadDataFromFile(const FileLoadInfo& info,
-                                                             bool merge_files)
+DataLoaderPtr MainWindow::readDatafileIntoShard(const FileLoadInfo& info, PlotDataMapRef& shard,
+                                                FileLoadInfo& new_info)
 {
-  ui->buttonPlay->setChecked(false);
-
   const QString extension = QFileInfo(info.filename).suffix().toLower();
 
   typedef std::map<QString, DataLoaderPtr>::const_iterator MapIterator;
@@ -1374,7 +1622,6 @@ std::unordered_set<std::string> MainWindow::loadDataFromFile(const FileLoadInfo&
   }
 
   DataLoaderPtr dataloader;
-  std::unordered_set<std::string> added_names;
 
   if (compatible_loaders.size() == 1)
   {
@@ -1409,77 +1656,240 @@ std::unordered_set<std::string> MainWindow::loadDataFromFile(const FileLoadInfo&
     }
   }
 
-  if (dataloader)
+  if (!dataloader)
+  {
+    QMessageBox::warning(this, tr("Error"),
+                         tr("Cannot read files with extension %1.\n No plugin can handle "
+                            "that!\n")
+                             .arg(info.filename));
+    return nullptr;
+  }
+
+  QFile file(info.filename);
+
+  if (!file.open(QFile::ReadOnly | QFile::Text))
+  {
+    QMessageBox::warning(this, tr("Datafile"),
+                         tr("Cannot read file %1:\n%2.").arg(info.filename).arg(file.errorString()));
+    return nullptr;
+  }
+  file.close();
+
+  try
   {
-    QFile file(info.filename);
+    new_info = info;
 
-    if (!file.open(QFile::ReadOnly | QFile::Text))
+    if (info.plugin_config.hasChildNodes())
     {
-      QMessageBox::warning(
-          this, tr("Datafile"),
-          tr("Cannot read file %1:\n%2.").arg(info.filename).arg(file.errorString()));
-      return {};
+      dataloader->xmlLoadState(info.plugin_config.firstChildElement());
     }
-    file.close();
 
-    try
+    // topic pre-filter: scan the metadata and let the user project the
+    // load, unless a previous selection is being replayed (reload button,
+    // Layout file)
+    if (new_info.selected_topics.isEmpty() && dataloader->supportsTopicFilter())
     {
-      PlotDataMapRef mapped_data;
-      FileLoadInfo new_info = info;
-
-      if (info.plugin_config.hasChildNodes())
+      const QStringList topics = dataloader->listTopicsInFile(new_info.filename);
+      if (topics.size() > 1)
       {
-        dataloader->xmlLoadState(info.plugin_config.firstChildElement());
+        TopicFilterDialog topic_dialog(topics, dataloader->name(), this);
+        if (topic_dialog.exec() != QDialog::Accepted)
+        {
+          return nullptr;
+        }
+        new_info.selected_topics = topic_dialog.selectedTopics();
       }
+    }
 
-      if (dataloader->readDataFromFile(&new_info, mapped_data))
+    QSettings settings;
+    const bool sandboxed = settings.value("Preferences::sandboxed_loaders", false).toBool();
+    // the session-dump loader is already just an mmap + append; isolating it
+    // would only recurse through another worker
+    if (sandboxed && extension != "pjdata")
+    {
+      if (!loadDatafileOutOfProcess(dataloader, new_info, shard))
       {
-        AddPrefixToPlotData(info.prefix.toStdString(), mapped_data.numeric);
-        AddPrefixToPlotData(info.prefix.toStdString(), mapped_data.strings);
-
-        added_names = mapped_data.getAllNames();
-        bool remove_old = !merge_files;
-        importPlotDataMap(mapped_data, remove_old);
-
-        QDomElement plugin_elem = dataloader->xmlSaveState(new_info.plugin_config);
-        new_info.plugin_config.appendChild(plugin_elem);
-        _loaded_datafiles_previous.push_back(new_info);
-
-        bool duplicate = false;
-
-        // substitute an old item of _loaded_datafiles or push_back another item.
-        for (auto& prev_loaded : _loaded_datafiles_history)
+        return nullptr;
+      }
+    }
+    else
+    {
+      // the application owns the progress dialog; the loader reports
+      // through the LoadControl and polls it for cancellation
+      QProgressDialog progress_dialog(tr("Loading %1").arg(QFileInfo(info.filename).fileName()),
+                                      tr("Cancel"), 0, 1000, this);
+      progress_dialog.setWindowModality(Qt::ApplicationModal);
+      progress_dialog.setMinimumDuration(800);
+
+      LoadControl load_control;
+      load_control.yield = [&load_control, &progress_dialog]() {
+        const double fraction = load_control.progress();
+        if (fraction >= 0)
         {
-          if (prev_loaded.filename == new_info.filename && prev_loaded.prefix == new_info.prefix)
-          {
-            prev_loaded = new_info;
-            duplicate = true;
-            break;
-          }
+          progress_dialog.setValue(int(fraction * 1000));
+        }
+        QApplication::processEvents();
+        if (progress_dialog.wasCanceled())
+        {
+          load_control.cancel();
         }
+      };
 
-        if (!duplicate)
+      // clear the control even when the plugin throws
+      struct ControlGuard
+      {
+        DataLoaderPtr loader;
+        ~ControlGuard()
         {
-          _loaded_datafiles_history.push_back(new_info);
+          loader->setLoadControl(nullptr);
         }
+      } control_guard{ dataloader };
+      dataloader->setLoadControl(&load_control);
+
+      const bool loaded = dataloader->readDataFromFile(&new_info, shard);
+      progress_dialog.close();
+      if (!loaded)
+      {
+        return nullptr;
+      }
+      if (load_control.isCanceled())
+      {
+        setStatusBarMessage(
+            tr("Loading of %1 canceled: keeping the data parsed so far").arg(info.filename));
       }
     }
-    catch (std::exception& ex)
+
+    AddPrefixToPlotData(info.prefix.toStdString(), shard.numeric);
+    AddPrefixToPlotData(info.prefix.toStdString(), shard.strings);
+
+    QDomElement plugin_elem = dataloader->xmlSaveState(new_info.plugin_config);
+    new_info.plugin_config.appendChild(plugin_elem);
+  }
+  catch (std::exception& ex)
+  {
+    QMessageBox::warning(this, tr("Exception from the plugin"),
+                         tr("The plugin [%1] thrown the following exception: \n\n %3\n")
+                             .arg(dataloader->name())
+                             .arg(ex.what()));
+    return nullptr;
+  }
+  return dataloader;
+}
+
+bool MainWindow::loadDatafileOutOfProcess(DataLoaderPtr dataloader, FileLoadInfo& new_info,
+                                          PlotDataMapRef& shard)
+{
+  QString plugin_name;
+  for (const auto& [name, loader] : dataLoaders())
+  {
+    if (loader == dataloader)
     {
-      QMessageBox::warning(this, tr("Exception from the plugin"),
-                           tr("The plugin [%1] thrown the following exception: \n\n %3\n")
-                               .arg(dataloader->name())
-                               .arg(ex.what()));
-      return {};
+      plugin_name = name;
+      break;
+    }
+  }
+
+  // /dev/shm keeps the dump in a shared-memory arena: the worker writes the
+  // series there and LoadSessionDump() maps the pages read-only, so the
+  // handoff never copies through this process' heap
+  const QString dump_dir = QDir("/dev/shm").exists() ? QString("/dev/shm") : QDir::tempPath();
+  const QString unique = QString("%1_%2")
+                             .arg(QCoreApplication::applicationPid())
+                             .arg(QDateTime::currentMSecsSinceEpoch());
+  const QString dump_path = QString("%1/plotjuggler_loader_%2.pjdata").arg(dump_dir, unique);
+  QString config_path;
+
+  QStringList args = { "-n", "--loader_worker", new_info.filename, "--loader_output", dump_path };
+  if (!plugin_name.isEmpty())
+  {
+    args << "--loader_plugin" << plugin_name;
+  }
+  if (new_info.plugin_config.hasChildNodes())
+  {
+    config_path = QString("%1/plotjuggler_loader_%2.xml").arg(dump_dir, unique);
+    QFile config_file(config_path);
+    if (config_file.open(QFile::WriteOnly | QFile::Text))
+    {
+      config_file.write(new_info.plugin_config.toByteArray());
+      config_file.close();
+      args << "--loader_config" << config_path;
     }
   }
+
+  QProcess worker;
+  worker.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+  worker.start(QCoreApplication::applicationFilePath(), args);
+  worker.waitForFinished(-1);
+
+  bool loaded = false;
+  if (worker.exitStatus() != QProcess::NormalExit)
+  {
+    QMessageBox::warning(this, tr("Datafile"),
+                         tr("The plugin [%1] crashed while loading:\n%2\n\n"
+                            "The application itself was not affected.")
+                             .arg(dataloader->name())
+                             .arg(new_info.filename));
+  }
+  else if (worker.exitCode() != 0)
+  {
+    QMessageBox::warning(
+        this, tr("Datafile"),
+        tr("The loader worker could not parse the file:\n%1").arg(new_info.filename));
+  }
   else
   {
-    QMessageBox::warning(this, tr("Error"),
-                         tr("Cannot read files with extension %1.\n No plugin can handle "
-                            "that!\n")
-                             .arg(info.filename));
+    loaded = LoadSessionDump(dump_path, shard);
+    if (!loaded)
+    {
+      QMessageBox::warning(
+          this, tr("Datafile"),
+          tr("The dump written by the loader worker is corrupted:\n%1").arg(dump_path));
+    }
+  }
+
+  QFile::remove(dump_path);
+  if (!config_path.isEmpty())
+  {
+    QFile::remove(config_path);
+  }
+  return loaded;
+}
+
+void MainWindow::registerLoadedDatafile(const FileLoadInfo& new_info, DataLoaderPtr dataloader)
+{
+  _loaded_datafiles_previous.push_back(new_info);
+
+  bool duplicate = false;
+
+  // substitute an old item of _loaded_datafiles or push_back another item.
+  for (auto& prev_loaded : _loaded_datafiles_history)
+  {
+    if (prev_loaded.filename == new_info.filename && prev_loaded.prefix == new_info.prefix)
+    {
+      prev_loaded = new_info;
+      duplicate = true;
+      break;
+    }
+  }
+
+  if (!duplicate)
+  {
+    _loaded_datafiles_history.push_back(new_info);
+  }
+
+  // follow the file if the loader can append the bytes written later
+  if (dataloader->supportsTailFollow())
+  {
+    _tail_loaders[new_info.filename] = dataloader;
+    if (!_tail_watcher->files().contains(new_info.filename))
+    {
+      _tail_watcher->addPath(new_info.filename);
+    }
   }
+}
+
+void MainWindow::finalizeLoadedData()
+{
   _curvelist_widget->updateFilter();
 
   // clean the custom plot. Function updateDataAndReplot will update them
@@ -1497,6 +1907,32 @@ std::unordered_set<std::string> MainWindow::loadDataFromFile(const FileLoadInfo&
   updateDataAndReplot(true);
   ui->timeSlider->setRealValue(ui->timeSlider->getMinimum());
 
+  // while streaming, the caches would be invalidated again immediately
+  if (!_active_streamer_plugin)
+  {
+    std::vector<PlotWidget*> widgets;
+    forEachWidget([&widgets](PlotWidget* plot) { widgets.push_back(plot); });
+    _cache_warmer->start(widgets);
+  }
+}
+
+std::unordered_set<std::string> MainWindow::loadDataFromFile(const FileLoadInfo& info,
+                                                             bool merge_files)
+{
+  ui->buttonPlay->setChecked(false);
+
+  std::unordered_set<std::string> added_names;
+  PlotDataMapRef shard;
+  FileLoadInfo new_info;
+
+  if (auto dataloader = readDatafileIntoShard(info, shard, new_info))
+  {
+    added_names = shard.getAllNames();
+    importPlotDataMap(shard, !merge_files);
+    registerLoadedDatafile(new_info, dataloader);
+  }
+  finalizeLoadedData();
+
   return added_names;
 }
 
@@ -1520,6 +1956,13 @@ void MainWindow::on_buttonStreamingPause_toggled(bool paused)
   {
     paused = true;
   }
+  else
+  {
+    // while paused the plugin spools raw bytes instead of parsing them;
+    // resuming (or stopping, which unchecks the button first) replays the
+    // spool before any new message goes through
+    _active_streamer_plugin->setUiPaused(paused);
+  }
 
   ui->buttonRemoveTimeOffset->setEnabled(paused);
   ui->widgetPlay->setEnabled(paused);
@@ -1532,6 +1975,9 @@ void MainWindow::on_buttonStreamingPause_toggled(bool paused)
   forEachWidget([&](PlotWidget* plot) {
     plot->enableTracker(paused);
     plot->setZoomEnabled(paused);
+    // while the stream runs the data is append-only and the time window only
+    // slides forward, which is exactly what the blit path can exploit
+    plot->setScrollBlitEnabled(!paused);
   });
 
   if (!paused)
@@ -1579,6 +2025,14 @@ void MainWindow::stopStreamingPlugin()
     _active_streamer_plugin = nullptr;
   }
 
+  if (_stream_recorder.isRecording())
+  {
+    const QString recorded_file = _stream_recorder.filePath();
+    _stream_recorder.stop();
+    ui->actionRecord_Stream->setChecked(false);
+    setStatusBarMessage(tr("Stream recording saved to %1").arg(recorded_file));
+  }
+
   if (!_mapped_plot_data.numeric.empty())
   {
     ui->actionDeleteAllData->setToolTip("");
@@ -1614,6 +2068,8 @@ void MainWindow::startStreamingPlugin(QString streamer_name)
     return;
   }
 
+  _memory_budget_notified = false;
+
   bool started = false;
   try
   {
@@ -1713,34 +2169,172 @@ void MainWindow::loadStyleSheet(QString file_path)
   }
 }
 
-void MainWindow::updateDerivedSeries()
+void MainWindow::updateDerivedSeries(const std::vector<PJ::TransformFunction*>& transforms)
 {
-  for (auto& [id, series] : _transform_functions)
+  // Derived series with disjoint inputs are independent: recompute them on
+  // the global thread pool instead of one by one on the GUI thread. Each
+  // transform writes only its own output series; shared sources are read-only,
+  // the same assumption already made for ReactiveLuaFunction.
+
+  // map each output series to the transform that produces it, to find the
+  // snippets whose input is the output of another snippet
+  std::unordered_map<const PlotData*, size_t> producer;
+  for (size_t i = 0; i < transforms.size(); i++)
   {
+    for (const PlotData* output : transforms[i]->dataOutputs())
+    {
+      if (output)
+      {
+        producer[output] = i;
+      }
+    }
   }
-}
-
-void MainWindow::updateReactivePlots()
-{
-  std::unordered_set<std::string> updated_curves;
 
-  bool curve_added = false;
-  for (auto& it : _transform_functions)
+  // level = longest chain of snippet-feeds-snippet dependencies. The vector
+  // is sorted by creation order, so a producer always precedes its consumers.
+  std::vector<int> level(transforms.size(), 0);
+  int max_level = 0;
+  for (size_t i = 0; i < transforms.size(); i++)
   {
-    if (auto reactive_function = std::dynamic_pointer_cast<PJ::ReactiveLuaFunction>(it.second))
+    for (const PlotData* source : transforms[i]->dataSources())
     {
-      reactive_function->setTimeTracker(_tracker_time);
-      reactive_function->calculate();
-
-      for (auto& name : reactive_function->createdCurves())
+      auto it = source ? producer.find(source) : producer.end();
+      if (it != producer.end() && it->second < i)
       {
-        curve_added |= _curvelist_widget->addCurve(name);
-        updated_curves.insert(name);
+        level[i] = std::max(level[i], level[it->second] + 1);
       }
     }
+    max_level = std::max(max_level, level[i]);
   }
-  if (curve_added)
-  {
+
+  QProgressDialog progress(tr("Recomputing derived series..."), QString(), 0,
+                           int(transforms.size()), this);
+  progress.setWindowModality(Qt::ApplicationModal);
+  // only pop up when the recompute actually stalls the application
+  progress.setMinimumDuration(1000);
+
+  int completed = 0;
+  std::vector<PJ::TransformFunction*> batch;
+
+  for (int current_level = 0; current_level <= max_level; current_level++)
+  {
+    batch.clear();
+    for (size_t i = 0; i < transforms.size(); i++)
+    {
+      if (level[i] == current_level)
+      {
+        batch.push_back(transforms[i]);
+      }
+    }
+
+    if (batch.size() == 1)
+    {
+      batch.front()->calculate();
+    }
+    else
+    {
+      auto future = QtConcurrent::map(
+          batch, [](PJ::TransformFunction* function) { function->calculate(); });
+
+      while (!future.isFinished())
+      {
+        progress.setValue(completed + future.progressValue());
+        QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+        QThread::msleep(15);
+      }
+      future.waitForFinished();
+    }
+    completed += int(batch.size());
+    progress.setValue(completed);
+  }
+}
+
+void MainWindow::updateReactivePlots()
+{
+  if (_reactive_watcher.isRunning() || _reactive_publishing)
+  {
+    // the previous batch has not finished yet: run again when it completes,
+    // with the most recent data and tracker position
+    _reactive_rerun_pending = true;
+    return;
+  }
+
+  _reactive_in_flight.clear();
+  _reactive_in_flight_ids.clear();
+  for (auto& it : _transform_functions)
+  {
+    if (auto reactive_function = std::dynamic_pointer_cast<PJ::ReactiveLuaFunction>(it.second))
+    {
+      reactive_function->setTimeTracker(_tracker_time);
+      reactive_function->snapshotInputs();
+      _reactive_in_flight.push_back(reactive_function);
+      _reactive_in_flight_ids.push_back(it.first);
+    }
+  }
+  if (_reactive_in_flight.empty())
+  {
+    return;
+  }
+
+  _reactive_watcher.setFuture(QtConcurrent::map(
+      _reactive_in_flight,
+      [](std::shared_ptr<PJ::ReactiveLuaFunction>& function) { function->calculate(); }));
+}
+
+void MainWindow::onReactiveCalculationFinished()
+{
+  _reactive_publishing = true;
+
+  std::unordered_set<std::string> updated_curves;
+  QStringList errors;
+  bool curve_added = false;
+
+  for (size_t i = 0; i < _reactive_in_flight.size(); i++)
+  {
+    auto& reactive_function = _reactive_in_flight[i];
+    const auto& id = _reactive_in_flight_ids[i];
+
+    auto registered = _transform_functions.find(id);
+    if (registered == _transform_functions.end() || registered->second != reactive_function)
+    {
+      // removed or replaced while it was running: discard its results
+      continue;
+    }
+
+    reactive_function->publishOutputs();
+
+    if (!reactive_function->lastError().empty())
+    {
+      errors.push_back(QString::fromStdString(reactive_function->lastError()));
+    }
+
+    if (reactive_function->lastExecutionMs() > _reactive_time_budget_ms)
+    {
+      // warn once, until the script gets back under its budget
+      if (_reactive_overrun_notified.insert(id).second)
+      {
+        showToast(tr("Reactive script \"%1\" took %2 ms, over its budget of %3 ms")
+                      .arg(QString::fromStdString(id))
+                      .arg(qRound(reactive_function->lastExecutionMs()))
+                      .arg(_reactive_time_budget_ms));
+      }
+    }
+    else
+    {
+      _reactive_overrun_notified.erase(id);
+    }
+
+    for (auto& name : reactive_function->createdCurves())
+    {
+      curve_added |= _curvelist_widget->addCurve(name);
+      updated_curves.insert(name);
+    }
+  }
+  _reactive_in_flight.clear();
+  _reactive_in_flight_ids.clear();
+
+  if (curve_added)
+  {
     _curvelist_widget->refreshColumns();
   }
 
@@ -1750,9 +2344,23 @@ void MainWindow::updateReactivePlots()
       if (updated_curves.count(curve.src_name) != 0)
       {
         plot->replot();
+        break;
       }
     }
   });
+
+  _reactive_publishing = false;
+
+  for (const auto& error : errors)
+  {
+    QMessageBox::warning(nullptr, "Error in Reactive Script", error, QMessageBox::Cancel);
+  }
+
+  if (_reactive_rerun_pending)
+  {
+    _reactive_rerun_pending = false;
+    updateReactivePlots();
+  }
 }
 
 void MainWindow::dragEnterEvent(QDragEnterEvent* event)
@@ -1920,20 +2528,16 @@ std::tuple<double, double, int> MainWindow::calculateVisibleRangeX()
     }
   });
 
-  // needed if all the plots are empty
+  // needed if all the plots are empty. The incremental accumulator makes
+  // this O(1) in the common case, instead of a scan of the whole map
   if (max_steps == 0 || max_time < min_time)
   {
-    for (const auto& it : _mapped_plot_data.numeric)
+    const auto& global_range = _mapped_plot_data.numericRangeX();
+    if (global_range.range)
     {
-      const PlotData& data = it.second;
-      if (data.size() >= 1)
-      {
-        const double t0 = data.front().x;
-        const double t1 = data.back().x;
-        min_time = std::min(min_time, t0);
-        max_time = std::max(max_time, t1);
-        max_steps = std::max(max_steps, (int)data.size() - 1);
-      }
+      min_time = std::min(min_time, global_range.range->min);
+      max_time = std::max(max_time, global_range.range->max);
+      max_steps = std::max(max_steps, (int)global_range.max_size - 1);
     }
   }
 
@@ -2000,6 +2604,7 @@ bool MainWindow::loadLayoutFromFile(QString filename)
     FileLoadInfo info;
     info.filename = datafile_path;
     info.prefix = datafile_elem.attribute("prefix");
+    info.selected_topics = datafile_elem.attribute("selected_topics").split(";", PJ::SkipEmptyParts);
 
     auto plugin_elem = datafile_elem.firstChildElement("plugin");
     info.plugin_config.appendChild(info.plugin_config.importNode(plugin_elem, true));
@@ -2246,11 +2851,16 @@ bool MainWindow::loadLayoutFromFile(QString filename)
   linkedZoomOut();
 
   _undo_states.clear();
-  _undo_states.push_back(domDocument);
+  _undo_states.push_back(qCompress(domDocument.toByteArray(-1), 6));
   return true;
 }
 
 void MainWindow::linkedZoomOut()
+{
+  linkedZoomOut([](PlotWidget*) { return true; });
+}
+
+void MainWindow::linkedZoomOut(const std::function<bool(PlotWidget*)>& needs_replot)
 {
   if (ui->buttonLink->isChecked())
   {
@@ -2261,6 +2871,18 @@ void MainWindow::linkedZoomOut()
       {
         if (PlotDocker* matrix = dynamic_cast<PlotDocker*>(tabs->widget(t)))
         {
+          // when no plot in this docker has new data, the shared range is
+          // unchanged and the whole docker can be skipped
+          bool any_dirty = false;
+          for (int index = 0; index < matrix->plotCount() && !any_dirty; index++)
+          {
+            any_dirty = needs_replot(matrix->plotAt(index));
+          }
+          if (!any_dirty)
+          {
+            continue;
+          }
+
           bool first = true;
           Range range;
           // find the ideal zoom
@@ -2296,6 +2918,12 @@ void MainWindow::linkedZoomOut()
             QRectF bound_act = plot->maxZoomRect();
             bound_act.setLeft(range.min);
             bound_act.setRight(range.max);
+            // the ranges are cached and exact: a plot already showing the
+            // target rectangle can skip the rescale and the replot
+            if (bound_act == plot->currentBoundingRect())
+            {
+              continue;
+            }
             plot->setZoomRectangle(bound_act, false);
             plot->replot();
           }
@@ -2305,7 +2933,12 @@ void MainWindow::linkedZoomOut()
   }
   else
   {
-    this->forEachWidget([](PlotWidget* plot) { plot->zoomOut(false); });
+    this->forEachWidget([&](PlotWidget* plot) {
+      if (needs_replot(plot))
+      {
+        plot->zoomOut(false);
+      }
+    });
   }
 }
 
@@ -2370,17 +3003,153 @@ void MainWindow::updateTimeOffset()
   }
 }
 
+// Recompute the curve caches of a batch of widgets, fanning the work out
+// to the shared pool like RecomputeTransforms (plotwidget_transforms.cpp).
+//
+// Curves in different widgets routinely read the same source series, and
+// the "read-only" access paths mutate it: a time-indexed query flushes the
+// staging buffer and advances the index hint, and positional access
+// re-materializes compressed chunks. Curves reading the same source must
+// therefore stay in the same task. An XY curve reads two sources, so it
+// joins their groups into one (union-find over the source names).
+static void PrepareCurvesGroupedBySource(const std::vector<PlotWidget*>& widgets,
+                                         bool reset_older_data)
+{
+  std::vector<QwtSeriesWrapper*> series_list;
+  std::vector<size_t> series_group;
+  std::vector<size_t> group_parent;
+  std::map<std::string, size_t> source_group;
+
+  auto findRoot = [&group_parent](size_t group) {
+    while (group_parent[group] != group)
+    {
+      group_parent[group] = group_parent[group_parent[group]];
+      group = group_parent[group];
+    }
+    return group;
+  };
+
+  for (auto* plot : widgets)
+  {
+    for (const auto& info : plot->curveList())
+    {
+      auto* series = dynamic_cast<QwtSeriesWrapper*>(info.curve->data());
+      if (!series)
+      {
+        continue;
+      }
+      std::vector<std::string> sources;
+      if (const auto* xy = dynamic_cast<const PointSeriesXY*>(series))
+      {
+        sources.push_back(xy->dataX()->plotName());
+        sources.push_back(xy->dataY()->plotName());
+      }
+      else
+      {
+        sources.push_back(info.src_name);
+      }
+
+      size_t curve_group = std::numeric_limits<size_t>::max();
+      for (const auto& name : sources)
+      {
+        size_t group;
+        auto it = source_group.find(name);
+        if (it == source_group.end())
+        {
+          group = group_parent.size();
+          group_parent.push_back(group);
+          source_group.emplace(name, group);
+        }
+        else
+        {
+          group = findRoot(it->second);
+        }
+        if (curve_group == std::numeric_limits<size_t>::max())
+        {
+          curve_group = group;
+        }
+        else if (group != curve_group)
+        {
+          group_parent[group] = curve_group;
+        }
+      }
+      series_list.push_back(series);
+      series_group.push_back(curve_group);
+    }
+  }
+
+  std::map<size_t, std::vector<QwtSeriesWrapper*>> groups;
+  for (size_t i = 0; i < series_list.size(); i++)
+  {
+    groups[findRoot(series_group[i])].push_back(series_list[i]);
+  }
+
+  if (groups.size() <= 1)
+  {
+    for (auto* series : series_list)
+    {
+      series->updateCache(reset_older_data);
+    }
+    return;
+  }
+
+  std::atomic<size_t> remaining(groups.size());
+  std::mutex mutex;
+  std::condition_variable all_done;
+
+  for (auto& it : groups)
+  {
+    auto* group = &it.second;
+    PJ::ThreadPool::instance().submit(
+        PJ::ThreadPool::Priority::TRANSFORM,
+        [group, reset_older_data, &remaining, &mutex, &all_done]() {
+          for (auto* series : *group)
+          {
+            try
+            {
+              series->updateCache(reset_older_data);
+            }
+            catch (const std::exception& err)
+            {
+              qWarning() << "Failed to update curve:" << err.what();
+            }
+          }
+          if (remaining.fetch_sub(1) == 1)
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            all_done.notify_one();
+          }
+        });
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  all_done.wait(lock, [&remaining]() { return remaining.load() == 0; });
+}
+
 void MainWindow::updateDataAndReplot(bool replot_hidden_tabs)
 {
+  PJ::PerfScope perf("MainWindow::updateDataAndReplot");
   _replot_timer->stop();
 
+  // the warmer reads the series that are about to be modified
+  _cache_warmer->cancelAndWait();
+
   MoveDataRet move_ret;
 
   if (_active_streamer_plugin)
   {
     {
-      std::lock_guard<std::mutex> lock(_active_streamer_plugin->mutex());
-      move_ret = MoveData(_active_streamer_plugin->dataMap(), _mapped_plot_data, false);
+      // swap the streamed samples into the staging map while holding the
+      // streamer mutex, then merge them without blocking the producers
+      PJ::PerfScope ingest_perf(std::string("ingest: ") + _active_streamer_plugin->name());
+      _active_streamer_plugin->takeStreamedData(_streamer_staging);
+      if (_stream_recorder.isRecording())
+      {
+        // the staging map holds exactly the fresh samples of this cycle,
+        // before the time-window trim and the memory budget touch them
+        _stream_recorder.recordBatch(_streamer_staging);
+      }
+      move_ret = MoveData(_streamer_staging, _mapped_plot_data, false);
     }
 
     for (const auto& str : move_ret.added_curves)
@@ -2390,26 +3159,32 @@ void MainWindow::updateDataAndReplot(bool replot_hidden_tabs)
 
     // Periodic resync: if a curve was missed by addCurve on first detection
     // (e.g. due to a transient issue), MoveData won't report it again.
-    // Re-attempt all known curves every ~2 seconds to recover.
+    // Re-attempt all known curves every ~2 seconds to recover; skipped
+    // entirely while the name-set revision has not moved, which is the
+    // steady state of a long streaming session.
     if (++_curvelist_resync_counter >= 50)
     {
       _curvelist_resync_counter = 0;
-      bool any_added = false;
-      auto syncCurves = [this, &any_added](auto& series_map) {
-        for (const auto& [name, _] : series_map)
-        {
-          if (_curvelist_widget->addCurve(name))
+      if (_synced_names_revision != _mapped_plot_data.names_revision)
+      {
+        bool any_added = false;
+        auto syncCurves = [this, &any_added](auto& series_map) {
+          for (const auto& [name, _] : series_map)
           {
-            any_added = true;
+            if (_curvelist_widget->addCurve(name))
+            {
+              any_added = true;
+            }
           }
+        };
+        syncCurves(_mapped_plot_data.numeric);
+        syncCurves(_mapped_plot_data.scatter_xy);
+        syncCurves(_mapped_plot_data.strings);
+        if (any_added)
+        {
+          move_ret.curves_updated = true;
         }
-      };
-      syncCurves(_mapped_plot_data.numeric);
-      syncCurves(_mapped_plot_data.scatter_xy);
-      syncCurves(_mapped_plot_data.strings);
-      if (any_added)
-      {
-        move_ret.curves_updated = true;
+        _synced_names_revision = _mapped_plot_data.names_revision;
       }
     }
 
@@ -2426,6 +3201,78 @@ void MainWindow::updateDataAndReplot(bool replot_hidden_tabs)
     {
       _mapped_plot_data.setMaximumRangeX(ui->streamingSpinBox->value());
     }
+
+    // the time-window trim above is not enough when thousands of series keep
+    // growing: an optional global budget drops the oldest samples instead of
+    // letting the process run out of memory
+    if (_memory_budget_mb > 0)
+    {
+      const size_t budget_bytes = size_t(_memory_budget_mb) * 1024 * 1024;
+      const size_t freed = _mapped_plot_data.enforceMemoryBudget(budget_bytes);
+      if (freed > 0 && !_memory_budget_notified)
+      {
+        _memory_budget_notified = true;
+        showToast(tr("Memory budget of %1 MB reached: the oldest samples are being "
+                     "dropped. Current buffer usage: %2 MB")
+                      .arg(_memory_budget_mb)
+                      .arg(_mapped_plot_data.memoryUsage() / (1024 * 1024)));
+      }
+    }
+
+    // memory accounting as plain series, like the streamers' stats: the
+    // buffer growth can be plotted and alerted on along with the data
+    const double now_sec =
+        std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    if (now_sec - _last_memory_stats_time >= 2.0)
+    {
+      _last_memory_stats_time = now_sec;
+      MemoryFootprint aggregate;
+      for (const auto& entry : _mapped_plot_data.memoryProfile())
+      {
+        aggregate += entry.footprint;
+      }
+      constexpr double MB = 1024.0 * 1024.0;
+      auto push = [&](const char* suffix, double value) {
+        _mapped_plot_data.getOrCreateNumeric(std::string("__plotjuggler/memory/") + suffix)
+            .pushBack({ now_sec, value });
+      };
+      push("heap_mb", double(aggregate.heapTotal()) / MB);
+      push("samples_mb", double(aggregate.sample_bytes) / MB);
+      push("dictionary_mb", double(aggregate.dictionary_bytes) / MB);
+      push("spilled_mb", double(aggregate.spilled_bytes) / MB);
+    }
+
+    // report the visible time window and the pixel budget to the plugin:
+    // streamers bridging a remote source forward it upstream, so the server
+    // only ships the resolution the plots can actually display
+    double view_min = std::numeric_limits<double>::max();
+    double view_max = std::numeric_limits<double>::lowest();
+    int view_px = 0;
+    forEachWidget([&](PlotWidget* plot) {
+      if (!plot->isEmpty() && !plot->isXYPlot())
+      {
+        const QRectF bound = plot->currentBoundingRect();
+        view_min = std::min(view_min, bound.left());
+        view_max = std::max(view_max, bound.right());
+        view_px = std::max(view_px, plot->width());
+      }
+    });
+    if (view_max > view_min && view_px > 0)
+    {
+      // currentBoundingRect() is in display time; the plugin expects the
+      // absolute time of the samples
+      view_min += _time_offset.get();
+      view_max += _time_offset.get();
+      const double epsilon = (view_max - view_min) * 0.01;
+      if (std::abs(view_min - _last_viewport_min) > epsilon ||
+          std::abs(view_max - _last_viewport_max) > epsilon || view_px != _last_viewport_px)
+      {
+        _last_viewport_min = view_min;
+        _last_viewport_max = view_max;
+        _last_viewport_px = view_px;
+        _active_streamer_plugin->setVisibleViewport(view_min, view_max, view_px);
+      }
+    }
   }
 
   const bool is_streaming_active = isStreamingActive();
@@ -2440,28 +3287,151 @@ void MainWindow::updateDataAndReplot(bool replot_hidden_tabs)
   std::sort(transforms.begin(), transforms.end(),
             [](TransformFunction* a, TransformFunction* b) { return a->order() < b->order(); });
 
+  // While streaming, only the widgets displaying a series that received new
+  // samples need to be repainted; the others would redraw identical pixels.
+  std::unordered_set<std::string> updated_series(move_ret.updated_curves.begin(),
+                                                 move_ret.updated_curves.end());
+  bool replot_all = replot_hidden_tabs || !is_streaming_active;
+
   // Update the reactive plots
   updateReactivePlots();
 
-  // update all transforms, but not the ReactiveLuaFunction
+  // update all transforms, but not the ReactiveLuaFunction: reactive scripts
+  // run asynchronously on the QtConcurrent pool and trigger their own replot
+  // when their results are published
+  std::vector<TransformFunction*> pending;
+  pending.reserve(transforms.size());
   for (auto& function : transforms)
   {
     if (dynamic_cast<ReactiveLuaFunction*>(function) == nullptr)
+    {
+      pending.push_back(function);
+    }
+  }
+
+  if (!is_streaming_active && pending.size() > 1)
+  {
+    // after a data import the whole history of every derived series must be
+    // recomputed: schedule independent transforms on the thread pool
+    updateDerivedSeries(pending);
+  }
+  else
+  {
+    // while streaming each calculate() is an incremental append over the
+    // few new samples: the thread pool dispatch would cost more than it saves
+    for (auto& function : pending)
     {
       function->calculate();
     }
   }
 
-  forEachWidget([](PlotWidget* plot) { plot->updateCurves(false); });
+  for (auto& function : pending)
+  {
+    // propagate dirtiness from inputs to outputs (transforms are sorted by
+    // order, so chained transforms are visited after their sources)
+    bool input_updated = false;
+    for (const auto* source : function->dataSources())
+    {
+      if (source && updated_series.count(source->plotName()) != 0)
+      {
+        input_updated = true;
+        break;
+      }
+    }
+    if (input_updated)
+    {
+      for (const auto* output : function->dataOutputs())
+      {
+        if (output)
+        {
+          updated_series.insert(output->plotName());
+        }
+      }
+    }
+  }
+
+  auto needsReplot = [&](PlotWidget* plot) {
+    if (replot_all)
+    {
+      return true;
+    }
+    // a widget skipped while its tab was hidden must catch up
+    if (plot->curvesUpdateDeferred())
+    {
+      return true;
+    }
+    // the time tracker follows the current time on every widget
+    if (plot->isTrackerEnabled())
+    {
+      return true;
+    }
+    for (const auto& info : plot->curveList())
+    {
+      if (updated_series.count(info.src_name) != 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  const auto frame_start = std::chrono::steady_clock::now();
+
+  // Curve preparation (transform recompute, cache refresh) never touches
+  // Qwt: spread it over the global thread pool, grouped by source series
+  // (see PrepareCurvesGroupedBySource), and keep only the Qwt part
+  // serialized on the GUI thread.
+  std::vector<PlotWidget*> widgets_to_update;
+  forEachWidget([&](PlotWidget* plot) {
+    if (!needsReplot(plot))
+    {
+      return;
+    }
+    if (!replot_all && !plot->isVisible())
+    {
+      // Curves on a hidden tab would recompute their transform caches
+      // every frame to draw pixels nobody sees. Mark them stale instead;
+      // updateCache() resumes incrementally, so the catch-up on tab
+      // activation costs the same as if the updates had never stopped.
+      plot->deferCurvesUpdate();
+      return;
+    }
+    widgets_to_update.push_back(plot);
+  });
+
+  if (!widgets_to_update.empty())
+  {
+    PrepareCurvesGroupedBySource(widgets_to_update, false);
+  }
+
+  for (auto* plot : widgets_to_update)
+  {
+    plot->finishUpdateCurves();
+  }
 
   //--------------------------------
   // trigger again the execution of this callback if steaming == true
   if (is_streaming_active)
   {
+    // close the control loop of the render governor: over-budget frames
+    // shrink the decimation column budget used by the next replot, and
+    // sustained headroom restores it (see RenderGovernor)
+    const double frame_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frame_start)
+            .count();
+    auto& governor = PJ::RenderGovernor::instance();
+    governor.frameCompleted(frame_ms);
+
     auto range = calculateVisibleRangeX();
     double max_time = std::get<1>(range);
     _tracker_time = max_time;
-    onTrackerTimeUpdated(_tracker_time, false);
+    // following the live edge with the tracker republishes the state and
+    // reruns the reactive scripts: under load, every 2nd / 4th frame is
+    // enough for decorations nobody can read at that rate anyway
+    if (governor.auxRefreshDue())
+    {
+      onTrackerTimeUpdated(_tracker_time, false);
+    }
   }
   else
   {
@@ -2469,7 +3439,11 @@ void MainWindow::updateDataAndReplot(bool replot_hidden_tabs)
     updateTimeSlider();
   }
   //--------------------------------
-  linkedZoomOut();
+  // deferred widgets kept a stale zoom area on purpose: exclude them until
+  // their catch-up pass, or the shared range would be computed from old data
+  linkedZoomOut([&](PlotWidget* plot) {
+    return replot_all || (plot->isVisible() && needsReplot(plot));
+  });
 }
 
 void MainWindow::on_streamingSpinBox_valueChanged(int value)
@@ -2708,18 +3682,50 @@ void MainWindow::closeEvent(QCloseEvent* event)
   settings.setValue("MainWindow.timeTrackerSetting", (int)_tracker_param);
   settings.setValue("MainWindow.splitterWidth", ui->mainSplitter->sizes()[0]);
 
+  // clean shutdown: nothing to recover at the next startup
+  if (_autosave_service)
+  {
+    _autosave_service->discardCheckpoints();
+  }
+
   _plugin_manager.unloadAllPlugins();
 }
 
+FunctionEditorWidget* MainWindow::functionEditor()
+{
+  if (!_function_editor)
+  {
+    auto editor_layout = new QVBoxLayout();
+    editor_layout->setMargin(0);
+    ui->formulaPage->setLayout(editor_layout);
+    _function_editor = new FunctionEditorWidget(_mapped_plot_data, _transform_functions, this);
+    editor_layout->addWidget(_function_editor);
+
+    connect(_function_editor, &FunctionEditorWidget::closed, this,
+            [this]() { ui->widgetStack->setCurrentIndex(0); });
+
+    // the editor themes itself in its constructor; this keeps it in sync
+    // with theme changes that happen while it is alive
+    connect(this, &MainWindow::stylesheetChanged, _function_editor,
+            &FunctionEditorWidget::on_stylesheetChanged);
+
+    connect(_function_editor, &FunctionEditorWidget::accept, this,
+            &MainWindow::onCustomPlotCreated);
+  }
+  return _function_editor;
+}
+
 void MainWindow::onAddCustomPlot(const std::string& plot_name)
 {
+  auto editor = functionEditor();
   ui->widgetStack->setCurrentIndex(1);
-  _function_editor->setLinkedPlotName(QString::fromStdString(plot_name));
-  _function_editor->createNewPlot();
+  editor->setLinkedPlotName(QString::fromStdString(plot_name));
+  editor->createNewPlot();
 }
 
 void MainWindow::onEditCustomPlot(const std::string& plot_name)
 {
+  auto editor = functionEditor();
   ui->widgetStack->setCurrentIndex(1);
   auto custom_it = _transform_functions.find(plot_name);
   if (custom_it == _transform_functions.end())
@@ -2727,8 +3733,7 @@ void MainWindow::onEditCustomPlot(const std::string& plot_name)
     qWarning("failed to find custom equation");
     return;
   }
-  _function_editor->editExistingPlot(
-      std::dynamic_pointer_cast<LuaCustomFunction>(custom_it->second));
+  editor->editExistingPlot(std::dynamic_pointer_cast<LuaCustomFunction>(custom_it->second));
 }
 
 void MainWindow::onRefreshCustomPlot(const std::string& plot_name)
@@ -2837,7 +3842,10 @@ void MainWindow::onCustomPlotCreated(std::vector<CustomPlotPtr> custom_plots)
 
   onUpdateLeftTableValues();
   ui->widgetStack->setCurrentIndex(0);
-  _function_editor->clear();
+  if (_function_editor)
+  {
+    _function_editor->clear();
+  }
 
   for (auto plot : widget_to_replot)
   {
@@ -3095,10 +4103,18 @@ void MainWindow::on_buttonSaveLayout_clicked()
   checkbox_snippets->setFocusPolicy(Qt::NoFocus);
   checkbox_snippets->setChecked(settings.value("MainWindow.saveLayoutSnippets", true).toBool());
 
+  auto checkbox_snapshot = new QCheckBox("Save data snapshot (binary)");
+  checkbox_snapshot->setToolTip("Dump the loaded data to a .pjdata file next to the layout.\n"
+                                "Reloading the layout restores it instantly, without\n"
+                                "re-parsing the original files.");
+  checkbox_snapshot->setFocusPolicy(Qt::NoFocus);
+  checkbox_snapshot->setChecked(settings.value("MainWindow.saveLayoutSnapshot", false).toBool());
+
   vbox->addWidget(title);
   vbox->addWidget(separator);
   vbox->addWidget(checkbox_datasource);
   vbox->addWidget(checkbox_snippets);
+  vbox->addWidget(checkbox_snapshot);
   frame->setLayout(vbox);
 
   int rows = save_layout->rowCount();
@@ -3127,6 +4143,24 @@ void MainWindow::on_buttonSaveLayout_clicked()
   settings.setValue("MainWindow.lastLayoutDirectory", directory_path);
   settings.setValue("MainWindow.saveLayoutDataSource", checkbox_datasource->isChecked());
   settings.setValue("MainWindow.saveLayoutSnippets", checkbox_snippets->isChecked());
+  settings.setValue("MainWindow.saveLayoutSnapshot", checkbox_snapshot->isChecked());
+
+  QString snapshot_file;
+  if (checkbox_snapshot->isChecked())
+  {
+    snapshot_file = fileName;
+    if (snapshot_file.endsWith(".xml"))
+    {
+      snapshot_file.chop(4);
+    }
+    snapshot_file += ".pjdata";
+    if (!PJ::SaveSessionDump(_mapped_plot_data, snapshot_file))
+    {
+      QMessageBox::warning(this, tr("Layout"),
+                           tr("Failed to write the data snapshot %1").arg(snapshot_file));
+      snapshot_file.clear();
+    }
+  }
 
   QDomElement root = doc.namedItem("root").toElement();
 
@@ -3138,24 +4172,40 @@ void MainWindow::on_buttonSaveLayout_clicked()
 
   root.appendChild(doc.createComment(" - - - - - - - - - - - - - - "));
 
-  if (checkbox_datasource->isChecked())
+  if (checkbox_datasource->isChecked() || !snapshot_file.isEmpty())
   {
     QDomElement loaded_list = doc.createElement("previouslyLoaded_Datafiles");
 
-    for (const auto& loaded : _loaded_datafiles_history)
+    if (!snapshot_file.isEmpty())
     {
-      QString loaded_datafile = QDir(directory_path).relativeFilePath(loaded.filename);
-
+      // the snapshot supersedes the original datafiles as the source:
+      // reloading the layout restores the data from the binary dump
       QDomElement file_elem = doc.createElement("fileInfo");
-      file_elem.setAttribute("filename", loaded_datafile);
-      file_elem.setAttribute("prefix", loaded.prefix);
-
-      file_elem.appendChild(loaded.plugin_config.firstChild());
+      file_elem.setAttribute("filename", QDir(directory_path).relativeFilePath(snapshot_file));
+      file_elem.setAttribute("prefix", "");
       loaded_list.appendChild(file_elem);
     }
+    else
+    {
+      for (const auto& loaded : _loaded_datafiles_history)
+      {
+        QString loaded_datafile = QDir(directory_path).relativeFilePath(loaded.filename);
+
+        QDomElement file_elem = doc.createElement("fileInfo");
+        file_elem.setAttribute("filename", loaded_datafile);
+        file_elem.setAttribute("prefix", loaded.prefix);
+        if (!loaded.selected_topics.isEmpty())
+        {
+          file_elem.setAttribute("selected_topics", loaded.selected_topics.join(";"));
+        }
+
+        file_elem.appendChild(loaded.plugin_config.firstChild());
+        loaded_list.appendChild(file_elem);
+      }
+    }
     root.appendChild(loaded_list);
 
-    if (_active_streamer_plugin)
+    if (checkbox_datasource->isChecked() && _active_streamer_plugin)
     {
       QDomElement loaded_streamer = doc.createElement("previouslyLoaded_Streamer");
       QString streamer_name = _active_streamer_plugin->name();
@@ -3291,6 +4341,13 @@ void MainWindow::on_actionPreferences_triggered()
     loadStyleSheet(tr(":/resources/stylesheet_%1.qss").arg(theme));
   }
 
+  int memory_budget = settings.value("Preferences::memory_budget_mb", 0).toInt();
+  if (memory_budget != _memory_budget_mb)
+  {
+    _memory_budget_mb = memory_budget;
+    _memory_budget_notified = false;
+  }
+
   // Apply swap pan/zoom preference to all existing plots
   bool swap_pan_zoom = settings.value("Preferences::swap_pan_zoom", false).toBool();
   if (swap_pan_zoom != prev_swap_pan_zoom)
@@ -3520,6 +4577,76 @@ void MainWindow::on_actionColorMap_Editor_triggered()
   dialog.exec();
 }
 
+void MainWindow::on_actionMemory_Profiler_triggered()
+{
+  MemoryProfileDialog dialog(_mapped_plot_data, this);
+  dialog.exec();
+}
+
+void MainWindow::on_actionFind_Events_triggered()
+{
+  if (!_event_query_dialog)
+  {
+    _event_query_dialog = new EventQueryDialog(
+        _mapped_plot_data, [this]() { return _tracker_time; }, this);
+
+    connect(_event_query_dialog, &EventQueryDialog::matchSelected, this, [this](double time) {
+      auto prev = ui->timeSlider->blockSignals(true);
+      ui->timeSlider->setRealValue(time);
+      ui->timeSlider->blockSignals(prev);
+      onTimeSlider_valueChanged(time);
+    });
+  }
+  _event_query_dialog->refreshSeriesList();
+  _event_query_dialog->show();
+  _event_query_dialog->raise();
+  _event_query_dialog->activateWindow();
+}
+
+void MainWindow::on_actionRecord_Stream_triggered(bool checked)
+{
+  if (!checked)
+  {
+    const QString recorded_file = _stream_recorder.filePath();
+    const size_t dropped = _stream_recorder.droppedBatches();
+    _stream_recorder.stop();
+    QString message = tr("Stream recording saved to %1").arg(recorded_file);
+    if (dropped > 0)
+    {
+      message += tr(" (%1 batches dropped: the writer could not keep up)").arg(dropped);
+    }
+    setStatusBarMessage(message);
+    return;
+  }
+
+  QSettings settings;
+  const QString directory =
+      settings.value("MainWindow.lastRecordingDirectory", QDir::currentPath()).toString();
+
+  QString filename = QFileDialog::getSaveFileName(this, tr("Record the stream to an MCAP file"),
+                                                  directory, tr("MCAP files (*.mcap)"));
+  if (filename.isEmpty())
+  {
+    ui->actionRecord_Stream->setChecked(false);
+    return;
+  }
+  if (!filename.endsWith(".mcap"))
+  {
+    filename += ".mcap";
+  }
+  settings.setValue("MainWindow.lastRecordingDirectory", QFileInfo(filename).absolutePath());
+
+  QString error_message;
+  if (!_stream_recorder.start(filename, &error_message))
+  {
+    QMessageBox::warning(this, tr("Stream recording"),
+                         tr("Cannot record to %1:\n%2").arg(filename).arg(error_message));
+    ui->actionRecord_Stream->setChecked(false);
+    return;
+  }
+  setStatusBarMessage(tr("Recording the stream to %1").arg(filename));
+}
+
 void MainWindow::on_buttonReloadData_clicked()
 {
   const auto prev_infos = std::move(_loaded_datafiles_previous);
@@ -3531,6 +4658,99 @@ void MainWindow::on_buttonReloadData_clicked()
   ui->buttonReloadData->setEnabled(!_loaded_datafiles_previous.empty());
 }
 
+void MainWindow::onTailFileChanged(const QString& path)
+{
+  if (_tail_loaders.count(path) == 0)
+  {
+    return;
+  }
+  _tail_pending_files.insert(path);
+  // restart the debounce window: recorders often flush several times per second
+  _tail_debounce_timer->start();
+}
+
+void MainWindow::onTailDebounceTimeout()
+{
+  auto pending = std::move(_tail_pending_files);
+  _tail_pending_files.clear();
+
+  bool data_added = false;
+
+  for (const QString& path : pending)
+  {
+    auto loader_it = _tail_loaders.find(path);
+    if (loader_it == _tail_loaders.end())
+    {
+      continue;
+    }
+
+    FileLoadInfo* info = nullptr;
+    for (auto& loaded : _loaded_datafiles_history)
+    {
+      if (loaded.filename == path)
+      {
+        info = &loaded;
+        break;
+      }
+    }
+    if (!info)
+    {
+      _tail_loaders.erase(loader_it);
+      _tail_watcher->removePath(path);
+      continue;
+    }
+
+    bool tailed = false;
+    PlotDataMapRef new_data;
+    try
+    {
+      tailed = loader_it->second->tailDataFromFile(info, new_data);
+    }
+    catch (std::exception& ex)
+    {
+      qWarning() << "tailDataFromFile failed:" << ex.what();
+      tailed = false;
+    }
+
+    if (!tailed)
+    {
+      // file truncated or replaced: stop following it, a manual "Reload"
+      // will re-parse the whole file and re-register it
+      _tail_loaders.erase(loader_it);
+      _tail_watcher->removePath(path);
+      showToast(tr("Stopped following \"%1\": the file was truncated or replaced.\n"
+                   "Use the Reload button to load it again.")
+                    .arg(QFileInfo(path).fileName()));
+      continue;
+    }
+
+    if (new_data.numeric.empty() && new_data.strings.empty() && new_data.scatter_xy.empty())
+    {
+      continue;
+    }
+
+    AddPrefixToPlotData(info->prefix.toStdString(), new_data.numeric);
+    AddPrefixToPlotData(info->prefix.toStdString(), new_data.strings);
+
+    importPlotDataMap(new_data, false);
+    data_added = true;
+
+    // some editors replace the file on save; QFileSystemWatcher drops the
+    // path in that case, so re-arm it while the file still exists
+    if (!_tail_watcher->files().contains(path) && QFileInfo::exists(path))
+    {
+      _tail_watcher->addPath(path);
+    }
+  }
+
+  if (data_added)
+  {
+    _curvelist_widget->updateFilter();
+    updateTimeSlider();
+    updateDataAndReplot(true);
+  }
+}
+
 void MainWindow::on_buttonCloseStatus_clicked()
 {
   // Status bar removed - using toast notifications instead
@@ -13,6 +13,8 @@
 
 #include <QCommandLineParser>
 #include <QElapsedTimer>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
 #include <QMainWindow>
 #include <QSignalMapper>
 #include <QShortcut>
@@ -20,6 +22,7 @@
 
 #include "plotwidget.h"
 #include "plot_docker.h"
+#include "stream_recorder.h"
 #include "curvelist_panel.h"
 #include "tabbedplotwidget.h"
 #include "realslider.h"
@@ -28,6 +31,7 @@
 #include "PlotJuggler/statepublisher_base.h"
 #include "PlotJuggler/toolbox_base.h"
 #include "PlotJuggler/datastreamer_base.h"
+#include "PlotJuggler/reactive_function.h"
 #include "PlotJuggler/util/delayed_callback.hpp"
 #include "transforms/custom_function.h"
 #include "transforms/function_editor.h"
@@ -37,6 +41,10 @@
 #include "ui_mainwindow.h"
 
 class QVBoxLayout;
+class AutosaveService;
+class CacheWarmer;
+class EventQueryDialog;
+class PerfOverlay;
 
 class MainWindow : public QMainWindow
 {
@@ -49,6 +57,14 @@ public:
 
   bool loadLayoutFromFile(QString filename);
   bool loadDataFromFiles(QStringList filenames);
+
+  /// Attach read-only to a session materialized by another instance:
+  /// either a ".pjdata" dump or an autosave checkpoint directory. The
+  /// source is never modified, and the layout state of this instance
+  /// stays its own; additional viewers of the same session read the
+  /// mapped dump through the shared page cache instead of re-parsing
+  /// the original datafiles.
+  bool attachSession(const QString& path);
   std::unordered_set<std::string> loadDataFromFile(const FileLoadInfo& info, bool merge_files);
 
   void stopStreamingPlugin();
@@ -92,6 +108,9 @@ public slots:
 
   void onPlotZoomChanged(PlotWidget* modified_plot, QRectF new_range);
 
+  /// Apply the most recent linked-zoom range to all the other linked plots.
+  void propagateLinkedZoom();
+
   void on_tabbedAreaDestroyed(QObject* object);
 
   void updateDataAndReplot(bool replot_hidden_tabs);
@@ -112,6 +131,8 @@ public slots:
 
   void linkedZoomOut();
 
+  void linkedZoomOut(const std::function<bool(PlotWidget*)>& needs_replot);
+
 private:
   Ui::MainWindow* ui;
 
@@ -131,14 +152,49 @@ private:
 
   TransformsMap _transform_functions;
 
+  // reactive scripts run on the QtConcurrent pool, between a snapshot of
+  // their inputs and the publication of their outputs on the GUI thread
+  QFutureWatcher<void> _reactive_watcher;
+  std::vector<std::shared_ptr<PJ::ReactiveLuaFunction>> _reactive_in_flight;
+  std::vector<std::string> _reactive_in_flight_ids;
+  bool _reactive_publishing = false;
+  bool _reactive_rerun_pending = false;
+  int _reactive_time_budget_ms = 100;
+  std::set<std::string> _reactive_overrun_notified;
+
   QString _default_streamer;
 
   ParserFactories _parser_factories;
 
   std::shared_ptr<DataStreamer> _active_streamer_plugin;
 
-  std::deque<QDomDocument> _undo_states;
-  std::deque<QDomDocument> _redo_states;
+  // streamed samples are swapped here under the streamer mutex, then
+  // merged into _mapped_plot_data without blocking the producers
+  PlotDataMapRef _streamer_staging;
+
+  // taps _streamer_staging before trimming, writing the samples to an
+  // MCAP file on a background thread
+  StreamRecorder _stream_recorder;
+
+  // modeless "Find Events" search box, created on first use
+  EventQueryDialog* _event_query_dialog = nullptr;
+
+  // global cap (in MB) on the samples kept in memory while streaming.
+  // 0 means unlimited; see PlotDataMapRef::enforceMemoryBudget()
+  int _memory_budget_mb = 0;
+  bool _memory_budget_notified = false;
+
+  /// last time the "__plotjuggler/memory/" series were appended
+  double _last_memory_stats_time = 0;
+
+  // last viewport reported to the active streamer with setVisibleViewport()
+  double _last_viewport_min = 0;
+  double _last_viewport_max = 0;
+  int _last_viewport_px = 0;
+
+  // each entry is a compressed binary snapshot of xmlSaveState()
+  std::deque<QByteArray> _undo_states;
+  std::deque<QByteArray> _redo_states;
   QElapsedTimer _undo_timer;
   bool _disable_undo_logging;
 
@@ -151,20 +207,44 @@ private:
 
   std::vector<FileLoadInfo> _loaded_datafiles_history;
   std::vector<FileLoadInfo> _loaded_datafiles_previous;
+
+  // tail-follow of files still being written: loaders that keep their
+  // parse state (DataLoader::supportsTailFollow) are registered here and
+  // appended to incrementally when the filesystem watcher fires
+  QFileSystemWatcher* _tail_watcher;
+  QTimer* _tail_debounce_timer;
+  std::set<QString> _tail_pending_files;
+  std::map<QString, DataLoaderPtr> _tail_loaders;
+
   CurveTracker::Parameter _tracker_param;
 
   std::map<CurveTracker::Parameter, QIcon> _tracker_button_icons;
 
   MonitoredValue _time_offset;
 
+  // linked zoom: during a continuous gesture, range changes arriving while
+  // the timer runs are coalesced into one propagation pass per frame
+  QTimer* _linked_zoom_timer;
+  PlotWidget* _linked_zoom_source = nullptr;  // compared by pointer only
+  QRectF _linked_zoom_range;
+  bool _linked_zoom_pending = false;
+
   QTimer* _replot_timer;
+  int _replot_interval_ms = 40;
   int _curvelist_resync_counter = 0;
+  // last PlotDataMapRef::names_revision mirrored into the curve list panel
+  uint64_t _synced_names_revision = 0;
   QTimer* _publish_timer;
-  PJ::DelayedCallback _tracker_delay;
 
   QDateTime _prev_publish_time;
 
-  FunctionEditorWidget* _function_editor;
+  // built on first use by functionEditor(): the editor pulls in the code
+  // editor, syntax highlighting and the Lua help page, none of which should
+  // delay the first paint of the main window
+  FunctionEditorWidget* _function_editor = nullptr;
+
+  // created on the first F9 press (see initializeActions)
+  PerfOverlay* _perf_overlay = nullptr;
 
   QMovie* _animated_streaming_movie;
   QTimer* _animated_streaming_timer;
@@ -186,9 +266,22 @@ private:
   // Toast notification manager
   ToastManager* _toast_manager;
 
+  // periodic crash-recovery checkpoints (see autosave_service.h)
+  AutosaveService* _autosave_service = nullptr;
+
+  // idle-time warming of the visualization caches after a bulk import
+  // (see cache_warmer.h)
+  CacheWarmer* _cache_warmer = nullptr;
+
   void initializeActions();
   void initializePlugins();
 
+  // lazily build _function_editor and wire it into ui->formulaPage
+  FunctionEditorWidget* functionEditor();
+
+  // offer to restore the checkpoints left behind by a crashed instance
+  void restoreAutosavedSession();
+
   PluginManager _plugin_manager;
 
   const std::map<QString, DataLoaderPtr>& dataLoaders() const
@@ -222,6 +315,26 @@ private:
 
   void checkAllCurvesFromLayout(const QDomElement& root);
 
+  /// Run the right DataLoader on a file and collect its series in `shard`,
+  /// without touching _mapped_plot_data. Returns the loader used, or
+  /// nullptr on failure (after warning the user).
+  DataLoaderPtr readDatafileIntoShard(const FileLoadInfo& info, PlotDataMapRef& shard,
+                                      FileLoadInfo& new_info);
+
+  /// "Sandboxed loaders" path: run the loader in a --loader_worker child
+  /// process that writes a session dump (under /dev/shm when available) and
+  /// map it back read-only. A crashing plugin kills only the worker.
+  /// Note: the dump carries numeric and string series; the few loaders that
+  /// produce scatter_xy or user_defined series lose those when sandboxed.
+  bool loadDatafileOutOfProcess(DataLoaderPtr dataloader, FileLoadInfo& new_info,
+                                PlotDataMapRef& shard);
+
+  void registerLoadedDatafile(const FileLoadInfo& new_info, DataLoaderPtr dataloader);
+
+  /// Curve list, custom transforms and replot refresh after one or more
+  /// datafiles have been merged into _mapped_plot_data
+  void finalizeLoadedData();
+
   void importPlotDataMap(PlotDataMapRef& new_data, bool remove_old);
 
   bool isStreamingActive() const;
@@ -247,16 +360,18 @@ private:
 
   void loadStyleSheet(QString file_path);
 
-  void updateDerivedSeries();
+  void updateDerivedSeries(const std::vector<PJ::TransformFunction*>& transforms);
 
   void updateReactivePlots();
 
+  void onReactiveCalculationFinished();
+
   void dragEnterEvent(QDragEnterEvent* event);
 
   void dropEvent(QDropEvent* event);
 
 signals:
-  void dataSourceRemoved(const std::string& name);
+  void dataSourcesRemoved(const std::set<std::string>& names);
   void dataSourceUpdated(const std::string& name);
   void activateTracker(bool active);
   void stylesheetChanged(QString style_name);
@@ -314,6 +429,12 @@ private slots:
 
   void on_actionColorMap_Editor_triggered();
 
+  void on_actionMemory_Profiler_triggered();
+
+  void on_actionFind_Events_triggered();
+
+  void on_actionRecord_Stream_triggered(bool checked);
+
   void on_buttonReloadData_clicked();
 
   void on_buttonCloseStatus_clicked();
@@ -324,6 +445,9 @@ private slots:
 
   void on_buttonDots_toggled(bool checked);
 
+  void onTailFileChanged(const QString& path);
+  void onTailDebounceTimeout();
+
 private:
   QStringList readAllCurvesFromXML(QDomElement root_node);
   void loadAllPlugins(QStringList command_line_plugin_folders);
@@ -0,0 +1,119 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "memory_profile_dialog.h"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+using namespace PJ;
+
+namespace
+{
+// displays a formatted string, sorts by the numeric value in Qt::UserRole
+class SortableItem : public QTableWidgetItem
+{
+public:
+  bool operator<(const QTableWidgetItem& other) const override
+  {
+    return data(Qt::UserRole).toDouble() < other.data(Qt::UserRole).toDouble();
+  }
+};
+
+QTableWidgetItem* bytesItem(size_t bytes)
+{
+  auto item = new SortableItem();
+  item->setData(Qt::DisplayRole, QString::number(double(bytes) / (1024.0 * 1024.0), 'f', 2));
+  item->setData(Qt::UserRole, double(bytes));
+  item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+  return item;
+}
+
+QTableWidgetItem* countItem(size_t count)
+{
+  auto item = new SortableItem();
+  item->setData(Qt::DisplayRole, QString::number(qulonglong(count)));
+  item->setData(Qt::UserRole, double(count));
+  item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+  return item;
+}
+}  // namespace
+
+MemoryProfileDialog::MemoryProfileDialog(const PlotDataMapRef& data, QWidget* parent)
+  : QDialog(parent), _data(data)
+{
+  setWindowTitle(tr("Memory Profiler"));
+  resize(800, 500);
+
+  _summary = new QLabel(this);
+
+  _table = new QTableWidget(this);
+  _table->setColumnCount(8);
+  _table->setHorizontalHeaderLabels({ tr("Series"), tr("Kind"), tr("Points"), tr("Samples (MB)"),
+                                      tr("Overhead (MB)"), tr("Dictionary (MB)"),
+                                      tr("Spilled (MB)"), tr("Total (MB)") });
+  _table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  _table->setSelectionBehavior(QAbstractItemView::SelectRows);
+  _table->verticalHeader()->setVisible(false);
+  _table->horizontalHeader()->setStretchLastSection(false);
+  _table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+
+  auto refresh_button = new QPushButton(tr("Refresh"), this);
+  auto close_button = new QPushButton(tr("Close"), this);
+  connect(refresh_button, &QPushButton::clicked, this, &MemoryProfileDialog::refresh);
+  connect(close_button, &QPushButton::clicked, this, &QDialog::accept);
+
+  auto buttons_layout = new QHBoxLayout();
+  buttons_layout->addWidget(_summary);
+  buttons_layout->addStretch();
+  buttons_layout->addWidget(refresh_button);
+  buttons_layout->addWidget(close_button);
+
+  auto layout = new QVBoxLayout(this);
+  layout->addWidget(_table);
+  layout->addLayout(buttons_layout);
+
+  refresh();
+}
+
+void MemoryProfileDialog::refresh()
+{
+  const auto profile = _data.memoryProfile();
+
+  // sorting must be off while the rows are rebuilt
+  _table->setSortingEnabled(false);
+  _table->setRowCount(int(profile.size()));
+
+  MemoryFootprint aggregate;
+  size_t total_points = 0;
+  int row = 0;
+  for (const auto& entry : profile)
+  {
+    aggregate += entry.footprint;
+    total_points += entry.points;
+
+    _table->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(entry.name)));
+    _table->setItem(row, 1, new QTableWidgetItem(entry.kind));
+    _table->setItem(row, 2, countItem(entry.points));
+    _table->setItem(row, 3, bytesItem(entry.footprint.sample_bytes));
+    _table->setItem(row, 4, bytesItem(entry.footprint.overhead_bytes));
+    _table->setItem(row, 5, bytesItem(entry.footprint.dictionary_bytes));
+    _table->setItem(row, 6, bytesItem(entry.footprint.spilled_bytes));
+    _table->setItem(row, 7, bytesItem(entry.footprint.heapTotal()));
+    row++;
+  }
+
+  _table->setSortingEnabled(true);
+  _table->sortByColumn(7, Qt::DescendingOrder);
+
+  _summary->setText(tr("%1 series, %2 points, %3 MB on the heap, %4 MB spilled to disk")
+                        .arg(profile.size())
+                        .arg(total_points)
+                        .arg(double(aggregate.heapTotal()) / (1024.0 * 1024.0), 0, 'f', 1)
+                        .arg(double(aggregate.spilled_bytes) / (1024.0 * 1024.0), 0, 'f', 1));
+}
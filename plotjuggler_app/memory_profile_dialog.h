@@ -0,0 +1,39 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef MEMORY_PROFILE_DIALOG_H
+#define MEMORY_PROFILE_DIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QTableWidget>
+
+#include "PlotJuggler/plotdata.h"
+
+/**
+ * @brief Sortable per-series view of PlotDataMapRef::memoryProfile()
+ * (Tools -> Memory Profiler): one row per series with points, sample
+ * bytes, bookkeeping overhead, string dictionary and spilled bytes, plus
+ * the aggregate in the header. Sort by the Total column to see which
+ * topics are eating the RAM; Refresh re-reads the live data map.
+ */
+class MemoryProfileDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  explicit MemoryProfileDialog(const PJ::PlotDataMapRef& data, QWidget* parent = nullptr);
+
+private slots:
+  void refresh();
+
+private:
+  const PJ::PlotDataMapRef& _data;
+  QTableWidget* _table;
+  QLabel* _summary;
+};
+
+#endif  // MEMORY_PROFILE_DIALOG_H
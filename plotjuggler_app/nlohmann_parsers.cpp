@@ -8,111 +8,277 @@
 
 #include "fmt/format.h"
 
-bool NlohmannParser::parseMessageImpl(double& timestamp)
+// SAX handler that flattens the document in a single pass.
+//
+// The flattened key is maintained incrementally in one string: each
+// container level remembers the length of the prefix it was opened with,
+// so entering a field is a truncate + append and no per-node strings or
+// DOM nodes are ever allocated.
+//
+// Values are buffered in (series, value) pairs and pushed at the end of
+// the message, because the embedded timestamp field may be serialized
+// after the values it applies to. A top-level array is a batch: every
+// element is flushed as a separate message with its own timestamp, like
+// the DOM implementation did.
+struct FlattenSAX
 {
-  // Support batched messages: if the top-level value is an array,
-  // treat each element as a separate data point with its own timestamp.
-  // This allows senders to batch multiple samples into a single message,
-  // reducing per-message overhead for high-rate data sources.
-  if (_json.is_array())
-  {
-    nlohmann::json array = std::move(_json);
-    for (auto& element : array)
+  using json = nlohmann::json;
+
+  NlohmannParser& parser;
+  double* timestamp = nullptr;  // the caller's timestamp, updated per message
+
+  std::string path;
+  size_t root_len = 0;
+
+  struct Level
+  {
+    bool is_array;
+    size_t base_len;
+    size_t index = 0;
+  };
+  std::vector<Level> levels;
+  bool root_is_array = false;
+
+  bool stamp_enabled = false;
+  bool stamp_found = false;
+  bool expect_stamp = false;
+  double stamp = 0;
+
+  FlattenSAX(NlohmannParser& parser_, double* timestamp_) : parser(parser_), timestamp(timestamp_)
+  {
+    path = parser._topic_name;
+    root_len = path.size();
+    stamp_enabled = parser._use_message_stamp && !parser._stamp_fieldname.empty();
+  }
+
+  PlotData& series()
+  {
+    auto it = parser._series_cache.find(path);
+    if (it == parser._series_cache.end())
     {
-      _json = std::move(element);
-      parseMessageImpl(timestamp);
+      it = parser._series_cache.insert({ path, &parser.getSeries(path) }).first;
     }
-    return true;
+    return *it->second;
   }
 
-  if (_use_message_stamp && _stamp_fieldname.empty() == false)
+  // set the key of the value about to be consumed. Object members are
+  // already named by key(); array elements get their index appended here.
+  // Elements of a top-level array are independent messages and restart
+  // from the topic name.
+  void setElementPath()
   {
-    auto ts = _json.find(_stamp_fieldname);
-    if (ts != _json.end() && ts.value().is_number())
+    if (levels.empty())
     {
-      timestamp = ts.value().get<double>();
+      path.resize(root_len);
+      return;
     }
-    else
+    auto& top = levels.back();
+    if (top.is_array)
     {
-      _use_message_stamp = false;
+      path.resize(top.base_len);
+      if (!(root_is_array && levels.size() == 1))
+      {
+        fmt::format_to(std::back_inserter(path), "[{}]", top.index);
+      }
+      top.index++;
     }
   }
 
-  std::function<void(const std::string&, const nlohmann::json&)> flatten;
+  bool atBatchElementLevel() const
+  {
+    return root_is_array && levels.size() == 1;
+  }
 
-  flatten = [&](const std::string& prefix, const nlohmann::json& value) {
-    if (value.empty())
+  void flushMessage()
+  {
+    if (stamp_enabled)
     {
-      return;
+      if (stamp_found)
+      {
+        *timestamp = stamp;
+      }
+      else
+      {
+        // same behavior as the DOM path: stop looking for the field
+        // after the first message that does not have it
+        stamp_enabled = false;
+        parser._use_message_stamp = false;
+      }
+    }
+    for (const auto& [plot_data, value] : parser._pending_samples)
+    {
+      plot_data->pushBack({ *timestamp, value });
     }
+    parser._pending_samples.clear();
+    stamp_found = false;
+  }
 
-    switch (value.type())
+  void storeNumber(double value)
+  {
+    setElementPath();
+    if (expect_stamp)
     {
-      case nlohmann::detail::value_t::array: {
-        // iterate array and use index as reference string
-        for (std::size_t i = 0; i < value.size(); ++i)
-        {
-          flatten(fmt::format("{}[{}]", prefix, i), value[i]);
-        }
-        break;
-      }
+      stamp = value;
+      stamp_found = true;
+      expect_stamp = false;
+    }
+    parser._pending_samples.push_back({ &series(), value });
+    if (atBatchElementLevel())
+    {
+      flushMessage();
+    }
+  }
 
-      case nlohmann::detail::value_t::object: {
-        // iterate object and use keys as reference string
-        for (const auto& element : value.items())
-        {
-          flatten(fmt::format("{}/{}", prefix, element.key()), element.value());
-        }
-        break;
-      }
+  void skipValue()
+  {
+    setElementPath();
+    expect_stamp = false;
+    if (atBatchElementLevel())
+    {
+      flushMessage();
+    }
+  }
 
-      default: {
-        double numeric_value = 0;
-        if (value.is_boolean())
-        {
-          numeric_value = value.get<bool>();
-        }
-        else if (value.is_number())
-        {
-          numeric_value = value.get<double>();
-        }
-        else
-        {
-          return;
-        }
-
-        auto plot_data = &(getSeries(prefix));
-        plot_data->pushBack({ timestamp, numeric_value });
-
-        break;
-      }
-    }  // end switch
-  };
+  //---- SAX interface ----
 
-  flatten(_topic_name, _json);
+  bool null()
+  {
+    skipValue();
+    return true;
+  }
+
+  bool boolean(bool value)
+  {
+    storeNumber(value ? 1.0 : 0.0);
+    return true;
+  }
+
+  bool number_integer(json::number_integer_t value)
+  {
+    storeNumber(double(value));
+    return true;
+  }
+
+  bool number_unsigned(json::number_unsigned_t value)
+  {
+    storeNumber(double(value));
+    return true;
+  }
+
+  bool number_float(json::number_float_t value, const json::string_t&)
+  {
+    storeNumber(double(value));
+    return true;
+  }
+
+  bool string(json::string_t&)
+  {
+    skipValue();
+    return true;
+  }
+
+  bool binary(json::binary_t&)
+  {
+    skipValue();
+    return true;
+  }
+
+  bool start_object(std::size_t)
+  {
+    setElementPath();
+    expect_stamp = false;
+    levels.push_back({ false, path.size() });
+    return true;
+  }
+
+  bool key(json::string_t& name)
+  {
+    auto& top = levels.back();
+    path.resize(top.base_len);
+    path += '/';
+    path += name;
+    // the timestamp field is only looked up at the root of the message
+    expect_stamp = stamp_enabled && !stamp_found &&
+                   levels.size() == (root_is_array ? 2u : 1u) &&
+                   name == parser._stamp_fieldname;
+    return true;
+  }
+
+  bool end_object()
+  {
+    levels.pop_back();
+    if (atBatchElementLevel())
+    {
+      flushMessage();
+    }
+    return true;
+  }
+
+  bool start_array(std::size_t)
+  {
+    if (levels.empty())
+    {
+      root_is_array = true;
+      levels.push_back({ true, path.size() });
+      return true;
+    }
+    setElementPath();
+    expect_stamp = false;
+    levels.push_back({ true, path.size() });
+    return true;
+  }
+
+  bool end_array()
+  {
+    levels.pop_back();
+    if (atBatchElementLevel())
+    {
+      flushMessage();
+    }
+    return true;
+  }
+
+  bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&)
+  {
+    return false;
+  }
+};
+
+bool NlohmannParser::parseSax(const MessageRef& msg, double& timestamp,
+                              nlohmann::json::input_format_t format)
+{
+  _pending_samples.clear();
+
+  FlattenSAX handler(*this, &timestamp);
+  const bool ok = nlohmann::json::sax_parse(msg.data(), msg.data() + msg.size(), &handler, format);
+  if (!ok)
+  {
+    _pending_samples.clear();
+    return false;
+  }
+  if (!handler.root_is_array)
+  {
+    handler.flushMessage();
+  }
   return true;
 }
 
 bool MessagePack_Parser::parseMessage(const MessageRef msg, double& timestamp)
 {
-  _json = nlohmann::json::from_msgpack(msg.data(), msg.data() + msg.size());
-  return parseMessageImpl(timestamp);
+  return parseSax(msg, timestamp, nlohmann::json::input_format_t::msgpack);
 }
 
 bool JSON_Parser::parseMessage(const MessageRef msg, double& timestamp)
 {
-  _json = nlohmann::json::parse(msg.data(), msg.data() + msg.size());
-  return parseMessageImpl(timestamp);
+  return parseSax(msg, timestamp, nlohmann::json::input_format_t::json);
 }
 
 bool CBOR_Parser::parseMessage(const MessageRef msg, double& timestamp)
 {
-  _json = nlohmann::json::from_cbor(msg.data(), msg.data() + msg.size());
-  return parseMessageImpl(timestamp);
+  return parseSax(msg, timestamp, nlohmann::json::input_format_t::cbor);
 }
 
 bool BSON_Parser::parseMessage(const MessageRef msg, double& timestamp)
 {
-  _json = nlohmann::json::from_bson(msg.data(), msg.data() + msg.size());
-  return parseMessageImpl(timestamp);
+  return parseSax(msg, timestamp, nlohmann::json::input_format_t::bson);
 }
@@ -26,11 +26,24 @@ public:
   }
 
 protected:
-  bool parseMessageImpl(double& timestamp);
+  // Single-pass SAX parsing: flattened (key, value) pairs are emitted
+  // directly into the destination series, without building a DOM.
+  bool parseSax(const MessageRef& msg, double& timestamp,
+                nlohmann::json::input_format_t format);
 
-  nlohmann::json _json;
   bool _use_message_stamp;
   std::string _stamp_fieldname;
+
+private:
+  friend struct FlattenSAX;
+
+  // series resolved by flattened key, so repeated fields of a high-rate
+  // topic skip the group bookkeeping of getOrCreateNumeric()
+  std::unordered_map<std::string, PlotData*> _series_cache;
+
+  // (destination, value) pairs of the message being parsed, pushed only
+  // once the embedded timestamp (which may appear after them) is known
+  std::vector<std::pair<PlotData*, double>> _pending_samples;
 };
 
 class JSON_Parser : public NlohmannParser
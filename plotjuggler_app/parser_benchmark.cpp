@@ -0,0 +1,251 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "parser_benchmark.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "plugin_manager.h"
+#include "nlohmann_parsers.h"
+#include "PlotJuggler/messageparser_base.h"
+
+using namespace PJ;
+
+namespace
+{
+struct Capture
+{
+  QString encoding;
+  std::string topic;
+  std::string type_name;
+  std::string schema;
+  // offsets and sizes into `blob`, so the replay loop touches no copies
+  QByteArray blob;
+  std::vector<MessageRef> messages;
+  size_t total_bytes = 0;
+};
+
+// Layout of a "PJCAPTURE 1" file (see generate_benchmark_fixtures.py):
+// a first line with magic and version, then "key: value" header lines
+// (encoding, topic, type, schema_size) up to an empty line, schema_size
+// bytes of schema, and finally the messages back to back, each prefixed
+// by its size as a little-endian uint32.
+bool readCapture(const QString& filename, Capture& capture)
+{
+  QFile file(filename);
+  if (!file.open(QFile::ReadOnly))
+  {
+    std::cerr << "Parser benchmark: cannot read file: " << filename.toStdString() << std::endl;
+    return false;
+  }
+  capture.blob = file.readAll();
+  const char* data = capture.blob.constData();
+  const size_t size = size_t(capture.blob.size());
+
+  size_t pos = 0;
+  auto nextLine = [&]() -> QString {
+    const char* newline =
+        static_cast<const char*>(memchr(data + pos, '\n', size - pos));
+    if (!newline)
+    {
+      pos = size;
+      return {};
+    }
+    QString line = QString::fromUtf8(data + pos, int(newline - (data + pos)));
+    pos = size_t(newline - data) + 1;
+    return line;
+  };
+
+  if (nextLine() != "PJCAPTURE 1")
+  {
+    std::cerr << "Parser benchmark: not a PJCAPTURE file: " << filename.toStdString() << std::endl;
+    return false;
+  }
+
+  size_t schema_size = 0;
+  while (pos < size)
+  {
+    const QString line = nextLine();
+    if (line.isEmpty())
+    {
+      break;  // end of the header
+    }
+    const int sep = line.indexOf(": ");
+    if (sep < 0)
+    {
+      std::cerr << "Parser benchmark: malformed header line: " << line.toStdString() << std::endl;
+      return false;
+    }
+    const QString key = line.left(sep);
+    const QString value = line.mid(sep + 2);
+    if (key == "encoding")
+    {
+      capture.encoding = value;
+    }
+    else if (key == "topic")
+    {
+      capture.topic = value.toStdString();
+    }
+    else if (key == "type")
+    {
+      capture.type_name = value.toStdString();
+    }
+    else if (key == "schema_size")
+    {
+      schema_size = value.toULongLong();
+    }
+    // unknown keys are skipped, for forward compatibility
+  }
+
+  if (capture.encoding.isEmpty() || pos + schema_size > size)
+  {
+    std::cerr << "Parser benchmark: incomplete capture header" << std::endl;
+    return false;
+  }
+  capture.schema.assign(data + pos, schema_size);
+  pos += schema_size;
+
+  while (pos + sizeof(uint32_t) <= size)
+  {
+    uint32_t msg_size = 0;
+    memcpy(&msg_size, data + pos, sizeof(uint32_t));
+    pos += sizeof(uint32_t);
+    if (pos + msg_size > size)
+    {
+      std::cerr << "Parser benchmark: truncated message record" << std::endl;
+      return false;
+    }
+    capture.messages.emplace_back(reinterpret_cast<const uint8_t*>(data + pos), msg_size);
+    capture.total_bytes += msg_size;
+    pos += msg_size;
+  }
+
+  if (capture.messages.empty())
+  {
+    std::cerr << "Parser benchmark: the capture contains no messages" << std::endl;
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+int RunParserBenchmark(const QString& capture_file, int loops,
+                       const QStringList& extra_plugin_folders)
+{
+  Capture capture;
+  if (!readCapture(capture_file, capture))
+  {
+    return -1;
+  }
+
+  // built-in factories first, same as MainWindow::initializePlugins()
+  ParserFactories parser_factories;
+  for (ParserFactoryPtr factory :
+       std::initializer_list<ParserFactoryPtr>{ std::make_shared<JSON_ParserFactory>(),
+                                                std::make_shared<CBOR_ParserFactory>(),
+                                                std::make_shared<BSON_ParserFactory>(),
+                                                std::make_shared<MessagePack_ParserFactory>() })
+  {
+    parser_factories.insert({ factory->encoding(), factory });
+  }
+
+  PluginManager plugin_manager;
+  QStringList plugin_folders = extra_plugin_folders;
+  plugin_folders += QCoreApplication::applicationDirPath();
+  plugin_folders += PJ_PLUGIN_INSTALL_DIRECTORY;
+  plugin_folders.removeDuplicates();
+  for (const auto& folder : plugin_folders)
+  {
+    plugin_manager.loadPluginsFromFolder(folder);
+  }
+  for (const auto& [plugin_name, parser] : plugin_manager.parserFactories())
+  {
+    auto encodings = QString(parser->encoding()).split(";");
+    for (const auto& encoding : encodings)
+    {
+      parser_factories.insert(std::make_pair(encoding, parser));
+    }
+  }
+
+  auto factory_it = parser_factories.find(capture.encoding);
+  if (factory_it == parser_factories.end())
+  {
+    std::cerr << "Parser benchmark: no parser for encoding [ "
+              << capture.encoding.toStdString() << " ]. Available:";
+    for (const auto& [encoding, factory] : parser_factories)
+    {
+      std::cerr << " " << encoding.toStdString();
+    }
+    std::cerr << std::endl;
+    return -1;
+  }
+
+  // Each loop replays the whole capture into a fresh parser and data map,
+  // so the loops are identical and comparable; the median is the number
+  // to track, the first loop additionally pays the series creation.
+  std::vector<double> loop_ms;
+  size_t num_series = 0;
+  for (int loop = 0; loop < loops; loop++)
+  {
+    PlotDataMapRef data;
+    auto parser = factory_it->second->createParser(capture.topic, capture.type_name,
+                                                   capture.schema, data);
+    if (!parser)
+    {
+      std::cerr << "Parser benchmark: the factory refused to create a parser" << std::endl;
+      return -1;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    double timestamp = 0;
+    try
+    {
+      for (const auto& message : capture.messages)
+      {
+        timestamp += 0.001;
+        parser->parseMessage(message, timestamp);
+      }
+    }
+    catch (std::exception& err)
+    {
+      std::cerr << "Parser benchmark: parseMessage failed: " << err.what() << std::endl;
+      return -1;
+    }
+    loop_ms.push_back(double(timer.nsecsElapsed()) * 1e-6);
+    num_series = data.numeric.size() + data.strings.size() + data.user_defined.size();
+  }
+
+  auto sorted = loop_ms;
+  std::sort(sorted.begin(), sorted.end());
+  const double median_ms = sorted[sorted.size() / 2];
+
+  QJsonObject result;
+  result["file"] = capture_file;
+  result["encoding"] = capture.encoding;
+  result["type"] = QString::fromStdString(capture.type_name);
+  result["loops"] = loops;
+  result["messages_per_loop"] = double(capture.messages.size());
+  result["payload_bytes_per_loop"] = double(capture.total_bytes);
+  result["num_series"] = double(num_series);
+  result["first_loop_ms"] = loop_ms.front();
+  result["min_ms"] = sorted.front();
+  result["median_ms"] = median_ms;
+  result["max_ms"] = sorted.back();
+  result["msgs_per_sec"] = double(capture.messages.size()) * 1000.0 / median_ms;
+  result["bytes_per_sec"] = double(capture.total_bytes) * 1000.0 / median_ms;
+
+  std::cout << QJsonDocument(result).toJson(QJsonDocument::Indented).toStdString() << std::endl;
+  return 0;
+}
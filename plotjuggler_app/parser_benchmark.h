@@ -0,0 +1,32 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PARSER_BENCHMARK_H
+#define PARSER_BENCHMARK_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * Replay a recorded message capture through MessageParser::parseMessage
+ * in a tight loop, without UI, and print msgs/sec and bytes/sec as JSON
+ * on stdout. Used to benchmark parser changes against real schemas:
+ *
+ *   plotjuggler -n --benchmark_parser datasamples/bench_capture.pjcap
+ *
+ * A capture is a "PJCAPTURE 1" file: a short text header with the
+ * encoding, topic, type name and schema of one topic, followed by the
+ * raw serialized messages (see datasamples/generate_benchmark_fixtures.py
+ * for the exact layout and a generator of JSON captures). The parser is
+ * selected by the encoding in the header, from the built-in factories
+ * and the ParserFactoryPlugin ones.
+ *
+ * @return the process exit code (0 on success).
+ */
+int RunParserBenchmark(const QString& capture_file, int loops,
+                       const QStringList& extra_plugin_folders);
+
+#endif  // PARSER_BENCHMARK_H
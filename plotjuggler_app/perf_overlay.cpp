@@ -0,0 +1,96 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "perf_overlay.h"
+
+#include <QEvent>
+#include <QFontDatabase>
+#include <QVBoxLayout>
+
+#include "PlotJuggler/util/perf_monitor.hpp"
+
+PerfOverlay::PerfOverlay(QWidget* parent) : QWidget(parent)
+{
+  setAttribute(Qt::WA_TransparentForMouseEvents);
+  setStyleSheet("background-color: rgba(20, 20, 20, 180);"
+                "color: rgb(144, 238, 144);"
+                "border-radius: 6px;");
+
+  _label = new QLabel(this);
+  _label->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+  _label->setTextFormat(Qt::PlainText);
+
+  auto layout = new QVBoxLayout(this);
+  layout->setContentsMargins(8, 6, 8, 6);
+  layout->addWidget(_label);
+
+  _refresh_timer.setInterval(500);
+  connect(&_refresh_timer, &QTimer::timeout, this, &PerfOverlay::updateStats);
+
+  // keep the overlay glued to the corner when the window is resized
+  parent->installEventFilter(this);
+  hide();
+}
+
+void PerfOverlay::toggle()
+{
+  if (isVisible())
+  {
+    _refresh_timer.stop();
+    PJ::PerfMonitor::setEnabled(false);
+    hide();
+    return;
+  }
+  PJ::PerfMonitor::instance().reset();
+  PJ::PerfMonitor::setEnabled(true);
+  updateStats();
+  _refresh_timer.start();
+  show();
+  raise();
+}
+
+bool PerfOverlay::eventFilter(QObject* obj, QEvent* event)
+{
+  if (obj == parentWidget() && event->type() == QEvent::Resize && isVisible())
+  {
+    moveToCorner();
+  }
+  return QWidget::eventFilter(obj, event);
+}
+
+void PerfOverlay::updateStats()
+{
+  const auto stats = PJ::PerfMonitor::instance().snapshot();
+
+  QString text = QString("%1  %2  %3  %4\n")
+                     .arg("scope", -40)
+                     .arg("count", 8)
+                     .arg("p50 ms", 8)
+                     .arg("p99 ms", 8);
+  if (stats.empty())
+  {
+    text += "collecting...";
+  }
+  for (const auto& entry : stats)
+  {
+    text += QString("%1  %2  %3  %4\n")
+                .arg(QString::fromStdString(entry.name), -40)
+                .arg(entry.count, 8)
+                .arg(entry.p50_ms, 8, 'f', 2)
+                .arg(entry.p99_ms, 8, 'f', 2);
+  }
+  _label->setText(text.trimmed());
+
+  adjustSize();
+  moveToCorner();
+  raise();
+}
+
+void PerfOverlay::moveToCorner()
+{
+  const int margin = 12;
+  move(parentWidget()->width() - width() - margin, margin);
+}
@@ -0,0 +1,44 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PERF_OVERLAY_H
+#define PERF_OVERLAY_H
+
+#include <QLabel>
+#include <QTimer>
+#include <QWidget>
+
+/**
+ * @brief Translucent overlay in the corner of the main window showing
+ * the timings collected by PJ::PerfMonitor (count, p50, p99 per scope).
+ *
+ * Toggled with F9. The monitor is enabled only while the overlay is
+ * visible, so the instrumented code paths pay nothing when it is hidden.
+ */
+class PerfOverlay : public QWidget
+{
+  Q_OBJECT
+
+public:
+  explicit PerfOverlay(QWidget* parent);
+
+public slots:
+  void toggle();
+
+protected:
+  bool eventFilter(QObject* obj, QEvent* event) override;
+
+private slots:
+  void updateStats();
+
+private:
+  void moveToCorner();
+
+  QLabel* _label;
+  QTimer _refresh_timer;
+};
+
+#endif  // PERF_OVERLAY_H
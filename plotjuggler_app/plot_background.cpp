@@ -5,8 +5,8 @@
  */
 
 #include "plot_background.h"
+#include <QPainter>
 #include "qwt_scale_map.h"
-#include "qwt_painter.h"
 
 BackgroundColorItem::BackgroundColorItem(const PJ::PlotData& data, QString colormap_name)
   : _data(data), _data_name(QString::fromStdString(data.plotName())), _colormap_name(colormap_name)
@@ -27,42 +27,113 @@ void BackgroundColorItem::draw(QPainter* painter, const QwtScaleMap& xMap,
   }
   auto colormap = it->second;
 
-  double prev_Y = _data[0].y;
-  double min_interval = _data[0].x;
-  QColor prev_color = colormap->mapColor(prev_Y);
+  updateSegments(*colormap);
 
+  const double time_offset = _time_offset ? (*_time_offset) : 0;
+  const double back_x = _data.back().x;
+  const qreal pixel_ratio = painter->device()->devicePixelRatioF();
+
+  // a replot that does not change the view (tracker movement, a curve
+  // updated on another axis) reuses the band rendered last time
+  const bool pixmap_valid =
+      !_pixmap.isNull() && _pixmap.devicePixelRatio() == pixel_ratio &&
+      _pixmap_key.canvas == canvasRect && _pixmap_key.s1 == xMap.s1() &&
+      _pixmap_key.s2 == xMap.s2() && _pixmap_key.p1 == xMap.p1() &&
+      _pixmap_key.p2 == xMap.p2() && _pixmap_key.time_offset == time_offset &&
+      _pixmap_key.back_x == back_x && _pixmap_key.segments_version == _segments_version;
+
+  if (!pixmap_valid)
+  {
+    renderBand(xMap, canvasRect, time_offset, pixel_ratio);
+    _pixmap_key = { canvasRect, xMap.s1(),   xMap.s2(), xMap.p1(),
+                    xMap.p2(),  time_offset, back_x,    _segments_version };
+  }
+  painter->drawPixmap(canvasRect.topLeft(), _pixmap);
+}
+
+void BackgroundColorItem::updateSegments(const ColorMap& colormap) const
+{
   auto isEqual = [](double a, double b) {
-    return abs(a - b) < std::numeric_limits<float>::epsilon();
+    return std::abs(a - b) < std::numeric_limits<float>::epsilon();
   };
 
   const size_t N = _data.size();
-  double time_offset = _time_offset ? (*_time_offset) : 0;
+  const double front_x = _data[0].x;
+  const QString script = colormap.script();
 
-  for (size_t i = 1; i < N; i++)
+  // resume from the first unprocessed sample when the series only grew at
+  // the back; a popFront() or a colormap edit invalidates the whole list
+  const bool can_resume = _seg_next_index > 0 && _seg_next_index <= N &&
+                          _data[_seg_next_index - 1].x == _seg_last_x &&
+                          front_x == _seg_front_x && script == _seg_script;
+  size_t i = _seg_next_index;
+  if (!can_resume)
+  {
+    _segments.clear();
+    _seg_prev_y = _data[0].y;
+    _seg_prev_rgba = colormap.mapColor(_seg_prev_y).rgba();
+    _segments.push_back({ front_x, _seg_prev_rgba });
+    _seg_front_x = front_x;
+    _seg_script = script;
+    i = 1;
+    _segments_version++;
+  }
+
+  if (i < N)
+  {
+    _segments_version++;
+  }
+  for (; i < N; i++)
   {
     const auto& point = _data[i];
-    if (isEqual(prev_Y, point.y) && (i + 1) < N)
+    if (isEqual(_seg_prev_y, point.y))
     {
       continue;
     }
-    QColor color = colormap->mapColor(point.y);
-    if (prev_color != color || (i + 1) == N)
+    _seg_prev_y = point.y;
+    const QRgb rgba = colormap.mapColor(point.y).rgba();
+    if (rgba != _seg_prev_rgba)
     {
-      double max_interval = point.x;
-      double x1 = xMap.transform(min_interval - time_offset);
-      double x2 = xMap.transform(max_interval - time_offset);
-
-      QRectF r(x1, canvasRect.top(), x2 - x1, canvasRect.height());
-      r = r.normalized();
-
-      if (x1 < x2 && prev_color != Qt::transparent)
-      {
-        QwtPainter::fillRect(painter, r, prev_color);
-      }
-      prev_color = color;
-      min_interval = max_interval;
+      _segments.push_back({ point.x, rgba });
+      _seg_prev_rgba = rgba;
+    }
+  }
+  _seg_next_index = N;
+  _seg_last_x = _data[N - 1].x;
+}
+
+void BackgroundColorItem::renderBand(const QwtScaleMap& xMap, const QRectF& canvasRect,
+                                     double time_offset, qreal pixel_ratio) const
+{
+  const QSize size = (canvasRect.size() * pixel_ratio).toSize();
+  if (_pixmap.size() != size)
+  {
+    _pixmap = QPixmap(size);
+  }
+  _pixmap.setDevicePixelRatio(pixel_ratio);
+  _pixmap.fill(Qt::transparent);
+
+  QPainter band_painter(&_pixmap);
+
+  for (size_t i = 0; i < _segments.size(); i++)
+  {
+    const QRgb rgba = _segments[i].second;
+    const double t0 = _segments[i].first;
+    const double t1 = (i + 1 < _segments.size()) ? _segments[i + 1].first : _data.back().x;
+
+    if (qAlpha(rgba) == 0)
+    {
+      continue;
+    }
+    const double x1 = xMap.transform(t0 - time_offset) - canvasRect.left();
+    const double x2 = xMap.transform(t1 - time_offset) - canvasRect.left();
+
+    if (x1 >= x2 || x2 <= 0.0 || x1 >= canvasRect.width())
+    {
+      continue;
     }
-    prev_Y = point.y;
+    band_painter.fillRect(QRectF(x1, 0.0, x2 - x1, canvasRect.height()),
+                          QColor::fromRgba(rgba));
   }
 }
 
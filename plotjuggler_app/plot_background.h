@@ -8,6 +8,7 @@
 #define PLOT_BACKGROUND_H
 
 #include <QBrush>
+#include <QPixmap>
 #include "qwt_plot_zoneitem.h"
 
 #include "PlotJuggler/plotdata.h"
@@ -46,10 +47,42 @@ public:
   }
 
 private:
+  void updateSegments(const ColorMap& colormap) const;
+
+  void renderBand(const QwtScaleMap& xMap, const QRectF& canvasRect, double time_offset,
+                  qreal pixel_ratio) const;
+
   const PJ::PlotData& _data;
   QString _data_name;
   QString _colormap_name;
   double* _time_offset = nullptr;
+
+  // --- repaint caches, draw() is const ---
+
+  // run-length segments of the series (start time + color of each run):
+  // the Lua colormap is evaluated only at the change points, and only for
+  // the samples appended since the previous repaint
+  mutable std::vector<std::pair<double, QRgb>> _segments;
+  mutable uint64_t _segments_version = 0;
+  mutable size_t _seg_next_index = 0;
+  mutable double _seg_last_x = 0;
+  mutable double _seg_front_x = 0;
+  mutable double _seg_prev_y = 0;
+  mutable QRgb _seg_prev_rgba = 0;
+  mutable QString _seg_script;
+
+  // rendered band, blitted as-is on the replots that do not change the
+  // view (e.g. the time tracker moving during playback)
+  mutable QPixmap _pixmap;
+  struct PixmapKey
+  {
+    QRectF canvas;
+    double s1, s2, p1, p2;
+    double time_offset;
+    double back_x;
+    uint64_t segments_version;
+  };
+  mutable PixmapKey _pixmap_key = {};
 };
 
 #endif  // PLOT_BACKGROUND_H
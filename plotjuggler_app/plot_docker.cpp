@@ -339,8 +339,6 @@ DockWidget::DockWidget(PlotDataMapRef& datamap, QWidget* parent)
 
   static int plot_count = 0;
   QString plot_name = QString("_plot_%1_").arg(plot_count++);
-  _plot_widget = new PlotWidget(datamap, this);
-  setWidget(_plot_widget);
   setFeature(ads::CDockWidget::DockWidgetFloatable, false);
   setFeature(ads::CDockWidget::DockWidgetDeleteOnClose, true);
 
@@ -353,15 +351,7 @@ DockWidget::DockWidget(PlotDataMapRef& datamap, QWidget* parent)
 
   connect(_toolbar->buttonSplitVertical(), &QPushButton::clicked, this, &DockWidget::splitVertical);
 
-  connect(_toolbar, &DockToolbar::backgroundColorRequest, _plot_widget,
-          &PlotWidget::onBackgroundColorRequest);
-
-  connect(_plot_widget, &PlotWidget::splitHorizontal, this, &DockWidget::splitHorizontal);
-
-  connect(_plot_widget, &PlotWidget::splitVertical, this, &DockWidget::splitVertical);
-
-  connect(_toolbar, &DockToolbar::titleChanged, _plot_widget,
-          [this](QString title) { _plot_widget->setStatisticsTitle(title); });
+  setPlotWidget(new PlotWidget(datamap, this));
 
   auto FullscreenAction = [this]() {
     PlotDocker* parent_docker = static_cast<PlotDocker*>(dockManager());
@@ -439,6 +429,76 @@ PlotWidget* DockWidget::plotWidget()
   return _plot_widget;
 }
 
+PlotWidget* DockWidget::takePlotWidget()
+{
+  auto plot = _plot_widget;
+  _plot_widget = nullptr;
+  if (plot)
+  {
+    takeWidget();
+    disconnect(_toolbar, nullptr, plot, nullptr);
+    disconnect(plot, nullptr, this, nullptr);
+  }
+  return plot;
+}
+
+void DockWidget::setPlotWidget(PlotWidget* plot)
+{
+  _plot_widget = plot;
+  setWidget(plot);
+  plot->setStatisticsTitle(name());
+
+  connect(_toolbar, &DockToolbar::backgroundColorRequest, plot,
+          &PlotWidget::onBackgroundColorRequest);
+
+  connect(_toolbar, &DockToolbar::titleChanged, plot,
+          [plot](QString title) { plot->setStatisticsTitle(title); });
+
+  connect(plot, &PlotWidget::splitHorizontal, this, &DockWidget::splitHorizontal);
+
+  connect(plot, &PlotWidget::splitVertical, this, &DockWidget::splitVertical);
+
+  connect(plot, &PlotWidget::swapWidgetsRequested, this, &DockWidget::onSwapWidgets);
+}
+
+void DockWidget::onSwapWidgets(PlotWidget* source, PlotWidget* destination)
+{
+  if (destination != _plot_widget)
+  {
+    return;
+  }
+  // the source may belong to another PlotDocker (or even another window):
+  // find its dock by walking up the widget tree
+  DockWidget* source_dock = nullptr;
+  for (QWidget* widget = source->parentWidget(); widget; widget = widget->parentWidget())
+  {
+    if (auto dock = qobject_cast<DockWidget*>(widget))
+    {
+      source_dock = dock;
+      break;
+    }
+  }
+  if (!source_dock || source_dock == this)
+  {
+    return;
+  }
+
+  // move the live widgets: curves, transforms and zoom state travel with
+  // them, nothing is serialized or rebuilt
+  auto this_plot = takePlotWidget();
+  auto other_plot = source_dock->takePlotWidget();
+
+  // the title follows the plot
+  const QString this_name = name();
+  _toolbar->label()->setText(source_dock->name());
+  source_dock->toolBar()->label()->setText(this_name);
+
+  setPlotWidget(other_plot);
+  source_dock->setPlotWidget(this_plot);
+
+  emit undoableChange();
+}
+
 DockToolbar* DockWidget::toolBar()
 {
   return _toolbar;
@@ -24,6 +24,14 @@ public:
 
   PlotWidget* plotWidget();
 
+  /// Detach the plot from this dock without destroying it, undoing the
+  /// dock-specific connections. The caller takes ownership.
+  PlotWidget* takePlotWidget();
+
+  /// Install a plot (typically taken from another dock) as the content of
+  /// this dock, moving the live widget instead of rebuilding it from XML.
+  void setPlotWidget(PlotWidget* plot);
+
   DockToolbar* toolBar();
 
   QString name() const;
@@ -33,6 +41,9 @@ public slots:
 
   DockWidget* splitVertical();
 
+private slots:
+  void onSwapWidgets(PlotWidget* source, PlotWidget* destination);
+
 private:
   PlotWidget* _plot_widget = nullptr;
 
@@ -7,6 +7,8 @@
 #include "plot_docker_toolbar.h"
 #include "PlotJuggler/svg_util.h"
 #include <QCoreApplication>
+#include <QDrag>
+#include <QMimeData>
 
 DockToolbar::DockToolbar(ads::CDockWidget* parent)
   : QWidget(parent), _parent(parent), ui(new Ui::DraggableToolbar), _fullscreen_mode(false)
@@ -57,6 +59,22 @@ void DockToolbar::toggleFullscreen()
 
 void DockToolbar::mousePressEvent(QMouseEvent* ev)
 {
+  if (ev->button() == Qt::LeftButton && ev->modifiers() == Qt::ControlModifier)
+  {
+    // CTRL + drag swaps this plot with the one it is dropped onto.
+    // The drag never leaves the application, so the payload is just the
+    // pointer of the widget being moved.
+    QByteArray encoded;
+    QDataStream stream(&encoded, QIODevice::WriteOnly);
+    stream << quint64(quintptr(_parent->widget()));
+
+    auto mime_data = new QMimeData;
+    mime_data->setData("plot_area", encoded);
+    auto drag = new QDrag(this);
+    drag->setMimeData(mime_data);
+    drag->exec();
+    return;
+  }
   QCoreApplication::sendEvent(_parent->dockAreaWidget()->titleBar(), ev);
 }
 
@@ -94,6 +94,12 @@ PlotWidget::PlotWidget(PlotDataMapRef& datamap, QWidget* parent)
   _grid = new QwtPlotGrid();
   _grid->setPen(QPen(Qt::gray, 0.0, Qt::DotLine));
 
+  // timeseries curves are attached to the invisible xTop axis, which mirrors
+  // xBottom shifted by the time offset: whenever the visible axis moves, the
+  // hidden one must follow
+  connect(qwtPlot()->axisWidget(QwtPlot::xBottom), &QwtScaleWidget::scaleDivChanged, this,
+          &PlotWidget::syncOffsetAxis);
+
   connect(this, &PlotWidgetBase::viewResized, this, &PlotWidget::on_externallyResized);
 
   connect(this, &PlotWidgetBase::dragEnterSignal, this, &PlotWidget::onDragEnterEvent);
@@ -223,6 +229,13 @@ void PlotWidget::buildActions()
 
   _action_data_statistics = new QAction("&Show data statistics", this);
   connect(_action_data_statistics, &QAction::triggered, this, &PlotWidget::onShowDataStatistics);
+
+  _action_envelope = new QAction("&Min/max envelope", this);
+  _action_envelope->setCheckable(true);
+  _action_envelope->setToolTip("Draw zoomed-out curves as a min/max band with the mean "
+                               "line on top, instead of a decimated line");
+  connect(_action_envelope, &QAction::toggled, this,
+          [this](bool checked) { setEnvelopeEnabled(checked); });
 }
 
 void PlotWidget::canvasContextMenuTriggered(const QPoint& pos)
@@ -266,6 +279,10 @@ void PlotWidget::canvasContextMenuTriggered(const QPoint& pos)
   {
     menu.addAction(_flip_x);
   }
+  else
+  {
+    menu.addAction(_action_envelope);
+  }
   menu.addAction(_flip_y);
   menu.addSeparator();
   menu.addAction(_action_copy);
@@ -408,6 +425,12 @@ PlotWidgetBase::CurveInfo* PlotWidget::addCurve(const std::string& name, QColor
     if (auto timeseries = dynamic_cast<QwtTimeseries*>(info->curve->data()))
     {
       timeseries->setTimeOffset(_time_offset);
+      if (!isXYPlot())
+      {
+        // samples stay in absolute time; the offset is applied by the
+        // mirrored axis the curve is attached to
+        info->curve->setXAxis(QwtPlot::xTop);
+      }
     }
   }
   _tracker->redraw();
@@ -423,16 +446,21 @@ void PlotWidget::removeCurve(const QString& title)
 }
 
 void PlotWidget::onDataSourceRemoved(const std::string& src_name)
+{
+  onDataSourcesRemoved({ src_name });
+}
+
+void PlotWidget::onDataSourcesRemoved(const std::set<std::string>& src_names)
 {
   bool deleted = false;
 
   for (auto it = curveList().begin(); it != curveList().end();)
   {
     PointSeriesXY* curve_xy = dynamic_cast<PointSeriesXY*>(it->curve->data());
-    bool remove_curve_xy = curve_xy && (curve_xy->dataX()->plotName() == src_name ||
-                                        curve_xy->dataY()->plotName() == src_name);
+    bool remove_curve_xy = curve_xy && (src_names.count(curve_xy->dataX()->plotName()) > 0 ||
+                                        src_names.count(curve_xy->dataY()->plotName()) > 0);
 
-    if (it->src_name == src_name || remove_curve_xy)
+    if (remove_curve_xy || src_names.count(it->src_name) > 0)
     {
       deleted = true;
       it->curve->detach();
@@ -451,7 +479,7 @@ void PlotWidget::onDataSourceRemoved(const std::string& src_name)
     _reference_tracker->redraw();
     emit curveListChanged();
   }
-  if (_background_item && _background_item->dataName() == QString::fromStdString(src_name))
+  if (_background_item && src_names.count(_background_item->dataName().toStdString()) > 0)
   {
     _background_item->detach();
     _background_item.reset();
@@ -466,6 +494,7 @@ void PlotWidget::removeAllCurves()
   _reference_tracker->redraw();
   _flip_x->setChecked(false);
   _flip_y->setChecked(false);
+  _action_envelope->setChecked(false);
 }
 
 void PlotWidget::onDragEnterEvent(QDragEnterEvent* event)
@@ -477,6 +506,25 @@ void PlotWidget::onDragEnterEvent(QDragEnterEvent* event)
   _dragging.curves.clear();
   _dragging.source = event->source();
 
+  // a whole plot dragged from the toolbar of another dock: the payload is
+  // the pointer of the source widget, valid because the drag never leaves
+  // the application
+  if (mimeFormats.contains("plot_area"))
+  {
+    QByteArray encoded = mimeData->data("plot_area");
+    QDataStream stream(&encoded, QIODevice::ReadOnly);
+    quint64 source_ptr = 0;
+    stream >> source_ptr;
+    auto source_plot = qobject_cast<PlotWidget*>(reinterpret_cast<QWidget*>(quintptr(source_ptr)));
+    if (source_plot && source_plot != this)
+    {
+      _dragging.mode = DragInfo::SWAP_PLOTS;
+      _dragging.source = source_plot;
+      event->acceptProposedAction();
+    }
+    return;
+  }
+
   auto& format = mimeFormats.first();
   QByteArray encoded = mimeData->data(format);
   QDataStream stream(&encoded, QIODevice::ReadOnly);
@@ -536,6 +584,18 @@ void PlotWidget::onDropEvent(QDropEvent*)
 
   bool noCurves = curveList().empty();
 
+  if (_dragging.mode == DragInfo::SWAP_PLOTS)
+  {
+    auto source_plot = qobject_cast<PlotWidget*>(_dragging.source);
+    _dragging.mode = DragInfo::NONE;
+    _dragging.curves.clear();
+    if (source_plot)
+    {
+      emit swapWidgetsRequested(source_plot, this);
+    }
+    return;
+  }
+
   if (_dragging.mode == DragInfo::CURVES)
   {
     size_t scatter_count = 0;
@@ -1131,6 +1191,8 @@ void PlotWidget::on_changeTimeOffset(double offset)
 
   if (fabs(prev_offset - offset) > std::numeric_limits<double>::epsilon())
   {
+    // the curves themselves are untouched: shifting the mirrored axis is all
+    // it takes to reposition them, whatever the number of samples
     for (auto& it : curveList())
     {
       if (auto series = dynamic_cast<QwtTimeseries*>(it.curve->data()))
@@ -1138,6 +1200,7 @@ void PlotWidget::on_changeTimeOffset(double offset)
         series->setTimeOffset(_time_offset);
       }
     }
+    syncOffsetAxis();
     if (!isXYPlot() && !curveList().empty())
     {
       QRectF rect = currentBoundingRect();
@@ -1149,6 +1212,17 @@ void PlotWidget::on_changeTimeOffset(double offset)
   updateMaximumZoomArea();
 }
 
+void PlotWidget::syncOffsetAxis()
+{
+  if (isXYPlot())
+  {
+    return;
+  }
+  const QwtScaleDiv& bottom = qwtPlot()->axisScaleDiv(QwtPlot::xBottom);
+  setAxisScaleIfChanged(QwtPlot::xTop, bottom.lowerBound() + _time_offset,
+                        bottom.upperBound() + _time_offset);
+}
+
 void PlotWidget::on_changeDateTimeScale(bool enable)
 {
   _use_date_time_scale = enable;
@@ -1201,12 +1275,24 @@ Range PlotWidget::getVisualizationRangeY(Range range_X) const
 }
 
 void PlotWidget::updateCurves(bool reset_older_data)
+{
+  prepareCurves(reset_older_data);
+  finishUpdateCurves();
+}
+
+void PlotWidget::prepareCurves(bool reset_older_data)
 {
   for (auto& it : curveList())
   {
     auto series = dynamic_cast<QwtSeriesWrapper*>(it.curve->data());
     series->updateCache(reset_older_data);
   }
+}
+
+void PlotWidget::finishUpdateCurves()
+{
+  _curves_update_deferred = false;
+
   updateMaximumZoomArea();
 
   updateStatistics(true);
@@ -1218,8 +1304,10 @@ void PlotWidget::updateStatistics(bool forceUpdate)
   {
     if (_statistics_dialog->calcVisibleRange() || forceUpdate)
     {
+      // samples hold absolute timestamps, the visible axis relative ones
       auto rect = currentBoundingRect();
-      _statistics_dialog->update({ rect.left(), rect.right() });
+      const double offset = isXYPlot() ? 0.0 : _time_offset;
+      _statistics_dialog->update({ rect.left() + offset, rect.right() + offset });
     }
   }
 }
@@ -1410,6 +1498,15 @@ void PlotWidget::zoomOut(bool emit_signal)
   }
   updateMaximumZoomArea();
 
+  // updateMaximumZoomArea() only folds the cached per-series ranges, so
+  // reaching this point is cheap; skip the replot when the view is
+  // already fully zoomed out (with a locked aspect ratio the target
+  // rectangle is recomputed from the canvas shape, don't second-guess it)
+  if (!(isXYPlot() && keepRatioXY()) && maxZoomRect() == currentBoundingRect())
+  {
+    return;
+  }
+
   setZoomRectangle(maxZoomRect(), emit_signal);
   replot();
 }
@@ -1444,6 +1541,15 @@ void PlotWidget::setModeXY(bool enable)
   }
   PlotWidgetBase::setModeXY(enable);
 
+  // XY curves live on the visible axis; timeseries on the mirrored one
+  for (auto& it : curveList())
+  {
+    const bool is_timeseries = dynamic_cast<QwtTimeseries*>(it.curve->data()) != nullptr &&
+                               dynamic_cast<PointSeriesXY*>(it.curve->data()) == nullptr;
+    it.curve->setXAxis((!enable && is_timeseries) ? QwtPlot::xTop : QwtPlot::xBottom);
+  }
+  syncOffsetAxis();
+
   enableTracker(!enable);
 
   if (enable)
@@ -1481,7 +1587,7 @@ void PlotWidget::on_savePlotToFile()
   plotOn(save_plots_helper, { 0, 0, plot_size.width(), plot_size.height() });
 }
 
-void PlotWidget::plotOn(const PlotSaveHelper& plot_save_helper, QRect paint_at)
+void PlotWidget::plotOn(PlotSaveHelper& plot_save_helper, QRect paint_at)
 {
   bool tracker_enabled = _tracker->isEnabled();
   if (tracker_enabled)
@@ -1695,15 +1801,15 @@ void PlotWidget::setAxisScale(QwtAxisId axisId, double min, double max)
   }
   if (axisId == QwtPlot::xBottom && _flip_x->isChecked())
   {
-    qwtPlot()->setAxisScale(QwtPlot::xBottom, max, min);
+    setAxisScaleIfChanged(QwtPlot::xBottom, max, min);
   }
   else if (axisId == QwtPlot::yLeft && _flip_y->isChecked())
   {
-    qwtPlot()->setAxisScale(QwtPlot::yLeft, max, min);
+    setAxisScaleIfChanged(QwtPlot::yLeft, max, min);
   }
   else
   {
-    qwtPlot()->setAxisScale(axisId, min, max);
+    setAxisScaleIfChanged(axisId, min, max);
   }
 }
 
@@ -9,6 +9,7 @@
 
 #include <map>
 #include <deque>
+#include <set>
 #include <QObject>
 #include <QTextEdit>
 #include <QDomDocument>
@@ -109,8 +110,40 @@ public slots:
 
   void updateCurves(bool reset_older_data);
 
+  /** Data-only part of updateCurves(): recompute the cache of each curve
+   * (transforms, XY pairing). It touches neither Qwt nor the GUI, but it is
+   * NOT safe to run concurrently with the same method of other widgets:
+   * curves in different widgets can read the same source series, and those
+   * reads mutate it (staging flush, index hint, chunk re-materialization).
+   * The parallel path in MainWindow instead groups curves by source series
+   * (see PrepareCurvesGroupedBySource in mainwindow.cpp).
+   * Must be followed by finishUpdateCurves() on the GUI thread.
+   */
+  void prepareCurves(bool reset_older_data);
+
+  void finishUpdateCurves();
+
+  /** Called instead of prepareCurves() when this widget sits on a hidden
+   * tab during streaming: the curve caches (transforms, XY pairing) are
+   * left stale and recomputed with a catch-up pass when the widget is
+   * shown again. */
+  void deferCurvesUpdate()
+  {
+    _curves_update_deferred = true;
+  }
+
+  bool curvesUpdateDeferred() const
+  {
+    return _curves_update_deferred;
+  }
+
   void onDataSourceRemoved(const std::string& src_name);
 
+  /// Batch version of onDataSourceRemoved(): the curve list is walked
+  /// once and curveListChanged() is emitted at most once, whatever the
+  /// number of deleted sources.
+  void onDataSourcesRemoved(const std::set<std::string>& src_names);
+
   void removeAllCurves() override;
 
   void on_panned(int dx, int dy);
@@ -149,7 +182,7 @@ public slots:
 
   void onShowDataStatistics();
 
-  void plotOn(const PlotSaveHelper& plot_save_helper, QRect paint_at);
+  void plotOn(PlotSaveHelper& plot_save_helper, QRect paint_at);
 
 private slots:
 
@@ -191,11 +224,14 @@ private:
 
   QAction* _flip_x;
   QAction* _flip_y;
+  QAction* _action_envelope;
 
   CurveTracker* _tracker;
   CurveTracker* _reference_tracker;
   QwtPlotGrid* _grid;
 
+  bool _curves_update_deferred = false;
+
   bool _show_point_enabled = false;
   QwtPlotMarker* _show_point_marker;
   QwtPlotMarker* _show_point_text;
@@ -214,7 +250,8 @@ private:
     {
       NONE,
       CURVES,
-      NEW_XY
+      NEW_XY,
+      SWAP_PLOTS
     } mode;
     std::vector<QString> curves;
     QObject* source;
@@ -249,6 +286,10 @@ private:
   void rescaleEqualAxisScaling();
 
   void setAxisScale(QwtAxisId axisId, double min, double max);
+
+  /// Keep the hidden xTop axis (the one timeseries curves are attached to)
+  /// at [xBottom + time offset], so that samples can stay in absolute time.
+  void syncOffsetAxis();
 };
 
 #endif
@@ -16,6 +16,72 @@
 #include <QDialogButtonBox>
 #include <QDebug>
 #include <qwt_text.h>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "PlotJuggler/thread_pool.h"
+
+// Recompute a batch of transformed series, fanning the work out to the
+// shared pool when more than one independent source is involved, so that
+// applying a transform to many selected curves scales with the cores
+// instead of running sequentially on the GUI thread.
+//
+// Curves reading the same source stay in the same task: recomputing
+// flushes the staging buffer of the source series.
+static void RecomputeTransforms(
+    const std::vector<std::pair<std::string, TransformedTimeseries*>>& curves,
+    bool reset_old_data)
+{
+  std::map<std::string, std::vector<TransformedTimeseries*>> groups;
+  for (const auto& [src_name, series] : curves)
+  {
+    groups[src_name].push_back(series);
+  }
+
+  if (groups.size() <= 1)
+  {
+    for (const auto& [src_name, series] : curves)
+    {
+      series->updateCache(reset_old_data);
+    }
+    return;
+  }
+
+  std::atomic<size_t> remaining(groups.size());
+  std::mutex mutex;
+  std::condition_variable all_done;
+
+  for (auto& it : groups)
+  {
+    auto* group = &it.second;
+    PJ::ThreadPool::instance().submit(
+        PJ::ThreadPool::Priority::TRANSFORM,
+        [group, reset_old_data, &remaining, &mutex, &all_done]() {
+          for (auto* series : *group)
+          {
+            try
+            {
+              series->updateCache(reset_old_data);
+            }
+            catch (const std::exception& err)
+            {
+              qWarning() << "Failed to apply transform:" << err.what();
+            }
+          }
+          if (remaining.fetch_sub(1) == 1)
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            all_done.notify_one();
+          }
+        });
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  all_done.wait(lock, [&remaining]() { return remaining.load() == 0; });
+}
 
 DialogTransformEditor::DialogTransformEditor(PlotWidget* plotwidget)
   : QDialog(plotwidget), ui(new Ui::plotwidget_transforms), _plotwidget_origin(plotwidget)
@@ -192,6 +258,7 @@ void DialogTransformEditor::on_listTransforms_itemSelectionChanged()
   }
 
   TransformedTimeseries* ts = nullptr;
+  std::vector<std::pair<std::string, TransformedTimeseries*>> to_recompute;
 
   for (auto item : selected_curves)
   {
@@ -209,7 +276,6 @@ void DialogTransformEditor::on_listTransforms_itemSelectionChanged()
     if (transform_ID.isEmpty())
     {
       ts->setTransform({});
-      ts->updateCache(true);
 
       if (has_default_title)
       {
@@ -221,7 +287,6 @@ void DialogTransformEditor::on_listTransforms_itemSelectionChanged()
     else
     {
       ts->setTransform(transform_ID);
-      ts->updateCache(true);
 
       if (has_default_title)
       {
@@ -237,8 +302,11 @@ void DialogTransformEditor::on_listTransforms_itemSelectionChanged()
         ui->lineEditAlias->setEnabled(true);
       }
     }
+    to_recompute.push_back({ curve_info->src_name, ts });
   }
 
+  RecomputeTransforms(to_recompute, true);
+
   // use the last selected curve, as the transform widget presenter
   if (ts && ts->transform())
   {
@@ -257,17 +325,19 @@ void DialogTransformEditor::on_listTransforms_itemSelectionChanged()
       if (_connected_transform_widgets.count(widget) == 0)
       {
         connect(ts->transform().get(), &TransformFunction::parametersChanged, this, [this, ts]() {
-          // update this transform
-          ts->updateCache(true);
-
-          // update the others if necessary
-          if (ui->listCurves->selectedItems().size() > 1)
+          if (ui->listCurves->selectedItems().size() <= 1)
+          {
+            // update this transform only
+            ts->updateCache(true);
+          }
+          else
           {
             // Copy state from visible widget and apply to all selected curves.
             QDomDocument doc;
             QDomElement transform_state = doc.createElement("transform");
             ts->transform()->xmlSaveState(doc, transform_state);
 
+            std::vector<std::pair<std::string, TransformedTimeseries*>> to_recompute;
             for (auto item : ui->listCurves->selectedItems())
             {
               auto row_widget = dynamic_cast<RowWidget*>(ui->listCurves->itemWidget(item));
@@ -279,9 +349,10 @@ void DialogTransformEditor::on_listTransforms_itemSelectionChanged()
               {
                 QSignalBlocker block_transform(item_ts->transform().get());
                 item_ts->transform()->xmlLoadState(transform_state);
-                item_ts->updateCache(true);
               }
+              to_recompute.push_back({ curve_info->src_name, item_ts });
             }
+            RecomputeTransforms(to_recompute, true);
           }
           // replot
           if (ui->checkBoxAutoZoom->isChecked())
@@ -2,6 +2,7 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QDebug>
+#include <QtConcurrent/QtConcurrent>
 #include <iostream>
 
 #ifdef WASM_RUNTIME_ENABLED
@@ -22,6 +23,9 @@ void PluginManager::loadPluginsFromFolder(const QString& folderPath)
     return;
   }
 
+  QStringList native_plugins;
+  QStringList wasm_plugins;
+
   for (const QString& filename : pluginsDir.entryList(QDir::Files))
   {
     QFileInfo fileInfo(filename);
@@ -32,13 +36,32 @@ void PluginManager::loadPluginsFromFolder(const QString& folderPath)
     }
     if (fileInfo.suffix() == "so" || fileInfo.suffix() == "dll" || fileInfo.suffix() == "dylib")
     {
-      loadPlugin(pluginPath);
+      native_plugins.push_back(pluginPath);
     }
     if (fileInfo.suffix() == "wasm")
     {
-      loadWASM(pluginPath);
+      wasm_plugins.push_back(pluginPath);
     }
   }
+
+  // Map and relocate the libraries in parallel worker threads. load() checks
+  // the Qt plugin metadata before dlopen-ing (like the serial code did) and
+  // dlopen is thread-safe and refcounted, so the QPluginLoader inside
+  // loadPlugin() finds each library already in memory. On slow (e.g. network
+  // mounted) install folders this overlaps the file reads instead of paying
+  // their latency one plugin at a time. The root components are still
+  // instantiated sequentially on the caller thread, where they must live.
+  QtConcurrent::blockingMap(native_plugins,
+                            [](const QString& path) { QPluginLoader(path).load(); });
+
+  for (const QString& pluginPath : native_plugins)
+  {
+    loadPlugin(pluginPath);
+  }
+  for (const QString& pluginPath : wasm_plugins)
+  {
+    loadWASM(pluginPath);
+  }
 }
 
 void PluginManager::loadPlugin(const QString& filename)
@@ -7,6 +7,7 @@
 #include "point_series_xy.h"
 #include <cmath>
 #include <cstdlib>
+#include "PlotJuggler/util/time_align.hpp"
 
 PointSeriesXY::PointSeriesXY(const PlotData* x_axis, const PlotData* y_axis)
   : QwtTimeseries(nullptr), _x_axis(x_axis), _y_axis(y_axis), _cached_curve("", x_axis->group())
@@ -26,8 +27,10 @@ std::optional<QPointF> PointSeriesXY::sampleFromTime(double t)
     return {};
   }
 
-  int index = _y_axis->getIndexFromX(t);
-  if (index < 0)
+  // the cache rows follow the time axis of the X series; with
+  // interpolation the rows before _row_offset have been dropped
+  int index = _x_axis->getIndexFromX(t) - int(_row_offset);
+  if (index < 0 || size_t(index) >= _cached_curve.size())
   {
     return {};
   }
@@ -42,31 +45,86 @@ RangeOpt PointSeriesXY::getVisualizationRangeY(Range)
 
 void PointSeriesXY::updateCache(bool reset_old_data)
 {
-  _cached_curve.clear();
-
   if (_x_axis == nullptr)
   {
     throw std::runtime_error("the X axis is null");
   }
 
-  const size_t data_size = std::min(_x_axis->size(), _y_axis->size());
+  const double EPS = std::numeric_limits<double>::epsilon();
 
-  if (data_size == 0)
+  if (_interpolated)
   {
+    rebuildInterpolated();
     return;
   }
 
-  const double EPS = std::numeric_limits<double>::epsilon();
+  size_t matched = _cached_curve.size();
+
+  // Resume from the last matched pair when the sources only grew at the back:
+  // rebuilding from scratch makes streaming XY plots O(n) per frame.
+  // The pairs already in the cache are valid only if they are still at the
+  // same indices; a popFront() during streaming shifts them, and we detect
+  // that by re-checking the timestamp of the last matched sample.
+  const bool can_resume = !reset_old_data && matched > 0 && matched <= _x_axis->size() &&
+                          matched <= _y_axis->size() &&
+                          std::abs(_x_axis->at(matched - 1).x - _last_matched_time) <= EPS;
+  if (!can_resume)
+  {
+    _cached_curve.clear();
+    matched = 0;
+  }
+
+  const size_t data_size = std::min(_x_axis->size(), _y_axis->size());
 
-  for (size_t i = 0; i < data_size; i++)
+  for (size_t i = matched; i < data_size; i++)
   {
     if (std::abs(_x_axis->at(i).x - _y_axis->at(i).x) > EPS)
     {
-      throw std::runtime_error("X and Y axis don't share the same time axis");
+      // the sources don't share the same time axis: switch permanently
+      // to the interpolated alignment, which has no resume path
+      _interpolated = true;
+      rebuildInterpolated();
+      return;
     }
+    _cached_curve.pushBack({ _x_axis->at(i).y, _y_axis->at(i).y });
+  }
+
+  if (data_size > 0)
+  {
+    _last_matched_time = _x_axis->at(data_size - 1).x;
+  }
+}
+
+void PointSeriesXY::rebuildInterpolated()
+{
+  _cached_curve.clear();
+  _row_offset = 0;
+
+  const size_t rows = _x_axis->size();
+  if (rows == 0 || _y_axis->size() == 0)
+  {
+    return;
+  }
+
+  std::vector<double> timebase;
+  timebase.reserve(rows);
+  for (size_t i = 0; i < rows; i++)
+  {
+    timebase.push_back(_x_axis->at(i).x);
+  }
+  const auto y_values = PJ::InterpolateOnTimebase(*_y_axis, timebase);
 
-    const QPointF p(_x_axis->at(i).y, _y_axis->at(i).y);
-    _cached_curve.pushBack({ p.x(), p.y() });
+  // NaN marks the rows outside the time range of the Y series:
+  // a leading and a trailing run, by construction
+  size_t row = 0;
+  while (row < rows && std::isnan(y_values[row]))
+  {
+    row++;
+  }
+  _row_offset = row;
+  for (; row < rows && !std::isnan(y_values[row]); row++)
+  {
+    _cached_curve.pushBack({ _x_axis->at(row).y, y_values[row] });
   }
 }
 
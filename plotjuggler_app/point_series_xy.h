@@ -45,9 +45,20 @@ public:
   }
 
 protected:
+  // used when the two sources don't share the same time axis: the Y
+  // series is linearly interpolated at the timestamps of the X series
+  void rebuildInterpolated();
+
   const PlotData* _x_axis;
   const PlotData* _y_axis;
   PlotDataXY _cached_curve;
+  // timestamp of the last pair appended to _cached_curve, used by
+  // updateCache() to decide if it can resume instead of rebuilding
+  double _last_matched_time = 0;
+  bool _interpolated = false;
+  // index in the X series of the first row of _cached_curve (rows of
+  // the X series outside the time range of the Y series are dropped)
+  size_t _row_offset = 0;
 };
 
 #endif  // POINT_SERIES_H
@@ -70,6 +70,21 @@ PreferencesDialog::PreferencesDialog(QWidget* parent)
   bool truncation_check = settings.value("Preferences::truncation_check", true).toBool();
   ui->checkBoxTruncation->setChecked(truncation_check);
 
+  bool sandboxed_loaders = settings.value("Preferences::sandboxed_loaders", false).toBool();
+  ui->checkBoxSandboxedLoaders->setChecked(sandboxed_loaders);
+
+  // default scheduling of the streaming ingest threads; per-plugin
+  // overrides use "StreamerThread::<plugin name>" (see datastreamer_base.h)
+  ui->lineEditStreamerAffinity->setText(
+      settings.value("StreamerThread::default/affinity").toString());
+  ui->spinBoxStreamerFifo->setValue(
+      settings.value("StreamerThread::default/fifo_priority", 0).toInt());
+  ui->checkBoxStreamerBusyPoll->setChecked(
+      settings.value("StreamerThread::default/busy_poll", false).toBool());
+#ifndef __linux__
+  ui->groupBoxStreamerThreads->setEnabled(false);
+#endif
+
   // Plugins
   ui->pushButtonAdd->setIcon(LoadSvg(":/resources/svg/add_tab.svg", theme));
   ui->pushButtonRemove->setIcon(LoadSvg(":/resources/svg/trash.svg", theme));
@@ -118,6 +133,12 @@ void PreferencesDialog::on_buttonBox_accepted()
   settings.setValue("Preferences::autozoom_filter_applied",
                     ui->checkBoxAutoZoomFilter->isChecked());
   settings.setValue("Preferences::truncation_check", ui->checkBoxTruncation->isChecked());
+  settings.setValue("Preferences::sandboxed_loaders", ui->checkBoxSandboxedLoaders->isChecked());
+  settings.setValue("StreamerThread::default/affinity",
+                    ui->lineEditStreamerAffinity->text().trimmed());
+  settings.setValue("StreamerThread::default/fifo_priority", ui->spinBoxStreamerFifo->value());
+  settings.setValue("StreamerThread::default/busy_poll",
+                    ui->checkBoxStreamerBusyPoll->isChecked());
   settings.setValue("Preferences::export_plot_size",
                     QSize{ ui->spinBoxExportX->value(), ui->spinBoxExportY->value() });
   settings.setValue("Preferences::swap_pan_zoom", ui->checkBoxSwapPanZoom->isChecked());
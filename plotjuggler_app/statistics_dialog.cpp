@@ -8,6 +8,7 @@
 #include "ui_statistics_dialog.h"
 #include <QTableWidgetItem>
 #include <cmath>
+#include <limits>
 #include "qwt_text.h"
 
 StatisticsDialog::StatisticsDialog(PlotWidget* parent)
@@ -36,6 +37,32 @@ bool StatisticsDialog::calcVisibleRange()
   return (ui->rangeComboBox->currentIndex() == 0);
 }
 
+namespace
+{
+// adapt QwtSeriesData to the Series concept used by SummaryIndex
+struct SeriesAdapter
+{
+  const QwtSeriesData<QPointF>* data;
+
+  struct Point
+  {
+    double x;
+    double y;
+  };
+
+  Point operator[](size_t i) const
+  {
+    const auto p = data->sample(i);
+    return { p.x(), p.y() };
+  }
+
+  size_t size() const
+  {
+    return data->size();
+  }
+};
+}  // namespace
+
 void StatisticsDialog::update(PJ::Range range)
 {
   std::map<QString, Statistics> statistics;
@@ -43,53 +70,63 @@ void StatisticsDialog::update(PJ::Range range)
   for (const auto& info : _parent->curveList())
   {
     Statistics stat;
-    double start_time;
-    double end_time;
-    const auto ts = info.curve->data();
-
-    bool first = true;
-
-    for (size_t i = 0; i < ts->size(); i++)
-    {
-      const auto p = ts->sample(i);
-      if (calcVisibleRange())
+    const SeriesAdapter series{ info.curve->data() };
+    const QString title = info.curve->title().text();
+    const size_t N = series.size();
+
+    auto& index = _indexes[title];
+    index.update(series);
+
+    // first index with x >= value (samples are sorted by time)
+    auto lowerBoundX = [&series, N](double value) {
+      size_t lo = 0;
+      size_t hi = N;
+      while (lo < hi)
       {
-        if (p.x() < range.min)
+        const size_t mid = (lo + hi) / 2;
+        if (series[mid].x < value)
         {
-          continue;
+          lo = mid + 1;
         }
-        if (p.x() > range.max)
+        else
         {
-          break;
+          hi = mid;
         }
       }
-      stat.count++;
-      if (first)
-      {
-        start_time = p.x();
-        end_time = p.x();
-        stat.min = p.y();
-        stat.max = p.y();
-        first = false;
-      }
-      else
-      {
-        start_time = std::min(start_time, p.x());
-        end_time = std::max(end_time, p.x());
-        stat.min = std::min(stat.min, p.y());
-        stat.max = std::max(stat.max, p.y());
-      }
-      stat.mean_tot += p.y();
-      stat.square_tot += p.y() * p.y();
-      stat.abs_tot += std::fabs(p.y());
+      return lo;
+    };
+
+    size_t first_index = 0;
+    size_t last_excl = N;
+    if (calcVisibleRange())
+    {
+      first_index = lowerBoundX(range.min);
+      last_excl = lowerBoundX(std::nextafter(range.max, std::numeric_limits<double>::max()));
     }
 
-    if (stat.count > 0)
+    if (first_index < last_excl)
     {
-      stat.mean_interval = (end_time - start_time) / double(stat.count - 1);
+      const auto summary = index.rangeSummary(series, first_index, last_excl - 1);
+      stat.count = summary.count;
+      stat.min = summary.min;
+      stat.max = summary.max;
+      stat.mean_tot = summary.sum;
+      stat.square_tot = summary.sum_sq;
+      stat.abs_tot = summary.sum_abs;
+      if (stat.count > 0)
+      {
+        stat.mean_interval =
+            (series[last_excl - 1].x - series[first_index].x) / double(stat.count - 1);
+      }
     }
 
-    statistics[info.curve->title().text()] = stat;
+    statistics[title] = stat;
+  }
+
+  // drop the indexes of curves no longer displayed
+  for (auto it = _indexes.begin(); it != _indexes.end();)
+  {
+    it = (statistics.count(it->first) == 0) ? _indexes.erase(it) : std::next(it);
   }
 
   ui->tableWidget->setRowCount(statistics.size());
@@ -9,7 +9,9 @@
 
 #include <QDialog>
 #include <QCloseEvent>
+#include <map>
 #include "PlotJuggler/plotdata.h"
+#include "PlotJuggler/util/summary_index.hpp"
 #include "plotwidget.h"
 
 namespace Ui
@@ -48,6 +50,9 @@ private:
   Ui::statistics_dialog* ui;
 
   PlotWidget* _parent;
+
+  // one summary index per displayed curve, kept across refresh ticks
+  std::map<QString, PJ::SummaryIndex> _indexes;
 };
 
 #endif  // STATISTICS_DIALOG_H
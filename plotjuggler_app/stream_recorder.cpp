@@ -0,0 +1,257 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "stream_recorder.h"
+
+#define MCAP_IMPLEMENTATION
+#include <mcap/writer.hpp>
+
+#include <cinttypes>
+#include <cstdio>
+
+namespace
+{
+/// log/publish time of a sample: MCAP timestamps are unsigned nanoseconds,
+/// streams with a relative time axis can legitimately sit at or below zero.
+/// The exact timestamp is always in the payload.
+mcap::Timestamp ToTimestamp(double x)
+{
+  return (x <= 0.0) ? 0 : mcap::Timestamp(x * 1e9);
+}
+
+void AppendEscapedJson(std::string& out, const std::string& text)
+{
+  for (const char c : text)
+  {
+    switch (c)
+    {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char buffer[8];
+          snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          out += buffer;
+        }
+        else
+        {
+          out += c;
+        }
+    }
+  }
+}
+}  // namespace
+
+StreamRecorder::~StreamRecorder()
+{
+  stop();
+}
+
+bool StreamRecorder::start(const QString& filepath, QString* error_message)
+{
+  stop();
+
+  auto writer = std::make_unique<mcap::McapWriter>();
+  mcap::McapWriterOptions options("");
+  options.compression = mcap::Compression::Zstd;
+
+  const auto status = writer->open(filepath.toStdString(), options);
+  if (!status.ok())
+  {
+    if (error_message)
+    {
+      *error_message = QString::fromStdString(status.message);
+    }
+    return false;
+  }
+
+  _file_path = filepath;
+  _series_ids.clear();
+  _dropped_batches.store(0, std::memory_order_relaxed);
+  _stop_requested = false;
+  _recording.store(true, std::memory_order_release);
+  _writer_thread = std::thread(&StreamRecorder::writerLoop, this, std::move(writer));
+  return true;
+}
+
+void StreamRecorder::stop()
+{
+  if (!_writer_thread.joinable())
+  {
+    return;
+  }
+  _recording.store(false, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(_queue_mutex);
+    _stop_requested = true;
+  }
+  _queue_cv.notify_one();
+  _writer_thread.join();
+}
+
+uint32_t StreamRecorder::seriesId(const std::string& name, Batch& batch)
+{
+  auto it = _series_ids.find(name);
+  if (it != _series_ids.end())
+  {
+    return it->second;
+  }
+  const uint32_t id = static_cast<uint32_t>(_series_ids.size());
+  _series_ids.emplace(name, id);
+  batch.new_series.emplace_back(id, name);
+  return id;
+}
+
+void StreamRecorder::recordBatch(const PJ::PlotDataMapRef& fresh_data)
+{
+  if (!isRecording())
+  {
+    return;
+  }
+
+  Batch batch;
+
+  for (const auto& [name, series] : fresh_data.numeric)
+  {
+    if (series.size() == 0)
+    {
+      continue;
+    }
+    SeriesBatch series_batch;
+    series_batch.series_id = seriesId(name, batch);
+    series_batch.numeric_points.reserve(series.size());
+    for (size_t i = 0; i < series.size(); i++)
+    {
+      const auto& point = series.at(i);
+      series_batch.numeric_points.emplace_back(point.x, point.y);
+    }
+    batch.series.push_back(std::move(series_batch));
+  }
+
+  for (const auto& [name, series] : fresh_data.strings)
+  {
+    if (series.size() == 0)
+    {
+      continue;
+    }
+    SeriesBatch series_batch;
+    series_batch.series_id = seriesId(name, batch);
+    series_batch.string_points.reserve(series.size());
+    for (size_t i = 0; i < series.size(); i++)
+    {
+      const auto& point = series.at(i);
+      const auto text = series.getString(point.y);
+      series_batch.string_points.emplace_back(point.x, std::string(text));
+    }
+    batch.series.push_back(std::move(series_batch));
+  }
+
+  if (batch.series.empty())
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_queue_mutex);
+    if (_queue.size() >= MAX_QUEUED_BATCHES)
+    {
+      // never stall the GUI thread: losing a cycle is better than
+      // backpressure on ingest. The channel registrations must survive,
+      // or every later batch of a new series would be orphaned.
+      _dropped_batches.fetch_add(1, std::memory_order_relaxed);
+      if (!batch.new_series.empty())
+      {
+        Batch registrations;
+        registrations.new_series = std::move(batch.new_series);
+        _queue.push_back(std::move(registrations));
+      }
+      return;
+    }
+    _queue.push_back(std::move(batch));
+  }
+  _queue_cv.notify_one();
+}
+
+void StreamRecorder::writerLoop(std::unique_ptr<mcap::McapWriter> writer)
+{
+  mcap::Schema schema("plotjuggler_sample", "jsonschema",
+                      R"({"type":"object","properties":)"
+                      R"({"t":{"type":"number"},"v":{}}})");
+  writer->addSchema(schema);
+
+  // series id (ours) -> channel id (the writer's)
+  std::unordered_map<uint32_t, mcap::ChannelId> channels;
+  std::unordered_map<uint32_t, uint32_t> sequences;
+  std::string payload;
+
+  auto writeSample = [&](uint32_t series_id, double x) {
+    mcap::Message message;
+    message.channelId = channels.at(series_id);
+    message.sequence = sequences[series_id]++;
+    message.logTime = ToTimestamp(x);
+    message.publishTime = message.logTime;
+    message.data = reinterpret_cast<const std::byte*>(payload.data());
+    message.dataSize = payload.size();
+    writer->write(message);
+  };
+
+  while (true)
+  {
+    Batch batch;
+    {
+      std::unique_lock<std::mutex> lock(_queue_mutex);
+      _queue_cv.wait(lock, [this]() { return !_queue.empty() || _stop_requested; });
+      if (_queue.empty())
+      {
+        break;  // stop requested and fully drained
+      }
+      batch = std::move(_queue.front());
+      _queue.pop_front();
+    }
+
+    for (const auto& [series_id, name] : batch.new_series)
+    {
+      mcap::Channel channel(name, "json", schema.id);
+      writer->addChannel(channel);
+      channels.emplace(series_id, channel.id);
+    }
+
+    char number[64];
+    for (const auto& series_batch : batch.series)
+    {
+      for (const auto& [x, y] : series_batch.numeric_points)
+      {
+        snprintf(number, sizeof(number), R"({"t":%.17g,"v":%.17g})", x, y);
+        payload = number;
+        writeSample(series_batch.series_id, x);
+      }
+      for (const auto& [x, text] : series_batch.string_points)
+      {
+        snprintf(number, sizeof(number), R"({"t":%.17g,"v":")", x);
+        payload = number;
+        AppendEscapedJson(payload, text);
+        payload += "\"}";
+        writeSample(series_batch.series_id, x);
+      }
+    }
+  }
+
+  writer->close();
+}
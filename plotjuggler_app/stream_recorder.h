@@ -0,0 +1,120 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef STREAM_RECORDER_H
+#define STREAM_RECORDER_H
+
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "PlotJuggler/plotdata.h"
+
+namespace mcap
+{
+class McapWriter;
+}
+
+/**
+ * @brief Records the samples of a live stream into an MCAP file, so that a
+ * session can be captured after the fact, while it is already running.
+ *
+ * The recorder taps the streaming pipeline where the fresh samples of each
+ * merge cycle are staged, before the time-window trim and the memory budget
+ * can drop anything: the file gets the full-rate data even when the plot
+ * buffer keeps only a short window. The GUI thread only copies the batch
+ * into a bounded queue; encoding, chunking and zstd compression run on a
+ * background thread. When the writer cannot keep up the queue drops whole
+ * batches (counted in droppedBatches()) instead of stalling ingest.
+ *
+ * Each series becomes one channel with json-encoded messages
+ * `{"t": <timestamp>, "v": <value>}`, readable back through the MCAP
+ * loader and any third-party MCAP tooling.
+ */
+class StreamRecorder
+{
+public:
+  StreamRecorder() = default;
+  ~StreamRecorder();
+
+  StreamRecorder(const StreamRecorder&) = delete;
+  StreamRecorder& operator=(const StreamRecorder&) = delete;
+
+  /// Open the file and start the writer thread. On failure returns false
+  /// and explains why in `error_message`.
+  bool start(const QString& filepath, QString* error_message = nullptr);
+
+  /// Drain the queue, finalize the file and join the writer thread.
+  /// Harmless when not recording.
+  void stop();
+
+  bool isRecording() const
+  {
+    return _recording.load(std::memory_order_acquire);
+  }
+
+  QString filePath() const
+  {
+    return _file_path;
+  }
+
+  /// GUI thread, once per streaming merge cycle: copies the numeric and
+  /// string samples staged in `fresh_data` into the writer queue.
+  void recordBatch(const PJ::PlotDataMapRef& fresh_data);
+
+  /// Batches discarded because the writer thread could not keep up.
+  size_t droppedBatches() const
+  {
+    return _dropped_batches.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct SeriesBatch
+  {
+    uint32_t series_id;
+    std::vector<std::pair<double, double>> numeric_points;
+    std::vector<std::pair<double, std::string>> string_points;
+  };
+
+  struct Batch
+  {
+    /// Series seen for the first time: the writer thread creates their
+    /// channel before writing the samples.
+    std::vector<std::pair<uint32_t, std::string>> new_series;
+    std::vector<SeriesBatch> series;
+  };
+
+  uint32_t seriesId(const std::string& name, Batch& batch);
+
+  void writerLoop(std::unique_ptr<mcap::McapWriter> writer);
+
+  /// Keep at most this many merge cycles in flight before dropping.
+  static constexpr size_t MAX_QUEUED_BATCHES = 256;
+
+  QString _file_path;
+  std::atomic<bool> _recording{ false };
+  std::atomic<size_t> _dropped_batches{ 0 };
+
+  /// GUI thread only.
+  std::unordered_map<std::string, uint32_t> _series_ids;
+
+  std::mutex _queue_mutex;
+  std::condition_variable _queue_cv;
+  std::deque<Batch> _queue;
+  bool _stop_requested = false;
+
+  std::thread _writer_thread;
+};
+
+#endif  // STREAM_RECORDER_H
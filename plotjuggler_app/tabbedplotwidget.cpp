@@ -17,12 +17,14 @@
 #include <QTabWidget>
 #include <QPushButton>
 #include <QHBoxLayout>
+#include <QtConcurrent/QtConcurrent>
 #include <algorithm>
 #include "qwt_plot_renderer.h"
 #include "mainwindow.h"
 #include "tabbedplotwidget.h"
 #include "tab_widget.h"
 #include "PlotJuggler/svg_util.h"
+#include "PlotJuggler/util/render_governor.hpp"
 
 std::map<QString, TabbedPlotWidget*> TabbedPlotWidget::_instances;
 
@@ -68,6 +70,12 @@ TabbedPlotWidget::TabbedPlotWidget(QString name, QMainWindow* mainwindow,
           &TabbedPlotWidget::on_tabWidget_currentChanged);
 
   tabWidget()->tabBar()->installEventFilter(this);
+  // hover events are needed to pre-warm tabs before they are clicked
+  tabWidget()->tabBar()->setMouseTracking(true);
+
+  _prewarm_timer.setSingleShot(true);
+  _prewarm_timer.setInterval(150);
+  connect(&_prewarm_timer, &QTimer::timeout, this, &TabbedPlotWidget::prewarmHoveredTab);
 
   _action_savePlots = new QAction(tr("&Save plots to file"), this);
   connect(_action_savePlots, &QAction::triggered, this, &TabbedPlotWidget::on_savePlotsToFile);
@@ -188,7 +196,19 @@ QDomElement TabbedPlotWidget::xmlSaveState(QDomDocument& doc) const
   for (int i = 0; i < tabWidget()->count(); i++)
   {
     PlotDocker* widget = static_cast<PlotDocker*>(tabWidget()->widget(i));
-    QDomElement element = widget->xmlSaveState(doc);
+    QDomElement element;
+
+    auto deferred = _deferred_tabs.find(widget);
+    if (deferred != _deferred_tabs.end())
+    {
+      // a tab never activated since the last load still matches the
+      // serialized state it was loaded from
+      element = doc.importNode(deferred->second, true).toElement();
+    }
+    else
+    {
+      element = widget->xmlSaveState(doc);
+    }
 
     element.setAttribute("tab_name", tabWidget()->tabText(i));
     tabbed_area.appendChild(element);
@@ -205,18 +225,20 @@ bool TabbedPlotWidget::xmlLoadState(QDomElement& tabbed_area)
 {
   int prev_count = tabWidget()->count();
 
+  _deferred_tabs.clear();
+  _deferred_doc = QDomDocument();
+
+  std::vector<std::pair<PlotDocker*, QDomElement>> new_tabs;
+
   for (auto docker_elem = tabbed_area.firstChildElement("Tab"); !docker_elem.isNull();
        docker_elem = docker_elem.nextSiblingElement("Tab"))
   {
     QString tab_name = docker_elem.attribute("tab_name");
     PlotDocker* docker = addTab(tab_name);
 
-    bool success = docker->xmlLoadState(docker_elem);
-
-    if (!success)
-    {
-      return false;
-    }
+    // keep a copy of the state: the caller's document will not outlive
+    // a deferred restore
+    new_tabs.push_back({ docker, _deferred_doc.importNode(docker_elem, true).toElement() });
   }
 
   // remove old ones
@@ -234,10 +256,41 @@ bool TabbedPlotWidget::xmlLoadState(QDomElement& tabbed_area)
     tabWidget()->setCurrentIndex(current_index);
   }
 
+  // restore only the visible tab now, so that it becomes interactive as soon
+  // as possible; the other ones are built on first activation
+  for (auto& [docker, docker_elem] : new_tabs)
+  {
+    if (docker == tabWidget()->currentWidget())
+    {
+      if (!docker->xmlLoadState(docker_elem))
+      {
+        return false;
+      }
+    }
+    else
+    {
+      _deferred_tabs[docker] = docker_elem;
+      connect(docker, &QObject::destroyed, this,
+              [this, docker]() { _deferred_tabs.erase(docker); });
+    }
+  }
+
   emit undoableChange();
   return true;
 }
 
+void TabbedPlotWidget::restoreDeferredTab(PlotDocker* docker)
+{
+  auto it = _deferred_tabs.find(docker);
+  if (it == _deferred_tabs.end())
+  {
+    return;
+  }
+  QDomElement state = it->second;
+  _deferred_tabs.erase(it);
+  docker->xmlLoadState(state);
+}
+
 void TabbedPlotWidget::setStreamingMode(bool streaming_mode)
 {
 }
@@ -293,6 +346,16 @@ void TabbedPlotWidget::on_tabWidget_currentChanged(int index)
   PlotDocker* tab = dynamic_cast<PlotDocker*>(tabWidget()->widget(index));
   if (tab)
   {
+    restoreDeferredTab(tab);
+    // widgets skipped while this tab was hidden catch up before painting
+    for (int i = 0; i < tab->plotCount(); i++)
+    {
+      PlotWidget* plot = tab->plotAt(i);
+      if (plot && plot->curvesUpdateDeferred())
+      {
+        plot->updateCurves(false);
+      }
+    }
     tab->replot();
   }
   for (int i = 0; i < tabWidget()->count(); i++)
@@ -412,12 +475,90 @@ bool TabbedPlotWidget::eventFilter(QObject* obj, QEvent* event)
         //        submenu->deleteLater();
       }
     }
+    else if (event->type() == QEvent::MouseMove)
+    {
+      QMouseEvent* mouse_event = static_cast<QMouseEvent*>(event);
+      const int index = tab_bar->tabAt(mouse_event->pos());
+      if (index != _hovered_tab_index)
+      {
+        _hovered_tab_index = index;
+        if (index >= 0 && index != tab_bar->currentIndex())
+        {
+          // restart the debounce every time the cursor moves to a new tab
+          _prewarm_timer.start();
+        }
+        else
+        {
+          _prewarm_timer.stop();
+        }
+      }
+    }
+    else if (event->type() == QEvent::Leave)
+    {
+      _hovered_tab_index = -1;
+      _prewarm_timer.stop();
+    }
   }
 
   // Standard event processing
   return QObject::eventFilter(obj, event);
 }
 
+void TabbedPlotWidget::prewarmHoveredTab()
+{
+  const int index = _hovered_tab_index;
+  if (index < 0 || index == tabWidget()->currentIndex())
+  {
+    return;
+  }
+  // purely speculative: when the streaming frames are already over their
+  // render budget, warming a tab the user may never open only makes the
+  // visible one stutter more
+  if (!PJ::RenderGovernor::instance().hasHeadroom())
+  {
+    return;
+  }
+  PlotDocker* tab = dynamic_cast<PlotDocker*>(tabWidget()->widget(index));
+  if (!tab)
+  {
+    return;
+  }
+
+  // same catch-up work that on_tabWidget_currentChanged() would do on the
+  // click, parallelized over the pool like the streaming update: by the
+  // time the user clicks, only the incremental part since this hover is
+  // left. Orchestrated from the GUI thread, so it can not race a
+  // concurrent streaming merge into the data map.
+  restoreDeferredTab(tab);
+
+  std::vector<PlotWidget*> deferred;
+  for (int i = 0; i < tab->plotCount(); i++)
+  {
+    PlotWidget* plot = tab->plotAt(i);
+    if (plot && plot->curvesUpdateDeferred())
+    {
+      deferred.push_back(plot);
+    }
+  }
+  if (deferred.empty())
+  {
+    return;
+  }
+  if (deferred.size() > 1)
+  {
+    QtConcurrent::blockingMap(deferred,
+                              [](PlotWidget* plot) { plot->prepareCurves(false); });
+  }
+  else
+  {
+    deferred.front()->prepareCurves(false);
+  }
+  for (auto* plot : deferred)
+  {
+    plot->finishUpdateCurves();
+  }
+}
+
 void TabbedPlotWidget::closeEvent(QCloseEvent* event)
 {
   TabbedPlotWidget::_instances.erase(name());
@@ -10,6 +10,7 @@
 #include <QWidget>
 #include <QMainWindow>
 #include <QTableWidget>
+#include <QTimer>
 #include <QDomDocument>
 #include "plot_docker.h"
 
@@ -37,6 +38,10 @@ public:
 
   bool xmlLoadState(QDomElement& tabbed_area);
 
+  /// Build the content of a tab whose restoration was deferred by
+  /// xmlLoadState(). No-op if the docker has no pending state.
+  void restoreDeferredTab(PlotDocker* docker);
+
   ~TabbedPlotWidget() override;
 
   QString name() const
@@ -80,6 +85,10 @@ private slots:
 
   void paintEvent(QPaintEvent* event) override;
 
+  /// Speculatively run the catch-up work of the hovered (but not yet
+  /// selected) tab, so that clicking it presents an already-warm tab.
+  void prewarmHoveredTab();
+
 private:
   QTabWidget* _tabWidget;
 
@@ -101,6 +110,16 @@ private:
 
   QString _parent_type;
 
+  // tabs that were not visible when xmlLoadState() was called keep their
+  // serialized state here and are built on first activation
+  QDomDocument _deferred_doc;
+  std::map<PlotDocker*, QDomElement> _deferred_tabs;
+
+  // debounces the hover events of the tab bar: the pre-warm runs only
+  // once the cursor has rested on the same tab handle for a moment
+  QTimer _prewarm_timer;
+  int _hovered_tab_index = -1;
+
   virtual void closeEvent(QCloseEvent* event) override;
 
   // void printPlotsNames();
@@ -0,0 +1,202 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "topic_filter_dialog.h"
+#include "ui_topic_filter_dialog.h"
+
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QSettings>
+
+TopicFilterDialog::TopicFilterDialog(const QStringList& topics, const QString& loader_name,
+                                     QWidget* parent)
+  : QDialog(parent), ui(new Ui::TopicFilterDialog), _loader_name(loader_name)
+{
+  ui->setupUi(this);
+
+  QSettings settings;
+  restoreGeometry(settings.value("TopicFilterDialog.geometry").toByteArray());
+
+  QStringList sorted_topics = topics;
+  sorted_topics.sort();
+
+  for (const QString& topic : sorted_topics)
+  {
+    auto* item = new QListWidgetItem(topic, ui->listWidgetTopics);
+    item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+    item->setCheckState(Qt::Checked);
+  }
+
+  // start from the selection of the previous load of this format, when
+  // it still matches the file. Empty means everything was checked.
+  const QStringList previous = settings.value(settingsKey("previous")).toStringList();
+  if (!previous.isEmpty())
+  {
+    setCheckedTopics(previous);
+  }
+
+  ui->comboBoxPresets->addItem("");
+  for (const QString& preset : settings.value(settingsKey("presets")).toStringList())
+  {
+    ui->comboBoxPresets->addItem(preset);
+  }
+
+  connect(ui->lineEditFilter, &QLineEdit::textChanged, this,
+          &TopicFilterDialog::onFilterTextChanged);
+  connect(ui->comboBoxPresets, qOverload<int>(&QComboBox::currentIndexChanged), this,
+          &TopicFilterDialog::onPresetSelected);
+  connect(ui->buttonSavePreset, &QPushButton::clicked, this, &TopicFilterDialog::onSavePreset);
+  connect(ui->buttonDeletePreset, &QPushButton::clicked, this, &TopicFilterDialog::onDeletePreset);
+  connect(ui->buttonSelectAll, &QPushButton::clicked, this, [this]() {
+    for (int row = 0; row < ui->listWidgetTopics->count(); row++)
+    {
+      auto* item = ui->listWidgetTopics->item(row);
+      if (!item->isHidden())
+      {
+        item->setCheckState(Qt::Checked);
+      }
+    }
+    updateCountLabel();
+  });
+  connect(ui->buttonDeselectAll, &QPushButton::clicked, this, [this]() {
+    for (int row = 0; row < ui->listWidgetTopics->count(); row++)
+    {
+      auto* item = ui->listWidgetTopics->item(row);
+      if (!item->isHidden())
+      {
+        item->setCheckState(Qt::Unchecked);
+      }
+    }
+    updateCountLabel();
+  });
+  connect(ui->listWidgetTopics, &QListWidget::itemChanged, this,
+          [this](QListWidgetItem*) { updateCountLabel(); });
+
+  updateCountLabel();
+}
+
+TopicFilterDialog::~TopicFilterDialog()
+{
+  delete ui;
+}
+
+QStringList TopicFilterDialog::selectedTopics() const
+{
+  return _selected;
+}
+
+void TopicFilterDialog::accept()
+{
+  const QStringList checked = checkedTopics();
+  const bool all_checked = (checked.size() == ui->listWidgetTopics->count());
+  // a full selection is no projection at all
+  _selected = all_checked ? QStringList() : checked;
+
+  QSettings settings;
+  settings.setValue("TopicFilterDialog.geometry", saveGeometry());
+  settings.setValue(settingsKey("previous"), _selected);
+
+  QDialog::accept();
+}
+
+void TopicFilterDialog::onFilterTextChanged(const QString& text)
+{
+  for (int row = 0; row < ui->listWidgetTopics->count(); row++)
+  {
+    auto* item = ui->listWidgetTopics->item(row);
+    item->setHidden(!item->text().contains(text, Qt::CaseInsensitive));
+  }
+}
+
+void TopicFilterDialog::onPresetSelected(int index)
+{
+  const QString preset = ui->comboBoxPresets->itemText(index);
+  if (preset.isEmpty())
+  {
+    return;
+  }
+  QSettings settings;
+  setCheckedTopics(settings.value(settingsKey("preset/" + preset)).toStringList());
+  updateCountLabel();
+}
+
+void TopicFilterDialog::onSavePreset()
+{
+  bool ok = false;
+  const QString name =
+      QInputDialog::getText(this, tr("Save preset"), tr("Name of the preset:"), QLineEdit::Normal,
+                            ui->comboBoxPresets->currentText(), &ok);
+  if (!ok || name.isEmpty())
+  {
+    return;
+  }
+
+  QSettings settings;
+  QStringList presets = settings.value(settingsKey("presets")).toStringList();
+  if (!presets.contains(name))
+  {
+    presets.push_back(name);
+    presets.sort();
+    settings.setValue(settingsKey("presets"), presets);
+    ui->comboBoxPresets->insertItem(presets.indexOf(name) + 1, name);
+  }
+  settings.setValue(settingsKey("preset/" + name), checkedTopics());
+  ui->comboBoxPresets->setCurrentText(name);
+}
+
+void TopicFilterDialog::onDeletePreset()
+{
+  const QString name = ui->comboBoxPresets->currentText();
+  if (name.isEmpty())
+  {
+    return;
+  }
+  if (QMessageBox::question(this, tr("Delete preset"),
+                            tr("Delete the preset [%1]?").arg(name)) != QMessageBox::Yes)
+  {
+    return;
+  }
+  QSettings settings;
+  QStringList presets = settings.value(settingsKey("presets")).toStringList();
+  presets.removeAll(name);
+  settings.setValue(settingsKey("presets"), presets);
+  settings.remove(settingsKey("preset/" + name));
+  ui->comboBoxPresets->removeItem(ui->comboBoxPresets->currentIndex());
+}
+
+void TopicFilterDialog::setCheckedTopics(const QStringList& topics)
+{
+  for (int row = 0; row < ui->listWidgetTopics->count(); row++)
+  {
+    auto* item = ui->listWidgetTopics->item(row);
+    item->setCheckState(topics.contains(item->text()) ? Qt::Checked : Qt::Unchecked);
+  }
+}
+
+QStringList TopicFilterDialog::checkedTopics() const
+{
+  QStringList checked;
+  for (int row = 0; row < ui->listWidgetTopics->count(); row++)
+  {
+    auto* item = ui->listWidgetTopics->item(row);
+    if (item->checkState() == Qt::Checked)
+    {
+      checked.push_back(item->text());
+    }
+  }
+  return checked;
+}
+
+void TopicFilterDialog::updateCountLabel()
+{
+  ui->labelCount->setText(
+      tr("%1 of %2 selected").arg(checkedTopics().size()).arg(ui->listWidgetTopics->count()));
+}
+
+QString TopicFilterDialog::settingsKey(const QString& suffix) const
+{
+  return QString("TopicFilterDialog.%1.%2").arg(_loader_name, suffix);
+}
@@ -0,0 +1,63 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TOPIC_FILTER_DIALOG_H
+#define TOPIC_FILTER_DIALOG_H
+
+#include <QDialog>
+#include <QStringList>
+
+namespace Ui
+{
+class TopicFilterDialog;
+}
+
+/**
+ * @brief Shared topic selection dialog, shown before a file load for any
+ * DataLoader that declares supportsTopicFilter(): the user projects the
+ * load down to the topics to plot, and the loader skips the rest at parse
+ * time. Selections can be saved as named presets, kept per loader in
+ * QSettings, so a recurring projection of the same kind of log is one
+ * click away.
+ */
+class TopicFilterDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  /// `loader_name` namespaces the saved presets and the remembered
+  /// selection, so that each file format keeps its own.
+  TopicFilterDialog(const QStringList& topics, const QString& loader_name,
+                    QWidget* parent = nullptr);
+
+  ~TopicFilterDialog() override;
+
+  /// The checked topics, or an empty list when all of them are checked:
+  /// a full selection means "no projection", so that the same saved
+  /// FileLoadInfo also loads files that contain additional topics.
+  QStringList selectedTopics() const;
+
+  virtual void accept() override;
+
+private slots:
+  void onFilterTextChanged(const QString& text);
+  void onPresetSelected(int index);
+  void onSavePreset();
+  void onDeletePreset();
+
+private:
+  void setCheckedTopics(const QStringList& topics);
+  QStringList checkedTopics() const;
+  void updateCountLabel();
+
+  QString settingsKey(const QString& suffix) const;
+
+  Ui::TopicFilterDialog* ui;
+  QString _loader_name;
+  QStringList _selected;
+};
+
+#endif  // TOPIC_FILTER_DIALOG_H
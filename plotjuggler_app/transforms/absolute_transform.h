@@ -1,6 +1,7 @@
 #ifndef ABSOLUTE_TRANSFORM_H
 #define ABSOLUTE_TRANSFORM_H
 
+#include <cmath>
 #include "PlotJuggler/transform_function.h"
 
 using namespace PJ;
@@ -24,6 +25,11 @@ public:
 
 private:
   std::optional<PlotData::Point> calculateNextPoint(size_t index) override;
+
+  PointwiseFunc pointwiseOperation() const override
+  {
+    return [](double y) { return std::abs(y); };
+  }
 };
 
 #endif  // ABSOLUTE_TRANSFORM_H
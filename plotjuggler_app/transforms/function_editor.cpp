@@ -98,14 +98,6 @@ FunctionEditorWidget::FunctionEditorWidget(PlotDataMapRef& plotMapData,
   palette.setBrush(QPalette::HighlightedText, palette.brush(QPalette::Text));
   ui->listAdditionalSources->setPalette(palette);
 
-  QStringList numericPlotNames;
-  for (const auto& p : _plot_map_data.numeric)
-  {
-    QString name = QString::fromStdString(p.first);
-    numericPlotNames.push_back(name);
-  }
-  numericPlotNames.sort(Qt::CaseInsensitive);
-
   QByteArray saved_xml =
       settings.value("FunctionEditorWidget.recentSnippetsXML", QByteArray()).toByteArray();
   restoreGeometry(settings.value("FunctionEditorWidget.geometry").toByteArray());
@@ -141,8 +133,19 @@ FunctionEditorWidget::FunctionEditorWidget(PlotDataMapRef& plotMapData,
   ui->listAdditionalSources->installEventFilter(this);
   ui->lineEditTab2Filter->installEventFilter(this);
 
-  auto preview_layout = new QHBoxLayout(ui->framePlotPreview);
+  auto preview_layout = new QVBoxLayout(ui->framePlotPreview);
   preview_layout->setMargin(6);
+
+  _preview_banner = new QLabel(this);
+  _preview_banner->setVisible(false);
+  _preview_banner->setWordWrap(true);
+  connect(_preview_banner, &QLabel::linkActivated, this, [this](const QString&) {
+    // one-shot: the next edit pause goes back to the fast subsample
+    _preview_full_eval = true;
+    onUpdatePreview();
+  });
+
+  preview_layout->addWidget(_preview_banner);
   preview_layout->addWidget(_preview_widget);
 
   _preview_widget->setContextMenuEnabled(false);
@@ -762,6 +765,73 @@ void FunctionEditorWidget::setSemaphore(QLabel* semaphore, QString errors)
   semaphore->setPixmap(QPixmap::fromImage(image));
 }
 
+PlotDataMapRef* FunctionEditorWidget::prepareSubsampledInput(const SnippetData& snippet,
+                                                             size_t& total_points,
+                                                             size_t& sampled_points)
+{
+  // a preview does not need more resolution than the widget can show
+  constexpr size_t PREVIEW_MAX_POINTS = 4000;
+
+  std::vector<std::string> required;
+  required.push_back(snippet.linked_source.toStdString());
+  for (const auto& extra : snippet.additional_sources)
+  {
+    required.push_back(extra.toStdString());
+  }
+
+  bool any_too_big = false;
+  for (const auto& name : required)
+  {
+    auto it = _plot_map_data.numeric.find(name);
+    if (it != _plot_map_data.numeric.end())
+    {
+      total_points += it->second.size();
+      any_too_big |= (it->second.size() > PREVIEW_MAX_POINTS);
+    }
+  }
+  if (!any_too_big)
+  {
+    return &_plot_map_data;
+  }
+
+  // calculate() looks all the sources up in a single map: mirror every
+  // required one into _preview_samples, striding over the big ones.
+  // Sources missing from the data are left out, so that the usual
+  // "invalid source" errors are still reported.
+  for (const auto& name : required)
+  {
+    auto it = _plot_map_data.numeric.find(name);
+    if (it == _plot_map_data.numeric.end())
+    {
+      continue;
+    }
+    const PlotData& source = it->second;
+    PlotData& mirror = _preview_samples.getOrCreateNumeric(name);
+
+    auto cached_size = _preview_sampled_sizes.find(name);
+    if (cached_size == _preview_sampled_sizes.end() || cached_size->second != source.size())
+    {
+      mirror.clear();
+      if (source.size() > 0)
+      {
+        const size_t stride = std::max<size_t>(1, source.size() / PREVIEW_MAX_POINTS);
+        for (size_t i = 0; i < source.size(); i += stride)
+        {
+          mirror.pushBack(source.at(i));
+        }
+        if (mirror.back().x < source.back().x)
+        {
+          // keep the real end of the time range
+          mirror.pushBack(source.back());
+        }
+      }
+      _preview_sampled_sizes[name] = source.size();
+    }
+    sampled_points += mirror.size();
+  }
+  return &_preview_samples;
+}
+
 void FunctionEditorWidget::onUpdatePreview()
 {
   QString errors;
@@ -827,10 +897,32 @@ void FunctionEditorWidget::onUpdatePreview()
       PlotData& out_data = _local_plot_data.getOrCreateNumeric(name);
       out_data.clear();
 
+      size_t total_points = 0;
+      size_t sampled_points = 0;
+      PlotDataMapRef* input_data = &_plot_map_data;
+      if (!_preview_full_eval)
+      {
+        input_data = prepareSubsampledInput(snippet, total_points, sampled_points);
+      }
+      _preview_full_eval = false;
+
       std::vector<PlotData*> out_vector = { &out_data };
-      lua_function->setData(&_plot_map_data, {}, out_vector);
+      lua_function->setData(input_data, {}, out_vector);
       lua_function->calculate();
 
+      if (input_data == &_preview_samples)
+      {
+        _preview_banner->setText(tr("Preview evaluated on %L1 of %L2 points — "
+                                    "<a href=\"full\">evaluate the full data once</a>")
+                                     .arg(sampled_points)
+                                     .arg(total_points));
+        _preview_banner->setVisible(true);
+      }
+      else
+      {
+        _preview_banner->setVisible(false);
+      }
+
       _preview_widget->removeAllCurves();
       _preview_widget->addCurve(name, Qt::blue);
       _preview_widget->zoomOut(false);
@@ -884,35 +976,57 @@ void FunctionEditorWidget::on_pushButtonHelp_clicked()
   dialog->exec();
 }
 
+// the pattern can only match names that start with its leading literal
+// characters; return them so the scan can be narrowed to that prefix
+static QString LiteralPrefix(const QString& pattern, bool wildcard)
+{
+  static const QString regexp_specials = "\\^$.[]|()*+?{}";
+  static const QString wildcard_specials = "*?[";
+  const QString& specials = wildcard ? wildcard_specials : regexp_specials;
+
+  QString prefix;
+  for (const auto& c : pattern)
+  {
+    if (specials.contains(c))
+    {
+      break;
+    }
+    prefix += c;
+  }
+  return prefix;
+}
+
 void FunctionEditorWidget::onLineEditTab2FilterChanged()
 {
   QString filter_text = ui->lineEditTab2Filter->text();
-  ui->listBatchSources->clear();
+  const QStringList& sorted_names = _name_index.refresh(_plot_map_data);
+
+  QStringList matches;
 
   if (ui->radioButtonRegExp->isChecked() || ui->radioButtonWildcard->isChecked())
   {
+    const bool wildcard = ui->radioButtonWildcard->isChecked();
     QRegExp rx(filter_text);
-    if (ui->radioButtonWildcard->isChecked())
+    if (wildcard)
     {
       rx.setPatternSyntax(QRegExp::Wildcard);
     }
 
-    for (const auto& [name, plotdata] : _plot_map_data.numeric)
+    const auto range = _name_index.prefixRange(LiteralPrefix(filter_text, wildcard));
+    for (int i = range.first; i < range.second; i++)
     {
-      auto qname = QString::fromStdString(name);
-      if (rx.exactMatch(qname))
+      if (rx.exactMatch(sorted_names[i]))
       {
-        ui->listBatchSources->addItem(qname);
+        matches.push_back(sorted_names[i]);
       }
     }
   }
   else
   {
     QStringList spaced_items = filter_text.split(' ', PJ::SkipEmptyParts);
-    for (const auto& [name, plotdata] : _plot_map_data.numeric)
+    for (const auto& qname : sorted_names)
     {
       bool show = true;
-      auto qname = QString::fromStdString(name);
       for (const auto& part : spaced_items)
       {
         if (qname.contains(part) == false)
@@ -923,11 +1037,17 @@ void FunctionEditorWidget::onLineEditTab2FilterChanged()
       }
       if (show)
       {
-        ui->listBatchSources->addItem(qname);
+        matches.push_back(qname);
       }
     }
   }
-  ui->listBatchSources->sortItems();
+
+  ui->listBatchSources->setUpdatesEnabled(false);
+  ui->listBatchSources->clear();
+  // the index is sorted already; adding in one batch skips the
+  // per-item relayout and the final sortItems()
+  ui->listBatchSources->addItems(matches);
+  ui->listBatchSources->setUpdatesEnabled(true);
   onUpdatePreviewBatch();
 }
 
@@ -10,6 +10,7 @@
 #include "qwt_plot_curve.h"
 #include "ui_function_editor.h"
 #include "plotwidget.h"
+#include "tree_completer.h"
 #include "PlotJuggler/util/delayed_callback.hpp"
 
 #include "QLuaCompleter"
@@ -113,6 +114,9 @@ private:
 
   void updatePreview();
 
+  PlotDataMapRef* prepareSubsampledInput(const SnippetData& snippet, size_t& total_points,
+                                         size_t& sampled_points);
+
   //  QTimer _update_preview_timer;
 
   PlotDataMapRef& _plot_map_data;
@@ -128,6 +132,13 @@ private:
   PlotDataMapRef _local_plot_data;
   PlotWidget* _preview_widget;
 
+  // subsampled mirror of the preview inputs, so that editing a formula
+  // against huge series stays interactive (see prepareSubsampledInput)
+  PlotDataMapRef _preview_samples;
+  std::unordered_map<std::string, size_t> _preview_sampled_sizes;
+  QLabel* _preview_banner;
+  bool _preview_full_eval = false;
+
   EditorMode _editor_mode;
 
   QLuaCompleter* lua_completer_;
@@ -135,6 +146,8 @@ private:
 
   DelayedCallback _tab2_filter;
 
+  SeriesNameIndex _name_index;
+
   DelayedCallback _update_preview_tab1;
   DelayedCallback _update_preview_tab2;
 
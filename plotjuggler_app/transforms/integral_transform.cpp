@@ -1,9 +1,16 @@
 #include "integral_transform.h"
 #include <QFormLayout>
 #include <QDoubleValidator>
+#include <cmath>
+#include <limits>
 
 IntegralTransform::IntegralTransform()
-  : _widget(new QWidget()), ui(new Ui::IntegralTransform), _dT(0.0)
+  : _widget(new QWidget())
+  , ui(new Ui::IntegralTransform)
+  , _dT(0.0)
+  , _accumulated_value(0.0)
+  , _last_x_produced(std::numeric_limits<double>::lowest())
+  , _prefix_dt(0.0)
 {
   ui->setupUi(_widget);
   ui->lineEditCustom->setValidator(new QDoubleValidator(0.0001, 1000, 4));
@@ -41,25 +48,110 @@ IntegralTransform::~IntegralTransform()
 
 std::optional<PlotData::Point> IntegralTransform::calculateNextPoint(size_t index)
 {
-  if (index == 0)
+  std::optional<PlotData::Point> out;
+
+  if (index > 0)
   {
-    return {};
+    const auto& prev = dataSource()->at(index - 1);
+    const auto& p = dataSource()->at(index);
+
+    double dt = (_dT == 0.0) ? (p.x - prev.x) : _dT;
+
+    // calculate() revisits the last processed sample when it resumes
+    // during streaming: skip it, or its trapezoid would be accumulated
+    // again on every cycle
+    if (dt > 0 && p.x > _last_x_produced)
+    {
+      _accumulated_value += (p.y + prev.y) * dt / (2.0);
+      _last_x_produced = p.x;
+      out = PlotData::Point{ p.x, _accumulated_value };
+    }
   }
 
-  const auto& prev = dataSource()->at(index - 1);
-  const auto& p = dataSource()->at(index);
+  appendToCache(index, out);
+  return out;
+}
 
-  double dt = (_dT == 0.0) ? (p.x - prev.x) : _dT;
+void IntegralTransform::appendToCache(size_t index, const std::optional<PlotData::Point>& out)
+{
+  if (index < _integral_prefix.size())
+  {
+    // revisited sample, already cached
+    return;
+  }
+  if (index > _integral_prefix.size())
+  {
+    // samples were skipped: the cache no longer mirrors the source
+    invalidateCache();
+    return;
+  }
+  _integral_prefix.push_back(out ? out->y : std::numeric_limits<double>::quiet_NaN());
+  _last_cached_sample = dataSource()->at(index);
+  if (index % BLOCK_SIZE == 0)
+  {
+    _block_fingerprint.push_back(_last_cached_sample);
+  }
+  _prefix_dt = _dT;
+}
 
-  if (dt <= 0)
+void IntegralTransform::invalidateCache()
+{
+  _integral_prefix.clear();
+  _block_fingerprint.clear();
+}
+
+bool IntegralTransform::validateCachedPrefix() const
+{
+  const PlotData* src_data = dataSource();
+  if (!src_data || _integral_prefix.empty() || _prefix_dt != _dT ||
+      src_data->size() < _integral_prefix.size())
   {
-    return {};
+    return false;
   }
+  // spot-check one sample per block plus the last cached one: enough to
+  // catch trims, replacements and edits without re-reading everything
+  for (size_t block = 0; block < _block_fingerprint.size(); block++)
+  {
+    const auto& cached = _block_fingerprint[block];
+    const auto& actual = src_data->at(block * BLOCK_SIZE);
+    if (cached.x != actual.x || cached.y != actual.y)
+    {
+      return false;
+    }
+  }
+  const auto& actual_last = src_data->at(_integral_prefix.size() - 1);
+  return _last_cached_sample.x == actual_last.x && _last_cached_sample.y == actual_last.y;
+}
 
-  double val = (p.y + prev.y) * dt / (2.0);
-  _accumulated_value += val;
-  PlotData::Point out = { p.x, _accumulated_value };
-  return out;
+void IntegralTransform::calculate()
+{
+  PlotData* dst_data = _dst_vector.empty() ? nullptr : _dst_vector.front();
+
+  if (dst_data && dst_data->size() == 0 && !_integral_prefix.empty())
+  {
+    if (validateCachedPrefix())
+    {
+      // rebuild the output from the cached values; only the samples
+      // beyond the cache are integrated below
+      const PlotData* src_data = dataSource();
+      for (size_t i = 0; i < _integral_prefix.size(); i++)
+      {
+        const double value = _integral_prefix[i];
+        if (!std::isnan(value))
+        {
+          dst_data->pushBack({ src_data->at(i).x, value });
+          _accumulated_value = value;
+          _last_x_produced = src_data->at(i).x;
+        }
+      }
+    }
+    else
+    {
+      invalidateCache();
+    }
+  }
+
+  TransformFunction_SISO::calculate();
 }
 
 QWidget* IntegralTransform::optionsWidget()
@@ -76,6 +168,9 @@ QWidget* IntegralTransform::optionsWidget()
 void IntegralTransform::reset()
 {
   _accumulated_value = 0.0;
+  _last_x_produced = std::numeric_limits<double>::lowest();
+  // the prefix cache survives on purpose: calculate() revalidates it
+  // against the source and drops it only if the data actually changed
   TransformFunction_SISO::reset();
 }
 
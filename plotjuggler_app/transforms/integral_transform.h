@@ -28,6 +28,8 @@ public:
 
   void reset() override;
 
+  void calculate() override;
+
   bool xmlSaveState(QDomDocument& doc, QDomElement& parent_element) const override;
 
   bool xmlLoadState(const QDomElement& parent_element) override;
@@ -37,11 +39,31 @@ public:
 private:
   std::optional<PlotData::Point> calculateNextPoint(size_t index) override;
 
+  bool validateCachedPrefix() const;
+
+  void appendToCache(size_t index, const std::optional<PlotData::Point>& out);
+
+  void invalidateCache();
+
   QWidget* _widget;
   Ui::IntegralTransform* ui;
   double _dT;
 
   double _accumulated_value;
+  // x of the last sample folded into the accumulator; calculate()
+  // revisits that sample when it resumes, and it must not count twice
+  double _last_x_produced;
+
+  // Prefix-sum cache: the integral value for every source index already
+  // processed (NaN where no output point was emitted), plus one source
+  // sample every BLOCK_SIZE as a fingerprint. A reset/update cycle
+  // revalidates the fingerprint in O(size / BLOCK_SIZE) and rebuilds the
+  // output from the cached values instead of re-integrating everything.
+  static constexpr size_t BLOCK_SIZE = 4096;
+  std::vector<double> _integral_prefix;
+  std::vector<PlotData::Point> _block_fingerprint;
+  PlotData::Point _last_cached_sample;
+  double _prefix_dt;
 };
 
 #endif  // INTEGRAL_TRANSFORM_H
@@ -1,5 +1,45 @@
 #include "lua_custom_function.h"
 #include <QTextStream>
+#include <unordered_map>
+#include "PlotJuggler/util/lua_sandbox.hpp"
+
+std::mutex& LuaCustomFunction::engineMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::shared_ptr<sol::state> LuaCustomFunction::sharedEngine()
+{
+  static std::shared_ptr<sol::state> engine = []() {
+    auto state = std::make_shared<sol::state>();
+    state->open_libraries();
+    PJ::SanitizeLuaEngine(*state);
+    return state;
+  }();
+  return engine;
+}
+
+// Compile each distinct source exactly once and replay the bytecode
+// afterwards. Must be called with engineMutex() held.
+const sol::bytecode& LuaCustomFunction::cachedChunk(sol::state& lua, const std::string& source)
+{
+  static std::unordered_map<std::string, sol::bytecode> cache;
+
+  auto it = cache.find(source);
+  if (it == cache.end())
+  {
+    sol::load_result loaded = lua.load(source);
+    if (!loaded.valid())
+    {
+      sol::error err = loaded;
+      throw err;
+    }
+    sol::protected_function chunk = loaded;
+    it = cache.emplace(source, chunk.dump()).first;
+  }
+  return it->second;
+}
 
 LuaCustomFunction::LuaCustomFunction(SnippetData snippet) : CustomFunction(snippet)
 {
@@ -24,17 +64,36 @@ LuaCustomFunction::LuaCustomFunction(SnippetData snippet) : CustomFunction(snipp
 
 void LuaCustomFunction::initEngine()
 {
-  std::unique_lock<std::mutex> lk(mutex_);
+  std::unique_lock<std::mutex> lk(engineMutex());
 
   _lua_function = {};
-  _lua_engine = {};
-  _lua_engine.open_libraries();
-  auto result = _lua_engine.safe_script(_snippet.global_vars.toStdString());
-  if (!result.valid())
+  if (!_lua_engine)
   {
-    sol::error err = result;
-    throw std::runtime_error(getError(err));
+    _lua_engine = sharedEngine();
   }
+  sol::state& lua = *_lua_engine;
+  // a fresh environment isolates the globals of this snippet, while reads
+  // of the standard libraries fall through to the shared state
+  _env = sol::environment(lua, sol::create, lua.globals());
+
+  auto runChunk = [&](const std::string& source) {
+    try
+    {
+      const sol::bytecode& chunk = cachedChunk(lua, source);
+      auto result = lua.safe_script(chunk.as_string_view(), _env);
+      if (!result.valid())
+      {
+        sol::error err = result;
+        throw err;
+      }
+    }
+    catch (sol::error& err)
+    {
+      throw std::runtime_error(getError(err));
+    }
+  };
+
+  runChunk(_snippet.global_vars.toStdString());
 
   auto calcMethodStr = QString("function calc(time, value");
   for (int index = 1; index <= _snippet.additional_sources.size(); index++)
@@ -43,19 +102,14 @@ void LuaCustomFunction::initEngine()
   }
   calcMethodStr += QString(")\n%1\nend").arg(snippet().function);
 
-  result = _lua_engine.safe_script(calcMethodStr.toStdString());
-  if (!result.valid())
-  {
-    sol::error err = result;
-    throw std::runtime_error(getError(err));
-  }
-  _lua_function = _lua_engine["calc"];
+  runChunk(calcMethodStr.toStdString());
+  _lua_function = _env["calc"];
 }
 
 void LuaCustomFunction::calculatePoints(const std::vector<const PlotData*>& src_data,
                                         size_t point_index, std::vector<PlotData::Point>& points)
 {
-  std::unique_lock<std::mutex> lk(mutex_);
+  std::unique_lock<std::mutex> lk(engineMutex());
 
   _chan_values.resize(src_data.size());
 
@@ -4,6 +4,7 @@
 #include "custom_function.h"
 #include <sol/sol.hpp>
 
+#include <memory>
 #include <mutex>
 
 class LuaCustomFunction : public CustomFunction
@@ -31,12 +32,20 @@ public:
   std::string getError(sol::error err);
 
 private:
-  sol::state _lua_engine;
+  // All instances share one sol::state where the standard libraries are
+  // opened exactly once; each instance runs inside its own sol::environment,
+  // so script globals stay isolated. Compiled chunks are cached by source,
+  // which makes re-initialization on layout load near-instant.
+  std::shared_ptr<sol::state> _lua_engine;
+  sol::environment _env;
   sol::protected_function _lua_function;
   std::vector<double> _chan_values;
-  std::mutex mutex_;
   int global_lines_ = 0;
   int function_lines_ = 0;
+
+  static std::shared_ptr<sol::state> sharedEngine();
+  static std::mutex& engineMutex();
+  static const sol::bytecode& cachedChunk(sol::state& lua, const std::string& source);
 };
 
 #endif  // LUA_CUSTOM_FUNCTION_H
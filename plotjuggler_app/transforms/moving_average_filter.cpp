@@ -25,41 +25,72 @@ MovingAverageFilter::~MovingAverageFilter()
 void MovingAverageFilter::reset()
 {
   _buffer.clear();
+  _ring_view = nonstd::ring_span<PlotData::Point>(_buffer.begin(), _buffer.end());
+  _sum = 0.0;
+  _sum_compensation = 0.0;
   TransformFunction_SISO::reset();
 }
 
-std::optional<PlotData::Point> MovingAverageFilter::calculateNextPoint(size_t index)
+void MovingAverageFilter::addToSum(double value)
+{
+  // Kahan compensated addition: the same running sum receives one add and
+  // one subtract per sample, plain accumulation would drift on long streams
+  const double y = value - _sum_compensation;
+  const double t = _sum + y;
+  _sum_compensation = (t - _sum) - y;
+  _sum = t;
+}
+
+void MovingAverageFilter::prepareWindow(size_t buffer_size)
 {
-  size_t buffer_size = std::min(size_t(ui->spinBoxSamples->value()), size_t(dataSource()->size()));
   if (buffer_size != _buffer.size())
   {
     _buffer.resize(buffer_size);
     _ring_view = nonstd::ring_span<PlotData::Point>(_buffer.begin(), _buffer.end());
+    _sum = 0.0;
+    _sum_compensation = 0.0;
   }
+}
 
-  const auto& p = dataSource()->at(index);
+PlotData::Point MovingAverageFilter::addSample(const PlotData::Point& p, size_t buffer_size,
+                                               bool median_time)
+{
+  if (_ring_view.size() == buffer_size)
+  {
+    addToSum(-_ring_view.front().y);
+  }
   _ring_view.push_back(p);
-
+  addToSum(p.y);
+  // pad the window with the first sample, like the full-scan version did
   while (_ring_view.size() < buffer_size)
   {
     _ring_view.push_back(p);
+    addToSum(p.y);
   }
 
-  double total = 0;
+  const double time = median_time ? (_ring_view.back().x + _ring_view.front().x) / 2.0 : p.x;
+  return { time, _sum / double(_ring_view.size()) };
+}
 
-  for (size_t i = 0; i < buffer_size; i++)
-  {
-    total += _ring_view[i].y;
-  }
+std::optional<PlotData::Point> MovingAverageFilter::calculateNextPoint(size_t index)
+{
+  const size_t buffer_size = std::min(size_t(ui->spinBoxSamples->value()), dataSource()->size());
+  prepareWindow(buffer_size);
+  return addSample(dataSource()->at(index), buffer_size, ui->checkBoxTimeOffset->isChecked());
+}
+
+void MovingAverageFilter::calculateBatch(size_t from, size_t to, PlotData* dst)
+{
+  // the options are constant for the whole batch: read them once
+  const size_t buffer_size = std::min(size_t(ui->spinBoxSamples->value()), dataSource()->size());
+  const bool median_time = ui->checkBoxTimeOffset->isChecked();
+  prepareWindow(buffer_size);
 
-  double time = p.x;
-  if (ui->checkBoxTimeOffset->isChecked())
+  const PlotData* src = dataSource();
+  for (size_t index = from; index < to; index++)
   {
-    time = (_ring_view.back().x + _ring_view.front().x) / 2.0;
+    dst->pushBack(addSample(src->at(index), buffer_size, median_time));
   }
-
-  PlotData::Point out = { time, total / _ring_view.size() };
-  return out;
 }
 
 QWidget* MovingAverageFilter::optionsWidget()
@@ -44,6 +44,18 @@ private:
   QWidget* _widget;
   std::vector<PlotData::Point> _buffer;
   nonstd::ring_span_lite::ring_span<PlotData::Point> _ring_view;
+  // running window sum with Kahan compensation: O(1) per sample instead of
+  // rescanning the whole window
+  double _sum = 0.0;
+  double _sum_compensation = 0.0;
+
+  void addToSum(double value);
+
+  void prepareWindow(size_t buffer_size);
+
+  PlotData::Point addSample(const PlotData::Point& p, size_t buffer_size, bool median_time);
 
   std::optional<PlotData::Point> calculateNextPoint(size_t index) override;
+
+  void calculateBatch(size_t from, size_t to, PlotData* dst) override;
 };
@@ -1,5 +1,7 @@
 #include "moving_rms.h"
 #include "ui_moving_rms.h"
+#include <algorithm>
+#include <cmath>
 
 MovingRMS::MovingRMS()
   : ui(new Ui::MovingRMS)
@@ -22,9 +24,55 @@ MovingRMS::~MovingRMS()
 void MovingRMS::reset()
 {
   _buffer.clear();
+  _ring_view = nonstd::ring_span<PJ::PlotData::Point>(_buffer.begin(), _buffer.end());
+  _sum_sqr = 0.0;
+  _sum_compensation = 0.0;
   TransformFunction_SISO::reset();
 }
 
+void MovingRMS::addToSum(double value)
+{
+  // Kahan compensated addition: the same running sum receives one add and
+  // one subtract per sample, plain accumulation would drift on long streams
+  const double y = value - _sum_compensation;
+  const double t = _sum_sqr + y;
+  _sum_compensation = (t - _sum_sqr) - y;
+  _sum_sqr = t;
+}
+
+void MovingRMS::prepareWindow(size_t buffer_size)
+{
+  if (buffer_size != _buffer.size())
+  {
+    _buffer.resize(buffer_size);
+    _ring_view = nonstd::ring_span<PJ::PlotData::Point>(_buffer.begin(), _buffer.end());
+    _sum_sqr = 0.0;
+    _sum_compensation = 0.0;
+  }
+}
+
+PJ::PlotData::Point MovingRMS::addSample(const PJ::PlotData::Point& p, size_t buffer_size)
+{
+  if (_ring_view.size() == buffer_size)
+  {
+    const double evicted = _ring_view.front().y;
+    addToSum(-evicted * evicted);
+  }
+  _ring_view.push_back(p);
+  addToSum(p.y * p.y);
+  // pad the window with the first sample, like the full-scan version did
+  while (_ring_view.size() < buffer_size)
+  {
+    _ring_view.push_back(p);
+    addToSum(p.y * p.y);
+  }
+
+  // compensation keeps the drift tiny, but a negative epsilon would still
+  // poison the square root
+  const double mean_sqr = std::max(0.0, _sum_sqr / double(_ring_view.size()));
+  return { p.x, std::sqrt(mean_sqr) };
+}
+
 QWidget* MovingRMS::optionsWidget()
 {
   return _widget;
@@ -51,31 +99,20 @@ bool MovingRMS::xmlLoadState(const QDomElement& parent_element)
 
 std::optional<PJ::PlotData::Point> MovingRMS::calculateNextPoint(size_t index)
 {
-  size_t buffer_size = std::min(size_t(ui->spinBoxSamples->value()), size_t(dataSource()->size()));
-  if (buffer_size != _buffer.size())
-  {
-    _buffer.resize(buffer_size);
-    _ring_view = nonstd::ring_span<PJ::PlotData::Point>(_buffer.begin(), _buffer.end());
-  }
-
-  const auto& p = dataSource()->at(index);
-  _ring_view.push_back(p);
-
-  while (_ring_view.size() < buffer_size)
-  {
-    _ring_view.push_back(p);
-  }
+  const size_t buffer_size = std::min(size_t(ui->spinBoxSamples->value()), dataSource()->size());
+  prepareWindow(buffer_size);
+  return addSample(dataSource()->at(index), buffer_size);
+}
 
-  double total_sqr = 0;
+void MovingRMS::calculateBatch(size_t from, size_t to, PJ::PlotData* dst)
+{
+  // the window size is constant for the whole batch: read it once
+  const size_t buffer_size = std::min(size_t(ui->spinBoxSamples->value()), dataSource()->size());
+  prepareWindow(buffer_size);
 
-  for (size_t i = 0; i < buffer_size; i++)
+  const PlotData* src = dataSource();
+  for (size_t index = from; index < to; index++)
   {
-    double val = _ring_view[i].y;
-    total_sqr += val * val;
+    dst->pushBack(addSample(src->at(index), buffer_size));
   }
-
-  double time = p.x;
-
-  PJ::PlotData::Point out = { time, sqrt(total_sqr / _ring_view.size()) };
-  return out;
 }
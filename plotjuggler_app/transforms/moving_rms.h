@@ -44,8 +44,20 @@ private:
   QWidget* _widget;
   std::vector<PJ::PlotData::Point> _buffer;
   nonstd::ring_span_lite::ring_span<PJ::PlotData::Point> _ring_view;
+  // running sum of squares with Kahan compensation: O(1) per sample
+  // instead of rescanning the whole window
+  double _sum_sqr = 0.0;
+  double _sum_compensation = 0.0;
+
+  void addToSum(double value);
+
+  void prepareWindow(size_t buffer_size);
+
+  PJ::PlotData::Point addSample(const PJ::PlotData::Point& p, size_t buffer_size);
 
   std::optional<PJ::PlotData::Point> calculateNextPoint(size_t index) override;
+
+  void calculateBatch(size_t from, size_t to, PJ::PlotData* dst) override;
 };
 
 #endif  // MOVING_RMS_H
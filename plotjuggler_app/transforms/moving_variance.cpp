@@ -67,6 +67,46 @@ std::optional<PlotData::Point> MovingVarianceFilter::calculateNextPoint(size_t i
   return PlotData::Point{ p.x, total_sqr / N };
 }
 
+void MovingVarianceFilter::calculateBatch(size_t from, size_t to, PlotData* dst)
+{
+  // the options are constant for the whole batch: read them once
+  const size_t buffer_size = std::min(size_t(ui->spinBoxSamples->value()), dataSource()->size());
+  const bool std_dev = ui->checkBoxStdDev->isChecked();
+
+  if (buffer_size != _buffer.size())
+  {
+    _buffer.resize(buffer_size);
+    _ring_view = nonstd::ring_span<PlotData::Point>(_buffer.begin(), _buffer.end());
+  }
+
+  const PlotData* src = dataSource();
+  for (size_t index = from; index < to; index++)
+  {
+    const auto& p = src->at(index);
+    _ring_view.push_back(p);
+    while (_ring_view.size() < buffer_size)
+    {
+      _ring_view.push_back(p);
+    }
+
+    double total = 0;
+    for (const auto& point : _ring_view)
+    {
+      total += point.y;
+    }
+    const double N = double(_ring_view.size());
+    const double avg = total / N;
+
+    double total_sqr = 0;
+    for (const auto& point : _ring_view)
+    {
+      const auto v = point.y - avg;
+      total_sqr += v * v;
+    }
+    dst->pushBack({ p.x, std_dev ? std::sqrt(total_sqr / N) : total_sqr / N });
+  }
+}
+
 QWidget* MovingVarianceFilter::optionsWidget()
 {
   return _widget;
@@ -46,4 +46,6 @@ private:
   nonstd::ring_span_lite::ring_span<PlotData::Point> _ring_view;
 
   std::optional<PlotData::Point> calculateNextPoint(size_t index) override;
+
+  void calculateBatch(size_t from, size_t to, PlotData* dst) override;
 };
@@ -68,3 +68,39 @@ std::optional<PJ::PlotData::Point> OutlierRemovalFilter::calculateNextPoint(size
   }
   return dataSource()->at(index - 1);
 }
+
+void OutlierRemovalFilter::calculateBatch(size_t from, size_t to, PlotData* dst)
+{
+  // the threshold is constant for the whole batch: read it once instead
+  // of querying the spinbox for every sample. The window is re-read by
+  // direct indexing, which also spares the ring-buffer shuffling.
+  const double thresh = ui->spinBoxFactor->value();
+  const PlotData* src = dataSource();
+
+  for (size_t index = from; index < to; index++)
+  {
+    if (index < 3)
+    {
+      dst->pushBack(src->at(index));
+      continue;
+    }
+    const double y0 = src->at(index - 3).y;
+    const double y1 = src->at(index - 2).y;
+    const double y2 = src->at(index - 1).y;
+    const double y3 = src->at(index).y;
+
+    const double d1 = y1 - y2;
+    const double d2 = y2 - y3;
+    if (d1 * d2 < 0)  // spike
+    {
+      const double d0 = y0 - y1;
+      const double jump = std::max(std::abs(d1), std::abs(d2));
+      if (jump / std::abs(d0) > thresh)
+      {
+        // drop the spiky sample
+        continue;
+      }
+    }
+    dst->pushBack(src->at(index - 1));
+  }
+}
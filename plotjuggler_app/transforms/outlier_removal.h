@@ -43,4 +43,6 @@ private:
   nonstd::ring_span_lite::ring_span<double> _ring_view;
 
   std::optional<PlotData::Point> calculateNextPoint(size_t index) override;
+
+  void calculateBatch(size_t from, size_t to, PlotData* dst) override;
 };
@@ -75,3 +75,30 @@ std::optional<PlotData::Point> ScaleTransform::calculateNextPoint(size_t index)
   PlotData::Point out = { p.x + off_x, scale * p.y + off_y };
   return out;
 }
+
+ScaleTransform::PointwiseFunc ScaleTransform::pointwiseOperation() const
+{
+  // a time offset shifts the timestamps: not a value-only mapping
+  if (ui->lineEditTimeOffset->text().toDouble() != 0.0)
+  {
+    return {};
+  }
+  const double off_y = ui->lineEditValueOffset->text().toDouble();
+  const double scale = ui->lineEditValueScale->text().toDouble();
+  return [=](double y) { return scale * y + off_y; };
+}
+
+void ScaleTransform::calculateBatch(size_t from, size_t to, PlotData* dst)
+{
+  // parse the options once per batch, not once per sample
+  const double off_x = ui->lineEditTimeOffset->text().toDouble();
+  const double off_y = ui->lineEditValueOffset->text().toDouble();
+  const double scale = ui->lineEditValueScale->text().toDouble();
+
+  const PlotData* src = dataSource();
+  for (size_t index = from; index < to; index++)
+  {
+    const auto& p = src->at(index);
+    dst->pushBack({ p.x + off_x, scale * p.y + off_y });
+  }
+}
@@ -39,6 +39,10 @@ private:
   Ui::ScaleTransform* ui;
 
   std::optional<PlotData::Point> calculateNextPoint(size_t index) override;
+
+  void calculateBatch(size_t from, size_t to, PlotData* dst) override;
+
+  PointwiseFunc pointwiseOperation() const override;
 };
 
 #endif  // SCALE_TRANSFORM_H
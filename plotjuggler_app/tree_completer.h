@@ -7,96 +7,76 @@
 #ifndef TREE_COMPLETER_H
 #define TREE_COMPLETER_H
 
-#include <QStandardItem>
-#include <QStandardItemModel>
 #include <QString>
-#include <QVariant>
-#include <QFont>
-#include <QFontDatabase>
-#include <map>
-#include "PlotJuggler/alphanum.hpp"
-/*/
-class TreeItem {
- public:
-  explicit TreeItem(QStandardItem* name_item, QStandardItem* value_item)
-      : _name_item(name_item), _value_item(value_item) {}
-
-  TreeItem* appendChild(const QString& name)
+#include <QStringList>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include "PlotJuggler/plotdata.h"
+
+/**
+ * @brief Sorted index over the numeric series names of a PlotDataMapRef,
+ * used to answer name completion and filter queries without scanning the
+ * whole map.
+ *
+ * refresh() rebuilds the index only when the name set of the map changed
+ * (stamped with PlotDataMapRef::names_revision), so repeated queries
+ * between imports cost nothing. prefixRange() locates the names sharing
+ * a prefix with a binary search: with tens of thousands of series a
+ * query touches only the matching slice.
+ */
+class SeriesNameIndex
+{
+public:
+  /// Rebuild from the map if its name set changed; returns the sorted names.
+  const QStringList& refresh(const PJ::PlotDataMapRef& plot_data)
   {
-    auto child_name = new QStandardItem(name);
-    auto child_value = new QStandardItem("-");
-
-    child_value->setSelectable(false);
-    child_value->setTextAlignment(Qt::AlignRight);
-    child_value->setFlags( Qt::NoItemFlags | Qt::ItemIsEnabled );
-    auto font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
-    child_value->setFont( font );
-    child_value->setFlags(Qt::NoItemFlags);
-
-    QList<QStandardItem*> columns;
-    columns << child_name << child_value;
-    _name_item->appendRow(columns);
-
-    auto res =
-        _child_items_map.insert(std::make_pair(name, TreeItem(child_name, child_value)));
-    return &(res.first->second);
-  }
-
-  TreeItem* findChild(const QString& name) {
-    auto it = _child_items_map.find(name);
-    if (it == _child_items_map.end()) {
-      return nullptr;
+    if (_revision != plot_data.names_revision)
+    {
+      _sorted_names.clear();
+      _sorted_names.reserve(int(plot_data.numeric.size()));
+      for (const auto& it : plot_data.numeric)
+      {
+        _sorted_names.push_back(QString::fromStdString(it.first));
+      }
+      // the map is ordered by byte value; QString comparison is not, so sort again
+      std::sort(_sorted_names.begin(), _sorted_names.end());
+      _revision = plot_data.names_revision;
     }
-    return &(it->second);
+    return _sorted_names;
   }
 
-  QStandardItem* nameItem() { return _name_item; }
-  QStandardItem* valueItem() { return _value_item; }
-
- private:
-  std::map<QString, TreeItem> _child_items_map;
-  QStandardItem* _name_item;
-  QStandardItem* _value_item;
-};
-
-class TreeModel : public QAbstractItemModel {
- public:
-  TreeModel(QStandardItemModel* parent_model)
-      : QStandardItemModel(0, 2, parent_model),
-        _root_tree_item(invisibleRootItem(), nullptr),
-        _parent_model(parent_model) {}
-
-  void clear() {
-    QStandardItemModel::clear();
-    _root_tree_item = TreeItem(invisibleRootItem(), nullptr);
+  const QStringList& sortedNames() const
+  {
+    return _sorted_names;
   }
 
-  void addToTree(const QString& name, int reference_row) {
-    auto parts = name.split('/', PJ::SkipEmptyParts);
-    if (parts.size() == 0) {
-      return;
+  /// Half-open range [first, second) of the indexes whose name starts
+  /// with the given prefix.
+  std::pair<int, int> prefixRange(const QString& prefix) const
+  {
+    if (prefix.isEmpty())
+    {
+      return { 0, _sorted_names.size() };
     }
-
-    TreeItem* tree_parent = &_root_tree_item;
-
-    for (int i = 0; i < parts.size(); i++) {
-      bool is_leaf = (i == parts.size() - 1);
-      const auto& part = parts[i];
-
-      TreeItem* matching_child = tree_parent->findChild(part);
-      if (matching_child) {
-        tree_parent = matching_child;
-      } else {
-
-        tree_parent = tree_parent->appendChild(part);
-        tree_parent->nameItem()->setSelectable(is_leaf);
-      }
+    auto first = std::lower_bound(_sorted_names.begin(), _sorted_names.end(), prefix);
+    // everything below the prefix with its last character incremented
+    // still starts with the prefix
+    const ushort last_unit = prefix.back().unicode();
+    auto last = _sorted_names.end();
+    if (last_unit < std::numeric_limits<ushort>::max())
+    {
+      QString upper = prefix;
+      upper[upper.size() - 1] = QChar(ushort(last_unit + 1));
+      last = std::lower_bound(first, _sorted_names.end(), upper);
     }
+    return { int(first - _sorted_names.begin()), int(last - _sorted_names.begin()) };
   }
 
- private:
-  TreeItem _root_tree_item;
-  QStandardItemModel* _parent_model;
-};*/
+private:
+  QStringList _sorted_names;
+  uint64_t _revision = std::numeric_limits<uint64_t>::max();
+};
 
 #endif  // TREE_COMPLETER_H
@@ -6,6 +6,9 @@
 
 #include "utils.h"
 #include <QDebug>
+#include <atomic>
+#include <functional>
+#include <thread>
 
 namespace PJ
 {
@@ -123,6 +126,11 @@ MoveDataRet MoveData(PlotDataMapRef& source, PlotDataMapRef& destination, bool r
 {
   MoveDataRet ret;
 
+  // merging two series only touches those two series: collect the heavy
+  // per-series work here and decide below whether to fan it out
+  std::vector<std::function<void()>> merge_jobs;
+  size_t queued_samples = 0;
+
   auto moveDataImpl = [&](auto& source_series, auto& destination_series) {
     for (auto& [source_ID, source_plot] : source_series)
     {
@@ -132,6 +140,7 @@ MoveDataRet MoveData(PlotDataMapRef& source, PlotDataMapRef& destination, bool r
       if (dest_plot_it == destination_series.end())
       {
         ret.added_curves.push_back(source_ID);
+        destination.names_revision++;
 
         PlotGroup::Ptr group;
         if (source_plot.group())
@@ -188,7 +197,14 @@ MoveDataRet MoveData(PlotDataMapRef& source, PlotDataMapRef& destination, bool r
         double max_range_x = source_plot.maximumRangeX();
         destination_plot.setMaximumRangeX(max_range_x);
       }
-      MergeData(source_plot, destination_plot);
+      auto* src_ptr = &source_plot;
+      auto* dst_ptr = &destination_plot;
+      if (source_plot.size() != 0)
+      {
+        ret.updated_curves.push_back(source_ID);
+      }
+      queued_samples += source_plot.size();
+      merge_jobs.emplace_back([src_ptr, dst_ptr]() { MergeData(*src_ptr, *dst_ptr); });
     }
   };
 
@@ -198,6 +214,44 @@ MoveDataRet MoveData(PlotDataMapRef& source, PlotDataMapRef& destination, bool r
   moveDataImpl(source.scatter_xy, destination.scatter_xy);
   moveDataImpl(source.user_defined, destination.user_defined);
 
+  // Bulk imports are worth spreading across cores; the small periodic
+  // batches of streaming stay on the calling thread.
+  constexpr size_t MIN_SAMPLES_FOR_PARALLEL_MERGE = 200 * 1024;
+
+  if (merge_jobs.size() > 1 && queued_samples >= MIN_SAMPLES_FOR_PARALLEL_MERGE)
+  {
+    // the jobs append to series sharing the destination time-range
+    // accumulator: stale it up front so that no worker writes to it
+    // (see SharedTimeRange)
+    destination.numeric_range->stale.store(true, std::memory_order_relaxed);
+
+    const size_t num_threads =
+        std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), merge_jobs.size());
+    std::atomic<size_t> next_job(0);
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads);
+    for (size_t t = 0; t < num_threads; t++)
+    {
+      workers.emplace_back([&merge_jobs, &next_job]() {
+        for (size_t j = next_job++; j < merge_jobs.size(); j = next_job++)
+        {
+          merge_jobs[j]();
+        }
+      });
+    }
+    for (auto& worker : workers)
+    {
+      worker.join();
+    }
+  }
+  else
+  {
+    for (auto& job : merge_jobs)
+    {
+      job();
+    }
+  }
+
   return ret;
 }
 
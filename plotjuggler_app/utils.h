@@ -59,6 +59,8 @@ private:
 struct MoveDataRet
 {
   std::vector<std::string> added_curves;
+  // names of the series that received at least one new sample
+  std::vector<std::string> updated_curves;
   bool curves_updated = false;
   bool data_pushed = false;
 };
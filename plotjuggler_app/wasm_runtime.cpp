@@ -1,6 +1,9 @@
 #include "wasm_runtime.hpp"
 
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
@@ -28,6 +31,82 @@ static std::vector<uint8_t> readBinaryFile(const std::string& path)
   return buf;
 }
 
+// ---------------------------------------------------------------------------
+// Compiled-module disk cache
+// ---------------------------------------------------------------------------
+
+static uint64_t fnv1aHash(const std::vector<uint8_t>& bytes)
+{
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (uint8_t byte : bytes)
+  {
+    hash = (hash ^ byte) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// (cache dir)/plotjuggler/wasm/<hash>-<size>.wasmer
+static std::filesystem::path moduleCachePath(const std::vector<uint8_t>& raw_bytes)
+{
+  std::filesystem::path cache_root;
+#ifdef _WIN32
+  if (const char* local = std::getenv("LOCALAPPDATA"))
+  {
+    cache_root = local;
+  }
+#else
+  if (const char* xdg = std::getenv("XDG_CACHE_HOME"))
+  {
+    cache_root = xdg;
+  }
+  else if (const char* home = std::getenv("HOME"))
+  {
+    cache_root = std::filesystem::path(home) / ".cache";
+  }
+#endif
+  if (cache_root.empty())
+  {
+    return {};
+  }
+  char filename[64];
+  std::snprintf(filename, sizeof(filename), "%016llx-%zu.wasmer",
+                static_cast<unsigned long long>(fnv1aHash(raw_bytes)), raw_bytes.size());
+  return cache_root / "plotjuggler" / "wasm" / filename;
+}
+
+// Best-effort: a failure to persist the cache only costs a recompile on
+// the next startup, so errors are swallowed.
+static void saveCompiledModule(wasm_module_t* module, const std::filesystem::path& path)
+{
+  wasm_byte_vec_t serialized = WASM_EMPTY_VEC;
+  wasm_module_serialize(module, &serialized);
+  if (serialized.size == 0)
+  {
+    return;
+  }
+
+  std::error_code ec;
+  std::filesystem::create_directories(path.parent_path(), ec);
+  if (!ec)
+  {
+    // write to a temporary name first, so a crash mid-write cannot leave a
+    // truncated file behind under the final name
+    const std::filesystem::path tmp_path = path.string() + ".tmp";
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    if (file && file.write(serialized.data, std::streamsize(serialized.size)))
+    {
+      file.close();
+      std::filesystem::rename(tmp_path, path, ec);
+    }
+    else
+    {
+      file.close();
+      std::filesystem::remove(tmp_path, ec);
+    }
+  }
+  wasm_byte_vec_delete(&serialized);
+}
+
 // ---------------------------------------------------------------------------
 // Stub import callbacks (C-style — cannot capture lambdas)
 // ---------------------------------------------------------------------------
@@ -74,8 +153,11 @@ static void env_stub_finalizer(void* env_ptr)
 
 WasmRuntime::WasmRuntime(const std::string& module_path)
 {
-  // 1. Engine + Store
-  engine_ = wasm_engine_new();
+  // 1. Engine + Store. The engine (and its JIT code cache) is shared by
+  // every runtime in the process; each runtime still gets its own store,
+  // since stores hold per-instance state.
+  static wasm_engine_t* shared_engine = wasm_engine_new();
+  engine_ = shared_engine;
   if (!engine_)
   {
     throw std::runtime_error("Failed to create WASM engine");
@@ -99,18 +181,50 @@ WasmRuntime::WasmRuntime(const std::string& module_path)
     throw std::runtime_error("Failed to create WASI environment");
   }
 
-  // 3. Compile module
+  // 3. Compile module, or restore it from the AOT disk cache. Compiling a
+  // parser module takes hundreds of milliseconds; deserializing the cached
+  // native code is nearly free, so a stream with wasm parsing starts
+  // instantly after the first run.
   std::vector<uint8_t> raw_bytes = readBinaryFile(module_path);
-  wasm_byte_vec_t wasm_bytes;
-  wasm_byte_vec_new(&wasm_bytes, raw_bytes.size(),
-                    reinterpret_cast<const wasm_byte_t*>(raw_bytes.data()));
+  const std::filesystem::path cache_path = moduleCachePath(raw_bytes);
 
-  module_ = wasm_module_new(store_, &wasm_bytes);
-  wasm_byte_vec_delete(&wasm_bytes);
+  if (!cache_path.empty() && std::filesystem::exists(cache_path))
+  {
+    try
+    {
+      std::vector<uint8_t> cached = readBinaryFile(cache_path.string());
+      wasm_byte_vec_t cached_bytes;
+      wasm_byte_vec_new(&cached_bytes, cached.size(),
+                        reinterpret_cast<const wasm_byte_t*>(cached.data()));
+      // returns null (and we recompile below) when the cache was produced
+      // by a different wasmer version or got corrupted
+      module_ = wasm_module_deserialize(store_, &cached_bytes);
+      wasm_byte_vec_delete(&cached_bytes);
+    }
+    catch (const std::exception&)
+    {
+      module_ = nullptr;
+    }
+  }
 
   if (!module_)
   {
-    throw std::runtime_error("Failed to compile WASM module: " + module_path);
+    wasm_byte_vec_t wasm_bytes;
+    wasm_byte_vec_new(&wasm_bytes, raw_bytes.size(),
+                      reinterpret_cast<const wasm_byte_t*>(raw_bytes.data()));
+
+    module_ = wasm_module_new(store_, &wasm_bytes);
+    wasm_byte_vec_delete(&wasm_bytes);
+
+    if (!module_)
+    {
+      throw std::runtime_error("Failed to compile WASM module: " + module_path);
+    }
+
+    if (!cache_path.empty())
+    {
+      saveCompiledModule(module_, cache_path);
+    }
   }
 
   // 4. Resolve imports and instantiate
@@ -146,10 +260,7 @@ WasmRuntime::~WasmRuntime()
   {
     wasm_store_delete(store_);
   }
-  if (engine_)
-  {
-    wasm_engine_delete(engine_);
-  }
+  // engine_ is the process-wide shared engine: never deleted
 }
 
 // ---------------------------------------------------------------------------
@@ -310,6 +421,12 @@ wasm_func_t* WasmRuntime::getFunc(const std::string& name)
   return it->second;
 }
 
+wasm_func_t* WasmRuntime::findFunc(const std::string& name)
+{
+  auto it = export_funcs_.find(name);
+  return (it == export_funcs_.end()) ? nullptr : it->second;
+}
+
 std::vector<int32_t> WasmRuntime::callFunc(wasm_func_t* func, const std::vector<int32_t>& args)
 {
   // Build args vec
@@ -19,6 +19,10 @@ public:
   // Returns borrowed handle; caller must NOT delete it
   wasm_func_t* getFunc(const std::string& name);
 
+  // Like getFunc(), but returns nullptr instead of throwing when the
+  // export does not exist (used to probe optional ABI extensions)
+  wasm_func_t* findFunc(const std::string& name);
+
   // Call a wasm function with i32 args; returns i32 results
   std::vector<int32_t> callFunc(wasm_func_t* func, const std::vector<int32_t>& args);
 
@@ -34,7 +38,7 @@ public:
   }
 
 private:
-  wasm_engine_t* engine_ = nullptr;
+  wasm_engine_t* engine_ = nullptr;  // process-wide shared engine, not owned
   wasm_store_t* store_ = nullptr;
   wasm_module_t* module_ = nullptr;
   wasm_instance_t* instance_ = nullptr;
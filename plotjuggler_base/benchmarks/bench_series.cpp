@@ -0,0 +1,250 @@
+// Micro-benchmarks for the core series containers (PlotData, PlotDataSoA
+// and PlotDataMapRef helpers). Run the full suite with:
+//
+//   ./plotjuggler_bench
+//
+// or a single benchmark with --benchmark_filter=BM_AppendBatch.
+// The CTest entry runs with a tiny --benchmark_min_time so that it acts
+// as a smoke test; for actual numbers run the binary directly.
+
+#include <benchmark/benchmark.h>
+
+#include <PlotJuggler/plotdata.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace PJ;
+
+namespace
+{
+struct Samples
+{
+  std::vector<double> xs;
+  std::vector<double> ys;
+};
+
+// Monotonic timestamps at 1 kHz with pseudo-random values. Only the last
+// requested size is cached: the 50M-point inputs are ~800 MB and we do
+// not want three copies alive at once.
+const Samples& sortedSamples(size_t count)
+{
+  static Samples cached;
+  static size_t cached_count = 0;
+  if (cached_count != count)
+  {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> val(-100, 100);
+    cached.xs.resize(count);
+    cached.ys.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+      cached.xs[i] = 0.001 * double(i);
+      cached.ys[i] = val(rng);
+    }
+    cached_count = count;
+  }
+  return cached;
+}
+
+// Same, but roughly 1% of the timestamps jump back in time, forcing the
+// sorted-insertion path of TimeseriesBase::pushBack().
+const Samples& unsortedSamples(size_t count)
+{
+  static Samples cached;
+  static size_t cached_count = 0;
+  if (cached_count != count)
+  {
+    cached = sortedSamples(count);
+    std::mt19937 rng(7);
+    for (size_t i = 1; i < count; i += 100)
+    {
+      cached.xs[i] -= 0.001 * double(1 + rng() % 20);
+    }
+    cached_count = count;
+  }
+  return cached;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------
+// Append throughput: one pushBack() per sample, time-ordered input.
+
+static void BM_PushBack(benchmark::State& state)
+{
+  const size_t count = size_t(state.range(0));
+  const auto& in = sortedSamples(count);
+  for (auto _ : state)
+  {
+    PlotData series("series", {});
+    for (size_t i = 0; i < count; i++)
+    {
+      series.pushBack({ in.xs[i], in.ys[i] });
+    }
+    benchmark::DoNotOptimize(series.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Bulk append of the same input through appendBatch().
+static void BM_AppendBatch(benchmark::State& state)
+{
+  const size_t count = size_t(state.range(0));
+  const auto& in = sortedSamples(count);
+  for (auto _ : state)
+  {
+    PlotData series("series", {});
+    series.appendBatch(in.xs.data(), in.ys.data(), count);
+    benchmark::DoNotOptimize(series.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Same, on the chunked structure-of-arrays backend.
+static void BM_AppendBatchSoA(benchmark::State& state)
+{
+  const size_t count = size_t(state.range(0));
+  const auto& in = sortedSamples(count);
+  for (auto _ : state)
+  {
+    PlotDataSoA series("series", {});
+    series.appendBatch(in.xs.data(), in.ys.data(), count);
+    benchmark::DoNotOptimize(series.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Out-of-order input: ~1% of the samples land behind the back of the
+// series and take the upper_bound + insert path.
+static void BM_PushBackUnsorted(benchmark::State& state)
+{
+  const size_t count = size_t(state.range(0));
+  const auto& in = unsortedSamples(count);
+  for (auto _ : state)
+  {
+    PlotData series("series", {});
+    for (size_t i = 0; i < count; i++)
+    {
+      series.pushBack({ in.xs[i], in.ys[i] });
+    }
+    benchmark::DoNotOptimize(series.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Steady-state sliding window: maximumRangeX covers 10% of the input, so
+// most appends evict from the front (trimRange + popFront).
+static void BM_TrimRange(benchmark::State& state)
+{
+  const size_t count = size_t(state.range(0));
+  const auto& in = sortedSamples(count);
+  const double window = (in.xs.back() - in.xs.front()) / 10.0;
+  for (auto _ : state)
+  {
+    PlotData series("series", {});
+    series.setMaximumRangeX(window);
+    for (size_t i = 0; i < count; i++)
+    {
+      series.pushBack({ in.xs[i], in.ys[i] });
+    }
+    benchmark::DoNotOptimize(series.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+//-----------------------------------------------------------------
+// Range queries
+
+// The streaming pattern: one new sample, one evicted sample, then a
+// rangeY() refresh. Exercises the monotonic min/max deques instead of a
+// full rescan.
+static void BM_StreamingRangeY(benchmark::State& state)
+{
+  const size_t count = size_t(state.range(0));
+  const auto& in = sortedSamples(count);
+  PlotData series("series", {});
+  series.appendBatch(in.xs.data(), in.ys.data(), count);
+
+  double t = in.xs.back();
+  size_t k = 0;
+  for (auto _ : state)
+  {
+    t += 0.001;
+    series.pushBack({ t, in.ys[k++ % count] });
+    series.popFront();
+    auto range = series.rangeY();
+    benchmark::DoNotOptimize(range->min);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Random-position getIndexFromX() lookups (the time tracker and the
+// downsampler are the hot callers).
+static void BM_GetIndexFromX(benchmark::State& state)
+{
+  const size_t count = size_t(state.range(0));
+  const auto& in = sortedSamples(count);
+  PlotData series("series", {});
+  series.appendBatch(in.xs.data(), in.ys.data(), count);
+
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> pos(in.xs.front(), in.xs.back());
+  std::vector<double> queries(1024);
+  for (auto& q : queries)
+  {
+    q = pos(rng);
+  }
+
+  for (auto _ : state)
+  {
+    for (double q : queries)
+    {
+      benchmark::DoNotOptimize(series.getIndexFromX(q));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+//-----------------------------------------------------------------
+// Map merge: re-keying a map of 1000 series with AddPrefixToPlotData().
+// The node-extraction implementation never touches the samples, so the
+// cost must stay flat as the total point count grows.
+
+static void BM_AddPrefixToPlotData(benchmark::State& state)
+{
+  const size_t total_points = size_t(state.range(0));
+  const size_t num_series = 1000;
+  const size_t points_per_series = std::max<size_t>(1, total_points / num_series);
+  const auto& in = sortedSamples(points_per_series);
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    TimeseriesMap map;
+    for (size_t s = 0; s < num_series; s++)
+    {
+      const std::string name = "series_" + std::to_string(s);
+      auto itr = map.emplace(std::piecewise_construct, std::forward_as_tuple(name),
+                             std::forward_as_tuple(name, PlotGroup::Ptr{}));
+      itr.first->second.appendBatch(in.xs.data(), in.ys.data(), points_per_series);
+    }
+    state.ResumeTiming();
+
+    AddPrefixToPlotData("prefix", map);
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * num_series);
+}
+
+//-----------------------------------------------------------------
+
+BENCHMARK(BM_PushBack)->Arg(1000)->Arg(1000000)->Arg(50000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AppendBatch)->Arg(1000)->Arg(1000000)->Arg(50000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AppendBatchSoA)->Arg(1000)->Arg(1000000)->Arg(50000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PushBackUnsorted)->Arg(1000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TrimRange)->Arg(1000)->Arg(1000000)->Arg(50000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StreamingRangeY)->Arg(1000)->Arg(1000000)->Arg(50000000);
+BENCHMARK(BM_GetIndexFromX)->Arg(1000)->Arg(1000000)->Arg(50000000);
+BENCHMARK(BM_AddPrefixToPlotData)->Arg(1000)->Arg(1000000)->Arg(50000000);
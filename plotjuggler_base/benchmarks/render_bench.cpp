@@ -0,0 +1,342 @@
+// Offscreen paint benchmark for PlotWidgetBase and the Qwt series
+// wrappers. It replays scripted scenarios (repeated replots, zoom
+// sequences, streaming appends with and without the scroll-blit path,
+// the min/max envelope mode) into a real widget under the "offscreen"
+// Qt platform, and prints per-frame times and heap allocation counts as
+// JSON. Run it directly for numbers:
+//
+//   ./plotjuggler_render_bench --curves 10 --points 500000 --frames 120
+//
+// The CTest entry runs a handful of frames per scenario, so that the
+// paint path is exercised in CI even though the timings there are noise.
+//
+// A "frame" is one replot() plus the event-loop pass that delivers the
+// resulting paint event to the canvas backing store: the same path the
+// application takes, so scroll blits and cached scale divisions behave
+// exactly as they do on screen. Allocation counts come from a global
+// operator new override and therefore include every allocation made by
+// the process during the frame, not only ours; they are still a stable
+// relative signal between two commits.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <PlotJuggler/plotdata.h>
+#include <PlotJuggler/plotwidget_base.h>
+#include "qwt_plot.h"
+
+static std::atomic<uint64_t> g_alloc_count{ 0 };
+
+void* operator new(std::size_t size)
+{
+  g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size ? size : 1))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+using namespace PJ;
+
+/// PlotWidgetBase keeps the axis control protected; the scenarios need it
+/// to script zooms the same way PlotWidget does.
+class BenchWidget : public PlotWidgetBase
+{
+public:
+  explicit BenchWidget(QWidget* parent = nullptr) : PlotWidgetBase(parent)
+  {
+  }
+
+  void setRangeX(double min, double max)
+  {
+    setAxisScaleIfChanged(QwtPlot::xBottom, min, max);
+  }
+
+  void setRangeY(double min, double max)
+  {
+    setAxisScaleIfChanged(QwtPlot::yLeft, min, max);
+  }
+
+  // same cache refresh the application does after a streaming batch
+  void updateCurveCaches()
+  {
+    for (auto& it : curveList())
+    {
+      auto series = dynamic_cast<QwtSeriesWrapper*>(it.curve->data());
+      series->updateCache(false);
+    }
+  }
+};
+
+struct FrameStats
+{
+  std::vector<double> frame_ms;
+  std::vector<uint64_t> frame_allocs;
+
+  void record(double ms, uint64_t allocs)
+  {
+    frame_ms.push_back(ms);
+    frame_allocs.push_back(allocs);
+  }
+
+  QJsonObject toJson() const
+  {
+    auto sorted = frame_ms;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double p) {
+      const size_t idx = size_t(p * double(sorted.size() - 1));
+      return sorted[idx];
+    };
+    uint64_t total_allocs = 0;
+    for (uint64_t count : frame_allocs)
+    {
+      total_allocs += count;
+    }
+    QJsonObject obj;
+    obj["frames"] = int(sorted.size());
+    obj["min_ms"] = sorted.front();
+    obj["median_ms"] = percentile(0.5);
+    obj["p95_ms"] = percentile(0.95);
+    obj["max_ms"] = sorted.back();
+    obj["allocs_per_frame"] = double(total_allocs) / double(frame_allocs.size());
+    return obj;
+  }
+};
+
+struct BenchConfig
+{
+  int num_curves = 10;
+  size_t points_per_curve = 200000;
+  int frames = 60;
+  int canvas_width = 1200;
+  int canvas_height = 700;
+};
+
+// 1 kHz sine waves at slightly different frequencies, so that curves do
+// not overlap pixel-perfectly and the painter has real work per curve
+void fillSeries(PlotDataMapRef& data, const BenchConfig& config)
+{
+  for (int c = 0; c < config.num_curves; c++)
+  {
+    auto& series = data.getOrCreateNumeric("bench/curve_" + std::to_string(c));
+    const double freq = 0.5 + 0.13 * double(c);
+    for (size_t i = 0; i < config.points_per_curve; i++)
+    {
+      const double t = 0.001 * double(i);
+      series.pushBack({ t, std::sin(t * freq * 2 * M_PI) });
+    }
+  }
+}
+
+// One frame: run `mutate`, then replot and pump the event loop so the
+// canvas actually paints into its backing store.
+template <typename Mutator>
+FrameStats runFrames(BenchWidget& widget, int frames, const Mutator& mutate)
+{
+  FrameStats stats;
+  QElapsedTimer timer;
+  for (int frame = 0; frame < frames; frame++)
+  {
+    mutate(frame);
+    const uint64_t allocs_before = g_alloc_count.load(std::memory_order_relaxed);
+    timer.start();
+    widget.replot();
+    QCoreApplication::sendPostedEvents();
+    QCoreApplication::processEvents();
+    stats.record(double(timer.nsecsElapsed()) * 1e-6,
+                 g_alloc_count.load(std::memory_order_relaxed) - allocs_before);
+  }
+  return stats;
+}
+
+std::unique_ptr<BenchWidget> makeWidget(PlotDataMapRef& data, const BenchConfig& config)
+{
+  auto widget = std::make_unique<BenchWidget>();
+  widget->resize(config.canvas_width, config.canvas_height);
+  for (auto& [name, series] : data.numeric)
+  {
+    widget->addCurve(name, series);
+  }
+  widget->show();
+  QCoreApplication::processEvents();
+  widget->setRangeY(-1.2, 1.2);
+  return widget;
+}
+
+// Sanity check, not a measurement: render the last frame to an image and
+// make sure the scenario painted something at all.
+bool paintedSomething(BenchWidget& widget)
+{
+  QImage image(widget.size(), QImage::Format_ARGB32_Premultiplied);
+  image.fill(Qt::white);
+  widget.render(&image);
+  const QRgb blank = QColor(Qt::white).rgb();
+  for (int y = 0; y < image.height(); y += 7)
+  {
+    const QRgb* line = reinterpret_cast<const QRgb*>(image.scanLine(y));
+    for (int x = 0; x < image.width(); x++)
+    {
+      if (line[x] != blank)
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  // the whole point is to run without a display server
+  if (qgetenv("QT_QPA_PLATFORM").isEmpty())
+  {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+  QApplication app(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Offscreen paint benchmark for PlotWidgetBase");
+  parser.addHelpOption();
+  parser.addOption({ "curves", "Number of curves per scenario", "num", "10" });
+  parser.addOption({ "points", "Points per curve", "num", "200000" });
+  parser.addOption({ "frames", "Frames per scenario", "num", "60" });
+  parser.process(app);
+
+  BenchConfig config;
+  config.num_curves = parser.value("curves").toInt();
+  config.points_per_curve = parser.value("points").toULongLong();
+  config.frames = parser.value("frames").toInt();
+  if (config.num_curves < 1 || config.points_per_curve < 1000 || config.frames < 1)
+  {
+    std::cerr << "render_bench: invalid configuration" << std::endl;
+    return -1;
+  }
+
+  QJsonObject result;
+  result["num_curves"] = config.num_curves;
+  result["points_per_curve"] = double(config.points_per_curve);
+
+  const double full_span = 0.001 * double(config.points_per_curve);
+
+  // ---- scenario: repeated replot of unchanged data, full range ----
+  // Measures the steady-state cost when nothing moved: cached scale
+  // divisions and decimated series should make this the cheapest case.
+  {
+    PlotDataMapRef data;
+    fillSeries(data, config);
+    auto widget = makeWidget(data, config);
+    widget->setRangeX(0, full_span);
+    auto stats = runFrames(*widget, config.frames, [](int) {});
+    if (!paintedSomething(*widget))
+    {
+      std::cerr << "render_bench: static scenario painted nothing" << std::endl;
+      return -1;
+    }
+    result["static_full_range"] = stats.toJson();
+  }
+
+  // ---- scenario: zoom-out sequence ----
+  // Every frame widens the window by 1.5x, from 1% of the data to the
+  // full range and back, so each frame re-enters the decimation and
+  // min/max range machinery with a different samples-per-pixel ratio.
+  {
+    PlotDataMapRef data;
+    fillSeries(data, config);
+    auto widget = makeWidget(data, config);
+    double span = full_span * 0.01;
+    auto stats = runFrames(*widget, config.frames, [&](int) {
+      widget->setRangeX(0, span);
+      span = (span >= full_span) ? full_span * 0.01 : std::min(span * 1.5, full_span);
+    });
+    result["zoom_sequence"] = stats.toJson();
+  }
+
+  // ---- scenario: streaming appends, follow mode ----
+  // Appends a batch per frame and shifts a fixed 10 second window, like
+  // a live stream with the time tracker in follow mode.
+  auto streamingScenario = [&](bool scroll_blit) {
+    PlotDataMapRef data;
+    fillSeries(data, config);
+    auto widget = makeWidget(data, config);
+    widget->setScrollBlitEnabled(scroll_blit);
+    const size_t batch = 2000;
+    size_t total = config.points_per_curve;
+    auto stats = runFrames(*widget, config.frames, [&](int) {
+      for (auto& [name, series] : data.numeric)
+      {
+        for (size_t i = 0; i < batch; i++)
+        {
+          const double t = 0.001 * double(total + i);
+          series.pushBack({ t, std::sin(t * 2 * M_PI) });
+        }
+      }
+      total += batch;
+      widget->updateCurveCaches();
+      const double now = 0.001 * double(total);
+      widget->setRangeX(now - 10.0, now);
+    });
+    return stats;
+  };
+  result["streaming"] = streamingScenario(false).toJson();
+  result["streaming_scroll_blit"] = streamingScenario(true).toJson();
+
+  // ---- scenario: min/max envelope mode, full range ----
+  // Same view as the static scenario, with the envelope band and mean
+  // line rebuilt from the summary index on every frame.
+  {
+    PlotDataMapRef data;
+    fillSeries(data, config);
+    auto widget = makeWidget(data, config);
+    widget->setEnvelopeEnabled(true);
+    widget->setRangeX(0, full_span);
+    auto stats = runFrames(*widget, config.frames, [](int) {});
+    result["envelope_full_range"] = stats.toJson();
+  }
+
+  std::cout << QJsonDocument(result).toJson(QJsonDocument::Indented).toStdString() << std::endl;
+  return 0;
+}
@@ -0,0 +1,291 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_ANY_VALUE_H
+#define PJ_ANY_VALUE_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "PlotJuggler/util/block_pool.hpp"
+
+namespace PJ
+{
+/**
+ * @brief Type-erased sample value for user_defined series (PlotDataAny).
+ *
+ * std::any heap-allocates anything larger than a pointer or two, which
+ * means one malloc/free per stored message when a plugin keeps whole
+ * decoded samples in a PlotDataAny series. AnyValue keeps values up to
+ * INLINE_CAPACITY bytes inside the sample itself — which already lives
+ * in pooled deque blocks — and serves larger ones from the BlockPool
+ * size classes, so steady-state streaming recycles the same few blocks
+ * instead of hammering the global allocator.
+ *
+ * Only the subset of the std::any interface used in this codebase is
+ * provided. Retrieval is cast<T>(), which returns nullptr on a type
+ * mismatch instead of throwing bad_any_cast.
+ */
+class AnyValue
+{
+public:
+  /// Sized so that typical decoded samples (small structs, shared_ptr
+  /// handles, SSO strings, vectors plus a header) stay inline.
+  static constexpr size_t INLINE_CAPACITY = 48;
+
+  AnyValue() noexcept
+  {
+  }
+
+  AnyValue(const AnyValue& other)
+  {
+    if (other._manager)
+    {
+      other._manager(Op::COPY, &other, this);
+    }
+  }
+
+  AnyValue(AnyValue&& other) noexcept
+  {
+    if (other._manager)
+    {
+      other._manager(Op::MOVE, &other, this);
+    }
+  }
+
+  template <typename T, typename D = std::decay_t<T>,
+            typename = std::enable_if_t<!std::is_same_v<D, AnyValue>>>
+  AnyValue(T&& value)
+  {
+    construct<D>(std::forward<T>(value));
+  }
+
+  AnyValue& operator=(const AnyValue& other)
+  {
+    if (this != &other)
+    {
+      reset();
+      if (other._manager)
+      {
+        other._manager(Op::COPY, &other, this);
+      }
+    }
+    return *this;
+  }
+
+  AnyValue& operator=(AnyValue&& other) noexcept
+  {
+    if (this != &other)
+    {
+      reset();
+      if (other._manager)
+      {
+        other._manager(Op::MOVE, &other, this);
+      }
+    }
+    return *this;
+  }
+
+  ~AnyValue()
+  {
+    reset();
+  }
+
+  void reset() noexcept
+  {
+    if (_manager)
+    {
+      _manager(Op::DESTROY, this, nullptr);
+      _manager = nullptr;
+    }
+  }
+
+  bool has_value() const noexcept
+  {
+    return _manager != nullptr;
+  }
+
+  const std::type_info& type() const noexcept
+  {
+    return _manager ? *static_cast<const std::type_info*>(_manager(Op::TYPE, this, nullptr)) :
+                      typeid(void);
+  }
+
+  /// Typed access; nullptr if empty or holding a different type.
+  template <typename T>
+  const T* cast() const noexcept
+  {
+    if (!_manager || type() != typeid(T))
+    {
+      return nullptr;
+    }
+    return static_cast<const T*>(_manager(Op::GET, this, nullptr));
+  }
+
+  template <typename T>
+  T* cast() noexcept
+  {
+    return const_cast<T*>(static_cast<const AnyValue*>(this)->cast<T>());
+  }
+
+private:
+  enum class Op
+  {
+    DESTROY,
+    COPY,
+    MOVE,
+    TYPE,
+    GET
+  };
+
+  using Manager = const void* (*)(Op, const AnyValue*, AnyValue*);
+
+  // Inline storage additionally requires a nothrow move constructor, so
+  // that moving an AnyValue (deque growth, merge of staged samples) can
+  // stay noexcept like the std::any it replaces.
+  template <typename T>
+  static constexpr bool storedInline()
+  {
+    return sizeof(T) <= INLINE_CAPACITY && alignof(T) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<T>;
+  }
+
+  /// Overflow allocations are rounded up to a BlockPool size class so
+  /// they hit its free lists; outliers fall through to operator new
+  /// inside BlockPool itself.
+  static constexpr size_t overflowSize(size_t bytes)
+  {
+    for (size_t class_size : BlockPool::CLASS_SIZES)
+    {
+      if (bytes <= class_size)
+      {
+        return class_size;
+      }
+    }
+    return bytes;
+  }
+
+  template <typename T, typename... Args>
+  void construct(Args&&... args)
+  {
+    if constexpr (storedInline<T>())
+    {
+      ::new (static_cast<void*>(_buffer)) T(std::forward<Args>(args)...);
+      _manager = &managerInline<T>;
+    }
+    else if constexpr (alignof(T) > alignof(std::max_align_t))
+    {
+      // over-aligned types can not use the pool blocks
+      _heap = new T(std::forward<Args>(args)...);
+      _manager = &managerAligned<T>;
+    }
+    else
+    {
+      void* block = BlockPool::instance().allocate(overflowSize(sizeof(T)));
+      try
+      {
+        _heap = ::new (block) T(std::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+        BlockPool::instance().deallocate(block, overflowSize(sizeof(T)));
+        throw;
+      }
+      _manager = &managerPooled<T>;
+    }
+  }
+
+  template <typename T>
+  static const void* managerInline(Op op, const AnyValue* self, AnyValue* other)
+  {
+    T* obj = reinterpret_cast<T*>(const_cast<unsigned char*>(self->_buffer));
+    switch (op)
+    {
+      case Op::DESTROY:
+        obj->~T();
+        break;
+      case Op::COPY:
+        other->construct<T>(*obj);
+        break;
+      case Op::MOVE:
+        other->construct<T>(std::move(*obj));
+        obj->~T();
+        const_cast<AnyValue*>(self)->_manager = nullptr;
+        break;
+      case Op::TYPE:
+        return &typeid(T);
+      case Op::GET:
+        return obj;
+    }
+    return nullptr;
+  }
+
+  template <typename T>
+  static const void* managerPooled(Op op, const AnyValue* self, AnyValue* other)
+  {
+    T* obj = static_cast<T*>(self->_heap);
+    switch (op)
+    {
+      case Op::DESTROY:
+        obj->~T();
+        BlockPool::instance().deallocate(obj, overflowSize(sizeof(T)));
+        break;
+      case Op::COPY:
+        other->construct<T>(*obj);
+        break;
+      case Op::MOVE:
+        // steal the allocation: pointer swap, no T operation at all
+        other->_heap = obj;
+        other->_manager = self->_manager;
+        const_cast<AnyValue*>(self)->_manager = nullptr;
+        break;
+      case Op::TYPE:
+        return &typeid(T);
+      case Op::GET:
+        return obj;
+    }
+    return nullptr;
+  }
+
+  template <typename T>
+  static const void* managerAligned(Op op, const AnyValue* self, AnyValue* other)
+  {
+    T* obj = static_cast<T*>(self->_heap);
+    switch (op)
+    {
+      case Op::DESTROY:
+        delete obj;
+        break;
+      case Op::COPY:
+        other->construct<T>(*obj);
+        break;
+      case Op::MOVE:
+        other->_heap = obj;
+        other->_manager = self->_manager;
+        const_cast<AnyValue*>(self)->_manager = nullptr;
+        break;
+      case Op::TYPE:
+        return &typeid(T);
+      case Op::GET:
+        return obj;
+    }
+    return nullptr;
+  }
+
+  union
+  {
+    alignas(std::max_align_t) unsigned char _buffer[INLINE_CAPACITY];
+    void* _heap;
+  };
+  Manager _manager = nullptr;
+};
+
+}  // namespace PJ
+
+#endif
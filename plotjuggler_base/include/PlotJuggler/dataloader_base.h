@@ -8,6 +8,10 @@
 #define DATALOAD_TEMPLATE_H
 
 #include <QFile>
+#include <QStringList>
+
+#include <atomic>
+#include <functional>
 
 #include "PlotJuggler/plotdata.h"
 #include "PlotJuggler/pj_plugin.h"
@@ -15,14 +19,68 @@
 
 namespace PJ
 {
+/**
+ * @brief Cooperative progress / cancellation channel between the
+ * application and a DataLoader.
+ *
+ * The application installs one with DataLoader::setLoadControl() before
+ * calling readDataFromFile() and owns the progress UI; the loader polls
+ * notifyProgress() from its parse loop instead of creating its own
+ * progress dialog. The flags are atomics, so the parse loop may run on
+ * a different thread than the one reading the progress and cancelling.
+ */
+class LoadControl
+{
+public:
+  void cancel()
+  {
+    _canceled.store(true, std::memory_order_release);
+  }
+
+  bool isCanceled() const
+  {
+    return _canceled.load(std::memory_order_acquire);
+  }
+
+  /// fraction of the load done so far, in [0, 1]; negative while unknown
+  double progress() const
+  {
+    return _progress.load(std::memory_order_relaxed);
+  }
+
+  void setProgress(double fraction)
+  {
+    _progress.store(fraction, std::memory_order_relaxed);
+  }
+
+  /// Installed by the application when the loader runs on the GUI
+  /// thread: pumps the event loop so the progress dialog repaints and
+  /// its Cancel button works. Left empty when the loader runs on a
+  /// worker thread and the GUI polls progress() on its own.
+  std::function<void()> yield;
+
+private:
+  std::atomic<bool> _canceled{ false };
+  std::atomic<double> _progress{ -1.0 };
+};
+
 struct FileLoadInfo
 {
-  /// name of the file to open
+  /// name of the file to open. Loaders that support it may also receive
+  /// an http(s) URL here (see PlotJuggler/util/remote_file.hpp)
   QString filename;
   /// prefix to be added to the name of the series (optional)
   QString prefix;
   /// Saved configuration from a previous run or a Layout file
   QDomDocument plugin_config;
+  /**
+   * When not empty, load only the topics / columns whose name is in this
+   * list (names as returned by DataLoader::listTopicsInFile). Filled by
+   * the application through the topic selection dialog, or restored from
+   * a Layout file; loaders that declare supportsTopicFilter() skip
+   * everything else at parse time.
+   */
+  QStringList selected_topics;
 };
 
 /**
@@ -43,6 +101,65 @@ public:
 
   virtual bool readDataFromFile(FileLoadInfo* fileload_info, PlotDataMapRef& destination) = 0;
 
+  /// True when the plugin implements tailDataFromFile(): after a
+  /// successful readDataFromFile() it keeps its parse state and can
+  /// append the bytes written since then, without a full re-parse.
+  virtual bool supportsTailFollow() const
+  {
+    return false;
+  }
+
+  /**
+   * @brief Incremental follow-up of a file previously opened with
+   * readDataFromFile() and still being written by a recorder.
+   *
+   * The plugin parses only the bytes appended since the last call (or
+   * since the initial load) and pushes the new samples into
+   * `destination`; the application merges them into the existing series,
+   * exactly like a streaming source. Partial trailing records are left
+   * pending for the next call.
+   *
+   * Returns false when incremental parsing is not possible — the file
+   * was truncated, replaced, or the saved state does not match — in
+   * which case the caller should fall back to a full readDataFromFile().
+   * A call that finds no new complete record is a success.
+   */
+  virtual bool tailDataFromFile(FileLoadInfo* fileload_info, PlotDataMapRef& destination)
+  {
+    (void)fileload_info;
+    (void)destination;
+    return false;
+  }
+
+  /**
+   * @brief True when the plugin implements listTopicsInFile() and honors
+   * FileLoadInfo::selected_topics. Before calling readDataFromFile() the
+   * application then runs the metadata pre-scan and offers the shared
+   * topic selection dialog, so that unselected topics are skipped at
+   * parse time instead of being materialized and never plotted.
+   *
+   * Plugins with their own selection UI (the CSV and MCAP loaders) keep
+   * returning false: a second dialog would only get in the way.
+   */
+  virtual bool supportsTopicFilter() const
+  {
+    return false;
+  }
+
+  /**
+   * @brief Metadata pre-scan listing the topics / columns available in
+   * the file, without decoding any sample; must be cheap compared to the
+   * load itself. Only called when supportsTopicFilter() is true.
+   *
+   * An empty list means the metadata could not be listed: the
+   * application skips the selection dialog and loads everything.
+   */
+  virtual QStringList listTopicsInFile(const QString& filename)
+  {
+    (void)filename;
+    return {};
+  }
+
   void setParserFactories(ParserFactories* parsers)
   {
     _parser_factories = parsers;
@@ -53,8 +170,48 @@ public:
     return _parser_factories;
   }
 
+  /// Installed by the application around readDataFromFile(); null when
+  /// the loader is invoked directly (worker process, tests).
+  void setLoadControl(LoadControl* control)
+  {
+    _load_control = control;
+  }
+
+  LoadControl* loadControl() const
+  {
+    return _load_control;
+  }
+
+protected:
+  /**
+   * To be polled from the parse loop, typically every few thousand
+   * samples: publishes the progress fraction ([0, 1], or negative when
+   * the total is unknown), keeps the GUI responsive and returns false
+   * once the user asked to cancel.
+   *
+   * On cancellation the loader must stop promptly and either keep the
+   * consistent prefix parsed so far in the destination and return true
+   * (preferred: the application detects the partial load through the
+   * control), or discard everything and return false when a consistent
+   * partial result is not possible.
+   */
+  bool notifyProgress(double fraction)
+  {
+    if (_load_control == nullptr)
+    {
+      return true;
+    }
+    _load_control->setProgress(fraction);
+    if (_load_control->yield)
+    {
+      _load_control->yield();
+    }
+    return !_load_control->isCanceled();
+  }
+
 private:
   ParserFactories* _parser_factories = nullptr;
+  LoadControl* _load_control = nullptr;
 };
 
 using DataLoaderPtr = std::shared_ptr<DataLoader>;
@@ -7,11 +7,14 @@
 #ifndef DATA_STREAMER_TEMPLATE_H
 #define DATA_STREAMER_TEMPLATE_H
 
+#include <atomic>
 #include <mutex>
 #include <unordered_set>
+#include <QByteArray>
 #include "PlotJuggler/plotdata.h"
 #include "PlotJuggler/pj_plugin.h"
 #include "PlotJuggler/messageparser_base.h"
+#include "PlotJuggler/util/spsc_queue.hpp"
 
 namespace PJ
 {
@@ -59,6 +62,21 @@ public:
     return { nullptr, 0 };
   }
 
+  /**
+   * @brief Hint from the application: the time range currently visible
+   * across the plots (absolute time) and the horizontal pixel budget
+   * available to draw it. Called again whenever the user zooms, pans or
+   * resizes. Streamers that pull data from a remote source can forward it
+   * upstream, so the server ships data at the resolution the client can
+   * actually display. The default implementation ignores the hint.
+   */
+  virtual void setVisibleViewport(double min_time, double max_time, int pixel_width)
+  {
+    (void)min_time;
+    (void)max_time;
+    (void)pixel_width;
+  }
+
   std::mutex& mutex()
   {
     return _mutex;
@@ -80,6 +98,147 @@ public:
 
   const ParserFactories* parserFactories() const;
 
+  /**
+   * @brief Alternative to writing into dataMap() under mutex(): a lock-free
+   * single-producer / single-consumer path for numeric samples.
+   *
+   * The producer thread registers each series once, then calls
+   * pushStreamedSample() which never blocks on mutex(); the GUI thread
+   * drains the queue into dataMap() while merging data. If more than one
+   * thread produces samples, each of them must use its own DataStreamer
+   * or keep using mutex().
+   */
+
+  /// Register a numeric series for the lock-free path (takes the mutex once).
+  /// Returns the index to pass to pushStreamedSample().
+  size_t registerStreamedSeries(const std::string& name);
+
+  /// Producer thread only. Wait-free; returns false and counts a drop
+  /// when the queue is full.
+  bool pushStreamedSample(size_t series_index, double x, double y);
+
+  /// Called by the GUI thread with mutex() held, before moving dataMap().
+  /// Returns the number of samples transferred. Also adapts the queue
+  /// capacity to the observed traffic (see adaptQueueCapacity).
+  size_t drainStreamedSamples();
+
+  /**
+   * @brief Move the content of dataMap() into "staging", holding mutex()
+   * only for a per-series swap of the sample buffers: the lock hold time is
+   * proportional to the number of series, not to the batch size. The caller
+   * merges "staging" into the main data map afterwards, while the producer
+   * threads keep filling the (now empty) dataMap().
+   */
+  void takeStreamedData(PlotDataMapRef& staging);
+
+  /// Samples discarded because the queue was full.
+  size_t droppedStreamedSamples() const
+  {
+    return _dropped_samples.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Pausing the display should not cost a full parse load: while the
+   * pause button is down, the plugins are decoding messages into series
+   * nobody is looking at.
+   *
+   * When "UI paused" is set, parseOrSpool() stops running the parser and
+   * appends the raw message bytes to an in-memory spool instead, compressed
+   * with qCompress in chunks. On resume the spool is replayed through the
+   * original parsers in arrival order, so the decoded result is the same as
+   * if parsing had never stopped. Called by the main window when the
+   * streaming pause button is toggled; a fresh pause always starts with an
+   * empty spool, and resuming replays synchronously before returning.
+   */
+  void setUiPaused(bool paused);
+
+  bool isUiPaused() const
+  {
+    return _ui_paused.load(std::memory_order_acquire);
+  }
+
+  /// Bytes currently held by the pause spool (compressed chunks plus the
+  /// chunk still being filled).
+  size_t spooledBytes() const
+  {
+    return _spooled_bytes.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Drop-in replacement for parser.parseMessage() in the receive
+   * path. Must be called with mutex() held, like parseMessage() itself;
+   * the lock is also what keeps the paused flag stable for the duration of
+   * the call. Parses immediately while the display runs, spools the raw
+   * bytes while it is paused. `parser` must stay alive until the plugin
+   * shuts down, because the replay on resume goes through the same
+   * instance.
+   */
+  bool parseOrSpool(MessageParser& parser, const MessageRef& msg, double& timestamp);
+
+  /// parseMessageBatch() counterpart of parseOrSpool(), same contract.
+  void parseOrSpoolBatch(MessageParser& parser, const MessageRef* messages, double* timestamps,
+                         size_t count);
+
+  /**
+   * @brief Runtime health counters of the streaming pipeline.
+   *
+   * Plugins update them from any thread (relaxed atomics, no lock).
+   * The base class periodically publishes them as ordinary numeric
+   * series under "__plotjuggler/stats/<plugin>/", so the pipeline's own
+   * health can be plotted and alerted on like any other data:
+   * cumulative messages received / parsed / dropped, the occupancy of
+   * the lock-free sample queue, and the mean / max parse latency since
+   * the previous publish. Nothing is published for plugins that never
+   * touch the counters.
+   */
+  struct StreamStats
+  {
+    std::atomic<uint64_t> messages_received{ 0 };
+    std::atomic<uint64_t> messages_parsed{ 0 };
+    std::atomic<uint64_t> messages_dropped{ 0 };
+    std::atomic<uint64_t> parse_ns_total{ 0 };
+    std::atomic<uint64_t> parse_ns_max{ 0 };
+  };
+
+  StreamStats& streamStats()
+  {
+    return _stream_stats;
+  }
+
+  /// Convenience for the "message_count messages parsed in N nanoseconds"
+  /// update: bumps messages_parsed and the latency counters. Streamers
+  /// that decode in batches pass the batch size as message_count.
+  void recordParseTime(uint64_t nanoseconds, uint64_t message_count = 1);
+
+  /// Prefix of the series published by the statistics channel.
+  static constexpr const char* STATS_PREFIX = "__plotjuggler/stats/";
+
+  /**
+   * @brief Scheduling configuration for the threads that receive streaming
+   * data, so that ingest latency does not depend on GUI load.
+   *
+   * The default is set in Preferences -> Behavior ("Streaming threads") and
+   * stored under "StreamerThread::default". A single plugin can be tuned
+   * differently by writing the same keys under "StreamerThread::<plugin
+   * name>": "affinity" (comma-separated CPU list, e.g. "2,3"),
+   * "fifo_priority" and "busy_poll".
+   */
+  struct IngestThreadConfig
+  {
+    std::vector<int> cpu_affinity;  ///< CPUs to pin to; empty: inherit
+    int fifo_priority = 0;          ///< 1-99: SCHED_FIFO, 0: keep SCHED_OTHER
+    bool busy_poll = false;         ///< spin on the socket instead of sleeping
+  };
+
+  /// Configuration for this plugin: per-plugin override when present,
+  /// the global default otherwise.
+  IngestThreadConfig ingestThreadConfig() const;
+
+  /// Apply affinity and scheduling class to the calling thread. Implemented
+  /// on Linux only; a denied request (typically SCHED_FIFO without
+  /// CAP_SYS_NICE) is reported with qWarning and skipped.
+  static void applyToCurrentThread(const IngestThreadConfig& config);
+
 signals:
 
   /// Request the main application to clear previous data points
@@ -101,10 +260,85 @@ signals:
   void notificationsChanged(int active_notification_count);
 
 private:
+  struct StreamedSample
+  {
+    uint32_t series_index;
+    double x;
+    double y;
+  };
+
   std::mutex _mutex;
   PlotDataMapRef _data_map;
   QAction* _start_streamer;
   ParserFactories* _parser_factories = nullptr;
+
+  /// Bounds of the adaptive sample queue, in entries. The capacity starts
+  /// at QUEUE_INITIAL_CAPACITY, doubles as soon as a drain observes drops
+  /// or near-full occupancy (a drop is lost data, so growth is immediate)
+  /// and halves only after many consecutive quiet drains, so an idle
+  /// plugin shrinks to ~100 KB while a bursty bus keeps the room it needed.
+  enum : size_t
+  {
+    QUEUE_MIN_CAPACITY = 4 * 1024,
+    QUEUE_INITIAL_CAPACITY = 64 * 1024,
+    QUEUE_MAX_CAPACITY = 1024 * 1024
+  };
+
+  /// The queue the producer currently pushes to. Resizes swap in a new
+  /// queue and park the old one in _retired_queue; see adaptQueueCapacity
+  /// for the handoff protocol.
+  std::unique_ptr<SPSCQueue<StreamedSample>> _sample_queue =
+      std::make_unique<SPSCQueue<StreamedSample>>(QUEUE_INITIAL_CAPACITY);
+  std::unique_ptr<SPSCQueue<StreamedSample>> _retired_queue;
+  std::atomic<SPSCQueue<StreamedSample>*> _active_queue{ _sample_queue.get() };
+  /// Bumped by the consumer after each queue swap; the producer echoes the
+  /// value it read before pushing, which tells the consumer when no push
+  /// into the retired queue can still be in flight.
+  std::atomic<uint64_t> _queue_epoch{ 0 };
+  std::atomic<uint64_t> _producer_epoch{ 0 };
+
+  std::vector<std::string> _streamed_series_names;
+  std::atomic<size_t> _dropped_samples{ 0 };
+
+  // consumer-side bookkeeping of adaptQueueCapacity(), under mutex()
+  size_t _quiet_drains = 0;
+  size_t _last_drain_depth = 0;
+  size_t _last_drain_dropped = 0;
+  uint64_t _drained_total = 0;
+
+  /// Grow or shrink the sample queue according to the traffic seen by the
+  /// drain that just completed. Called by drainStreamedSamples() with
+  /// mutex() held.
+  void adaptQueueCapacity();
+
+  /// Raw messages spooled while the UI is paused. Records are
+  /// [uint32 parser index][double timestamp][uint32 size][payload]; the
+  /// chunk being filled is sealed with qCompress once it grows past
+  /// kSpoolChunkSize. Protected by mutex().
+  struct PauseSpool
+  {
+    std::vector<MessageParser*> parsers;
+    std::vector<QByteArray> sealed_chunks;
+    QByteArray open_chunk;
+    size_t message_count = 0;
+    size_t sealed_bytes = 0;
+  };
+  PauseSpool _spool;
+  std::atomic<bool> _ui_paused{ false };
+  std::atomic<size_t> _spooled_bytes{ 0 };
+
+  /// mutex() held by the caller in all three.
+  void spoolMessage(MessageParser& parser, const MessageRef& msg, double timestamp);
+  void replaySpool();
+  void clearSpool();
+
+  StreamStats _stream_stats;
+  uint64_t _last_parsed_count = 0;
+  uint64_t _last_parse_ns_total = 0;
+
+  /// Append the current counters to the stats series. Called by
+  /// takeStreamedData() with mutex() held.
+  void publishStreamStats();
 };
 
 using DataStreamerPtr = std::shared_ptr<DataStreamer>;
@@ -85,24 +85,64 @@ public:
 
   virtual bool parseMessage(const MessageRef serialized_msg, double& timestamp) = 0;
 
+  /** Parse several messages of the same topic in one call.
+   *
+   * The default implementation simply loops over parseMessage(); parsers
+   * that pay a fixed cost per call (e.g. crossing the WASM boundary)
+   * override this to amortize it over the whole batch. timestamps has one
+   * entry per message and may be adjusted by parsers that use an embedded
+   * timestamp, like parseMessage() does.
+   */
+  virtual void parseMessageBatch(const MessageRef* messages, double* timestamps, size_t count)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      parseMessage(messages[i], timestamps[i]);
+    }
+  }
+
   // Decide what to do if an array is particularly large (size > max_size):
   //
-  // if clamp == true, then keep the first max_size elements,
-  // otherwise, skip the entire array.
-  virtual void setLargeArraysPolicy(bool clamp, unsigned max_size)
+  // - SKIP: don't store the array at all
+  // - CLAMP: keep only the first max_size elements
+  // - DECIMATE: keep max_size elements spread over the whole array,
+  //   preserving the minimum and the maximum of each bucket. Parsers that
+  //   don't implement decimation treat it as CLAMP.
+  enum class LargeArrayPolicy
+  {
+    SKIP,
+    CLAMP,
+    DECIMATE
+  };
+
+  virtual void setLargeArraysPolicy(LargeArrayPolicy policy, unsigned max_size)
   {
-    _clamp_large_arrays = clamp;
+    _large_array_policy = policy;
     _max_array_size = max_size;
   }
 
+  // Overload kept for the callers and subclasses that predate DECIMATE:
+  // clamp == true keeps the first max_size elements, false skips the array.
+  virtual void setLargeArraysPolicy(bool clamp, unsigned max_size)
+  {
+    setLargeArraysPolicy(clamp ? LargeArrayPolicy::CLAMP : LargeArrayPolicy::SKIP, max_size);
+  }
+
   unsigned maxArraySize() const
   {
     return _max_array_size;
   }
 
+  LargeArrayPolicy largeArrayPolicy() const
+  {
+    return _large_array_policy;
+  }
+
+  // True whenever some elements should be stored (CLAMP or DECIMATE):
+  // parsers limited to a keep-or-skip choice should keep.
   bool clampLargeArray() const
   {
-    return _clamp_large_arrays;
+    return _large_array_policy != LargeArrayPolicy::SKIP;
   }
 
   virtual bool useEmbeddedTimestamp() const
@@ -120,18 +160,20 @@ protected:
   std::string _topic_name;
   PlotGroup::Ptr _group;
 
-  PlotData& getSeries(const std::string& key)
+  // string_view pass-through: keys sliced out of the message buffer reach
+  // the map without a temporary std::string (see PlotDataMapRef)
+  PlotData& getSeries(std::string_view key)
   {
     return _plot_data.getOrCreateNumeric(key, _group);
   }
 
-  StringSeries& getStringSeries(const std::string& key)
+  StringSeries& getStringSeries(std::string_view key)
   {
     return _plot_data.getOrCreateStringSeries(key, _group);
   }
 
 private:
-  bool _clamp_large_arrays = false;
+  LargeArrayPolicy _large_array_policy = LargeArrayPolicy::SKIP;
   unsigned _max_array_size = 10000;
   bool _use_embedded_timestamp = false;
 };
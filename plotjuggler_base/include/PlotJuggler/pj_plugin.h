@@ -12,6 +12,7 @@
 #include <QWidget>
 #include <QDomDocument>
 #include "PlotJuggler/plotdata.h"
+#include "PlotJuggler/thread_pool.h"
 
 namespace PJ
 {
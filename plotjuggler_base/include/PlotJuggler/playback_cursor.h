@@ -0,0 +1,70 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_PLAYBACK_CURSOR_H
+#define PJ_PLAYBACK_CURSOR_H
+
+#include <functional>
+#include <vector>
+
+#include "PlotJuggler/plotdata.h"
+
+namespace PJ
+{
+/**
+ * Replay engine that walks a PlotDataMapRef forward in time.
+ *
+ * During playback the tracker time moves monotonically, but publishers that
+ * look up "the samples since the last tick" with getIndexFromX() pay a binary
+ * search per series per tick; with hundreds of series this dominates
+ * faster-than-realtime replay. PlaybackCursor keeps one integer cursor per
+ * series instead: seek() positions all cursors with a single binary search
+ * each, and advance() only steps each cursor over the new tail, invoking the
+ * callback for every sample in the (previous_time, time] window.
+ *
+ * advance() re-seeks automatically when time moves backwards or when series
+ * are added or removed. If the data itself is modified (cleared, trimmed,
+ * re-imported), call seek() to re-synchronize the cursors.
+ */
+class PlaybackCursor
+{
+public:
+  /// Invoked by advance() once per new sample, grouped per series and in
+  /// time order within each series.
+  using SampleCallback = std::function<void(const std::string& series_name, const PlotData::Point& point)>;
+
+  void setDataMap(const PlotDataMapRef* datamap)
+  {
+    _datamap = datamap;
+    _needs_seek = true;
+  }
+
+  /// Position every cursor on the first sample with x > time.
+  /// O(series * log(points)); advance() calls it only when needed.
+  void seek(double time);
+
+  /// Advance all the cursors monotonically up to (and including) \p time and
+  /// invoke \p callback for each sample passed over. Returns the number of
+  /// samples published in this tick.
+  size_t advance(double time, const SampleCallback& callback);
+
+private:
+  struct Cursor
+  {
+    const std::string* name;
+    const PlotData* series;
+    size_t next_index;
+  };
+
+  const PlotDataMapRef* _datamap = nullptr;
+  std::vector<Cursor> _cursors;
+  double _current_time = 0;
+  bool _needs_seek = true;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_PLAYBACK_CURSOR_H
@@ -10,14 +10,54 @@
 #include "plotdatabase.h"
 #include "timeseries.h"
 #include "stringseries.h"
-#include <any>
+#include "soa_storage.h"
+#include "any_value.h"
+#include <cstdint>
+#include <string_view>
 #include <unordered_set>
+#include <vector>
 
 namespace PJ
 {
+// PlotDataXY (and its SoA variant at the bottom of this block) remains an
+// alias of the template: it is the type used polymorphically across the
+// plugin interface (PlotWidgetBase::addCurve, the Qwt wrappers), and every
+// timeseries IS-A PlotDataXY.
 using PlotDataXY = PlotDataBase<double, double>;
-using PlotData = TimeseriesBase<double>;
-using PlotDataAny = TimeseriesBase<std::any>;
+
+/**
+ * The concrete series types below are final classes rather than aliases:
+ * knowing the dynamic type lets the compiler devirtualize — and, since the
+ * whole hierarchy lives in headers, inline — the append path (pushBack()
+ * together with the range maintenance it performs) wherever a series is
+ * manipulated through its concrete type, which is the case in every loader,
+ * streamer and transform. Access through PlotDataBase / TimeseriesBase
+ * references keeps its virtual behavior.
+ */
+class PlotData final : public TimeseriesBase<double>
+{
+public:
+  using TimeseriesBase<double>::TimeseriesBase;
+};
+
+/// user_defined series store one AnyValue per sample: inline up to
+/// AnyValue::INLINE_CAPACITY bytes, BlockPool-backed beyond that.
+/// Use AnyValue::cast<T>() instead of std::any_cast to read them back.
+class PlotDataAny final : public TimeseriesBase<AnyValue>
+{
+public:
+  using TimeseriesBase<AnyValue>::TimeseriesBase;
+};
+
+/// Same as PlotData / PlotDataXY, but backed by chunked structure-of-arrays
+/// storage (see soa_storage.h). Preferable for very large series, where
+/// min/max passes and downsampling are limited by memory bandwidth.
+class PlotDataSoA final : public TimeseriesBase<double, SoAStorage<PlotPoint<double, double>>>
+{
+public:
+  using TimeseriesBase<double, SoAStorage<PlotPoint<double, double>>>::TimeseriesBase;
+};
+using PlotDataXYSoA = PlotDataBase<double, double, SoAStorage<PlotPoint<double, double>>>;
 
 /**
  * @brief The PlotDataMapRef is the main data structure used to store all the
@@ -52,72 +92,202 @@ struct PlotDataMapRef
    */
   std::unordered_map<std::string, PlotGroup::Ptr> groups;
 
-  ScatterXYMap::iterator addScatterXY(const std::string& name, PlotGroup::Ptr group = {});
+  /// Time range of all the numeric series (see numericRangeX()). Shared
+  /// with the series, that extend it as they grow.
+  SharedTimeRange::Ptr numeric_range = std::make_shared<SharedTimeRange>();
 
-  TimeseriesMap::iterator addNumeric(const std::string& name, PlotGroup::Ptr group = {});
+  /**
+   * @brief Revision of the set of series names: bumped whenever a series
+   * is created, erased, or the map is cleared (MoveData() bumps it too
+   * when it creates destination series directly). Mirrors of the name
+   * list, like the curve panel and its completer, can compare it with
+   * the last revision they saw and skip the rescan when it did not move.
+   */
+  uint64_t names_revision = 0;
 
-  AnySeriesMap::iterator addUserDefined(const std::string& name, PlotGroup::Ptr group = {});
+  /**
+   * The lookup-or-create accessors take a string_view, so a parser that
+   * assembles keys from message fields does not pay a temporary
+   * std::string per call even on the hit path: the view is matched
+   * against the map through a thread-local buffer whose capacity is
+   * reused across calls (std::unordered_map only learns heterogeneous
+   * lookup in C++20), and a key string is allocated only when the series
+   * is actually created.
+   */
+
+  ScatterXYMap::iterator addScatterXY(std::string_view name, PlotGroup::Ptr group = {});
+
+  TimeseriesMap::iterator addNumeric(std::string_view name, PlotGroup::Ptr group = {});
+
+  AnySeriesMap::iterator addUserDefined(std::string_view name, PlotGroup::Ptr group = {});
 
-  StringSeriesMap::iterator addStringSeries(const std::string& name, PlotGroup::Ptr group = {});
+  StringSeriesMap::iterator addStringSeries(std::string_view name, PlotGroup::Ptr group = {});
 
-  PlotDataXY& getOrCreateScatterXY(const std::string& name, PlotGroup::Ptr group = {});
+  PlotDataXY& getOrCreateScatterXY(std::string_view name, PlotGroup::Ptr group = {});
 
-  PlotData& getOrCreateNumeric(const std::string& name, PlotGroup::Ptr group = {});
+  PlotData& getOrCreateNumeric(std::string_view name, PlotGroup::Ptr group = {});
 
-  StringSeries& getOrCreateStringSeries(const std::string& name, PlotGroup::Ptr group = {});
+  StringSeries& getOrCreateStringSeries(std::string_view name, PlotGroup::Ptr group = {});
 
-  PlotDataAny& getOrCreateUserDefined(const std::string& name, PlotGroup::Ptr group = {});
+  PlotDataAny& getOrCreateUserDefined(std::string_view name, PlotGroup::Ptr group = {});
+
+  /**
+   * @brief Append `count` samples from two parallel arrays to a numeric
+   * timeseries, creating it if needed. One map lookup and one range
+   * update per batch instead of per point: loaders and high-rate
+   * streamers should prefer this to pushBack() in a loop.
+   * See TimeseriesBase::appendBatch() for the exact semantics.
+   */
+  PlotData& appendBatch(std::string_view name, const double* xs, const double* ys, size_t count,
+                        PlotGroup::Ptr group = {});
 
   PlotGroup::Ptr getOrCreateGroup(const std::string& name);
 
+  /**
+   * @brief Refresh (when stale) and return the accumulator with the time
+   * range of all the numeric series and the size of the largest one.
+   *
+   * Appends keep the cached value current in O(1); trimming, erasing or
+   * clearing series only marks it stale, and the refresh done here folds
+   * the O(1) cached range of each series without touching the samples.
+   * Intended for the time slider and the time offset, which used to
+   * rescan the whole map after every stream batch.
+   */
+  const SharedTimeRange& numericRangeX();
+
+  /// Detached copy of the samples of one numeric series (see
+  /// snapshotNumeric): two contiguous parallel arrays.
+  struct SeriesSnapshot
+  {
+    std::vector<double> xs;
+    std::vector<double> ys;
+
+    size_t size() const
+    {
+      return xs.size();
+    }
+  };
+
+  /**
+   * @brief Detach a stable copy of a numeric series for analysis plugins
+   * (FFT and friends). The samples in range_x (all of them when nullopt)
+   * are copied out one storage chunk at a time, at memory-bandwidth
+   * speed, so the caller can compute on the snapshot for as long as it
+   * wants while streaming keeps mutating the live series. Call it from
+   * the thread that owns the map, like every other accessor; the
+   * returned snapshot can then move to any worker.
+   *
+   * Returns nullopt when the series does not exist or is empty.
+   */
+  std::optional<SeriesSnapshot> snapshotNumeric(std::string_view name,
+                                                RangeOpt range_x = {}) const;
+
   std::unordered_set<std::string> getAllNames() const;
 
   void clear();
 
+  /**
+   * @brief Set the maximum time range of every time-ordered series and
+   * drop the samples that fall outside it. With many series the eviction
+   * runs in parallel on the shared thread pool; the call returns only
+   * when every series is trimmed.
+   */
   void setMaximumRangeX(double range);
 
-  bool erase(const std::string& name);
+  bool erase(std::string_view name);
+
+  /// Estimate of the memory used by the samples of all the series, in bytes.
+  /// Only the sample storage is counted: string dictionaries and the payload
+  /// of user_defined series are not.
+  size_t memoryUsage() const;
+
+  /**
+   * @brief Drop the oldest samples of the timeseries until memoryUsage()
+   * fits in the given budget. Each series is trimmed proportionally to its
+   * own size, so large series pay more than small ones.
+   *
+   * @return the number of bytes freed.
+   */
+  size_t enforceMemoryBudget(size_t budget_bytes);
+
+  /**
+   * @brief Move the oldest samples of every time-ordered series out of the
+   * heap into a shared temp file, where the storage backend supports it
+   * (see SoAStorage::spillColdChunks). Unlike enforceMemoryBudget(), no
+   * sample is lost: spilled chunks are paged back in on access. The newest
+   * keep_recent_points samples of each series stay resident, so the hot
+   * streaming tail is never touched. Called automatically by
+   * enforceMemoryBudget() before resorting to eviction.
+   *
+   * @return the number of heap bytes moved to disk.
+   */
+  size_t spillColdData(size_t keep_recent_points = 8192);
+
+  /**
+   * @brief Compress the oldest chunks of every time-ordered series in
+   * place, where the storage backend supports it (see
+   * SoAStorage::compressColdChunks). The samples stay in RAM, bitwise
+   * intact, and are decompressed transparently on access; only the newest
+   * keep_recent_points samples of each series are left uncompressed.
+   * Called automatically by enforceMemoryBudget() before spilling to disk.
+   *
+   * @return the number of heap bytes saved.
+   */
+  size_t compressColdData(size_t keep_recent_points = 8192);
+
+  /// One entry of memoryProfile(): the footprint of a single series.
+  struct SeriesFootprint
+  {
+    std::string name;
+    const char* kind;  ///< "numeric", "string", "scatter_xy" or "user_defined"
+    size_t points;
+    MemoryFootprint footprint;
+  };
+
+  /**
+   * @brief Per-series memory accounting over all the maps, in no
+   * particular order (the memory profiler dialog sorts it). The sum of
+   * the entries is a finer-grained version of memoryUsage(): it also
+   * counts string dictionaries and bookkeeping overhead, which
+   * memoryUsage() - being on the streaming hot path - skips.
+   */
+  std::vector<SeriesFootprint> memoryProfile() const;
 };
 
 template <typename Value>
 inline void AddPrefixToPlotData(const std::string& prefix,
                                 std::unordered_map<std::string, Value>& data)
 {
-  if (prefix.empty())
+  if (prefix.empty() || data.empty())
   {
     return;
   }
 
-  std::vector<std::string> temp_key;
-  temp_key.reserve(data.size());
-  std::vector<Value> temp_value;
-  temp_value.reserve(data.size());
+  // Re-key by recycling the map nodes: the series themselves are never
+  // copied, moved or re-allocated, only the key strings are rewritten.
+  std::unordered_map<std::string, Value> prefixed;
+  prefixed.reserve(data.size());
 
-  for (auto& it : data)
+  std::string key;
+  while (!data.empty())
   {
-    std::string key;
-    key.reserve(prefix.size() + 2 + it.first.size());
-    key = (it.first.front() == '/') ? (prefix + it.first) : (prefix + "/" + it.first);
-
-    temp_key.emplace_back(key);
-    temp_value.emplace_back(std::move(it.second));
-  }
-
-  data.clear();
-
-  for (size_t i = 0; i < temp_key.size(); i++)
-  {
-    const std::string& key = temp_key[i];
-    auto group = temp_value[i].group();
-
-    auto it = data.emplace(std::piecewise_construct, std::forward_as_tuple(key),
-                           std::forward_as_tuple(key, group))
-                  .first;
-
-    // Keep the new prefixed plot name while moving samples and metadata.
-    it->second.attributes() = std::move(temp_value[i].attributes());
-    it->second.swapData(temp_value[i]);
+    auto node = data.extract(data.begin());
+    const std::string& old_key = node.key();
+
+    key.clear();
+    key.reserve(prefix.size() + 1 + old_key.size());
+    key = prefix;
+    if (old_key.front() != '/')
+    {
+      key += '/';
+    }
+    key += old_key;
+
+    node.key() = key;
+    node.mapped().setPlotName(node.key());
+    prefixed.insert(std::move(node));
   }
+  data = std::move(prefixed);
 }
 
 }  // namespace PJ
@@ -7,6 +7,7 @@
 #ifndef PJ_PLOTDATA_BASE_H
 #define PJ_PLOTDATA_BASE_H
 
+#include <array>
 #include <memory>
 #include <string>
 #include <deque>
@@ -19,8 +20,79 @@
 #include <QVariant>
 #include <QtGlobal>
 
+#include "string_interner.h"
+#include "util/block_pool.hpp"
+#include "util/simd_minmax.hpp"
+
 namespace PJ
 {
+// Detects storage backends that expose their samples as contiguous
+// per-coordinate chunks (see SoAStorage), usable by vectorized kernels.
+template <typename T, typename = void>
+struct HasChunkAccess : std::false_type
+{
+};
+
+template <typename T>
+struct HasChunkAccess<T, std::void_t<decltype(std::declval<const T&>().chunkDataY(0))>>
+  : std::true_type
+{
+};
+
+// Detects storage backends with a bulk append(xs, ys, count) method
+// (see SoAStorage), used by appendBatch() to skip per-sample push_back.
+template <typename T, typename X, typename Y, typename = void>
+struct HasBulkAppend : std::false_type
+{
+};
+
+template <typename T, typename X, typename Y>
+struct HasBulkAppend<T, X, Y,
+                     std::void_t<decltype(std::declval<T&>().append(
+                         std::declval<const X*>(), std::declval<const Y*>(), size_t(0)))>>
+  : std::true_type
+{
+};
+
+// Detects storage backends with an opt-in compressed timestamp
+// representation (see SoAStorage::compressTimestamps).
+template <typename T, typename = void>
+struct HasTimeCompression : std::false_type
+{
+};
+
+template <typename T>
+struct HasTimeCompression<T, std::void_t<decltype(std::declval<T&>().compressTimestamps())>>
+  : std::true_type
+{
+};
+
+// Detects storage backends with an in-RAM compressed tier for cold
+// chunks (see SoAStorage::compressColdChunks).
+template <typename T, typename = void>
+struct HasColdCompression : std::false_type
+{
+};
+
+template <typename T>
+struct HasColdCompression<T, std::void_t<decltype(std::declval<T&>().compressColdChunks(size_t(0)))>>
+  : std::true_type
+{
+};
+
+// Detects storage backends with a disk-spill tier for cold chunks
+// (see SoAStorage::spillColdChunks).
+template <typename T, typename = void>
+struct HasDiskSpill : std::false_type
+{
+};
+
+template <typename T>
+struct HasDiskSpill<T, std::void_t<decltype(std::declval<T&>().spillColdChunks(size_t(0)))>>
+  : std::true_type
+{
+};
+
 struct Range
 {
   double min = std::numeric_limits<double>::lowest();
@@ -35,6 +107,38 @@ const auto SkipEmptyParts = QString::SkipEmptyParts;
 
 typedef std::optional<Range> RangeOpt;
 
+/**
+ * @brief Heap footprint of one series, split by what the bytes are used
+ * for (see PlotDataBase::memoryFootprint). All values are estimates
+ * computed from container sizes, not from the allocator: close enough to
+ * rank series and plan capacity, without walking the heap.
+ */
+struct MemoryFootprint
+{
+  /// Samples resident on the heap (x/y payload).
+  size_t sample_bytes = 0;
+  /// Caches and bookkeeping: monotonic min/max deques.
+  size_t overhead_bytes = 0;
+  /// Interned string storage (string series only).
+  size_t dictionary_bytes = 0;
+  /// Samples moved to the spill file: on disk, not on the heap.
+  size_t spilled_bytes = 0;
+
+  size_t heapTotal() const
+  {
+    return sample_bytes + overhead_bytes + dictionary_bytes;
+  }
+
+  MemoryFootprint& operator+=(const MemoryFootprint& other)
+  {
+    sample_bytes += other.sample_bytes;
+    overhead_bytes += other.overhead_bytes;
+    dictionary_bytes += other.dictionary_bytes;
+    spilled_bytes += other.spilled_bytes;
+    return *this;
+  }
+};
+
 // Attributes supported by the GUI.
 enum PlotAttribute
 {
@@ -55,7 +159,122 @@ enum PlotAttribute
   COLOR_HINT
 };
 
-using Attributes = std::unordered_map<PlotAttribute, QVariant>;
+/**
+ * @brief Container for the per-series / per-group attributes above.
+ *
+ * The enum has exactly four members, so the values live in four inline
+ * slots instead of an unordered_map: an invalid QVariant means "not set".
+ * Every series carries one of these, and most of them stay empty; with
+ * hundreds of thousands of series the empty-map overhead and the one heap
+ * node per entry added up, and reading an attribute during a curve list
+ * repaint chased pointers for nothing. Enough of the map interface is
+ * kept (operator[], value(), empty(), iteration as {key, value} pairs)
+ * that call sites did not have to change.
+ */
+class Attributes
+{
+public:
+  static constexpr size_t CAPACITY = size_t(COLOR_HINT) + 1;
+
+  QVariant& operator[](PlotAttribute id)
+  {
+    return _slots[size_t(id)];
+  }
+
+  /// The attribute, or an invalid QVariant if it was never set.
+  const QVariant& value(PlotAttribute id) const
+  {
+    return _slots[size_t(id)];
+  }
+
+  bool empty() const
+  {
+    for (const auto& slot : _slots)
+    {
+      if (slot.isValid())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t size() const
+  {
+    size_t count = 0;
+    for (const auto& slot : _slots)
+    {
+      count += slot.isValid() ? 1 : 0;
+    }
+    return count;
+  }
+
+  void clear()
+  {
+    for (auto& slot : _slots)
+    {
+      slot = QVariant();
+    }
+  }
+
+  /// Iterates the slots that are set, dereferencing to a
+  /// {PlotAttribute, const QVariant&} pair like the old map did.
+  class const_iterator
+  {
+  public:
+    const_iterator(const QVariant* slots, size_t index) : _slots(slots), _index(index)
+    {
+      skipUnset();
+    }
+
+    std::pair<PlotAttribute, const QVariant&> operator*() const
+    {
+      return { PlotAttribute(_index), _slots[_index] };
+    }
+
+    const_iterator& operator++()
+    {
+      ++_index;
+      skipUnset();
+      return *this;
+    }
+
+    bool operator==(const const_iterator& other) const
+    {
+      return _index == other._index;
+    }
+
+    bool operator!=(const const_iterator& other) const
+    {
+      return _index != other._index;
+    }
+
+  private:
+    void skipUnset()
+    {
+      while (_index < CAPACITY && !_slots[_index].isValid())
+      {
+        ++_index;
+      }
+    }
+
+    const QVariant* _slots;
+    size_t _index;
+  };
+
+  const_iterator begin() const
+  {
+    return const_iterator(_slots.data(), 0);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(_slots.data(), CAPACITY);
+  }
+
+private:
+  std::array<QVariant, CAPACITY> _slots;
+};
 
 inline bool CheckType(PlotAttribute attr, const QVariant& value)
 {
@@ -108,8 +327,7 @@ public:
 
   QVariant attribute(const PlotAttribute& id) const
   {
-    auto it = _attributes.find(id);
-    return (it == _attributes.end()) ? QVariant() : it->second;
+    return _attributes.value(id);
   }
 
 private:
@@ -117,21 +335,31 @@ private:
   Attributes _attributes;
 };
 
-// A Generic series of points
+// A single sample of a series. Kept outside PlotDataBase so that
+// alternative storage backends can be parametrized on it.
 template <typename TypeX, typename Value>
-class PlotDataBase
+class PlotPoint
 {
 public:
-  class Point
+  TypeX x;
+  Value y;
+  PlotPoint(TypeX _x, Value _y) : x(_x), y(_y)
   {
-  public:
-    TypeX x;
-    Value y;
-    Point(TypeX _x, Value _y) : x(_x), y(_y)
-    {
-    }
-    Point() = default;
-  };
+  }
+  PlotPoint() = default;
+};
+
+// A Generic series of points.
+// The Storage template parameter selects the memory layout of the samples:
+// the default std::deque keeps x/y interleaved (array-of-structures), while
+// SoAStorage (soa_storage.h) keeps them in separate contiguous chunks.
+template <typename TypeX, typename Value,
+          typename Storage = std::deque<PlotPoint<TypeX, Value>,
+                                        PoolAllocator<PlotPoint<TypeX, Value>>>>
+class PlotDataBase
+{
+public:
+  using Point = PlotPoint<TypeX, Value>;
 
   enum
   {
@@ -139,12 +367,18 @@ public:
     ASYNC_BUFFER_CAPACITY = 1024
   };
 
-  typedef typename std::deque<Point>::iterator Iterator;
-  typedef typename std::deque<Point>::const_iterator ConstIterator;
+  typedef typename Storage::iterator Iterator;
+  typedef typename Storage::const_iterator ConstIterator;
+  // Reference may be a proxy object when the backend is not array-of-structures
+  typedef typename Storage::reference Reference;
+  typedef typename Storage::const_reference ConstReference;
   typedef Value ValueT;
 
   PlotDataBase(const std::string& name, PlotGroup::Ptr group)
-    : _name(name), _range_x_dirty(true), _range_y_dirty(true), _group(group)
+    : _name(&StringInterner::instance().intern(name))
+    , _range_x_dirty(true)
+    , _range_y_dirty(true)
+    , _group(group)
   {
   }
 
@@ -161,6 +395,9 @@ public:
     _range_y = other._range_y;
     _range_x_dirty = other._range_x_dirty;
     _range_y_dirty = other._range_y_dirty;
+    _mono_min_y = other._mono_min_y;
+    _mono_max_y = other._mono_max_y;
+    _mono_y_valid = other._mono_y_valid;
   }
 
   void clonePoints(PlotDataBase&& other)
@@ -170,6 +407,9 @@ public:
     _range_y = other._range_y;
     _range_x_dirty = other._range_x_dirty;
     _range_y_dirty = other._range_y_dirty;
+    _mono_min_y = std::move(other._mono_min_y);
+    _mono_max_y = std::move(other._mono_max_y);
+    _mono_y_valid = other._mono_y_valid;
   }
 
   /// Swap only the data (points and cached ranges), leaving name, group,
@@ -181,13 +421,23 @@ public:
     std::swap(_range_y, other._range_y);
     std::swap(_range_x_dirty, other._range_x_dirty);
     std::swap(_range_y_dirty, other._range_y_dirty);
+    std::swap(_mono_min_y, other._mono_min_y);
+    std::swap(_mono_max_y, other._mono_max_y);
+    std::swap(_mono_y_valid, other._mono_y_valid);
   }
 
   virtual ~PlotDataBase() = default;
 
   const std::string& plotName() const
   {
-    return _name;
+    return *_name;
+  }
+
+  /// Used when a series is re-keyed in its map (e.g. by AddPrefixToPlotData):
+  /// the stored name must follow the key.
+  void setPlotName(const std::string& name)
+  {
+    _name = &StringInterner::instance().intern(name);
   }
 
   const PlotGroup::Ptr& group() const
@@ -210,22 +460,22 @@ public:
     return false;
   }
 
-  const Point& at(size_t index) const
+  ConstReference at(size_t index) const
   {
     return _points[index];
   }
 
-  Point& at(size_t index)
+  Reference at(size_t index)
   {
     return _points[index];
   }
 
-  const Point& operator[](size_t index) const
+  ConstReference operator[](size_t index) const
   {
     return at(index);
   }
 
-  Point& operator[](size_t index)
+  Reference operator[](size_t index)
   {
     return at(index);
   }
@@ -235,6 +485,9 @@ public:
     _points.clear();
     _range_x_dirty = true;
     _range_y_dirty = true;
+    _mono_min_y.clear();
+    _mono_max_y.clear();
+    _mono_y_valid = true;
   }
 
   const Attributes& attributes() const
@@ -258,16 +511,15 @@ public:
 
   QVariant attribute(PlotAttribute id) const
   {
-    auto it = _attributes.find(id);
-    return (it == _attributes.end()) ? QVariant() : it->second;
+    return _attributes.value(id);
   }
 
-  const Point& front() const
+  ConstReference front() const
   {
     return _points.front();
   }
 
-  const Point& back() const
+  ConstReference back() const
   {
     return _points.back();
   }
@@ -303,12 +555,25 @@ public:
       }
       if (_range_x_dirty)
       {
-        _range_x.min = front().x;
-        _range_x.max = _range_x.min;
-        for (const auto& p : _points)
+        if constexpr (HasChunkAccess<Storage>::value && std::is_same_v<TypeX, double>)
+        {
+          MinMax mm;
+          for (size_t c = 0; c < _points.chunkCount(); c++)
+          {
+            Merge(mm, MinMaxOfArray(_points.chunkDataX(c), _points.chunkSize(c)));
+          }
+          _range_x.min = mm.min;
+          _range_x.max = mm.max;
+        }
+        else
         {
-          _range_x.min = std::min(_range_x.min, p.x);
-          _range_x.max = std::max(_range_x.max, p.x);
+          _range_x.min = front().x;
+          _range_x.max = _range_x.min;
+          for (const auto& p : _points)
+          {
+            _range_x.min = std::min(_range_x.min, p.x);
+            _range_x.max = std::max(_range_x.max, p.x);
+          }
         }
         _range_x_dirty = false;
       }
@@ -328,13 +593,27 @@ public:
       }
       if (_range_y_dirty)
       {
-        _range_y.min = front().y;
-        _range_y.max = _range_y.min;
-        for (const auto& p : _points)
+        if constexpr (HasChunkAccess<Storage>::value && std::is_same_v<Value, double>)
         {
-          _range_y.min = std::min(_range_y.min, p.y);
-          _range_y.max = std::max(_range_y.max, p.y);
+          MinMax mm;
+          for (size_t c = 0; c < _points.chunkCount(); c++)
+          {
+            Merge(mm, MinMaxOfArray(_points.chunkDataY(c), _points.chunkSize(c)));
+          }
+          _range_y.min = mm.min;
+          _range_y.max = mm.max;
         }
+        else
+        {
+          _range_y.min = front().y;
+          _range_y.max = _range_y.min;
+          for (const auto& p : _points)
+          {
+            _range_y.min = std::min(_range_y.min, p.y);
+            _range_y.max = std::max(_range_y.max, p.y);
+          }
+        }
+        rebuildMonotonicY();
         _range_y_dirty = false;
       }
       return _range_y;
@@ -370,6 +649,151 @@ public:
     _points.emplace_back(p);
   }
 
+  /// Append a batch of samples given as two parallel arrays.
+  /// Equivalent to calling pushBack() on every pair, but non-finite
+  /// samples are skipped run-wise and the cached ranges are updated once
+  /// per run of valid samples instead of once per point. No ordering of x
+  /// is assumed; timeseries should use TimeseriesBase::appendBatch().
+  void appendBatch(const TypeX* xs, const Value* ys, size_t count)
+  {
+    size_t i = 0;
+    while (i < count)
+    {
+      while (i < count && !sampleIsValid(xs[i], ys[i]))
+      {
+        i++;
+      }
+      const size_t run_begin = i;
+      while (i < count && sampleIsValid(xs[i], ys[i]))
+      {
+        i++;
+      }
+      if (i > run_begin)
+      {
+        appendFiniteRun(xs + run_begin, ys + run_begin, i - run_begin);
+      }
+    }
+  }
+
+  /// Copy `count` samples starting at index `first` into two contiguous
+  /// parallel arrays. Chunked backends (see SoAStorage) are walked one
+  /// chunk at a time at memory-bandwidth speed; the others fall back to
+  /// an element loop. Used by PlotDataMapRef::snapshotNumeric().
+  void extractSamples(size_t first, size_t count, TypeX* xs, Value* ys) const
+  {
+    if constexpr (HasChunkAccess<Storage>::value)
+    {
+      size_t chunk_first = 0;  // index of the first sample of chunk c
+      size_t written = 0;
+      for (size_t c = 0; c < _points.chunkCount() && written < count; c++)
+      {
+        const size_t len = _points.chunkSize(c);
+        if (chunk_first + len > first)
+        {
+          const size_t begin = std::max(first, chunk_first) - chunk_first;
+          const size_t take = std::min(len - begin, count - written);
+          const TypeX* cx = _points.chunkDataX(c);
+          const Value* cy = _points.chunkDataY(c);
+          std::copy(cx + begin, cx + begin + take, xs + written);
+          std::copy(cy + begin, cy + begin + take, ys + written);
+          written += take;
+        }
+        chunk_first += len;
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < count; i++)
+      {
+        const auto& p = _points[first + i];
+        xs[i] = p.x;
+        ys[i] = p.y;
+      }
+    }
+  }
+
+  /// Delta-compress the timestamps of the sealed storage chunks, when the
+  /// backend supports it (see SoAStorage::compressTimestamps). Lossless and
+  /// transparent to readers; quasi-regular series shrink by up to ~45%.
+  /// Returns the number of bytes saved (0 for backends without compression).
+  size_t compressTimestamps()
+  {
+    if constexpr (HasTimeCompression<Storage>::value)
+    {
+      return _points.compressTimestamps();
+    }
+    return 0;
+  }
+
+  /// Compress the oldest storage chunks in place, when the backend
+  /// supports it (see SoAStorage::compressColdChunks): lossless, still
+  /// resident in RAM and transparently decompressed on first access. The
+  /// newest keep_recent_points samples stay uncompressed.
+  /// Returns the number of heap bytes saved (0 for backends without it).
+  size_t compressColdPoints(size_t keep_recent_points)
+  {
+    if constexpr (HasColdCompression<Storage>::value)
+    {
+      const size_t chunks = 1 + keep_recent_points / Storage::CHUNK_SIZE;
+      return _points.compressColdChunks(chunks);
+    }
+    return 0;
+  }
+
+  /// Heap bytes currently saved by compressed storage chunks (always 0
+  /// for backends without compression).
+  size_t compressedSavedBytes() const
+  {
+    if constexpr (HasColdCompression<Storage>::value)
+    {
+      return _points.compressedSavedBytes();
+    }
+    return 0;
+  }
+
+  /// Move the oldest samples out of the heap into the shared spill file,
+  /// when the backend supports it (see SoAStorage::spillColdChunks). The
+  /// newest keep_recent_points samples stay resident; spilled samples
+  /// remain fully accessible and are paged back in on demand.
+  /// Returns the number of heap bytes moved (0 for backends without spill).
+  size_t spillColdPoints(size_t keep_recent_points)
+  {
+    if constexpr (HasDiskSpill<Storage>::value)
+    {
+      const size_t chunks = 1 + keep_recent_points / Storage::CHUNK_SIZE;
+      return _points.spillColdChunks(chunks);
+    }
+    return 0;
+  }
+
+  /// Number of samples currently living in the spill file instead of the
+  /// heap (always 0 for backends without spill).
+  size_t spilledPoints() const
+  {
+    if constexpr (HasDiskSpill<Storage>::value)
+    {
+      return _points.spilledCount();
+    }
+    return 0;
+  }
+
+  /// Estimated heap footprint of this series. Samples in compressed
+  /// chunks are counted at their compressed size, consistent with
+  /// PlotDataMapRef::memoryUsage(); subclasses with extra storage
+  /// (e.g. the string dictionary) override and add their share.
+  virtual MemoryFootprint memoryFootprint() const
+  {
+    MemoryFootprint footprint;
+    const size_t spilled = spilledPoints();
+    const size_t resident = (size() - spilled) * sizeof(Point);
+    const size_t saved = compressedSavedBytes();
+    footprint.sample_bytes = resident - std::min(saved, resident);
+    footprint.spilled_bytes = spilled * sizeof(Point);
+    // attributes live inline in the series object, no heap share to add
+    footprint.overhead_bytes = (_mono_min_y.size() + _mono_max_y.size()) * sizeof(Value);
+    return footprint;
+  }
+
   virtual void insert(Iterator it, Point&& p)
   {
     if constexpr (std::is_arithmetic_v<TypeX>)
@@ -390,6 +814,15 @@ public:
     }
 
     _points.insert(it, p);
+
+    // a middle insertion breaks the append-order invariant of the
+    // monotonic deques; they are rebuilt lazily by the next rangeY()
+    if constexpr (std::is_arithmetic_v<Value>)
+    {
+      _mono_min_y.clear();
+      _mono_max_y.clear();
+      _mono_y_valid = false;
+    }
   }
 
   virtual void popFront()
@@ -406,7 +839,25 @@ public:
 
     if constexpr (std::is_arithmetic_v<Value>)
     {
-      if (!_range_y_dirty && (p.y == _range_y.max || p.y == _range_y.min))
+      if (_mono_y_valid)
+      {
+        // sliding-window repair: the evicted sample can only be at the
+        // front of the monotonic deques
+        if (!_mono_max_y.empty() && p.y == _mono_max_y.front())
+        {
+          _mono_max_y.pop_front();
+        }
+        if (!_mono_min_y.empty() && p.y == _mono_min_y.front())
+        {
+          _mono_min_y.pop_front();
+        }
+        if (!_range_y_dirty && !_mono_max_y.empty() && !_mono_min_y.empty())
+        {
+          _range_y.max = _mono_max_y.front();
+          _range_y.min = _mono_min_y.front();
+        }
+      }
+      else if (!_range_y_dirty && (p.y == _range_y.max || p.y == _range_y.min))
       {
         _range_y_dirty = true;
       }
@@ -415,9 +866,10 @@ public:
   }
 
 protected:
-  std::string _name;
+  // points into the process-wide StringInterner: names are shared, not copied
+  const std::string* _name;
   Attributes _attributes;
-  std::deque<Point> _points;
+  Storage _points;
 
   mutable Range _range_x;
   mutable Range _range_y;
@@ -425,8 +877,145 @@ protected:
   mutable bool _range_y_dirty;
   mutable std::shared_ptr<PlotGroup> _group;
 
-  // template specialization for types that support compare operator
-  virtual void pushUpdateRangeX(const Point& p)
+  // Sliding-window extrema of y, kept in append order: the front of each
+  // deque is the current min/max of the whole series, so popFront() can
+  // repair the range in O(1) amortized instead of forcing a full rescan.
+  // Invalidated by middle insertions, rebuilt by the next rangeY().
+  mutable std::deque<Value> _mono_min_y;
+  mutable std::deque<Value> _mono_max_y;
+  mutable bool _mono_y_valid = true;
+
+  // Same filter applied by pushBack(): non-finite coordinates are skipped
+  static bool sampleIsValid(const TypeX& x, const Value& y)
+  {
+    bool valid = true;
+    if constexpr (std::is_arithmetic_v<TypeX>)
+    {
+      valid = valid && std::isfinite(double(x));
+    }
+    if constexpr (std::is_arithmetic_v<Value>)
+    {
+      valid = valid && std::isfinite(double(y));
+    }
+    return valid;
+  }
+
+  // Append a run of samples known to be finite, updating the cached
+  // ranges with one (vectorized, when double) min/max pass per
+  // coordinate and the storage with one bulk insert when the backend
+  // supports it.
+  void appendFiniteRun(const TypeX* xs, const Value* ys, size_t count)
+  {
+    if constexpr (std::is_arithmetic_v<TypeX>)
+    {
+      if (_points.empty())
+      {
+        _range_x_dirty = false;
+        _range_x.min = xs[0];
+        _range_x.max = xs[0];
+      }
+      if (!_range_x_dirty)
+      {
+        if constexpr (std::is_same_v<TypeX, double>)
+        {
+          const MinMax mm = MinMaxOfArray(xs, count);
+          _range_x.min = std::min(_range_x.min, mm.min);
+          _range_x.max = std::max(_range_x.max, mm.max);
+        }
+        else
+        {
+          for (size_t i = 0; i < count; i++)
+          {
+            _range_x.min = std::min(_range_x.min, double(xs[i]));
+            _range_x.max = std::max(_range_x.max, double(xs[i]));
+          }
+        }
+      }
+    }
+    if constexpr (std::is_arithmetic_v<Value>)
+    {
+      if (_points.empty())
+      {
+        _range_y_dirty = false;
+        _range_y.min = ys[0];
+        _range_y.max = ys[0];
+      }
+      if (!_range_y_dirty)
+      {
+        if constexpr (std::is_same_v<Value, double>)
+        {
+          const MinMax mm = MinMaxOfArray(ys, count);
+          _range_y.min = std::min(_range_y.min, mm.min);
+          _range_y.max = std::max(_range_y.max, mm.max);
+        }
+        else
+        {
+          for (size_t i = 0; i < count; i++)
+          {
+            _range_y.min = std::min(_range_y.min, double(ys[i]));
+            _range_y.max = std::max(_range_y.max, double(ys[i]));
+          }
+        }
+      }
+      if (_mono_y_valid)
+      {
+        // inherently sequential: same update as pushUpdateRangeY()
+        for (size_t i = 0; i < count; i++)
+        {
+          while (!_mono_max_y.empty() && _mono_max_y.back() < ys[i])
+          {
+            _mono_max_y.pop_back();
+          }
+          _mono_max_y.push_back(ys[i]);
+          while (!_mono_min_y.empty() && _mono_min_y.back() > ys[i])
+          {
+            _mono_min_y.pop_back();
+          }
+          _mono_min_y.push_back(ys[i]);
+        }
+      }
+    }
+
+    if constexpr (HasBulkAppend<Storage, TypeX, Value>::value)
+    {
+      _points.append(xs, ys, count);
+    }
+    else
+    {
+      for (size_t i = 0; i < count; i++)
+      {
+        _points.emplace_back(Point(xs[i], ys[i]));
+      }
+    }
+  }
+
+  // Rebuild the eviction deques with a single pass over the samples
+  void rebuildMonotonicY() const
+  {
+    _mono_min_y.clear();
+    _mono_max_y.clear();
+    for (const auto& p : _points)
+    {
+      while (!_mono_max_y.empty() && _mono_max_y.back() < p.y)
+      {
+        _mono_max_y.pop_back();
+      }
+      _mono_max_y.push_back(p.y);
+      while (!_mono_min_y.empty() && _mono_min_y.back() > p.y)
+      {
+        _mono_min_y.pop_back();
+      }
+      _mono_min_y.push_back(p.y);
+    }
+    _mono_y_valid = true;
+  }
+
+  // template specialization for types that support compare operator.
+  // Appending a sample can only extend the range, so no dirty flag is set
+  // here: a full rescan happens only when an extremum is evicted.
+  // Deliberately non-virtual: this runs once per appended sample and must
+  // inline into pushBack().
+  void pushUpdateRangeX(const Point& p)
   {
     if constexpr (std::is_arithmetic_v<TypeX>)
     {
@@ -446,19 +1035,22 @@ protected:
         {
           _range_x.min = p.x;
         }
-        else
-        {
-          _range_x_dirty = true;
-        }
       }
     }
   }
 
-  // template specialization for types that support compare operator
-  virtual void pushUpdateRangeY(const Point& p)
+  // template specialization for types that support compare operator.
+  // Non-virtual for the same reason as pushUpdateRangeX().
+  void pushUpdateRangeY(const Point& p)
   {
     if constexpr (std::is_arithmetic_v<Value>)
     {
+      if (_points.empty())
+      {
+        _range_y_dirty = false;
+        _range_y.min = p.y;
+        _range_y.max = p.y;
+      }
       if (!_range_y_dirty)
       {
         if (p.y > _range_y.max)
@@ -469,10 +1061,19 @@ protected:
         {
           _range_y.min = p.y;
         }
-        else
+      }
+      if (_mono_y_valid)
+      {
+        while (!_mono_max_y.empty() && _mono_max_y.back() < p.y)
+        {
+          _mono_max_y.pop_back();
+        }
+        _mono_max_y.push_back(p.y);
+        while (!_mono_min_y.empty() && _mono_min_y.back() > p.y)
         {
-          _range_y_dirty = true;
+          _mono_min_y.pop_back();
         }
+        _mono_min_y.push_back(p.y);
       }
     }
   }
@@ -130,6 +130,38 @@ public:
 
   void setLineWidth(LineWidth width);
 
+  /**
+   * @brief Enable the oscilloscope-style paint path used while streaming.
+   *
+   * When enabled, a replot whose only effect is a horizontal shift of the
+   * time window (same vertical range, same span, same canvas size) scrolls
+   * the canvas backing store sideways and repaints just the newly exposed
+   * strip of each curve, instead of redrawing every visible point. Any
+   * other change - zoom, pan, resize, log scale, XY mode - falls back to a
+   * full replot. Only effective with the raster canvas; the OpenGL canvas
+   * has no backing store to blit.
+   *
+   * The caller must enable it only while the data is append-only (follow
+   * mode): samples rewritten in place would leave stale pixels on screen
+   * until they scroll out.
+   */
+  void setScrollBlitEnabled(bool enabled);
+
+  /**
+   * @brief Toggle the min/max envelope display mode.
+   *
+   * When enabled, timeseries curves whose visible samples far outnumber
+   * the pixel columns are painted as a translucent band spanning the
+   * per-column min/max, with the per-column mean line on top. Unlike a
+   * decimated line, the band cannot hide short excursions such as spikes,
+   * and it is computed from the block summary index in O(columns * log n)
+   * rather than by scanning every visible sample. Curves with few visible
+   * samples, and XY curves, keep their configured style.
+   */
+  void setEnvelopeEnabled(bool enabled);
+
+  bool isEnvelopeEnabled() const;
+
   LineWidth lineWidth() const
   {
     return _line_width;
@@ -173,9 +205,24 @@ protected:
 
   void updateMaximumZoomArea();
 
+  /**
+   * QwtPlot::setAxisScale unconditionally invalidates the scale division,
+   * so the next replot recomputes the ticks and lays out their labels even
+   * when the bounds did not move. This wrapper compares against the current
+   * division first: steady-state streaming replots, where only new samples
+   * arrived within the same range, then reuse the cached QwtScaleDiv and
+   * Qwt's tick label cache untouched. The bounds are compared exactly as
+   * passed, so flipped axes (min > max) work the same way.
+   */
+  void setAxisScaleIfChanged(int axisId, double min, double max);
+
   bool eventFilter(QObject* obj, QEvent* event);
 
 private:
+  /// Rebuild or hide the band and mean line of each curve, according to
+  /// the current zoom. Called by replot().
+  void updateEnvelopes(int num_pixel_columns);
+
   bool _xy_mode;
 
   QRectF _max_zoom_rect;
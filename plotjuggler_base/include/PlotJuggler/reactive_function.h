@@ -9,6 +9,9 @@
 
 #include "PlotJuggler/transform_function.h"
 #include <sol/sol.hpp>
+#include <unordered_set>
+
+class QThread;
 
 class TimeseriesRef;
 class CreatedSeriesBase;
@@ -31,6 +34,10 @@ struct TimeseriesRef
 
   void clear() const;
 
+  /** Indices [first, last) of the samples with t0 <= x <= t1, found by
+   * binary search. Used by the bulk accessors bound in prepareLua(). */
+  std::pair<size_t, size_t> rangeIndices(double t0, double t1) const;
+
   PJ::PlotData* _plot_data = nullptr;
 };
 
@@ -88,8 +95,31 @@ public:
 
   void setTimeTracker(double time_tracker_value);
 
+  /** Execute the script. Does not touch the main PlotDataMapRef, so it may
+   * run on a worker thread, between snapshotInputs() and publishOutputs().
+   * Errors are stored in lastError() instead of being thrown. */
   void calculate() override;
 
+  /** Refresh the private mirror of the series read by the script.
+   * Must be called on the main thread, while calculate() is not running. */
+  void snapshotInputs();
+
+  /** Copy the series created by the script into the main PlotDataMapRef.
+   * Must be called on the main thread, after calculate() completed. */
+  void publishOutputs();
+
+  /** Duration of the last calculate() call, in milliseconds. */
+  double lastExecutionMs() const
+  {
+    return _last_execution_ms;
+  }
+
+  /** Error raised by the last calculate() call, or an empty string. */
+  const std::string& lastError() const
+  {
+    return _last_error;
+  }
+
   const std::vector<std::string>& createdCurves() const
   {
     return _created_curves;
@@ -119,6 +149,18 @@ protected:
 
   std::vector<std::string> _created_curves;
 
+  // The script only ever touches _local_data: a mirror of the series it
+  // reads, refreshed by snapshotInputs(), plus the series it creates, copied
+  // back by publishOutputs(). This keeps calculate() safe on a worker thread
+  // while the GUI keeps mutating the main PlotDataMapRef.
+  PlotDataMapRef* _main_data = nullptr;
+  PlotDataMapRef _local_data;
+  std::unordered_set<std::string> _accessed_inputs;
+  std::vector<std::string> _series_names;
+  QThread* _owner_thread = nullptr;
+  double _last_execution_ms = 0;
+  std::string _last_error;
+
   sol::state _lua_engine;
   sol::protected_function _lua_function;
 
@@ -128,6 +170,8 @@ protected:
 
 private:
   void init();
+
+  void mirrorInput(const std::string& name);
 };
 
 }  // namespace PJ
@@ -10,8 +10,10 @@
 #include <qwt_plot.h>
 #include <qwt_plot_renderer.h>
 
+#include <QColor>
 #include <QPaintDevice>
 #include <QPainter>
+#include <QPicture>
 #include <QRect>
 #include <QSettings>
 #include <QSize>
@@ -19,6 +21,7 @@
 #include <QWidget>
 
 #include <memory>
+#include <vector>
 
 const static QSize default_document_dimentions{ 1920, 1200 };
 
@@ -33,20 +36,48 @@ inline auto plotSize()
   return result;
 }
 
+/**
+ * Helper used to export one or more plots to an image file.
+ *
+ * For raster formats (png/jpg), paint() only records the Qwt paint commands
+ * into a per-plot QPicture; rasterization at the export resolution and the
+ * image encoding — the expensive, resolution-dependent part — happen on the
+ * QtConcurrent pool after the helper is destroyed, with one parallel job per
+ * plot. The GUI thread is blocked only for the recording.
+ *
+ * SVG output is vector-based and cheap, so it keeps the direct synchronous
+ * path through QSvgGenerator.
+ */
 class PlotSaveHelper
 {
 public:
   PlotSaveHelper(QSize dims, QWidget* parent);
   ~PlotSaveHelper();
 
-  void paint(QwtPlot* plot, QRect paint_at) const;
-  void paintTitle(const QString& title, QRectF paint_at, QWidget* parent) const;
+  void paint(QwtPlot* plot, QRect paint_at);
+  void paintTitle(const QString& title, QRectF paint_at, QWidget* parent);
 
 private:
+  struct RecordedPlot
+  {
+    QPicture picture;
+    QRect rect;
+  };
+
   std::unique_ptr<QwtPlotRenderer> _renderer;
+  // direct paint device, used only for the synchronous (svg) path
   std::unique_ptr<QPaintDevice> _paint_device;
   std::unique_ptr<QPainter> _painter;
+
+  // recorded commands for the asynchronous (raster) path
+  std::vector<RecordedPlot> _recorded_plots;
+  QPicture _overlay_picture;
+  std::unique_ptr<QPainter> _overlay_painter;
+
   QString _save_filename;
+  QSize _dims;
+  QColor _background;
+  bool _raster = false;
 };
 
 #endif  // PJ_SAVE_PLOT_H
@@ -0,0 +1,35 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_SESSION_DUMP_H
+#define PJ_SESSION_DUMP_H
+
+#include <QString>
+#include "PlotJuggler/plotdata.h"
+
+namespace PJ
+{
+/**
+ * Native binary snapshot of a PlotDataMapRef (".pjdata").
+ *
+ * The file is columnar and restore-oriented: a name table up front,
+ * then the x / y arrays of each numeric series stored contiguously and
+ * 8-byte aligned, and string series as their dictionary plus (x, index)
+ * columns. Loading maps the file and feeds the arrays straight into
+ * appendBatch(), so restoring a session costs a memcpy instead of
+ * re-parsing the original CSV / MCAP.
+ *
+ * The byte order is the native one: the format is a local cache, not an
+ * interchange format.
+ */
+
+bool SaveSessionDump(const PlotDataMapRef& data, const QString& filepath);
+
+bool LoadSessionDump(const QString& filepath, PlotDataMapRef& destination);
+
+}  // namespace PJ
+
+#endif  // PJ_SESSION_DUMP_H
@@ -0,0 +1,957 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_SOA_STORAGE_H
+#define PJ_SOA_STORAGE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "util/block_pool.hpp"
+#include "util/spill_file.hpp"
+
+namespace PJ
+{
+/**
+ * @brief Chunked structure-of-arrays backend for PlotDataBase.
+ *
+ * Samples are stored in fixed-size chunks, each holding two separate
+ * contiguous arrays for x and y. Range scans (min/max, downsampling,
+ * bounding rect) touch only the coordinate they need, streaming through
+ * memory at full bandwidth instead of striding over interleaved pairs.
+ *
+ * The interface mirrors the subset of std::deque<Point> used by
+ * PlotDataBase / TimeseriesBase: random access, push_back, pop_front,
+ * insert and sortable random-access iterators. Since x and y live in
+ * different arrays, dereferencing an iterator returns a proxy reference
+ * (PointRef) instead of Point&; the proxy exposes the same .x / .y
+ * members and converts implicitly to Point.
+ *
+ * Timestamps of quasi-regular series can optionally be delta-compressed
+ * per chunk with compressTimestamps(): a sealed chunk replaces its x
+ * array with a base delta plus one 16-bit offset per sample (and an
+ * exceptions list for the samples that do not fit), shrinking x from 8
+ * to ~2 bytes per sample without losing a single bit. Compressed chunks
+ * are transparently re-materialized the first time they are accessed
+ * again, so hot chunks pay the decompression once and cold history stays
+ * compressed. Materialization mutates the chunk: do not call
+ * compressTimestamps() on a storage shared between threads.
+ *
+ * compressColdChunks() adds a middle tier between fully-resident and
+ * disk-spilled: the oldest sealed chunks are compressed in place, in RAM.
+ * Timestamps use the delta encoding above; the y values are split into
+ * byte planes (plane p holds byte p of every sample) and each plane is
+ * run-length encoded when repetitive. For smooth telemetry the sign,
+ * exponent and high mantissa bytes barely change between neighbouring
+ * samples, so typical series shrink several-fold while staying bitwise
+ * intact; chunks that do not compress are left untouched. Access goes
+ * through the same transparent re-materialization as compressed
+ * timestamps.
+ *
+ * Independently of compression, spillColdChunks() can move the payload of
+ * cold sealed chunks out of the heap into a shared temp file (see
+ * SpillFile). A spilled chunk stays fully readable and writable through a
+ * MAP_SHARED mapping of its slot: the kernel pages the data in and out on
+ * demand, so a series larger than RAM degrades to disk speed instead of
+ * failing. Readers that only touch whole-block summaries (MinMaxIndex,
+ * SummaryIndex) keep their own resident levels and never fault spilled
+ * pages in.
+ */
+template <typename Point>
+class SoAStorage
+{
+public:
+  using TypeX = decltype(Point::x);
+  using TypeY = decltype(Point::y);
+
+  // 4096 doubles per coordinate = 32 KiB per array, L1/L2 friendly
+  static constexpr size_t CHUNK_SIZE = 4096;
+
+  struct ConstPointRef
+  {
+    const TypeX& x;
+    const TypeY& y;
+
+    operator Point() const
+    {
+      return Point(x, y);
+    }
+  };
+
+  struct PointRef
+  {
+    TypeX& x;
+    TypeY& y;
+
+    operator Point() const
+    {
+      return Point(x, y);
+    }
+
+    operator ConstPointRef() const
+    {
+      return { x, y };
+    }
+
+    PointRef& operator=(const Point& p)
+    {
+      x = p.x;
+      y = p.y;
+      return *this;
+    }
+
+    PointRef& operator=(Point&& p)
+    {
+      x = std::move(p.x);
+      y = std::move(p.y);
+      return *this;
+    }
+
+    PointRef& operator=(const PointRef& other)
+    {
+      x = other.x;
+      y = other.y;
+      return *this;
+    }
+
+    // taken by value: iter_swap passes temporary proxies
+    friend void swap(PointRef a, PointRef b)
+    {
+      Point tmp = a;
+      a = Point(b);
+      b = std::move(tmp);
+    }
+  };
+
+  template <bool IsConst>
+  class IteratorImpl
+  {
+    using StoragePtr = std::conditional_t<IsConst, const SoAStorage*, SoAStorage*>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Point;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<IsConst, ConstPointRef, PointRef>;
+    using pointer = void;
+
+    IteratorImpl() = default;
+
+    IteratorImpl(StoragePtr storage, size_t index) : _storage(storage), _index(index)
+    {
+    }
+
+    // implicit iterator -> const_iterator conversion
+    template <bool WasConst, typename = std::enable_if_t<IsConst && !WasConst>>
+    IteratorImpl(const IteratorImpl<WasConst>& other)
+      : _storage(other.storage()), _index(other.index())
+    {
+    }
+
+    reference operator*() const
+    {
+      return (*_storage)[_index];
+    }
+
+    reference operator[](difference_type n) const
+    {
+      return (*_storage)[_index + n];
+    }
+
+    IteratorImpl& operator++()
+    {
+      ++_index;
+      return *this;
+    }
+
+    IteratorImpl operator++(int)
+    {
+      auto tmp = *this;
+      ++_index;
+      return tmp;
+    }
+
+    IteratorImpl& operator--()
+    {
+      --_index;
+      return *this;
+    }
+
+    IteratorImpl operator--(int)
+    {
+      auto tmp = *this;
+      --_index;
+      return tmp;
+    }
+
+    IteratorImpl& operator+=(difference_type n)
+    {
+      _index += n;
+      return *this;
+    }
+
+    IteratorImpl& operator-=(difference_type n)
+    {
+      _index -= n;
+      return *this;
+    }
+
+    friend IteratorImpl operator+(IteratorImpl it, difference_type n)
+    {
+      it += n;
+      return it;
+    }
+
+    friend IteratorImpl operator+(difference_type n, IteratorImpl it)
+    {
+      it += n;
+      return it;
+    }
+
+    friend IteratorImpl operator-(IteratorImpl it, difference_type n)
+    {
+      it -= n;
+      return it;
+    }
+
+    friend difference_type operator-(const IteratorImpl& a, const IteratorImpl& b)
+    {
+      return difference_type(a._index) - difference_type(b._index);
+    }
+
+    friend bool operator==(const IteratorImpl& a, const IteratorImpl& b)
+    {
+      return a._index == b._index;
+    }
+
+    friend bool operator!=(const IteratorImpl& a, const IteratorImpl& b)
+    {
+      return a._index != b._index;
+    }
+
+    friend bool operator<(const IteratorImpl& a, const IteratorImpl& b)
+    {
+      return a._index < b._index;
+    }
+
+    friend bool operator>(const IteratorImpl& a, const IteratorImpl& b)
+    {
+      return a._index > b._index;
+    }
+
+    friend bool operator<=(const IteratorImpl& a, const IteratorImpl& b)
+    {
+      return a._index <= b._index;
+    }
+
+    friend bool operator>=(const IteratorImpl& a, const IteratorImpl& b)
+    {
+      return a._index >= b._index;
+    }
+
+    StoragePtr storage() const
+    {
+      return _storage;
+    }
+
+    size_t index() const
+    {
+      return _index;
+    }
+
+  private:
+    StoragePtr _storage = nullptr;
+    size_t _index = 0;
+  };
+
+  using value_type = Point;
+  using reference = PointRef;
+  using const_reference = ConstPointRef;
+  using iterator = IteratorImpl<false>;
+  using const_iterator = IteratorImpl<true>;
+
+  size_t size() const
+  {
+    return _size;
+  }
+
+  bool empty() const
+  {
+    return _size == 0;
+  }
+
+  void clear()
+  {
+    _chunks.clear();
+    _front_offset = 0;
+    _size = 0;
+  }
+
+  PointRef operator[](size_t index)
+  {
+    const size_t pos = _front_offset + index;
+    Chunk& chunk = _chunks[pos / CHUNK_SIZE];
+    if (chunk.spilled_x)
+    {
+      return { chunk.spilled_x[pos % CHUNK_SIZE], chunk.spilled_y[pos % CHUNK_SIZE] };
+    }
+    materializeX(chunk);
+    materializeY(chunk);
+    return { chunk.x[pos % CHUNK_SIZE], chunk.y[pos % CHUNK_SIZE] };
+  }
+
+  ConstPointRef operator[](size_t index) const
+  {
+    const size_t pos = _front_offset + index;
+    const Chunk& chunk = _chunks[pos / CHUNK_SIZE];
+    if (chunk.spilled_x)
+    {
+      return { chunk.spilled_x[pos % CHUNK_SIZE], chunk.spilled_y[pos % CHUNK_SIZE] };
+    }
+    materializeX(const_cast<Chunk&>(chunk));
+    materializeY(const_cast<Chunk&>(chunk));
+    return { chunk.x[pos % CHUNK_SIZE], chunk.y[pos % CHUNK_SIZE] };
+  }
+
+  PointRef front()
+  {
+    return (*this)[0];
+  }
+
+  ConstPointRef front() const
+  {
+    return (*this)[0];
+  }
+
+  PointRef back()
+  {
+    return (*this)[_size - 1];
+  }
+
+  ConstPointRef back() const
+  {
+    return (*this)[_size - 1];
+  }
+
+  void push_back(const Point& p)
+  {
+    Chunk& chunk = writableChunk();
+    chunk.x.push_back(p.x);
+    chunk.y.push_back(p.y);
+    _size++;
+  }
+
+  void push_back(Point&& p)
+  {
+    Chunk& chunk = writableChunk();
+    chunk.x.push_back(std::move(p.x));
+    chunk.y.push_back(std::move(p.y));
+    _size++;
+  }
+
+  template <typename... Args>
+  void emplace_back(Args&&... args)
+  {
+    push_back(Point(std::forward<Args>(args)...));
+  }
+
+  /// Bulk append from two contiguous arrays: each chunk is filled to
+  /// capacity with one ranged insert per coordinate, instead of a
+  /// push_back per sample.
+  void append(const TypeX* xs, const TypeY* ys, size_t count)
+  {
+    while (count > 0)
+    {
+      Chunk& chunk = writableChunk();
+      const size_t room = CHUNK_SIZE - chunk.x.size();
+      const size_t n = std::min(room, count);
+      chunk.x.insert(chunk.x.end(), xs, xs + n);
+      chunk.y.insert(chunk.y.end(), ys, ys + n);
+      xs += n;
+      ys += n;
+      count -= n;
+      _size += n;
+    }
+  }
+
+  void pop_front()
+  {
+    _front_offset++;
+    _size--;
+    if (_front_offset == chunkLength(_chunks.front()))
+    {
+      _chunks.pop_front();
+      _front_offset = 0;
+    }
+  }
+
+  /** Delta-compress the timestamps of every sealed (full) chunk: the 64-bit
+   * patterns of consecutive x values are encoded as a per-chunk base delta
+   * plus one 16-bit offset per sample, with an exceptions list holding the
+   * samples whose delta does not fit. This is bitwise lossless for any
+   * input; with quasi-regular sampling the x array shrinks from 8 to ~2
+   * bytes per sample. Chunks with too many exceptions (irregular sampling)
+   * are left untouched, as is the last chunk, which is still growing.
+   * Returns the number of bytes saved.
+   */
+  size_t compressTimestamps()
+  {
+    size_t saved = 0;
+    if constexpr (std::is_same_v<TypeX, double>)
+    {
+      std::vector<int64_t> deltas;
+      std::vector<int64_t> sorted;
+
+      for (size_t c = 0; c + 1 < _chunks.size(); c++)
+      {
+        compressChunkX(_chunks[c], deltas, sorted, saved);
+      }
+    }
+    return saved;
+  }
+
+  /** Compress cold sealed chunks in place, in RAM: timestamps with the
+   * delta encoding of compressTimestamps(), y values with per-byte-plane
+   * run-length encoding (see compressChunkY). The newest
+   * keep_resident_chunks chunks (the hot streaming tail) are left
+   * untouched, as are chunks that would not shrink by at least 1/8.
+   * Bitwise lossless; compressed chunks are transparently re-materialized
+   * on first access, so only the cold history pays the decompression and
+   * only when it is actually revisited. Like compressTimestamps(), this
+   * must not run on a storage shared between threads.
+   * Returns the number of heap bytes saved.
+   */
+  size_t compressColdChunks(size_t keep_resident_chunks = 2)
+  {
+    size_t saved = 0;
+    const size_t keep = std::max<size_t>(1, keep_resident_chunks);
+    std::vector<int64_t> deltas;
+    std::vector<int64_t> sorted;
+    std::vector<uint8_t> plane;
+    std::vector<uint8_t> encoded;
+    for (size_t c = 0; c + keep < _chunks.size(); c++)
+    {
+      Chunk& chunk = _chunks[c];
+      if (chunk.spilled_x)
+      {
+        continue;
+      }
+      if constexpr (std::is_same_v<TypeX, double>)
+      {
+        compressChunkX(chunk, deltas, sorted, saved);
+      }
+      compressChunkY(chunk, plane, encoded, saved);
+    }
+    return saved;
+  }
+
+  /// Estimated heap bytes currently saved by the compressed chunk
+  /// representations (timestamps and y values together).
+  size_t compressedSavedBytes() const
+  {
+    size_t saved = 0;
+    for (const Chunk& chunk : _chunks)
+    {
+      if (chunk.cx.count != 0)
+      {
+        const size_t raw = chunk.cx.count * sizeof(TypeX);
+        const size_t compressed = chunk.cx.offsets.capacity() * sizeof(uint16_t) +
+                                  chunk.cx.exceptions.capacity() * sizeof(chunk.cx.exceptions.front());
+        saved += (compressed < raw) ? raw - compressed : 0;
+      }
+      if (chunk.cy.count != 0)
+      {
+        const size_t raw = chunk.cy.count * sizeof(TypeY);
+        saved += (chunk.cy.bytes.capacity() < raw) ? raw - chunk.cy.bytes.capacity() : 0;
+      }
+    }
+    return saved;
+  }
+
+  /** Move the payload of cold sealed chunks out of the heap into the
+   * shared spill file, keeping the newest keep_resident_chunks chunks (the
+   * hot streaming tail) untouched. Spilled chunks stay fully accessible
+   * through a file mapping; the kernel pages them in and out on demand.
+   * Chunks with compressed timestamps are already small and are skipped.
+   * Returns the number of heap bytes moved to the file (0 on platforms
+   * without the spill tier, or for non-trivially-copyable samples).
+   */
+  size_t spillColdChunks(size_t keep_resident_chunks = 2)
+  {
+    size_t moved = 0;
+    if constexpr (std::is_trivially_copyable_v<TypeX> && std::is_trivially_copyable_v<TypeY>)
+    {
+      const size_t keep = std::max<size_t>(1, keep_resident_chunks);
+      for (size_t c = 0; c + keep < _chunks.size(); c++)
+      {
+        Chunk& chunk = _chunks[c];
+        if (chunk.spilled_x || chunk.cx.count != 0 || chunk.cy.count != 0 ||
+            chunk.x.size() != CHUNK_SIZE)
+        {
+          continue;  // compressed chunks are already small, keep them in RAM
+        }
+        void* slot = SpillFile::instance().store(chunk.x.data(), CHUNK_SIZE * sizeof(TypeX),
+                                                 chunk.y.data(), CHUNK_SIZE * sizeof(TypeY));
+        if (slot == nullptr)
+        {
+          break;  // spilling unavailable: keep everything resident
+        }
+        chunk.spilled_x = static_cast<TypeX*>(slot);
+        chunk.spilled_y =
+            reinterpret_cast<TypeY*>(static_cast<char*>(slot) + CHUNK_SIZE * sizeof(TypeX));
+        moved += chunk.x.capacity() * sizeof(TypeX) + chunk.y.capacity() * sizeof(TypeY);
+        chunk.x.clear();
+        chunk.x.shrink_to_fit();
+        chunk.y.clear();
+        chunk.y.shrink_to_fit();
+      }
+    }
+    return moved;
+  }
+
+  /// Samples currently living in the spill file instead of the heap.
+  size_t spilledCount() const
+  {
+    size_t count = 0;
+    for (size_t c = 0; c < _chunks.size(); c++)
+    {
+      if (_chunks[c].spilled_x)
+      {
+        count += chunkSize(c);
+      }
+    }
+    return count;
+  }
+
+  iterator insert(iterator it, const Point& p)
+  {
+    const size_t index = it.index();
+    push_back(p);
+    std::rotate(begin() + index, end() - 1, end());
+    return begin() + index;
+  }
+
+  iterator begin()
+  {
+    return iterator(this, 0);
+  }
+
+  iterator end()
+  {
+    return iterator(this, _size);
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(this, 0);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(this, _size);
+  }
+
+  //--- direct chunk access, used by vectorized kernels ---
+
+  size_t chunkCount() const
+  {
+    return _chunks.size();
+  }
+
+  /// Number of valid samples in a chunk, adjusted for the
+  /// consumed prefix of the first chunk.
+  size_t chunkSize(size_t chunk_index) const
+  {
+    return chunkLength(_chunks[chunk_index]) - (chunk_index == 0 ? _front_offset : 0);
+  }
+
+  const TypeX* chunkDataX(size_t chunk_index) const
+  {
+    const Chunk& chunk = _chunks[chunk_index];
+    const size_t skip = (chunk_index == 0) ? _front_offset : 0;
+    if (chunk.spilled_x)
+    {
+      return chunk.spilled_x + skip;
+    }
+    materializeX(const_cast<Chunk&>(chunk));
+    return chunk.x.data() + skip;
+  }
+
+  const TypeY* chunkDataY(size_t chunk_index) const
+  {
+    const Chunk& chunk = _chunks[chunk_index];
+    const size_t skip = (chunk_index == 0) ? _front_offset : 0;
+    if (chunk.spilled_y)
+    {
+      return chunk.spilled_y + skip;
+    }
+    materializeY(const_cast<Chunk&>(chunk));
+    return chunk.y.data() + skip;
+  }
+
+private:
+  // Compressed-time representation of a sealed chunk: the bit pattern of
+  // x[i] is the one of x[i-1] plus base_delta + offsets[i-1], except for
+  // the indices in the exceptions list, which store the full bit pattern.
+  // count == 0 means "not compressed" and the x array is authoritative.
+  struct CompressedX
+  {
+    uint64_t first = 0;
+    int64_t base_delta = 0;
+    uint32_t count = 0;
+    std::vector<uint16_t> offsets;
+    std::vector<std::pair<uint16_t, uint64_t>> exceptions;
+  };
+
+  // Compressed representation of the y array of a sealed chunk: one
+  // encoded byte plane after the other, each starting with a PLANE_RAW or
+  // PLANE_RLE tag (see compressChunkY / materializeY). count == 0 means
+  // "not compressed" and the y array is authoritative.
+  struct CompressedY
+  {
+    uint32_t count = 0;
+    std::vector<uint8_t> bytes;
+  };
+
+  enum : uint8_t
+  {
+    PLANE_RAW = 0,  // tag + count verbatim bytes
+    PLANE_RLE = 1   // tag + (length, value) pairs until count bytes
+  };
+
+  static constexpr size_t MAX_EXCEPTIONS = CHUNK_SIZE / 4;
+  static_assert(CHUNK_SIZE <= std::numeric_limits<uint16_t>::max(),
+                "delta offsets and exception indices are stored as uint16_t");
+
+  static uint64_t bitsOf(double value)
+  {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  static double valueOf(uint64_t bits)
+  {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  struct Chunk
+  {
+    // chunks have a fixed capacity, so they recycle through BlockPool
+    std::vector<TypeX, PoolAllocator<TypeX>> x;
+    std::vector<TypeY, PoolAllocator<TypeY>> y;
+    CompressedX cx;
+    CompressedY cy;
+    // non-null when the payload lives in the spill file: x then y, back to
+    // back, in one writable MAP_SHARED slot (see spillColdChunks)
+    TypeX* spilled_x = nullptr;
+    TypeY* spilled_y = nullptr;
+
+    Chunk() = default;
+
+    // copying a spilled chunk brings it back to the heap: the slot belongs
+    // to the original
+    Chunk(const Chunk& other) : x(other.x), y(other.y), cx(other.cx), cy(other.cy)
+    {
+      if (other.spilled_x)
+      {
+        x.assign(other.spilled_x, other.spilled_x + CHUNK_SIZE);
+        y.assign(other.spilled_y, other.spilled_y + CHUNK_SIZE);
+      }
+    }
+
+    Chunk(Chunk&& other) noexcept
+      : x(std::move(other.x))
+      , y(std::move(other.y))
+      , cx(std::move(other.cx))
+      , cy(std::move(other.cy))
+      , spilled_x(other.spilled_x)
+      , spilled_y(other.spilled_y)
+    {
+      other.spilled_x = nullptr;
+      other.spilled_y = nullptr;
+    }
+
+    Chunk& operator=(Chunk other) noexcept
+    {
+      std::swap(x, other.x);
+      std::swap(y, other.y);
+      std::swap(cx, other.cx);
+      std::swap(cy, other.cy);
+      std::swap(spilled_x, other.spilled_x);
+      std::swap(spilled_y, other.spilled_y);
+      return *this;
+    }
+
+    ~Chunk()
+    {
+      if (spilled_x)
+      {
+        SpillFile::instance().release(spilled_x);
+      }
+    }
+  };
+
+  static size_t chunkLength(const Chunk& chunk)
+  {
+    if (chunk.spilled_x)
+    {
+      return CHUNK_SIZE;
+    }
+    return (chunk.cx.count != 0) ? chunk.cx.count : chunk.x.size();
+  }
+
+  // Delta-compress the x array of one sealed chunk (see the doc of
+  // compressTimestamps); `deltas` and `sorted` are caller-owned scratch
+  // buffers, reused across chunks. No-op when the chunk is already
+  // compressed, spilled, too short or too irregular.
+  void compressChunkX(Chunk& chunk, std::vector<int64_t>& deltas, std::vector<int64_t>& sorted,
+                      size_t& saved)
+  {
+    if constexpr (std::is_same_v<TypeX, double>)
+    {
+      const size_t n = chunk.x.size();
+      if (chunk.cx.count != 0 || chunk.spilled_x != nullptr || n < 2)
+      {
+        return;
+      }
+
+      deltas.resize(n - 1);
+      for (size_t i = 1; i < n; i++)
+      {
+        deltas[i - 1] = int64_t(bitsOf(chunk.x[i]) - bitsOf(chunk.x[i - 1]));
+      }
+
+      // center the 16-bit window on the median delta, so that the jitter
+      // of quasi-regular sampling lands inside it and only genuine
+      // irregularities become exceptions
+      sorted = deltas;
+      std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+      const int64_t median = sorted[sorted.size() / 2];
+
+      CompressedX cx;
+      cx.first = bitsOf(chunk.x.front());
+      cx.base_delta = median - 32767;
+      cx.count = uint32_t(n);
+      cx.offsets.reserve(n - 1);
+
+      for (size_t i = 0; i < deltas.size(); i++)
+      {
+        // unsigned on purpose: extreme deltas may wrap, and the decoder
+        // adds base_delta + offset back modulo 2^64 anyway
+        const uint64_t offset = uint64_t(deltas[i]) - uint64_t(cx.base_delta);
+        if (offset > 65535)
+        {
+          if (cx.exceptions.size() >= MAX_EXCEPTIONS)
+          {
+            return;  // too irregular, not worth compressing
+          }
+          // store the absolute value: the delta chain resumes from here
+          cx.exceptions.push_back({ uint16_t(i + 1), bitsOf(chunk.x[i + 1]) });
+          cx.offsets.push_back(0);
+        }
+        else
+        {
+          cx.offsets.push_back(uint16_t(offset));
+        }
+      }
+      const size_t compressed_bytes = cx.offsets.capacity() * sizeof(uint16_t) +
+                                      cx.exceptions.size() * sizeof(cx.exceptions.front());
+      saved += chunk.x.capacity() * sizeof(TypeX) - compressed_bytes;
+
+      chunk.x.clear();
+      chunk.x.shrink_to_fit();
+      chunk.cx = std::move(cx);
+    }
+  }
+
+  // Byte-plane compress the y array of one sealed chunk: plane p (byte p
+  // of every sample) is run-length encoded when repetitive, stored
+  // verbatim otherwise. `plane` and `encoded` are caller-owned scratch
+  // buffers, reused across chunks. No-op when the chunk is already
+  // compressed, not sealed, or would shrink by less than 1/8.
+  void compressChunkY(Chunk& chunk, std::vector<uint8_t>& plane, std::vector<uint8_t>& encoded,
+                      size_t& saved)
+  {
+    if constexpr (std::is_trivially_copyable_v<TypeY>)
+    {
+      const size_t n = chunk.y.size();
+      if (chunk.cy.count != 0 || n != CHUNK_SIZE)
+      {
+        return;
+      }
+      const auto* raw = reinterpret_cast<const uint8_t*>(chunk.y.data());
+      plane.resize(n);
+      encoded.clear();
+      for (size_t p = 0; p < sizeof(TypeY); p++)
+      {
+        for (size_t i = 0; i < n; i++)
+        {
+          plane[i] = raw[i * sizeof(TypeY) + p];
+        }
+        // count the runs first, to pick the smaller of the two encodings
+        size_t runs = 1;
+        size_t run_length = 1;
+        for (size_t i = 1; i < n; i++)
+        {
+          if (plane[i] != plane[i - 1] || run_length == 255)
+          {
+            runs++;
+            run_length = 0;
+          }
+          run_length++;
+        }
+        if (2 * runs < n)
+        {
+          encoded.push_back(PLANE_RLE);
+          size_t i = 0;
+          while (i < n)
+          {
+            size_t j = i + 1;
+            while (j < n && j - i < 255 && plane[j] == plane[i])
+            {
+              j++;
+            }
+            encoded.push_back(uint8_t(j - i));
+            encoded.push_back(plane[i]);
+            i = j;
+          }
+        }
+        else
+        {
+          encoded.push_back(PLANE_RAW);
+          encoded.insert(encoded.end(), plane.begin(), plane.end());
+        }
+      }
+      if (encoded.size() * 8 > n * sizeof(TypeY) * 7)
+      {
+        return;  // not worth the re-materialization churn
+      }
+      CompressedY cy;
+      cy.count = uint32_t(n);
+      cy.bytes.assign(encoded.begin(), encoded.end());
+      saved += chunk.y.capacity() * sizeof(TypeY) - cy.bytes.size();
+      chunk.y.clear();
+      chunk.y.shrink_to_fit();
+      chunk.cy = std::move(cy);
+    }
+  }
+
+  // Rebuild the x array of a compressed chunk, the first time it is
+  // accessed again; the chunk then stays materialized. This mutates the
+  // chunk even through const accessors, hence the const_cast at the call
+  // sites: acceptable because the logical content does not change.
+  void materializeX(Chunk& chunk) const
+  {
+    if (chunk.cx.count == 0)
+    {
+      return;
+    }
+    if constexpr (std::is_same_v<TypeX, double>)
+    {
+      const CompressedX& cx = chunk.cx;
+      chunk.x.reserve(CHUNK_SIZE);
+      uint64_t bits = cx.first;
+      chunk.x.push_back(valueOf(bits));
+      // exceptions are stored in increasing index order; the delta chain
+      // resumes from the absolute value after each one
+      size_t next_exception = 0;
+      for (size_t i = 1; i < cx.count; i++)
+      {
+        if (next_exception < cx.exceptions.size() &&
+            cx.exceptions[next_exception].first == i)
+        {
+          bits = cx.exceptions[next_exception].second;
+          next_exception++;
+        }
+        else
+        {
+          bits += uint64_t(cx.base_delta) + cx.offsets[i - 1];
+        }
+        chunk.x.push_back(valueOf(bits));
+      }
+    }
+    chunk.cx = CompressedX{};
+  }
+
+  // Rebuild the y array of a compressed chunk, the first time it is
+  // accessed again; the inverse of compressChunkY. Same const_cast idiom
+  // and caveats as materializeX.
+  void materializeY(Chunk& chunk) const
+  {
+    if (chunk.cy.count == 0)
+    {
+      return;
+    }
+    if constexpr (std::is_trivially_copyable_v<TypeY>)
+    {
+      const size_t n = chunk.cy.count;
+      chunk.y.reserve(CHUNK_SIZE);
+      chunk.y.resize(n);
+      auto* raw = reinterpret_cast<uint8_t*>(chunk.y.data());
+      const uint8_t* in = chunk.cy.bytes.data();
+      for (size_t p = 0; p < sizeof(TypeY); p++)
+      {
+        const uint8_t tag = *in++;
+        if (tag == PLANE_RAW)
+        {
+          for (size_t i = 0; i < n; i++)
+          {
+            raw[i * sizeof(TypeY) + p] = in[i];
+          }
+          in += n;
+        }
+        else
+        {
+          size_t i = 0;
+          while (i < n)
+          {
+            const size_t length = *in++;
+            const uint8_t value = *in++;
+            for (size_t k = 0; k < length; k++)
+            {
+              raw[i * sizeof(TypeY) + p] = value;
+              i++;
+            }
+          }
+        }
+      }
+    }
+    chunk.cy = CompressedY{};
+  }
+
+  Chunk& writableChunk()
+  {
+    if (_chunks.empty() || chunkLength(_chunks.back()) == CHUNK_SIZE)
+    {
+      _chunks.emplace_back();
+      _chunks.back().x.reserve(CHUNK_SIZE);
+      _chunks.back().y.reserve(CHUNK_SIZE);
+    }
+    return _chunks.back();
+  }
+
+  // Invariant: every chunk except the last holds exactly CHUNK_SIZE samples,
+  // and _front_offset < size of the first chunk. This keeps random access a
+  // single division.
+  std::deque<Chunk> _chunks;
+  size_t _front_offset = 0;
+  size_t _size = 0;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_SOA_STORAGE_H
@@ -0,0 +1,105 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_STRING_INTERNER_H
+#define PJ_STRING_INTERNER_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <QString>
+
+namespace PJ
+{
+/**
+ * @brief Process-wide deduplication table for channel/series names.
+ *
+ * The same name is otherwise copied into every PlotDataBase, map key and
+ * widget that refers to the series; on sessions with very many topics
+ * those duplicates add up to a lot of memory. Interning stores each
+ * distinct name once and hands out a stable 4-byte ID plus a reference
+ * that remains valid for the lifetime of the process.
+ *
+ * Thread-safe. Entries are never removed: the set of distinct names is
+ * bounded by the data sources, not by the session length.
+ */
+class StringInterner
+{
+public:
+  using ID = uint32_t;
+
+  static StringInterner& instance()
+  {
+    static StringInterner interner;
+    return interner;
+  }
+
+  ID internID(std::string_view str)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _ids.find(str);
+    if (it != _ids.end())
+    {
+      return it->second;
+    }
+    const ID id = static_cast<ID>(_strings.size());
+    _strings.emplace_back(str);
+    // the key views into the deque entry, which never moves
+    _ids.emplace(std::string_view(_strings.back()), id);
+    // converted once per distinct name: the Qt side of the application
+    // (legend, curve list, drag payloads) reuses the cached QString
+    // instead of re-encoding the name on every operation
+    _qstrings.emplace_back(QString::fromUtf8(str.data(), int(str.size())));
+    return id;
+  }
+
+  /// Intern and return the canonical copy of the string.
+  const std::string& intern(std::string_view str)
+  {
+    return string(internID(str));
+  }
+
+  const std::string& string(ID id) const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _strings[id];
+  }
+
+  /// Canonical QString of an interned entry; same lifetime guarantee as
+  /// string().
+  const QString& qstring(ID id) const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _qstrings[id];
+  }
+
+  /// Intern and return the cached QString of the name.
+  const QString& qstring(std::string_view str)
+  {
+    return qstring(internID(str));
+  }
+
+  size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _strings.size();
+  }
+
+private:
+  StringInterner() = default;
+
+  mutable std::mutex _mutex;
+  std::deque<std::string> _strings;  // stable addresses
+  std::deque<QString> _qstrings;     // parallel to _strings
+  std::unordered_map<std::string_view, ID> _ids;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_STRING_INTERNER_H
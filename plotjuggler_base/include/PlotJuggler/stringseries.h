@@ -10,15 +10,17 @@
 #include "PlotJuggler/timeseries.h"
 #include "PlotJuggler/string_ref_sso.h"
 #include "PlotJuggler/string_dict_index.h"
+#include "PlotJuggler/contrib/unordered_dense.hpp"
 #include <algorithm>
 #include <string>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 
 namespace PJ
 {
-class StringSeries : public TimeseriesBase<StringDictIndex>
+// final for the same reason as PlotData (see plotdata.h): appends through
+// the concrete type are devirtualized and inlined
+class StringSeries final : public TimeseriesBase<StringDictIndex>
 {
 public:
   using TimeseriesBase<StringDictIndex>::_points;
@@ -73,6 +75,16 @@ public:
     return _index_to_string[idx.index];
   }
 
+  /// Index of an already interned value, or an invalid index if this
+  /// series never stored the string. Consumers looking for a specific
+  /// value should resolve it once with this method and compare the
+  /// 4-byte index of each sample, instead of comparing strings.
+  StringDictIndex stringIndex(std::string_view str) const
+  {
+    auto it = _string_to_index.find(str);
+    return (it == _string_to_index.end()) ? StringDictIndex() : StringDictIndex(it->second);
+  }
+
   std::optional<std::string_view> getStringFromX(double x) const
   {
     int index = getIndexFromX(x);
@@ -97,6 +109,25 @@ public:
     PlotDataBase<double, StringDictIndex>::clonePoints(other);
   }
 
+  MemoryFootprint memoryFootprint() const override
+  {
+    auto footprint = TimeseriesBase<StringDictIndex>::memoryFootprint();
+    // one std::string plus heap payload per unique value, plus the
+    // interning map entries (key string shares no storage with the vector)
+    size_t dictionary = _index_to_string.capacity() * sizeof(std::string);
+    for (const auto& str : _index_to_string)
+    {
+      dictionary += str.capacity();
+    }
+    dictionary += _string_to_index.size() * (sizeof(std::string) + sizeof(uint32_t));
+    for (const auto& [key, index] : _string_to_index)
+    {
+      dictionary += key.capacity();
+    }
+    footprint.dictionary_bytes = dictionary;
+    return footprint;
+  }
+
   void swapData(StringSeries& other)
   {
     TimeseriesBase<StringDictIndex>::swapData(other);
@@ -105,23 +136,36 @@ public:
   }
 
 private:
+  // heterogeneous hash, so interning can probe with a string_view
+  // without building a temporary std::string per sample
+  struct TransparentHash
+  {
+    using is_transparent = void;
+    using is_avalanching = void;
+
+    uint64_t operator()(std::string_view str) const noexcept
+    {
+      return ankerl::unordered_dense::hash<std::string_view>{}(str);
+    }
+  };
+
   StringDictIndex internString(std::string_view str)
   {
-    _tmp_str.assign(str.data(), str.size());
-    auto it = _string_to_index.find(_tmp_str);
+    auto it = _string_to_index.find(str);
     if (it != _string_to_index.end())
     {
       return StringDictIndex(it->second);
     }
+    // the copy happens only once per unique value
     uint32_t new_index = static_cast<uint32_t>(_index_to_string.size());
-    _index_to_string.push_back(_tmp_str);
-    _string_to_index.emplace(_tmp_str, new_index);
+    _index_to_string.emplace_back(str);
+    _string_to_index.emplace(_index_to_string.back(), new_index);
     return StringDictIndex(new_index);
   }
 
-  std::string _tmp_str;
   std::vector<std::string> _index_to_string;
-  std::unordered_map<std::string, uint32_t> _string_to_index;
+  ankerl::unordered_dense::map<std::string, uint32_t, TransparentHash, std::equal_to<>>
+      _string_to_index;
 };
 
 }  // namespace PJ
@@ -0,0 +1,90 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_THREAD_POOL_H
+#define PJ_THREAD_POOL_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PJ
+{
+/**
+ * @brief Process-wide pool of worker threads shared by the application and
+ * the plugins, sized to the machine once instead of every plugin spawning
+ * its own workers.
+ *
+ * Tasks are tagged with a priority class so that, when the pool is
+ * saturated, message decoding is favoured over transform recomputation,
+ * which in turn is favoured over speculative render preparation.
+ * Within a class, each worker pops its own queue in LIFO order (the data
+ * is still warm in cache) and steals from the other workers in FIFO order.
+ *
+ * Tasks must not block on the GUI thread: the pool is also drained during
+ * application shutdown, when the event loop is no longer running.
+ */
+class ThreadPool
+{
+public:
+  enum class Priority : int
+  {
+    INGEST = 0,         ///< decoding / parsing of incoming samples
+    TRANSFORM = 1,      ///< recomputing derived series
+    RENDER_PREPARE = 2  ///< work that only speeds up the next repaint
+  };
+
+  static ThreadPool& instance();
+
+  /// Schedule a task. Never blocks: the queues are unbounded, callers that
+  /// need backpressure must implement it at the producer side.
+  void submit(Priority priority, std::function<void()> task);
+
+  size_t threadCount() const
+  {
+    return _workers.size();
+  }
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+private:
+  ThreadPool();
+
+  static constexpr size_t PRIORITY_CLASSES = 3;
+
+  /// Per-thread queues; the mutex only covers this worker's deques, so
+  /// submissions and steals touching different workers do not contend.
+  struct Worker
+  {
+    std::mutex mutex;
+    std::array<std::deque<std::function<void()>>, PRIORITY_CLASSES> queues;
+  };
+
+  void workerLoop(size_t self_index);
+  bool popTask(Worker& worker, bool steal, std::function<void()>& task);
+
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::vector<std::thread> _threads;
+
+  std::mutex _sleep_mutex;
+  std::condition_variable _wakeup;
+  std::atomic<size_t> _pending_count{ 0 };
+  std::atomic<size_t> _round_robin{ 0 };
+  std::atomic<bool> _running{ true };
+};
+
+}  // namespace PJ
+
+#endif  // PJ_THREAD_POOL_H
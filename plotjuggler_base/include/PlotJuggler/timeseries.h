@@ -9,21 +9,57 @@
 
 #include "plotdatabase.h"
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 namespace PJ
 {
-template <typename Value>
-class TimeseriesBase : public PlotDataBase<double, Value>
+/**
+ * @brief Accumulator with the time range of a set of timeseries, shared
+ * between the series and the container that owns them (see
+ * PlotDataMapRef::numericRangeX).
+ *
+ * Appending samples extends it in O(1). Anything that can shrink a series
+ * (trimming, clearing, swapping its data) only marks it stale: the owner
+ * refreshes it lazily by folding the O(1) cached range of each series,
+ * never rescanning the samples.
+ *
+ * The stale flag is atomic so that series merged on worker threads can
+ * mark it without racing; min/max and the counters are written only by
+ * the owner's thread (a stale accumulator is never extended).
+ */
+struct SharedTimeRange
+{
+  RangeOpt range;
+
+  /// size of the largest series, i.e. the resolution of the time slider
+  size_t max_size = 0;
+
+  /// number of series folded into the current value, used to detect
+  /// series added or removed behind the owner's back
+  size_t series_count = 0;
+
+  std::atomic<bool> stale{ true };
+
+  using Ptr = std::shared_ptr<SharedTimeRange>;
+};
+
+template <typename Value,
+          typename Storage =
+              std::deque<PlotPoint<double, Value>, PoolAllocator<PlotPoint<double, Value>>>>
+class TimeseriesBase : public PlotDataBase<double, Value, Storage>
 {
 protected:
   double _max_range_x;
-  using PlotDataBase<double, Value>::_points;
+  using PlotDataBase<double, Value, Storage>::_points;
 
 public:
-  using Point = typename PlotDataBase<double, Value>::Point;
+  using Point = typename PlotDataBase<double, Value, Storage>::Point;
 
   TimeseriesBase(const std::string& name, PlotGroup::Ptr group)
-    : PlotDataBase<double, Value>(name, group), _max_range_x(std::numeric_limits<double>::max())
+    : PlotDataBase<double, Value, Storage>(name, group)
+    , _max_range_x(std::numeric_limits<double>::max())
   {
   }
 
@@ -41,7 +77,10 @@ public:
   void setMaximumRangeX(double max_range)
   {
     _max_range_x = max_range;
-    trimRange();
+    // unbounded: this is the explicit resize entry point. The bulk path
+    // (PlotDataMapRef::setMaximumRangeX) spreads the cost over the
+    // thread pool instead of amortizing it.
+    trimRange(std::numeric_limits<size_t>::max());
   }
 
   double maximumRangeX() const
@@ -51,8 +90,31 @@ public:
 
   void swapData(TimeseriesBase& other)
   {
-    PlotDataBase<double, Value>::swapData(other);
+    PlotDataBase<double, Value, Storage>::swapData(other);
     std::swap(_max_range_x, other._max_range_x);
+    std::swap(_staging, other._staging);
+    // the accumulators stay with their owning containers, but both now
+    // describe different samples
+    markSharedRangeStale();
+    other.markSharedRangeStale();
+  }
+
+  void clear() override
+  {
+    PlotDataBase<double, Value, Storage>::clear();
+    _staging.clear();
+    markSharedRangeStale();
+  }
+
+  /// Attach the accumulator shared with the container that owns this
+  /// series (see SharedTimeRange). The series extends it when samples
+  /// are appended and marks it stale when samples are dropped.
+  void setSharedTimeRange(const SharedTimeRange::Ptr& shared)
+  {
+    if (_shared_range != shared)
+    {
+      _shared_range = shared;
+    }
   }
 
   int getIndexFromX(double x) const;
@@ -63,6 +125,20 @@ public:
     return (index < 0) ? std::nullopt : std::optional(_points[index].y);
   }
 
+  // the time-indexed queries and the plot bounds must see the staged
+  // samples: flush before answering
+  RangeOpt rangeX() const override
+  {
+    flushStaging();
+    return PlotDataBase<double, Value, Storage>::rangeX();
+  }
+
+  RangeOpt rangeY() const override
+  {
+    flushStaging();
+    return PlotDataBase<double, Value, Storage>::rangeY();
+  }
+
   void pushBack(const Point& p) override
   {
     auto temp = p;
@@ -75,17 +151,88 @@ public:
 
     if (need_sorting)
     {
-      auto it = std::upper_bound(_points.begin(), _points.end(), p,
-                                 [](const auto& a, const auto& b) { return a.x < b.x; });
-      PlotDataBase<double, Value>::insert(it, std::move(p));
+      // A late sample used to pay a sorted mid-storage insertion, which
+      // also invalidates the monotonic min/max deques: with jittery
+      // multi-source streams that is an O(n) cost per sample. Stage it
+      // instead and merge the staged samples in one sorted batch.
+      if (this->sampleIsValid(p.x, p.y))
+      {
+        _staging.push_back(std::move(p));
+        if (_staging.size() >= STAGING_CAPACITY)
+        {
+          mergeStaging();
+        }
+      }
     }
     else
     {
-      PlotDataBase<double, Value>::pushBack(std::move(p));
+      PlotDataBase<double, Value, Storage>::pushBack(std::move(p));
     }
     trimRange();
   }
 
+  /// Bulk version of pushBack() for samples given as two parallel arrays.
+  /// Time-ordered stretches (the normal case for loaders and streamers)
+  /// are appended run-wise: one range update per run, one bulk storage
+  /// insert when the backend supports it, and a single trimRange() at the
+  /// end. Out-of-order samples degrade gracefully to the per-point
+  /// pushBack() behavior. Non-finite samples are skipped entirely
+  /// (pushBack() instead extends the cached rangeX with a finite-x /
+  /// non-finite-y sample before dropping it).
+  void appendBatch(const double* xs, const Value* ys, size_t count)
+  {
+    size_t i = 0;
+    while (i < count)
+    {
+      if (!this->sampleIsValid(xs[i], ys[i]))
+      {
+        i++;
+        continue;
+      }
+      const double back_x =
+          _points.empty() ? std::numeric_limits<double>::lowest() : double(this->back().x);
+      if (xs[i] < back_x)
+      {
+        // needs sorted insertion: one sample at a time
+        this->pushBack(Point(xs[i], ys[i]));
+        i++;
+        continue;
+      }
+      const size_t run_begin = i;
+      double prev_x = xs[i];
+      while (i < count && this->sampleIsValid(xs[i], ys[i]) && xs[i] >= prev_x)
+      {
+        prev_x = xs[i];
+        i++;
+      }
+      this->appendFiniteRun(xs + run_begin, ys + run_begin, i - run_begin);
+    }
+    trimRange(count + TRIM_QUANTUM);
+  }
+
+  void popFront() override
+  {
+    if (_shared_range && !_points.empty())
+    {
+      // dropping the oldest sample can invalidate the shared accumulator
+      // only when this series owns its minimum, or is the largest one
+      if ((_shared_range->range && double(_points.front().x) <= _shared_range->range->min) ||
+          _points.size() >= _shared_range->max_size)
+      {
+        markSharedRangeStale();
+      }
+    }
+    PlotDataBase<double, Value, Storage>::popFront();
+    // x is sorted: after evicting the front, the range is simply
+    // [front, back]. No rescan needed.
+    if (this->_range_x_dirty && !_points.empty())
+    {
+      this->_range_x.min = _points.front().x;
+      this->_range_x.max = _points.back().x;
+      this->_range_x_dirty = false;
+    }
+  }
+
   virtual void pushUnsorted(const Point& p)
   {
     if constexpr (std::is_arithmetic_v<Value>)
@@ -103,41 +250,213 @@ public:
 
   void sort()
   {
+    // a full sort makes the staged/merged distinction pointless
+    for (auto& p : _staging)
+    {
+      _points.push_back(std::move(p));
+    }
+    _staging.clear();
     std::sort(_points.begin(), _points.end(),
               [](const auto& a, const auto& b) { return a.x < b.x; });
 
-    Range range_x;
-    Range range_y;
+    if (_points.empty())
+    {
+      this->_range_x_dirty = true;
+    }
+    else
+    {
+      this->_range_x.min = _points.front().x;
+      this->_range_x.max = _points.back().x;
+      this->_range_x_dirty = false;
+    }
+    // y is not ordered; recompute lazily. The monotonic deques kept the
+    // old append order, so they must be rebuilt as well.
+    this->_range_y_dirty = true;
+    if constexpr (std::is_arithmetic_v<Value>)
+    {
+      this->_mono_min_y.clear();
+      this->_mono_max_y.clear();
+      this->_mono_y_valid = false;
+    }
+    // a full sort happens at load time, not per frame: trim everything
+    trimRange(std::numeric_limits<size_t>::max());
+  }
+
+private:
+  // last result of getIndexFromX(), exploited for temporal locality.
+  // Just a hint: always clamped to the current size before use.
+  mutable size_t _index_hint = 0;
+
+  /// Staging buffer for out-of-order samples (see pushBack). Staged
+  /// samples become visible to positional access (size/at) only after
+  /// the next merge, which happens when the buffer fills, when a
+  /// time-indexed query or rangeX/rangeY runs — i.e. at the next
+  /// replot at the latest — or when the series is sorted or cleared.
+  /// Bounded disorder therefore costs amortized O(log k) per sample
+  /// instead of an O(n) mid-storage insertion.
+  static constexpr size_t STAGING_CAPACITY = 256;
+  mutable std::vector<Point> _staging;
 
-    for (const auto& p : _points)
+  /// Extra evictions allowed per trimRange() call beyond the samples just
+  /// inserted: the points held by one recycled deque buffer (see
+  /// BlockPool), so a backlog drains block by block.
+  static constexpr size_t TRIM_QUANTUM =
+      std::max<size_t>(size_t(1), BlockPool::CLASS_SIZES[0] / sizeof(Point));
+
+  /// accumulator shared with the owning container, if any (see
+  /// SharedTimeRange). Staged samples reach it only at the next merge,
+  /// like every other reader of this series.
+  SharedTimeRange::Ptr _shared_range;
+
+  /// Behind a unique_ptr so the defaulted move operations keep working.
+  /// Taken only by flushStaging(), and only when there is staged data.
+  mutable std::unique_ptr<std::mutex> _staging_mutex = std::make_unique<std::mutex>();
+
+  // Flushing from a const accessor turns the caller into a writer, so two
+  // flushers (e.g. two worker tasks that both query this series by time)
+  // must not merge the same buffers at once: the mutex serializes them.
+  // It does NOT make general concurrent access safe - a reader scanning
+  // the points while another thread merges still races. Readers and the
+  // ingesting writer synchronize externally as everywhere in this class,
+  // and the parallel call sites partition the series they touch by source
+  // (see RecomputeTransforms and PrepareCurvesGroupedBySource in the app).
+  void flushStaging() const
+  {
+    if (!_staging.empty())
     {
-      range_x.min = std::max(range_x.min, p.x);
-      range_x.max = std::min(range_x.max, p.x);
+      std::lock_guard<std::mutex> lock(*_staging_mutex);
+      if (!_staging.empty())
+      {
+        const_cast<TimeseriesBase*>(this)->mergeStaging();
+      }
+    }
+  }
 
+  void mergeStaging()
+  {
+    if (_staging.empty())
+    {
+      return;
+    }
+    // stable: staged samples with equal timestamps keep arrival order
+    std::stable_sort(_staging.begin(), _staging.end(), TimeCompare);
+
+    const size_t old_size = _points.size();
+    const size_t staged = _staging.size();
+    const size_t merge_from = std::distance(
+        _points.begin(),
+        std::upper_bound(_points.begin(), _points.end(), _staging.front(), TimeCompare));
+
+    // grow the storage; these values are overwritten by the merge below
+    for (const auto& p : _staging)
+    {
+      if (!this->_range_x_dirty)
+      {
+        this->_range_x.min = std::min(this->_range_x.min, p.x);
+        this->_range_x.max = std::max(this->_range_x.max, p.x);
+      }
       if constexpr (std::is_arithmetic_v<Value>)
       {
-        range_y.min = std::max(range_y.min, p.y);
-        range_y.max = std::min(range_y.max, p.y);
+        if (!this->_range_y_dirty)
+        {
+          this->_range_y.min = std::min(this->_range_y.min, p.y);
+          this->_range_y.max = std::max(this->_range_y.max, p.y);
+        }
       }
+      _points.push_back(p);
     }
-    this->_range_x = range_x;
-    this->_range_y = range_y;
-    this->_range_x_dirty = false;
-    this->_range_y_dirty = false;
-    trimRange();
+
+    // backward merge of the old tail [merge_from, old_size) with the
+    // staged samples; a staged sample ends up after an existing one
+    // with the same timestamp, like the upper_bound insertion did
+    size_t tail = old_size;
+    size_t pending = staged;
+    size_t write = old_size + staged;
+    while (pending > 0)
+    {
+      if (tail > merge_from && _points[tail - 1].x > _staging[pending - 1].x)
+      {
+        _points[write - 1] = Point(_points[tail - 1]);
+        tail--;
+      }
+      else
+      {
+        pending--;
+        _points[write - 1] = _staging[pending];
+      }
+      write--;
+    }
+    _staging.clear();
+
+    // middle insertions break the append-order invariant of the
+    // monotonic deques; they are rebuilt lazily by the next rangeY()
+    if constexpr (std::is_arithmetic_v<Value>)
+    {
+      this->_mono_min_y.clear();
+      this->_mono_max_y.clear();
+      this->_mono_y_valid = false;
+    }
+    trimRange(staged + TRIM_QUANTUM);
   }
 
-private:
-  void trimRange()
+  /// Evict at most max_evictions samples older than the configured range.
+  /// Mutators pass the number of samples they just inserted plus
+  /// TRIM_QUANTUM: steady-state streaming evicts about one sample per
+  /// append, and the backlog left by a shrunk buffer or a forward jump of
+  /// the timestamps drains one block-sized quantum per append instead of
+  /// stalling a single frame with an unbounded eviction loop.
+  void trimRange(size_t max_evictions)
   {
     if (_max_range_x < std::numeric_limits<double>::max() && !_points.empty())
     {
       auto const back_point_x = _points.back().x;
-      while (_points.size() > 2 && (back_point_x - _points.front().x) > _max_range_x)
+      while (max_evictions > 0 && _points.size() > 2 &&
+             (back_point_x - _points.front().x) > _max_range_x)
       {
-        this->popFront();
+        // qualified call: no subclass overrides popFront(), and the virtual
+        // dispatch would otherwise survive inlining of the append path
+        TimeseriesBase::popFront();
+        max_evictions--;
       }
     }
+    growSharedRange();
+  }
+
+  void trimRange()
+  {
+    trimRange(1 + TRIM_QUANTUM);
+  }
+
+  void markSharedRangeStale()
+  {
+    if (_shared_range)
+    {
+      _shared_range->stale.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  // every mutation funnel ends here (possibly via trimRange): x is
+  // sorted, so [front, back] is the whole extent of this series
+  void growSharedRange()
+  {
+    if (!_shared_range || _points.empty() ||
+        _shared_range->stale.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+    const double front_x = _points.front().x;
+    const double back_x = _points.back().x;
+    auto& range = _shared_range->range;
+    if (!range)
+    {
+      range = Range{ front_x, back_x };
+    }
+    else
+    {
+      range->min = std::min(range->min, front_x);
+      range->max = std::max(range->max, back_x);
+    }
+    _shared_range->max_size = std::max(_shared_range->max_size, _points.size());
   }
 
   static bool TimeCompare(const Point& a, const Point& b)
@@ -148,29 +467,66 @@ private:
 
 //--------------------
 
-template <typename Value>
-inline int TimeseriesBase<Value>::getIndexFromX(double x) const
+template <typename Value, typename Storage>
+inline int TimeseriesBase<Value, Storage>::getIndexFromX(double x) const
 {
-  if (_points.size() == 0)
+  flushStaging();
+  const size_t count = _points.size();
+  if (count == 0)
   {
     return -1;
   }
-  auto lower = std::lower_bound(_points.begin(), _points.end(), Point(x, {}), TimeCompare);
+
+  // Consecutive queries (time tracker, range scans) are usually close to
+  // each other: gallop from the last result to bracket x, then binary
+  // search only inside the bracket. Far jumps degrade gracefully to
+  // O(log distance).
+  const size_t hint = std::min(_index_hint, count - 1);
+  size_t lower_limit = 0;
+  size_t upper_limit = count;
+  size_t bound = 1;
+
+  if (_points[hint].x < x)
+  {
+    lower_limit = hint;
+    while (hint + bound < count && _points[hint + bound].x < x)
+    {
+      lower_limit = hint + bound;
+      bound <<= 1;
+    }
+    upper_limit = std::min(count, hint + bound + 1);
+  }
+  else
+  {
+    upper_limit = hint;
+    while (bound <= hint && _points[hint - bound].x >= x)
+    {
+      upper_limit = hint - bound;
+      bound <<= 1;
+    }
+    lower_limit = (bound > hint) ? 0 : hint - bound;
+  }
+
+  auto lower = std::lower_bound(_points.begin() + lower_limit, _points.begin() + upper_limit,
+                                Point(x, {}), TimeCompare);
   auto index = std::distance(_points.begin(), lower);
 
-  if (index >= _points.size())
+  if (index >= static_cast<decltype(index)>(count))
   {
-    return _points.size() - 1;
+    _index_hint = count - 1;
+    return count - 1;
   }
   if (index < 0)
   {
+    _index_hint = 0;
     return 0;
   }
 
-  if (index > 0 && (abs(_points[index - 1].x - x) < abs(_points[index].x - x)))
+  if (index > 0 && (std::abs(_points[index - 1].x - x) < std::abs(_points[index].x - x)))
   {
     index = index - 1;
   }
+  _index_hint = static_cast<size_t>(index);
   return index;
 }
 
@@ -61,9 +61,19 @@ public:
 
   std::vector<const PlotData*>& dataSources();
 
+  std::vector<PlotData*>& dataOutputs();
+
   virtual void setData(PlotDataMapRef* data, const std::vector<const PlotData*>& src_vect,
                        std::vector<PlotData*>& dst_vect);
 
+  /** Apply the transform.
+   *
+   * Incremental-append contract: when called repeatedly while the sources
+   * grow, implementations should only process the samples appended since the
+   * previous call (TransformFunction_SISO resumes from the last computed
+   * timestamp). reset() is invoked whenever the history becomes invalid
+   * (option change, data reload) and must discard any incremental state.
+   */
   virtual void calculate() = 0;
 
   unsigned order() const
@@ -109,6 +119,28 @@ public:
   /// Index will increase monotonically, unless reset() is used.
   virtual std::optional<PlotData::Point> calculateNextPoint(size_t index) = 0;
 
+  /** Process the source samples with indices [from, to) and append the
+   * results to dst. The default implementation makes one virtual
+   * calculateNextPoint() call per sample; transforms with a cheap
+   * per-sample kernel should override this to hoist option lookups and
+   * dispatch out of the inner loop.
+   */
+  virtual void calculateBatch(size_t from, size_t to, PlotData* dst);
+
+  using PointwiseFunc = std::function<double(double)>;
+
+  /** A stateless per-sample mapping of the value (timestamps untouched,
+   * no sample dropped), or an empty function for transforms that do not
+   * qualify. Consecutive pointwise stages of a chained pipeline are fused
+   * into a single loop with no intermediate series (see
+   * TransformedTimeseries). Queried before every pass, so the returned
+   * function may capture the current option values.
+   */
+  virtual PointwiseFunc pointwiseOperation() const
+  {
+    return {};
+  }
+
   const PlotData* dataSource() const;
 
 protected:
@@ -0,0 +1,208 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_BLOCK_POOL_HPP
+#define PJ_BLOCK_POOL_HPP
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace PJ
+{
+/**
+ * @brief Process-wide recycler for the fixed-size blocks that dominate
+ * series storage: the ~512 byte buffers of std::deque and the 32 KiB
+ * coordinate chunks of SoAStorage. Loading a large session performs
+ * millions of identically-sized allocations; serving them from a free
+ * list removes most of the allocator traffic and the resulting heap
+ * fragmentation.
+ *
+ * Requests whose size does not match a pooled class fall through to
+ * operator new. PlotDataMapRef::clear() calls releaseFreeBlocks() to
+ * return the recycled memory to the system in one go.
+ */
+class BlockPool
+{
+public:
+  static BlockPool& instance()
+  {
+    // leaked on purpose: allocators may outlive any static destruction order
+    static BlockPool* pool = new BlockPool();
+    return *pool;
+  }
+
+  void* allocate(size_t bytes)
+  {
+    const int c = classIndex(bytes);
+    if (c >= 0)
+    {
+      // Steady-state streaming alternates one trim at the front of a deque
+      // with one append at its back: the per-thread magazine turns that
+      // pattern into a ring of recycled blocks, with no lock and no heap
+      // traffic at all.
+      auto& magazine = threadMagazine();
+      if (magazine.count[c] > 0)
+      {
+        return magazine.blocks[c][--magazine.count[c]];
+      }
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto& free_list = _free_lists[c];
+      if (!free_list.empty())
+      {
+        void* block = free_list.back();
+        free_list.pop_back();
+        return block;
+      }
+    }
+    return ::operator new(bytes);
+  }
+
+  void deallocate(void* block, size_t bytes)
+  {
+    const int c = classIndex(bytes);
+    if (c >= 0)
+    {
+      auto& magazine = threadMagazine();
+      if (magazine.count[c] < MAGAZINE_CAPACITY)
+      {
+        magazine.blocks[c][magazine.count[c]++] = block;
+        return;
+      }
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto& free_list = _free_lists[c];
+      if (free_list.size() * CLASS_SIZES[c] < MAX_POOLED_BYTES_PER_CLASS)
+      {
+        free_list.push_back(block);
+        return;
+      }
+    }
+    ::operator delete(block);
+  }
+
+  /// Bulk release: give all recycled blocks back to the system.
+  void releaseFreeBlocks()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& free_list : _free_lists)
+    {
+      for (void* block : free_list)
+      {
+        ::operator delete(block);
+      }
+      free_list.clear();
+      free_list.shrink_to_fit();
+    }
+  }
+
+  size_t pooledBytes() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t total = 0;
+    for (size_t c = 0; c < CLASS_SIZES.size(); c++)
+    {
+      total += _free_lists[c].size() * CLASS_SIZES[c];
+    }
+    return total;
+  }
+
+  // 512: libstdc++ deque buffer; 4096 / 32768: SoAStorage chunks.
+  // Public so that callers with variable-sized payloads (any_value.h)
+  // can round their requests up to a pooled size.
+  static constexpr std::array<size_t, 3> CLASS_SIZES = { 512, 4096, 32768 };
+
+private:
+  BlockPool() = default;
+
+  static constexpr size_t MAX_POOLED_BYTES_PER_CLASS = 32 * 1024 * 1024;
+  static constexpr size_t MAGAZINE_CAPACITY = 8;
+
+  // Small per-thread cache sitting in front of the shared free lists.
+  // Not drained by releaseFreeBlocks(): it holds at most a few KiB per
+  // thread and returns its blocks to the system when the thread exits.
+  struct Magazine
+  {
+    std::array<std::array<void*, MAGAZINE_CAPACITY>, CLASS_SIZES.size()> blocks;
+    std::array<size_t, CLASS_SIZES.size()> count = {};
+
+    ~Magazine()
+    {
+      for (size_t c = 0; c < CLASS_SIZES.size(); c++)
+      {
+        for (size_t i = 0; i < count[c]; i++)
+        {
+          ::operator delete(blocks[c][i]);
+        }
+      }
+    }
+  };
+
+  static Magazine& threadMagazine()
+  {
+    static thread_local Magazine magazine;
+    return magazine;
+  }
+
+  static int classIndex(size_t bytes)
+  {
+    for (size_t c = 0; c < CLASS_SIZES.size(); c++)
+    {
+      if (CLASS_SIZES[c] == bytes)
+      {
+        return int(c);
+      }
+    }
+    return -1;
+  }
+
+  mutable std::mutex _mutex;
+  std::array<std::vector<void*>, CLASS_SIZES.size()> _free_lists;
+};
+
+/// std-compatible allocator backed by BlockPool. Stateless: all
+/// instances compare equal, so containers can be swapped and moved
+/// across owners freely.
+template <typename T>
+class PoolAllocator
+{
+public:
+  using value_type = T;
+
+  PoolAllocator() = default;
+
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>&)
+  {
+  }
+
+  T* allocate(size_t n)
+  {
+    return static_cast<T*>(BlockPool::instance().allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n)
+  {
+    BlockPool::instance().deallocate(ptr, n * sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const PoolAllocator<U>&) const
+  {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const PoolAllocator<U>&) const
+  {
+    return false;
+  }
+};
+
+}  // namespace PJ
+
+#endif  // PJ_BLOCK_POOL_HPP
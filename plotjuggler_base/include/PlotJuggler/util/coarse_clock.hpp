@@ -0,0 +1,81 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_COARSE_CLOCK_HPP
+#define PJ_COARSE_CLOCK_HPP
+
+#include <algorithm>
+#include <chrono>
+
+namespace PJ
+{
+/**
+ * @brief Arrival-time stamping for streamers that timestamp samples on
+ * receipt (UDP, serial, MQTT without an embedded timestamp).
+ *
+ * Reading the wall clock once per message is measurable at high rates,
+ * and the stamps it produces jitter with scheduling noise. This clock is
+ * read once per received batch instead: refresh() caches the wall time,
+ * and batchStamp() spreads the messages of the batch evenly over the
+ * interval since the previous refresh. A burst of N datagrams gets N
+ * distinct, monotonically increasing stamps from a single clock read,
+ * which is both cheaper and a smoother time base than N independent
+ * reads.
+ *
+ * One instance per receive thread; not thread-safe and not meant to be.
+ */
+class CoarseArrivalClock
+{
+public:
+  /// Longest interval one batch is spread over. After an idle gap the
+  /// batch most likely arrived just before the refresh, so stamps are
+  /// never back-dated by more than this.
+  static constexpr double MAX_SPAN_SEC = 0.1;
+
+  CoarseArrivalClock() : _now(wallNow())
+  {
+  }
+
+  /// Read the wall clock and start a new batch. One call per batch.
+  void refresh()
+  {
+    const double now = wallNow();
+    _span = std::clamp(now - _now, 0.0, MAX_SPAN_SEC);
+    _now = now;
+  }
+
+  /// Time of the last refresh (or of construction), in seconds since
+  /// the epoch. Use it when the batch size is unknown and every message
+  /// of the batch gets the same stamp.
+  double time() const
+  {
+    return _now;
+  }
+
+  /// Arrival stamp of message `index` of a batch of `count` received
+  /// just before the last refresh(): evenly spaced over the interval
+  /// since the previous refresh, with the last message stamped closest
+  /// to the refresh itself. Monotonic across consecutive batches.
+  double batchStamp(size_t index, size_t count) const
+  {
+    return _now - (_span * double(count - 1 - index)) / double(count);
+  }
+
+private:
+  static double wallNow()
+  {
+    using namespace std::chrono;
+    const auto since_epoch = system_clock::now().time_since_epoch();
+    return 1e-6 * double(duration_cast<microseconds>(since_epoch).count());
+  }
+
+  double _now;
+  double _span = 0;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_COARSE_CLOCK_HPP
@@ -7,9 +7,15 @@
 #ifndef PJ_DELAYED_CALLBACK_HPP
 #define PJ_DELAYED_CALLBACK_HPP
 
+#include <QElapsedTimer>
 #include <QTimer>
 #include <QMetaMethod>
+#include <algorithm>
 #include <functional>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
 
 namespace PJ
 {
@@ -46,6 +52,149 @@ private:
   QTimer* _delay_timer;
 };
 
+/**
+ * @brief Central coalescing scheduler for GUI refreshes.
+ *
+ * A channel is a named callback, registered once. Every trigger() asks
+ * for the channel to run within the given latency bound; triggers
+ * arriving while it is pending collapse into a single invocation, with
+ * the earliest deadline winning. Wake-ups are aligned to a frame grid,
+ * so channels due in the same frame share one timer event instead of
+ * waking the event loop separately.
+ *
+ * Use it for refresh paths that may be hit by event storms (imports,
+ * curve drops, scrolling); DelayedCallback remains the right tool for a
+ * single throttled slot owned by one widget.
+ *
+ * GUI-thread only, like the widgets it refreshes.
+ */
+class CoalescingScheduler
+{
+public:
+  static CoalescingScheduler& instance()
+  {
+    static CoalescingScheduler scheduler;
+    return scheduler;
+  }
+
+  /// Register (or replace) the callback of a channel.
+  void registerChannel(const std::string& name, std::function<void()> callback)
+  {
+    _channels[name].callback = std::move(callback);
+  }
+
+  /// Forget a channel; owners of captured context must call this before
+  /// that context is destroyed.
+  void unregisterChannel(const std::string& name)
+  {
+    _channels.erase(name);
+  }
+
+  /// Ask for the channel to run within max_latency_ms from now.
+  void trigger(const std::string& name, int max_latency_ms)
+  {
+    auto it = _channels.find(name);
+    if (it == _channels.end() || !it->second.callback)
+    {
+      return;
+    }
+    auto& channel = it->second;
+    const qint64 deadline = _clock.elapsed() + max_latency_ms;
+    if (channel.pending)
+    {
+      channel.deadline = std::min(channel.deadline, deadline);
+    }
+    else
+    {
+      channel.pending = true;
+      channel.deadline = deadline;
+    }
+    scheduleWakeup();
+  }
+
+  /// Grid the wake-ups are aligned to; deadlines are rounded down to it,
+  /// never exceeded.
+  void setFramePeriod(int period_ms)
+  {
+    _frame_period_ms = std::max(1, period_ms);
+  }
+
+private:
+  CoalescingScheduler()
+  {
+    _clock.start();
+    _timer = new QTimer();
+    _timer->setSingleShot(true);
+    _timer->setTimerType(Qt::PreciseTimer);
+    QObject::connect(_timer, &QTimer::timeout, [this]() { onTimeout(); });
+  }
+
+  ~CoalescingScheduler()
+  {
+    delete _timer;
+  }
+
+  struct Channel
+  {
+    std::function<void()> callback;
+    bool pending = false;
+    qint64 deadline = 0;
+  };
+
+  void onTimeout()
+  {
+    // channels due within the current frame fire together. Collect them
+    // first: a callback may trigger or (un)register channels.
+    const qint64 horizon = _clock.elapsed() + _frame_period_ms / 2;
+    std::vector<std::function<void()>> due;
+    for (auto& [name, channel] : _channels)
+    {
+      if (channel.pending && channel.deadline <= horizon)
+      {
+        channel.pending = false;
+        due.push_back(channel.callback);
+      }
+    }
+    for (auto& callback : due)
+    {
+      callback();
+    }
+    scheduleWakeup();
+  }
+
+  void scheduleWakeup()
+  {
+    qint64 earliest = std::numeric_limits<qint64>::max();
+    for (const auto& [name, channel] : _channels)
+    {
+      if (channel.pending)
+      {
+        earliest = std::min(earliest, channel.deadline);
+      }
+    }
+    if (earliest == std::numeric_limits<qint64>::max())
+    {
+      _timer->stop();
+      return;
+    }
+    // round down to the frame grid: fire early rather than late
+    qint64 fire_at = earliest - (earliest % _frame_period_ms);
+    const qint64 now = _clock.elapsed();
+    fire_at = std::max(fire_at, now);
+    if (!_timer->isActive() || fire_at < _wakeup_at)
+    {
+      _wakeup_at = fire_at;
+      _timer->start(int(fire_at - now));
+    }
+  }
+
+  std::map<std::string, Channel> _channels;
+  QTimer* _timer;
+  QElapsedTimer _clock;
+  qint64 _wakeup_at = 0;
+  int _frame_period_ms = 16;
+};
+
 }  // namespace PJ
 
 #endif  // PJ_DELAYED_CALLBACK_HPP
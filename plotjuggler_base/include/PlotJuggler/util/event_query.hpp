@@ -0,0 +1,307 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_EVENT_QUERY_HPP
+#define PJ_EVENT_QUERY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "PlotJuggler/plotdata.h"
+#include "PlotJuggler/util/simd_minmax.hpp"
+
+namespace PJ
+{
+/**
+ * @brief Answers "when did this series exceed 80 A" questions without a
+ * linear scan per query.
+ *
+ * Construction makes a single pass over the samples and keeps one min/max
+ * summary per block of 1024 of them. Queries then classify each block from
+ * its summary alone: blocks that cannot contain a match are skipped, blocks
+ * that match entirely cost O(1), and only the blocks straddling the
+ * predicate boundary are re-scanned sample by sample. On typical data the
+ * matches are rare and clustered, so stepping through the events of a
+ * 100M-sample session touches a few thousand summaries and a handful of
+ * blocks.
+ *
+ * A "match" is the onset of the predicate, not every sample inside it:
+ * sample i matches when the predicate holds at i and did not hold at i-1
+ * (or i is the first sample). Jumping between matches therefore visits each
+ * excursion once, at the moment it starts.
+ *
+ * The query holds a reference to the series and indexes the samples present
+ * at construction time; build a new one after the series has grown or been
+ * trimmed. The caller is responsible for the usual locking if the series
+ * belongs to a live stream.
+ */
+class EventQuery
+{
+public:
+  enum class Predicate
+  {
+    GreaterThan,   ///< y > low
+    LessThan,      ///< y < low
+    InsideRange,   ///< low <= y <= high
+    OutsideRange   ///< y < low or y > high
+  };
+
+  EventQuery(const PlotDataXY& series, Predicate predicate, double low, double high = 0)
+    : _series(series), _predicate(predicate), _low(low), _high(high)
+  {
+    if ((predicate == Predicate::InsideRange || predicate == Predicate::OutsideRange) &&
+        _low > _high)
+    {
+      std::swap(_low, _high);
+    }
+    _indexed_points = series.size();
+    _blocks.reserve((_indexed_points + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    for (size_t i = 0; i < _indexed_points; i += BLOCK_SIZE)
+    {
+      const size_t block_end = std::min(_indexed_points, i + BLOCK_SIZE);
+      MinMax summary;
+      for (size_t j = i; j < block_end; j++)
+      {
+        const double y = _series.at(j).y;
+        summary.min = std::min(summary.min, y);
+        summary.max = std::max(summary.max, y);
+      }
+      _blocks.push_back(summary);
+    }
+  }
+
+  size_t indexedPoints() const
+  {
+    return _indexed_points;
+  }
+
+  /// Number of onsets in the whole indexed range. Lazily computed once;
+  /// only the straddling blocks are scanned.
+  size_t matchCount() const
+  {
+    if (!_match_count)
+    {
+      size_t count = 0;
+      bool prev = false;
+      for (size_t k = 0; k < _blocks.size(); k++)
+      {
+        switch (classify(_blocks[k]))
+        {
+          case BlockClass::NONE:
+            prev = false;
+            break;
+          case BlockClass::ALL:
+            count += prev ? 0 : 1;
+            prev = true;
+            break;
+          case BlockClass::PARTIAL:
+          {
+            const size_t block_end = std::min(_indexed_points, (k + 1) * BLOCK_SIZE);
+            for (size_t i = k * BLOCK_SIZE; i < block_end; i++)
+            {
+              const bool m = matches(_series.at(i).y);
+              count += (m && !prev) ? 1 : 0;
+              prev = m;
+            }
+            break;
+          }
+        }
+      }
+      _match_count = count;
+    }
+    return *_match_count;
+  }
+
+  /// Timestamp of the first onset strictly after `time`, if any.
+  std::optional<double> nextMatch(double time) const
+  {
+    const size_t start = firstIndexAfter(time);
+    if (start >= _indexed_points)
+    {
+      return std::nullopt;
+    }
+    bool prev = (start > 0) ? matches(_series.at(start - 1).y) : false;
+    size_t i = start;
+    for (size_t k = start / BLOCK_SIZE; k < _blocks.size(); k++)
+    {
+      const size_t block_end = std::min(_indexed_points, (k + 1) * BLOCK_SIZE);
+      switch (classify(_blocks[k]))
+      {
+        case BlockClass::NONE:
+          prev = false;
+          break;
+        case BlockClass::ALL:
+          if (!prev)
+          {
+            return _series.at(i).x;
+          }
+          prev = true;
+          break;
+        case BlockClass::PARTIAL:
+        {
+          for (; i < block_end; i++)
+          {
+            const bool m = matches(_series.at(i).y);
+            if (m && !prev)
+            {
+              return _series.at(i).x;
+            }
+            prev = m;
+          }
+          break;
+        }
+      }
+      i = block_end;
+    }
+    return std::nullopt;
+  }
+
+  /// Timestamp of the last onset strictly before `time`, if any.
+  std::optional<double> previousMatch(double time) const
+  {
+    const size_t after = firstIndexAtOrAfter(time);
+    if (after == 0)
+    {
+      return std::nullopt;
+    }
+    const size_t limit = after - 1;  // last index eligible to be the onset
+
+    for (size_t k = limit / BLOCK_SIZE + 1; k-- > 0;)
+    {
+      const size_t block_begin = k * BLOCK_SIZE;
+      const size_t block_end = std::min(limit + 1, std::min(_indexed_points, (k + 1) * BLOCK_SIZE));
+      switch (classify(_blocks[k]))
+      {
+        case BlockClass::NONE:
+          break;  // an onset needs a matching sample
+        case BlockClass::ALL:
+          // inside a block where every sample matches, the only possible
+          // onset is its first sample
+          if (block_begin == 0 || !matches(_series.at(block_begin - 1).y))
+          {
+            return _series.at(block_begin).x;
+          }
+          break;
+        case BlockClass::PARTIAL:
+        {
+          bool prev = (block_begin > 0) ? matches(_series.at(block_begin - 1).y) : false;
+          std::optional<size_t> last_onset;
+          for (size_t i = block_begin; i < block_end; i++)
+          {
+            const bool m = matches(_series.at(i).y);
+            if (m && !prev)
+            {
+              last_onset = i;
+            }
+            prev = m;
+          }
+          if (last_onset)
+          {
+            return _series.at(*last_onset).x;
+          }
+          break;
+        }
+      }
+    }
+    return std::nullopt;
+  }
+
+private:
+  static constexpr size_t BLOCK_SIZE = 1024;
+
+  enum class BlockClass
+  {
+    NONE,    ///< no sample of the block can match
+    ALL,     ///< every sample of the block matches
+    PARTIAL  ///< the summary cannot decide: scan the samples
+  };
+
+  bool matches(double y) const
+  {
+    switch (_predicate)
+    {
+      case Predicate::GreaterThan:
+        return y > _low;
+      case Predicate::LessThan:
+        return y < _low;
+      case Predicate::InsideRange:
+        return y >= _low && y <= _high;
+      case Predicate::OutsideRange:
+        return y < _low || y > _high;
+    }
+    return false;
+  }
+
+  BlockClass classify(const MinMax& block) const
+  {
+    switch (_predicate)
+    {
+      case Predicate::GreaterThan:
+        if (block.min > _low)
+        {
+          return BlockClass::ALL;
+        }
+        return (block.max > _low) ? BlockClass::PARTIAL : BlockClass::NONE;
+      case Predicate::LessThan:
+        if (block.max < _low)
+        {
+          return BlockClass::ALL;
+        }
+        return (block.min < _low) ? BlockClass::PARTIAL : BlockClass::NONE;
+      case Predicate::InsideRange:
+        if (block.min >= _low && block.max <= _high)
+        {
+          return BlockClass::ALL;
+        }
+        return (block.max < _low || block.min > _high) ? BlockClass::NONE : BlockClass::PARTIAL;
+      case Predicate::OutsideRange:
+        if (block.max < _low || block.min > _high)
+        {
+          return BlockClass::ALL;
+        }
+        return (block.min >= _low && block.max <= _high) ? BlockClass::NONE : BlockClass::PARTIAL;
+    }
+    return BlockClass::PARTIAL;
+  }
+
+  /// First index with x > time (timeseries samples are sorted by x).
+  size_t firstIndexAfter(double time) const
+  {
+    size_t lo = 0, hi = _indexed_points;
+    while (lo < hi)
+    {
+      const size_t mid = lo + (hi - lo) / 2;
+      (_series.at(mid).x > time) ? hi = mid : lo = mid + 1;
+    }
+    return lo;
+  }
+
+  /// First index with x >= time.
+  size_t firstIndexAtOrAfter(double time) const
+  {
+    size_t lo = 0, hi = _indexed_points;
+    while (lo < hi)
+    {
+      const size_t mid = lo + (hi - lo) / 2;
+      (_series.at(mid).x >= time) ? hi = mid : lo = mid + 1;
+    }
+    return lo;
+  }
+
+  const PlotDataXY& _series;
+  Predicate _predicate;
+  double _low;
+  double _high;
+  size_t _indexed_points = 0;
+  std::vector<MinMax> _blocks;
+  mutable std::optional<size_t> _match_count;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_EVENT_QUERY_HPP
@@ -0,0 +1,244 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_FAST_PARSE_HPP
+#define PJ_FAST_PARSE_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#if defined(__cpp_lib_to_chars)
+#include <charconv>
+#endif
+
+namespace PJ
+{
+/**
+ * Locale-independent string-to-double conversion, tuned for the text
+ * loaders (CSV, Influx line protocol, ...) where number conversion
+ * dominates the ingestion time.
+ *
+ * The common case — up to 19 significant digits and a small decimal
+ * exponent — is handled with SWAR digit scanning (8 digits per 64-bit
+ * load) and an exact power-of-ten multiplication, which is an order of
+ * magnitude faster than strtod / QLocale::toDouble. Anything unusual
+ * (very long mantissas, extreme exponents) falls back to the standard
+ * library, so the result is always correctly rounded.
+ *
+ * The whole range must be consumed: trailing garbage means failure,
+ * like QString::toDouble. Leading/trailing whitespace is NOT skipped.
+ */
+namespace fastparse
+{
+// true if all 8 bytes of the word are ASCII digits
+inline bool allEightDigits(uint64_t word)
+{
+  return ((word & 0xF0F0F0F0F0F0F0F0ULL) |
+          (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+         0x3333333333333333ULL;
+}
+
+// convert 8 ASCII digits (little-endian word) to their numeric value
+inline uint32_t parseEightDigits(uint64_t word)
+{
+  constexpr uint64_t mask = 0x000000FF000000FFULL;
+  constexpr uint64_t mul1 = 0x000F424000000064ULL;  // 100 + (1000000 << 32)
+  constexpr uint64_t mul2 = 0x0000271000000001ULL;  // 1 + (10000 << 32)
+  word -= 0x3030303030303030ULL;
+  word = (word * 10) + (word >> 8);  // base 100
+  word = (((word & mask) * mul1) + (((word >> 16) & mask) * mul2)) >> 32;
+  return static_cast<uint32_t>(word);
+}
+
+// slow but always correct; used for inputs outside the fast path
+inline std::optional<double> fallbackParse(const char* begin, const char* end)
+{
+#if defined(__cpp_lib_to_chars)
+  double value = 0;
+  auto res = std::from_chars(begin, end, value);
+  if (res.ec == std::errc() && res.ptr == end)
+  {
+    return value;
+  }
+  return std::nullopt;
+#else
+  // strtod needs a null-terminated copy; numeric locale is assumed to be
+  // "C"-compatible, as everywhere else strtod is used in this codebase
+  std::string copy(begin, end);
+  char* str_end = nullptr;
+  double value = std::strtod(copy.c_str(), &str_end);
+  if (str_end == copy.c_str() + copy.size())
+  {
+    return value;
+  }
+  return std::nullopt;
+#endif
+}
+
+inline bool matchCaseInsensitive(const char* ptr, const char* end, const char* word)
+{
+  for (; *word; word++, ptr++)
+  {
+    if (ptr == end || (*ptr | 0x20) != *word)
+    {
+      return false;
+    }
+  }
+  return ptr == end;
+}
+}  // namespace fastparse
+
+inline std::optional<double> FastParseDouble(const char* begin, const char* end)
+{
+  namespace fp = fastparse;
+
+  const char* ptr = begin;
+  if (ptr == end)
+  {
+    return std::nullopt;
+  }
+
+  bool negative = false;
+  if (*ptr == '+' || *ptr == '-')
+  {
+    negative = (*ptr == '-');
+    ptr++;
+  }
+
+  if (ptr != end && ((*ptr | 0x20) == 'i' || (*ptr | 0x20) == 'n'))
+  {
+    if (fp::matchCaseInsensitive(ptr, end, "inf") || fp::matchCaseInsensitive(ptr, end, "infinity"))
+    {
+      const double inf = std::numeric_limits<double>::infinity();
+      return negative ? -inf : inf;
+    }
+    if (fp::matchCaseInsensitive(ptr, end, "nan"))
+    {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    return std::nullopt;
+  }
+
+  uint64_t mantissa = 0;
+  int digit_count = 0;
+  int exponent = 0;
+
+  // integer part
+  while (end - ptr >= 8 && digit_count + 8 <= 19)
+  {
+    uint64_t word;
+    std::memcpy(&word, ptr, 8);
+    if (!fp::allEightDigits(word))
+    {
+      break;
+    }
+    mantissa = mantissa * 100000000 + fp::parseEightDigits(word);
+    digit_count += 8;
+    ptr += 8;
+  }
+  while (ptr != end && *ptr >= '0' && *ptr <= '9')
+  {
+    if (++digit_count > 19)
+    {
+      return fp::fallbackParse(begin, end);
+    }
+    mantissa = mantissa * 10 + uint64_t(*ptr - '0');
+    ptr++;
+  }
+
+  // fractional part
+  if (ptr != end && *ptr == '.')
+  {
+    ptr++;
+    while (end - ptr >= 8 && digit_count + 8 <= 19)
+    {
+      uint64_t word;
+      std::memcpy(&word, ptr, 8);
+      if (!fp::allEightDigits(word))
+      {
+        break;
+      }
+      mantissa = mantissa * 100000000 + fp::parseEightDigits(word);
+      digit_count += 8;
+      exponent -= 8;
+      ptr += 8;
+    }
+    while (ptr != end && *ptr >= '0' && *ptr <= '9')
+    {
+      if (++digit_count > 19)
+      {
+        return fp::fallbackParse(begin, end);
+      }
+      mantissa = mantissa * 10 + uint64_t(*ptr - '0');
+      exponent--;
+      ptr++;
+    }
+  }
+
+  if (digit_count == 0)
+  {
+    return std::nullopt;
+  }
+
+  // explicit exponent
+  if (ptr != end && (*ptr | 0x20) == 'e')
+  {
+    ptr++;
+    bool exp_negative = false;
+    if (ptr != end && (*ptr == '+' || *ptr == '-'))
+    {
+      exp_negative = (*ptr == '-');
+      ptr++;
+    }
+    if (ptr == end || *ptr < '0' || *ptr > '9')
+    {
+      return std::nullopt;
+    }
+    int explicit_exp = 0;
+    while (ptr != end && *ptr >= '0' && *ptr <= '9')
+    {
+      if (explicit_exp < 10000)
+      {
+        explicit_exp = explicit_exp * 10 + (*ptr - '0');
+      }
+      ptr++;
+    }
+    exponent += exp_negative ? -explicit_exp : explicit_exp;
+  }
+
+  if (ptr != end)
+  {
+    return std::nullopt;  // trailing garbage
+  }
+
+  // Exact fast path: both the mantissa and the power of ten are exactly
+  // representable, so a single multiplication/division rounds correctly.
+  static constexpr double POWERS_OF_TEN[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                              1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                              1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+  if (mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+  {
+    double value = static_cast<double>(mantissa);
+    value = (exponent >= 0) ? value * POWERS_OF_TEN[exponent] : value / POWERS_OF_TEN[-exponent];
+    return negative ? -value : value;
+  }
+
+  return fp::fallbackParse(begin, end);
+}
+
+inline std::optional<double> FastParseDouble(std::string_view str)
+{
+  return FastParseDouble(str.data(), str.data() + str.size());
+}
+
+}  // namespace PJ
+
+#endif  // PJ_FAST_PARSE_HPP
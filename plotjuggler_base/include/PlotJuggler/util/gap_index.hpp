@@ -0,0 +1,129 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_GAP_INDEX_HPP
+#define PJ_GAP_INDEX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace PJ
+{
+/**
+ * @brief Index of the time holes of a series.
+ *
+ * Non-finite samples are dropped at ingest, so an outage of the producer
+ * shows up as a large step between two consecutive timestamps. This index
+ * records the left timestamp of every step larger than GAP_FACTOR times
+ * the median sampling interval, so that painting can split the curve into
+ * one polyline per run of contiguous samples without scanning the
+ * timestamps on every frame.
+ *
+ * Like MinMaxIndex, it is maintained incrementally while the series grows
+ * in the back and rebuilt from scratch when the series shrinks or its
+ * first sample changes. The median interval is re-estimated whenever the
+ * series doubles in size, so the amortized cost per appended sample is
+ * O(1).
+ */
+class GapIndex
+{
+public:
+  /// A hole is a step larger than this multiple of the median interval
+  static constexpr double GAP_FACTOR = 10.0;
+
+  /// A series with more than one hole every MIN_SAMPLES_PER_GAP samples
+  /// is irregular rather than gappy (e.g. sporadic events): the index
+  /// disables itself and the curve is painted as a single polyline.
+  static constexpr size_t MIN_SAMPLES_PER_GAP = 16;
+
+  void clear()
+  {
+    _gap_start_x.clear();
+    _indexed_count = 0;
+    _threshold_count = 0;
+    _front_x = 0.0;
+    _threshold = 0.0;
+  }
+
+  /// Bring the index up to date with the series. Amortized O(appended).
+  template <typename Series>
+  void update(const Series& data)
+  {
+    const size_t count = data.size();
+    if (count < 2)
+    {
+      clear();
+      return;
+    }
+    if (count < _indexed_count || (_indexed_count > 0 && data[0].x != _front_x) ||
+        count >= 2 * _threshold_count)
+    {
+      clear();
+    }
+    if (_threshold_count == 0)
+    {
+      _threshold = estimateThreshold(data, count);
+      _threshold_count = count;
+    }
+    if (_threshold > 0.0)
+    {
+      for (size_t i = std::max<size_t>(_indexed_count, 1); i < count; i++)
+      {
+        if (double(data[i].x) - double(data[i - 1].x) > _threshold)
+        {
+          _gap_start_x.push_back(data[i - 1].x);
+        }
+      }
+      if (_gap_start_x.size() * MIN_SAMPLES_PER_GAP > count)
+      {
+        // irregular: stop detecting until the next full rebuild
+        _gap_start_x.clear();
+        _threshold = 0.0;
+      }
+    }
+    _indexed_count = count;
+    _front_x = data[0].x;
+  }
+
+  /// Left timestamp of each hole, sorted. Call update() first.
+  const std::vector<double>& gapStarts() const
+  {
+    return _gap_start_x;
+  }
+
+private:
+  /// Median interval of up to MAX_PROBES steps sampled evenly across the
+  /// series, scaled by GAP_FACTOR. Zero (index disabled) when the median
+  /// is not positive, i.e. duplicated timestamps dominate.
+  template <typename Series>
+  static double estimateThreshold(const Series& data, size_t count)
+  {
+    constexpr size_t MAX_PROBES = 512;
+
+    const size_t stride = std::max<size_t>(1, (count - 1) / MAX_PROBES);
+    std::vector<double> steps;
+    steps.reserve((count - 1) / stride + 1);
+    for (size_t i = 1; i < count; i += stride)
+    {
+      steps.push_back(double(data[i].x) - double(data[i - 1].x));
+    }
+    auto median = steps.begin() + steps.size() / 2;
+    std::nth_element(steps.begin(), median, steps.end());
+    return (*median > 0.0) ? GAP_FACTOR * *median : 0.0;
+  }
+
+  std::vector<double> _gap_start_x;
+  size_t _indexed_count = 0;
+  /// series size when _threshold was estimated; 0 forces a new estimate
+  size_t _threshold_count = 0;
+  double _front_x = 0.0;
+  double _threshold = 0.0;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_GAP_INDEX_HPP
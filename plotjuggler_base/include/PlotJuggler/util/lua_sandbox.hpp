@@ -0,0 +1,42 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_LUA_SANDBOX_HPP
+#define PJ_LUA_SANDBOX_HPP
+
+#include <sol/sol.hpp>
+
+namespace PJ
+{
+/**
+ * @brief Apply the safety policy shared by every Lua state in the
+ * application. Call it right after open_libraries().
+ *
+ * With the reference engine this is a no-op. When the build is backed by
+ * LuaJIT (USE_LUAJIT), the ffi module is unregistered so user scripts
+ * keep the speed of the JIT without gaining the ability to call
+ * arbitrary native code.
+ */
+inline void SanitizeLuaEngine(sol::state& lua)
+{
+#if defined(LUAJIT_VERSION)
+  // LuaJIT registers ffi in package.preload rather than as a global;
+  // clearing both places makes require("ffi") fail as well
+  lua.script(R"(
+    if package ~= nil then
+      package.preload.ffi = nil
+      package.loaded.ffi = nil
+    end
+    ffi = nil
+  )");
+#else
+  (void)lua;
+#endif
+}
+
+}  // namespace PJ
+
+#endif  // PJ_LUA_SANDBOX_HPP
@@ -0,0 +1,188 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_MINMAX_INDEX_HPP
+#define PJ_MINMAX_INDEX_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "PlotJuggler/plotdatabase.h"
+#include "PlotJuggler/util/simd_minmax.hpp"
+
+namespace PJ
+{
+/**
+ * @brief Hierarchical min/max index over the Y values of a series.
+ *
+ * Level 0 stores the min/max of each complete block of BLOCK_SIZE
+ * samples; every level above aggregates BLOCK_SIZE entries of the level
+ * below. A sub-range query then touches O(BLOCK_SIZE * log n) entries
+ * instead of scanning every sample, which is what makes
+ * getVisualizationRangeY() usable while zooming on multi-million-point
+ * series.
+ *
+ * The index is maintained incrementally while the series grows in the
+ * back (the common streaming and file-loading case). If the series
+ * shrinks or its first sample changes — e.g. trimmed by
+ * setMaximumRangeX(), where the size is bounded anyway — it is rebuilt
+ * from scratch.
+ */
+class MinMaxIndex
+{
+public:
+  static constexpr size_t BLOCK_SIZE = 64;
+
+  void clear()
+  {
+    _levels.clear();
+    _indexed_count = 0;
+    _front_x = 0.0;
+  }
+
+  /// Bring the index up to date with the series. Amortized O(appended).
+  template <typename Series>
+  void update(const Series& data)
+  {
+    const size_t count = data.size();
+    if (count == 0)
+    {
+      clear();
+      return;
+    }
+    if (count < _indexed_count || (_indexed_count > 0 && data[0].x != _front_x))
+    {
+      clear();
+    }
+    if (_levels.empty())
+    {
+      _levels.emplace_back();
+    }
+    // only complete blocks are indexed; the tail is scanned by rangeY()
+    const size_t total_blocks = count / BLOCK_SIZE;
+    for (size_t block = _levels[0].size(); block < total_blocks; block++)
+    {
+      MinMax mm;
+      const size_t begin = block * BLOCK_SIZE;
+      for (size_t i = begin; i < begin + BLOCK_SIZE; i++)
+      {
+        const double y = data[i].y;
+        mm.min = std::min(mm.min, y);
+        mm.max = std::max(mm.max, y);
+      }
+      appendEntry(mm);
+    }
+    _indexed_count = total_blocks * BLOCK_SIZE;
+    _front_x = data[0].x;
+  }
+
+  /// Min/max of samples in [first_index, last_index], inclusive.
+  /// Call update() first.
+  template <typename Series>
+  Range rangeY(const Series& data, size_t first_index, size_t last_index) const
+  {
+    MinMax out;
+    const size_t last_excl = last_index + 1;
+    const size_t indexed_blocks = _levels.empty() ? 0 : _levels[0].size();
+    const size_t first_block = (first_index + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const size_t last_block = std::min(last_excl / BLOCK_SIZE, indexed_blocks);
+
+    if (first_block >= last_block)
+    {
+      scanSamples(data, first_index, last_excl, out);
+      return { out.min, out.max };
+    }
+    // partial head/tail (including the not-yet-indexed back of the series)
+    scanSamples(data, first_index, first_block * BLOCK_SIZE, out);
+    scanSamples(data, last_block * BLOCK_SIZE, last_excl, out);
+    queryLevel(0, first_block, last_block, out);
+    return { out.min, out.max };
+  }
+
+private:
+  template <typename Series>
+  static void scanSamples(const Series& data, size_t begin, size_t end, MinMax& out)
+  {
+    for (size_t i = begin; i < end; i++)
+    {
+      const double y = data[i].y;
+      out.min = std::min(out.min, y);
+      out.max = std::max(out.max, y);
+    }
+  }
+
+  void appendEntry(MinMax mm)
+  {
+    size_t index = _levels[0].size();
+    _levels[0].push_back(mm);
+
+    for (size_t level = 1;; level++)
+    {
+      index /= BLOCK_SIZE;
+      if (_levels.size() <= level)
+      {
+        // a new level pays off only once the one below outgrows a block;
+        // seed its first entry from the children already present
+        if (_levels[level - 1].size() <= BLOCK_SIZE)
+        {
+          break;
+        }
+        MinMax seed = _levels[level - 1][0];
+        for (size_t i = 1; i < BLOCK_SIZE; i++)
+        {
+          Merge(seed, _levels[level - 1][i]);
+        }
+        _levels.emplace_back();
+        _levels[level].push_back(seed);
+      }
+      auto& entries = _levels[level];
+      if (index >= entries.size())
+      {
+        entries.push_back(mm);
+      }
+      else
+      {
+        Merge(entries[index], mm);
+      }
+    }
+  }
+
+  /// Merge entries [first, last) of the given level, delegating
+  /// block-aligned middle sections to the level above.
+  void queryLevel(size_t level, size_t first, size_t last, MinMax& out) const
+  {
+    if (level + 1 < _levels.size())
+    {
+      const size_t first_aligned = (first + BLOCK_SIZE - 1) / BLOCK_SIZE;
+      const size_t last_aligned = last / BLOCK_SIZE;
+      if (first_aligned < last_aligned)
+      {
+        for (size_t i = first; i < first_aligned * BLOCK_SIZE; i++)
+        {
+          Merge(out, _levels[level][i]);
+        }
+        for (size_t i = last_aligned * BLOCK_SIZE; i < last; i++)
+        {
+          Merge(out, _levels[level][i]);
+        }
+        queryLevel(level + 1, first_aligned, last_aligned, out);
+        return;
+      }
+    }
+    for (size_t i = first; i < last; i++)
+    {
+      Merge(out, _levels[level][i]);
+    }
+  }
+
+  std::vector<std::vector<MinMax>> _levels;
+  size_t _indexed_count = 0;
+  double _front_x = 0.0;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_MINMAX_INDEX_HPP
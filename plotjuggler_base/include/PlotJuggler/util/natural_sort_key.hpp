@@ -0,0 +1,71 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_NATURAL_SORT_KEY_HPP
+#define PJ_NATURAL_SORT_KEY_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace PJ
+{
+/**
+ * @brief Binary key whose plain byte-wise comparison reproduces the
+ * natural ("alphanum") ordering of doj::alphanum_impl().
+ *
+ * The key is computed once per name and compared with
+ * std::string::operator< (a memcmp), instead of re-tokenizing both
+ * strings on every comparison; this is what makes re-sorting the curve
+ * list after a bulk import cheap.
+ *
+ * Encoding: non-digit bytes are copied verbatim. A digit run is
+ * replaced by the marker byte 0x01 — which sorts below every printable
+ * character, like alphanum_impl() sorts numbers before text — followed
+ * by the number of significant digits as a 4-byte big-endian count and
+ * the digits themselves with leading zeros stripped. Between two
+ * numbers, a shorter digit count means a smaller value, and equal
+ * counts compare digit by digit; "007" and "7" produce the same key
+ * segment, matching the value-based comparison of alphanum_impl().
+ */
+inline std::string NaturalSortKey(std::string_view name)
+{
+  std::string key;
+  key.reserve(name.size() + 8);
+
+  size_t i = 0;
+  while (i < name.size())
+  {
+    const char c = name[i];
+    if (c < '0' || c > '9')
+    {
+      key.push_back(c);
+      i++;
+      continue;
+    }
+    while (i < name.size() && name[i] == '0')
+    {
+      i++;
+    }
+    const size_t digits_begin = i;
+    while (i < name.size() && name[i] >= '0' && name[i] <= '9')
+    {
+      i++;
+    }
+    const uint32_t digits_count = uint32_t(i - digits_begin);
+    key.push_back('\x01');
+    key.push_back(char(digits_count >> 24));
+    key.push_back(char(digits_count >> 16));
+    key.push_back(char(digits_count >> 8));
+    key.push_back(char(digits_count));
+    key.append(name.substr(digits_begin, digits_count));
+  }
+  return key;
+}
+
+}  // namespace PJ
+
+#endif  // PJ_NATURAL_SORT_KEY_HPP
@@ -0,0 +1,157 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_PERF_MONITOR_HPP
+#define PJ_PERF_MONITOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace PJ
+{
+/**
+ * @brief Process-wide registry of scoped timings for the hot paths
+ * (replot, transform caches, streamer ingest...).
+ *
+ * Disabled by default: in that state a PerfScope costs one relaxed
+ * atomic load and never touches the clock, so the instrumentation can
+ * stay in release builds. When enabled (e.g. by the in-app overlay),
+ * each scope records its duration into a small per-name ring buffer
+ * from which snapshot() derives count, p50 and p99.
+ */
+class PerfMonitor
+{
+public:
+  struct Stats
+  {
+    std::string name;
+    uint64_t count = 0;
+    double last_ms = 0;
+    double p50_ms = 0;
+    double p99_ms = 0;
+  };
+
+  static PerfMonitor& instance()
+  {
+    static PerfMonitor monitor;
+    return monitor;
+  }
+
+  static bool enabled()
+  {
+    return instance()._enabled.load(std::memory_order_relaxed);
+  }
+
+  static void setEnabled(bool enabled)
+  {
+    instance()._enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  void addSample(const std::string& name, uint64_t duration_ns)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& track = _tracks[name];
+    track.samples[track.count % Track::CAPACITY] = duration_ns;
+    track.count++;
+  }
+
+  std::vector<Stats> snapshot() const
+  {
+    std::vector<Stats> out;
+    std::lock_guard<std::mutex> lock(_mutex);
+    out.reserve(_tracks.size());
+    for (const auto& [name, track] : _tracks)
+    {
+      const size_t used = std::min<uint64_t>(track.count, Track::CAPACITY);
+      if (used == 0)
+      {
+        continue;
+      }
+      std::array<uint64_t, Track::CAPACITY> sorted;
+      std::copy(track.samples.begin(), track.samples.begin() + used, sorted.begin());
+      std::sort(sorted.begin(), sorted.begin() + used);
+
+      Stats stats;
+      stats.name = name;
+      stats.count = track.count;
+      stats.last_ms = double(track.samples[(track.count - 1) % Track::CAPACITY]) * 1e-6;
+      stats.p50_ms = double(sorted[used / 2]) * 1e-6;
+      stats.p99_ms = double(sorted[(used * 99) / 100]) * 1e-6;
+      out.push_back(std::move(stats));
+    }
+    return out;
+  }
+
+  void reset()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tracks.clear();
+  }
+
+private:
+  struct Track
+  {
+    static constexpr size_t CAPACITY = 256;
+    std::array<uint64_t, CAPACITY> samples;
+    uint64_t count = 0;
+  };
+
+  mutable std::mutex _mutex;
+  std::map<std::string, Track> _tracks;
+  std::atomic<bool> _enabled{ false };
+};
+
+/// RAII timer feeding PerfMonitor. Use a string literal for fixed scopes
+/// and the std::string overload for per-plugin / per-curve names.
+class PerfScope
+{
+public:
+  explicit PerfScope(const char* name)
+  {
+    if (PerfMonitor::enabled())
+    {
+      _name = name;
+      _start = std::chrono::steady_clock::now();
+    }
+  }
+
+  explicit PerfScope(std::string name)
+  {
+    if (PerfMonitor::enabled())
+    {
+      _name = std::move(name);
+      _start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~PerfScope()
+  {
+    if (!_name.empty())
+    {
+      const auto duration = std::chrono::steady_clock::now() - _start;
+      PerfMonitor::instance().addSample(
+          _name, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+  }
+
+  PerfScope(const PerfScope&) = delete;
+  PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+  std::string _name;
+  std::chrono::steady_clock::time_point _start;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_PERF_MONITOR_HPP
@@ -0,0 +1,347 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_READAHEAD_FILE_HPP
+#define PJ_READAHEAD_FILE_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace PJ
+{
+/**
+ * @brief Random-access reads over a local file, with a background thread
+ * prefetching ahead of sequential scans.
+ *
+ * The local counterpart of RemoteFileReader: reads are rounded to
+ * fixed-size blocks kept in an LRU cache, and every sequential access
+ * extends a readahead window that a dedicated thread keeps filled,
+ * PREFETCH_DEPTH blocks ahead of the consumer. On a network filesystem
+ * (or a cold page cache) the parser then decodes block N while the
+ * kernel fetches block N+1..N+4, instead of stalling on every read; on
+ * an already-cached file the overhead is one extra memcpy per read.
+ * Random seeks - index and footer lookups in practice - bypass the
+ * window and are served with a direct positioned read.
+ *
+ * The block cache is only touched under its mutex, so read() may be
+ * called from any one thread at a time while the prefetcher runs.
+ */
+class ReadaheadFileReader
+{
+public:
+  static constexpr uint64_t DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+  static constexpr size_t DEFAULT_MAX_BLOCKS = 16;  // 64 MB of cache
+  static constexpr uint64_t PREFETCH_DEPTH = 4;     // blocks kept in flight
+
+  explicit ReadaheadFileReader(uint64_t block_size = DEFAULT_BLOCK_SIZE,
+                               size_t max_cached_blocks = DEFAULT_MAX_BLOCKS)
+    : _block_size(std::max<uint64_t>(1, block_size))
+    , _max_cached_blocks(std::max<size_t>(2, max_cached_blocks))
+  {
+  }
+
+  ~ReadaheadFileReader()
+  {
+    close();
+  }
+
+  ReadaheadFileReader(const ReadaheadFileReader&) = delete;
+  ReadaheadFileReader& operator=(const ReadaheadFileReader&) = delete;
+
+  bool open(const std::string& path, std::string* error = nullptr)
+  {
+    close();
+#if !defined(_WIN32)
+    _fd = ::open(path.c_str(), O_RDONLY);
+    if (_fd < 0)
+    {
+      setError(error, "can't open file: " + path);
+      return false;
+    }
+    struct stat st;
+    if (fstat(_fd, &st) != 0)
+    {
+      close();
+      setError(error, "can't stat file: " + path);
+      return false;
+    }
+    _file_size = uint64_t(st.st_size);
+#if defined(POSIX_FADV_SEQUENTIAL)
+    // loaders scan mostly forward: let the kernel readahead help too
+    posix_fadvise(_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#else
+    _file = std::fopen(path.c_str(), "rb");
+    if (!_file)
+    {
+      setError(error, "can't open file: " + path);
+      return false;
+    }
+    _fseeki64(_file, 0, SEEK_END);
+    _file_size = uint64_t(_ftelli64(_file));
+#endif
+    _shutdown = false;
+    _prefetcher = std::thread([this]() { prefetchLoop(); });
+    return true;
+  }
+
+  void close()
+  {
+    if (_prefetcher.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _shutdown = true;
+      }
+      _wakeup.notify_one();
+      _prefetcher.join();
+    }
+#if !defined(_WIN32)
+    if (_fd >= 0)
+    {
+      ::close(_fd);
+      _fd = -1;
+    }
+#else
+    if (_file)
+    {
+      std::fclose(_file);
+      _file = nullptr;
+    }
+#endif
+    _blocks.clear();
+    _lru.clear();
+    _file_size = 0;
+    _last_block = std::numeric_limits<uint64_t>::max();
+    _prefetch_next = 0;
+    _prefetch_limit = 0;
+  }
+
+  uint64_t size() const
+  {
+    return _file_size;
+  }
+
+  /// Copy [offset, offset + count) into dest. Returns the number of
+  /// bytes copied, which is smaller than count past the end of the file
+  /// or when a read fails.
+  uint64_t read(uint64_t offset, uint8_t* dest, uint64_t count)
+  {
+    if (offset >= _file_size)
+    {
+      return 0;
+    }
+    count = std::min(count, _file_size - offset);
+
+    uint64_t copied = 0;
+    while (copied < count)
+    {
+      const uint64_t pos = offset + copied;
+      const std::vector<uint8_t>* block = getBlock(pos / _block_size);
+      if (!block)
+      {
+        break;
+      }
+      const uint64_t block_offset = pos % _block_size;
+      if (block_offset >= uint64_t(block->size()))
+      {
+        break;  // truncated read
+      }
+      const uint64_t chunk = std::min(count - copied, uint64_t(block->size()) - block_offset);
+      std::memcpy(dest + copied, block->data() + block_offset, size_t(chunk));
+      copied += chunk;
+    }
+    return copied;
+  }
+
+private:
+  struct CacheEntry
+  {
+    std::vector<uint8_t> data;
+    std::list<uint64_t>::iterator lru_it;
+  };
+
+  static void setError(std::string* error, const std::string& message)
+  {
+    if (error)
+    {
+      *error = message;
+    }
+  }
+
+  /// Positioned read of one whole block; thread-safe, so the consumer
+  /// and the prefetcher can both issue it.
+  std::vector<uint8_t> readBlockFromFile(uint64_t block_index)
+  {
+    const uint64_t begin = block_index * _block_size;
+    if (begin >= _file_size)
+    {
+      return {};
+    }
+    std::vector<uint8_t> data(size_t(std::min(_block_size, _file_size - begin)));
+#if !defined(_WIN32)
+    size_t done = 0;
+    while (done < data.size())
+    {
+      const ssize_t n = pread(_fd, data.data() + done, data.size() - done, off_t(begin + done));
+      if (n <= 0)
+      {
+        data.resize(done);
+        break;
+      }
+      done += size_t(n);
+    }
+#else
+    // no pread on Windows: serialize seek + read on the shared handle
+    std::lock_guard<std::mutex> lock(_file_mutex);
+    _fseeki64(_file, int64_t(begin), SEEK_SET);
+    data.resize(std::fread(data.data(), 1, data.size(), _file));
+#endif
+    return data;
+  }
+
+  /// Insert under _mutex; the caller holds the lock.
+  void insertBlock(uint64_t block_index, std::vector<uint8_t> data)
+  {
+    if (_blocks.count(block_index) != 0)
+    {
+      return;
+    }
+    while (_blocks.size() >= _max_cached_blocks)
+    {
+      _blocks.erase(_lru.back());
+      _lru.pop_back();
+    }
+    _lru.push_front(block_index);
+    _blocks[block_index] = CacheEntry{ std::move(data), _lru.begin() };
+  }
+
+  const std::vector<uint8_t>* getBlock(uint64_t block_index)
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto it = _blocks.find(block_index);
+    if (it == _blocks.end())
+    {
+      const bool sequential = (block_index == _last_block + 1 || block_index == _last_block);
+      if (sequential && _prefetch_next <= block_index && block_index < _prefetch_limit)
+      {
+        // the prefetcher is on its way here (or reading this very
+        // block): wait for it instead of reading the block twice
+        _block_ready.wait(lock, [&]() {
+          return _blocks.count(block_index) != 0 ||
+                 (_prefetch_next > block_index && _in_flight != block_index) || _shutdown;
+        });
+        it = _blocks.find(block_index);
+      }
+      if (it == _blocks.end())
+      {
+        if (!sequential)
+        {
+          // a seek makes the pending window stale: stop wasting I/O on it
+          _prefetch_limit = _prefetch_next;
+        }
+        lock.unlock();
+        std::vector<uint8_t> data = readBlockFromFile(block_index);
+        lock.lock();
+        if (data.empty())
+        {
+          return nullptr;
+        }
+        insertBlock(block_index, std::move(data));
+        it = _blocks.find(block_index);
+      }
+    }
+    _lru.splice(_lru.begin(), _lru, it->second.lru_it);
+
+    // every consumed block extends the readahead window, keeping
+    // PREFETCH_DEPTH blocks in flight ahead of a sequential scan
+    if (block_index == _last_block + 1 || block_index == _last_block)
+    {
+      _prefetch_next = std::max(_prefetch_next, block_index + 1);
+      _prefetch_limit = block_index + 1 + PREFETCH_DEPTH;
+      _wakeup.notify_one();
+    }
+    _last_block = block_index;
+    return &it->second.data;
+  }
+
+  void prefetchLoop()
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+      _wakeup.wait(lock, [&]() { return _shutdown || _prefetch_next < _prefetch_limit; });
+      if (_shutdown)
+      {
+        return;
+      }
+      const uint64_t block_index = _prefetch_next++;
+      if (_blocks.count(block_index) != 0 || block_index * _block_size >= _file_size)
+      {
+        _block_ready.notify_one();
+        continue;
+      }
+      _in_flight = block_index;
+      lock.unlock();
+      std::vector<uint8_t> data = readBlockFromFile(block_index);
+      lock.lock();
+      _in_flight = std::numeric_limits<uint64_t>::max();
+      if (!data.empty())
+      {
+        insertBlock(block_index, std::move(data));
+      }
+      _block_ready.notify_one();
+    }
+  }
+
+  uint64_t _block_size;
+  size_t _max_cached_blocks;
+
+#if !defined(_WIN32)
+  int _fd = -1;
+#else
+  std::FILE* _file = nullptr;
+  std::mutex _file_mutex;
+#endif
+  uint64_t _file_size = 0;
+
+  std::mutex _mutex;
+  std::condition_variable _wakeup;       // consumer -> prefetcher
+  std::condition_variable _block_ready;  // prefetcher -> consumer
+  bool _shutdown = false;
+
+  std::unordered_map<uint64_t, CacheEntry> _blocks;
+  std::list<uint64_t> _lru;  // front = most recently used
+
+  // +1 wraps to 0, so the very first read of block 0 counts as sequential
+  uint64_t _last_block = std::numeric_limits<uint64_t>::max();
+  uint64_t _prefetch_next = 0;   // next block the prefetcher will read
+  uint64_t _prefetch_limit = 0;  // one past the last block to prefetch
+  // block the prefetcher is reading right now, max() when idle
+  uint64_t _in_flight = std::numeric_limits<uint64_t>::max();
+
+  std::thread _prefetcher;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_READAHEAD_FILE_HPP
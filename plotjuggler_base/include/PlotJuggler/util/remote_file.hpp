@@ -0,0 +1,305 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_REMOTE_FILE_HPP
+#define PJ_REMOTE_FILE_HPP
+
+#include <QEventLoop>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QString>
+#include <QUrl>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <unordered_map>
+
+namespace PJ
+{
+/**
+ * @brief Random-access reads over a remote HTTP(S) file, served with
+ * Range requests.
+ *
+ * Indexed formats (MCAP being the main consumer) only touch the summary
+ * section and the chunks that match the selected topics and time window,
+ * so a multi-gigabyte file on S3/MinIO can be opened without downloading
+ * it first. Reads are rounded to fixed-size blocks kept in an LRU cache,
+ * and after every block downloaded the next one is requested
+ * asynchronously: sequential scans overlap the network transfer with the
+ * caller's decompression and parsing.
+ *
+ * Not thread-safe, and reads spin a local QEventLoop while a transfer is
+ * in flight: use it from a thread that can process Qt events, the way
+ * the loaders already do with QApplication::processEvents().
+ */
+class RemoteFileReader
+{
+public:
+  static constexpr uint64_t DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+  static constexpr size_t DEFAULT_MAX_BLOCKS = 64;  // 256 MB of cache
+
+  static bool IsRemoteUrl(const QString& path)
+  {
+    return path.startsWith("http://", Qt::CaseInsensitive) ||
+           path.startsWith("https://", Qt::CaseInsensitive);
+  }
+
+  explicit RemoteFileReader(const QString& url, uint64_t block_size = DEFAULT_BLOCK_SIZE,
+                            size_t max_cached_blocks = DEFAULT_MAX_BLOCKS)
+    : _url(url)
+    , _block_size(std::max<uint64_t>(1, block_size))
+    , _max_cached_blocks(std::max<size_t>(2, max_cached_blocks))
+  {
+  }
+
+  ~RemoteFileReader()
+  {
+    abortReadahead();
+  }
+
+  RemoteFileReader(const RemoteFileReader&) = delete;
+  RemoteFileReader& operator=(const RemoteFileReader&) = delete;
+
+  /**
+   * Probe the server with a HEAD request: the file size comes from
+   * Content-Length and range support from "Accept-Ranges: bytes".
+   * Servers that omit the header on HEAD (some S3-compatible ones do)
+   * get a second chance with a one byte range GET.
+   */
+  bool open(QString* error = nullptr)
+  {
+    QNetworkRequest request = makeRequest();
+    QNetworkReply* reply = _network.head(request);
+    waitForFinished(reply);
+
+    const bool head_ok = (reply->error() == QNetworkReply::NoError);
+    const QString head_error = reply->errorString();
+    const QVariant length = reply->header(QNetworkRequest::ContentLengthHeader);
+    const bool advertises_ranges = (reply->rawHeader("Accept-Ranges").toLower() == "bytes");
+    reply->deleteLater();
+
+    if (!head_ok || !length.isValid())
+    {
+      setError(error, head_ok ? QString("the server did not report the file size") :
+                                head_error);
+      return false;
+    }
+    _file_size = length.toULongLong();
+
+    if (!advertises_ranges)
+    {
+      QNetworkRequest probe = makeRequest();
+      probe.setRawHeader("Range", "bytes=0-0");
+      QNetworkReply* probe_reply = _network.get(probe);
+      waitForFinished(probe_reply);
+      const int status =
+          probe_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+      probe_reply->deleteLater();
+      if (status != 206)  // Partial Content
+      {
+        setError(error, "the server does not support HTTP range requests");
+        return false;
+      }
+    }
+    return true;
+  }
+
+  uint64_t size() const
+  {
+    return _file_size;
+  }
+
+  /// Total bytes transferred so far, readahead included.
+  uint64_t downloadedBytes() const
+  {
+    return _downloaded_bytes;
+  }
+
+  /// Copy [offset, offset + count) into dest. Returns the number of
+  /// bytes copied, which is smaller than count past the end of the file
+  /// or when a transfer fails.
+  uint64_t read(uint64_t offset, uint8_t* dest, uint64_t count)
+  {
+    if (offset >= _file_size)
+    {
+      return 0;
+    }
+    count = std::min(count, _file_size - offset);
+
+    uint64_t copied = 0;
+    while (copied < count)
+    {
+      const uint64_t pos = offset + copied;
+      const QByteArray* block = getBlock(pos / _block_size);
+      if (!block)
+      {
+        break;
+      }
+      const uint64_t block_offset = pos % _block_size;
+      if (block_offset >= uint64_t(block->size()))
+      {
+        break;  // truncated transfer
+      }
+      const uint64_t chunk =
+          std::min(count - copied, uint64_t(block->size()) - block_offset);
+      std::memcpy(dest + copied, block->constData() + block_offset, size_t(chunk));
+      copied += chunk;
+    }
+    return copied;
+  }
+
+private:
+  struct CacheEntry
+  {
+    QByteArray data;
+    std::list<uint64_t>::iterator lru_it;
+  };
+
+  QNetworkRequest makeRequest() const
+  {
+    QNetworkRequest request{ QUrl(_url) };
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    return request;
+  }
+
+  static void setError(QString* error, const QString& message)
+  {
+    if (error)
+    {
+      *error = message;
+    }
+  }
+
+  static void waitForFinished(QNetworkReply* reply)
+  {
+    if (!reply->isFinished())
+    {
+      QEventLoop loop;
+      QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+      loop.exec();
+    }
+  }
+
+  QNetworkReply* startFetch(uint64_t block_index)
+  {
+    const uint64_t begin = block_index * _block_size;
+    const uint64_t end = std::min(begin + _block_size, _file_size) - 1;
+    QNetworkRequest request = makeRequest();
+    request.setRawHeader("Range", "bytes=" + QByteArray::number(qulonglong(begin)) + "-" +
+                                      QByteArray::number(qulonglong(end)));
+    return _network.get(request);
+  }
+
+  /// Collect a finished (or awaited) reply; empty on failure.
+  QByteArray collectReply(QNetworkReply* reply)
+  {
+    waitForFinished(reply);
+    QByteArray data;
+    if (reply->error() == QNetworkReply::NoError)
+    {
+      data = reply->readAll();
+      _downloaded_bytes += uint64_t(data.size());
+    }
+    reply->deleteLater();
+    return data;
+  }
+
+  void abortReadahead()
+  {
+    if (_readahead_reply)
+    {
+      if (!_readahead_reply->isFinished())
+      {
+        _readahead_reply->abort();
+      }
+      _readahead_reply->deleteLater();
+      _readahead_reply = nullptr;
+    }
+  }
+
+  void startReadahead(uint64_t block_index)
+  {
+    if (block_index * _block_size >= _file_size || _blocks.count(block_index) != 0 ||
+        (_readahead_reply && _readahead_block == block_index))
+    {
+      return;
+    }
+    abortReadahead();
+    _readahead_block = block_index;
+    _readahead_reply = startFetch(block_index);
+  }
+
+  void insertBlock(uint64_t block_index, QByteArray data)
+  {
+    while (_blocks.size() >= _max_cached_blocks)
+    {
+      _blocks.erase(_lru.back());
+      _lru.pop_back();
+    }
+    _lru.push_front(block_index);
+    _blocks[block_index] = CacheEntry{ std::move(data), _lru.begin() };
+  }
+
+  const QByteArray* getBlock(uint64_t block_index)
+  {
+    auto it = _blocks.find(block_index);
+    if (it != _blocks.end())
+    {
+      _lru.splice(_lru.begin(), _lru, it->second.lru_it);
+      return &it->second.data;
+    }
+
+    QByteArray data;
+    if (_readahead_reply && _readahead_block == block_index)
+    {
+      QNetworkReply* reply = _readahead_reply;
+      _readahead_reply = nullptr;
+      data = collectReply(reply);
+    }
+    else
+    {
+      // a miss elsewhere makes the pending readahead stale
+      abortReadahead();
+    }
+    if (data.isEmpty())
+    {
+      // direct fetch, also retrying once after a failed readahead
+      data = collectReply(startFetch(block_index));
+    }
+    if (data.isEmpty())
+    {
+      return nullptr;
+    }
+    insertBlock(block_index, std::move(data));
+
+    // every downloaded block requests the next one in the background;
+    // random access wastes at most one block per miss
+    startReadahead(block_index + 1);
+    return &_blocks[block_index].data;
+  }
+
+  QString _url;
+  uint64_t _block_size;
+  size_t _max_cached_blocks;
+  QNetworkAccessManager _network;
+
+  uint64_t _file_size = 0;
+  uint64_t _downloaded_bytes = 0;
+
+  std::unordered_map<uint64_t, CacheEntry> _blocks;
+  std::list<uint64_t> _lru;  // front = most recently used
+
+  QNetworkReply* _readahead_reply = nullptr;
+  uint64_t _readahead_block = std::numeric_limits<uint64_t>::max();
+};
+
+}  // namespace PJ
+
+#endif  // PJ_REMOTE_FILE_HPP
@@ -0,0 +1,148 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_RENDER_GOVERNOR_HPP
+#define PJ_RENDER_GOVERNOR_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+namespace PJ
+{
+/**
+ * @brief Closed-loop governor of the rendering quality during streaming.
+ *
+ * Every per-frame budget used to be static, so a session streaming more
+ * than the machine can draw at full resolution degrades into a frozen
+ * UI. The governor measures the prepare+paint cost of each streaming
+ * frame against a target (16 ms by default) and derives a quality factor
+ * in [MIN_QUALITY, 1]:
+ *
+ * - the per-curve column budget of the display decimation shrinks with
+ *   it (scaleColumns), trading resolution for frame time;
+ * - auxiliary refreshes (time tracker, state publishers) stretch to
+ *   every 2nd / 4th frame when degraded (auxRefreshDue);
+ * - speculative work such as the hidden-tab prewarm only runs with
+ *   headroom (hasHeadroom).
+ *
+ * Over-budget frames cut the quality multiplicatively; sustained
+ * under-budget frames restore it in small steps, and a pause of the
+ * frame stream (streaming stopped, source idle) resets it to full, so a
+ * past overload never dulls an interactive session.
+ */
+class RenderGovernor
+{
+public:
+  static RenderGovernor& instance()
+  {
+    static RenderGovernor governor;
+    return governor;
+  }
+
+  /// One sample per streaming frame: total prepare+paint time.
+  void frameCompleted(double elapsed_ms)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto now = std::chrono::steady_clock::now();
+    if (_last_frame.time_since_epoch().count() != 0 &&
+        std::chrono::duration<double>(now - _last_frame).count() > IDLE_RESET_SEC)
+    {
+      // the frame stream paused: past load says nothing about this burst
+      _smoothed_ms = elapsed_ms;
+      _quality = 1.0;
+    }
+    _last_frame = now;
+
+    _smoothed_ms += SMOOTHING * (elapsed_ms - _smoothed_ms);
+
+    if (_smoothed_ms > _target_ms)
+    {
+      // proportional cut, but never more than a third per frame: a single
+      // pathological frame (GC in a plugin, window resize) should not
+      // collapse the resolution
+      const double ratio = std::max(0.66, _target_ms / _smoothed_ms);
+      _quality = std::max(MIN_QUALITY, _quality * ratio);
+    }
+    else if (_smoothed_ms < RESTORE_FRACTION * _target_ms)
+    {
+      // restore slowly: climbing back right to the edge of the budget
+      // and getting cut again every few frames would make the plots flicker
+      // between resolutions
+      _quality = std::min(1.0, _quality + RESTORE_STEP);
+    }
+  }
+
+  double quality() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return idleQuality();
+  }
+
+  /// Scale a per-curve column/point budget by the current quality.
+  int scaleColumns(int num_columns) const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::max(1, int(double(num_columns) * idleQuality()));
+  }
+
+  /// Rate limiter for the auxiliary refreshes: true on the frames where
+  /// they should run. Every frame at full quality, every 2nd below 0.75,
+  /// every 4th below 0.5.
+  bool auxRefreshDue()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const double quality = idleQuality();
+    const unsigned period = (quality >= 0.75) ? 1 : (quality >= 0.5) ? 2 : 4;
+    return (_frame_counter++ % period) == 0;
+  }
+
+  /// True when the recent frames left enough slack for speculative work.
+  bool hasHeadroom() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return idleQuality() >= 0.9 && _smoothed_ms < _target_ms;
+  }
+
+  void setTargetFrameTime(double target_ms)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _target_ms = std::max(1.0, target_ms);
+  }
+
+private:
+  RenderGovernor() = default;
+
+  static constexpr double MIN_QUALITY = 0.2;
+  static constexpr double SMOOTHING = 0.2;
+  static constexpr double RESTORE_FRACTION = 0.7;
+  static constexpr double RESTORE_STEP = 0.02;
+  static constexpr double IDLE_RESET_SEC = 2.0;
+
+  // callers must hold _mutex. An idle frame stream reports full quality
+  // without waiting for the next frameCompleted() to reset it.
+  double idleQuality() const
+  {
+    if (_last_frame.time_since_epoch().count() != 0 &&
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - _last_frame).count() >
+            IDLE_RESET_SEC)
+    {
+      return 1.0;
+    }
+    return _quality;
+  }
+
+  mutable std::mutex _mutex;
+  double _target_ms = 16.0;
+  double _smoothed_ms = 0;
+  double _quality = 1.0;
+  unsigned _frame_counter = 0;
+  std::chrono::steady_clock::time_point _last_frame;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_RENDER_GOVERNOR_HPP
@@ -0,0 +1,88 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_SIMD_MINMAX_HPP
+#define PJ_SIMD_MINMAX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace PJ
+{
+struct MinMax
+{
+  double min = std::numeric_limits<double>::max();
+  double max = std::numeric_limits<double>::lowest();
+};
+
+inline void Merge(MinMax& out, const MinMax& other)
+{
+  out.min = std::min(out.min, other.min);
+  out.max = std::max(out.max, other.max);
+}
+
+/**
+ * @brief Min/max of a contiguous array of doubles, vectorized with
+ * AVX on x86 and NEON on arm64, with a scalar fallback elsewhere.
+ * NaN / infinity are assumed to have been filtered out at insertion
+ * time (see PlotDataBase::pushBack).
+ */
+inline MinMax MinMaxOfArray(const double* data, size_t count)
+{
+  MinMax out;
+  size_t i = 0;
+
+#if defined(__AVX__)
+  if (count >= 4)
+  {
+    __m256d vmin = _mm256_loadu_pd(data);
+    __m256d vmax = vmin;
+    for (i = 4; i + 4 <= count; i += 4)
+    {
+      const __m256d v = _mm256_loadu_pd(data + i);
+      vmin = _mm256_min_pd(vmin, v);
+      vmax = _mm256_max_pd(vmax, v);
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, vmin);
+    out.min = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+    _mm256_storeu_pd(lanes, vmax);
+    out.max = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+  }
+#elif defined(__aarch64__)
+  if (count >= 2)
+  {
+    float64x2_t vmin = vld1q_f64(data);
+    float64x2_t vmax = vmin;
+    for (i = 2; i + 2 <= count; i += 2)
+    {
+      const float64x2_t v = vld1q_f64(data + i);
+      vmin = vminq_f64(vmin, v);
+      vmax = vmaxq_f64(vmax, v);
+    }
+    out.min = vminvq_f64(vmin);
+    out.max = vmaxvq_f64(vmax);
+  }
+#endif
+
+  for (; i < count; i++)
+  {
+    out.min = std::min(out.min, data[i]);
+    out.max = std::max(out.max, data[i]);
+  }
+  return out;
+}
+
+}  // namespace PJ
+
+#endif  // PJ_SIMD_MINMAX_HPP
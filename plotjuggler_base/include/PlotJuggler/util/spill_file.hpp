@@ -0,0 +1,160 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_SPILL_FILE_HPP
+#define PJ_SPILL_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace PJ
+{
+/**
+ * @brief Process-wide temp file backing the disk-spill tier of SoAStorage.
+ *
+ * store() copies a block of samples into a slot of the file and returns a
+ * writable MAP_SHARED mapping of it: the caller keeps reading and writing
+ * the data through that pointer, while the kernel is free to drop the
+ * pages under memory pressure and fault them back in from disk on access.
+ * release() unmaps the slot and recycles its extent for the next store().
+ *
+ * The file is created lazily in the system temp directory and unlinked
+ * immediately, so it disappears with the process even after a crash. On
+ * platforms without POSIX mmap the tier is disabled and store() returns
+ * nullptr: callers must keep the data on the heap in that case.
+ */
+class SpillFile
+{
+public:
+  static SpillFile& instance()
+  {
+    // deliberately leaked: storage chunks may still release their slots
+    // during static destruction
+    static SpillFile* obj = new SpillFile();
+    return *obj;
+  }
+
+#if !defined(_WIN32)
+  /// Copy head and tail, back to back, into a slot of the file. Returns a
+  /// writable mapping of the slot, or nullptr when spilling is unavailable.
+  void* store(const void* head, size_t head_bytes, const void* tail, size_t tail_bytes)
+  {
+    const size_t page = size_t(sysconf(_SC_PAGESIZE));
+    const size_t bytes = ((head_bytes + tail_bytes + page - 1) / page) * page;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_fd < 0 && !openTempFile())
+    {
+      return nullptr;
+    }
+    uint64_t offset;
+    auto& free_list = _free_extents[bytes];
+    if (!free_list.empty())
+    {
+      offset = free_list.back();
+      free_list.pop_back();
+    }
+    else
+    {
+      offset = _file_size;
+      if (ftruncate(_fd, off_t(_file_size + bytes)) != 0)
+      {
+        return nullptr;
+      }
+      _file_size += bytes;
+    }
+    void* addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, off_t(offset));
+    if (addr == MAP_FAILED)
+    {
+      free_list.push_back(offset);
+      return nullptr;
+    }
+    std::memcpy(addr, head, head_bytes);
+    std::memcpy(static_cast<char*>(addr) + head_bytes, tail, tail_bytes);
+    _mapped.emplace(addr, Extent{ offset, bytes });
+    return addr;
+  }
+
+  /// Unmap a slot returned by store() and recycle its extent.
+  void release(void* addr)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _mapped.find(addr);
+    if (it == _mapped.end())
+    {
+      return;
+    }
+    munmap(addr, it->second.bytes);
+    _free_extents[it->second.bytes].push_back(it->second.offset);
+    _mapped.erase(it);
+  }
+#else
+  void* store(const void*, size_t, const void*, size_t)
+  {
+    return nullptr;
+  }
+
+  void release(void*)
+  {
+  }
+#endif
+
+  /// Bytes currently occupied by the spill file on disk.
+  size_t fileBytes() const
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _file_size;
+  }
+
+private:
+  SpillFile() = default;
+
+#if !defined(_WIN32)
+  bool openTempFile()
+  {
+    const char* tmpdir = getenv("TMPDIR");
+    std::string path = (tmpdir && *tmpdir) ? tmpdir : "/tmp";
+    path += "/plotjuggler-spill-XXXXXX";
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+    _fd = mkstemp(name.data());
+    if (_fd < 0)
+    {
+      return false;
+    }
+    unlink(name.data());
+    return true;
+  }
+#endif
+
+  struct Extent
+  {
+    uint64_t offset;
+    size_t bytes;
+  };
+
+  mutable std::mutex _mutex;
+  int _fd = -1;
+  uint64_t _file_size = 0;
+  // recycled slots, grouped by size; all the slots of one storage are equal
+  std::map<size_t, std::vector<uint64_t>> _free_extents;
+  std::map<void*, Extent> _mapped;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_SPILL_FILE_HPP
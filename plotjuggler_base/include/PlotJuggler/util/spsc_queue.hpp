@@ -0,0 +1,87 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_SPSC_QUEUE_HPP
+#define PJ_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace PJ
+{
+/**
+ * @brief Bounded lock-free queue for a single producer and a single
+ * consumer. push() is wait-free and never blocks: when the queue is
+ * full it returns false and the caller decides whether to drop or
+ * retry. Used to decouple streaming plugin threads from the GUI
+ * thread that merges samples into dataMap().
+ */
+template <typename T>
+class SPSCQueue
+{
+public:
+  /// capacity is rounded up to the next power of two
+  explicit SPSCQueue(size_t capacity)
+  {
+    size_t pow2 = 1;
+    while (pow2 < capacity)
+    {
+      pow2 <<= 1;
+    }
+    _buffer.resize(pow2);
+    _mask = pow2 - 1;
+  }
+
+  /// Producer thread only. Returns false if the queue is full.
+  bool push(const T& item)
+  {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head.load(std::memory_order_acquire) > _mask)
+    {
+      return false;
+    }
+    _buffer[tail & _mask] = item;
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer thread only. Returns false if the queue is empty.
+  bool pop(T& item)
+  {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    if (head == _tail.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    item = std::move(_buffer[head & _mask]);
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// May be stale when called while the other thread is active.
+  size_t sizeApprox() const
+  {
+    return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+  }
+
+  size_t capacity() const
+  {
+    return _mask + 1;
+  }
+
+private:
+  std::vector<T> _buffer;
+  size_t _mask = 0;
+  // head and tail on separate cache lines to avoid false sharing
+  alignas(64) std::atomic<size_t> _head{ 0 };
+  alignas(64) std::atomic<size_t> _tail{ 0 };
+};
+
+}  // namespace PJ
+
+#endif  // PJ_SPSC_QUEUE_HPP
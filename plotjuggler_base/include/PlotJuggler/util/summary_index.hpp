@@ -0,0 +1,219 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_SUMMARY_INDEX_HPP
+#define PJ_SUMMARY_INDEX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace PJ
+{
+/**
+ * @brief Hierarchical summary index over the Y values of a series.
+ *
+ * Same block structure as MinMaxIndex, but each entry carries all the
+ * aggregates needed by the statistics panel: count, sum, sum of squares,
+ * sum of absolute values, min and max. A sub-range query touches
+ * O(BLOCK_SIZE * log n) entries instead of scanning every sample, so the
+ * panel can stay open during streaming without paying a full scan on
+ * every refresh tick.
+ *
+ * The index is maintained incrementally while the series grows in the
+ * back and rebuilt from scratch when it shrinks or its first sample
+ * changes. Unlike MinMaxIndex, the first Y value is part of the validity
+ * check: the dialog indexes the *displayed* (possibly transformed)
+ * series, and editing a transform changes Y values without changing the
+ * size or the timestamps.
+ */
+class SummaryIndex
+{
+public:
+  static constexpr size_t BLOCK_SIZE = 64;
+
+  struct Summary
+  {
+    size_t count = 0;
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    double sum_abs = 0.0;
+
+    void add(double y)
+    {
+      count++;
+      min = std::min(min, y);
+      max = std::max(max, y);
+      sum += y;
+      sum_sq += y * y;
+      sum_abs += std::abs(y);
+    }
+
+    void merge(const Summary& other)
+    {
+      count += other.count;
+      min = std::min(min, other.min);
+      max = std::max(max, other.max);
+      sum += other.sum;
+      sum_sq += other.sum_sq;
+      sum_abs += other.sum_abs;
+    }
+  };
+
+  void clear()
+  {
+    _levels.clear();
+    _indexed_count = 0;
+    _front_x = 0.0;
+    _front_y = 0.0;
+  }
+
+  /// Bring the index up to date with the series. Amortized O(appended).
+  template <typename Series>
+  void update(const Series& data)
+  {
+    const size_t count = data.size();
+    if (count == 0)
+    {
+      clear();
+      return;
+    }
+    if (count < _indexed_count ||
+        (_indexed_count > 0 && (data[0].x != _front_x || data[0].y != _front_y)))
+    {
+      clear();
+    }
+    if (_levels.empty())
+    {
+      _levels.emplace_back();
+    }
+    // only complete blocks are indexed; the tail is scanned by rangeSummary()
+    const size_t total_blocks = count / BLOCK_SIZE;
+    for (size_t block = _levels[0].size(); block < total_blocks; block++)
+    {
+      Summary summary;
+      const size_t begin = block * BLOCK_SIZE;
+      for (size_t i = begin; i < begin + BLOCK_SIZE; i++)
+      {
+        summary.add(data[i].y);
+      }
+      appendEntry(summary);
+    }
+    _indexed_count = total_blocks * BLOCK_SIZE;
+    _front_x = data[0].x;
+    _front_y = data[0].y;
+  }
+
+  /// Aggregates of samples in [first_index, last_index], inclusive.
+  /// Call update() first.
+  template <typename Series>
+  Summary rangeSummary(const Series& data, size_t first_index, size_t last_index) const
+  {
+    Summary out;
+    const size_t last_excl = last_index + 1;
+    const size_t indexed_blocks = _levels.empty() ? 0 : _levels[0].size();
+    const size_t first_block = (first_index + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const size_t last_block = std::min(last_excl / BLOCK_SIZE, indexed_blocks);
+
+    if (first_block >= last_block)
+    {
+      scanSamples(data, first_index, last_excl, out);
+      return out;
+    }
+    // partial head/tail (including the not-yet-indexed back of the series)
+    scanSamples(data, first_index, first_block * BLOCK_SIZE, out);
+    scanSamples(data, last_block * BLOCK_SIZE, last_excl, out);
+    queryLevel(0, first_block, last_block, out);
+    return out;
+  }
+
+private:
+  template <typename Series>
+  static void scanSamples(const Series& data, size_t begin, size_t end, Summary& out)
+  {
+    for (size_t i = begin; i < end; i++)
+    {
+      out.add(data[i].y);
+    }
+  }
+
+  void appendEntry(Summary summary)
+  {
+    size_t index = _levels[0].size();
+    _levels[0].push_back(summary);
+
+    for (size_t level = 1;; level++)
+    {
+      index /= BLOCK_SIZE;
+      if (_levels.size() <= level)
+      {
+        // a new level pays off only once the one below outgrows a block;
+        // seed its first entry from the children already present
+        if (_levels[level - 1].size() <= BLOCK_SIZE)
+        {
+          break;
+        }
+        Summary seed = _levels[level - 1][0];
+        for (size_t i = 1; i < BLOCK_SIZE; i++)
+        {
+          seed.merge(_levels[level - 1][i]);
+        }
+        _levels.emplace_back();
+        _levels[level].push_back(seed);
+      }
+      auto& entries = _levels[level];
+      if (index >= entries.size())
+      {
+        entries.push_back(summary);
+      }
+      else
+      {
+        entries[index].merge(summary);
+      }
+    }
+  }
+
+  /// Merge entries [first, last) of the given level, delegating
+  /// block-aligned middle sections to the level above.
+  void queryLevel(size_t level, size_t first, size_t last, Summary& out) const
+  {
+    if (level + 1 < _levels.size())
+    {
+      const size_t first_aligned = (first + BLOCK_SIZE - 1) / BLOCK_SIZE;
+      const size_t last_aligned = last / BLOCK_SIZE;
+      if (first_aligned < last_aligned)
+      {
+        for (size_t i = first; i < first_aligned * BLOCK_SIZE; i++)
+        {
+          out.merge(_levels[level][i]);
+        }
+        for (size_t i = last_aligned * BLOCK_SIZE; i < last; i++)
+        {
+          out.merge(_levels[level][i]);
+        }
+        queryLevel(level + 1, first_aligned, last_aligned, out);
+        return;
+      }
+    }
+    for (size_t i = first; i < last; i++)
+    {
+      out.merge(_levels[level][i]);
+    }
+  }
+
+  std::vector<std::vector<Summary>> _levels;
+  size_t _indexed_count = 0;
+  double _front_x = 0.0;
+  double _front_y = 0.0;
+};
+
+}  // namespace PJ
+
+#endif  // PJ_SUMMARY_INDEX_HPP
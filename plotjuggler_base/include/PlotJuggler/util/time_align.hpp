@@ -0,0 +1,236 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_TIME_ALIGN_HPP
+#define PJ_TIME_ALIGN_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace PJ
+{
+/**
+ * Time-alignment and resampling over multiple sorted series.
+ *
+ * All functions here work in a single linear pass over each input
+ * instead of one binary search per output row, and produce columnar
+ * output (one contiguous vector per series). The series type only needs
+ * size() and at(i) returning a point with .x and .y members, so both
+ * PlotData and plain vectors of points qualify.
+ *
+ * Consumers: the CSV range export, XY curves with mismatched time axes,
+ * and any toolbox that needs multiple series as an aligned matrix.
+ */
+
+/// Merged, strictly increasing union of the timestamps of every series,
+/// restricted to [time_start, time_end]. Timestamps of different series
+/// closer than epsilon are collapsed into one entry.
+template <typename SeriesT>
+std::vector<double> MergedTimebase(const std::vector<const SeriesT*>& series,
+                                   double time_start = std::numeric_limits<double>::lowest(),
+                                   double time_end = std::numeric_limits<double>::max())
+{
+  const double EPS = std::numeric_limits<double>::epsilon();
+  const size_t series_count = series.size();
+
+  std::vector<size_t> cursor(series_count, 0);
+  size_t total_points = 0;
+  for (size_t i = 0; i < series_count; i++)
+  {
+    const auto& data = *series[i];
+    while (cursor[i] < data.size() && data.at(cursor[i]).x < time_start)
+    {
+      cursor[i]++;
+    }
+    total_points += data.size() - cursor[i];
+  }
+
+  std::vector<double> timebase;
+  timebase.reserve(total_points);
+
+  while (true)
+  {
+    double min_time = std::numeric_limits<double>::max();
+    bool found = false;
+    for (size_t i = 0; i < series_count; i++)
+    {
+      const auto& data = *series[i];
+      if (cursor[i] < data.size())
+      {
+        min_time = std::min(min_time, data.at(cursor[i]).x);
+        found = true;
+      }
+    }
+    if (!found || min_time > time_end)
+    {
+      break;
+    }
+    timebase.push_back(min_time);
+    // consume every sample that collapses into this timestamp
+    for (size_t i = 0; i < series_count; i++)
+    {
+      const auto& data = *series[i];
+      while (cursor[i] < data.size() && data.at(cursor[i]).x <= min_time + EPS)
+      {
+        cursor[i]++;
+      }
+    }
+  }
+  return timebase;
+}
+
+/// Column of one series over the given timebase: the sample value where
+/// the series has a sample at that timestamp (within epsilon), NaN
+/// elsewhere. Two-pointer pass, no searches.
+template <typename SeriesT>
+std::vector<double> AlignToTimebase(const SeriesT& series, const std::vector<double>& timebase)
+{
+  const double EPS = std::numeric_limits<double>::epsilon();
+  std::vector<double> column(timebase.size(), std::numeric_limits<double>::quiet_NaN());
+
+  size_t i = 0;
+  for (size_t j = 0; j < timebase.size() && i < series.size(); j++)
+  {
+    while (i < series.size() && series.at(i).x < timebase[j] - EPS)
+    {
+      i++;
+    }
+    // when several samples collapsed into one timebase entry, the last
+    // one wins, matching what a per-row getYfromX would return
+    while (i < series.size() && std::abs(series.at(i).x - timebase[j]) <= EPS)
+    {
+      column[j] = series.at(i).y;
+      i++;
+    }
+  }
+  return column;
+}
+
+/// Column of one series linearly interpolated at every timebase entry;
+/// NaN before the first and after the last sample of the series. The
+/// timebase is consumed one segment of the series at a time, so the
+/// inner loop has a constant slope and is vectorized.
+template <typename SeriesT>
+std::vector<double> InterpolateOnTimebase(const SeriesT& series,
+                                          const std::vector<double>& timebase)
+{
+  const double EPS = std::numeric_limits<double>::epsilon();
+  std::vector<double> column(timebase.size(), std::numeric_limits<double>::quiet_NaN());
+  const size_t points_count = series.size();
+  if (points_count == 0)
+  {
+    return column;
+  }
+
+  size_t j = 0;
+  // entries before the first sample stay NaN
+  while (j < timebase.size() && timebase[j] < series.at(0).x - EPS)
+  {
+    j++;
+  }
+
+  if (points_count == 1)
+  {
+    const auto point = series.at(0);
+    while (j < timebase.size() && timebase[j] <= point.x + EPS)
+    {
+      column[j++] = point.y;
+    }
+    return column;
+  }
+
+  size_t i = 0;
+  while (j < timebase.size())
+  {
+    while (i + 2 < points_count && series.at(i + 1).x < timebase[j])
+    {
+      i++;
+    }
+    const double x0 = series.at(i).x;
+    const double y0 = series.at(i).y;
+    const double x1 = series.at(i + 1).x;
+    const double y1 = series.at(i + 1).y;
+    if (timebase[j] > x1 + EPS)
+    {
+      break;  // past the last sample, the tail stays NaN
+    }
+    const double slope = (x1 - x0 > EPS) ? (y1 - y0) / (x1 - x0) : 0.0;
+
+    size_t run_end = j;
+    while (run_end < timebase.size() && timebase[run_end] <= x1 + EPS)
+    {
+      run_end++;
+    }
+
+#if defined(__AVX__)
+    const __m256d vx0 = _mm256_set1_pd(x0);
+    const __m256d vy0 = _mm256_set1_pd(y0);
+    const __m256d vslope = _mm256_set1_pd(slope);
+    for (; j + 4 <= run_end; j += 4)
+    {
+      const __m256d t = _mm256_loadu_pd(timebase.data() + j);
+      const __m256d y =
+          _mm256_add_pd(vy0, _mm256_mul_pd(vslope, _mm256_sub_pd(t, vx0)));
+      _mm256_storeu_pd(column.data() + j, y);
+    }
+#elif defined(__aarch64__)
+    const float64x2_t vx0 = vdupq_n_f64(x0);
+    const float64x2_t vy0 = vdupq_n_f64(y0);
+    const float64x2_t vslope = vdupq_n_f64(slope);
+    for (; j + 2 <= run_end; j += 2)
+    {
+      const float64x2_t t = vld1q_f64(timebase.data() + j);
+      const float64x2_t y = vfmaq_f64(vy0, vslope, vsubq_f64(t, vx0));
+      vst1q_f64(column.data() + j, y);
+    }
+#endif
+    for (; j < run_end; j++)
+    {
+      column[j] = y0 + slope * (timebase[j] - x0);
+    }
+    // the next timebase entry is past x1: the loop above advances i
+  }
+  return column;
+}
+
+/// Several series as one aligned matrix: a common timebase plus one
+/// column per input, in input order.
+struct AlignedMatrix
+{
+  std::vector<double> timestamps;
+  std::vector<std::vector<double>> columns;
+};
+
+/// interpolate = false leaves NaN where a series has no sample
+/// (sparse alignment, what the CSV export writes as empty cells);
+/// interpolate = true fills the gaps by linear interpolation.
+template <typename SeriesT>
+AlignedMatrix AlignSeries(const std::vector<const SeriesT*>& series, bool interpolate,
+                          double time_start = std::numeric_limits<double>::lowest(),
+                          double time_end = std::numeric_limits<double>::max())
+{
+  AlignedMatrix matrix;
+  matrix.timestamps = MergedTimebase(series, time_start, time_end);
+  matrix.columns.reserve(series.size());
+  for (const SeriesT* data : series)
+  {
+    matrix.columns.push_back(interpolate ? InterpolateOnTimebase(*data, matrix.timestamps) :
+                                           AlignToTimebase(*data, matrix.timestamps));
+  }
+  return matrix;
+}
+
+}  // namespace PJ
+
+#endif  // PJ_TIME_ALIGN_HPP
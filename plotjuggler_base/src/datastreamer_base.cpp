@@ -5,6 +5,17 @@
  */
 
 #include "PlotJuggler/datastreamer_base.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+
+#include <QSettings>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace PJ
 {
@@ -26,6 +37,484 @@ void PJ::DataStreamer::setMaximumRangeX(double range)
   }
 }
 
+size_t DataStreamer::registerStreamedSeries(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mutex());
+  dataMap().getOrCreateNumeric(name);
+  _streamed_series_names.push_back(name);
+  return _streamed_series_names.size() - 1;
+}
+
+bool DataStreamer::pushStreamedSample(size_t series_index, double x, double y)
+{
+  StreamedSample sample = { static_cast<uint32_t>(series_index), x, y };
+  // the epoch is read before the queue pointer: once the echoed
+  // _producer_epoch catches up with _queue_epoch, the consumer knows that
+  // no push into a retired queue can still be in flight (and that any
+  // such push has completed), so the retired queue is safe to delete
+  const uint64_t epoch = _queue_epoch.load(std::memory_order_acquire);
+  const bool pushed = _active_queue.load(std::memory_order_acquire)->push(sample);
+  if (!pushed)
+  {
+    _dropped_samples.fetch_add(1, std::memory_order_relaxed);
+  }
+  _producer_epoch.store(epoch, std::memory_order_release);
+  return pushed;
+}
+
+size_t DataStreamer::drainStreamedSamples()
+{
+  // mutex() is already held by the caller (GUI thread).
+  // Series pointers are resolved lazily, once per drain: entries of
+  // dataMap().numeric may have been erased since the previous call.
+  std::vector<PlotData*> series(_streamed_series_names.size(), nullptr);
+
+  // occupancy before draining: this is what the sizing policy and the
+  // stats channel care about, the post-drain depth is always near zero
+  _last_drain_depth =
+      _sample_queue->sizeApprox() + (_retired_queue ? _retired_queue->sizeApprox() : 0);
+
+  size_t count = 0;
+  StreamedSample sample;
+  auto drainQueue = [&](SPSCQueue<StreamedSample>& queue) {
+    while (queue.pop(sample))
+    {
+      if (sample.series_index >= series.size())
+      {
+        continue;
+      }
+      auto& dest = series[sample.series_index];
+      if (!dest)
+      {
+        dest = &dataMap().getOrCreateNumeric(_streamed_series_names[sample.series_index]);
+      }
+      dest->pushBack({ sample.x, sample.y });
+      count++;
+    }
+  };
+  if (_retired_queue)
+  {
+    drainQueue(*_retired_queue);
+    // The retired queue is deleted only when the producer provably
+    // switched to the new one (epoch echoed) and nothing is left inside;
+    // an idle producer just delays this. Until then the new queue is not
+    // drained at all, so samples keep arriving here in push order.
+    if (_producer_epoch.load(std::memory_order_acquire) ==
+            _queue_epoch.load(std::memory_order_relaxed) &&
+        _retired_queue->sizeApprox() == 0)
+    {
+      _retired_queue.reset();
+    }
+  }
+  if (!_retired_queue)
+  {
+    drainQueue(*_sample_queue);
+  }
+  _drained_total += count;
+
+  adaptQueueCapacity();
+  return count;
+}
+
+void DataStreamer::adaptQueueCapacity()
+{
+  if (_retired_queue)
+  {
+    return;  // one resize in flight at a time
+  }
+
+  // past this occupancy the next burst would likely overflow
+  const size_t capacity = _sample_queue->capacity();
+  const size_t dropped = _dropped_samples.load(std::memory_order_relaxed);
+  const bool pressed = (dropped != _last_drain_dropped) || (_last_drain_depth > capacity / 2);
+  _last_drain_dropped = dropped;
+
+  // consecutive quiet drains required before shrinking: growth reacts to a
+  // single event (a drop is lost data), shrinking needs sustained calm
+  constexpr size_t QUIET_DRAINS_TO_SHRINK = 32;
+
+  size_t new_capacity = capacity;
+  if (pressed)
+  {
+    _quiet_drains = 0;
+    if (capacity < QUEUE_MAX_CAPACITY)
+    {
+      new_capacity = capacity * 2;
+    }
+  }
+  else if (_last_drain_depth < capacity / 8 && capacity > QUEUE_MIN_CAPACITY)
+  {
+    if (++_quiet_drains >= QUIET_DRAINS_TO_SHRINK)
+    {
+      _quiet_drains = 0;
+      new_capacity = capacity / 2;
+    }
+  }
+  else
+  {
+    _quiet_drains = 0;
+  }
+  if (new_capacity == capacity)
+  {
+    return;
+  }
+
+  _retired_queue = std::move(_sample_queue);
+  _sample_queue = std::make_unique<SPSCQueue<StreamedSample>>(new_capacity);
+  // publish the queue before the epoch: a producer that observes the new
+  // epoch is then guaranteed to also observe the new queue pointer
+  _active_queue.store(_sample_queue.get(), std::memory_order_release);
+  _queue_epoch.fetch_add(1, std::memory_order_release);
+}
+
+namespace
+{
+template <typename T, typename = void>
+struct HasMaxRangeX : std::false_type
+{
+};
+
+template <typename T>
+struct HasMaxRangeX<T, std::void_t<decltype(std::declval<T&>().maximumRangeX())>> : std::true_type
+{
+};
+
+template <typename SeriesMap>
+void SwapSeriesData(SeriesMap& source_map, SeriesMap& staging_map)
+{
+  // drop staging entries whose series disappeared from the source
+  for (auto it = staging_map.begin(); it != staging_map.end();)
+  {
+    it = (source_map.count(it->first) == 0) ? staging_map.erase(it) : std::next(it);
+  }
+
+  for (auto& [name, series] : source_map)
+  {
+    auto it = staging_map.find(name);
+    if (it == staging_map.end())
+    {
+      it = staging_map
+               .emplace(std::piecewise_construct, std::forward_as_tuple(name),
+                        std::forward_as_tuple(series.plotName(), PlotGroup::Ptr{}))
+               .first;
+    }
+    auto& staged = it->second;
+    // the staged series was fully drained by the previous merge: after the
+    // swap it owns the new samples and the source is empty again
+    staged.swapData(series);
+    if constexpr (HasMaxRangeX<std::decay_t<decltype(series)>>::value)
+    {
+      // swapData() exchanged the trimming range too: keep both sides in sync
+      series.setMaximumRangeX(staged.maximumRangeX());
+    }
+    // metadata is copied, not swapped: MoveData propagates it downstream
+    staged.attributes() = series.attributes();
+    staged.changeGroup(series.group());
+  }
+}
+}  // namespace
+
+void DataStreamer::recordParseTime(uint64_t nanoseconds, uint64_t message_count)
+{
+  if (message_count == 0)
+  {
+    return;
+  }
+  _stream_stats.messages_parsed.fetch_add(message_count, std::memory_order_relaxed);
+  _stream_stats.parse_ns_total.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+  // racy max update is fine: this is a monitoring counter, an occasional
+  // lost maximum between two publishes does not matter
+  const uint64_t per_message = nanoseconds / message_count;
+  uint64_t prev_max = _stream_stats.parse_ns_max.load(std::memory_order_relaxed);
+  while (per_message > prev_max &&
+         !_stream_stats.parse_ns_max.compare_exchange_weak(prev_max, per_message,
+                                                           std::memory_order_relaxed))
+  {
+  }
+}
+
+void DataStreamer::publishStreamStats()
+{
+  const uint64_t received = _stream_stats.messages_received.load(std::memory_order_relaxed);
+  const uint64_t parsed = _stream_stats.messages_parsed.load(std::memory_order_relaxed);
+  const uint64_t dropped = _stream_stats.messages_dropped.load(std::memory_order_relaxed) +
+                           _dropped_samples.load(std::memory_order_relaxed);
+  if (received == 0 && parsed == 0 && dropped == 0 && _drained_total == 0)
+  {
+    // the plugin uses neither the counters nor the lock-free sample path:
+    // don't pollute the curve list
+    return;
+  }
+
+  const double now = std::chrono::duration<double>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+  // one reused buffer per publish: the suffix is rewritten in place
+  std::string key = std::string(STATS_PREFIX) + name() + "/";
+  const size_t prefix_len = key.size();
+  auto push = [&](const char* suffix, double value) {
+    key.resize(prefix_len);
+    key += suffix;
+    dataMap().getOrCreateNumeric(key).pushBack({ now, value });
+  };
+
+  push("messages_received", double(received));
+  push("messages_parsed", double(parsed));
+  push("messages_dropped", double(dropped));
+  // occupancy at the start of the drain that just ran, and the capacity
+  // the adaptive sizing settled on (see adaptQueueCapacity)
+  push("queue_depth", double(_last_drain_depth));
+  push("queue_capacity", double(_sample_queue->capacity()));
+  if (_spooled_bytes.load(std::memory_order_relaxed) > 0)
+  {
+    push("pause_spool_bytes", double(_spooled_bytes.load(std::memory_order_relaxed)));
+  }
+
+  // latency over the interval since the previous publish
+  const uint64_t parse_ns_total = _stream_stats.parse_ns_total.load(std::memory_order_relaxed);
+  const uint64_t parsed_delta = parsed - _last_parsed_count;
+  if (parsed_delta > 0)
+  {
+    const uint64_t total_delta = parse_ns_total - _last_parse_ns_total;
+    const uint64_t max_ns = _stream_stats.parse_ns_max.exchange(0, std::memory_order_relaxed);
+    push("parse_latency_ms_mean", double(total_delta / parsed_delta) * 1e-6);
+    push("parse_latency_ms_max", double(max_ns) * 1e-6);
+  }
+  _last_parsed_count = parsed;
+  _last_parse_ns_total = parse_ns_total;
+}
+
+namespace
+{
+/// Seal the open chunk once it holds this much raw data. Large enough to
+/// amortize the qCompress call, small enough that sealing never stalls a
+/// receive loop noticeably.
+constexpr int kSpoolChunkSize = 1024 * 1024;
+
+/// Hard cap on the spool: past this, new messages are dropped and counted
+/// instead of growing without bound during a very long pause.
+constexpr size_t kSpoolMaxBytes = 512 * 1024 * 1024;
+
+void AppendRaw(QByteArray& buffer, const void* data, size_t size)
+{
+  buffer.append(reinterpret_cast<const char*>(data), int(size));
+}
+}  // namespace
+
+void DataStreamer::setUiPaused(bool paused)
+{
+  std::lock_guard<std::mutex> lock(mutex());
+  if (paused)
+  {
+    // a fresh pause must never replay leftovers: a previous session could
+    // have been shut down while paused, leaving records that point to
+    // parsers which no longer exist
+    clearSpool();
+    _ui_paused.store(true, std::memory_order_release);
+    return;
+  }
+  _ui_paused.store(false, std::memory_order_release);
+  // the resuming click happens while the plugin is running, so the parsers
+  // recorded in the spool are still alive: replay before letting any new
+  // message through
+  replaySpool();
+}
+
+bool DataStreamer::parseOrSpool(MessageParser& parser, const MessageRef& msg, double& timestamp)
+{
+  if (_ui_paused.load(std::memory_order_acquire))
+  {
+    spoolMessage(parser, msg, timestamp);
+    return true;
+  }
+  return parser.parseMessage(msg, timestamp);
+}
+
+void DataStreamer::parseOrSpoolBatch(MessageParser& parser, const MessageRef* messages,
+                                     double* timestamps, size_t count)
+{
+  if (_ui_paused.load(std::memory_order_acquire))
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      spoolMessage(parser, messages[i], timestamps[i]);
+    }
+    return;
+  }
+  parser.parseMessageBatch(messages, timestamps, count);
+}
+
+void DataStreamer::spoolMessage(MessageParser& parser, const MessageRef& msg, double timestamp)
+{
+  if (_spool.sealed_bytes + size_t(_spool.open_chunk.size()) >= kSpoolMaxBytes)
+  {
+    _stream_stats.messages_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  auto it = std::find(_spool.parsers.begin(), _spool.parsers.end(), &parser);
+  if (it == _spool.parsers.end())
+  {
+    it = _spool.parsers.insert(_spool.parsers.end(), &parser);
+  }
+  const uint32_t parser_index = uint32_t(std::distance(_spool.parsers.begin(), it));
+  const uint32_t size = uint32_t(msg.size());
+
+  AppendRaw(_spool.open_chunk, &parser_index, sizeof(parser_index));
+  AppendRaw(_spool.open_chunk, &timestamp, sizeof(timestamp));
+  AppendRaw(_spool.open_chunk, &size, sizeof(size));
+  AppendRaw(_spool.open_chunk, msg.data(), size);
+  _spool.message_count++;
+
+  if (_spool.open_chunk.size() >= kSpoolChunkSize)
+  {
+    // level 1: the spool absorbs bursts, it is not an archive
+    _spool.sealed_chunks.push_back(qCompress(_spool.open_chunk, 1));
+    _spool.sealed_bytes += size_t(_spool.sealed_chunks.back().size());
+    _spool.open_chunk.clear();
+  }
+  _spooled_bytes.store(_spool.sealed_bytes + size_t(_spool.open_chunk.size()),
+                       std::memory_order_relaxed);
+}
+
+void DataStreamer::replaySpool()
+{
+  if (_spool.message_count == 0)
+  {
+    clearSpool();
+    return;
+  }
+
+  const auto replay_start = std::chrono::steady_clock::now();
+  uint64_t replayed = 0;
+
+  auto replayChunk = [this, &replayed](const QByteArray& raw) {
+    const char* ptr = raw.constData();
+    const char* end = ptr + raw.size();
+    constexpr size_t header_size = sizeof(uint32_t) + sizeof(double) + sizeof(uint32_t);
+    while (size_t(end - ptr) >= header_size)
+    {
+      uint32_t parser_index = 0;
+      double timestamp = 0;
+      uint32_t size = 0;
+      std::memcpy(&parser_index, ptr, sizeof(parser_index));
+      ptr += sizeof(parser_index);
+      std::memcpy(&timestamp, ptr, sizeof(timestamp));
+      ptr += sizeof(timestamp);
+      std::memcpy(&size, ptr, sizeof(size));
+      ptr += sizeof(size);
+      if (size_t(end - ptr) < size || parser_index >= _spool.parsers.size())
+      {
+        break;  // truncated record: cannot happen unless the spool is corrupted
+      }
+      MessageRef msg(reinterpret_cast<const uint8_t*>(ptr), size);
+      ptr += size;
+      try
+      {
+        _spool.parsers[parser_index]->parseMessage(msg, timestamp);
+        replayed++;
+      }
+      catch (std::exception&)
+      {
+        // a message that would have failed live fails here too: count it
+        // and keep going, one bad record must not discard the rest
+        _stream_stats.messages_dropped.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  for (const auto& chunk : _spool.sealed_chunks)
+  {
+    replayChunk(qUncompress(chunk));
+  }
+  replayChunk(_spool.open_chunk);
+  clearSpool();
+
+  recordParseTime(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - replay_start)
+                      .count(),
+                  replayed);
+}
+
+void DataStreamer::clearSpool()
+{
+  _spool = PauseSpool{};
+  _spooled_bytes.store(0, std::memory_order_relaxed);
+}
+
+void DataStreamer::takeStreamedData(PlotDataMapRef& staging)
+{
+  std::lock_guard<std::mutex> lock(mutex());
+  drainStreamedSamples();
+  publishStreamStats();
+
+  SwapSeriesData(dataMap().numeric, staging.numeric);
+  SwapSeriesData(dataMap().strings, staging.strings);
+  SwapSeriesData(dataMap().scatter_xy, staging.scatter_xy);
+  SwapSeriesData(dataMap().user_defined, staging.user_defined);
+}
+
+DataStreamer::IngestThreadConfig DataStreamer::ingestThreadConfig() const
+{
+  QSettings settings;
+  QString group = QString("StreamerThread::") + name();
+  if (!settings.contains(group + "/affinity") && !settings.contains(group + "/fifo_priority") &&
+      !settings.contains(group + "/busy_poll"))
+  {
+    group = "StreamerThread::default";
+  }
+
+  IngestThreadConfig config;
+  const auto cpu_list = settings.value(group + "/affinity").toString();
+  for (const auto& token : cpu_list.split(',', PJ::SkipEmptyParts))
+  {
+    bool ok = false;
+    const int cpu = token.trimmed().toInt(&ok);
+    if (ok && cpu >= 0)
+    {
+      config.cpu_affinity.push_back(cpu);
+    }
+  }
+  config.fifo_priority = std::clamp(settings.value(group + "/fifo_priority", 0).toInt(), 0, 99);
+  config.busy_poll = settings.value(group + "/busy_poll", false).toBool();
+  return config;
+}
+
+void DataStreamer::applyToCurrentThread(const IngestThreadConfig& config)
+{
+#ifdef __linux__
+  if (!config.cpu_affinity.empty())
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (const int cpu : config.cpu_affinity)
+    {
+      if (cpu < CPU_SETSIZE)
+      {
+        CPU_SET(cpu, &cpus);
+      }
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0)
+    {
+      qWarning("DataStreamer: can't pin the ingest thread to the requested CPUs");
+    }
+  }
+  if (config.fifo_priority > 0)
+  {
+    sched_param param = {};
+    param.sched_priority = config.fifo_priority;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0)
+    {
+      qWarning("DataStreamer: SCHED_FIFO denied; grant CAP_SYS_NICE or raise the "
+               "rtprio limit in /etc/security/limits.d");
+    }
+  }
+#else
+  (void)config;
+#endif
+}
+
 void DataStreamer::setParserFactories(ParserFactories* parsers)
 {
   _parser_factories = parsers;
@@ -0,0 +1,77 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "PlotJuggler/playback_cursor.h"
+
+namespace PJ
+{
+
+void PlaybackCursor::seek(double time)
+{
+  _cursors.clear();
+
+  if (_datamap)
+  {
+    _cursors.reserve(_datamap->numeric.size());
+
+    for (const auto& [name, series] : _datamap->numeric)
+    {
+      Cursor cursor = { &name, &series, series.size() };
+
+      // first sample with x > time; getIndexFromX returns the closest
+      // sample, which may be on either side of the threshold
+      int index = series.getIndexFromX(time);
+      if (index >= 0)
+      {
+        cursor.next_index = size_t(index);
+        while (cursor.next_index > 0 && series.at(cursor.next_index - 1).x > time)
+        {
+          cursor.next_index--;
+        }
+        while (cursor.next_index < series.size() && series.at(cursor.next_index).x <= time)
+        {
+          cursor.next_index++;
+        }
+      }
+      _cursors.push_back(cursor);
+    }
+  }
+  _current_time = time;
+  _needs_seek = false;
+}
+
+size_t PlaybackCursor::advance(double time, const SampleCallback& callback)
+{
+  if (_needs_seek || time < _current_time ||
+      (_datamap && _cursors.size() != _datamap->numeric.size()))
+  {
+    seek(_current_time);
+  }
+
+  size_t published = 0;
+
+  for (auto& cursor : _cursors)
+  {
+    const PlotData& series = *cursor.series;
+    // appends at the back are the only modification that preserves the
+    // cursor; anything else requires an explicit seek()
+    while (cursor.next_index < series.size())
+    {
+      const auto& point = series.at(cursor.next_index);
+      if (point.x > time)
+      {
+        break;
+      }
+      callback(*cursor.name, point);
+      cursor.next_index++;
+      published++;
+    }
+  }
+  _current_time = time;
+  return published;
+}
+
+}  // namespace PJ
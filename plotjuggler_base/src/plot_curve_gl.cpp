@@ -0,0 +1,312 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "plot_curve_gl.h"
+
+#include <algorithm>
+
+#include <QMatrix4x4>
+#include <QOpenGLBuffer>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+#include <QPaintEngine>
+#include <QPainter>
+#include <QVector>
+
+#include "qwt_scale_map.h"
+#include "qwt_transform.h"
+#include "timeseries_qwt.h"
+
+// The axes mapping is applied entirely here: the vertex buffer never
+// changes when panning or zooming.
+static const char* VERTEX_SHADER = "attribute highp vec2 a_pos;\n"
+                                   "uniform highp mat4 u_mvp;\n"
+                                   "uniform mediump float u_point_size;\n"
+                                   "void main() {\n"
+                                   "  gl_Position = u_mvp * vec4(a_pos, 0.0, 1.0);\n"
+                                   "  gl_PointSize = u_point_size;\n"
+                                   "}\n";
+
+static const char* FRAGMENT_SHADER = "uniform lowp vec4 u_color;\n"
+                                     "void main() {\n"
+                                     "  gl_FragColor = u_color;\n"
+                                     "}\n";
+
+struct PlotCurveGL::GLData
+{
+  QOpenGLShaderProgram* program = nullptr;
+  QOpenGLBuffer vbo{ QOpenGLBuffer::VertexBuffer };
+  QOpenGLContext* context = nullptr;
+  // number of points currently in the buffer / allocated capacity
+  size_t uploaded = 0;
+  size_t capacity = 0;
+  // vertices are stored relative to the first sample, because a float has
+  // too few mantissa bits for absolute timestamps (epoch seconds)
+  QPointF origin;
+  QPointF front_sample;
+  QPointF last_sample;
+};
+
+PlotCurveGL::PlotCurveGL(const QString& title) : QwtPlotCurve(title)
+{
+}
+
+PlotCurveGL::~PlotCurveGL()
+{
+  if (_gl)
+  {
+    // GPU handles are reclaimed through the context resource guards of Qt,
+    // even when no context is current here
+    delete _gl->program;
+  }
+}
+
+void PlotCurveGL::drawLines(QPainter* painter, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                            const QRectF& canvasRect, int from, int to) const
+{
+  if (canUseBatch(painter, xMap, yMap) && drawBatched(painter, xMap, yMap, false))
+  {
+    return;
+  }
+  // one polyline per run of contiguous samples, so that a hole in the
+  // series is not bridged by a false line
+  if (const auto* series = dynamic_cast<const QwtTimeseries*>(data()))
+  {
+    if (series->paintSegments(from, to, _gap_segments))
+    {
+      for (const auto& segment : _gap_segments)
+      {
+        QwtPlotCurve::drawLines(painter, xMap, yMap, canvasRect, segment.first, segment.second);
+      }
+      return;
+    }
+  }
+  QwtPlotCurve::drawLines(painter, xMap, yMap, canvasRect, from, to);
+}
+
+void PlotCurveGL::drawDots(QPainter* painter, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                           const QRectF& canvasRect, int from, int to) const
+{
+  if (canUseBatch(painter, xMap, yMap) && drawBatched(painter, xMap, yMap, true))
+  {
+    return;
+  }
+  QwtPlotCurve::drawDots(painter, xMap, yMap, canvasRect, from, to);
+}
+
+bool PlotCurveGL::canUseBatch(const QPainter* painter, const QwtScaleMap& xMap,
+                              const QwtScaleMap& yMap) const
+{
+  const QPaintEngine* engine = painter->paintEngine();
+  if (!engine || engine->type() != QPaintEngine::OpenGL2)
+  {
+    return false;
+  }
+  // anything the shader path can not reproduce faithfully is rendered
+  // through the regular Qwt rasterization
+  if (painter->pen().style() != Qt::SolidLine || !painter->transform().isIdentity())
+  {
+    return false;
+  }
+  if (brush().style() != Qt::NoBrush || testCurveAttribute(QwtPlotCurve::Fitted))
+  {
+    return false;
+  }
+  auto isLinear = [](const QwtScaleMap& map) {
+    const QwtTransform* transform = map.transformation();
+    return transform == nullptr || dynamic_cast<const QwtNullTransform*>(transform) != nullptr;
+  };
+  return isLinear(xMap) && isLinear(yMap);
+}
+
+bool PlotCurveGL::uploadSamples() const
+{
+  const QwtSeriesData<QPointF>* series = data();
+  const size_t count = series ? size_t(series->size()) : 0;
+  if (count == 0)
+  {
+    return false;
+  }
+  GLData& gl = *_gl;
+
+  // Detect anything that is not a pure append: the front of the series
+  // trimmed by the streaming buffer, a recomputed transform, reloaded data.
+  const QPointF front = series->sample(0);
+  if (gl.uploaded > count ||
+      (gl.uploaded > 0 &&
+       (front != gl.front_sample || series->sample(int(gl.uploaded) - 1) != gl.last_sample)))
+  {
+    gl.uploaded = 0;
+  }
+
+  // grow the buffer geometrically
+  if (count > gl.capacity || !gl.vbo.isCreated())
+  {
+    if (!gl.vbo.isCreated() && !gl.vbo.create())
+    {
+      return false;
+    }
+    size_t new_capacity = std::max<size_t>(gl.capacity, 4096);
+    while (new_capacity < count)
+    {
+      new_capacity *= 2;
+    }
+    gl.vbo.bind();
+    gl.vbo.allocate(int(new_capacity * 2 * sizeof(float)));
+    gl.capacity = new_capacity;
+    gl.uploaded = 0;  // allocate() discarded the previous content
+  }
+  else
+  {
+    gl.vbo.bind();
+  }
+
+  if (gl.uploaded == count)
+  {
+    return true;
+  }
+  if (gl.uploaded == 0)
+  {
+    gl.origin = front;
+  }
+
+  QVector<float> staging;
+  staging.reserve(int(count - gl.uploaded) * 2);
+  for (size_t i = gl.uploaded; i < count; i++)
+  {
+    const QPointF point = series->sample(int(i));
+    staging.push_back(float(point.x() - gl.origin.x()));
+    staging.push_back(float(point.y() - gl.origin.y()));
+  }
+  gl.vbo.write(int(gl.uploaded * 2 * sizeof(float)), staging.constData(),
+               staging.size() * int(sizeof(float)));
+
+  gl.uploaded = count;
+  gl.front_sample = front;
+  gl.last_sample = series->sample(int(count) - 1);
+  return true;
+}
+
+bool PlotCurveGL::drawBatched(QPainter* painter, const QwtScaleMap& xMap,
+                              const QwtScaleMap& yMap, bool as_dots) const
+{
+  // drawCurve() configures the painter pen (LinesAndDots enlarges it for
+  // the dots pass); capture it before switching to native painting
+  const QPen pen = painter->pen();
+  const double width_px = double(painter->device()->width());
+  const double height_px = double(painter->device()->height());
+  const float pixel_ratio = float(painter->device()->devicePixelRatioF());
+
+  painter->beginNativePainting();
+
+  bool drawn = false;
+  do
+  {
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    if (!context || width_px <= 0 || height_px <= 0)
+    {
+      break;
+    }
+    if (!_gl)
+    {
+      _gl.reset(new GLData);
+      _gl->context = context;
+    }
+    GLData& gl = *_gl;
+    if (gl.context != context)
+    {
+      // the canvas was recreated with a new context: everything is stale.
+      // The old buffer handle is released through its resource guard.
+      delete gl.program;
+      gl = GLData{};
+      gl.context = context;
+    }
+
+    if (!gl.program)
+    {
+      auto program = std::make_unique<QOpenGLShaderProgram>();
+      if (!program->addShaderFromSourceCode(QOpenGLShader::Vertex, VERTEX_SHADER) ||
+          !program->addShaderFromSourceCode(QOpenGLShader::Fragment, FRAGMENT_SHADER))
+      {
+        break;
+      }
+      program->bindAttributeLocation("a_pos", 0);
+      if (!program->link())
+      {
+        break;
+      }
+      gl.program = program.release();
+    }
+
+    if (!gl.program->bind())
+    {
+      break;
+    }
+    if (!uploadSamples())  // leaves the vertex buffer bound on success
+    {
+      gl.program->release();
+      break;
+    }
+
+    // from (data - origin) to painter coordinates, then to clip space.
+    // The factors are combined in double precision before narrowing.
+    const double fx = (xMap.p2() - xMap.p1()) / (xMap.s2() - xMap.s1());
+    const double fy = (yMap.p2() - yMap.p1()) / (yMap.s2() - yMap.s1());
+    QMatrix4x4 mvp;
+    mvp.ortho(0.0f, float(width_px), float(height_px), 0.0f, -1.0f, 1.0f);
+    mvp.translate(float(xMap.p1() + (gl.origin.x() - xMap.s1()) * fx),
+                  float(yMap.p1() + (gl.origin.y() - yMap.s1()) * fy));
+    mvp.scale(float(fx), float(fy));
+
+    const QColor color = pen.color();
+    gl.program->setUniformValue("u_mvp", mvp);
+    gl.program->setUniformValue("u_color", QVector4D(float(color.redF()), float(color.greenF()),
+                                                     float(color.blueF()), float(color.alphaF())));
+    gl.program->setUniformValue("u_point_size",
+                                std::max(1.0f, float(pen.widthF()) * pixel_ratio));
+
+    QOpenGLFunctions* functions = context->functions();
+    functions->glEnable(GL_BLEND);
+    functions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    if (as_dots)
+    {
+      if (!context->isOpenGLES())
+      {
+        functions->glEnable(0x8642);  // GL_PROGRAM_POINT_SIZE
+      }
+    }
+    else
+    {
+      functions->glLineWidth(std::max(1.0f, float(pen.widthF()) * pixel_ratio));
+    }
+
+    gl.program->enableAttributeArray(0);
+    gl.program->setAttributeBuffer(0, GL_FLOAT, 0, 2);
+    const auto* series_ts = as_dots ? nullptr : dynamic_cast<const QwtTimeseries*>(data());
+    if (series_ts && series_ts->paintSegments(0, int(gl.uploaded) - 1, _gap_segments))
+    {
+      // one strip per run of contiguous samples: holes are not bridged
+      for (const auto& segment : _gap_segments)
+      {
+        functions->glDrawArrays(GL_LINE_STRIP, segment.first,
+                                GLsizei(segment.second - segment.first + 1));
+      }
+    }
+    else
+    {
+      functions->glDrawArrays(as_dots ? GL_POINTS : GL_LINE_STRIP, 0, GLsizei(gl.uploaded));
+    }
+    gl.program->disableAttributeArray(0);
+
+    gl.vbo.release();
+    gl.program->release();
+    drawn = true;
+  } while (false);
+
+  painter->endNativePainting();
+  return drawn;
+}
@@ -0,0 +1,58 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PJ_PLOT_CURVE_GL_H
+#define PJ_PLOT_CURVE_GL_H
+
+#include "qwt_plot_curve.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * QwtPlotCurve that draws plain lines and dots as a single GL batch when the
+ * canvas is a QwtPlotOpenGLCanvas (the "use OpenGL" preference).
+ *
+ * The samples are kept in a vertex buffer in data coordinates, appended
+ * incrementally while streaming, and the axes mapping is applied in the
+ * vertex shader: panning or zooming only changes a uniform matrix, instead
+ * of re-projecting and rasterizing every point with QPainter.
+ *
+ * Whenever the batched path cannot reproduce the Qwt rendering faithfully
+ * (raster canvas, non-linear scales, dashed pens, filled curves, fitted
+ * curves) it silently falls back to the regular QwtPlotCurve drawing.
+ */
+class PlotCurveGL : public QwtPlotCurve
+{
+public:
+  explicit PlotCurveGL(const QString& title);
+
+  ~PlotCurveGL() override;
+
+protected:
+  void drawLines(QPainter* painter, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                 const QRectF& canvasRect, int from, int to) const override;
+
+  void drawDots(QPainter* painter, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                const QRectF& canvasRect, int from, int to) const override;
+
+private:
+  struct GLData;
+  mutable std::unique_ptr<GLData> _gl;
+
+  bool drawBatched(QPainter* painter, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                   bool as_dots) const;
+
+  bool canUseBatch(const QPainter* painter, const QwtScaleMap& xMap,
+                   const QwtScaleMap& yMap) const;
+
+  bool uploadSamples() const;
+
+  // scratch for QwtTimeseries::paintSegments(), reused across paints
+  mutable std::vector<std::pair<int, int>> _gap_segments;
+};
+
+#endif  // PJ_PLOT_CURVE_GL_H
@@ -5,81 +5,97 @@
  */
 
 #include "PlotJuggler/plotdata.h"
+#include "PlotJuggler/thread_pool.h"
+#include "PlotJuggler/util/block_pool.hpp"
 
 namespace PJ
 {
-template <typename T>
-typename std::unordered_map<std::string, T>::iterator
-addImpl(std::unordered_map<std::string, T>& series, const std::string& name, PlotGroup::Ptr group)
+namespace
 {
-  std::string ID;
-  if (group)
-  {
-    ID = group->name();
-    if (ID.back() != '/')
-    {
-      ID.push_back('/');
-    }
-  }
-  ID += name;
-
-  return series
-      .emplace(std::piecewise_construct, std::forward_as_tuple(name),
-               std::forward_as_tuple(name, group))
-      .first;
+// std::unordered_map<std::string, ...> cannot be probed with a
+// string_view before C++20: materialize the key into a buffer whose
+// capacity survives across calls, so the hit path of the accessors below
+// performs no heap allocation once warmed up.
+const std::string& LookupKey(std::string_view name)
+{
+  static thread_local std::string key;
+  key.assign(name.data(), name.size());
+  return key;
 }
+}  // namespace
 
 template <typename T>
-T& getOrCreateImpl(std::unordered_map<std::string, T>& series, const std::string& name,
-                   const PlotGroup::Ptr& group)
+typename std::unordered_map<std::string, T>::iterator
+addImpl(std::unordered_map<std::string, T>& series, std::string_view name, PlotGroup::Ptr group,
+        uint64_t& names_revision)
 {
-  auto it = series.find(name);
-  if (it == series.end())
+  auto res = series.emplace(std::piecewise_construct, std::forward_as_tuple(name),
+                            std::forward_as_tuple(std::string(name), group));
+  if (res.second)
   {
-    it = addImpl(series, name, group);
+    names_revision++;
   }
-  return it->second;
+  return res.first;
 }
 
-ScatterXYMap::iterator PlotDataMapRef::addScatterXY(const std::string& name, PlotGroup::Ptr group)
+ScatterXYMap::iterator PlotDataMapRef::addScatterXY(std::string_view name, PlotGroup::Ptr group)
 {
-  return addImpl(scatter_xy, name, group);
+  return addImpl(scatter_xy, name, group, names_revision);
 }
 
-TimeseriesMap::iterator PlotDataMapRef::addNumeric(const std::string& name, PlotGroup::Ptr group)
+TimeseriesMap::iterator PlotDataMapRef::addNumeric(std::string_view name, PlotGroup::Ptr group)
 {
-  return addImpl(numeric, name, group);
+  auto it = addImpl(numeric, name, group, names_revision);
+  it->second.setSharedTimeRange(numeric_range);
+  return it;
 }
 
-AnySeriesMap::iterator PlotDataMapRef::addUserDefined(const std::string& name, PlotGroup::Ptr group)
+AnySeriesMap::iterator PlotDataMapRef::addUserDefined(std::string_view name, PlotGroup::Ptr group)
 {
-  return addImpl(user_defined, name, group);
+  return addImpl(user_defined, name, group, names_revision);
 }
 
-StringSeriesMap::iterator PlotDataMapRef::addStringSeries(const std::string& name,
+StringSeriesMap::iterator PlotDataMapRef::addStringSeries(std::string_view name,
                                                           PlotGroup::Ptr group)
 {
-  return addImpl(strings, name, group);
+  return addImpl(strings, name, group, names_revision);
+}
+
+PlotDataXY& PlotDataMapRef::getOrCreateScatterXY(std::string_view name, PlotGroup::Ptr group)
+{
+  auto it = scatter_xy.find(LookupKey(name));
+  return (it != scatter_xy.end()) ? it->second : addScatterXY(name, group)->second;
 }
 
-PlotDataXY& PlotDataMapRef::getOrCreateScatterXY(const std::string& name, PlotGroup::Ptr group)
+PlotData& PlotDataMapRef::getOrCreateNumeric(std::string_view name, PlotGroup::Ptr group)
 {
-  return getOrCreateImpl(scatter_xy, name, group);
+  auto it = numeric.find(LookupKey(name));
+  if (it == numeric.end())
+  {
+    return addNumeric(name, group)->second;
+  }
+  it->second.setSharedTimeRange(numeric_range);
+  return it->second;
 }
 
-PlotData& PlotDataMapRef::getOrCreateNumeric(const std::string& name, PlotGroup::Ptr group)
+StringSeries& PlotDataMapRef::getOrCreateStringSeries(std::string_view name, PlotGroup::Ptr group)
 {
-  return getOrCreateImpl(numeric, name, group);
+  auto it = strings.find(LookupKey(name));
+  return (it != strings.end()) ? it->second : addStringSeries(name, group)->second;
 }
 
-StringSeries& PlotDataMapRef::getOrCreateStringSeries(const std::string& name, PlotGroup::Ptr group)
+PlotDataAny& PlotDataMapRef::getOrCreateUserDefined(std::string_view name, PlotGroup::Ptr group)
 {
-  return getOrCreateImpl(strings, name, group);
+  auto it = user_defined.find(LookupKey(name));
+  return (it != user_defined.end()) ? it->second : addUserDefined(name, group)->second;
 }
 
-PlotDataAny& PlotDataMapRef::getOrCreateUserDefined(const std::string& name, PlotGroup::Ptr group)
+PlotData& PlotDataMapRef::appendBatch(std::string_view name, const double* xs, const double* ys,
+                                      size_t count, PlotGroup::Ptr group)
 {
-  return getOrCreateImpl(user_defined, name, group);
+  auto& series = getOrCreateNumeric(name, group);
+  series.appendBatch(xs, ys, count);
+  return series;
 }
 
 PlotGroup::Ptr PlotDataMapRef::getOrCreateGroup(const std::string& name)
@@ -96,6 +112,44 @@ PlotGroup::Ptr PlotDataMapRef::getOrCreateGroup(const std::string& name)
   return group;
 }
 
+std::optional<PlotDataMapRef::SeriesSnapshot>
+PlotDataMapRef::snapshotNumeric(std::string_view name, RangeOpt range_x) const
+{
+  auto it = numeric.find(LookupKey(name));
+  if (it == numeric.end())
+  {
+    return std::nullopt;
+  }
+  const PlotData& series = it->second;
+  // merge the staged out-of-order samples, so the copy below sees them
+  series.rangeX();
+  if (series.size() == 0)
+  {
+    return std::nullopt;
+  }
+
+  size_t first = 0;
+  size_t last = series.size() - 1;
+  if (range_x)
+  {
+    const int min_index = series.getIndexFromX(range_x->min);
+    const int max_index = series.getIndexFromX(range_x->max);
+    if (min_index < 0 || max_index < min_index)
+    {
+      return std::nullopt;
+    }
+    first = size_t(min_index);
+    last = size_t(max_index);
+  }
+
+  SeriesSnapshot snapshot;
+  const size_t count = last - first + 1;
+  snapshot.xs.resize(count);
+  snapshot.ys.resize(count);
+  series.extractSamples(first, count, snapshot.xs.data(), snapshot.ys.data());
+  return snapshot;
+}
+
 std::unordered_set<std::string> PlotDataMapRef::getAllNames() const
 {
   std::unordered_set<std::string> out;
@@ -111,6 +165,10 @@ std::unordered_set<std::string> PlotDataMapRef::getAllNames() const
   {
     out.insert(it.first);
   }
+  for (auto& it : scatter_xy)
+  {
+    out.insert(it.first);
+  }
   return out;
 }
 
@@ -119,26 +177,255 @@ void PlotDataMapRef::clear()
   numeric.clear();
   strings.clear();
   user_defined.clear();
+  names_revision++;
+  numeric_range->stale.store(true, std::memory_order_relaxed);
+  // series destruction refilled the block pool: hand the memory back in bulk
+  BlockPool::instance().releaseFreeBlocks();
+}
+
+const SharedTimeRange& PlotDataMapRef::numericRangeX()
+{
+  auto& acc = *numeric_range;
+  // a mismatching count means series were added or removed without going
+  // through addNumeric()/erase(), e.g. by MoveData(): refresh and adopt them
+  if (acc.stale.load(std::memory_order_relaxed) || acc.series_count != numeric.size())
+  {
+    acc.range = std::nullopt;
+    acc.max_size = 0;
+    for (auto& it : numeric)
+    {
+      auto& series = it.second;
+      series.setSharedTimeRange(numeric_range);
+      if (auto series_range = series.rangeX())
+      {
+        if (!acc.range)
+        {
+          acc.range = *series_range;
+        }
+        else
+        {
+          acc.range->min = std::min(acc.range->min, series_range->min);
+          acc.range->max = std::max(acc.range->max, series_range->max);
+        }
+      }
+      acc.max_size = std::max(acc.max_size, series.size());
+    }
+    acc.series_count = numeric.size();
+    acc.stale.store(false, std::memory_order_relaxed);
+  }
+  return acc;
 }
 
 void PlotDataMapRef::setMaximumRangeX(double range)
 {
-  for (auto& it : numeric)
+  // Workers trimming their share of the series would race to extend the
+  // shared accumulator: invalidate it up-front, so every
+  // growSharedRange() below is a no-op and the next numericRangeX()
+  // rebuilds it from the trimmed series.
+  numeric_range->stale.store(true, std::memory_order_relaxed);
+
+  // below this many series the submit/join overhead exceeds the trim
+  constexpr size_t MIN_SERIES_PER_TASK = 64;
+
+  const size_t total = numeric.size() + strings.size() + user_defined.size();
+  const size_t num_workers = ThreadPool::instance().threadCount();
+
+  if (total <= MIN_SERIES_PER_TASK || num_workers < 2)
   {
-    it.second.setMaximumRangeX(range);
+    for (auto& it : numeric)
+    {
+      it.second.setMaximumRangeX(range);
+    }
+    for (auto& it : strings)
+    {
+      it.second.setMaximumRangeX(range);
+    }
+    for (auto& it : user_defined)
+    {
+      it.second.setMaximumRangeX(range);
+    }
+    return;
   }
-  for (auto& it : strings)
+
+  // Trim in parallel over the shared pool, one chunk of series per task,
+  // and join before returning: the caller keeps the same exclusive access
+  // window it already had, only the walk inside it is parallel.
+  std::atomic<size_t> remaining(0);
+  std::mutex mutex;
+  std::condition_variable all_done;
+
+  const size_t chunk_size =
+      std::max(MIN_SERIES_PER_TASK, (total + num_workers - 1) / num_workers);
+
+  auto submitChunks = [&](auto& series_map) {
+    using Series = typename std::decay_t<decltype(series_map)>::mapped_type;
+    std::vector<Series*> chunk;
+    auto flush = [&]() {
+      if (chunk.empty())
+      {
+        return;
+      }
+      remaining.fetch_add(1);
+      ThreadPool::instance().submit(
+          ThreadPool::Priority::TRANSFORM,
+          [range, batch = std::move(chunk), &remaining, &mutex, &all_done]() {
+            for (auto* series : batch)
+            {
+              series->setMaximumRangeX(range);
+            }
+            if (remaining.fetch_sub(1) == 1)
+            {
+              std::lock_guard<std::mutex> lock(mutex);
+              all_done.notify_one();
+            }
+          });
+      chunk = {};
+    };
+    for (auto& it : series_map)
+    {
+      chunk.push_back(&it.second);
+      if (chunk.size() >= chunk_size)
+      {
+        flush();
+      }
+    }
+    flush();
+  };
+  submitChunks(numeric);
+  submitChunks(strings);
+  submitChunks(user_defined);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  all_done.wait(lock, [&remaining]() { return remaining.load() == 0; });
+}
+
+size_t PlotDataMapRef::memoryUsage() const
+{
+  auto mapUsage = [](const auto& series_map) {
+    using Series = typename std::decay_t<decltype(series_map)>::mapped_type;
+    size_t bytes = 0;
+    for (const auto& it : series_map)
+    {
+      // spilled samples live in the temp file, not on the heap
+      const size_t resident =
+          (it.second.size() - it.second.spilledPoints()) * sizeof(typename Series::Point);
+      // compressed chunks only occupy their compressed size
+      const size_t saved = it.second.compressedSavedBytes();
+      bytes += resident - std::min(saved, resident);
+    }
+    return bytes;
+  };
+  return mapUsage(numeric) + mapUsage(strings) + mapUsage(scatter_xy) + mapUsage(user_defined);
+}
+
+size_t PlotDataMapRef::compressColdData(size_t keep_recent_points)
+{
+  size_t saved = 0;
+  auto compressMap = [&saved, keep_recent_points](auto& series_map) {
+    for (auto& it : series_map)
+    {
+      saved += it.second.compressColdPoints(keep_recent_points);
+    }
+  };
+  // same scope as setMaximumRangeX(): only the time-ordered series, where
+  // the oldest samples are guaranteed to be in the front chunks
+  compressMap(numeric);
+  compressMap(strings);
+  compressMap(user_defined);
+  return saved;
+}
+
+size_t PlotDataMapRef::spillColdData(size_t keep_recent_points)
+{
+  size_t moved = 0;
+  auto spillMap = [&moved, keep_recent_points](auto& series_map) {
+    for (auto& it : series_map)
+    {
+      moved += it.second.spillColdPoints(keep_recent_points);
+    }
+  };
+  // same scope as setMaximumRangeX(): only the time-ordered series, where
+  // the oldest samples are guaranteed to be in the front chunks
+  spillMap(numeric);
+  spillMap(strings);
+  spillMap(user_defined);
+  return moved;
+}
+
+std::vector<PlotDataMapRef::SeriesFootprint> PlotDataMapRef::memoryProfile() const
+{
+  std::vector<SeriesFootprint> profile;
+  profile.reserve(numeric.size() + strings.size() + scatter_xy.size() + user_defined.size());
+
+  auto profileMap = [&profile](const auto& series_map, const char* kind) {
+    for (const auto& it : series_map)
+    {
+      profile.push_back({ it.first, kind, it.second.size(), it.second.memoryFootprint() });
+    }
+  };
+  profileMap(numeric, "numeric");
+  profileMap(strings, "string");
+  profileMap(scatter_xy, "scatter_xy");
+  profileMap(user_defined, "user_defined");
+  return profile;
+}
+
+size_t PlotDataMapRef::enforceMemoryBudget(size_t budget_bytes)
+{
+  size_t usage = memoryUsage();
+  if (usage <= budget_bytes)
   {
-    it.second.setMaximumRangeX(range);
+    return 0;
   }
-  for (auto& it : user_defined)
+  // compress before spilling, spill before evicting: each tier is
+  // lossless and only the remaining overshoot falls through to the next
+  const size_t compressed = compressColdData();
+  if (compressed > 0)
   {
-    it.second.setMaximumRangeX(range);
+    usage = memoryUsage();
+    if (usage <= budget_bytes)
+    {
+      return compressed;
+    }
+  }
+  // series on a backend with the disk tier move their cold chunks to the
+  // temp file without losing a single sample
+  const size_t spilled = compressed + spillColdData();
+  if (spilled > compressed)
+  {
+    usage = memoryUsage();
+    if (usage <= budget_bytes)
+    {
+      return spilled;
+    }
   }
+  // aim slightly below the budget, so that the next batch of samples does
+  // not trigger another eviction immediately
+  const double ratio = 0.9 * double(budget_bytes) / double(usage);
+
+  auto trimMap = [ratio](auto& series_map) {
+    for (auto& it : series_map)
+    {
+      auto& series = it.second;
+      const size_t target_size = static_cast<size_t>(double(series.size()) * ratio);
+      while (series.size() > target_size)
+      {
+        series.popFront();
+      }
+    }
+  };
+  // same scope as setMaximumRangeX(): only the time-ordered series are
+  // trimmed, where the front is guaranteed to be the oldest sample
+  trimMap(numeric);
+  trimMap(strings);
+  trimMap(user_defined);
+
+  return spilled + usage - memoryUsage();
 }
 
-bool PlotDataMapRef::erase(const std::string& name)
+bool PlotDataMapRef::erase(std::string_view name_view)
 {
+  const std::string& name = LookupKey(name_view);
   bool erased = false;
   auto num_it = numeric.find(name);
   if (num_it != numeric.end())
@@ -160,6 +447,10 @@ bool PlotDataMapRef::erase(const std::string& name)
     user_defined.erase(any_it);
     erased = true;
   }
+  if (erased)
+  {
+    names_revision++;
+  }
   return erased;
 }
 
@@ -47,12 +47,58 @@ QRectF PlotLegend::hideButtonRect() const
   return QRectF(geometry(canvas_rect).topLeft() + QPoint(-s, -s), QSize(s * 2, s * 2));
 }
 
+void PlotLegend::updateLegend(const QwtPlotItem* item, const QList<QwtLegendData>& data)
+{
+  _cache_dirty = true;
+  QwtPlotLegendItem::updateLegend(item, data);
+}
+
+void PlotLegend::drawCached(QPainter* painter, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                            const QRectF& canvas_rect) const
+{
+  const QRect geom = geometry(canvas_rect);
+  if (!geom.isValid())
+  {
+    return;
+  }
+
+  // restyles that do not pass through updateLegend(): curves toggled from
+  // the legend (grayed title) and palette / theme changes
+  quint64 signature = quint64(_parent_plot->canvas()->palette().foreground().color().rgba());
+  for (const auto* item : plotItems())
+  {
+    signature = signature * 1099511628211ULL + (item->isVisible() ? 3 : 7);
+  }
+
+  const qreal pixel_ratio = painter->device()->devicePixelRatioF();
+  const QSize cache_size = geom.size() * pixel_ratio;
+
+  if (_cache_dirty || signature != _cache_signature || _cache.size() != cache_size)
+  {
+    QPixmap pixmap(cache_size);
+    pixmap.setDevicePixelRatio(pixel_ratio);
+    pixmap.fill(Qt::transparent);
+
+    QPainter cache_painter(&pixmap);
+    cache_painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+    cache_painter.translate(-geom.topLeft());
+    QwtPlotLegendItem::draw(&cache_painter, xMap, yMap, canvas_rect);
+    cache_painter.end();
+
+    _cache = std::move(pixmap);
+    _cache_signature = signature;
+    _cache_dirty = false;
+  }
+
+  painter->drawPixmap(geom.topLeft(), _cache);
+}
+
 void PlotLegend::draw(QPainter* painter, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
                       const QRectF& rect) const
 {
   if (!_collapsed)
   {
-    QwtPlotLegendItem::draw(painter, xMap, yMap, rect);
+    drawCached(painter, xMap, yMap, rect);
   }
 
   QRectF iconRect = hideButtonRect();
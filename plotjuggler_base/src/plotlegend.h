@@ -8,6 +8,7 @@
 #define PLOTLEGEND_H
 
 #include <QObject>
+#include <QPixmap>
 #include "qwt_plot_legenditem.h"
 #include "qwt_plot.h"
 
@@ -21,6 +22,11 @@ public:
 
   const QwtPlotItem* processMousePressEvent(QMouseEvent* mouse_event);
 
+  /// Invalidates the pixmap cache: called by Qwt whenever a curve is
+  /// added, removed, renamed or restyled.
+  virtual void updateLegend(const QwtPlotItem* item,
+                            const QList<QwtLegendData>& data) override;
+
 private:
   virtual void draw(QPainter* p, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
                     const QRectF& rect) const override;
@@ -30,8 +36,19 @@ private:
 
   virtual void drawBackground(QPainter* painter, const QRectF& rect) const override;
 
+  /// Blit the cached rendering of the entries, refreshing it first when
+  /// something changed. Laying out and drawing 40 curve titles on every
+  /// replot is measurable; blitting one pixmap is not.
+  void drawCached(QPainter* painter, const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                  const QRectF& canvas_rect) const;
+
   QwtPlot* _parent_plot;
   bool _collapsed;
+
+  // the cache is refreshed inside draw(), which Qwt declares const
+  mutable QPixmap _cache;
+  mutable quint64 _cache_signature = 0;
+  mutable bool _cache_dirty = true;
 };
 
 #endif  // PLOTLEGEND_H
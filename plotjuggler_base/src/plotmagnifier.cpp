@@ -4,6 +4,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
+#include <cmath>
 #include <limits>
 #include <QDebug>
 #include <QWheelEvent>
@@ -20,6 +21,10 @@ PlotMagnifier::PlotMagnifier(QWidget* canvas) : QwtPlotMagnifier(canvas), _defau
     _lower_bounds[axisId] = std::numeric_limits<double>::lowest();
     _upper_bounds[axisId] = std::numeric_limits<double>::max();
   }
+
+  _wheel_timer.setSingleShot(true);
+  _wheel_timer.setInterval(16);  // one rescale per frame at 60 Hz
+  connect(&_wheel_timer, &QTimer::timeout, this, &PlotMagnifier::applyPendingWheel);
 }
 
 PlotMagnifier::~PlotMagnifier()
@@ -151,7 +156,41 @@ QPointF PlotMagnifier::invTransform(QPoint pos)
 void PlotMagnifier::widgetWheelEvent(QWheelEvent* event)
 {
   _mouse_position = invTransform(event->pos());
-  QwtPlotMagnifier::widgetWheelEvent(event);
+
+  if (event->modifiers() != wheelModifiers() || wheelFactor() == 0.0)
+  {
+    return;
+  }
+
+  const QPoint delta = event->angleDelta();
+  _pending_wheel_delta += (qAbs(delta.x()) > qAbs(delta.y())) ? delta.x() : delta.y();
+
+  if (!_wheel_timer.isActive())
+  {
+    // leading edge: react to the first tick right away, coalesce the rest
+    applyPendingWheel();
+  }
+}
+
+void PlotMagnifier::applyPendingWheel()
+{
+  const int wheel_delta = _pending_wheel_delta;
+  _pending_wheel_delta = 0;
+  if (wheel_delta == 0)
+  {
+    return;
+  }
+
+  // same factor QwtMagnifier::widgetWheelEvent() would compute, applied
+  // once for the accumulated delta instead of once per event
+  double factor = std::pow(wheelFactor(), qAbs(wheel_delta / 120.0));
+  if (wheel_delta > 0)
+  {
+    factor = 1.0 / factor;
+  }
+  rescale(factor);
+
+  _wheel_timer.start();
 }
 
 void PlotMagnifier::widgetMousePressEvent(QMouseEvent* event)
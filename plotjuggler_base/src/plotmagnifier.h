@@ -55,7 +55,18 @@ signals:
 
 private:
   QPointF invTransform(QPoint pos);
-  QTimer _future_emit;
+
+  /// Apply the wheel delta accumulated since the last rescale, if any.
+  void applyPendingWheel();
+
+  // Inertial trackpads emit dozens of small wheel events per second.
+  // The first one rescales immediately; the ones arriving while
+  // _wheel_timer runs only accumulate into _pending_wheel_delta, so the
+  // plot is rescaled and replotted at most once per frame, at the scale
+  // reached by the whole burst.
+  QTimer _wheel_timer;
+  int _pending_wheel_delta = 0;
+
   AxisMode _default_mode;
 };
 
@@ -5,8 +5,12 @@
  */
 
 #include "PlotJuggler/plotwidget_base.h"
+#include "PlotJuggler/string_interner.h"
+#include "PlotJuggler/util/perf_monitor.hpp"
+#include "PlotJuggler/util/render_governor.hpp"
 #include "timeseries_qwt.h"
 
+#include "plot_curve_gl.h"
 #include "plotmagnifier.h"
 #include "plotzoomer.h"
 #include "plotlegend.h"
@@ -18,6 +22,7 @@
 #include "qwt_plot_grid.h"
 #include "qwt_plot_canvas.h"
 #include "qwt_plot_curve.h"
+#include "qwt_plot_intervalcurve.h"
 #include "qwt_plot_opengl_canvas.h"
 #include "qwt_plot_rescaler.h"
 #include "qwt_plot_legenditem.h"
@@ -30,8 +35,12 @@
 #include "qwt_symbol.h"
 #include "qwt_text.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <limits>
 #include <QBoxLayout>
+#include <QPainter>
 #include <QMessageBox>
 #include <QSettings>
 #include <QDebug>
@@ -142,6 +151,63 @@ public:
 
   bool zoom_enabled = true;
 
+  //--- envelope display mode, see PlotWidgetBase::setEnvelopeEnabled() ---
+
+  bool envelope_enabled = false;
+
+  struct EnvelopeItems
+  {
+    QwtPlotIntervalCurve* band = nullptr;
+    QwtPlotCurve* mean = nullptr;
+    TimeseriesEnvelope envelope;
+  };
+  std::map<QwtPlotCurve*, EnvelopeItems> envelope_items;
+
+  void dropEnvelope(QwtPlotCurve* curve)
+  {
+    auto it = envelope_items.find(curve);
+    if (it == envelope_items.end())
+    {
+      return;
+    }
+    it->second.band->detach();
+    delete it->second.band;
+    it->second.mean->detach();
+    delete it->second.mean;
+    envelope_items.erase(it);
+  }
+
+  //--- scroll-blit state, see PlotWidgetBase::setScrollBlitEnabled() ---
+
+  bool scroll_blit_enabled = false;
+
+  /// What the previous replot painted: used to decide whether the next one
+  /// is a pure horizontal shift of the same picture.
+  struct LastFrame
+  {
+    bool valid = false;
+    /// the x axis the curves were attached to (timeseries curves may sit on
+    /// a hidden axis mirroring the visible one shifted by the time offset)
+    int x_axis = QwtPlot::xBottom;
+    double x_s1 = 0;
+    double x_s2 = 0;
+    double y_s1 = 0;
+    double y_s2 = 0;
+    /// lower bound of xBottom, to detect whether the grid moved with the data
+    double grid_s1 = 0;
+    QSize canvas_size;
+    /// newest sample of each curve: anything beyond it was not painted yet
+    std::map<const QwtPlotCurve*, double> last_sample_x;
+  };
+  LastFrame last_frame;
+
+  /// fractional pixel carried from one blit to the next, so that rounding
+  /// the per-frame shift to whole pixels does not accumulate drift
+  double scroll_error = 0;
+
+  bool tryScrollBlit();
+  void rememberFrame();
+
   void dragEnterEvent(QDragEnterEvent* event) override
   {
     event_callback(event);
@@ -158,6 +224,276 @@ public:
   }
 };
 
+/// First index whose sample has x() >= value; data must be sorted by x.
+static int LowerBoundIndex(const QwtSeriesData<QPointF>* data, double value)
+{
+  int low = 0;
+  int high = int(data->size());
+  while (low < high)
+  {
+    const int mid = (low + high) / 2;
+    if (data->sample(mid).x() < value)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+bool PlotWidgetBase::QwtPlotPimpl::tryScrollBlit()
+{
+  if (!scroll_blit_enabled || !last_frame.valid || parent->isXYPlot() || curve_list.empty())
+  {
+    return false;
+  }
+  auto* plot_canvas = qobject_cast<QwtPlotCanvas*>(canvas());
+  if (!plot_canvas || !plot_canvas->testPaintAttribute(QwtPlotCanvas::BackingStore))
+  {
+    return false;
+  }
+
+  // all the curves must be scrolled by the same amount: a single x axis
+  const int x_axis = curve_list.front().curve->xAxis();
+  if (x_axis != last_frame.x_axis)
+  {
+    return false;
+  }
+
+  updateAxes();
+
+  const QPixmap* store_ro = plot_canvas->backingStore();
+  if (!store_ro || store_ro->isNull() || canvas()->size() != last_frame.canvas_size)
+  {
+    return false;
+  }
+  const qreal pixel_ratio = store_ro->devicePixelRatio();
+  if (store_ro->size() != canvas()->size() * pixel_ratio)
+  {
+    return false;
+  }
+
+  const QwtScaleMap xmap = canvasMap(x_axis);
+  const QwtScaleMap ymap = canvasMap(QwtPlot::yLeft);
+
+  // the previous picture can be reused only if this replot is a pure
+  // horizontal translation: same vertical range, same time span
+  if (ymap.s1() != last_frame.y_s1 || ymap.s2() != last_frame.y_s2)
+  {
+    return false;
+  }
+  const double span = xmap.s2() - xmap.s1();
+  const double last_span = last_frame.x_s2 - last_frame.x_s1;
+  if (span == 0.0 || std::abs(span - last_span) > 1e-9 * std::abs(span))
+  {
+    return false;
+  }
+  // a translated window is a pixel shift only on a linear scale: probe the
+  // midpoint to reject log and other custom transformations
+  const double mid_value = 0.5 * (xmap.s1() + xmap.s2());
+  if (std::abs(xmap.transform(mid_value) - 0.5 * (xmap.p1() + xmap.p2())) > 0.01)
+  {
+    return false;
+  }
+
+  const QRectF canvas_rect = plot_canvas->contentsRect();
+  const double px_per_unit = (xmap.p2() - xmap.p1()) / span;
+  const double shift = (xmap.s1() - last_frame.x_s1) * px_per_unit * pixel_ratio + scroll_error;
+  const int shift_px = int(std::lround(shift));
+
+  // only the follow-mode direction; a shift of zero means the range did not
+  // move and the data may have changed in place, which a blit would miss
+  if (shift_px <= 0 || shift_px > 0.4 * canvas_rect.width() * pixel_ratio)
+  {
+    return false;
+  }
+
+  // every visible item must either scroll with the curves or be repainted
+  // explicitly; anything unknown (markers, background items...) disqualifies
+  // the whole frame
+  const double curve_dx = (xmap.s1() - last_frame.x_s1) * px_per_unit * pixel_ratio;
+  std::vector<QRect> grid_strips;
+  for (QwtPlotItem* item : itemList())
+  {
+    if (!item->isVisible())
+    {
+      continue;
+    }
+    if (auto* curve = dynamic_cast<QwtPlotCurve*>(item))
+    {
+      if (curve->xAxis() != x_axis)
+      {
+        return false;
+      }
+    }
+    else if (auto* grid = dynamic_cast<QwtPlotGrid*>(item))
+    {
+      // horizontal grid lines are invariant under a horizontal blit; the
+      // vertical ones are not, unless their axis moved with the curves
+      const QwtScaleMap grid_map = canvasMap(grid->xAxis());
+      if (grid_map.s2() == grid_map.s1())
+      {
+        return false;
+      }
+      const double grid_dx = (grid_map.s1() - last_frame.grid_s1) *
+                             (grid_map.p2() - grid_map.p1()) /
+                             (grid_map.s2() - grid_map.s1()) * pixel_ratio;
+      if (std::abs(grid_dx - curve_dx) <= 0.5)
+      {
+        continue;
+      }
+      if (std::abs(grid_dx) > 0.01 || !(grid->xEnabled() || grid->xMinEnabled()))
+      {
+        return false;
+      }
+      // the axis is static: each vertical line was dragged left by the blit
+      // and must be repainted in place, together with the stripe it vacated
+      const QwtScaleDiv& scale_div = axisScaleDiv(grid->xAxis());
+      QList<double> ticks;
+      if (grid->xEnabled())
+      {
+        ticks += scale_div.ticks(QwtScaleDiv::MajorTick);
+      }
+      if (grid->xMinEnabled())
+      {
+        ticks += scale_div.ticks(QwtScaleDiv::MediumTick);
+        ticks += scale_div.ticks(QwtScaleDiv::MinorTick);
+      }
+      for (double tick : ticks)
+      {
+        const double tick_px = grid_map.transform(tick);
+        grid_strips.push_back(
+            QRect(QPoint(int(std::floor(tick_px - double(shift_px) / pixel_ratio - 2.0)),
+                         int(canvas_rect.top())),
+                  QPoint(int(std::ceil(tick_px + 2.0)), int(canvas_rect.bottom()))));
+      }
+    }
+    else if (item != legend)
+    {
+      return false;
+    }
+  }
+
+  // the strip exposed on the right, with some slack for the pen width...
+  double dirty_left = canvas_rect.right() - double(shift_px) / pixel_ratio - 3.0;
+  // ...extended to the left when a curve got samples that are newer than
+  // the last one painted, but further apart than the scroll amount
+  for (const auto& info : curve_list)
+  {
+    const auto* data = info.curve->data();
+    if (!info.curve->isVisible() || !data || data->size() == 0)
+    {
+      continue;
+    }
+    const double newest_x = data->sample(data->size() - 1).x();
+    const auto it = last_frame.last_sample_x.find(info.curve);
+    const double painted_x =
+        (it != last_frame.last_sample_x.end()) ? it->second : -std::numeric_limits<double>::max();
+    if (newest_x > painted_x)
+    {
+      dirty_left = std::min(dirty_left, xmap.transform(painted_x) - 3.0);
+    }
+  }
+  dirty_left = std::max(dirty_left, canvas_rect.left());
+
+  QRegion dirty(QRect(QPoint(int(std::floor(dirty_left)), int(canvas_rect.top())),
+                      QPoint(int(std::ceil(canvas_rect.right())), int(canvas_rect.bottom()))));
+  // the legend is anchored to the canvas, not to the data: scrolling moved
+  // the pixels beneath it, so its area must always be repainted
+  if (legend && legend->isVisible())
+  {
+    dirty += legend->geometry(canvas_rect).adjusted(-2, -2, 2, 2).intersected(canvas_rect).toAlignedRect();
+  }
+  for (const QRect& strip : grid_strips)
+  {
+    dirty += strip.intersected(canvas_rect.toAlignedRect());
+  }
+
+  QPixmap* store = const_cast<QPixmap*>(store_ro);
+  const QRect device_contents(int(canvas_rect.left() * pixel_ratio),
+                              int(canvas_rect.top() * pixel_ratio),
+                              int(canvas_rect.width() * pixel_ratio),
+                              int(canvas_rect.height() * pixel_ratio));
+  store->scroll(-shift_px, 0, device_contents);
+
+  {
+    QPainter painter(store);
+    for (const QRect& rect : dirty)
+    {
+      painter.setClipRect(rect);
+      painter.fillRect(rect, canvasBackground());
+    }
+
+    for (QwtPlotItem* item : itemList())
+    {
+      if (!item->isVisible())
+      {
+        continue;
+      }
+      const QwtScaleMap item_xmap = canvasMap(item->xAxis());
+      const QwtScaleMap item_ymap = canvasMap(item->yAxis());
+      painter.save();
+      painter.setRenderHint(QPainter::Antialiasing,
+                            item->testRenderHint(QwtPlotItem::RenderAntialiased));
+      for (const QRect& rect : dirty)
+      {
+        painter.setClipRect(rect);
+        if (auto* curve = dynamic_cast<QwtPlotCurve*>(item))
+        {
+          // paint only the samples overlapping this rectangle, with one
+          // extra on each side so the connecting segments cross the seam
+          const auto* data = curve->data();
+          const int from =
+              std::max(0, LowerBoundIndex(data, item_xmap.invTransform(rect.left() - 2)) - 1);
+          int to = -1;
+          if (rect.right() < canvas_rect.right() - 1)
+          {
+            to = std::min(int(data->size()) - 1,
+                          LowerBoundIndex(data, item_xmap.invTransform(rect.right() + 2)));
+          }
+          curve->drawSeries(&painter, item_xmap, item_ymap, QRectF(rect), from, to);
+        }
+        else
+        {
+          item->draw(&painter, item_xmap, item_ymap, QRectF(rect));
+        }
+      }
+      painter.restore();
+    }
+  }
+
+  scroll_error = shift - shift_px;
+  canvas()->update();
+  return true;
+}
+
+void PlotWidgetBase::QwtPlotPimpl::rememberFrame()
+{
+  last_frame.x_axis =
+      curve_list.empty() ? int(QwtPlot::xBottom) : int(curve_list.front().curve->xAxis());
+  const QwtScaleMap xmap = canvasMap(last_frame.x_axis);
+  const QwtScaleMap ymap = canvasMap(QwtPlot::yLeft);
+  last_frame.grid_s1 = canvasMap(QwtPlot::xBottom).s1();
+  last_frame.valid = true;
+  last_frame.x_s1 = xmap.s1();
+  last_frame.x_s2 = xmap.s2();
+  last_frame.y_s1 = ymap.s1();
+  last_frame.y_s2 = ymap.s2();
+  last_frame.canvas_size = canvas()->size();
+  last_frame.last_sample_x.clear();
+  for (const auto& info : curve_list)
+  {
+    const auto* data = info.curve->data();
+    if (data && data->size() > 0)
+    {
+      last_frame.last_sample_x[info.curve] = data->sample(data->size() - 1).x();
+    }
+  }
+}
+
 namespace PJ
 {
 QwtPlot* PlotWidgetBase::qwtPlot()
@@ -175,15 +511,24 @@ void PlotWidgetBase::resetZoom()
   updateMaximumZoomArea();
   QRectF rect = maxZoomRect();
 
-  qwtPlot()->setAxisScale(QwtPlot::yLeft, std::min(rect.bottom(), rect.top()),
-                          std::max(rect.bottom(), rect.top()));
-  qwtPlot()->setAxisScale(QwtPlot::xBottom, std::min(rect.left(), rect.right()),
-                          std::max(rect.left(), rect.right()));
+  setAxisScaleIfChanged(QwtPlot::yLeft, std::min(rect.bottom(), rect.top()),
+                        std::max(rect.bottom(), rect.top()));
+  setAxisScaleIfChanged(QwtPlot::xBottom, std::min(rect.left(), rect.right()),
+                        std::max(rect.left(), rect.right()));
   qwtPlot()->updateAxes();
 
   replot();
 }
 
+void PlotWidgetBase::setAxisScaleIfChanged(int axisId, double min, double max)
+{
+  const QwtScaleDiv& scale_div = qwtPlot()->axisScaleDiv(axisId);
+  if (scale_div.lowerBound() != min || scale_div.upperBound() != max)
+  {
+    qwtPlot()->setAxisScale(axisId, min, max);
+  }
+}
+
 Range PlotWidgetBase::getVisualizationRangeX() const
 {
   double left = std::numeric_limits<double>::max();
@@ -386,7 +731,9 @@ PlotWidgetBase::~PlotWidgetBase()
 PlotWidgetBase::CurveInfo* PlotWidgetBase::addCurve(const std::string& name, PlotDataXY& data,
                                                     QColor color)
 {
-  const auto qname = QString::fromStdString(name);
+  // series names are interned by PlotDataBase: reuse the cached QString
+  // instead of re-encoding the name for every curve
+  const QString& qname = StringInterner::instance().qstring(name);
 
   // title is the same of src_name, unless a transform was applied
   auto curve_it = curveFromTitle(qname);
@@ -395,7 +742,9 @@ PlotWidgetBase::CurveInfo* PlotWidgetBase::addCurve(const std::string& name, Plo
     return nullptr;  // TODO FIXME
   }
 
-  auto curve = new QwtPlotCurve(qname);
+  // batches the curve on the GPU when the OpenGL canvas is active,
+  // behaves exactly like a QwtPlotCurve otherwise
+  auto curve = new PlotCurveGL(qname);
   try
   {
     QwtSeriesWrapper* plot_qwt = nullptr;
@@ -460,11 +809,13 @@ void PlotWidgetBase::removeCurve(const QString& title)
 
   if (it != p->curve_list.end())
   {
+    p->dropEnvelope(it->curve);
     it->curve->detach();
     delete it->curve;
     it->marker->detach();
     delete it->marker;
     p->curve_list.erase(it);
+    p->last_frame.valid = false;
 
     emit curveListChanged();
   }
@@ -734,18 +1085,21 @@ void PlotWidgetBase::updateCurvesStyle()
   {
     setStyle(it.curve, style);
   }
+  // the new style applies to the whole curve, not just the exposed strip
+  p->last_frame.valid = false;
   replot();
 }
 
 PlotWidgetBase::CurveInfo* PlotWidgetBase::curveFromTitle(const QString& title)
 {
+  const std::string title_std = title.toStdString();
   for (auto& info : p->curve_list)
   {
     if (info.curve->title() == title)
     {
       return &info;
     }
-    if (info.src_name == title.toStdString())
+    if (info.src_name == title_std)
     {
       return &info;
     }
@@ -808,17 +1162,47 @@ std::optional<PlotWidgetBase::CurveStyle> PlotWidgetBase::overriddenCurvesStyle(
 
 void PlotWidgetBase::replot()
 {
+  PerfScope perf("PlotWidgetBase::replot");
   if (p->zoomer)
   {
     p->zoomer->setZoomBase(false);
   }
-  qwtPlot()->replot();
+  const auto xmap = qwtPlot()->canvasMap(QwtPlot::xBottom);
+  // canvas width scaled by the render governor: when the streaming frames
+  // exceed their time budget, the curves decimate below pixel resolution
+  // until the load subsides (see RenderGovernor)
+  const int column_budget = RenderGovernor::instance().scaleColumns(qwtPlot()->canvas()->width());
+
+  updateEnvelopes(column_budget);
+
+  // let oversampled series decimate themselves down to the column budget
+  // before QwtPlotCurve walks their samples
+  for (auto& it : p->curve_list)
+  {
+    // a curve handed over to its envelope band is not painted at all
+    if (it.curve->style() == QwtPlotCurve::NoCurve)
+    {
+      continue;
+    }
+    if (auto series = dynamic_cast<QwtSeriesWrapper*>(it.curve->data()))
+    {
+      series->setDisplayHint({ std::min(xmap.s1(), xmap.s2()), std::max(xmap.s1(), xmap.s2()) },
+                             column_budget);
+    }
+  }
+  if (!p->tryScrollBlit())
+  {
+    qwtPlot()->replot();
+    p->scroll_error = 0;
+  }
+  p->rememberFrame();
 }
 
 void PlotWidgetBase::removeAllCurves()
 {
   for (auto& it : curveList())
   {
+    p->dropEnvelope(it.curve);
     it.curve->detach();
     delete it.curve;
     it.marker->detach();
@@ -826,6 +1210,7 @@ void PlotWidgetBase::removeAllCurves()
   }
 
   curveList().clear();
+  p->last_frame.valid = false;
   emit curveListChanged();
   replot();
 }
@@ -911,7 +1296,116 @@ void PlotWidgetBase::setLineWidth(LineWidth width)
   {
     it.curve->setPen(it.curve->pen().color(), width_value);
   }
+  p->last_frame.valid = false;
+  replot();
+}
+
+void PlotWidgetBase::setEnvelopeEnabled(bool enabled)
+{
+  if (p->envelope_enabled == enabled)
+  {
+    return;
+  }
+  p->envelope_enabled = enabled;
+  if (!enabled)
+  {
+    for (auto& [curve, items] : p->envelope_items)
+    {
+      items.band->detach();
+      delete items.band;
+      items.mean->detach();
+      delete items.mean;
+      setStyle(curve, curveStyle());
+    }
+    p->envelope_items.clear();
+  }
+  p->last_frame.valid = false;
   replot();
 }
 
+bool PlotWidgetBase::isEnvelopeEnabled() const
+{
+  return p->envelope_enabled;
+}
+
+void PlotWidgetBase::updateEnvelopes(int num_pixel_columns)
+{
+  if (!p->envelope_enabled && p->envelope_items.empty())
+  {
+    return;
+  }
+  for (auto& info : p->curve_list)
+  {
+    auto* series = dynamic_cast<QwtTimeseries*>(info.curve->data());
+    bool active = false;
+
+    if (p->envelope_enabled && series && info.curve->isVisible() && !isXYPlot())
+    {
+      auto& items = p->envelope_items[info.curve];
+      if (!items.band)
+      {
+        items.band = new QwtPlotIntervalCurve;
+        items.band->setStyle(QwtPlotIntervalCurve::Tube);
+        items.band->setPen(Qt::NoPen);
+        items.band->setItemAttribute(QwtPlotItem::Legend, false);
+        items.band->setRenderHint(QwtPlotItem::RenderAntialiased, true);
+        items.band->setZ(info.curve->z() - 1);
+        items.band->attach(qwtPlot());
+
+        items.mean = new QwtPlotCurve;
+        items.mean->setItemAttribute(QwtPlotItem::Legend, false);
+        items.mean->setRenderHint(QwtPlotItem::RenderAntialiased, true);
+        items.mean->setZ(info.curve->z());
+        items.mean->attach(qwtPlot());
+      }
+
+      // the curve may sit on a hidden axis shifted by the time offset:
+      // its own scale map is in the time frame of the samples
+      const QwtScaleMap xmap = qwtPlot()->canvasMap(info.curve->xAxis());
+      const Range range_x = { std::min(xmap.s1(), xmap.s2()), std::max(xmap.s1(), xmap.s2()) };
+
+      active = items.envelope.rebuild(*series->timeseriesData(), range_x, num_pixel_columns);
+      if (active)
+      {
+        items.band->setSamples(new QwtIntervalSeriesData(items.envelope.band()));
+        items.mean->setSamples(items.envelope.meanLine());
+        items.band->setAxes(info.curve->xAxis(), info.curve->yAxis());
+        items.mean->setAxes(info.curve->xAxis(), info.curve->yAxis());
+
+        const QColor color = info.curve->pen().color();
+        QColor fill = color;
+        fill.setAlpha(60);
+        items.band->setBrush(fill);
+        items.mean->setPen(color, info.curve->pen().widthF());
+      }
+    }
+
+    auto it = p->envelope_items.find(info.curve);
+    if (it != p->envelope_items.end())
+    {
+      it->second.band->setVisible(active);
+      it->second.mean->setVisible(active);
+    }
+    // hand painting over to the band while it is active, and restore the
+    // configured style as soon as the view zooms in enough
+    if (active)
+    {
+      info.curve->setStyle(QwtPlotCurve::NoCurve);
+    }
+    else if (info.curve->style() == QwtPlotCurve::NoCurve)
+    {
+      setStyle(info.curve, curveStyle());
+    }
+  }
+}
+
+void PlotWidgetBase::setScrollBlitEnabled(bool enabled)
+{
+  p->scroll_blit_enabled = enabled;
+  if (!enabled)
+  {
+    p->last_frame.valid = false;
+  }
+}
+
 }  // namespace PJ
@@ -7,6 +7,7 @@
 #include "plotzoomer.h"
 #include <QMouseEvent>
 #include <QApplication>
+#include <QPainter>
 #include <QSettings>
 #include <QPen>
 
@@ -15,6 +16,47 @@
 #include "qwt_plot.h"
 #include "PlotJuggler/svg_util.h"
 
+class PlotZoomer::RubberBandOverlay : public QWidget
+{
+public:
+  RubberBandOverlay(QWidget* canvas, const QPen& pen)
+    : QWidget(canvas), _background(canvas->grab()), _pen(pen)
+  {
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setAttribute(Qt::WA_NoSystemBackground);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setGeometry(canvas->rect());
+    show();
+  }
+
+  void setSelection(const QRect& rect)
+  {
+    if (_selection != rect)
+    {
+      _selection = rect;
+      update();
+    }
+  }
+
+protected:
+  void paintEvent(QPaintEvent*) override
+  {
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, _background);
+    if (!_selection.isNull())
+    {
+      painter.setPen(_pen);
+      painter.setBrush(Qt::NoBrush);
+      painter.drawRect(_selection);
+    }
+  }
+
+private:
+  QPixmap _background;
+  QPen _pen;
+  QRect _selection;
+};
+
 PlotZoomer::PlotZoomer(QWidget* canvas)
   : QwtPlotZoomer(canvas, false)
   , _mouse_pressed(false)
@@ -61,18 +103,25 @@ void PlotZoomer::widgetMouseMoveEvent(QMouseEvent* me)
           QCursor zoom_cursor(pixmap.scaled(24, 24));
 
           _zoom_enabled = true;
-          this->setRubberBand(RectRubberBand);
+          // the rubber band is drawn on our overlay, not by QwtPicker
+          this->setRubberBand(NoRubberBand);
           this->setTrackerMode(AlwaysOff);
-          QPen pen(parentWidget()->palette().foreground().color(), 1, Qt::DashLine);
-          this->setRubberBandPen(pen);
           QApplication::setOverrideCursor(zoom_cursor);
+
+          delete _overlay;
+          QPen pen(parentWidget()->palette().foreground().color(), 1, Qt::DashLine);
+          _overlay = new RubberBandOverlay(canvas(), pen);
         }
+        _overlay->setSelection(rect.normalized());
       }
       else if (_zoom_enabled)
       {
         _zoom_enabled = false;
-        this->setRubberBand(NoRubberBand);
         QApplication::restoreOverrideCursor();
+        if (_overlay)
+        {
+          _overlay->setSelection(QRect());
+        }
       }
       break;
     }
@@ -88,6 +137,10 @@ void PlotZoomer::widgetMouseReleaseEvent(QMouseEvent* me)
     QApplication::restoreOverrideCursor();
     _zoom_enabled = false;
   }
+  // remove the overlay first: the zoom triggered below must repaint the
+  // canvas itself, at the final scale
+  delete _overlay;
+  _overlay = nullptr;
   QwtPlotPicker::widgetMouseReleaseEvent(me);
   this->setTrackerMode(AlwaysOff);
 }
@@ -41,6 +41,16 @@ private:
   bool _zoom_enabled;
   bool _keep_aspect_ratio;
   QPoint _initial_pos;
+
+  /**
+   * Opaque widget covering the canvas while the zoom rectangle is dragged:
+   * it shows an image of the canvas grabbed when the drag started and draws
+   * the rubber band on top. Animating the rectangle only repaints this
+   * cached image, never the canvas below - which, with the OpenGL canvas,
+   * would re-render every curve on each mouse move.
+   */
+  class RubberBandOverlay;
+  RubberBandOverlay* _overlay = nullptr;
 };
 
 #endif  // PLOTZOOMER_H
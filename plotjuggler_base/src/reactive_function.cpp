@@ -6,11 +6,47 @@
 
 #include "PlotJuggler/reactive_function.h"
 #include <sol/sol.hpp>
+#include "PlotJuggler/util/lua_sandbox.hpp"
 #include <fmt/format.h>
-#include <QMessageBox>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <limits>
 
 namespace PJ
 {
+namespace
+{
+// Append to "dst" the samples of "src" that it is still missing; start from
+// scratch when "src" was trimmed or rewritten instead.
+template <typename Series>
+void MirrorSeries(const Series& src, Series& dst)
+{
+  size_t index = dst.size();
+  if (index > src.size() || (index > 0 && (dst.at(index - 1).x != src.at(index - 1).x ||
+                                           dst.at(index - 1).y != src.at(index - 1).y)))
+  {
+    dst.clear();
+    index = 0;
+  }
+  for (; index < src.size(); index++)
+  {
+    dst.pushBack(src.at(index));
+  }
+}
+
+// Created series are usually cleared and rebuilt on every execution:
+// don't bother detecting appends, just replace the destination.
+template <typename Series>
+void CopySeries(const Series& src, Series& dst)
+{
+  dst.clear();
+  for (size_t index = 0; index < src.size(); index++)
+  {
+    dst.pushBack(src.at(index));
+  }
+}
+}  // namespace
 void ReactiveLuaFunction::init()
 {
   _lua_function = {};
@@ -20,6 +56,7 @@ void ReactiveLuaFunction::init()
   _lua_engine.open_libraries(sol::lib::string);
   _lua_engine.open_libraries(sol::lib::math);
   _lua_engine.open_libraries(sol::lib::table);
+  SanitizeLuaEngine(_lua_engine);
 
   _lua_engine.script(_library_code);
 
@@ -47,6 +84,9 @@ void ReactiveLuaFunction::init()
     throw std::runtime_error(std::string("Error in Function part:\n") + err.what());
   }
   _lua_function = _lua_engine["calc"];
+
+  // series created by the global part must be visible right away
+  publishOutputs();
 }
 
 ReactiveLuaFunction::ReactiveLuaFunction(PlotDataMapRef* data_map, QString lua_global,
@@ -55,7 +95,9 @@ ReactiveLuaFunction::ReactiveLuaFunction(PlotDataMapRef* data_map, QString lua_g
   , _function_code(lua_function.toStdString())
   , _library_code(lua_library.toStdString())
 {
-  _data = data_map;
+  _main_data = data_map;
+  _data = &_local_data;
+  _owner_thread = QThread::currentThread();
   init();
 }
 
@@ -70,6 +112,8 @@ void ReactiveLuaFunction::setTimeTracker(double time_tracker_value)
 
 void ReactiveLuaFunction::calculate()
 {
+  _last_error.clear();
+  auto start = std::chrono::steady_clock::now();
   try
   {
     auto result = _lua_function(_tracker_value);
@@ -81,8 +125,55 @@ void ReactiveLuaFunction::calculate()
   }
   catch (std::exception& err)
   {
-    QMessageBox::warning(nullptr, "Error in Reactive Script", QString(err.what()),
-                         QMessageBox::Cancel);
+    _last_error = err.what();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  _last_execution_ms = std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+void ReactiveLuaFunction::snapshotInputs()
+{
+  _series_names.clear();
+  for (const auto& it : _main_data->numeric)
+  {
+    _series_names.push_back(it.first);
+  }
+
+  for (const auto& name : _accessed_inputs)
+  {
+    mirrorInput(name);
+  }
+}
+
+void ReactiveLuaFunction::mirrorInput(const std::string& name)
+{
+  // series created by this script are published, not mirrored
+  if (std::find(_created_curves.begin(), _created_curves.end(), name) != _created_curves.end())
+  {
+    return;
+  }
+  auto it = _main_data->numeric.find(name);
+  if (it != _main_data->numeric.end())
+  {
+    MirrorSeries(it->second, _local_data.getOrCreateNumeric(name));
+  }
+}
+
+void ReactiveLuaFunction::publishOutputs()
+{
+  for (const auto& name : _created_curves)
+  {
+    auto num_it = _local_data.numeric.find(name);
+    if (num_it != _local_data.numeric.end())
+    {
+      CopySeries(num_it->second, _main_data->getOrCreateNumeric(name));
+      continue;
+    }
+    auto xy_it = _local_data.scatter_xy.find(name);
+    if (xy_it != _local_data.scatter_xy.end())
+    {
+      CopySeries(xy_it->second, _main_data->getOrCreateScatterXY(name));
+    }
   }
 }
 
@@ -102,7 +193,15 @@ void ReactiveLuaFunction::prepareLua()
 
   _timeseries_ref["find"] = [this](sol::object name) {
     auto str = name.as<std::string>();
+    _accessed_inputs.insert(str);
     auto it = plotData()->numeric.find(str);
+    if (it == plotData()->numeric.end() && QThread::currentThread() == _owner_thread)
+    {
+      // on the main thread the series can be mirrored right away; on a
+      // worker the name was recorded and will be there at the next snapshot
+      mirrorInput(str);
+      it = plotData()->numeric.find(str);
+    }
     if (it == plotData()->numeric.end())
     {
       return sol::make_object(_lua_engine, sol::lua_nil);
@@ -116,6 +215,59 @@ void ReactiveLuaFunction::prepareLua()
   _timeseries_ref["atTime"] = &TimeseriesRef::atTime;
   _timeseries_ref["clear"] = &TimeseriesRef::clear;
 
+  // Bulk accessors: a script that aggregates a long series with at() pays
+  // one Lua/C++ boundary crossing per sample; these cross it once per call.
+
+  // ts:slice(t0, t1) -> timestamps, values
+  // Two plain arrays with the samples in [t0, t1]; both bounds optional
+  // (whole series by default)
+  _timeseries_ref["slice"] = [this](const TimeseriesRef& self, sol::optional<double> from,
+                                    sol::optional<double> to) {
+    const auto range = self.rangeIndices(from.value_or(std::numeric_limits<double>::lowest()),
+                                         to.value_or(std::numeric_limits<double>::max()));
+    const int count = int(range.second - range.first);
+    sol::table times = _lua_engine.create_table(count, 0);
+    sol::table values = _lua_engine.create_table(count, 0);
+    int out = 1;
+    for (size_t i = range.first; i < range.second; i++, out++)
+    {
+      const auto& point = self._plot_data->at(i);
+      times.raw_set(out, point.x);
+      values.raw_set(out, point.y);
+    }
+    return std::make_tuple(times, values);
+  };
+
+  // ts:reduce(t0, t1) -> { count, min, max, sum, mean }
+  // Single C++ pass over the samples in [t0, t1] (both bounds optional);
+  // only "count" is set when the range is empty
+  _timeseries_ref["reduce"] = [this](const TimeseriesRef& self, sol::optional<double> from,
+                                     sol::optional<double> to) {
+    const auto range = self.rangeIndices(from.value_or(std::numeric_limits<double>::lowest()),
+                                         to.value_or(std::numeric_limits<double>::max()));
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    double sum = 0;
+    for (size_t i = range.first; i < range.second; i++)
+    {
+      const double y = self._plot_data->at(i).y;
+      min = std::min(min, y);
+      max = std::max(max, y);
+      sum += y;
+    }
+    const size_t count = range.second - range.first;
+    sol::table stats = _lua_engine.create_table(0, 5);
+    stats["count"] = count;
+    if (count > 0)
+    {
+      stats["min"] = min;
+      stats["max"] = max;
+      stats["sum"] = sum;
+      stats["mean"] = sum / double(count);
+    }
+    return stats;
+  };
+
   //---------------------------------------
   _created_timeseries = _lua_engine.new_usertype<CreatedSeriesTime>("Timeseries");
 
@@ -127,7 +279,11 @@ void ReactiveLuaFunction::prepareLua()
     auto str_name = name.as<std::string>();
     auto series = CreatedSeriesTime(plotData(), str_name);
     series.clear();
-    _created_curves.push_back(str_name);
+    if (std::find(_created_curves.begin(), _created_curves.end(), str_name) ==
+        _created_curves.end())
+    {
+      _created_curves.push_back(str_name);
+    }
     return sol::object(_lua_engine, sol::in_place, series);
   };
 
@@ -147,7 +303,11 @@ void ReactiveLuaFunction::prepareLua()
     auto str_name = name.as<std::string>();
     auto series = CreatedSeriesXY(plotData(), str_name);
     series.clear();
-    _created_curves.push_back(str_name);
+    if (std::find(_created_curves.begin(), _created_curves.end(), str_name) ==
+        _created_curves.end())
+    {
+      _created_curves.push_back(str_name);
+    }
     return sol::object(_lua_engine, sol::in_place, series);
   };
 
@@ -158,12 +318,16 @@ void ReactiveLuaFunction::prepareLua()
 
   //---------------------------------------
   auto GetSeriesNames = [this]() {
-    std::vector<std::string> names;
-    for (const auto& it : plotData()->numeric)
+    if (QThread::currentThread() == _owner_thread)
     {
-      names.push_back(it.first);
+      _series_names.clear();
+      for (const auto& it : _main_data->numeric)
+      {
+        _series_names.push_back(it.first);
+      }
     }
-    return names;
+    // on a worker thread, return the names captured by the last snapshot
+    return _series_names;
   };
   _lua_engine.set_function("GetSeriesNames", GetSeriesNames);
 }
@@ -195,6 +359,34 @@ unsigned TimeseriesRef::size() const
   return _plot_data->size();
 }
 
+std::pair<size_t, size_t> TimeseriesRef::rangeIndices(double t0, double t1) const
+{
+  // samples are sorted by x: binary search both boundaries
+  auto first_at_or_after = [this](double t) {
+    size_t low = 0;
+    size_t high = _plot_data->size();
+    while (low < high)
+    {
+      const size_t mid = low + (high - low) / 2;
+      (_plot_data->at(mid).x >= t) ? high = mid : low = mid + 1;
+    }
+    return low;
+  };
+  auto first_after = [this](double t) {
+    size_t low = 0;
+    size_t high = _plot_data->size();
+    while (low < high)
+    {
+      const size_t mid = low + (high - low) / 2;
+      (_plot_data->at(mid).x > t) ? high = mid : low = mid + 1;
+    }
+    return low;
+  };
+  const size_t first = first_at_or_after(t0);
+  const size_t last = first_after(t1);
+  return { first, std::max(first, last) };
+}
+
 void TimeseriesRef::clear() const
 {
   _plot_data->clear();
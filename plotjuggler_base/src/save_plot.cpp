@@ -7,6 +7,7 @@
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QFont>
+#include <QImage>
 #include <QPaintDevice>
 #include <QPainter>
 #include <QRect>
@@ -14,6 +15,7 @@
 #include <QString>
 #include <QSvgGenerator>
 #include <QTextOption>
+#include <QtConcurrent/QtConcurrent>
 
 #include <memory>
 
@@ -23,7 +25,7 @@ auto toExtension(const QString& filter)
 }
 
 PlotSaveHelper::PlotSaveHelper(QSize dims, QWidget* parent)
-  : _renderer{ std::make_unique<QwtPlotRenderer>(parent) }
+  : _renderer{ std::make_unique<QwtPlotRenderer>(parent) }, _dims{ dims }
 {
   QFileDialog save_dialog(parent);
   save_dialog.setAcceptMode(QFileDialog::AcceptSave);
@@ -47,6 +49,8 @@ PlotSaveHelper::PlotSaveHelper(QSize dims, QWidget* parent)
   }
   auto is_svg = _save_filename.endsWith(".svg");
 
+  _background = parent->palette().window().color();
+
   const auto rect = QRect(0, 0, dims.width(), dims.height());
   if (is_svg)
   {
@@ -56,26 +60,60 @@ PlotSaveHelper::PlotSaveHelper(QSize dims, QWidget* parent)
     generator->setViewBox(rect);
 
     _paint_device = std::unique_ptr<QPaintDevice>(generator);
+    _painter = std::make_unique<QPainter>(_paint_device.get());
+    _painter->fillRect(rect, _background);
   }
   else
   {
-    auto* pixmap = new QPixmap(dims.width(), dims.height());
-    _paint_device = std::unique_ptr<QPaintDevice>(pixmap);
+    // raster output: paint() records into per-plot QPictures and the
+    // rasterization + encoding happen asynchronously in the destructor
+    _raster = true;
   }
-  _painter = std::make_unique<QPainter>(_paint_device.get());
-
-  _painter->fillRect(rect, parent->palette().window());
 }
 
 PlotSaveHelper::~PlotSaveHelper()
 {
-  if (const auto* pixmap = dynamic_cast<QPixmap*>(_paint_device.get()); pixmap)
+  if (!_raster || _save_filename.isEmpty())
+  {
+    return;
+  }
+
+  if (_overlay_painter)
   {
-    pixmap->save(_save_filename);
+    _overlay_painter->end();
+    _overlay_painter.reset();
   }
+
+  // Rasterizing a dense plot at export resolution and encoding the image can
+  // take seconds; do it on the QtConcurrent pool, one parallel job per plot.
+  // QPicture and QImage are safe to paint outside the GUI thread.
+  QtConcurrent::run([recorded = std::move(_recorded_plots), overlay = _overlay_picture,
+                     dims = _dims, background = _background, filename = _save_filename]() {
+    auto renderTile = [](const RecordedPlot& plot) {
+      QImage tile(plot.rect.size(), QImage::Format_ARGB32_Premultiplied);
+      tile.fill(Qt::transparent);
+      QPainter tile_painter(&tile);
+      tile_painter.drawPicture(0, 0, plot.picture);
+      return tile;
+    };
+    const auto tiles = QtConcurrent::blockingMapped<std::vector<QImage>>(recorded, renderTile);
+
+    QImage image(dims, QImage::Format_ARGB32_Premultiplied);
+    image.fill(background);
+
+    QPainter painter(&image);
+    for (size_t i = 0; i < recorded.size(); i++)
+    {
+      painter.drawImage(recorded[i].rect.topLeft(), tiles[i]);
+    }
+    painter.drawPicture(0, 0, overlay);
+    painter.end();
+
+    image.save(filename);
+  });
 }
 
-void PlotSaveHelper::paint(QwtPlot* plot, QRect paint_at) const
+void PlotSaveHelper::paint(QwtPlot* plot, QRect paint_at)
 {
   static const auto margin = 5;
   if (_save_filename.isEmpty())
@@ -84,24 +122,48 @@ void PlotSaveHelper::paint(QwtPlot* plot, QRect paint_at) const
   }
 
   paint_at.adjust(margin, margin, -margin, -margin);
-  _renderer->render(plot, _painter.get(), paint_at);
+
+  if (_raster)
+  {
+    // record the paint commands only (cheap, resolution independent); the
+    // pixels are produced later by the worker
+    RecordedPlot recorded;
+    recorded.rect = paint_at;
+    QPainter recorder(&recorded.picture);
+    _renderer->render(plot, &recorder, QRect(QPoint(0, 0), paint_at.size()));
+    recorder.end();
+    _recorded_plots.push_back(std::move(recorded));
+  }
+  else
+  {
+    _renderer->render(plot, _painter.get(), paint_at);
+  }
 }
 
-void PlotSaveHelper::paintTitle(const QString& title, QRectF paint_at, QWidget* parent) const
+void PlotSaveHelper::paintTitle(const QString& title, QRectF paint_at, QWidget* parent)
 {
   if (_save_filename.isEmpty())
   {
     return;
   }
 
-  QFont font;
-  _painter->setFont(parent->font());
-  _painter->setPen(parent->palette().windowText().color());
+  QPainter* painter = _painter.get();
+  if (_raster)
+  {
+    if (!_overlay_painter)
+    {
+      _overlay_painter = std::make_unique<QPainter>(&_overlay_picture);
+    }
+    painter = _overlay_painter.get();
+  }
+
+  painter->setFont(parent->font());
+  painter->setPen(parent->palette().windowText().color());
 
   QTextOption text_options;
   text_options.setAlignment(Qt::AlignCenter);
 
-  _painter->drawText(paint_at, title, text_options);
+  painter->drawText(paint_at, title, text_options);
 }
 
 void savePlotToFile(QSize dims, QwtPlot* plot, QWidget* parent)
@@ -0,0 +1,352 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "PlotJuggler/session_dump.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include <QFile>
+
+namespace PJ
+{
+/* File layout (native byte order):
+ *
+ *   [8]  magic "PJDUMP", version byte, zero byte
+ *   [u64] numeric series count
+ *   [u64] string series count
+ *   directory: one variable-length entry per series
+ *     numeric: [u32 name_len][name][u32 group_len][group]
+ *              [u64 count][u64 x_offset][u64 y_offset]
+ *     string:  [u32 name_len][name][u32 group_len][group]
+ *              [u64 count][u64 dict_offset][u64 dict_size]
+ *              [u64 x_offset][u64 index_offset]
+ *   data: the arrays pointed to by the directory, each offset 8-aligned.
+ *         A dictionary is [u32 count] then count * ([u32 len][bytes]).
+ */
+
+static const char kMagic[8] = { 'P', 'J', 'D', 'U', 'M', 'P', 1, 0 };
+
+static uint64_t Align8(uint64_t offset)
+{
+  return (offset + 7) & ~uint64_t(7);
+}
+
+namespace
+{
+// append-only byte buffer used to assemble the directory
+struct ByteWriter
+{
+  std::vector<char> bytes;
+
+  template <typename T>
+  void write(const T& value)
+  {
+    const char* ptr = reinterpret_cast<const char*>(&value);
+    bytes.insert(bytes.end(), ptr, ptr + sizeof(T));
+  }
+
+  void writeString(const std::string& str)
+  {
+    write(uint32_t(str.size()));
+    bytes.insert(bytes.end(), str.begin(), str.end());
+  }
+};
+
+// cursor over the mapped file, with bounds checking
+struct ByteReader
+{
+  const uchar* base;
+  uint64_t size;
+  uint64_t pos = 0;
+  bool valid = true;
+
+  template <typename T>
+  T read()
+  {
+    T value{};
+    if (pos + sizeof(T) > size)
+    {
+      valid = false;
+      return value;
+    }
+    std::memcpy(&value, base + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+  }
+
+  std::string readString()
+  {
+    const uint32_t len = read<uint32_t>();
+    if (!valid || pos + len > size)
+    {
+      valid = false;
+      return {};
+    }
+    std::string str(reinterpret_cast<const char*>(base + pos), len);
+    pos += len;
+    return str;
+  }
+
+  const uchar* at(uint64_t offset, uint64_t bytes_needed)
+  {
+    if (offset + bytes_needed > size || offset + bytes_needed < offset)
+    {
+      valid = false;
+      return nullptr;
+    }
+    return base + offset;
+  }
+};
+
+std::string GroupName(const PlotGroup::Ptr& group)
+{
+  return group ? group->name() : std::string();
+}
+}  // namespace
+
+bool SaveSessionDump(const PlotDataMapRef& data, const QString& filepath)
+{
+  // string series are rebuilt in memory first (dictionary + columns):
+  // they are small compared to the numeric ones
+  struct StringColumns
+  {
+    std::vector<char> dict;
+    std::vector<double> xs;
+    std::vector<uint32_t> indices;
+  };
+  std::vector<StringColumns> string_columns;
+  string_columns.reserve(data.strings.size());
+
+  for (const auto& [name, series] : data.strings)
+  {
+    StringColumns columns;
+    columns.xs.reserve(series.size());
+    columns.indices.reserve(series.size());
+
+    ByteWriter dict;
+    std::unordered_map<std::string, uint32_t> seen;
+    for (size_t i = 0; i < series.size(); i++)
+    {
+      const auto point = series[i];
+      const auto str_view = series.getString(point.y);
+      std::string str(str_view.data(), str_view.size());
+      auto it = seen.find(str);
+      if (it == seen.end())
+      {
+        it = seen.emplace(std::move(str), uint32_t(seen.size())).first;
+        dict.writeString(it->first);
+      }
+      columns.xs.push_back(point.x);
+      columns.indices.push_back(it->second);
+    }
+    // prepend the entry count to the dictionary blob
+    ByteWriter blob;
+    blob.write(uint32_t(seen.size()));
+    blob.bytes.insert(blob.bytes.end(), dict.bytes.begin(), dict.bytes.end());
+    columns.dict = std::move(blob.bytes);
+    string_columns.push_back(std::move(columns));
+  }
+
+  // first pass: directory with the data offsets precomputed
+  ByteWriter directory;
+  const uint64_t header_size = sizeof(kMagic) + 2 * sizeof(uint64_t);
+  uint64_t directory_size = 0;
+  for (const auto& [name, series] : data.numeric)
+  {
+    directory_size += 4 + name.size() + 4 + GroupName(series.group()).size() + 3 * 8;
+  }
+  for (const auto& [name, series] : data.strings)
+  {
+    directory_size += 4 + name.size() + 4 + GroupName(series.group()).size() + 5 * 8;
+  }
+
+  uint64_t data_offset = Align8(header_size + directory_size);
+
+  for (const auto& [name, series] : data.numeric)
+  {
+    directory.writeString(name);
+    directory.writeString(GroupName(series.group()));
+    directory.write(uint64_t(series.size()));
+    directory.write(data_offset);  // x
+    data_offset = Align8(data_offset + series.size() * sizeof(double));
+    directory.write(data_offset);  // y
+    data_offset = Align8(data_offset + series.size() * sizeof(double));
+  }
+  {
+    size_t index = 0;
+    for (const auto& [name, series] : data.strings)
+    {
+      const auto& columns = string_columns[index++];
+      directory.writeString(name);
+      directory.writeString(GroupName(series.group()));
+      directory.write(uint64_t(columns.xs.size()));
+      directory.write(data_offset);  // dictionary
+      directory.write(uint64_t(columns.dict.size()));
+      data_offset = Align8(data_offset + columns.dict.size());
+      directory.write(data_offset);  // x
+      data_offset = Align8(data_offset + columns.xs.size() * sizeof(double));
+      directory.write(data_offset);  // indices
+      data_offset = Align8(data_offset + columns.indices.size() * sizeof(uint32_t));
+    }
+  }
+
+  QFile file(filepath);
+  if (!file.open(QIODevice::WriteOnly))
+  {
+    return false;
+  }
+
+  uint64_t written = 0;
+  auto writeBlock = [&](const void* ptr, uint64_t size) {
+    file.write(reinterpret_cast<const char*>(ptr), qint64(size));
+    written += size;
+  };
+  auto padTo = [&](uint64_t offset) {
+    static const char zeros[8] = { 0 };
+    writeBlock(zeros, offset - written);
+  };
+
+  writeBlock(kMagic, sizeof(kMagic));
+  const uint64_t numeric_count = data.numeric.size();
+  const uint64_t string_count = data.strings.size();
+  writeBlock(&numeric_count, 8);
+  writeBlock(&string_count, 8);
+  writeBlock(directory.bytes.data(), directory.bytes.size());
+  padTo(Align8(written));
+
+  // second pass: the arrays themselves. The deque storage is not
+  // contiguous, so each column goes through a flat staging vector.
+  std::vector<double> stage;
+  for (const auto& [name, series] : data.numeric)
+  {
+    stage.clear();
+    stage.reserve(series.size());
+    for (size_t i = 0; i < series.size(); i++)
+    {
+      stage.push_back(series[i].x);
+    }
+    writeBlock(stage.data(), stage.size() * sizeof(double));
+    padTo(Align8(written));
+
+    stage.clear();
+    for (size_t i = 0; i < series.size(); i++)
+    {
+      stage.push_back(series[i].y);
+    }
+    writeBlock(stage.data(), stage.size() * sizeof(double));
+    padTo(Align8(written));
+  }
+  for (const auto& columns : string_columns)
+  {
+    writeBlock(columns.dict.data(), columns.dict.size());
+    padTo(Align8(written));
+    writeBlock(columns.xs.data(), columns.xs.size() * sizeof(double));
+    padTo(Align8(written));
+    writeBlock(columns.indices.data(), columns.indices.size() * sizeof(uint32_t));
+    padTo(Align8(written));
+  }
+
+  file.close();
+  return file.error() == QFile::NoError;
+}
+
+bool LoadSessionDump(const QString& filepath, PlotDataMapRef& destination)
+{
+  QFile file(filepath);
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+  const uchar* base = file.map(0, file.size());
+  if (base == nullptr)
+  {
+    return false;
+  }
+
+  ByteReader reader{ base, uint64_t(file.size()) };
+  const uchar* magic = reader.at(0, 8);
+  if (magic == nullptr || std::memcmp(magic, kMagic, 8) != 0)
+  {
+    return false;
+  }
+  reader.pos = 8;
+  const uint64_t numeric_count = reader.read<uint64_t>();
+  const uint64_t string_count = reader.read<uint64_t>();
+
+  auto groupOf = [&](const std::string& group_name) -> PlotGroup::Ptr {
+    return group_name.empty() ? PlotGroup::Ptr{} : destination.getOrCreateGroup(group_name);
+  };
+
+  for (uint64_t s = 0; s < numeric_count && reader.valid; s++)
+  {
+    const std::string name = reader.readString();
+    const std::string group_name = reader.readString();
+    const uint64_t count = reader.read<uint64_t>();
+    const uint64_t x_offset = reader.read<uint64_t>();
+    const uint64_t y_offset = reader.read<uint64_t>();
+
+    const auto* xs = reinterpret_cast<const double*>(reader.at(x_offset, count * 8));
+    const auto* ys = reinterpret_cast<const double*>(reader.at(y_offset, count * 8));
+    if (!reader.valid)
+    {
+      return false;
+    }
+    auto& series = destination.getOrCreateNumeric(name, groupOf(group_name));
+    series.appendBatch(xs, ys, count);
+  }
+
+  for (uint64_t s = 0; s < string_count && reader.valid; s++)
+  {
+    const std::string name = reader.readString();
+    const std::string group_name = reader.readString();
+    const uint64_t count = reader.read<uint64_t>();
+    const uint64_t dict_offset = reader.read<uint64_t>();
+    const uint64_t dict_size = reader.read<uint64_t>();
+    const uint64_t x_offset = reader.read<uint64_t>();
+    const uint64_t index_offset = reader.read<uint64_t>();
+    if (!reader.valid)
+    {
+      return false;
+    }
+
+    // decode the dictionary with a nested cursor
+    ByteReader dict{ base, uint64_t(file.size()), dict_offset };
+    if (reader.at(dict_offset, dict_size) == nullptr)
+    {
+      return false;
+    }
+    const uint32_t dict_count = dict.read<uint32_t>();
+    std::vector<std::string> dictionary;
+    dictionary.reserve(dict_count);
+    for (uint32_t i = 0; i < dict_count && dict.valid; i++)
+    {
+      dictionary.push_back(dict.readString());
+    }
+
+    const auto* xs = reinterpret_cast<const double*>(reader.at(x_offset, count * 8));
+    const auto* indices = reinterpret_cast<const uint32_t*>(reader.at(index_offset, count * 4));
+    if (!reader.valid || !dict.valid)
+    {
+      return false;
+    }
+    auto& series = destination.getOrCreateStringSeries(name, groupOf(group_name));
+    for (uint64_t i = 0; i < count; i++)
+    {
+      if (indices[i] >= dictionary.size())
+      {
+        return false;
+      }
+      const auto& str = dictionary[indices[i]];
+      series.pushBack({ xs[i], StringRef(str.data(), str.size()) });
+    }
+  }
+
+  return reader.valid;
+}
+
+}  // namespace PJ
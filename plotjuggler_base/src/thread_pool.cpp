@@ -0,0 +1,122 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "PlotJuggler/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace PJ
+{
+
+ThreadPool& ThreadPool::instance()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+ThreadPool::ThreadPool()
+{
+  // leave one hardware thread of headroom for the GUI thread and the
+  // blocking receive threads of the streaming plugins.
+  // hardware_concurrency() may return 0 when it cannot be detected.
+  const size_t hw_threads = std::thread::hardware_concurrency();
+  const size_t num_threads = std::max<size_t>(2, hw_threads > 0 ? hw_threads - 1 : 2);
+
+  _workers.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; i++)
+  {
+    _workers.push_back(std::make_unique<Worker>());
+  }
+  _threads.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; i++)
+  {
+    _threads.emplace_back([this, i]() { workerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(_sleep_mutex);
+    _running = false;
+  }
+  _wakeup.notify_all();
+  for (auto& thread : _threads)
+  {
+    thread.join();
+  }
+}
+
+void ThreadPool::submit(Priority priority, std::function<void()> task)
+{
+  const size_t index = _round_robin.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+  auto& worker = *_workers[index];
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.queues[static_cast<int>(priority)].push_back(std::move(task));
+  }
+  _pending_count.fetch_add(1, std::memory_order_release);
+  _wakeup.notify_one();
+}
+
+bool ThreadPool::popTask(Worker& worker, bool steal, std::function<void()>& task)
+{
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  for (auto& queue : worker.queues)
+  {
+    if (queue.empty())
+    {
+      continue;
+    }
+    if (steal)
+    {
+      // oldest task first: the owner is working on the other end
+      task = std::move(queue.front());
+      queue.pop_front();
+    }
+    else
+    {
+      task = std::move(queue.back());
+      queue.pop_back();
+    }
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::workerLoop(size_t self_index)
+{
+  while (true)
+  {
+    std::function<void()> task;
+    bool found = popTask(*_workers[self_index], false, task);
+    for (size_t offset = 1; !found && offset < _workers.size(); offset++)
+    {
+      found = popTask(*_workers[(self_index + offset) % _workers.size()], true, task);
+    }
+
+    if (found)
+    {
+      _pending_count.fetch_sub(1, std::memory_order_release);
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(_sleep_mutex);
+    if (!_running && _pending_count.load(std::memory_order_acquire) == 0)
+    {
+      return;
+    }
+    // the timeout covers the race between the empty scan above and a
+    // submit() that fired its notification before we started waiting
+    _wakeup.wait_for(lock, std::chrono::milliseconds(100), [this]() {
+      return !_running || _pending_count.load(std::memory_order_acquire) > 0;
+    });
+  }
+}
+
+}  // namespace PJ
@@ -5,6 +5,7 @@
  */
 
 #include "timeseries_qwt.h"
+#include "PlotJuggler/util/perf_monitor.hpp"
 #include <limits>
 #include <stdexcept>
 #include <QMessageBox>
@@ -13,22 +14,11 @@
 
 RangeOpt QwtSeriesWrapper::getVisualizationRangeY(Range range_x)
 {
-  if (range_x.min <= std::numeric_limits<double>::lowest() &&
-      range_x.min <= std::numeric_limits<double>::max())
-  {
-    return _data->rangeY();
-  }
-
-  double min_y = (std::numeric_limits<double>::max());
-  double max_y = (std::numeric_limits<double>::lowest());
-
-  for (size_t i = 0; i < size(); i++)
-  {
-    const double Y = sample(i).y();
-    min_y = std::min(min_y, Y);
-    max_y = std::max(max_y, Y);
-  }
-  return Range{ min_y, max_y };
+  // XY points are not sorted along x, so the Y extremes of the whole series
+  // are the correct conservative answer for any sub-range. rangeY() is O(1):
+  // it is maintained incrementally while the series grows.
+  (void)range_x;
+  return _data->rangeY();
 }
 
 RangeOpt QwtTimeseries::getVisualizationRangeY(Range range_X)
@@ -46,12 +36,21 @@ RangeOpt QwtTimeseries::getVisualizationRangeY(Range range_X)
     return _ts_data->rangeY();
   }
 
+  // below this size a direct scan is cheaper than maintaining the index
+  constexpr int MIN_SAMPLES_FOR_INDEX = 4096;
+
+  if (last_index - first_index >= MIN_SAMPLES_FOR_INDEX)
+  {
+    _y_index.update(*_ts_data);
+    return _y_index.rangeY(*_ts_data, size_t(first_index), size_t(last_index));
+  }
+
   double min_y = (std::numeric_limits<double>::max());
   double max_y = (std::numeric_limits<double>::lowest());
 
-  for (size_t i = first_index; i < last_index; i++)
+  for (size_t i = first_index; i <= size_t(last_index); i++)
   {
-    const double Y = sample(i).y();
+    const double Y = _ts_data->at(i).y;
     min_y = std::min(min_y, Y);
     max_y = std::max(max_y, Y);
   }
@@ -70,13 +69,14 @@ std::optional<QPointF> QwtTimeseries::sampleFromTime(double t)
 }
 
 TransformedTimeseries::TransformedTimeseries(const PlotData* source_data)
-  : QwtTimeseries(&_dst_data), _dst_data(source_data->plotName(), {}), _src_data(source_data)
+  : QwtTimeseries(source_data), _dst_data(source_data->plotName(), {}), _src_data(source_data)
 {
+  // until a transform is set, this wrapper reads straight from the source
 }
 
 TransformFunction::Ptr TransformedTimeseries::transform()
 {
-  return _transform;
+  return _stages.empty() ? TransformFunction::Ptr() : _stages.front();
 }
 
 bool TransformedTimeseries::setTransform(QString transform_ID)
@@ -85,49 +85,173 @@ bool TransformedTimeseries::setTransform(QString transform_ID)
   {
     return true;
   }
+  _stages.clear();
+  _buffers.clear();
+  _plan_signature = 0;
+  _dst_data.clear();
+
   if (transform_ID.isEmpty())
   {
-    _transform.reset();
+    setTimeseriesSource(_src_data);
     return false;
   }
 
-  _transform = TransformFactory::create(transform_ID.toStdString());
-  if (!_transform)
+  for (const QString& id : transform_ID.split('|', PJ::SkipEmptyParts))
   {
-    return false;
+    auto stage = TransformFactory::create(id.trimmed().toStdString());
+    if (!stage)
+    {
+      _stages.clear();
+      setTimeseriesSource(_src_data);
+      return false;
+    }
+    _stages.push_back(stage);
   }
-  std::vector<PlotData*> dest = { &_dst_data };
-  _dst_data.clear();
-  _transform->setData(nullptr, { _src_data }, dest);
+
+  // default wiring: each stage reads the output buffer of the previous one.
+  // updateCache() re-wires the scratch buffers according to the fused plan.
+  for (size_t i = 0; i + 1 < _stages.size(); i++)
+  {
+    _buffers.emplace_back(_src_data->plotName(), PlotGroup::Ptr());
+  }
+  for (size_t i = 0; i < _stages.size(); i++)
+  {
+    const PlotData* input = (i == 0) ? _src_data : &_buffers[i - 1];
+    std::vector<PlotData*> dest = { (i + 1 == _stages.size()) ? &_dst_data : &_buffers[i] };
+    _stages[i]->setData(nullptr, { input }, dest);
+  }
+  setTimeseriesSource(&_dst_data);
   return true;
 }
 
+void TransformedTimeseries::resetPipeline()
+{
+  _dst_data.clear();
+  for (auto& buffer : _buffers)
+  {
+    buffer.clear();
+  }
+  for (auto& stage : _stages)
+  {
+    stage->reset();
+  }
+}
+
 void TransformedTimeseries::updateCache(bool reset_old_data)
 {
-  if (_transform)
+  PJ::PerfScope perf("TransformedTimeseries::updateCache");
+  if (_stages.empty())
+  {
+    // without a transform there is nothing to copy: the wrapper reads
+    // directly from the source series
+    return;
+  }
+  if (reset_old_data)
+  {
+    resetPipeline();
+  }
+
+  // the kernels capture the current option values, so they are refreshed
+  // at every pass (composing them is cheap, the loops below are not)
+  const size_t num_stages = _stages.size();
+  std::vector<TransformFunction_SISO::PointwiseFunc> kernels(num_stages);
+  uint64_t signature = 0;
+  for (size_t i = 0; i < num_stages; i++)
   {
-    if (reset_old_data)
+    if (auto siso = dynamic_cast<TransformFunction_SISO*>(_stages[i].get()))
+    {
+      kernels[i] = siso->pointwiseOperation();
+    }
+    if (kernels[i])
     {
-      _dst_data.clear();
-      _transform->reset();
+      signature |= uint64_t(1) << (i & 63);
     }
-    std::vector<PlotData*> dest = { &_dst_data };
-    _transform->calculate();
   }
-  else
+  // an option change can turn a pointwise stage into a stateful one (or
+  // back): the buffers no longer hold the right history, start over
+  if (signature != _plan_signature)
+  {
+    _plan_signature = signature;
+    resetPipeline();
+  }
+
+  const PlotData* input = _src_data;
+  PlotData* input_scratch = nullptr;  // when set, `input` is cleared after use
+
+  size_t i = 0;
+  while (i < num_stages)
   {
-    // TODO: optimize ??
-    _dst_data.clear();
-    for (size_t i = 0; i < _src_data->size(); i++)
+    if (kernels[i])
     {
-      _dst_data.pushBack(_src_data->at(i));
+      // maximal run [i, j) of pointwise stages: one loop, no intermediates
+      size_t j = i;
+      while (j < num_stages && kernels[j])
+      {
+        j++;
+      }
+      PlotData* out = (j == num_stages) ? &_dst_data : &_buffers[j - 1];
+      out->setMaximumRangeX(input->maximumRangeX());
+
+      size_t from = 0;
+      if (!input_scratch && out->size() != 0)
+      {
+        // persistent input (the source series): resume after the last
+        // timestamp already produced, robust to front-trimming
+        const double last_x = out->back().x;
+        const int pos = input->getIndexFromX(last_x);
+        from = pos < 0 ? 0 : static_cast<size_t>(pos);
+        while (from < input->size() && input->at(from).x <= last_x)
+        {
+          from++;
+        }
+      }
+      for (size_t index = from; index < input->size(); index++)
+      {
+        const auto& point = input->at(index);
+        double y = point.y;
+        for (size_t s = i; s < j; s++)
+        {
+          y = kernels[s](y);
+        }
+        out->pushBack({ point.x, y });
+      }
+      if (input_scratch)
+      {
+        input_scratch->clear();
+      }
+      input = out;
+      input_scratch = nullptr;
+      i = j;
+    }
+    else
+    {
+      PlotData* out = (i + 1 == num_stages) ? &_dst_data : &_buffers[i];
+      std::vector<PlotData*> dest = { out };
+      _stages[i]->setData(nullptr, { input }, dest);
+      // TransformFunction_SISO::calculate() resumes from the last computed
+      // timestamp, so the cost is proportional to the new samples only
+      _stages[i]->calculate();
+      input = out;
+      // when the next stage is pointwise, `out` only needs to hold the
+      // samples of this pass: the fused run consumes and clears it
+      input_scratch = (i + 1 < num_stages && kernels[i + 1]) ? out : nullptr;
+      i++;
     }
   }
 }
 
 QString TransformedTimeseries::transformName()
 {
-  return (!_transform) ? QString() : _transform->name();
+  QString joined;
+  for (const auto& stage : _stages)
+  {
+    if (!joined.isEmpty())
+    {
+      joined += '|';
+    }
+    joined += stage->name();
+  }
+  return joined;
 }
 
 QString TransformedTimeseries::alias() const
@@ -157,23 +281,6 @@ QRectF QwtSeriesWrapper::boundingRect() const
   return box;
 }
 
-QRectF QwtTimeseries::boundingRect() const
-{
-  if (size() == 0)
-  {
-    return {};
-  }
-  auto range_x = plotData()->rangeX().value();
-  auto range_y = plotData()->rangeY().value();
-
-  QRectF box;
-  box.setLeft(range_x.min - _time_offset);
-  box.setRight(range_x.max - _time_offset);
-  box.setTop(range_y.max);
-  box.setBottom(range_y.min);
-  return box;
-}
-
 QPointF QwtSeriesWrapper::sample(size_t i) const
 {
   const auto& p = _data->at(i);
@@ -182,8 +289,14 @@ QPointF QwtSeriesWrapper::sample(size_t i) const
 
 QPointF QwtTimeseries::sample(size_t i) const
 {
-  const auto& p = _ts_data->at(i);
-  return QPointF(p.x - _time_offset, p.y);
+  // absolute timestamps, untouched: the offset is applied by the plot on
+  // the axis the curve is attached to
+  if (_decimated_active)
+  {
+    return _decimated[i];
+  }
+  const auto& p = _ts_data->at(_window_count != 0 ? _window_first + i : i);
+  return QPointF(p.x, p.y);
 }
 
 size_t QwtSeriesWrapper::size() const
@@ -191,6 +304,223 @@ size_t QwtSeriesWrapper::size() const
   return _data->size();
 }
 
+size_t QwtTimeseries::size() const
+{
+  if (_decimated_active)
+  {
+    return _decimated.size();
+  }
+  return _window_count != 0 ? _window_count : _ts_data->size();
+}
+
+void QwtTimeseries::setRectOfInterest(const QRectF& rect)
+{
+  // fewer hidden samples than this are not worth the window churn, and
+  // consumers that cache incrementally (the GL upload, the scroll blit)
+  // keep seeing a stable, append-only series
+  constexpr size_t MIN_SAMPLES_TO_CLIP = 10000;
+
+  _window_count = 0;
+  // when the M4 view is active it already covers the visible range only
+  if (_decimated_active || !(rect.width() > 0) || _ts_data->size() < 2 * MIN_SAMPLES_TO_CLIP)
+  {
+    return;
+  }
+  // the rect is in the coordinates of the axes the curve is attached to:
+  // for a timeseries that is the (possibly hidden) axis in the absolute
+  // time frame of the samples, so no offset conversion is needed
+  const int first_index = _ts_data->getIndexFromX(rect.left());
+  const int last_index = _ts_data->getIndexFromX(rect.right());
+  if (first_index < 0 || last_index < first_index)
+  {
+    return;
+  }
+  // one sample beyond each edge, so the polyline still enters and
+  // leaves the canvas instead of stopping at the first visible point
+  const size_t window_first = (first_index > 0) ? size_t(first_index) - 1 : 0;
+  const size_t window_last = std::min(size_t(last_index) + 1, _ts_data->size() - 1);
+  const size_t span = window_last - window_first + 1;
+  if (_ts_data->size() - span < MIN_SAMPLES_TO_CLIP)
+  {
+    return;
+  }
+  _window_first = window_first;
+  _window_count = span;
+}
+
+bool QwtTimeseries::paintSegments(int from, int to, std::vector<std::pair<int, int>>& segments) const
+{
+  // the M4 view has its own index space and a column may straddle a hole;
+  // at that zoom level a gap narrower than a pixel column is invisible anyway
+  if (_decimated_active || to <= from)
+  {
+    return false;
+  }
+  _gap_index.update(*_ts_data);
+  const auto& gaps = _gap_index.gapStarts();
+  if (gaps.empty())
+  {
+    return false;
+  }
+  // translate from painter indexes to series indexes (see setRectOfInterest)
+  const size_t offset = (_window_count != 0) ? _window_first : 0;
+  const double x_from = _ts_data->at(offset + size_t(from)).x;
+  const double x_to = _ts_data->at(offset + size_t(to)).x;
+
+  segments.clear();
+  int begin = from;
+  for (auto it = std::lower_bound(gaps.begin(), gaps.end(), x_from); it != gaps.end() && *it < x_to;
+       it++)
+  {
+    // the gap timestamp is the exact x of the sample on its left edge
+    const int left = _ts_data->getIndexFromX(*it) - int(offset);
+    if (left >= begin && left < to)
+    {
+      segments.emplace_back(begin, left);
+      begin = left + 1;
+    }
+  }
+  if (segments.empty())
+  {
+    return false;
+  }
+  segments.emplace_back(begin, to);
+  return true;
+}
+
+void QwtTimeseries::setDisplayHint(Range range_x, int num_columns)
+{
+  // below this count, handing raw points to QwtPlotCurve is fast enough
+  constexpr size_t MIN_SAMPLES_TO_DECIMATE = 20000;
+
+  _decimated_active = false;
+  if (num_columns <= 0 || _ts_data->size() < MIN_SAMPLES_TO_DECIMATE)
+  {
+    return;
+  }
+  const int first_index = _ts_data->getIndexFromX(range_x.min + _time_offset);
+  const int last_index = _ts_data->getIndexFromX(range_x.max + _time_offset);
+  if (first_index < 0 || last_index <= first_index)
+  {
+    return;
+  }
+  const size_t span = size_t(last_index - first_index) + 1;
+  if (span < MIN_SAMPLES_TO_DECIMATE || span < size_t(num_columns) * 8)
+  {
+    return;
+  }
+
+  _y_index.update(*_ts_data);
+  _decimated.clear();
+  _decimated.reserve(size_t(num_columns) * 4);
+
+  const double x_first = _ts_data->at(first_index).x;
+  const double x_last = _ts_data->at(last_index).x;
+  const double column_width = (x_last - x_first) / num_columns;
+  if (!(column_width > 0.0))
+  {
+    return;
+  }
+
+  size_t i0 = size_t(first_index);
+  for (int col = 0; col < num_columns && i0 <= size_t(last_index); col++)
+  {
+    size_t i1 = size_t(last_index);
+    if (col + 1 < num_columns)
+    {
+      const double x_end = x_first + column_width * (col + 1);
+      int idx = _ts_data->getIndexFromX(x_end);
+      // getIndexFromX returns the closest sample: step back to the last
+      // one actually inside this column
+      while (idx > int(i0) && _ts_data->at(idx).x > x_end)
+      {
+        idx--;
+      }
+      i1 = std::min(std::max(size_t(idx), i0), size_t(last_index));
+    }
+    const auto& p_head = _ts_data->at(i0);
+    const auto& p_tail = _ts_data->at(i1);
+    _decimated.emplace_back(p_head.x, p_head.y);
+    if (i1 > i0 + 1)
+    {
+      const auto mm = _y_index.rangeY(*_ts_data, i0, i1);
+      const double x_mid = 0.5 * (p_head.x + p_tail.x);
+      _decimated.emplace_back(x_mid, mm.min);
+      _decimated.emplace_back(x_mid, mm.max);
+    }
+    if (i1 > i0)
+    {
+      _decimated.emplace_back(p_tail.x, p_tail.y);
+    }
+    i0 = i1 + 1;
+  }
+  _decimated_active = _decimated.size() < span;
+}
+
+bool TimeseriesEnvelope::rebuild(const PlotData& data, Range range_x, int num_columns)
+{
+  // below this density the raw (possibly M4-decimated) curve is just as
+  // honest and the band would degenerate into noise around it
+  constexpr size_t MIN_SAMPLES_PER_COLUMN = 4;
+
+  _band.clear();
+  _mean.clear();
+  if (num_columns <= 0 || data.size() < 2)
+  {
+    return false;
+  }
+  const int first_index = data.getIndexFromX(range_x.min);
+  const int last_index = data.getIndexFromX(range_x.max);
+  if (first_index < 0 || last_index <= first_index)
+  {
+    return false;
+  }
+  const size_t span = size_t(last_index - first_index) + 1;
+  if (span < size_t(num_columns) * MIN_SAMPLES_PER_COLUMN)
+  {
+    return false;
+  }
+
+  _index.update(data);
+  _band.reserve(num_columns);
+  _mean.reserve(num_columns);
+
+  const double x_first = data.at(first_index).x;
+  const double x_last = data.at(last_index).x;
+  const double column_width = (x_last - x_first) / num_columns;
+  if (!(column_width > 0.0))
+  {
+    return false;
+  }
+
+  size_t i0 = size_t(first_index);
+  for (int col = 0; col < num_columns && i0 <= size_t(last_index); col++)
+  {
+    size_t i1 = size_t(last_index);
+    if (col + 1 < num_columns)
+    {
+      const double x_end = x_first + column_width * (col + 1);
+      int idx = data.getIndexFromX(x_end);
+      // getIndexFromX returns the closest sample: step back to the last
+      // one actually inside this column
+      while (idx > int(i0) && data.at(idx).x > x_end)
+      {
+        idx--;
+      }
+      i1 = std::min(std::max(size_t(idx), i0), size_t(last_index));
+    }
+    const auto summary = _index.rangeSummary(data, i0, i1);
+    if (summary.count > 0)
+    {
+      const double x_mid = 0.5 * (data.at(i0).x + data.at(i1).x);
+      _band.append(QwtIntervalSample(x_mid, summary.min, summary.max));
+      _mean.append(QPointF(x_mid, summary.sum / double(summary.count)));
+    }
+    i0 = i1 + 1;
+  }
+  return _band.size() >= 2;
+}
+
 void QwtTimeseries::setTimeOffset(double offset)
 {
   _time_offset = offset;
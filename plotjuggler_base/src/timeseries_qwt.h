@@ -7,9 +7,13 @@
 #ifndef TIMESERIES_QWT_H
 #define TIMESERIES_QWT_H
 
+#include <deque>
 #include "qwt_series_data.h"
 #include "PlotJuggler/plotdata.h"
 #include "PlotJuggler/transform_function.h"
+#include "PlotJuggler/util/gap_index.hpp"
+#include "PlotJuggler/util/minmax_index.hpp"
+#include "PlotJuggler/util/summary_index.hpp"
 
 using namespace PJ;
 
@@ -39,8 +43,28 @@ public:
   virtual void updateCache(bool reset_old_data)
   {
   }
+
+  /// Called before painting with the visible X range and the canvas width
+  /// in pixels. Series holding many more samples than pixels may build a
+  /// decimated view; the default implementation draws every raw point.
+  virtual void setDisplayHint(Range range_x, int num_pixel_columns)
+  {
+  }
+
+protected:
+  void setSourceData(const PlotDataXY* data)
+  {
+    _data = data;
+  }
 };
 
+/**
+ * Samples are exposed in absolute time, exactly as stored: the "remove time
+ * offset" feature is applied on the axis side (the plot scrolls a hidden,
+ * shifted x axis under the curve), not by translating every point. The
+ * offset kept here is only used to convert between the relative coordinates
+ * of the visible axis and the sample timestamps.
+ */
 class QwtTimeseries : public QwtSeriesWrapper
 {
 public:
@@ -50,10 +74,15 @@ public:
 
   QPointF sample(size_t i) const override;
 
-  QRectF boundingRect() const override;
+  size_t size() const override;
 
   void setTimeOffset(double offset);
 
+  double timeOffset() const
+  {
+    return _time_offset;
+  }
+
   virtual RangeOpt getVisualizationRangeX() override;
 
   virtual RangeOpt getVisualizationRangeY(Range range_X) override;
@@ -64,18 +93,133 @@ public:
   {
   }
 
+  /// Build an M4-style view (first / min / max / last of each pixel
+  /// column) when the visible samples outnumber the pixels by a wide
+  /// margin, so that painting cost is bounded by the canvas width.
+  void setDisplayHint(Range range_x, int num_pixel_columns) override;
+
+  /// Called by Qwt with the visible axes range before painting. Since the
+  /// samples are sorted by time, the indexes of the visible ones are found
+  /// with getIndexFromX() and only that window (plus one sample per side)
+  /// is exposed to the painter: zoomed into a small portion of a long
+  /// series, the paint cost tracks the visible points instead of clipping
+  /// the whole history point by point. Independent of the M4 view above,
+  /// which already restricts itself to the visible columns.
+  void setRectOfInterest(const QRectF& rect) override;
+
+  /// Split the painter range [from, to] into runs of contiguous samples,
+  /// cutting at the time holes recorded by GapIndex, so the painter draws
+  /// one polyline per run instead of bridging an outage with a false line.
+  /// The indexes are in the same space as sample(), i.e. relative to the
+  /// window installed by setRectOfInterest(). Returns false (and leaves
+  /// `segments` untouched) when there is nothing to split: no hole in
+  /// range, irregular series, or M4 view active.
+  bool paintSegments(int from, int to, std::vector<std::pair<int, int>>& segments) const;
+
+  /// The underlying (possibly transformed) timeseries this wrapper reads.
+  const PlotData* timeseriesData() const
+  {
+    return _ts_data;
+  }
+
+  /// Install a min/max index built off-thread over `built_from` (see the
+  /// CacheWarmer of the application). Ignored when this wrapper switched
+  /// to another source in the meantime; a stale-but-matching index is
+  /// harmless, since every query calls update() first, which detects and
+  /// repairs a mismatch with the series. GUI thread only.
+  void adoptWarmIndex(const PlotData* built_from, MinMaxIndex&& index)
+  {
+    if (built_from == _ts_data)
+    {
+      _y_index = std::move(index);
+    }
+  }
+
 protected:
+  /// Switch the container this wrapper reads from. Used by
+  /// TransformedTimeseries to expose the source directly when no transform
+  /// is applied, instead of mirroring it point by point.
+  void setTimeseriesSource(const PlotData* data)
+  {
+    _ts_data = data;
+    setSourceData(data);
+    _y_index.clear();
+    _gap_index.clear();
+    _decimated_active = false;
+    _window_count = 0;
+  }
+
   const PlotData* _ts_data;
   double _time_offset = 0.0;
+  // answers sub-range min/max queries in O(log n). Updated lazily.
+  MinMaxIndex _y_index;
+  // timestamps of the holes of the series, for paintSegments(). Updated
+  // lazily, like _y_index.
+  mutable GapIndex _gap_index;
+
+  std::vector<QPointF> _decimated;
+  bool _decimated_active = false;
+
+  // visible index window set by setRectOfInterest(); a count of zero
+  // means the whole series is exposed
+  size_t _window_first = 0;
+  size_t _window_count = 0;
 };
 
 //------------------------------------
 
+/**
+ * Per-pixel-column min/max band and mean line of a timeseries, used by the
+ * envelope display mode of PlotWidgetBase. Each column is answered by
+ * SummaryIndex in O(log n), so a fully-zoomed-out view of a multi-million
+ * sample series costs O(columns * log n) instead of a full scan, while
+ * still showing the true extremes that a decimated line would hide.
+ */
+class TimeseriesEnvelope
+{
+public:
+  /// Recompute band and mean line for the given range (in the time frame
+  /// of the samples) and canvas width. Returns false when the visible
+  /// samples are too few for an envelope to be meaningful; the caller
+  /// should draw the raw curve instead.
+  bool rebuild(const PlotData& data, Range range_x, int num_columns);
+
+  const QVector<QwtIntervalSample>& band() const
+  {
+    return _band;
+  }
+
+  const QVector<QPointF>& meanLine() const
+  {
+    return _mean;
+  }
+
+private:
+  // answers per-column min/max/mean queries. Updated lazily.
+  SummaryIndex _index;
+  QVector<QwtIntervalSample> _band;
+  QVector<QPointF> _mean;
+};
+
+//------------------------------------
+
+/**
+ * The transform_ID may also be a '|' separated chain of IDs (for example
+ * "Scale/Offset|Absolute|Moving Average"): the stages are compiled into a
+ * pipeline executed by updateCache(). Consecutive stages that declare a
+ * pointwiseOperation() are fused into a single loop, so a run of value-only
+ * mappings costs no intermediate series; a stateful stage followed by
+ * pointwise ones writes into a scratch buffer that only ever holds the
+ * samples of the current pass.
+ */
 class TransformedTimeseries : public QwtTimeseries
 {
 public:
   TransformedTimeseries(const PlotData* source_data);
 
+  /// The first stage of the pipeline (the only one, in the common case of a
+  /// single transform). Its options widget and XML state are the ones
+  /// exposed in the curve editor.
   TransformFunction::Ptr transform();
 
   // return true if the transform was set, false if the transform_ID was not found
@@ -90,10 +234,22 @@ public:
   void setAlias(QString alias);
 
 protected:
+  /// Discard the state of every stage and the content of every buffer;
+  /// the next pass recomputes the pipeline from the source.
+  void resetPipeline();
+
   QString _alias;
   PlotData _dst_data;
   const PlotData* _src_data;
-  TransformFunction_SISO::Ptr _transform;
+  std::vector<TransformFunction::Ptr> _stages;
+  // _buffers[i] receives the output of stage i (the last stage writes to
+  // _dst_data instead). Depending on the compiled plan a buffer holds the
+  // full history (the input of a stateful stage) or only the delta of the
+  // current pass (consumed and cleared by a fused pointwise run).
+  std::deque<PlotData> _buffers;
+  // which stages were pointwise in the last executed plan: when an option
+  // change flips a stage, the buffers become stale and the pipeline restarts
+  uint64_t _plan_signature = 0;
 };
 
 //---------------------------------------------------------
@@ -19,6 +19,11 @@ std::vector<const PlotData*>& TransformFunction::dataSources()
   return _src_vector;
 }
 
+std::vector<PlotData*>& TransformFunction::dataOutputs()
+{
+  return _dst_vector;
+}
+
 void TransformFunction::setData(PlotDataMapRef* data, const std::vector<const PlotData*>& src_vect,
                                 std::vector<PlotData*>& dst_vect)
 {
@@ -58,20 +63,28 @@ void TransformFunction_SISO::calculate()
   int pos = src_data->getIndexFromX(_last_timestamp);
   size_t index = pos < 0 ? 0 : static_cast<size_t>(pos);
 
-  while (index < src_data->size())
+  // data is time-sorted: everything from the first unprocessed sample
+  // onward belongs to this batch
+  while (index < src_data->size() && src_data->at(index).x < _last_timestamp)
+  {
+    index++;
+  }
+  if (index < src_data->size())
   {
-    const auto& in_point = src_data->at(index);
+    calculateBatch(index, src_data->size(), dst_data);
+    _last_timestamp = src_data->back().x;
+  }
+}
 
-    if (in_point.x >= _last_timestamp)
+void TransformFunction_SISO::calculateBatch(size_t from, size_t to, PlotData* dst_data)
+{
+  for (size_t index = from; index < to; index++)
+  {
+    auto out_point = calculateNextPoint(index);
+    if (out_point)
     {
-      auto out_point = calculateNextPoint(index);
-      if (out_point)
-      {
-        dst_data->pushBack(std::move(out_point.value()));
-      }
-      _last_timestamp = in_point.x;
+      dst_data->pushBack(std::move(out_point.value()));
     }
-    index++;
   }
 }
 
@@ -2,10 +2,15 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <iomanip>
 #include <limits>
 #include <set>
 #include <sstream>
+#include <string_view>
+#include <thread>
 
 namespace PJ::CSV
 {
@@ -106,7 +111,8 @@ char DetectDelimiter(const std::string& first_line)
 // SplitLine
 // ---------------------------------------------------------------------------
 
-void SplitLine(const std::string& line, char separator, std::vector<std::string>& parts)
+void SplitLine(const std::string& line, char separator, std::vector<std::string>& parts,
+               const std::vector<char>* keep_columns)
 {
   parts.clear();
   bool inside_quotes = false;
@@ -154,17 +160,26 @@ void SplitLine(const std::string& line, char separator, std::vector<std::string>
 
     if (part_completed)
     {
-      std::string part;
-      if (quoted_word)
+      // projected-out column: keep scanning for field boundaries, but
+      // never copy the characters into a string
+      const size_t column = parts.size();
+      if (keep_columns && column < keep_columns->size() && !(*keep_columns)[column])
       {
-        part = line.substr(quote_start, quote_end - quote_start + 1);
+        parts.emplace_back();
       }
       else
       {
-        part = line.substr(start_pos, end_pos - start_pos);
+        std::string part;
+        if (quoted_word)
+        {
+          part = line.substr(quote_start, quote_end - quote_start + 1);
+        }
+        else
+        {
+          part = line.substr(start_pos, end_pos - start_pos);
+        }
+        parts.push_back(Trim(part));
       }
-
-      parts.push_back(Trim(part));
       start_pos = pos + 1;
       quoted_word = false;
       inside_quotes = false;
@@ -350,8 +365,12 @@ CsvParseResult ParseCsvData(std::istream& input, const CsvParseConfig& config,
     result.columns[i].name = result.column_names[i];
   }
 
-  // Column types detected from first data row
+  // Column types detected from first data row, unless forced by the caller
   std::vector<ColumnTypeInfo> column_types(num_columns);
+  if (config.predetected_types.size() == num_columns)
+  {
+    column_types = config.predetected_types;
+  }
 
   // Populate combined component indices if using combined columns
   if (config.combined_column_index >= 0 &&
@@ -362,6 +381,31 @@ CsvParseResult ParseCsvData(std::istream& input, const CsvParseConfig& config,
     result.combined_component_indices.insert(combo.time_column_index);
   }
 
+  // Column projection: the mask tells SplitLine which fields it can skip
+  // without materializing a string. The time source columns are forced in,
+  // since the timestamp is needed for every row.
+  std::vector<char> keep_columns;
+  if (!config.selected_columns.empty())
+  {
+    keep_columns.assign(num_columns, 0);
+    for (int index : config.selected_columns)
+    {
+      if (index >= 0 && index < static_cast<int>(num_columns))
+      {
+        keep_columns[index] = 1;
+      }
+    }
+    if (config.time_column_index >= 0 && config.time_column_index < static_cast<int>(num_columns))
+    {
+      keep_columns[config.time_column_index] = 1;
+    }
+    for (int index : result.combined_component_indices)
+    {
+      keep_columns[index] = 1;
+    }
+  }
+  const std::vector<char>* keep_mask = keep_columns.empty() ? nullptr : &keep_columns;
+
   double prev_time = std::numeric_limits<double>::lowest();
   int linenumber = config.skip_rows + 1;  // header was this line
   int samplecount = 0;
@@ -386,6 +430,10 @@ CsvParseResult ParseCsvData(std::istream& input, const CsvParseConfig& config,
   std::vector<std::string> parts;
   std::string line;
 
+  // per-column incremental parsers: consecutive rows usually share the same
+  // date prefix, so DATETIME cells can skip the full date::parse path
+  std::vector<DateTimeCache> column_caches(num_columns);
+
   while (std::getline(input, line))
   {
     linenumber++;
@@ -396,7 +444,7 @@ CsvParseResult ParseCsvData(std::istream& input, const CsvParseConfig& config,
       line.pop_back();
     }
 
-    SplitLine(line, config.delimiter, parts);
+    SplitLine(line, config.delimiter, parts, keep_mask);
 
     // Empty line — skip
     if (parts.empty())
@@ -420,6 +468,10 @@ CsvParseResult ParseCsvData(std::istream& input, const CsvParseConfig& config,
     // Detect column types from first data row with non-empty cells
     for (size_t i = 0; i < num_columns; i++)
     {
+      if (keep_mask && !keep_columns[i])
+      {
+        continue;
+      }
       if (column_types[i].type == ColumnType::UNDEFINED && !parts[i].empty())
       {
         column_types[i] = DetectColumnType(parts[i]);
@@ -472,7 +524,7 @@ CsvParseResult ParseCsvData(std::istream& input, const CsvParseConfig& config,
         const auto& time_type = column_types[config.time_column_index];
         if (time_type.type != ColumnType::STRING)
         {
-          if (auto ts = ParseWithType(t_str, time_type))
+          if (auto ts = column_caches[config.time_column_index].Parse(t_str, time_type))
           {
             timestamp_valid = true;
             timestamp = *ts;
@@ -511,6 +563,12 @@ CsvParseResult ParseCsvData(std::istream& input, const CsvParseConfig& config,
     // Parse column values
     for (size_t i = 0; i < num_columns; i++)
     {
+      // the time column may be kept in the mask only to compute the
+      // timestamp: values are stored for the selected columns alone
+      if (keep_mask && config.selected_columns.count(static_cast<int>(i)) == 0)
+      {
+        continue;
+      }
       if (result.combined_component_indices.count(static_cast<int>(i)) > 0)
       {
         continue;
@@ -526,7 +584,7 @@ CsvParseResult ParseCsvData(std::istream& input, const CsvParseConfig& config,
 
       if (col_type.type != ColumnType::STRING)
       {
-        if (auto val = ParseWithType(str, col_type))
+        if (auto val = column_caches[i].Parse(str, col_type))
         {
           result.columns[i].numeric_points.emplace_back(timestamp, *val);
         }
@@ -572,4 +630,337 @@ CsvParseResult ParseCsvData(const std::string& csv_content, const CsvParseConfig
   return ParseCsvData(stream, config, progress);
 }
 
+// ---------------------------------------------------------------------------
+// ParseCsvDataParallel
+// ---------------------------------------------------------------------------
+
+namespace
+{
+
+/// Read-only istream over two in-memory segments (header + chunk),
+/// without copying either of them.
+class ConcatStreambuf : public std::streambuf
+{
+public:
+  ConcatStreambuf(const char* first, size_t first_size, const char* second, size_t second_size)
+    : _second(second), _second_size(second_size)
+  {
+    char* begin = const_cast<char*>(first);
+    setg(begin, begin, begin + first_size);
+  }
+
+protected:
+  int_type underflow() override
+  {
+    if (gptr() < egptr())
+    {
+      return traits_type::to_int_type(*gptr());
+    }
+    if (_second)
+    {
+      char* begin = const_cast<char*>(_second);
+      setg(begin, begin, begin + _second_size);
+      _second = nullptr;
+      if (gptr() < egptr())
+      {
+        return traits_type::to_int_type(*gptr());
+      }
+    }
+    return traits_type::eof();
+  }
+
+private:
+  const char* _second;
+  size_t _second_size;
+};
+
+size_t CountLines(const char* begin, const char* end)
+{
+  size_t count = 0;
+  while (begin < end)
+  {
+    const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+    count++;
+    if (!newline)
+    {
+      break;
+    }
+    begin = newline + 1;
+  }
+  return count;
+}
+
+}  // namespace
+
+CsvParseResult ParseCsvDataParallel(const char* data, size_t size, const CsvParseConfig& config,
+                                    std::function<bool(int, int)> progress)
+{
+  CsvParseResult result;
+  const std::string_view content(data, size);
+
+  // Locate the header line, skipping the configured number of rows
+  size_t pos = 0;
+  for (int i = 0; i < config.skip_rows; i++)
+  {
+    pos = content.find('\n', pos);
+    if (pos == std::string_view::npos)
+    {
+      return result;  // not enough lines
+    }
+    pos++;
+  }
+  if (pos >= size)
+  {
+    return result;
+  }
+
+  const size_t header_end = content.find('\n', pos);
+  std::string header_line(content.substr(pos, (header_end == std::string_view::npos) ?
+                                                  std::string_view::npos :
+                                                  header_end - pos));
+  if (!header_line.empty() && header_line.back() == '\r')
+  {
+    header_line.pop_back();
+  }
+  const size_t body_begin = (header_end == std::string_view::npos) ? size : header_end + 1;
+
+  // Every chunk must interpret the columns the same way: detect the types
+  // once, from the first data rows, and force them in each worker.
+  CsvParseConfig chunk_config = config;
+  chunk_config.skip_rows = 0;
+  chunk_config.total_lines = std::max(1, config.total_lines);  // suppress line counting
+  if (chunk_config.predetected_types.empty())
+  {
+    const auto column_names = ParseHeaderLine(header_line, config.delimiter);
+    std::vector<ColumnTypeInfo> types(column_names.size());
+    std::vector<std::string> parts;
+    size_t line_start = body_begin;
+    for (int row = 0; row < 100 && line_start < size; row++)
+    {
+      size_t line_end = content.find('\n', line_start);
+      if (line_end == std::string_view::npos)
+      {
+        line_end = size;
+      }
+      std::string line(content.substr(line_start, line_end - line_start));
+      if (!line.empty() && line.back() == '\r')
+      {
+        line.pop_back();
+      }
+      SplitLine(line, config.delimiter, parts);
+      for (size_t i = 0; i < types.size() && i < parts.size(); i++)
+      {
+        if (types[i].type == ColumnType::UNDEFINED && !parts[i].empty())
+        {
+          types[i] = DetectColumnType(parts[i]);
+        }
+      }
+      line_start = line_end + 1;
+    }
+    chunk_config.predetected_types = std::move(types);
+  }
+
+  // Split the body into line-aligned chunks, one per worker
+  constexpr size_t MIN_CHUNK_SIZE = 1024 * 1024;
+  const size_t body_size = size - body_begin;
+  size_t num_chunks = std::max<size_t>(1, std::thread::hardware_concurrency());
+  num_chunks = std::min(num_chunks, std::max<size_t>(1, body_size / MIN_CHUNK_SIZE));
+
+  std::vector<std::pair<size_t, size_t>> chunks;  // [begin, end)
+  size_t chunk_begin = body_begin;
+  for (size_t c = 0; c < num_chunks && chunk_begin < size; c++)
+  {
+    size_t chunk_end = (c + 1 == num_chunks) ? size : body_begin + (body_size * (c + 1)) / num_chunks;
+    chunk_end = std::max(chunk_end, chunk_begin);
+    if (chunk_end < size)
+    {
+      const size_t newline = content.find('\n', chunk_end);
+      chunk_end = (newline == std::string_view::npos) ? size : newline + 1;
+    }
+    chunks.emplace_back(chunk_begin, chunk_end);
+    chunk_begin = chunk_end;
+  }
+
+  const std::string header_with_newline = header_line + '\n';
+
+  if (chunks.size() <= 1)
+  {
+    // Nothing to parallelize: parse in place, keeping the caller's callback
+    const char* chunk_data = chunks.empty() ? data : data + chunks[0].first;
+    const size_t chunk_size = chunks.empty() ? 0 : chunks[0].second - chunks[0].first;
+    ConcatStreambuf buffer(header_with_newline.data(), header_with_newline.size(), chunk_data,
+                           chunk_size);
+    std::istream stream(&buffer);
+    chunk_config.total_lines = config.total_lines;
+    result = ParseCsvData(stream, chunk_config, progress);
+    for (auto& warn : result.warnings)
+    {
+      warn.line_number += config.skip_rows;
+    }
+    return result;
+  }
+
+  struct Shard
+  {
+    CsvParseResult result;
+    size_t line_count = 0;  // physical lines in the chunk, empty ones included
+  };
+
+  std::vector<Shard> shards(chunks.size());
+  std::atomic<int> lines_done(0);
+  std::atomic<size_t> shards_done(0);
+  std::atomic<bool> cancelled(false);
+
+  auto parseChunk = [&](size_t c) {
+    const auto [begin, end] = chunks[c];
+    Shard& shard = shards[c];
+    shard.line_count = CountLines(data + begin, data + end);
+
+    ConcatStreambuf buffer(header_with_newline.data(), header_with_newline.size(), data + begin,
+                           end - begin);
+    std::istream stream(&buffer);
+
+    int prev_line = 0;
+    shard.result = ParseCsvData(stream, chunk_config, [&](int line, int) -> bool {
+      lines_done.fetch_add(line - prev_line, std::memory_order_relaxed);
+      prev_line = line;
+      return !cancelled.load(std::memory_order_relaxed);
+    });
+    shards_done.fetch_add(1, std::memory_order_release);
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(chunks.size());
+  for (size_t c = 0; c < chunks.size(); c++)
+  {
+    threads.emplace_back(parseChunk, c);
+  }
+
+  // Pump the caller's callback from this thread while the workers run
+  while (shards_done.load(std::memory_order_acquire) < shards.size())
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    if (progress && !cancelled &&
+        !progress(lines_done.load(std::memory_order_relaxed), config.total_lines))
+    {
+      cancelled = true;
+    }
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  if (cancelled)
+  {
+    return result;  // success == false, like the cancelled sequential path
+  }
+
+  // Merge the shards in file order
+  result = std::move(shards[0].result);
+
+  // without a combined or regular time column, timestamps are row numbers
+  const bool combined_time =
+      config.combined_column_index >= 0 &&
+      config.combined_column_index < static_cast<int>(config.combined_columns.size());
+  const bool column_time = config.time_column_index >= 0 &&
+                           config.time_column_index < static_cast<int>(result.column_names.size());
+  const bool row_number_time = !combined_time && !column_time;
+
+  for (auto& warn : result.warnings)
+  {
+    warn.line_number += config.skip_rows;
+  }
+
+  // lines/samples contained in the shards already merged
+  size_t lines_before = shards[0].line_count;
+  int samples_before = result.lines_processed;
+
+  for (size_t c = 1; c < shards.size(); c++)
+  {
+    auto& shard = shards[c].result;
+
+    // a chunk's line N sits at global line skip_rows + lines_before + N
+    const int line_offset = config.skip_rows + static_cast<int>(lines_before);
+    for (auto& warn : shard.warnings)
+    {
+      if (warn.type == CsvParseWarning::DUPLICATE_COLUMN_NAMES)
+      {
+        continue;  // already reported by the first shard
+      }
+      warn.line_number += line_offset;
+      result.warnings.push_back(std::move(warn));
+    }
+
+    // non-monotonic time across the chunk boundary
+    if (!row_number_time && !result.time_is_non_monotonic)
+    {
+      double prev_last = std::numeric_limits<double>::lowest();
+      double next_first = std::numeric_limits<double>::max();
+      for (size_t i = 0; i < result.columns.size(); i++)
+      {
+        const auto& dst = result.columns[i];
+        const auto& src = shard.columns[i];
+        if (!dst.numeric_points.empty())
+        {
+          prev_last = std::max(prev_last, dst.numeric_points.back().first);
+        }
+        if (!dst.string_points.empty())
+        {
+          prev_last = std::max(prev_last, dst.string_points.back().first);
+        }
+        if (!src.numeric_points.empty())
+        {
+          next_first = std::min(next_first, src.numeric_points.front().first);
+        }
+        if (!src.string_points.empty())
+        {
+          next_first = std::min(next_first, src.string_points.front().first);
+        }
+      }
+      if (prev_last > next_first)
+      {
+        result.time_is_non_monotonic = true;
+        CsvParseWarning warn;
+        warn.type = CsvParseWarning::NON_MONOTONIC_TIME;
+        warn.line_number = line_offset + 2;
+        warn.detail = "Time is not monotonically increasing";
+        result.warnings.push_back(warn);
+      }
+    }
+    result.time_is_non_monotonic |= shard.time_is_non_monotonic;
+
+    for (size_t i = 0; i < result.columns.size() && i < shard.columns.size(); i++)
+    {
+      auto& dst = result.columns[i];
+      auto& src = shard.columns[i];
+
+      if (row_number_time)
+      {
+        // row-number timestamps restart at 0 in every chunk
+        for (auto& point : src.numeric_points)
+        {
+          point.first += samples_before;
+        }
+        for (auto& point : src.string_points)
+        {
+          point.first += samples_before;
+        }
+      }
+      dst.numeric_points.insert(dst.numeric_points.end(), src.numeric_points.begin(),
+                                src.numeric_points.end());
+      dst.string_points.insert(dst.string_points.end(),
+                               std::make_move_iterator(src.string_points.begin()),
+                               std::make_move_iterator(src.string_points.end()));
+    }
+
+    result.lines_processed += shard.lines_processed;
+    result.lines_skipped += shard.lines_skipped;
+    samples_before += shard.lines_processed;
+    lines_before += shards[c].line_count;
+  }
+
+  return result;
+}
+
 }  // namespace PJ::CSV
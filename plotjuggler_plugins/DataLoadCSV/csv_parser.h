@@ -36,8 +36,13 @@ char DetectDelimiter(const std::string& first_line);
  * @param line The CSV line to split
  * @param separator The delimiter character
  * @param parts Output: the split parts (cleared first)
+ * @param keep_columns Optional projection mask: when non-null, the fields
+ *        whose index maps to false are never materialized (the matching
+ *        entry of @p parts is left as an empty string). The field
+ *        boundaries are still scanned, so the column count is preserved.
  */
-void SplitLine(const std::string& line, char separator, std::vector<std::string>& parts);
+void SplitLine(const std::string& line, char separator, std::vector<std::string>& parts,
+               const std::vector<char>* keep_columns = nullptr);
 
 /**
  * @brief Parse a CSV header line into column names.
@@ -74,6 +79,19 @@ struct CsvParseConfig
 
   std::vector<CombinedColumnPair> combined_columns;  // detected date+time pairs
   int combined_column_index = -1;                    // which pair to use for time; -1 = not used
+
+  // Optional: force the type of each column instead of detecting it from the
+  // first data row. Used by ParseCsvDataParallel so every chunk interprets
+  // the columns the same way. Ignored unless the size matches the header.
+  std::vector<ColumnTypeInfo> predetected_types;
+
+  // Optional projection: when non-empty, only the columns whose index is in
+  // this set produce values; the other fields are skipped at the tokenizer
+  // level, without materializing a string, and their CsvColumnData stays
+  // empty. The time column and the combined date/time components are still
+  // tokenized to compute the timestamps, but do not produce values unless
+  // they are selected themselves.
+  std::set<int> selected_columns;
 };
 
 struct CsvColumnData
@@ -143,6 +161,29 @@ CsvParseResult ParseCsvData(std::istream& input, const CsvParseConfig& config,
 CsvParseResult ParseCsvData(const std::string& csv_content, const CsvParseConfig& config,
                             std::function<bool(int, int)> progress = nullptr);
 
+/**
+ * @brief Parse an in-memory (typically memory-mapped) CSV buffer in parallel.
+ *
+ * The buffer is split into line-aligned chunks, each parsed by a worker
+ * thread into its own CsvParseResult; the shards are then merged in file
+ * order. Column types are detected once from the first data rows so every
+ * chunk interprets the columns identically. Results are equivalent to
+ * ParseCsvData on the same content, including warnings and line numbers.
+ *
+ * The buffer is never copied: callers can pass a pointer obtained from
+ * QFile::map() / mmap(). The progress callback, when provided, is invoked
+ * from the calling thread while the workers run; returning false cancels
+ * the parse.
+ *
+ * @param data First byte of the CSV content
+ * @param size Size of the content in bytes
+ * @param config Parsing configuration
+ * @param progress Optional callback: progress(lines_done, total_lines) → false to cancel
+ * @return CsvParseResult with all parsed data, warnings, and metadata
+ */
+CsvParseResult ParseCsvDataParallel(const char* data, size_t size, const CsvParseConfig& config,
+                                    std::function<bool(int, int)> progress = nullptr);
+
 }  // namespace PJ::CSV
 
 #endif  // CSV_PARSER_H
@@ -7,7 +7,6 @@
 #include <QMessageBox>
 #include <QDebug>
 #include <QSettings>
-#include <QProgressDialog>
 #include <QDateTime>
 #include <QInputDialog>
 #include <QPushButton>
@@ -17,6 +16,7 @@
 #include <QListWidgetItem>
 
 #include <array>
+#include <cstring>
 #include <set>
 #include <algorithm>
 
@@ -142,6 +142,17 @@ DataLoadCSV::DataLoadCSV()
 
   connect(_ui->dateTimeHelpButton, &QPushButton::clicked, this,
           [this]() { _dateTime_dialog->show(); });
+
+  auto setAllColumnsChecked = [this](Qt::CheckState state) {
+    for (int row = 0; row < _ui->listWidgetColumns->count(); row++)
+    {
+      _ui->listWidgetColumns->item(row)->setCheckState(state);
+    }
+  };
+  connect(_ui->buttonSelectAllColumns, &QPushButton::clicked, this,
+          [setAllColumnsChecked]() { setAllColumnsChecked(Qt::Checked); });
+  connect(_ui->buttonDeselectColumns, &QPushButton::clicked, this,
+          [setAllColumnsChecked]() { setAllColumnsChecked(Qt::Unchecked); });
   _ui->rawText->setHighlighter(&_csvHighlighter);
 
   QSizePolicy sp_retain = _ui->tableView->sizePolicy();
@@ -225,6 +236,23 @@ void DataLoadCSV::parseHeader(QFile& file, std::vector<std::string>& column_name
   _model->setColumnCount(column_labels.size());
   _model->setHorizontalHeaderLabels(column_labels);
 
+  // Column projection list, in file order. The saved default set lets a
+  // user who always plots the same handful of columns skip the other
+  // hundreds every time; an empty saved set means "load everything".
+  _ui->listWidgetColumns->clear();
+  const QStringList saved_selection =
+      settings.value("DataLoadCSV.selectedColumns").toStringList();
+  for (size_t i = 0; i < column_names.size(); i++)
+  {
+    auto qname = QString::fromStdString(column_names[i]);
+    auto* item = new QListWidgetItem(qname);
+    item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+    const bool checked = saved_selection.isEmpty() || saved_selection.contains(qname);
+    item->setCheckState(checked ? Qt::Checked : Qt::Unchecked);
+    item->setData(Qt::UserRole, static_cast<int>(i));
+    _ui->listWidgetColumns->addItem(item);
+  }
+
   QStringList lines;
 
   for (int row = 0; row <= 100 && !inA.atEnd(); row++)
@@ -376,6 +404,28 @@ int DataLoadCSV::launchDialog(QFile& file, std::vector<std::string>* column_name
   settings.setValue("DataLoadCSV.useDateFormat", _ui->radioCustomTime->isChecked());
   settings.setValue("DataLoadCSV.dateFormat", _ui->lineEditDateFormat->text());
 
+  {
+    // persist the projection as the default for the next load. A fully
+    // checked list is stored as an empty one, so that files with other
+    // column names start fully selected instead of fully deselected.
+    QStringList checked_columns;
+    bool all_checked = true;
+    for (int row = 0; row < _ui->listWidgetColumns->count(); row++)
+    {
+      auto* item = _ui->listWidgetColumns->item(row);
+      if (item->checkState() == Qt::Checked)
+      {
+        checked_columns.push_back(item->text());
+      }
+      else
+      {
+        all_checked = false;
+      }
+    }
+    settings.setValue("DataLoadCSV.selectedColumns",
+                      all_checked ? QStringList() : checked_columns);
+  }
+
   if (res == QDialog::Rejected)
   {
     return TIME_INDEX_NOT_DEFINED;
@@ -408,6 +458,7 @@ int DataLoadCSV::launchDialog(QFile& file, std::vector<std::string>* column_name
 bool DataLoadCSV::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_data)
 {
   multiple_columns_warning_ = true;
+  _tail_state.valid = false;
 
   _fileInfo = info;
 
@@ -476,50 +527,99 @@ bool DataLoadCSV::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_data
     config.custom_time_format = _ui->lineEditDateFormat->text().toStdString();
   }
 
+  // column projection: active only when at least one column is unchecked
+  {
+    bool any_unchecked = false;
+    std::set<int> selected_columns;
+    for (int row = 0; row < _ui->listWidgetColumns->count(); row++)
+    {
+      auto* item = _ui->listWidgetColumns->item(row);
+      if (item->checkState() == Qt::Checked)
+      {
+        selected_columns.insert(item->data(Qt::UserRole).toInt());
+      }
+      else
+      {
+        any_unchecked = true;
+      }
+    }
+    if (any_unchecked)
+    {
+      config.selected_columns = std::move(selected_columns);
+    }
+  }
+
+  //--- Map the file in memory; no copy, and chunks can be parsed in parallel ---
+  file.open(QFile::ReadOnly);
+  const qint64 file_size = file.size();
+  uchar* mapped = file.map(0, file_size);
+
+  QByteArray fallback_data;
+  const char* file_begin = nullptr;
+  if (mapped)
+  {
+    file_begin = reinterpret_cast<const char*>(mapped);
+  }
+  else
+  {
+    // mapping may fail on virtual filesystems: read the whole file instead
+    fallback_data = file.readAll();
+    file_begin = fallback_data.constData();
+  }
+
+  // keep a copy of the header line: tailDataFromFile() prepends it to each
+  // chunk so that names, deduplication and column count stay consistent
+  std::string tail_header;
+  {
+    const char* newline =
+        static_cast<const char*>(memchr(file_begin, '\n', static_cast<size_t>(file_size)));
+    tail_header.assign(file_begin, newline ? newline - file_begin : file_size);
+    if (!tail_header.empty() && tail_header.back() == '\r')
+    {
+      tail_header.pop_back();
+    }
+  }
+
   //--- Count lines for progress ---
   {
-    file.open(QFile::ReadOnly);
-    QTextStream in(&file);
-    while (!in.atEnd())
+    const char* ptr = file_begin;
+    const char* end = file_begin + file_size;
+    while (ptr < end)
     {
-      in.readLine();
+      const char* newline = static_cast<const char*>(memchr(ptr, '\n', end - ptr));
       config.total_lines++;
+      if (!newline)
+      {
+        break;
+      }
+      ptr = newline + 1;
     }
-    file.close();
   }
 
-  QProgressDialog progress_dialog;
-  progress_dialog.setWindowTitle("Loading the CSV file");
-  progress_dialog.setLabelText("Loading... please wait");
-  progress_dialog.setWindowModality(Qt::ApplicationModal);
-  progress_dialog.setRange(0, config.total_lines);
-  progress_dialog.setAutoClose(true);
-  progress_dialog.setAutoReset(true);
-  progress_dialog.show();
-
   //--- Parse via csv_parser ---
   bool interrupted = false;
 
-  file.open(QFile::ReadOnly);
-  QByteArray file_data = file.readAll();
-  file.close();
-
-  std::string file_str(file_data.constData(), file_data.size());
+  const double total_lines = std::max(1, config.total_lines);
+  auto result = PJ::CSV::ParseCsvDataParallel(file_begin, static_cast<size_t>(file_size), config,
+                                              [&](int current, int) -> bool {
+                                                if (!notifyProgress(current / total_lines))
+                                                {
+                                                  interrupted = true;
+                                                  return false;
+                                                }
+                                                return true;
+                                              });
 
-  auto result = PJ::CSV::ParseCsvData(file_str, config, [&](int current, int) -> bool {
-    progress_dialog.setValue(current);
-    QApplication::processEvents();
-    if (progress_dialog.wasCanceled())
-    {
-      interrupted = true;
-      return false;
-    }
-    return true;
-  });
+  if (mapped)
+  {
+    file.unmap(mapped);
+  }
+  file.close();
 
   if (interrupted)
   {
-    progress_dialog.cancel();
+    // the chunks parse in parallel: an interrupted run has holes, so no
+    // consistent partial result can be kept
     plot_data.clear();
     return false;
   }
@@ -555,40 +655,23 @@ bool DataLoadCSV::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_data
   }
 
   //--- Convert CsvParseResult → PlotData ---
-  for (size_t i = 0; i < result.columns.size(); i++)
-  {
-    const auto& col = result.columns[i];
-    const std::string& name = col.name;
-
-    bool has_numeric = !col.numeric_points.empty();
-    bool has_string = !col.string_points.empty();
+  appendResultToPlotData(result, config, 0.0, plot_data);
 
-    if (has_numeric)
-    {
-      auto num_it = plot_data.addNumeric(name);
-      auto& series = num_it->second;
-      for (const auto& [ts, val] : col.numeric_points)
-      {
-        series.pushBack({ ts, val });
-      }
-    }
-    if (has_string && !has_numeric)
-    {
-      auto str_it = plot_data.addStringSeries(name);
-      auto& series = str_it->second;
-      for (const auto& [ts, val] : col.string_points)
-      {
-        series.pushBack({ ts, val });
-      }
-    }
-    // If column has both numeric and string data (parse failures),
-    // keep only numeric and discard string fallbacks
-    if (!has_numeric && !has_string)
-    {
-      // Column with no data at all — still register it as numeric
-      plot_data.addNumeric(name);
-    }
+  //--- Remember the parse state, so tailDataFromFile() can resume ---
+  _tail_state = TailState();
+  _tail_state.filename = info->filename;
+  _tail_state.file_offset = file_size;
+  _tail_state.header_line = tail_header;
+  _tail_state.config = config;
+  _tail_state.config.skip_rows = 0;
+  _tail_state.config.total_lines = 0;
+  _tail_state.config.predetected_types.clear();
+  for (const auto& col : result.columns)
+  {
+    _tail_state.config.predetected_types.push_back(col.detected_type);
   }
+  _tail_state.samples_loaded = result.lines_processed;
+  _tail_state.valid = true;
 
   //--- Update default time axis ---
   if (time_index == TIME_INDEX_COMBINED && !_combined_columns.empty())
@@ -640,6 +723,126 @@ bool DataLoadCSV::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_data
   return true;
 }
 
+void DataLoadCSV::appendResultToPlotData(const PJ::CSV::CsvParseResult& result,
+                                         const PJ::CSV::CsvParseConfig& config, double time_offset,
+                                         PlotDataMapRef& plot_data)
+{
+  // staging arrays reused across columns, to feed appendBatch()
+  std::vector<double> stage_x;
+  std::vector<double> stage_y;
+
+  for (size_t i = 0; i < result.columns.size(); i++)
+  {
+    // projected-out columns carry no data and must not create a series
+    if (!config.selected_columns.empty() &&
+        config.selected_columns.count(static_cast<int>(i)) == 0)
+    {
+      continue;
+    }
+    const auto& col = result.columns[i];
+    const std::string& name = col.name;
+
+    bool has_numeric = !col.numeric_points.empty();
+    bool has_string = !col.string_points.empty();
+
+    if (has_numeric)
+    {
+      auto num_it = plot_data.addNumeric(name);
+      auto& series = num_it->second;
+      stage_x.clear();
+      stage_y.clear();
+      stage_x.reserve(col.numeric_points.size());
+      stage_y.reserve(col.numeric_points.size());
+      for (const auto& [ts, val] : col.numeric_points)
+      {
+        stage_x.push_back(ts + time_offset);
+        stage_y.push_back(val);
+      }
+      series.appendBatch(stage_x.data(), stage_y.data(), stage_x.size());
+    }
+    if (has_string && !has_numeric)
+    {
+      auto str_it = plot_data.addStringSeries(name);
+      auto& series = str_it->second;
+      for (const auto& [ts, val] : col.string_points)
+      {
+        series.pushBack({ ts + time_offset, val });
+      }
+    }
+    // If column has both numeric and string data (parse failures),
+    // keep only numeric and discard string fallbacks
+    if (!has_numeric && !has_string)
+    {
+      // Column with no data at all — still register it as numeric
+      plot_data.addNumeric(name);
+    }
+  }
+}
+
+bool DataLoadCSV::tailDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_data)
+{
+  if (!_tail_state.valid || _tail_state.filename != info->filename)
+  {
+    return false;
+  }
+
+  QFile file(info->filename);
+  if (!file.open(QFile::ReadOnly))
+  {
+    return false;
+  }
+  const qint64 file_size = file.size();
+  if (file_size < _tail_state.file_offset)
+  {
+    // the file shrank: it was truncated or replaced, our offset is meaningless
+    _tail_state.valid = false;
+    return false;
+  }
+  if (file_size == _tail_state.file_offset)
+  {
+    return true;  // nothing appended yet
+  }
+  if (!file.seek(_tail_state.file_offset))
+  {
+    return false;
+  }
+  QByteArray new_bytes = file.read(file_size - _tail_state.file_offset);
+  file.close();
+
+  // parse complete lines only; a torn trailing line stays pending
+  const int last_newline = new_bytes.lastIndexOf('\n');
+  if (last_newline < 0)
+  {
+    return true;
+  }
+  new_bytes.truncate(last_newline + 1);
+
+  // prepend the stored header, so that names, deduplication and the column
+  // count check behave exactly as in the initial load
+  std::string content = _tail_state.header_line;
+  content += '\n';
+  content.append(new_bytes.constData(), static_cast<size_t>(new_bytes.size()));
+
+  auto result = PJ::CSV::ParseCsvData(content, _tail_state.config);
+  if (!result.success)
+  {
+    _tail_state.valid = false;
+    return false;
+  }
+
+  // with row-number time, chunks restart from zero: shift by the samples
+  // loaded so far to keep the generated X axis monotonic
+  const bool row_number_time = _tail_state.config.time_column_index < 0 &&
+                               _tail_state.config.combined_column_index < 0;
+  const double time_offset = row_number_time ? double(_tail_state.samples_loaded) : 0.0;
+
+  appendResultToPlotData(result, _tail_state.config, time_offset, plot_data);
+
+  _tail_state.file_offset += last_newline + 1;
+  _tail_state.samples_loaded += result.lines_processed;
+  return true;
+}
+
 bool DataLoadCSV::xmlSaveState(QDomDocument& doc, QDomElement& parent_element) const
 {
   QDomElement elem = doc.createElement("parameters");
@@ -25,6 +25,13 @@ public:
   virtual bool readDataFromFile(PJ::FileLoadInfo* fileload_info,
                                 PlotDataMapRef& destination) override;
 
+  bool supportsTailFollow() const override
+  {
+    return true;
+  }
+
+  bool tailDataFromFile(PJ::FileLoadInfo* fileload_info, PlotDataMapRef& destination) override;
+
   virtual ~DataLoadCSV();
 
   virtual const char* name() const override
@@ -61,4 +68,21 @@ private:
   bool multiple_columns_warning_ = true;
 
   std::vector<PJ::CSV::CombinedColumnPair> _combined_columns;
+
+  /// Parse state kept after readDataFromFile() so that tailDataFromFile()
+  /// can resume from the first byte the recorder appended since.
+  struct TailState
+  {
+    bool valid = false;
+    QString filename;
+    qint64 file_offset = 0;          // first byte not parsed yet
+    std::string header_line;         // verbatim, without line terminator
+    PJ::CSV::CsvParseConfig config;  // with the detected types forced
+    int samples_loaded = 0;          // to continue row-number timestamps
+  };
+  TailState _tail_state;
+
+  void appendResultToPlotData(const PJ::CSV::CsvParseResult& result,
+                              const PJ::CSV::CsvParseConfig& config, double time_offset,
+                              PlotDataMapRef& plot_data);
 };
@@ -566,6 +566,52 @@ TEST(ParseCsvData, ScientificNotation)  // PR #1280
   EXPECT_DOUBLE_EQ(result.columns[0].numeric_points[3].second, 1e10);
 }
 
+TEST(ParseCsvData, ColumnProjection)
+{
+  std::string csv = "t,a,b,c\n0.0,1,2,3\n1.0,4,5,6\n";
+  CsvParseConfig config;
+  config.delimiter = ',';
+  config.time_column_index = 0;
+  config.selected_columns = { 1, 3 };
+
+  auto result = ParseCsvData(csv, config);
+  ASSERT_TRUE(result.success);
+  ASSERT_EQ(result.columns.size(), 4u);
+
+  // only "a" and "c" produce values; the time column is used for
+  // timestamps but is not selected, so it has no points either
+  EXPECT_EQ(result.columns[0].numeric_points.size(), 0u);
+  ASSERT_EQ(result.columns[1].numeric_points.size(), 2u);
+  EXPECT_EQ(result.columns[2].numeric_points.size(), 0u);
+  ASSERT_EQ(result.columns[3].numeric_points.size(), 2u);
+
+  EXPECT_DOUBLE_EQ(result.columns[1].numeric_points[0].first, 0.0);
+  EXPECT_DOUBLE_EQ(result.columns[1].numeric_points[0].second, 1.0);
+  EXPECT_DOUBLE_EQ(result.columns[3].numeric_points[1].first, 1.0);
+  EXPECT_DOUBLE_EQ(result.columns[3].numeric_points[1].second, 6.0);
+}
+
+TEST(ParseCsvData, ProjectionSkipsStringColumns)
+{
+  // the skipped column holds quoted strings with embedded delimiters:
+  // field boundaries must still be scanned correctly
+  std::string csv = "t,label,v\n0.0,\"hello, world\",10\n1.0,\"a,b,c\",20\n";
+  CsvParseConfig config;
+  config.delimiter = ',';
+  config.time_column_index = 0;
+  config.selected_columns = { 2 };
+
+  auto result = ParseCsvData(csv, config);
+  ASSERT_TRUE(result.success);
+  ASSERT_EQ(result.columns.size(), 3u);
+
+  EXPECT_EQ(result.columns[1].numeric_points.size(), 0u);
+  EXPECT_EQ(result.columns[1].string_points.size(), 0u);
+  ASSERT_EQ(result.columns[2].numeric_points.size(), 2u);
+  EXPECT_DOUBLE_EQ(result.columns[2].numeric_points[0].second, 10.0);
+  EXPECT_DOUBLE_EQ(result.columns[2].numeric_points[1].second, 20.0);
+}
+
 // ===========================================================================
 // DetectColumnType — DATE_ONLY / TIME_ONLY tests
 // ===========================================================================
@@ -925,3 +971,167 @@ TEST(ParseCsvData, TimestampColumnStartingAtZero)
   EXPECT_NEAR(result.columns[1].numeric_points[1].first, 0.003, 1e-9);
   EXPECT_NEAR(result.columns[1].numeric_points[2].first, 0.005, 1e-9);
 }
+
+// ===========================================================================
+// ParseCsvDataParallel tests
+// ===========================================================================
+
+TEST(ParseCsvDataParallel, EquivalentToSequential)
+{
+  // large enough to be split into multiple chunks (> 1 MB per chunk)
+  std::string csv = "time,alpha,beta\n";
+  for (int i = 0; i < 200000; i++)
+  {
+    csv += std::to_string(i * 0.01) + "," + std::to_string(i % 97) + "," +
+           std::to_string((i * 13) % 31) + "\n";
+  }
+
+  CsvParseConfig config;
+  config.time_column_index = 0;
+
+  auto seq = ParseCsvData(csv, config);
+  auto par = ParseCsvDataParallel(csv.data(), csv.size(), config);
+
+  ASSERT_TRUE(seq.success);
+  ASSERT_TRUE(par.success);
+  EXPECT_EQ(par.lines_processed, seq.lines_processed);
+  EXPECT_EQ(par.column_names, seq.column_names);
+  ASSERT_EQ(par.columns.size(), seq.columns.size());
+  for (size_t i = 0; i < seq.columns.size(); i++)
+  {
+    ASSERT_EQ(par.columns[i].numeric_points.size(), seq.columns[i].numeric_points.size());
+    EXPECT_EQ(par.columns[i].numeric_points, seq.columns[i].numeric_points);
+  }
+}
+
+TEST(ParseCsvDataParallel, RowNumberTimestampsContinueAcrossChunks)
+{
+  std::string csv = "a,b\n";
+  const int num_rows = 150000;
+  for (int i = 0; i < num_rows; i++)
+  {
+    csv += std::to_string(i) + "," + std::to_string(i * 2) + "\n";
+  }
+
+  CsvParseConfig config;  // no time column: row number is the timestamp
+
+  auto par = ParseCsvDataParallel(csv.data(), csv.size(), config);
+  ASSERT_TRUE(par.success);
+  ASSERT_EQ(par.columns[0].numeric_points.size(), static_cast<size_t>(num_rows));
+  for (int i = 0; i < num_rows; i += 10000)
+  {
+    EXPECT_DOUBLE_EQ(par.columns[0].numeric_points[i].first, static_cast<double>(i));
+  }
+}
+
+TEST(ParseCsvDataParallel, WarningLineNumbersMatchSequential)
+{
+  std::string csv = "time,val\n";
+  for (int i = 0; i < 120000; i++)
+  {
+    if (i % 40000 == 12345)
+    {
+      csv += "only_one_column\n";
+      continue;
+    }
+    csv += std::to_string(i * 0.1) + "," + std::to_string(i) + "\n";
+  }
+
+  CsvParseConfig config;
+  config.time_column_index = 0;
+
+  auto seq = ParseCsvData(csv, config);
+  auto par = ParseCsvDataParallel(csv.data(), csv.size(), config);
+
+  ASSERT_EQ(par.warnings.size(), seq.warnings.size());
+  for (size_t i = 0; i < seq.warnings.size(); i++)
+  {
+    EXPECT_EQ(par.warnings[i].type, seq.warnings[i].type);
+    EXPECT_EQ(par.warnings[i].line_number, seq.warnings[i].line_number);
+  }
+}
+
+TEST(ParseCsvDataParallel, SmallInputSingleChunk)
+{
+  std::string csv = "t,v\n1.0,10\n2.0,20\n";
+
+  CsvParseConfig config;
+  config.time_column_index = 0;
+
+  auto result = ParseCsvDataParallel(csv.data(), csv.size(), config);
+  ASSERT_TRUE(result.success);
+  EXPECT_EQ(result.lines_processed, 2);
+  ASSERT_EQ(result.columns[1].numeric_points.size(), 2u);
+  EXPECT_DOUBLE_EQ(result.columns[1].numeric_points[1].second, 20.0);
+}
+
+// ============================================================
+// DateTimeCache tests
+// ============================================================
+
+TEST(DateTimeCache, MatchesParseWithTypeAcrossRows)
+{
+  ColumnTypeInfo info = DetectColumnType("2024-01-15T10:00:00.123");
+  ASSERT_EQ(info.type, ColumnType::DATETIME);
+
+  DateTimeCache cache;
+  const char* rows[] = {
+    "2024-01-15T10:00:00.123",  // warms the cache
+    "2024-01-15T10:00:00.456",  // same base string, new fraction
+    "2024-01-15T10:00:01.000",  // same day, new second
+    "2024-01-15T23:59:59.999",  // same day, end of day
+    "2024-01-16T00:00:00.000",  // day rollover, prefix change
+    "2024-01-16T07:30:15.250",  // new day now cached
+  };
+  for (const char* row : rows)
+  {
+    auto cached = cache.Parse(row, info);
+    auto reference = ParseWithType(row, info);
+    ASSERT_TRUE(cached.has_value()) << row;
+    ASSERT_TRUE(reference.has_value()) << row;
+    EXPECT_DOUBLE_EQ(*cached, *reference) << row;
+  }
+}
+
+TEST(DateTimeCache, InvalidRowAfterWarmCache)
+{
+  ColumnTypeInfo info = DetectColumnType("2024-01-15 10:00:00");
+  ASSERT_EQ(info.type, ColumnType::DATETIME);
+
+  DateTimeCache cache;
+  ASSERT_TRUE(cache.Parse("2024-01-15 10:00:00", info).has_value());
+  EXPECT_FALSE(cache.Parse("2024-01-15 10:62:00", info).has_value());
+  EXPECT_FALSE(cache.Parse("garbage", info).has_value());
+
+  // cache still answers correctly afterwards
+  auto cached = cache.Parse("2024-01-15 10:05:00", info);
+  auto reference = ParseWithType("2024-01-15 10:05:00", info);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_DOUBLE_EQ(*cached, *reference);
+}
+
+TEST(DateTimeCache, NonDatetimeTypesPassThrough)
+{
+  ColumnTypeInfo info = DetectColumnType("3.14");
+  ASSERT_EQ(info.type, ColumnType::NUMBER);
+
+  DateTimeCache cache;
+  auto value = cache.Parse("3.14", info);
+  ASSERT_TRUE(value.has_value());
+  EXPECT_DOUBLE_EQ(*value, 3.14);
+}
+
+TEST(DateTimeCache, TimezoneFormatFallsBackToGeneralPath)
+{
+  ColumnTypeInfo info = DetectColumnType("2024-01-15T10:00:00+0200");
+  ASSERT_EQ(info.type, ColumnType::DATETIME);
+
+  DateTimeCache cache;
+  for (const char* row : { "2024-01-15T10:00:00+0200", "2024-01-15T10:00:01+0200" })
+  {
+    auto cached = cache.Parse(row, info);
+    auto reference = ParseWithType(row, info);
+    ASSERT_TRUE(cached.has_value()) << row;
+    EXPECT_DOUBLE_EQ(*cached, *reference) << row;
+  }
+}
@@ -1,6 +1,6 @@
 #include "timestamp_parsing.h"
-#include <QLocale>
-#include <QString>
+#include <PlotJuggler/util/fast_parse.hpp>
+#include <algorithm>
 
 namespace PJ::CSV
 {
@@ -18,14 +18,20 @@ std::string Trim(const std::string& str)
 
 std::optional<double> toDouble(const std::string& str)
 {
-  // If comma is used as decimal separator (European format), replace with dot
-  QString qstr = QString::fromStdString(str);
-  qstr.replace(',', '.');
+  // Locale-independent fast path ('.' as decimal separator)
+  if (auto value = FastParseDouble(str))
+  {
+    return value;
+  }
 
-  // Use QLocale::c() for locale-independent parsing (always uses '.' as decimal separator)
-  bool ok = false;
-  double value = QLocale::c().toDouble(qstr, &ok);
-  return ok ? std::optional<double>(value) : std::nullopt;
+  // If comma is used as decimal separator (European format), replace with dot
+  if (str.find(',') != std::string::npos)
+  {
+    std::string fixed = str;
+    std::replace(fixed.begin(), fixed.end(), ',', '.');
+    return FastParseDouble(fixed);
+  }
+  return std::nullopt;
 }
 
 // Common format strings used by multiple functions
@@ -601,6 +607,104 @@ std::optional<double> ParseWithType(const std::string& str, const ColumnTypeInfo
   }
 }
 
+// Helper: decode a strict "HH:MM:SS" suffix into seconds since midnight
+static std::optional<int> DecodeTimeOfDay(const char* t)
+{
+  if (t[2] != ':' || t[5] != ':')
+  {
+    return std::nullopt;
+  }
+  for (size_t i : { 0, 1, 3, 4, 6, 7 })
+  {
+    if (!std::isdigit(static_cast<unsigned char>(t[i])))
+    {
+      return std::nullopt;
+    }
+  }
+  const int hours = (t[0] - '0') * 10 + (t[1] - '0');
+  const int minutes = (t[3] - '0') * 10 + (t[4] - '0');
+  const int seconds = (t[6] - '0') * 10 + (t[7] - '0');
+  if (hours > 23 || minutes > 59 || seconds > 59)
+  {
+    return std::nullopt;
+  }
+  return hours * 3600 + minutes * 60 + seconds;
+}
+
+std::optional<double> DateTimeCache::Parse(const std::string& str,
+                                           const ColumnTypeInfo& type_info)
+{
+  if (type_info.type != ColumnType::DATETIME)
+  {
+    return ParseWithType(str, type_info);
+  }
+
+  std::string trimmed = Trim(str);
+  if (trimmed.empty())
+  {
+    return std::nullopt;
+  }
+
+  auto [base_str, fractional_ns] = ExtractFractionalSeconds(trimmed);
+  if (!type_info.has_fractional)
+  {
+    fractional_ns = std::chrono::nanoseconds{ 0 };
+  }
+  auto toSeconds = [](int64_t base_ns, std::chrono::nanoseconds frac) {
+    return std::chrono::duration<double>(std::chrono::nanoseconds{ base_ns } + frac).count();
+  };
+
+  // Same base string as the previous row: only the fractional part changed
+  if (base_str == _last_base)
+  {
+    return toSeconds(_last_ns, fractional_ns);
+  }
+
+  // The prefix cache only applies to formats where the time of day is a
+  // trailing "HH:MM:SS" (all detected formats except the %z / Z variants)
+  const std::string& fmt = type_info.format;
+  const bool time_is_suffix = fmt.size() >= 8 && fmt.compare(fmt.size() - 8, 8, "%H:%M:%S") == 0;
+
+  if (time_is_suffix && base_str.size() > 8)
+  {
+    const size_t prefix_len = base_str.size() - 8;
+    if (_prefix_valid && _cached_prefix.size() == prefix_len &&
+        base_str.compare(0, prefix_len, _cached_prefix) == 0)
+    {
+      if (auto tod = DecodeTimeOfDay(base_str.data() + prefix_len))
+      {
+        _last_base = std::move(base_str);
+        _last_ns = _midnight_ns + int64_t(*tod) * 1000000000LL;
+        return toSeconds(_last_ns, fractional_ns);
+      }
+    }
+  }
+
+  // General path; refresh the caches on success. TryParseFormat with a zero
+  // fractional part returns whole seconds, exactly representable as double.
+  auto full = TryParseFormat(base_str, fmt.c_str(), std::chrono::nanoseconds{ 0 });
+  if (!full)
+  {
+    return std::nullopt;
+  }
+  const int64_t full_ns = int64_t(*full) * 1000000000LL;
+
+  if (time_is_suffix && base_str.size() > 8)
+  {
+    const size_t prefix_len = base_str.size() - 8;
+    if (auto tod = DecodeTimeOfDay(base_str.data() + prefix_len))
+    {
+      _cached_prefix = base_str.substr(0, prefix_len);
+      _midnight_ns = full_ns - int64_t(*tod) * 1000000000LL;
+      _prefix_valid = true;
+    }
+  }
+
+  _last_base = std::move(base_str);
+  _last_ns = full_ns;
+  return toSeconds(_last_ns, fractional_ns);
+}
+
 std::optional<double> ParseCombinedDateTime(const std::string& date_str,
                                             const std::string& time_str,
                                             const ColumnTypeInfo& date_info,
@@ -133,6 +133,34 @@ ColumnTypeInfo DetectColumnType(const std::string& str);
  */
 std::optional<double> ParseWithType(const std::string& str, const ColumnTypeInfo& type_info);
 
+/**
+ * @brief Incremental parser for DATETIME columns.
+ *
+ * Consecutive rows of a log usually share the same date (and often the same
+ * second). This class caches two things across calls:
+ *
+ * - the epoch value of the last parsed base string, reused verbatim when only
+ *   the fractional part changes;
+ * - the midnight epoch of the current date prefix, so that rows on the same
+ *   day only need the "HH:MM:SS" suffix to be decoded arithmetically.
+ *
+ * When the prefix changes (day rollover) or the input does not match the
+ * expected layout, it falls back to the general ParseWithType() path and
+ * refreshes the cache. Results are identical to ParseWithType().
+ */
+class DateTimeCache
+{
+public:
+  std::optional<double> Parse(const std::string& str, const ColumnTypeInfo& type_info);
+
+private:
+  std::string _last_base;         // last successfully parsed base string
+  int64_t _last_ns = 0;           // epoch nanoseconds of _last_base
+  std::string _cached_prefix;     // date prefix preceding the "HH:MM:SS" suffix
+  int64_t _midnight_ns = 0;       // epoch nanoseconds at 00:00:00 of _cached_prefix
+  bool _prefix_valid = false;
+};
+
 /**
  * @brief Parse a combined date + time string pair into a single timestamp.
  *
@@ -1,6 +1,8 @@
 #include "dataload_mcap.h"
 
 #include "PlotJuggler/messageparser_base.h"
+#include "PlotJuggler/util/readahead_file.hpp"
+#include "PlotJuggler/util/remote_file.hpp"
 
 #include "mcap/reader.hpp"
 #include "mcap/internal.hpp"
@@ -11,30 +13,102 @@
 #include <QMessageBox>
 #include <QDebug>
 #include <QSettings>
-#include <QProgressDialog>
 #include <QDateTime>
 #include <QInputDialog>
 #include <QPushButton>
 #include <QElapsedTimer>
 #include <QStandardItemModel>
+#include <QThread>
 #include <QtConcurrent>
 
+#include <algorithm>
+#include <deque>
+#include <memory>
 #include <set>
 
 namespace
 {
 
+// Adapts PJ::RemoteFileReader to the reader interface of the mcap
+// library, so a file on S3/MinIO can be opened in place: the summary
+// reads and chunk seeks below translate into HTTP range requests and
+// only the chunks of the selected topics are ever downloaded.
+class RemoteMcapReadable : public mcap::IReadable
+{
+public:
+  explicit RemoteMcapReadable(const QString& url) : _remote(url)
+  {
+  }
+
+  bool open(QString* error)
+  {
+    return _remote.open(error);
+  }
+
+  uint64_t size() const override
+  {
+    return _remote.size();
+  }
+
+  uint64_t read(std::byte** output, uint64_t offset, uint64_t size) override
+  {
+    _buffer.resize(size_t(size));
+    const uint64_t copied =
+        _remote.read(offset, reinterpret_cast<uint8_t*>(_buffer.data()), size);
+    *output = _buffer.data();
+    return copied;
+  }
+
+private:
+  PJ::RemoteFileReader _remote;
+  std::vector<std::byte> _buffer;  // must outlive the read, per IReadable
+};
+
+// Same adapter over PJ::ReadaheadFileReader for files on disk: a
+// background thread keeps a few blocks in flight ahead of the parse
+// loop, so on a network filesystem (or a cold page cache) the next
+// chunk is already being fetched while the current one is decompressed
+// and parsed.
+class LocalMcapReadable : public mcap::IReadable
+{
+public:
+  bool open(const std::string& path, std::string* error)
+  {
+    return _file.open(path, error);
+  }
+
+  uint64_t size() const override
+  {
+    return _file.size();
+  }
+
+  uint64_t read(std::byte** output, uint64_t offset, uint64_t size) override
+  {
+    _buffer.resize(size_t(size));
+    const uint64_t copied =
+        _file.read(offset, reinterpret_cast<uint8_t*>(_buffer.data()), size);
+    *output = _buffer.data();
+    return copied;
+  }
+
+private:
+  PJ::ReadaheadFileReader _file;
+  std::vector<std::byte> _buffer;  // must outlive the read, per IReadable
+};
+
 struct McapSummaryInfo
 {
   std::unordered_map<mcap::SchemaId, mcap::SchemaPtr> schemas;
   std::unordered_map<mcap::ChannelId, mcap::ChannelPtr> channels;
+  std::vector<mcap::ChunkIndex> chunk_indexes;
   std::optional<mcap::Statistics> statistics;
   mcap::ByteOffset summaryStart = 0;
 };
 
-// Reads only Schema, Channel, and Statistics records from the MCAP summary
-// by using SummaryOffset entries to seek directly to each group, skipping
-// expensive MessageIndex and ChunkIndex data.
+// Reads only Schema, Channel, ChunkIndex and Statistics records from the
+// MCAP summary by using SummaryOffset entries to seek directly to each
+// group, skipping expensive MessageIndex data. The chunk indexes let the
+// loader skip chunks that contain none of the selected channels.
 mcap::Status readSelectiveSummary(mcap::IReadable& reader, McapSummaryInfo& info)
 {
   const uint64_t fileSize = reader.size();
@@ -55,14 +129,49 @@ mcap::Status readSelectiveSummary(mcap::IReadable& reader, McapSummaryInfo& info
 
   info.summaryStart = footer.summaryStart;
 
-  const mcap::ByteOffset summaryOffsetStart = footer.summaryOffsetStart != 0 ?
-                                                  footer.summaryOffsetStart :
-                                                  fileSize - mcap::internal::FooterLength;
+  const mcap::ByteOffset summaryEnd = fileSize - mcap::internal::FooterLength;
+  const mcap::ByteOffset summaryOffsetStart =
+      footer.summaryOffsetStart != 0 ? footer.summaryOffsetStart : summaryEnd;
 
-  if (summaryOffsetStart <= footer.summaryStart)
-  {
-    return mcap::Status{ mcap::StatusCode::InvalidFooter, "no SummaryOffset section available" };
-  }
+  auto collectRecord = [&info](const mcap::Record& record) {
+    switch (record.opcode)
+    {
+      case mcap::OpCode::Schema: {
+        auto ptr = std::make_shared<mcap::Schema>();
+        if (mcap::McapReader::ParseSchema(record, ptr.get()).ok())
+        {
+          info.schemas.try_emplace(ptr->id, ptr);
+        }
+        break;
+      }
+      case mcap::OpCode::Channel: {
+        auto ptr = std::make_shared<mcap::Channel>();
+        if (mcap::McapReader::ParseChannel(record, ptr.get()).ok())
+        {
+          info.channels.try_emplace(ptr->id, ptr);
+        }
+        break;
+      }
+      case mcap::OpCode::ChunkIndex: {
+        mcap::ChunkIndex chunk_index;
+        if (mcap::McapReader::ParseChunkIndex(record, &chunk_index).ok())
+        {
+          info.chunk_indexes.push_back(std::move(chunk_index));
+        }
+        break;
+      }
+      case mcap::OpCode::Statistics: {
+        mcap::Statistics stats;
+        if (mcap::McapReader::ParseStatistics(record, &stats).ok())
+        {
+          info.statistics = stats;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  };
 
   // 2. Read the SummaryOffset section to find group byte ranges
   struct GroupRange
@@ -70,104 +179,54 @@ mcap::Status readSelectiveSummary(mcap::IReadable& reader, McapSummaryInfo& info
     mcap::ByteOffset start = 0;
     mcap::ByteOffset end = 0;
   };
-  GroupRange schemaRange, channelRange, statsRange;
-  bool foundAny = false;
-
-  mcap::RecordReader offsetReader(reader, summaryOffsetStart,
-                                  fileSize - mcap::internal::FooterLength);
-  while (auto record = offsetReader.next())
-  {
-    if (record->opcode != mcap::OpCode::SummaryOffset)
-    {
-      continue;
-    }
-    mcap::SummaryOffset so;
-    if (!mcap::McapReader::ParseSummaryOffset(*record, &so).ok())
-    {
-      continue;
-    }
-    if (so.groupOpCode == mcap::OpCode::Schema)
-    {
-      schemaRange = { so.groupStart, so.groupStart + so.groupLength };
-      foundAny = true;
-    }
-    else if (so.groupOpCode == mcap::OpCode::Channel)
-    {
-      channelRange = { so.groupStart, so.groupStart + so.groupLength };
-      foundAny = true;
-    }
-    else if (so.groupOpCode == mcap::OpCode::Statistics)
-    {
-      statsRange = { so.groupStart, so.groupStart + so.groupLength };
-      foundAny = true;
-    }
-  }
-
-  if (!foundAny)
-  {
-    return mcap::Status{ mcap::StatusCode::MissingStatistics,
-                         "no relevant SummaryOffset records found" };
-  }
+  std::vector<GroupRange> group_ranges;
 
-  // 3. Read each targeted group
-  if (schemaRange.start != 0)
+  if (summaryOffsetStart > footer.summaryStart && summaryOffsetStart < summaryEnd)
   {
-    mcap::RecordReader rdr(reader, schemaRange.start, schemaRange.end);
-    while (auto record = rdr.next())
+    mcap::RecordReader offsetReader(reader, summaryOffsetStart, summaryEnd);
+    while (auto record = offsetReader.next())
     {
-      if (record->opcode != mcap::OpCode::Schema)
+      if (record->opcode != mcap::OpCode::SummaryOffset)
       {
         continue;
       }
-      auto ptr = std::make_shared<mcap::Schema>();
-      if (mcap::McapReader::ParseSchema(*record, ptr.get()).ok())
-      {
-        info.schemas.try_emplace(ptr->id, ptr);
-      }
-    }
-  }
-
-  if (channelRange.start != 0)
-  {
-    mcap::RecordReader rdr(reader, channelRange.start, channelRange.end);
-    while (auto record = rdr.next())
-    {
-      if (record->opcode != mcap::OpCode::Channel)
+      mcap::SummaryOffset so;
+      if (!mcap::McapReader::ParseSummaryOffset(*record, &so).ok())
       {
         continue;
       }
-      auto ptr = std::make_shared<mcap::Channel>();
-      if (mcap::McapReader::ParseChannel(*record, ptr.get()).ok())
+      if (so.groupOpCode == mcap::OpCode::Schema || so.groupOpCode == mcap::OpCode::Channel ||
+          so.groupOpCode == mcap::OpCode::Statistics || so.groupOpCode == mcap::OpCode::ChunkIndex)
       {
-        info.channels.try_emplace(ptr->id, ptr);
+        group_ranges.push_back({ so.groupStart, so.groupStart + so.groupLength });
       }
     }
   }
 
-  if (statsRange.start != 0)
+  // 3. Read each targeted group; when the writer emitted no SummaryOffset
+  // section, read the whole summary section instead. It holds no message
+  // data, so this is still a single small linear read.
+  if (group_ranges.empty())
   {
-    mcap::RecordReader rdr(reader, statsRange.start, statsRange.end);
+    group_ranges.push_back({ footer.summaryStart, summaryOffsetStart });
+  }
+
+  for (const auto& range : group_ranges)
+  {
+    mcap::RecordReader rdr(reader, range.start, range.end);
     while (auto record = rdr.next())
     {
-      if (record->opcode != mcap::OpCode::Statistics)
-      {
-        continue;
-      }
-      mcap::Statistics stats;
-      if (mcap::McapReader::ParseStatistics(*record, &stats).ok())
-      {
-        info.statistics = stats;
-        break;  // only one Statistics record expected
-      }
+      collectRecord(*record);
     }
   }
 
-  if (!info.statistics)
+  if (info.channels.empty())
   {
-    return mcap::Status{ mcap::StatusCode::MissingStatistics,
-                         "Statistics record not found in summary" };
+    return mcap::Status{ mcap::StatusCode::MissingStatistics, "no Channel records in the summary" };
   }
 
+  // a missing Statistics record is tolerated: the dialog simply hides the
+  // message-count column
   return mcap::StatusCode::Success;
 }
 
@@ -230,9 +289,38 @@ bool DataLoadMCAP::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_dat
     throw std::runtime_error("No parsing available");
   }
 
-  // open file
+  // open file, either on disk (with readahead) or remote through HTTP
+  // range requests. Both adapters must outlive the reader.
+  std::unique_ptr<RemoteMcapReadable> remote_file;
+  std::unique_ptr<LocalMcapReadable> local_file;
   mcap::McapReader reader;
-  auto status = reader.open(info->filename.toStdString());
+  mcap::Status status;
+  if (PJ::RemoteFileReader::IsRemoteUrl(info->filename))
+  {
+    remote_file = std::make_unique<RemoteMcapReadable>(info->filename);
+    QString error;
+    if (!remote_file->open(&error))
+    {
+      QMessageBox::warning(nullptr, "Can't open remote file",
+                           tr("URL: %0\n Message: %1").arg(info->filename).arg(error));
+      return false;
+    }
+    status = reader.open(*remote_file);
+  }
+  else
+  {
+    local_file = std::make_unique<LocalMcapReadable>();
+    std::string error;
+    if (!local_file->open(info->filename.toStdString(), &error))
+    {
+      QMessageBox::warning(nullptr, "Can't open file",
+                           tr("File: %0\n Message: %1")
+                               .arg(info->filename)
+                               .arg(QString::fromStdString(error)));
+      return false;
+    }
+    status = reader.open(*local_file);
+  }
   if (!status.ok())
   {
     QMessageBox::warning(nullptr, "Can't open file",
@@ -244,8 +332,9 @@ bool DataLoadMCAP::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_dat
 
   // --- Read summary information (schemas, channels, statistics) ---
   // Try selective read first (reads only Schema/Channel/Statistics via SummaryOffset,
-  // skipping expensive MessageIndex and ChunkIndex data).
-  // Falls back to full readSummary() for files without a SummaryOffset section.
+  // skipping expensive MessageIndex data; without a SummaryOffset section the whole
+  // summary section is read, which is still small and seekable in O(1)).
+  // Falls back to readSummary() only for files with no summary at all.
   McapSummaryInfo summaryInfo;
   bool usedSelectiveSummary = false;
   status = readSelectiveSummary(*reader.dataSource(), summaryInfo);
@@ -272,11 +361,12 @@ bool DataLoadMCAP::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_dat
     {
       summaryInfo.channels.insert({ id, ptr });
     }
+    summaryInfo.chunk_indexes = reader.chunkIndexes();
     summaryInfo.statistics = reader.statistics();
   }
 
   plot_data.addUserDefined("plotjuggler::mcap::file_path")
-      ->second.pushBack({ 0, std::any(info->filename.toStdString()) });
+      ->second.pushBack({ 0, PJ::AnyValue(info->filename.toStdString()) });
 
   const auto& statistics = summaryInfo.statistics;
 
@@ -359,7 +449,10 @@ bool DataLoadMCAP::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_dat
     if (schema->name == "data_tamer_msgs/msg/Schemas")
     {
       channels_containing_datatamer_schema.insert(channel_id);
-      total_dt_schemas += statistics->channelMessageCounts.at(channel_id);
+      if (statistics && statistics->channelMessageCounts.count(channel_id) != 0)
+      {
+        total_dt_schemas += statistics->channelMessageCounts.at(channel_id);
+      }
     }
     if (schema->name == "data_tamer_msgs/msg/Snapshot")
     {
@@ -439,7 +532,7 @@ bool DataLoadMCAP::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_dat
     {
       enabled_channels.insert(channel_id);
       auto mcap_channel = channels[channel_id]->id;
-      if (statistics->channelMessageCounts.count(mcap_channel) != 0)
+      if (statistics && statistics->channelMessageCounts.count(mcap_channel) != 0)
       {
         total_msgs += statistics->channelMessageCounts.at(channel_id);
       }
@@ -449,71 +542,225 @@ bool DataLoadMCAP::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_dat
   //-------------------------------------------
   //---------------- Parse messages -----------
 
-  auto onProblem = [](const mcap::Status& problem) {
-    qDebug() << QString::fromStdString(problem.message);
-  };
-
-  // When selective summary was used, readSummary() was not called, so
-  // reader.dataEnd_ still includes the summary section. Construct
-  // LinearMessageView with explicit byte range to avoid reading expensive
-  // summary records during iteration.
-  auto createMessageView = [&]() -> mcap::LinearMessageView {
-    if (usedSelectiveSummary)
-    {
-      auto [dataStart, dataEndUnused] = reader.byteRange(0);
-      return mcap::LinearMessageView(reader, dataStart, summaryInfo.summaryStart, 0, mcap::MaxTime,
-                                     onProblem);
-    }
-    return reader.readMessages(onProblem);
-  };
-
-  auto messages = createMessageView();
+  // Chunks are independent: decompress them concurrently on the global
+  // thread pool while this (GUI) thread consumes the decoded chunks in
+  // file order and feeds the single-threaded parsers. Decompression is
+  // where most of the wall time goes with lz4/zstd files.
 
-  QProgressDialog progress_dialog("Loading... please wait", "Cancel", 0, 0, nullptr);
-  progress_dialog.setWindowTitle("Loading the MCAP file");
-  progress_dialog.setWindowModality(Qt::ApplicationModal);
-  progress_dialog.setRange(0, std::max<size_t>(total_msgs, 1) - 1);
-  progress_dialog.show();
-  progress_dialog.setValue(0);
+  // When selective summary was used, readSummary() was not called, so the
+  // reader's data range still includes the summary section: clamp it.
+  mcap::ByteOffset data_start = 0;
+  mcap::ByteOffset data_end = 0;
+  {
+    auto range = reader.byteRange(0);
+    data_start = range.first;
+    data_end = usedSelectiveSummary ? summaryInfo.summaryStart : range.second;
+  }
 
   size_t msg_count = 0;
+  bool canceled = false;
 
   auto new_progress_update = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
 
-  for (const auto& msg_view : messages)
-  {
-    if (enabled_channels.count(msg_view.channel->id) == 0)
+  auto parseMessageRecord = [&](const mcap::Record& record) {
+    mcap::Message message;
+    if (!mcap::McapReader::ParseMessage(record, &message).ok())
     {
-      continue;
+      return;
+    }
+    if (enabled_channels.count(message.channelId) == 0)
+    {
+      return;
     }
-
     // MCAP always represents publishTime in nanoseconds
-    double timestamp_sec = double(msg_view.message.publishTime) * 1e-9;
+    double timestamp_sec = double(message.publishTime) * 1e-9;
     if (_dialog_parameters->use_mcap_log_time)
     {
-      timestamp_sec = double(msg_view.message.logTime) * 1e-9;
+      timestamp_sec = double(message.logTime) * 1e-9;
     }
-    auto parser_it = parsers_by_channel.find(msg_view.channel->id);
+    auto parser_it = parsers_by_channel.find(message.channelId);
     if (parser_it == parsers_by_channel.end())
     {
-      qDebug() << "Skipping channeld id: " << msg_view.channel->id;
-      continue;
+      qDebug() << "Skipping channeld id: " << message.channelId;
+      return;
     }
 
-    auto parser = parser_it->second;
-    MessageRef msg(msg_view.message.data, msg_view.message.dataSize);
-    parser->parseMessage(msg, timestamp_sec);
+    MessageRef msg(message.data, message.dataSize);
+    parser_it->second->parseMessage(msg, timestamp_sec);
 
     if (msg_count++ % 100 == 0 && std::chrono::steady_clock::now() > new_progress_update)
     {
       new_progress_update += std::chrono::milliseconds(500);
-      progress_dialog.setValue(msg_count);
-      QApplication::processEvents();
-      if (progress_dialog.wasCanceled())
+      // total_msgs is 0 when the file has no Statistics record
+      const double fraction =
+          (total_msgs > 0) ? double(msg_count) / double(total_msgs) : -1.0;
+      if (!notifyProgress(fraction))
+      {
+        // keep the messages parsed so far: a partial prefix of an MCAP
+        // file is still a consistent set of series
+        canceled = true;
+      }
+    }
+  };
+
+  mcap::BufferReader decoded_reader;
+  auto parseChunkRecords = [&](const mcap::ByteArray& records) {
+    decoded_reader.reset(records.data(), records.size(), records.size());
+    mcap::RecordReader record_reader(decoded_reader, 0, records.size());
+    while (auto record = record_reader.next())
+    {
+      if (record->opcode == mcap::OpCode::Message)
       {
+        parseMessageRecord(*record);
+        if (canceled)
+        {
+          return;
+        }
+      }
+    }
+  };
+
+  struct DecodedChunk
+  {
+    mcap::ByteArray records;
+    bool ok = false;
+    std::string compression;
+  };
+
+  auto decompressChunk = [](mcap::Chunk header,
+                            std::shared_ptr<mcap::ByteArray> compressed) -> DecodedChunk {
+    DecodedChunk out;
+    out.compression = header.compression;
+    if (header.compression.empty())
+    {
+      out.records = std::move(*compressed);
+      out.ok = true;
+    }
+    else if (header.compression == "zstd")
+    {
+      out.ok = mcap::ZStdReader::DecompressAll(compressed->data(), compressed->size(),
+                                               header.uncompressedSize, &out.records)
+                   .ok();
+    }
+    else if (header.compression == "lz4")
+    {
+      mcap::LZ4Reader lz4;
+      out.ok = lz4.decompressAll(compressed->data(), compressed->size(), header.uncompressedSize,
+                                 &out.records)
+                   .ok();
+    }
+    return out;
+  };
+
+  // in-flight chunks, consumed in submission (i.e. file) order
+  const size_t max_in_flight = size_t(std::max(2, QThread::idealThreadCount())) * 2;
+  std::deque<QFuture<DecodedChunk>> in_flight;
+
+  auto drainOne = [&]() {
+    DecodedChunk decoded = in_flight.front().result();
+    in_flight.pop_front();
+    if (!decoded.ok)
+    {
+      qDebug() << "Failed to decompress chunk with compression: "
+               << QString::fromStdString(decoded.compression);
+      return;
+    }
+    if (!canceled)
+    {
+      parseChunkRecords(decoded.records);
+    }
+  };
+
+  auto submitChunk = [&](const mcap::Record& record) {
+    mcap::Chunk chunk;
+    if (!mcap::McapReader::ParseChunk(record, &chunk).ok())
+    {
+      return;
+    }
+    // the record buffer is reused by next(): copy the compressed payload
+    auto compressed =
+        std::make_shared<mcap::ByteArray>(chunk.records, chunk.records + chunk.compressedSize);
+    in_flight.push_back(QtConcurrent::run(decompressChunk, chunk, std::move(compressed)));
+    if (in_flight.size() >= max_in_flight)
+    {
+      drainOne();
+    }
+  };
+
+  // A chunk whose message index references none of the enabled channels can
+  // be skipped entirely: its bytes are never read, let alone decompressed.
+  // Chunks with an empty index are conservatively kept.
+  std::vector<const mcap::ChunkIndex*> relevant_chunks;
+  for (const auto& chunk_index : summaryInfo.chunk_indexes)
+  {
+    bool relevant = chunk_index.messageIndexOffsets.empty();
+    for (const auto& [channel_id, unused_offset] : chunk_index.messageIndexOffsets)
+    {
+      if (enabled_channels.count(channel_id) != 0)
+      {
+        relevant = true;
         break;
       }
     }
+    if (relevant)
+    {
+      relevant_chunks.push_back(&chunk_index);
+    }
+  }
+
+  if (!summaryInfo.chunk_indexes.empty())
+  {
+    // Indexed files keep all messages inside chunks: seek straight to the
+    // relevant ones, in file order.
+    std::sort(relevant_chunks.begin(), relevant_chunks.end(),
+              [](const mcap::ChunkIndex* a, const mcap::ChunkIndex* b) {
+                return a->chunkStartOffset < b->chunkStartOffset;
+              });
+    for (const auto* chunk_index : relevant_chunks)
+    {
+      if (canceled)
+      {
+        break;
+      }
+      mcap::RecordReader chunk_reader(*reader.dataSource(), chunk_index->chunkStartOffset,
+                                      chunk_index->chunkStartOffset + chunk_index->chunkLength);
+      auto record = chunk_reader.next();
+      if (record && record->opcode == mcap::OpCode::Chunk)
+      {
+        submitChunk(*record);
+      }
+    }
+  }
+  else
+  {
+    mcap::RecordReader data_reader(*reader.dataSource(), data_start, data_end);
+    while (!canceled)
+    {
+      auto record = data_reader.next();
+      if (!record)
+      {
+        break;
+      }
+      if (record->opcode == mcap::OpCode::Chunk)
+      {
+        submitChunk(*record);
+      }
+      else if (record->opcode == mcap::OpCode::Message)
+      {
+        // message outside any chunk: preserve file order
+        while (!in_flight.empty() && !canceled)
+        {
+          drainOne();
+        }
+        parseMessageRecord(*record);
+      }
+    }
+  }
+
+  // always collect pending futures, even when canceled
+  while (!in_flight.empty())
+  {
+    drainOne();
   }
 
   reader.close();
@@ -1,18 +1,20 @@
 #include "dataload_parquet.h"
 #include <arrow/type_fwd.h>
+#include <parquet/statistics.h>
 #include <QTextStream>
 #include <QFile>
 #include <QMessageBox>
 #include <QDebug>
 #include <QSettings>
-#include <QProgressDialog>
 #include <QDateTime>
 #include <QInputDialog>
 #include <QListWidget>
 #include <QSet>
 #include <QTimeZone>
+#include <QtConcurrent>
 #include <cmath>
 #include <algorithm>
+#include <optional>
 
 namespace
 {
@@ -82,6 +84,13 @@ DataLoadParquet::DataLoadParquet()
   connect(ui->radioButtonIndex, &QRadioButton::toggled, this, [this](bool checked) {
     ui->buttonBox->setEnabled(checked);
     ui->listWidgetSeries->setEnabled(!checked);
+    // row-group pruning needs a timestamp column to read statistics from
+    ui->checkBoxTimeRange->setEnabled(!checked);
+  });
+
+  connect(ui->checkBoxTimeRange, &QCheckBox::toggled, this, [this](bool checked) {
+    ui->lineEditRangeMin->setEnabled(checked);
+    ui->lineEditRangeMax->setEnabled(checked);
   });
 
   QSettings settings;
@@ -110,6 +119,40 @@ const std::vector<const char*>& DataLoadParquet::compatibleFileExtensions() cons
   return extensions;
 }
 
+// raw timestamp value -> seconds, applying the unit and timezone of the
+// column type. Shared between the per-value decode and the row-group
+// statistics used for time-range pruning.
+static double timestamp_to_seconds(int64_t value, const arrow::TimestampType& timestamp_type)
+{
+  double seconds = 0;
+  switch (timestamp_type.unit())
+  {
+    case arrow::TimeUnit::SECOND:
+      seconds = static_cast<double>(value);
+      break;
+    case arrow::TimeUnit::MILLI:
+      seconds = static_cast<double>(value) / 1000.0;
+      break;
+    case arrow::TimeUnit::MICRO:
+      seconds = static_cast<double>(value) / 1000000.0;
+      break;
+    case arrow::TimeUnit::NANO:
+      seconds = static_cast<double>(value) / 1000000000.0;
+      break;
+  }
+  const std::string& timezone_str = timestamp_type.timezone();
+  if (!timezone_str.empty() && timezone_str != "UTC")
+  {
+    QTimeZone tz(QByteArray::fromStdString(timezone_str));
+    if (tz.isValid())
+    {
+      QDateTime utc_dt = QDateTime::fromSecsSinceEpoch(static_cast<qint64>(seconds));
+      seconds -= tz.offsetFromUtc(utc_dt);
+    }
+  }
+  return seconds;
+}
+
 template <typename ArrowType>
 double get_arrow_value(const std::shared_ptr<arrow::Array>& array, int64_t index)
 {
@@ -156,34 +199,7 @@ double get_arrow_value(const std::shared_ptr<arrow::Array>& array, int64_t index
       }
       const auto timestamp_type =
           std::static_pointer_cast<arrow::TimestampType>(timestamp_array->type());
-      const int64_t value = timestamp_array->Value(index);
-      double seconds = 0;
-      switch (timestamp_type->unit())
-      {
-        case arrow::TimeUnit::SECOND:
-          seconds = static_cast<double>(value);
-          break;
-        case arrow::TimeUnit::MILLI:
-          seconds = static_cast<double>(value) / 1000.0;
-          break;
-        case arrow::TimeUnit::MICRO:
-          seconds = static_cast<double>(value) / 1000000.0;
-          break;
-        case arrow::TimeUnit::NANO:
-          seconds = static_cast<double>(value) / 1000000000.0;
-          break;
-      }
-      const std::string& timezone_str = timestamp_type->timezone();
-      if (!timezone_str.empty() && timezone_str != "UTC")
-      {
-        QTimeZone tz(QByteArray::fromStdString(timezone_str));
-        if (tz.isValid())
-        {
-          QDateTime utc_dt = QDateTime::fromSecsSinceEpoch(static_cast<qint64>(seconds));
-          seconds -= tz.offsetFromUtc(utc_dt);
-        }
-      }
-      return seconds;
+      return timestamp_to_seconds(timestamp_array->Value(index), *timestamp_type);
     }
     default:
       break;
@@ -217,7 +233,6 @@ bool DataLoadParquet::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_
   std::shared_ptr<parquet::FileMetaData> file_metadata =
       arrow_file_reader->parquet_reader()->metadata();
   const auto schema = file_metadata->schema();
-  const int64_t total_rows = file_metadata->num_rows();
 
   struct ColumnInfo
   {
@@ -332,18 +347,133 @@ bool DataLoadParquet::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_
     }
   }
 
-  QProgressDialog progress_dialog;
-  progress_dialog.setWindowTitle("Loading the Parquet file");
-  progress_dialog.setLabelText("Loading... please wait");
-  progress_dialog.setWindowModality(Qt::ApplicationModal);
-  progress_dialog.setRange(0, columns_info.size());
-  progress_dialog.setAutoClose(true);
-  progress_dialog.setAutoReset(true);
-  progress_dialog.show();
+  //-----------------------------
+  // Time-range pruning: when the user restricted the time window, the
+  // row-group min/max statistics of the timestamp column tell us which
+  // row groups cannot contain any sample in it. Those are skipped before
+  // any decompression or decode happens, which is what makes opening an
+  // incident window out of a multi-GB file fast.
+  bool range_enabled = false;
+  double range_min = std::numeric_limits<double>::lowest();
+  double range_max = std::numeric_limits<double>::max();
+
+  if (ui->checkBoxTimeRange->isChecked() && timestamp_column >= 0)
+  {
+    bool ok_min = false;
+    bool ok_max = false;
+    const double parsed_min = ui->lineEditRangeMin->text().toDouble(&ok_min);
+    const double parsed_max = ui->lineEditRangeMax->text().toDouble(&ok_max);
+    if (ok_min)
+    {
+      range_min = parsed_min;
+    }
+    if (ok_max)
+    {
+      range_max = parsed_max;
+    }
+    range_enabled = ok_min || ok_max;
+  }
+
+  // min/max of the timestamp chunk of one row group, converted to seconds
+  // exactly like the values themselves. nullopt when the writer stored no
+  // statistics or the type has an unreliable sort order (booleans,
+  // unsigned integers stored as signed).
+  auto chunkTimeRange =
+      [&](const parquet::RowGroupMetaData& rg_meta) -> std::optional<std::pair<double, double>> {
+    auto stats = rg_meta.ColumnChunk(timestamp_column)->statistics();
+    if (!stats || !stats->HasMinMax())
+    {
+      return std::nullopt;
+    }
+    double stat_min = 0;
+    double stat_max = 0;
+    switch (timestamp_arrow_type)
+    {
+      case arrow::Type::TIMESTAMP: {
+        auto typed = std::static_pointer_cast<parquet::Int64Statistics>(stats);
+        const auto& ts_type = static_cast<const arrow::TimestampType&>(
+            *arrow_schema->field(timestamp_column)->type());
+        stat_min = timestamp_to_seconds(typed->min(), ts_type);
+        stat_max = timestamp_to_seconds(typed->max(), ts_type);
+        break;
+      }
+      case arrow::Type::INT64: {
+        auto typed = std::static_pointer_cast<parquet::Int64Statistics>(stats);
+        stat_min = static_cast<double>(typed->min());
+        stat_max = static_cast<double>(typed->max());
+        break;
+      }
+      case arrow::Type::INT8:
+      case arrow::Type::INT16:
+      case arrow::Type::INT32: {
+        auto typed = std::static_pointer_cast<parquet::Int32Statistics>(stats);
+        stat_min = static_cast<double>(typed->min());
+        stat_max = static_cast<double>(typed->max());
+        break;
+      }
+      case arrow::Type::FLOAT: {
+        auto typed = std::static_pointer_cast<parquet::FloatStatistics>(stats);
+        stat_min = static_cast<double>(typed->min());
+        stat_max = static_cast<double>(typed->max());
+        break;
+      }
+      case arrow::Type::DOUBLE: {
+        auto typed = std::static_pointer_cast<parquet::DoubleStatistics>(stats);
+        stat_min = typed->min();
+        stat_max = typed->max();
+        break;
+      }
+      default:
+        return std::nullopt;
+    }
+    return std::make_pair(std::min(stat_min, stat_max), std::max(stat_min, stat_max));
+  };
+
+  std::vector<int> row_groups_to_read;
+  row_groups_to_read.reserve(file_metadata->num_row_groups());
+  int64_t rows_to_read = 0;
+  int64_t bytes_to_read = 0;
+  int64_t bytes_skipped = 0;
+
+  for (int rg = 0; rg < file_metadata->num_row_groups(); rg++)
+  {
+    auto rg_meta = file_metadata->RowGroup(rg);
+    bool keep = true;
+    if (range_enabled)
+    {
+      if (auto rg_range = chunkTimeRange(*rg_meta))
+      {
+        keep = !(rg_range->second < range_min || rg_range->first > range_max);
+      }
+      // without statistics the row group must be read: pruning may never
+      // drop data it cannot rule out
+    }
+    if (keep)
+    {
+      row_groups_to_read.push_back(rg);
+      rows_to_read += rg_meta->num_rows();
+      bytes_to_read += rg_meta->total_compressed_size();
+    }
+    else
+    {
+      bytes_skipped += rg_meta->total_compressed_size();
+    }
+  }
+
+  if (range_enabled)
+  {
+    const auto toMB = [](int64_t bytes) { return double(bytes) / (1024.0 * 1024.0); };
+    qDebug() << QString("Reading %1 of %2 row groups (%3 MB), "
+                        "skipped %4 MB outside the time range")
+                    .arg(row_groups_to_read.size())
+                    .arg(file_metadata->num_row_groups())
+                    .arg(toMB(bytes_to_read), 0, 'f', 1)
+                    .arg(toMB(bytes_skipped), 0, 'f', 1);
+  }
 
   // Create RecordBatchReader for efficient batch processing
   std::shared_ptr<arrow::RecordBatchReader> batch_reader;
-  status = arrow_file_reader->GetRecordBatchReader(&batch_reader);
+  status = arrow_file_reader->GetRecordBatchReader(row_groups_to_read, &batch_reader);
   if (!status.ok())
   {
     throw std::runtime_error("Failed to create RecordBatchReader");
@@ -372,39 +502,50 @@ bool DataLoadParquet::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_
     std::sort(timestamp_to_row_index.begin(), timestamp_to_row_index.end(),
               [](const auto& a, const auto& b) { return a.first < b.first; });
 
-    int column = 0;
+    // Parquet is columnar: each column decodes independently and appends
+    // into its own series, so decode them concurrently on the thread pool.
+    // Timestamps are already sorted, making every append an O(1) push_back.
+    std::vector<QFuture<void>> column_jobs;
+    column_jobs.reserve(columns_info.size());
 
     for (const auto& info : columns_info)
     {
-      const auto values_array = batch->column(info.column_index);
-
-      for (int64_t row = 0; row < batch_rows; row++)
-      {
-        size_t ordered_row = row;
-        double timestamp = static_cast<double>(rows_processed + row);
-        if (timestamp_column >= 0)
-        {
-          timestamp = timestamp_to_row_index[row].first;
-          ordered_row = timestamp_to_row_index[row].second;
-        }
-        double value = get_arrow_value(values_array, ordered_row, info.arrow_type);
-        if (!std::isnan(value))
+      column_jobs.push_back(QtConcurrent::run([&, col = &info]() {
+        const auto values_array = batch->column(col->column_index);
+        for (int64_t row = 0; row < batch_rows; row++)
         {
-          info.plot_data->pushBack({ timestamp, value });
+          size_t ordered_row = row;
+          double timestamp = static_cast<double>(rows_processed + row);
+          if (timestamp_column >= 0)
+          {
+            timestamp = timestamp_to_row_index[row].first;
+            ordered_row = timestamp_to_row_index[row].second;
+          }
+          // row groups at the edges of the window straddle it: drop the
+          // rows outside, the statistics only prune whole groups
+          if (range_enabled && (timestamp < range_min || timestamp > range_max))
+          {
+            continue;
+          }
+          double value = get_arrow_value(values_array, ordered_row, col->arrow_type);
+          if (!std::isnan(value))
+          {
+            col->plot_data->pushBack({ timestamp, value });
+          }
         }
-      }
-
-      if (column++ % 10 == 0)
-      {
-        progress_dialog.setValue(column);
-        QApplication::processEvents();
-        if (progress_dialog.wasCanceled())
-        {
-          break;
-        }
-      }
+      }));
+    }
+    for (auto& job : column_jobs)
+    {
+      job.waitForFinished();
     }
+
     rows_processed += batch_rows;
+    // on cancel, keep the batches appended so far as a partial result
+    if (!notifyProgress(double(rows_processed) / double(std::max<int64_t>(1, rows_to_read))))
+    {
+      break;
+    }
   }
 
   return true;
@@ -0,0 +1,26 @@
+#include "dataload_session.h"
+
+#include <QMessageBox>
+
+#include "PlotJuggler/session_dump.h"
+
+const std::vector<const char*>& DataLoadSession::compatibleFileExtensions() const
+{
+  static std::vector<const char*> extensions = { "pjdata" };
+  return extensions;
+}
+
+bool DataLoadSession::readDataFromFile(PJ::FileLoadInfo* fileload_info,
+                                       PlotDataMapRef& destination)
+{
+  if (!LoadSessionDump(fileload_info->filename, destination))
+  {
+    QMessageBox::warning(nullptr, "Session snapshot",
+                         QString("Failed to load the session snapshot:\n%1\n"
+                                 "The file is corrupted or was written by an "
+                                 "incompatible version.")
+                             .arg(fileload_info->filename));
+    return false;
+  }
+  return true;
+}
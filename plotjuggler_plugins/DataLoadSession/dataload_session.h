@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QObject>
+#include <QtPlugin>
+#include "PlotJuggler/dataloader_base.h"
+
+using namespace PJ;
+
+/**
+ * Loader for the native ".pjdata" session snapshots written by
+ * SaveSessionDump() (see PlotJuggler/session_dump.h). There is nothing
+ * to parse or configure: the file already contains the series columns,
+ * so loading is essentially a bulk append.
+ */
+class DataLoadSession : public PJ::DataLoader
+{
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID "facontidavide.PlotJuggler3.DataLoader")
+  Q_INTERFACES(PJ::DataLoader)
+
+public:
+  DataLoadSession() = default;
+
+  const std::vector<const char*>& compatibleFileExtensions() const override;
+
+  bool readDataFromFile(PJ::FileLoadInfo* fileload_info, PlotDataMapRef& destination) override;
+
+  ~DataLoadSession() override = default;
+
+  const char* name() const override
+  {
+    return "DataLoad Session";
+  }
+};
@@ -6,6 +6,7 @@
 #include <QWidget>
 #include <QSettings>
 #include <QMainWindow>
+#include <algorithm>
 
 #include "ulog_parser.h"
 #include "ulog_parameters_dialog.h"
@@ -38,15 +39,42 @@ bool DataLoadULog::readDataFromFile(FileLoadInfo* fileload_info, PlotDataMapRef&
   {
     throw std::runtime_error("ULog: Failed to open file");
   }
-  QByteArray file_array = file.readAll();
-  ULogParser::DataStream datastream(file_array.data(), file_array.size());
+  // map the file instead of copying it: the parser decodes DATA messages
+  // directly from this buffer
+  size_t file_size = static_cast<size_t>(file.size());
+  const uchar* mapped = file.map(0, file.size());
+  QByteArray fallback_array;
+  const char* file_begin = reinterpret_cast<const char*>(mapped);
+  if (!mapped)
+  {
+    fallback_array = file.readAll();
+    file_begin = fallback_array.data();
+    file_size = static_cast<size_t>(fallback_array.size());
+  }
+  ULogParser::DataStream datastream(file_begin, file_size);
+
+  // the shared topic selection dialog already ran: decode only the
+  // subscriptions the user asked for
+  std::set<std::string> subscription_filter;
+  for (const auto& topic : fileload_info->selected_topics)
+  {
+    subscription_filter.insert(topic.toStdString());
+  }
 
-  ULogParser parser(datastream);
+  ULogParser parser(datastream, subscription_filter.empty() ? nullptr : &subscription_filter);
 
   const auto& timeseries_map = parser.getTimeseriesMap();
   auto min_msg_time = std::numeric_limits<double>::max();
+  size_t subscriptions_done = 0;
   for (const auto& it : timeseries_map)
   {
+    // the vendored parser has no callbacks, so cancellation takes
+    // effect between subscriptions, keeping the ones copied so far
+    if (!notifyProgress(double(subscriptions_done++) /
+                        double(std::max<size_t>(1, timeseries_map.size()))))
+    {
+      break;
+    }
     const std::string& sucsctiption_name = it.first;
     const ULogParser::Timeseries& timeseries = it.second;
     auto group = plot_data.getOrCreateGroup(sucsctiption_name);
@@ -87,6 +115,33 @@ bool DataLoadULog::readDataFromFile(FileLoadInfo* fileload_info, PlotDataMapRef&
   return true;
 }
 
+QStringList DataLoadULog::listTopicsInFile(const QString& filename)
+{
+  QFile file(filename);
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    return {};
+  }
+  size_t file_size = static_cast<size_t>(file.size());
+  const uchar* mapped = file.map(0, file.size());
+  QByteArray fallback_array;
+  const char* file_begin = reinterpret_cast<const char*>(mapped);
+  if (!mapped)
+  {
+    fallback_array = file.readAll();
+    file_begin = fallback_array.data();
+    file_size = static_cast<size_t>(fallback_array.size());
+  }
+  ULogParser::DataStream datastream(file_begin, file_size);
+
+  QStringList topics;
+  for (const auto& name : ULogParser::scanSubscriptionNames(datastream))
+  {
+    topics.push_back(QString::fromStdString(name));
+  }
+  return topics;
+}
+
 DataLoadULog::~DataLoadULog()
 {
 }
@@ -20,6 +20,13 @@ public:
 
   bool readDataFromFile(PJ::FileLoadInfo* fileload_info, PlotDataMapRef& destination) override;
 
+  bool supportsTopicFilter() const override
+  {
+    return true;
+  }
+
+  QStringList listTopicsInFile(const QString& filename) override;
+
   ~DataLoadULog() override;
 
   const char* name() const override
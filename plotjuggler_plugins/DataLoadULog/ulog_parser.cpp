@@ -8,7 +8,8 @@
 
 using ios = std::ios;
 
-ULogParser::ULogParser(DataStream& datastream) : _file_start_time(0)
+ULogParser::ULogParser(DataStream& datastream, const std::set<std::string>* subscription_filter)
+  : _file_start_time(0)
 {
   bool ret = readFileHeader(datastream);
 
@@ -29,6 +30,28 @@ ULogParser::ULogParser(DataStream& datastream) : _file_start_time(0)
     ulog_message_header_s message_header;
     datastream.read((char*)&message_header, ULOG_MSG_HEADER_LEN);
 
+    if (message_header.msg_type == (int)ULogMessageType::DATA)
+    {
+      // hot path: decode straight from the input buffer, without copying the
+      // payload into _read_buffer
+      const char* message = datastream.peek(message_header.msg_size);
+      uint16_t msg_id;
+      memcpy(&msg_id, message, sizeof(msg_id));
+
+      auto sub_it = _subscriptions.find(msg_id);
+      if (sub_it == _subscriptions.end())
+      {
+        continue;
+      }
+      auto plan_it = _decode_plans.find(msg_id);
+      if (plan_it == _decode_plans.end())
+      {
+        plan_it = _decode_plans.insert({ msg_id, buildDecodePlan(sub_it->second) }).first;
+      }
+      executePlan(plan_it->second, message + sizeof(msg_id));
+      continue;
+    }
+
     _read_buffer.reserve(message_header.msg_size + 1);
     char* message = (char*)_read_buffer.data();
     datastream.read(message, message_header.msg_size);
@@ -44,6 +67,13 @@ ULogParser::ULogParser(DataStream& datastream) : _file_start_time(0)
         message += 3;
         sub.message_name.assign(message, message_header.msg_size - 3);
 
+        // filtered out: never registering the subscription makes every
+        // DATA message with this msg_id fall through the find() above
+        if (subscription_filter && subscription_filter->count(sub.message_name) == 0)
+        {
+          break;
+        }
+
         const auto it = _formats.find(sub.message_name);
         if (it != _formats.end())
         {
@@ -51,9 +81,17 @@ ULogParser::ULogParser(DataStream& datastream) : _file_start_time(0)
         }
         _subscriptions.insert({ sub.msg_id, sub });
 
-        if (sub.multi_id > 0)
+        if (sub.multi_id > 0 && _message_name_with_multi_id.insert(sub.message_name).second)
         {
-          _message_name_with_multi_id.insert(sub.message_name);
+          // the multi_id suffix changes the timeseries name: drop any plan
+          // compiled before we knew this message has multiple instances
+          for (auto plan_it = _decode_plans.begin(); plan_it != _decode_plans.end();)
+          {
+            const Subscription& prev_sub = _subscriptions.at(plan_it->first);
+            plan_it = (prev_sub.message_name == sub.message_name) ?
+                          _decode_plans.erase(plan_it) :
+                          std::next(plan_it);
+          }
         }
 
         //            printf("ADD_LOGGED_MSG: %d %d %s\n", sub.msg_id, sub.multi_id,
@@ -64,22 +102,10 @@ ULogParser::ULogParser(DataStream& datastream) : _file_start_time(0)
         printf("REMOVE_LOGGED_MSG\n");
         {
           uint16_t msg_id = *reinterpret_cast<uint16_t*>(message);
+          _decode_plans.erase(msg_id);
           _subscriptions.erase(msg_id);
         }
         break;
-      case (int)ULogMessageType::DATA: {
-        uint16_t msg_id = *reinterpret_cast<uint16_t*>(message);
-        message += 2;
-        auto sub_it = _subscriptions.find(msg_id);
-        if (sub_it == _subscriptions.end())
-        {
-          continue;
-        }
-        const Subscription& sub = sub_it->second;
-
-        parseDataMessage(sub, message);
-      }
-      break;
 
       case (int)ULogMessageType::LOGGING: {
         MessageLog msg;
@@ -124,18 +150,44 @@ ULogParser::ULogParser(DataStream& datastream) : _file_start_time(0)
   }
 }
 
-void ULogParser::parseDataMessage(const ULogParser::Subscription& sub, char* message)
+// unaligned load from the (possibly memory-mapped) input buffer
+template <typename T>
+static T loadRaw(const char* src)
 {
-  size_t other_fields_count = 0;
-  std::string ts_name = sub.message_name;
+  T value;
+  memcpy(&value, src, sizeof(T));
+  return value;
+}
 
-  for (const auto& field : sub.format->fields)
-  {
-    if (field.type == OTHER)
-    {
-      other_fields_count++;
-    }
+static size_t fieldSize(ULogParser::FormatType type)
+{
+  switch (type)
+  {
+    case ULogParser::UINT8:
+    case ULogParser::INT8:
+    case ULogParser::CHAR:
+    case ULogParser::BOOL:
+      return 1;
+    case ULogParser::UINT16:
+    case ULogParser::INT16:
+      return 2;
+    case ULogParser::UINT32:
+    case ULogParser::INT32:
+    case ULogParser::FLOAT:
+      return 4;
+    case ULogParser::UINT64:
+    case ULogParser::INT64:
+    case ULogParser::DOUBLE:
+      return 8;
+    case ULogParser::OTHER:
+      break;
   }
+  return 0;
+}
+
+ULogParser::DecodePlan ULogParser::buildDecodePlan(const ULogParser::Subscription& sub)
+{
+  std::string ts_name = sub.message_name;
 
   if (_message_name_with_multi_id.count(ts_name) > 0)
   {
@@ -144,134 +196,128 @@ void ULogParser::parseDataMessage(const ULogParser::Subscription& sub, char* mes
     ts_name += std::string(buff);
   }
 
-  // get the timeseries or create if if it doesn't exist
+  // get the timeseries or create it if it doesn't exist
   auto ts_it = _timeseries.find(ts_name);
   if (ts_it == _timeseries.end())
   {
     ts_it = _timeseries.insert({ ts_name, createTimeseries(sub.format) }).first;
   }
-  Timeseries& timeseries = ts_it->second;
 
-  size_t index = 0;
-  parseSimpleDataMessage(timeseries, sub.format, message, &index);
+  DecodePlan plan;
+  plan.timeseries = &ts_it->second;
+  plan.ops.reserve(fieldsCount(*sub.format));
+
+  size_t offset = 0;
+  uint32_t series_index = 0;
+  appendPlanOps(*sub.format, offset, series_index, plan, true);
+  return plan;
 }
 
-char* ULogParser::parseSimpleDataMessage(Timeseries& timeseries, const Format* format,
-                                         char* message, size_t* index, bool read_timestamp)
+void ULogParser::appendPlanOps(const ULogParser::Format& format, size_t& offset,
+                               uint32_t& series_index, DecodePlan& plan, bool top_level)
 {
-  for (size_t i = 0; i <= format->fields.size(); i++)
+  for (size_t i = 0; i <= format.fields.size(); i++)
   {
-    if (format->timestamp_idx == static_cast<int>(i))
+    if (format.timestamp_idx == static_cast<int>(i))
     {
-      uint64_t time_val = *reinterpret_cast<uint64_t*>(message);
-      message += sizeof(uint64_t);
-      if (read_timestamp)
+      // nested formats carry their own timestamp, but only the top level one
+      // is published
+      if (top_level)
       {
-        timeseries.timestamps.push_back(time_val);
+        plan.timestamp_offset = static_cast<int64_t>(offset);
       }
+      offset += sizeof(uint64_t);
     }
 
-    if (i == format->fields.size())
+    if (i == format.fields.size())
     {
       break;
     }
 
-    const auto& field = format->fields[i];
+    const auto& field = format.fields[i];
 
     // skip _padding messages which are one byte in size
     if (startsWith(StringView(field.field_name), "_padding"))
     {
-      message += field.array_size;
+      offset += field.array_size;
       continue;
     }
 
     for (int array_pos = 0; array_pos < field.array_size; array_pos++)
     {
-      double value = 0;
-      switch (field.type)
+      if (field.type == OTHER)
       {
-        case UINT8: {
-          value = static_cast<double>(*reinterpret_cast<uint8_t*>(message));
-          message += 1;
-        }
-        break;
-        case INT8: {
-          value = static_cast<double>(*reinterpret_cast<int8_t*>(message));
-          message += 1;
-        }
+        appendPlanOps(_formats.at(field.other_type_ID), offset, series_index, plan, false);
+        continue;
+      }
+      plan.ops.push_back({ field.type, static_cast<uint32_t>(offset), series_index++ });
+      offset += fieldSize(field.type);
+    }
+  }
+}
+
+void ULogParser::executePlan(const DecodePlan& plan, const char* message)
+{
+  Timeseries& timeseries = *plan.timeseries;
+
+  if (plan.timestamp_offset >= 0)
+  {
+    uint64_t time_val;
+    memcpy(&time_val, message + plan.timestamp_offset, sizeof(time_val));
+    timeseries.timestamps.push_back(time_val);
+  }
+  else
+  {
+    timeseries.timestamps.push_back(std::nullopt);
+  }
+
+  for (const DecodeOp& op : plan.ops)
+  {
+    const char* src = message + op.offset;
+    double value = 0;
+    switch (op.type)
+    {
+      case UINT8:
+        value = static_cast<double>(loadRaw<uint8_t>(src));
         break;
-        case UINT16: {
-          value = static_cast<double>(*reinterpret_cast<uint16_t*>(message));
-          message += 2;
-        }
+      case INT8:
+        value = static_cast<double>(loadRaw<int8_t>(src));
         break;
-        case INT16: {
-          value = static_cast<double>(*reinterpret_cast<int16_t*>(message));
-          message += 2;
-        }
+      case UINT16:
+        value = static_cast<double>(loadRaw<uint16_t>(src));
         break;
-        case UINT32: {
-          value = static_cast<double>(*reinterpret_cast<uint32_t*>(message));
-          message += 4;
-        }
+      case INT16:
+        value = static_cast<double>(loadRaw<int16_t>(src));
         break;
-        case INT32: {
-          value = static_cast<double>(*reinterpret_cast<int32_t*>(message));
-          message += 4;
-        }
+      case UINT32:
+        value = static_cast<double>(loadRaw<uint32_t>(src));
         break;
-        case UINT64: {
-          value = static_cast<double>(*reinterpret_cast<uint64_t*>(message));
-          message += 8;
-        }
+      case INT32:
+        value = static_cast<double>(loadRaw<int32_t>(src));
         break;
-        case INT64: {
-          value = static_cast<double>(*reinterpret_cast<int64_t*>(message));
-          message += 8;
-        }
+      case UINT64:
+        value = static_cast<double>(loadRaw<uint64_t>(src));
         break;
-        case FLOAT: {
-          value = static_cast<double>(*reinterpret_cast<float*>(message));
-          message += 4;
-        }
+      case INT64:
+        value = static_cast<double>(loadRaw<int64_t>(src));
         break;
-        case DOUBLE: {
-          value = (*reinterpret_cast<double*>(message));
-          message += 8;
-        }
+      case FLOAT:
+        value = static_cast<double>(loadRaw<float>(src));
         break;
-        case CHAR: {
-          value = static_cast<double>(*reinterpret_cast<char*>(message));
-          message += 1;
-        }
+      case DOUBLE:
+        value = loadRaw<double>(src);
         break;
-        case BOOL: {
-          value = static_cast<double>(*reinterpret_cast<bool*>(message));
-          message += 1;
-        }
+      case CHAR:
+        value = static_cast<double>(*src);
         break;
-        case OTHER: {
-          // recursion!!!
-          auto child_format = _formats.at(field.other_type_ID);
-          message = parseSimpleDataMessage(timeseries, &child_format, message, index, false);
-        }
+      case BOOL:
+        value = static_cast<double>(loadRaw<uint8_t>(src) != 0);
         break;
-
-      }  // end switch
-
-      if (field.type != OTHER)
-      {
-        timeseries.data[(*index)++].second.push_back(value);
-      }
-    }  // end for
-  }
-
-  if (read_timestamp && format->timestamp_idx < 0)
-  {
-    timeseries.timestamps.push_back(std::nullopt);
+      case OTHER:  // flattened away by appendPlanOps
+        continue;
+    }
+    timeseries.data[op.series_index].second.push_back(value);
   }
-
-  return message;
 }
 
 const std::map<std::string, ULogParser::Timeseries>& ULogParser::getTimeseriesMap() const
@@ -372,6 +418,43 @@ bool ULogParser::readFileHeader(DataStream& datastream)
   return memcmp(magic, msg_header.magic, 7) == 0;
 }
 
+std::set<std::string> ULogParser::scanSubscriptionNames(DataStream& datastream)
+{
+  std::set<std::string> names;
+
+  ulog_file_header_s file_header;
+  datastream.read((char*)&file_header, sizeof(file_header));
+  const char magic[7] = { 'U', 'L', 'o', 'g', 0x01, 0x12, 0x35 };
+  if (!datastream || memcmp(magic, file_header.magic, 7) != 0)
+  {
+    return names;
+  }
+
+  // one pass over the message headers, skipping every payload except the
+  // subscription names: linear in the file size, but no field decoding
+  while (datastream)
+  {
+    ulog_message_header_s message_header;
+    datastream.read((char*)&message_header, ULOG_MSG_HEADER_LEN);
+    if (!datastream)
+    {
+      break;
+    }
+    if (message_header.msg_type == (int)ULogMessageType::ADD_LOGGED_MSG &&
+        message_header.msg_size > 3)
+    {
+      // skip multi_id (1 byte) and msg_id (2 bytes)
+      const char* message = datastream.peek(message_header.msg_size);
+      names.insert(std::string(message + 3, message_header.msg_size - 3));
+    }
+    else
+    {
+      datastream.offset += message_header.msg_size;
+    }
+  }
+  return names;
+}
+
 bool ULogParser::readFileDefinitions(DataStream& datastream)
 {
   ulog_message_header_s message_header;
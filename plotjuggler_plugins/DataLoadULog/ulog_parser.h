@@ -33,7 +33,7 @@ public:
     const size_t _length;
     size_t offset;
 
-    DataStream(char* data, int len) : _data(data), _length(len), offset(0)
+    DataStream(const char* data, size_t len) : _data(data), _length(len), offset(0)
     {
     }
 
@@ -43,6 +43,15 @@ public:
       offset += len;
     }
 
+    /// Return a pointer into the underlying buffer and advance the offset,
+    /// avoiding a copy of the message payload.
+    const char* peek(int len)
+    {
+      const char* ptr = &_data[offset];
+      offset += len;
+      return ptr;
+    }
+
     operator bool()
     {
       return offset < _length;
@@ -126,8 +135,35 @@ public:
     std::vector<std::pair<std::string, std::vector<double>>> data;
   };
 
+  /// Single decoding step: read one scalar at a fixed offset of the message
+  /// payload and append it to one column of the timeseries.
+  struct DecodeOp
+  {
+    FormatType type;
+    uint32_t offset;
+    uint32_t series_index;
+  };
+
+  /// Flattened decoding recipe for one subscription. It is compiled once from
+  /// the (possibly nested) format definition and executed for every DATA
+  /// message, replacing the recursive per-field dispatch.
+  struct DecodePlan
+  {
+    std::vector<DecodeOp> ops;
+    int64_t timestamp_offset = -1;  ///< byte offset of the uint64_t timestamp, -1 if absent
+    Timeseries* timeseries = nullptr;
+  };
+
 public:
-  ULogParser(DataStream& datastream);
+  /// When `subscription_filter` is not null, only the subscriptions whose
+  /// message name is in the set are decoded: DATA messages of the others
+  /// are skipped without touching the payload.
+  ULogParser(DataStream& datastream, const std::set<std::string>* subscription_filter = nullptr);
+
+  /// Metadata pre-scan: the names of the logged messages, collected by
+  /// walking the message headers without decoding any DATA payload.
+  /// Returns an empty set when the stream is not a valid ULog file.
+  static std::set<std::string> scanSubscriptionNames(DataStream& datastream);
 
   const std::map<std::string, Timeseries>& getTimeseriesMap() const;
 
@@ -174,6 +210,8 @@ private:
 
   std::map<uint16_t, Subscription> _subscriptions;
 
+  std::map<uint16_t, DecodePlan> _decode_plans;
+
   std::map<std::string, Timeseries> _timeseries;
 
   std::vector<StringView> splitString(const StringView& strToSplit, char delimeter);
@@ -182,8 +220,10 @@ private:
 
   std::vector<MessageLog> _message_logs;
 
-  void parseDataMessage(const Subscription& sub, char* message);
+  DecodePlan buildDecodePlan(const Subscription& sub);
+
+  void appendPlanOps(const Format& format, size_t& offset, uint32_t& series_index,
+                     DecodePlan& plan, bool top_level);
 
-  char* parseSimpleDataMessage(Timeseries& timeseries, const Format* format, char* message,
-                               size_t* index, bool read_timestamp = true);
+  void executePlan(const DecodePlan& plan, const char* message);
 };
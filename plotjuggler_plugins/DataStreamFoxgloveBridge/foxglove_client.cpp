@@ -11,6 +11,7 @@
 #include <QPushButton>
 #include <QSettings>
 
+#include <algorithm>
 #include <cstring>
 
 namespace
@@ -23,6 +24,11 @@ constexpr int kStatusLevelInfo = 0;
 constexpr int kStatusLevelWarning = 1;
 constexpr int kStatusLevelError = 2;
 
+// Decode worker pool: capped shard count (also bounded by hardware
+// threads) and per-channel queue depth before old samples are dropped
+constexpr unsigned kMaxDecodeShards = 4;
+constexpr int kMaxPendingPerChannel = 256;
+
 template <typename T>
 bool readLE(const uint8_t*& ptr, const uint8_t* end, T& out)
 {
@@ -307,7 +313,12 @@ void FoxgloveBridgeClient::resetState()
   _subscriptions.clear();
   _subscription_by_channel.clear();
 #ifdef PJ_BUILD
-  _parsers_by_subscription.clear();
+  // Join the workers before dropping the parsers they may be using
+  stopDecodeWorkers();
+  {
+    std::lock_guard<std::mutex> lock(_parsers_mutex);
+    _parsers_by_subscription.clear();
+  }
 #endif
   _next_subscription_id = 1;
   _data_received_timer.stop();
@@ -418,10 +429,14 @@ bool FoxgloveBridgeClient::subscribeSelectedChannels(
     _subscription_by_channel.insert(it.key(), it.value());
   }
 #ifdef PJ_BUILD
-  for (auto it = new_parsers.cbegin(); it != new_parsers.cend(); ++it)
   {
-    _parsers_by_subscription.insert(it.key(), it.value());
+    std::lock_guard<std::mutex> lock(_parsers_mutex);
+    for (auto it = new_parsers.cbegin(); it != new_parsers.cend(); ++it)
+    {
+      _parsers_by_subscription.insert(it.key(), it.value());
+    }
   }
+  startDecodeWorkers();
 #endif
 
   _state = FoxgloveState::Streaming;
@@ -626,7 +641,10 @@ void FoxgloveBridgeClient::onTextMessageReceived(const QString& message)
         _subscription_by_channel.erase(sub_it);
         _subscriptions.remove(subscription_id);
 #ifdef PJ_BUILD
-        _parsers_by_subscription.remove(subscription_id);
+        {
+          std::lock_guard<std::mutex> lock(_parsers_mutex);
+          _parsers_by_subscription.remove(subscription_id);
+        }
 #endif
       }
     }
@@ -725,42 +743,181 @@ void FoxgloveBridgeClient::onBinaryMessageReceived(const QByteArray& message)
   }
 
 #ifdef PJ_BUILD
-  auto parser_it = _parsers_by_subscription.find(subscription_id);
-  if (parser_it == _parsers_by_subscription.end())
+  // Decode happens on the worker shards: the socket thread only pays for
+  // the header parse and a refcounted enqueue, so a decode backlog can
+  // never stall the websocket
+  const int payload_offset =
+      int(ptr - reinterpret_cast<const uint8_t*>(message.constData()));
+  enqueueSample(subscription_id, log_time, message, payload_offset);
+#else
+  _data_received_pending = true;
+  if (!_data_received_timer.isActive())
+  {
+    _data_received_timer.start();
+  }
+#endif
+}
+
+#ifdef PJ_BUILD
+void FoxgloveBridgeClient::startDecodeWorkers()
+{
+  if (!_decode_shards.empty())
   {
     return;
   }
+  const unsigned hw_threads = std::max(1u, std::thread::hardware_concurrency());
+  const unsigned num_shards = std::min(kMaxDecodeShards, hw_threads);
 
-  double timestamp = double(log_time) * 1e-9;
-  QString parse_error;
-  try
+  _decode_error_reported = false;
+  _decode_running = true;
+  for (unsigned i = 0; i < num_shards; i++)
   {
-    std::lock_guard<std::mutex> lock(mutex());
-    parser_it.value()->parseMessage(PJ::MessageRef(ptr, size_t(end - ptr)), timestamp);
+    auto shard = std::make_unique<DecodeShard>();
+    shard->thread = std::thread([this, shard_ptr = shard.get()]() { decodeLoop(*shard_ptr); });
+    _decode_shards.push_back(std::move(shard));
   }
-  catch (std::exception& ex)
+}
+
+void FoxgloveBridgeClient::stopDecodeWorkers()
+{
+  if (_decode_shards.empty())
+  {
+    return;
+  }
+  _decode_running = false;
+  for (auto& shard : _decode_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->cv.notify_all();
+  }
+  for (auto& shard : _decode_shards)
   {
-    parse_error = QString::fromLocal8Bit(ex.what());
+    if (shard->thread.joinable())
+    {
+      shard->thread.join();
+    }
   }
+  _decode_shards.clear();
+}
 
-  if (!parse_error.isEmpty())
+void FoxgloveBridgeClient::enqueueSample(quint32 subscription_id, quint64 log_time,
+                                         const QByteArray& frame, int payload_offset)
+{
+  if (_decode_shards.empty())
   {
-    QMessageBox::warning(
-        nullptr, tr("Foxglove Bridge"),
-        tr("Problem parsing the message. Foxglove Bridge will be stopped.\n%1").arg(parse_error),
-        QMessageBox::Ok);
-    shutdown();
-    emit closed();
     return;
   }
-#endif
+  auto& shard = *_decode_shards[subscription_id % _decode_shards.size()];
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    int& pending = shard.pending_per_channel[subscription_id];
+    if (pending >= kMaxPendingPerChannel)
+    {
+      // Back-pressure: drop the oldest queued sample of this channel.
+      // Other channels on the shard are not affected.
+      for (auto it = shard.queue.begin(); it != shard.queue.end(); ++it)
+      {
+        if (it->subscription_id == subscription_id)
+        {
+          shard.queue.erase(it);
+          pending--;
+          break;
+        }
+      }
+    }
+    pending++;
+    shard.queue.push_back({ subscription_id, log_time, frame, payload_offset });
+  }
+  shard.cv.notify_one();
+}
 
-  _data_received_pending = true;
-  if (!_data_received_timer.isActive())
+void FoxgloveBridgeClient::decodeLoop(DecodeShard& shard)
+{
+  while (true)
   {
-    _data_received_timer.start();
+    PendingSample sample;
+    bool drained = false;
+    {
+      std::unique_lock<std::mutex> lock(shard.mutex);
+      shard.cv.wait(lock, [&]() { return !_decode_running || !shard.queue.empty(); });
+      if (!_decode_running)
+      {
+        return;
+      }
+      sample = std::move(shard.queue.front());
+      shard.queue.pop_front();
+      auto count_it = shard.pending_per_channel.find(sample.subscription_id);
+      if (count_it != shard.pending_per_channel.end() && --count_it.value() <= 0)
+      {
+        shard.pending_per_channel.erase(count_it);
+      }
+      drained = shard.queue.empty();
+    }
+
+    // shared_ptr copy: the parser stays alive even if the subscription is
+    // removed while we are decoding
+    PJ::MessageParserPtr parser;
+    {
+      std::lock_guard<std::mutex> lock(_parsers_mutex);
+      parser = _parsers_by_subscription.value(sample.subscription_id);
+    }
+
+    if (parser)
+    {
+      const auto* data =
+          reinterpret_cast<const uint8_t*>(sample.frame.constData()) + sample.payload_offset;
+      const size_t size = size_t(sample.frame.size() - sample.payload_offset);
+      double timestamp = double(sample.log_time) * 1e-9;
+      try
+      {
+        std::lock_guard<std::mutex> lock(mutex());
+        parser->parseMessage(PJ::MessageRef(data, size), timestamp);
+      }
+      catch (std::exception& ex)
+      {
+        // Report once, from the GUI thread
+        if (!_decode_error_reported.exchange(true))
+        {
+          const QString error = QString::fromLocal8Bit(ex.what());
+          QMetaObject::invokeMethod(
+              this,
+              [this, error]() {
+                QMessageBox::warning(nullptr, tr("Foxglove Bridge"),
+                                     tr("Problem parsing the message. Foxglove Bridge will be "
+                                        "stopped.\n%1")
+                                         .arg(error),
+                                     QMessageBox::Ok);
+                shutdown();
+                emit closed();
+              },
+              Qt::QueuedConnection);
+        }
+        continue;
+      }
+    }
+
+    // Schedule the coalesced dataReceived() once per drained queue, not
+    // per sample
+    if (drained)
+    {
+      QMetaObject::invokeMethod(
+          this,
+          [this]() {
+            if (!_running)
+            {
+              return;
+            }
+            _data_received_pending = true;
+            if (!_data_received_timer.isActive())
+            {
+              _data_received_timer.start();
+            }
+          },
+          Qt::QueuedConnection);
+    }
   }
 }
+#endif
 
 bool FoxgloveBridgeClient::xmlSaveState(QDomDocument& doc, QDomElement& parent_element) const
 {
@@ -6,6 +6,13 @@
 #include <QTimer>
 #include <QWebSocket>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include "PlotJuggler/datastreamer_base.h"
 #include "PlotJuggler/messageparser_base.h"
 #include "foxglove_client_config.h"
@@ -74,6 +81,43 @@ private:
 
 #ifdef PJ_BUILD
   QHash<quint32, PJ::MessageParserPtr> _parsers_by_subscription;
+  /// Guards _parsers_by_subscription, shared between the socket thread
+  /// (subscribe/unadvertise/reset) and the decode workers.
+  std::mutex _parsers_mutex;
+
+  /// One queued sample. The frame is the whole websocket message
+  /// (implicitly shared QByteArray, so enqueueing does not copy the bytes).
+  struct PendingSample
+  {
+    quint32 subscription_id = 0;
+    quint64 log_time = 0;
+    QByteArray frame;
+    int payload_offset = 0;
+  };
+
+  /// A decode worker and its queue. Samples are sharded by subscription id,
+  /// so all samples of a channel land on the same worker and stay ordered.
+  struct DecodeShard
+  {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<PendingSample> queue;
+    QHash<quint32, int> pending_per_channel;
+    std::thread thread;
+  };
+
+  std::vector<std::unique_ptr<DecodeShard>> _decode_shards;
+  std::atomic<bool> _decode_running{ false };
+  std::atomic<bool> _decode_error_reported{ false };
+
+  void startDecodeWorkers();
+  void stopDecodeWorkers();
+  void decodeLoop(DecodeShard& shard);
+  /// Hand a sample to its shard. When the channel already has
+  /// kMaxPendingPerChannel samples queued, the oldest one is dropped,
+  /// so a slow decoder never stalls the socket or grows the backlog.
+  void enqueueSample(quint32 subscription_id, quint64 log_time, const QByteArray& frame,
+                     int payload_offset);
 #endif
 
   quint32 _next_subscription_id = 1;
@@ -1,6 +1,7 @@
 #include "datastream_mqtt.h"
 #include "ui_datastream_mqtt.h"
 #include "PlotJuggler/dialog_utils.h"
+#include "PlotJuggler/util/coarse_clock.hpp"
 #include <QMetaObject>
 #include <QMessageBox>
 #include <QSettings>
@@ -9,6 +10,7 @@
 #include <QUuid>
 #include <QIntValidator>
 #include <QMessageBox>
+#include <chrono>
 
 DataStreamMQTT::DataStreamMQTT() : _running(false)
 {
@@ -16,13 +18,17 @@ DataStreamMQTT::DataStreamMQTT() : _running(false)
 
   connect(_notification_action, &QAction::triggered, this, [this]() {
     QMessageBox::warning(nullptr, "MQTT error",
-                         QString("Failed to parse %1 messages").arg(_failed_parsing),
+                         QString("Failed to parse %1 messages.\n"
+                                 "Dropped %2 messages (ingest queue full).")
+                             .arg(int(_failed_parsing))
+                             .arg(int(_dropped_messages)),
                          QMessageBox::Ok);
 
-    if (_failed_parsing > 0)
+    if (_failed_parsing > 0 || _dropped_messages > 0)
     {
       _failed_parsing = 0;
-      emit notificationsChanged(_failed_parsing);
+      _dropped_messages = 0;
+      emit notificationsChanged(0);
     }
   });
 
@@ -45,6 +51,7 @@ bool DataStreamMQTT::start(QStringList*)
 
   // cleanup notifications
   _failed_parsing = 0;
+  _dropped_messages = 0;
   emit notificationsChanged(0);
 
   if (parserFactories() == nullptr || parserFactories()->empty())
@@ -109,6 +116,9 @@ bool DataStreamMQTT::start(QStringList*)
     _mosq->addMessageCallback(topic_name, callback);
   }
 
+  _decode_running = true;
+  _decode_thread = std::thread([this]() { decodeLoop(); });
+
   _running = true;
   return _running;
 }
@@ -118,8 +128,16 @@ void DataStreamMQTT::shutdown()
   if (_running)
   {
     _running = false;
+    // stop the producer first, then drain and join the decode thread
     _mosq->disconnect();
 
+    _decode_running = false;
+    _ingest_cv.notify_one();
+    if (_decode_thread.joinable())
+    {
+      _decode_thread.join();
+    }
+
     std::unique_lock<std::mutex> lk(mutex());
     _parsers.clear();
     _topic_to_parse.clear();
@@ -186,28 +204,147 @@ PJ::MessageParserPtr DataStreamMQTT::ensureTopicParser(const std::string& topic)
 
 void DataStreamMQTT::onMessageReceived(const mosquitto_message* message)
 {
-  bool result = false;
-  try
+  // called by the mosquitto network thread: only copy the payload into the
+  // ingest queue, decoding happens in decodeLoop()
+  IngestMessage msg;
+  msg.topic = message->topic;
+  if (message->payloadlen > 0)
   {
-    auto parser = ensureTopicParser(message->topic);
-    std::unique_lock<std::mutex> lk(mutex());
-    MessageRef msg(static_cast<uint8_t*>(message->payload), message->payloadlen);
+    const auto* payload = static_cast<const uint8_t*>(message->payload);
+    msg.payload.assign(payload, payload + message->payloadlen);
+  }
 
-    using namespace std::chrono;
-    auto ts = high_resolution_clock::now().time_since_epoch();
-    double timestamp = 1e-6 * double(duration_cast<microseconds>(ts).count());
+  // no clock call here: the arrival stamps are assigned per batch in
+  // decodeLoop(), right after the messages are popped from the queue
+  streamStats().messages_received.fetch_add(1, std::memory_order_relaxed);
 
-    result = parser->parseMessage(msg, timestamp);
-  }
-  catch (std::exception&)
+  if (!_ingest_queue.push(msg))
   {
+    // never block the network thread: drop the message and count it
+    _dropped_messages.fetch_add(1, std::memory_order_relaxed);
+    streamStats().messages_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
   }
+  _ingest_cv.notify_one();
+}
 
-  emit dataReceived();
+void DataStreamMQTT::decodeLoop()
+{
+  constexpr size_t MAX_BATCH_SIZE = 256;
 
-  if (!result)
+  std::vector<IngestMessage> batch;
+  batch.reserve(MAX_BATCH_SIZE);
+  PJ::CoarseArrivalClock arrival_clock;
+  // parsers resolved once per topic, not once per message
+  std::unordered_map<std::string, PJ::MessageParserPtr> parser_cache;
+  int reported_dropped = 0;
+
+  while (_decode_running)
   {
-    _failed_parsing++;
-    emit notificationsChanged(_failed_parsing);
+    batch.clear();
+    IngestMessage msg;
+    while (batch.size() < MAX_BATCH_SIZE && _ingest_queue.pop(msg))
+    {
+      batch.push_back(std::move(msg));
+    }
+
+    if (batch.empty())
+    {
+      std::unique_lock<std::mutex> lk(_ingest_cv_mutex);
+      _ingest_cv.wait_for(lk, std::chrono::milliseconds(10));
+      continue;
+    }
+
+    // batch-stamp the arrival times: one wall-clock read for the whole
+    // batch, interpolated across it, instead of one read per message on
+    // the mosquitto network thread. The queue is drained as soon as the
+    // network thread signals it, so the stamps stay close to the actual
+    // arrival.
+    arrival_clock.refresh();
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+      batch[i].timestamp = arrival_clock.batchStamp(i, batch.size());
+    }
+
+    // resolve the parsers first, without holding the data mutex:
+    // ensureTopicParser() locks it and may round-trip to the GUI thread
+    for (const auto& it : batch)
+    {
+      if (parser_cache.count(it.topic) == 0)
+      {
+        try
+        {
+          parser_cache[it.topic] = ensureTopicParser(it.topic);
+        }
+        catch (std::exception&)
+        {
+          parser_cache[it.topic] = nullptr;
+        }
+      }
+    }
+
+    int failed = 0;
+    const auto parse_start = std::chrono::steady_clock::now();
+    {
+      // one mutex acquisition and one dataReceived() per batch,
+      // instead of one per message
+      std::unique_lock<std::mutex> lk(mutex());
+
+      // messages from the same topic usually arrive back to back: hand each
+      // run to the parser in a single parseMessageBatch() call, so that
+      // parsers with a per-call fixed cost (WASM) can amortize it
+      std::vector<PJ::MessageRef> run_refs;
+      std::vector<double> run_timestamps;
+      size_t begin = 0;
+      while (begin < batch.size())
+      {
+        size_t end = begin + 1;
+        while (end < batch.size() && batch[end].topic == batch[begin].topic)
+        {
+          end++;
+        }
+        const size_t run_len = end - begin;
+        auto& parser = parser_cache[batch[begin].topic];
+        if (!parser)
+        {
+          failed += run_len;
+          begin = end;
+          continue;
+        }
+        run_refs.clear();
+        run_timestamps.clear();
+        for (size_t i = begin; i < end; i++)
+        {
+          run_refs.emplace_back(batch[i].payload.data(), batch[i].payload.size());
+          run_timestamps.push_back(batch[i].timestamp);
+        }
+        try
+        {
+          parseOrSpoolBatch(*parser, run_refs.data(), run_timestamps.data(), run_len);
+        }
+        catch (std::exception&)
+        {
+          failed += run_len;
+        }
+        begin = end;
+      }
+    }
+    if (!isUiPaused())
+    {
+      recordParseTime(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - parse_start)
+                          .count(),
+                      batch.size() - failed);
+    }
+
+    emit dataReceived();
+
+    const int dropped = _dropped_messages.load(std::memory_order_relaxed);
+    if (failed > 0 || dropped != reported_dropped)
+    {
+      _failed_parsing += failed;
+      reported_dropped = dropped;
+      emit notificationsChanged(_failed_parsing + dropped);
+    }
   }
 }
@@ -4,9 +4,14 @@
 #include <QDialog>
 #include <QtPlugin>
 #include <QTimer>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
+#include <vector>
 #include "PlotJuggler/datastreamer_base.h"
 #include "PlotJuggler/messageparser_base.h"
+#include "PlotJuggler/util/spsc_queue.hpp"
 #include "ui_datastream_mqtt.h"
 #include "mqtt_dialog.h"
 
@@ -41,7 +46,7 @@ public:
 
   std::pair<QAction*, int> notificationAction() override
   {
-    return { _notification_action, _failed_parsing };
+    return { _notification_action, _failed_parsing + _dropped_messages };
   }
 
 private slots:
@@ -53,6 +58,8 @@ private slots:
 private:
   PJ::MessageParserPtr ensureTopicParser(const std::string& topic);
 
+  void decodeLoop();
+
   bool _running;
 
   std::unordered_map<std::string, PJ::MessageParserPtr> _parsers;
@@ -65,7 +72,25 @@ private:
   QString _topic_to_parse;
 
   QAction* _notification_action;
-  int _failed_parsing = 0;
+  std::atomic<int> _failed_parsing{ 0 };
+
+  /// Raw message copied out of the mosquitto callback, waiting to be decoded
+  struct IngestMessage
+  {
+    std::string topic;
+    std::vector<uint8_t> payload;
+    double timestamp = 0;  // arrival stamp, batch-assigned by decodeLoop()
+  };
+
+  // the mosquitto network thread pushes, decodeLoop() drains in batches.
+  // When the queue is full, messages are dropped and counted.
+  PJ::SPSCQueue<IngestMessage> _ingest_queue{ 16 * 1024 };
+  std::atomic<int> _dropped_messages{ 0 };
+
+  std::thread _decode_thread;
+  std::atomic<bool> _decode_running{ false };
+  std::condition_variable _ingest_cv;
+  std::mutex _ingest_cv_mutex;
 
   MQTT_Dialog* _dialog;
   ParserFactoryPlugin::Ptr _current_parser_creator;
@@ -245,7 +245,8 @@ void MQTTClient::disconnect()
   }
   _connected = false;
   _topics_set.clear();
-  _message_callbacks.clear();
+  _filter_root = FilterNode{};
+  _resolved_callbacks.clear();
 }
 
 bool MQTTClient::isConnected() const
@@ -256,19 +257,117 @@ bool MQTTClient::isConnected() const
 void MQTTClient::addMessageCallback(const std::string& topic, MQTTClient::TopicCallback callback)
 {
   std::unique_lock<std::mutex> lk(_mutex);
-  _message_callbacks[topic] = callback;
+
+  FilterNode* node = &_filter_root;
+  std::string_view remaining = topic;
+  while (true)
+  {
+    const size_t slash = remaining.find('/');
+    const std::string_view segment = remaining.substr(0, slash);
+    if (segment == "#")
+    {
+      // '#' is only valid as the last segment of a filter
+      node->hash_callback = std::make_unique<TopicCallback>(std::move(callback));
+      break;
+    }
+    if (segment == "+")
+    {
+      if (!node->plus)
+      {
+        node->plus = std::make_unique<FilterNode>();
+      }
+      node = node->plus.get();
+    }
+    else
+    {
+      auto it = node->children.find(segment);
+      if (it == node->children.end())
+      {
+        it = node->children.emplace(std::string(segment), std::make_unique<FilterNode>()).first;
+      }
+      node = it->second.get();
+    }
+    if (slash == std::string_view::npos)
+    {
+      node->callback = std::make_unique<TopicCallback>(std::move(callback));
+      break;
+    }
+    remaining.remove_prefix(slash + 1);
+  }
+  // the cached terminals may point at filters that just changed
+  _resolved_callbacks.clear();
+}
+
+MQTTClient::TopicCallback* MQTTClient::matchSegments(const FilterNode& node,
+                                                     const std::vector<std::string_view>& segments,
+                                                     size_t index, bool allow_wildcard)
+{
+  if (index == segments.size())
+  {
+    if (node.callback)
+    {
+      return node.callback.get();
+    }
+    // "sport/#" also matches "sport" itself
+    return allow_wildcard ? node.hash_callback.get() : nullptr;
+  }
+  auto it = node.children.find(segments[index]);
+  if (it != node.children.end())
+  {
+    if (auto* callback = matchSegments(*it->second, segments, index + 1, true))
+    {
+      return callback;
+    }
+  }
+  if (allow_wildcard)
+  {
+    if (node.plus)
+    {
+      if (auto* callback = matchSegments(*node.plus, segments, index + 1, true))
+      {
+        return callback;
+      }
+    }
+    return node.hash_callback.get();
+  }
+  return nullptr;
+}
+
+MQTTClient::TopicCallback* MQTTClient::resolveCallback(std::string_view topic) const
+{
+  std::vector<std::string_view> segments;
+  std::string_view remaining = topic;
+  while (true)
+  {
+    const size_t slash = remaining.find('/');
+    segments.push_back(remaining.substr(0, slash));
+    if (slash == std::string_view::npos)
+    {
+      break;
+    }
+    remaining.remove_prefix(slash + 1);
+  }
+  // wildcards must not match the reserved "$SYS/..." topics at the top level
+  const bool reserved = !topic.empty() && topic.front() == '$';
+  return matchSegments(_filter_root, segments, 0, !reserved);
 }
 
 void MQTTClient::onMessageReceived(const mosquitto_message* message)
 {
   std::unique_lock<std::mutex> lk(_mutex);
 
-  _topics_set.insert(message->topic);
-
-  auto it = _message_callbacks.find(message->topic);
-  if (it != _message_callbacks.end())
+  // one trie walk per distinct topic: afterwards every message of that
+  // topic costs a single cached lookup, with no string allocation
+  const std::string_view topic = message->topic;
+  auto it = _resolved_callbacks.find(topic);
+  if (it == _resolved_callbacks.end())
+  {
+    _topics_set.insert(std::string(topic));
+    it = _resolved_callbacks.emplace(std::string(topic), resolveCallback(topic)).first;
+  }
+  if (it->second)
   {
-    it->second(message);
+    (*it->second)(message);
   }
 }
 
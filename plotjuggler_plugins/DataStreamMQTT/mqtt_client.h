@@ -3,10 +3,12 @@
 
 #include "mosquitto_config.h"
 #include <string>
+#include <string_view>
 #include <functional>
 #include <thread>
-#include <unordered_map>
+#include <map>
 #include <unordered_set>
+#include <vector>
 #include <mutex>
 #include <memory>
 #include <QObject>
@@ -49,8 +51,30 @@ signals:
 private:
   bool configureMosquitto(const MosquittoConfig& config);
 
+  /// One node per '/'-separated segment of the subscribed filters, with
+  /// MQTT wildcard semantics: '+' matches any single segment, '#' the
+  /// whole remainder (and the parent level itself).
+  struct FilterNode
+  {
+    std::map<std::string, std::unique_ptr<FilterNode>, std::less<>> children;
+    std::unique_ptr<FilterNode> plus;
+    std::unique_ptr<TopicCallback> hash_callback;
+    /// set when a filter ends exactly at this node
+    std::unique_ptr<TopicCallback> callback;
+  };
+
+  /// Walk the filter trie. Returns nullptr when no filter matches.
+  TopicCallback* resolveCallback(std::string_view topic) const;
+
+  static TopicCallback* matchSegments(const FilterNode& node,
+                                      const std::vector<std::string_view>& segments, size_t index,
+                                      bool allow_wildcard);
+
   mosquitto* _mosq = nullptr;
-  std::unordered_map<std::string, TopicCallback> _message_callbacks;
+  FilterNode _filter_root;
+  /// concrete topic -> terminal resolved by the trie (nullptr included),
+  /// so each distinct topic pays the trie walk only once
+  std::map<std::string, TopicCallback*, std::less<>> _resolved_callbacks;
   std::unordered_set<std::string> _topics_set;
   std::mutex _mutex;
   MosquittoConfig _config;
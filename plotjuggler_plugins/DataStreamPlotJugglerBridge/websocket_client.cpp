@@ -210,6 +210,13 @@ bool WebsocketClient::start(QStringList*)
     QJsonObject cmd;
     cmd["command"] = "subscribe";
     cmd["topics"] = arr;
+    // Advertise support for the columnar binary frames (protocol v2).
+    // Older servers ignore the field and keep sending v1 frames.
+    cmd["binary_version"] = 2;
+    // Advertise support for viewport-driven decimation. Only a server
+    // that echoes the field back will ever receive "set_viewport": an
+    // unknown command would be answered with an error popup.
+    cmd["viewport_negotiation"] = true;
 
     _pending_mode = WsState::Mode::Subscribe;
     _pending_request_id = sendCommand(cmd);
@@ -300,6 +307,17 @@ bool WebsocketClient::resume()
   return !sendCommand(cmd).isEmpty();
 }
 
+void WebsocketClient::setVisibleViewport(double min_time, double max_time, int pixel_width)
+{
+  // Called by the application on zoom / pan / resize. Just remember the
+  // values: the heartbeat timer batches them into one "set_viewport" per
+  // second, so dragging the zoom rectangle does not flood the server.
+  _viewport_min = min_time;
+  _viewport_max = max_time;
+  _viewport_px = pixel_width;
+  _viewport_dirty = _viewport_negotiated;
+}
+
 void WebsocketClient::resetState()
 {
   // Stop periodic timers
@@ -320,6 +338,15 @@ void WebsocketClient::resetState()
   // Clear topics cache
   _topics.clear();
 
+  // Forget the negotiated binary protocol
+  _binary_version = 1;
+  _topic_by_id.clear();
+
+  // Forget the negotiated viewport (the last reported one is kept, so a
+  // new subscription can flush it again)
+  _viewport_negotiated = false;
+  _viewport_dirty = false;
+
 #ifdef PJ_BUILD
   // Drop created parsers
   _parsers_topic.clear();
@@ -496,6 +523,40 @@ void WebsocketClient::onTextMessageReceived(const QString& message)
         t.schema_definition = s.value("definition").toString();
       }
 
+      // Binary protocol negotiation. A server that supports the columnar
+      // v2 frames echoes "binary_version": 2 and assigns a numeric id to
+      // every accepted topic, so data frames do not repeat topic names:
+      // "topic_ids": { "/topic_a": 0, "/topic_b": 1 }
+      _binary_version = 1;
+      _topic_by_id.clear();
+      if (obj.value("binary_version").toInt(1) >= 2 && obj.value("topic_ids").isObject())
+      {
+        const auto ids = obj.value("topic_ids").toObject();
+        for (auto it = ids.begin(); it != ids.end(); ++it)
+        {
+          const int id = it.value().toInt(-1);
+          if (id < 0 || id > 0xFFFF)
+          {
+            continue;
+          }
+          if (size_t(id) >= _topic_by_id.size())
+          {
+            _topic_by_id.resize(id + 1);
+          }
+          _topic_by_id[id] = it.key();
+        }
+        if (!_topic_by_id.empty())
+        {
+          _binary_version = 2;
+        }
+      }
+
+      // Viewport negotiation: only send "set_viewport" to a server that
+      // echoed the capability back. If the application already reported a
+      // viewport, flush it with the next heartbeat.
+      _viewport_negotiated = obj.value("viewport_negotiation").toBool(false);
+      _viewport_dirty = _viewport_negotiated && _viewport_px > 0;
+
       // Create parsers for accepted topics (PJ build only)
       createParsersForTopics();
 
@@ -543,6 +604,27 @@ static bool readLE(const uint8_t*& p, const uint8_t* end, T& out)
   return true;
 }
 
+static bool readVarint(const uint8_t*& p, const uint8_t* end, uint64_t& out)
+{
+  // Unsigned LEB128, used by the v2 columnar payload for timestamp
+  // deltas and sample lengths (both small most of the time)
+  out = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7)
+  {
+    if (p >= end)
+    {
+      return false;
+    }
+    const uint8_t byte = *p++;
+    out |= uint64_t(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool WebsocketClient::parseDecompressedPayload(const QByteArray& decompressed,
                                                uint32_t expected_count)
 {
@@ -600,6 +682,100 @@ bool WebsocketClient::parseDecompressedPayload(const QByteArray& decompressed,
   return true;
 }
 
+bool WebsocketClient::parseColumnarPayload(const QByteArray& payload, uint32_t expected_count)
+{
+  // v2 payload: repeated per-topic blocks, columnar inside each block:
+  // [u16 topic_id][u32 count][u64 base_ts_ns]
+  // [varint ts_delta_ns] x count   delta from the previous sample (first
+  //                                one from base_ts_ns, typically zero)
+  // [varint cdr_len]     x count
+  // [bytes cdr]          x count   concatenated sample payloads
+  //
+  // Compared to v1 this sends each topic name once per subscription
+  // instead of once per sample, and 1-2 bytes per timestamp instead
+  // of 8, which is what makes high series-count bridging cheap.
+  const uint8_t* q = reinterpret_cast<const uint8_t*>(payload.constData());
+  const uint8_t* qend = q + payload.size();
+
+  uint32_t parsed = 0;
+
+  std::lock_guard<std::mutex> lock(mutex());
+
+  while (q < qend)
+  {
+    uint16_t topic_id = 0;
+    uint32_t count = 0;
+    uint64_t base_ts_ns = 0;
+
+    if (!readLE(q, qend, topic_id) || !readLE(q, qend, count) || !readLE(q, qend, base_ts_ns))
+    {
+      return false;
+    }
+
+    if (topic_id >= _topic_by_id.size() || _topic_by_id[topic_id].isEmpty())
+    {
+      qWarning() << "Unknown topic id:" << topic_id;
+      return false;
+    }
+    // By value: a parse error inside onRos2CdrMessage() shuts the client
+    // down and clears _topic_by_id while we are still in the loop
+    const QString topic = _topic_by_id[topic_id];
+
+    // Timestamp column: cumulative deltas from the block base
+    _scratch_ts.clear();
+    _scratch_ts.reserve(count);
+    uint64_t ts_ns = base_ts_ns;
+    for (uint32_t i = 0; i < count; i++)
+    {
+      uint64_t delta = 0;
+      if (!readVarint(q, qend, delta))
+      {
+        return false;
+      }
+      ts_ns += delta;
+      _scratch_ts.push_back(ts_ns);
+    }
+
+    // Length column
+    _scratch_len.clear();
+    _scratch_len.reserve(count);
+    size_t total_data = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+      uint64_t len = 0;
+      if (!readVarint(q, qend, len))
+      {
+        return false;
+      }
+      _scratch_len.push_back(uint32_t(len));
+      total_data += size_t(len);
+    }
+
+    if (size_t(qend - q) < total_data)
+    {
+      return false;
+    }
+
+    // Data column: concatenated CDR blobs
+    for (uint32_t i = 0; i < count; i++)
+    {
+      onRos2CdrMessage(topic, double(_scratch_ts[i]) * 1e-9, q, _scratch_len[i]);
+      q += _scratch_len[i];
+      parsed++;
+    }
+  }
+
+  // Header message_count must match parsed messages
+  if (parsed != expected_count)
+  {
+    qWarning() << "Parsed messages mismatch. header=" << expected_count << "parsed=" << parsed
+               << "payload=" << payload.size();
+    return false;
+  }
+
+  return true;
+}
+
 void WebsocketClient::onBinaryMessageReceived(const QByteArray& message)
 {
   if (!_running)
@@ -628,44 +804,73 @@ void WebsocketClient::onBinaryMessageReceived(const QByteArray& message)
     return;
   }
 
+  // Frame flags. v1 servers always send 0.
+  // COLUMNAR marks the v2 columnar payload (negotiated at subscribe);
+  // UNCOMPRESSED lets the server skip zstd on payloads that would not
+  // shrink (small batches, already-compressed blobs).
+  constexpr uint32_t FLAG_COLUMNAR = 0x1;
+  constexpr uint32_t FLAG_UNCOMPRESSED = 0x2;
+
   // Validate magic and flags
   if (magic != 0x42524A50)
   {  // "PJRB"
     qWarning() << "Bad magic:" << Qt::hex << magic;
     return;
   }
-  if (flags != 0)
+  if ((flags & ~(FLAG_COLUMNAR | FLAG_UNCOMPRESSED)) != 0)
   {
     qWarning() << "Bad flag:" << flags;
     return;
   }
+  if ((flags & FLAG_COLUMNAR) && _binary_version < 2)
+  {
+    qWarning() << "Columnar frame received without negotiation";
+    return;
+  }
 
-  // Compressed payload starts after 16-byte header
+  // Payload starts after 16-byte header
   const size_t header_size = 16;
-  const size_t compressed_size = message.size() - header_size;
-  if (compressed_size == 0)
+  const size_t payload_size = message.size() - header_size;
+  if (payload_size == 0)
   {
     return;
   }
 
-  // ZSTD decompress
   QByteArray decompressed;
-  decompressed.resize(static_cast<int>(uncompressed_size));
-
-  size_t res = ZSTD_decompress(decompressed.data(), size_t(decompressed.size()),
-                               message.constData() + header_size, compressed_size);
-
-  if (ZSTD_isError(res))
+  if (flags & FLAG_UNCOMPRESSED)
   {
-    qWarning() << "ZSTD_decompress error:" << ZSTD_getErrorName(res);
-    return;
+    // No copy: the view stays valid for the lifetime of `message`,
+    // which outlives this handler
+    decompressed =
+        QByteArray::fromRawData(message.constData() + header_size, int(payload_size));
   }
+  else
+  {
+    // ZSTD decompress
+    decompressed.resize(static_cast<int>(uncompressed_size));
 
-  // Resize to actual decompressed bytes
-  decompressed.resize(int(res));
+    size_t res = ZSTD_decompress(decompressed.data(), size_t(decompressed.size()),
+                                 message.constData() + header_size, payload_size);
+
+    if (ZSTD_isError(res))
+    {
+      qWarning() << "ZSTD_decompress error:" << ZSTD_getErrorName(res);
+      return;
+    }
+
+    // Resize to actual decompressed bytes
+    decompressed.resize(int(res));
+  }
 
   // Parse messages inside payload
-  parseDecompressedPayload(decompressed, message_count);
+  if (flags & FLAG_COLUMNAR)
+  {
+    parseColumnarPayload(decompressed, message_count);
+  }
+  else
+  {
+    parseDecompressedPayload(decompressed, message_count);
+  }
   _ws_msg_count++;
 
   // Notify PlotJuggler that new data is available (once per binary frame)
@@ -742,6 +947,22 @@ void WebsocketClient::sendHeartBeat()
   QJsonObject cmd;
   cmd["command"] = "heartbeat";
   sendCommand(cmd);
+
+  // Piggy-back the latest viewport on the heartbeat cadence. Fire-and-forget
+  // like pause/resume: the success reply carries no payload.
+  if (_viewport_negotiated && _viewport_dirty && _viewport_px > 0 &&
+      _viewport_max > _viewport_min)
+  {
+    QJsonObject viewport;
+    viewport["command"] = "set_viewport";
+    viewport["min_time"] = _viewport_min;
+    viewport["max_time"] = _viewport_max;
+    viewport["pixel_width"] = _viewport_px;
+    if (!sendCommand(viewport).isEmpty())
+    {
+      _viewport_dirty = false;
+    }
+  }
 }
 
 // =======================
@@ -67,6 +67,11 @@ public:
   bool pause();
   bool resume();
 
+  // Remember the visible time range / pixel budget reported by the
+  // application; forwarded to the server with the next heartbeat when the
+  // server negotiated "viewport_negotiation" at subscribe time.
+  void setVisibleViewport(double min_time, double max_time, int pixel_width) override;
+
 private:
   QAction* _action_settings = nullptr;
   std::vector<QAction*> _actions;
@@ -90,6 +95,26 @@ private:
 
   std::vector<TopicInfo> _topics;
 
+  // Binary protocol version negotiated with the server at subscribe time.
+  // Version 2 adds columnar batch frames: numeric topic ids instead of
+  // repeated topic names, delta-encoded timestamps and optional
+  // compression bypass (see onBinaryMessageReceived).
+  int _binary_version = 1;
+  std::vector<QString> _topic_by_id;
+
+  // Viewport negotiated with the server at subscribe time: when accepted,
+  // the server decimates each batch to the reported pixel budget and
+  // refines the visible window on zoom (see setVisibleViewport).
+  bool _viewport_negotiated = false;
+  bool _viewport_dirty = false;
+  double _viewport_min = 0;
+  double _viewport_max = 0;
+  int _viewport_px = 0;
+
+  // Decoded columns of the block being parsed, reused across frames
+  std::vector<uint64_t> _scratch_ts;
+  std::vector<uint32_t> _scratch_len;
+
 #ifdef PJ_BUILD
   QHash<QString, PJ::MessageParserPtr> _parsers_topic;
 #endif
@@ -110,6 +135,7 @@ private:
   void createParsersForTopics();
   void onRos2CdrMessage(const QString& topic, double ts_sec, const uint8_t* cdr, uint32_t len);
   bool parseDecompressedPayload(const QByteArray& decompressed, uint32_t expected_count);
+  bool parseColumnarPayload(const QByteArray& payload, uint32_t expected_count);
   void printStats();
 
 private slots:
@@ -18,9 +18,11 @@ OTHER DEALINGS IN THE SOFTWARE.
 
 #include "datastream_serialport.h"
 
-#include <chrono>
+#include <cstring>
 #include <memory>
 
+#include "PlotJuggler/util/coarse_clock.hpp"
+
 #include <QAction>
 #include <QDebug>
 #include <QMessageBox>
@@ -32,7 +34,7 @@ OTHER DEALINGS IN THE SOFTWARE.
 #include "PlotJuggler/dialog_utils.h"
 #include "ui_datastream_serialport.h"
 
-static constexpr int kChunkSize = 4096;
+static constexpr int kChunkSize = 65536;
 
 enum FlowControl
 {
@@ -243,74 +245,135 @@ public:
 class JSONSplitter : public MsgSplitter
 {
 public:
-  QList<QByteArray> process(const QByteArray& data)
+  // Incoming bytes are appended to the accumulation buffer in bulk and
+  // scanned with memchr (SIMD on every mainstream libc), jumping from one
+  // structural byte ('{', '}', '"') to the next instead of walking and
+  // appending byte by byte. The buffer is compacted at most once per call:
+  // fully consumed input is dropped for free, a partial message is moved
+  // to the front only when there are bytes in front of it.
+  QList<QByteArray> process(const QByteArray& data) override
   {
     QList<QByteArray> res;
 
-    for (const auto byte : data)
-    {
-      if (_buf.count() > 1024 * 1024)
+    // Everything before the old size has already been scanned
+    int pos = _buf.size();
+    _buf.append(data);
+
+    const char* base = _buf.constData();
+    const int size = _buf.size();
+
+    // memchr results cached per character: once a character is known to be
+    // absent from the remaining bytes, it is never searched again
+    int next_open = -2;
+    int next_close = -2;
+    int next_quote = -2;
+    auto nextOf = [&](char c, int& cached) {
+      if (cached != -1 && cached < pos)
       {
-        _buf.clear();
-        _depth = 0;
-        _in_string = false;
-        _escape_next = false;
+        const void* p = memchr(base + pos, c, size_t(size - pos));
+        cached = p ? int(static_cast<const char*>(p) - base) : -1;
       }
+      return cached;
+    };
 
+    while (pos < size)
+    {
       if (_in_string)
       {
-        _buf.append(byte);
-        if (byte == '"' && !_escape_next)
+        const int idx = nextOf('"', next_quote);
+        if (idx < 0)
+        {
+          pos = size;
+          break;
+        }
+        // the quote is escaped when preceded by an odd run of backslashes
+        int backslashes = 0;
+        for (int k = idx - 1; k >= 0 && base[k] == '\\'; k--)
+        {
+          backslashes++;
+        }
+        pos = idx + 1;
+        if ((backslashes & 1) == 0)
         {
           _in_string = false;
         }
-        _escape_next = (!_escape_next && byte == '\\');
         continue;
       }
 
-      if (byte == '"' && _depth > 0)
+      const int i_open = nextOf('{', next_open);
+      const int i_close = nextOf('}', next_close);
+      const int i_quote = nextOf('"', next_quote);
+
+      int idx = size;
+      if (i_open >= 0 && i_open < idx)
       {
-        _buf.append(byte);
-        _in_string = true;
-        _escape_next = false;
-        continue;
+        idx = i_open;
       }
+      if (i_close >= 0 && i_close < idx)
+      {
+        idx = i_close;
+      }
+      if (i_quote >= 0 && i_quote < idx)
+      {
+        idx = i_quote;
+      }
+      if (idx == size)
+      {
+        pos = size;
+        break;
+      }
+
+      const char byte = base[idx];
+      pos = idx + 1;
 
       if (byte == '{')
       {
         if (_depth == 0)
         {
-          _buf.clear();
+          _msg_start = idx;
         }
         _depth++;
-        _buf.append(byte);
       }
       else if (byte == '}')
       {
-        if (_depth > 0)
+        if (_depth > 0 && --_depth == 0)
         {
-          _buf.append(byte);
-          _depth--;
-          if (_depth == 0)
-          {
-            res.append(std::move(_buf));
-          }
+          res.append(QByteArray(base + _msg_start, pos - _msg_start));
         }
       }
       else if (_depth > 0)
       {
-        _buf.append(byte);
+        _in_string = true;
       }
     }
 
+    if (_depth == 0 && !_in_string)
+    {
+      // no partial message pending: drop everything
+      _buf.clear();
+    }
+    else if (_msg_start > 0)
+    {
+      // keep only the partial message, moved to the front
+      _buf.remove(0, _msg_start);
+    }
+    _msg_start = 0;
+
+    if (_buf.size() > 1024 * 1024)
+    {
+      _buf.clear();
+      _depth = 0;
+      _in_string = false;
+    }
+
     return res;
   }
 
 private:
   QByteArray _buf;
   int _depth = 0;
+  int _msg_start = 0;
   bool _in_string = false;
-  bool _escape_next = false;
 };
 
 class DatastreamSerialPortDialog : public QDialog
@@ -560,11 +623,13 @@ void DatastreamSerialPort::processMessage()
     return;
   }
 
+  // one wall-clock read per chunk; the messages split out of it get
+  // interpolated stamps instead of sharing a single one
+  PJ::CoarseArrivalClock arrival_clock;
+
   while (_serialPort->bytesAvailable() > 0)
   {
-    using namespace std::chrono;
-    auto ts = high_resolution_clock::now().time_since_epoch();
-    double timestamp = 1e-6 * double(duration_cast<microseconds>(ts).count());
+    arrival_clock.refresh();
 
     auto msgList = _splitter->process(_serialPort->read(kChunkSize));
     if (msgList.count() == 0)
@@ -575,12 +640,13 @@ void DatastreamSerialPort::processMessage()
     int errors_before = _failed_parsing;
     {
       std::lock_guard<std::mutex> lock(mutex());
-      for (const auto& data : msgList)
+      for (int index = 0; index < msgList.count(); index++)
       {
+        const auto& data = msgList[index];
         MessageRef msg(reinterpret_cast<const uint8_t*>(data.data()), data.count());
         try
         {
-          _parser->parseMessage(msg, timestamp);
+          parseOrSpool(*_parser, msg, arrival_clock.batchStamp(index, msgList.count()));
         }
         catch (std::exception& err)
         {
@@ -0,0 +1,125 @@
+#include "datastream_shm.h"
+
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QSettings>
+#include <chrono>
+
+using namespace PJ;
+
+DataStreamShm::DataStreamShm() : _running(false)
+{
+}
+
+DataStreamShm::~DataStreamShm()
+{
+  shutdown();
+}
+
+bool DataStreamShm::start(QStringList*)
+{
+  if (_running)
+  {
+    return _running;
+  }
+
+  QSettings settings;
+  QString segment_name =
+      settings.value("DataStreamShm::segment_name", "/plotjuggler").toString();
+
+  bool ok = false;
+  segment_name = QInputDialog::getText(nullptr, tr("Shared Memory Ring"),
+                                       tr("Name of the shared memory segment:"),
+                                       QLineEdit::Normal, segment_name, &ok);
+  if (!ok || segment_name.isEmpty())
+  {
+    return false;
+  }
+  settings.setValue("DataStreamShm::segment_name", segment_name);
+
+  std::string error_msg;
+  if (!_reader.open(segment_name.toStdString(), error_msg))
+  {
+    QMessageBox::warning(nullptr, tr("Shared Memory Ring"),
+                         tr("Can't attach to segment \"%1\".\n%2")
+                             .arg(segment_name)
+                             .arg(QString::fromStdString(error_msg)),
+                         QMessageBox::Ok);
+    return false;
+  }
+
+  _segment_name = segment_name;
+  _series_indices.clear();
+  _running = true;
+  _thread = std::thread([this]() { this->loop(); });
+  return true;
+}
+
+void DataStreamShm::shutdown()
+{
+  _running = false;
+  if (_thread.joinable())
+  {
+    _thread.join();
+  }
+  _reader.close();
+}
+
+bool DataStreamShm::xmlSaveState(QDomDocument& doc, QDomElement& parent_element) const
+{
+  QDomElement elem = doc.createElement("segment");
+  elem.setAttribute("name", _segment_name);
+  parent_element.appendChild(elem);
+  return true;
+}
+
+bool DataStreamShm::xmlLoadState(const QDomElement& parent_element)
+{
+  QDomElement elem = parent_element.firstChildElement("segment");
+  if (!elem.isNull())
+  {
+    QSettings settings;
+    settings.setValue("DataStreamShm::segment_name", elem.attribute("name"));
+  }
+  return true;
+}
+
+void DataStreamShm::loop()
+{
+  // drain in bounded batches so that a fast producer can't starve the
+  // dataReceived notifications
+  constexpr size_t MAX_BATCH = 8 * 1024;
+
+  using namespace std::chrono;
+  auto last_notification = steady_clock::now();
+
+  auto onSample = [this](const shm::RingSample& sample) {
+    std::string name(sample.name);
+    auto it = _series_indices.find(name);
+    if (it == _series_indices.end())
+    {
+      // takes the mutex, but only once per series
+      size_t index = registerStreamedSeries(name);
+      it = _series_indices.insert({ std::move(name), index }).first;
+    }
+    pushStreamedSample(it->second, sample.timestamp, sample.value);
+  };
+
+  while (_running)
+  {
+    const size_t drained = _reader.drain(onSample, MAX_BATCH);
+
+    auto now = steady_clock::now();
+    if (drained > 0 && now - last_notification > milliseconds(20))
+    {
+      last_notification = now;
+      emit dataReceived();
+    }
+
+    if (drained < MAX_BATCH)
+    {
+      // ring is empty (or nearly): yield instead of spinning
+      std::this_thread::sleep_for(milliseconds(1));
+    }
+  }
+}
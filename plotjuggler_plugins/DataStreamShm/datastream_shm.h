@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QtPlugin>
+#include <thread>
+#include <unordered_map>
+
+#include "PlotJuggler/datastreamer_base.h"
+#include "shm_ring.h"
+
+/**
+ * @brief Streams samples published by a local producer through a shared
+ * memory ring (see shm_ring.h), avoiding the per-datagram syscall and copy
+ * overhead of looping data through UDP on the same host.
+ *
+ * The reader thread drains the ring and feeds the lock-free streaming path
+ * of DataStreamer (registerStreamedSeries / pushStreamedSample); the mutex
+ * is only taken the first time a new series name appears.
+ */
+class DataStreamShm : public PJ::DataStreamer
+{
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID "facontidavide.PlotJuggler3.DataStreamer")
+  Q_INTERFACES(PJ::DataStreamer)
+
+public:
+  DataStreamShm();
+
+  virtual bool start(QStringList*) override;
+
+  virtual void shutdown() override;
+
+  virtual bool isRunning() const override
+  {
+    return _running;
+  }
+
+  virtual ~DataStreamShm() override;
+
+  virtual const char* name() const override
+  {
+    return "Shared Memory Ring";
+  }
+
+  virtual bool isDebugPlugin() override
+  {
+    return false;
+  }
+
+  virtual bool xmlSaveState(QDomDocument& doc, QDomElement& parent_element) const override;
+
+  virtual bool xmlLoadState(const QDomElement& parent_element) override;
+
+private:
+  void loop();
+
+  std::thread _thread;
+
+  bool _running;
+
+  PJ::shm::RingReader _reader;
+
+  QString _segment_name;
+
+  std::unordered_map<std::string, size_t> _series_indices;
+};
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace PJ
+{
+namespace shm
+{
+
+/**
+ * Single-producer / multiple-consumer broadcast ring over POSIX shared
+ * memory, used by the "Shared Memory Ring" streaming plugin.
+ *
+ * The layout is a fixed header followed by a power-of-two number of slots.
+ * Each slot carries its own sequence counter used as a seqlock:
+ *
+ * - while a slot is being written, its sequence is odd (2 * seq + 1);
+ * - once published, it holds exactly 2 * seq;
+ * - the header "head" is the sequence of the next sample to be written.
+ *
+ * The producer never waits for consumers: a slow reader detects that a slot
+ * was overwritten (sequence no longer matches) and resynchronizes to the
+ * oldest sample still available, counting the gap as overruns. The hot path
+ * on both sides is plain loads/stores on the mapped pages: no syscalls,
+ * no futexes.
+ *
+ * Producers in other processes only need to replicate this header (the
+ * layout is fixed by RING_MAGIC / RING_VERSION): create the segment with
+ * RingWriter::create() or equivalent code in any language that can mmap
+ * and issue release stores.
+ */
+
+constexpr uint64_t RING_MAGIC = 0x31474E524A50ULL;  // "PJRNG1"
+constexpr uint32_t RING_VERSION = 1;
+
+/// Maximum length of a series name, including the null terminator
+constexpr size_t MAX_NAME_LENGTH = 48;
+
+struct RingSample
+{
+  double timestamp;  ///< seconds (the plugin does not rescale it)
+  double value;
+  char name[MAX_NAME_LENGTH];  ///< null-terminated series name
+};
+
+struct RingSlot
+{
+  std::atomic<uint64_t> sequence;
+  RingSample sample;
+};
+
+struct RingHeader
+{
+  uint64_t magic;
+  uint32_t version;
+  uint32_t capacity;  ///< number of slots, power of two
+  std::atomic<uint64_t> head;  ///< sequence of the next sample to be written
+  uint8_t _padding[40];        ///< keep the slots cache-line aligned
+};
+
+static_assert(sizeof(RingHeader) == 64, "unexpected RingHeader layout");
+
+inline size_t RingSegmentSize(uint32_t capacity)
+{
+  return sizeof(RingHeader) + size_t(capacity) * sizeof(RingSlot);
+}
+
+/**
+ * @brief Consumer side of the ring. Attaches read-only to an existing
+ * segment and drains samples published after attach time.
+ */
+class RingReader
+{
+public:
+  RingReader() = default;
+
+  RingReader(const RingReader&) = delete;
+  RingReader& operator=(const RingReader&) = delete;
+
+  ~RingReader()
+  {
+    close();
+  }
+
+  /// Attach to an existing segment. On failure returns false and fills
+  /// error_msg.
+  bool open(const std::string& segment_name, std::string& error_msg)
+  {
+    close();
+
+    int fd = ::shm_open(segment_name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+      error_msg = "shm_open failed: " + std::string(strerror(errno));
+      return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(RingHeader))
+    {
+      error_msg = "segment is smaller than the ring header";
+      ::close(fd);
+      return false;
+    }
+
+    void* base = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED)
+    {
+      error_msg = "mmap failed: " + std::string(strerror(errno));
+      return false;
+    }
+
+    const auto* header = static_cast<const RingHeader*>(base);
+    if (header->magic != RING_MAGIC || header->version != RING_VERSION)
+    {
+      error_msg = "not a PlotJuggler ring segment (wrong magic or version)";
+      ::munmap(base, size_t(st.st_size));
+      return false;
+    }
+    const uint32_t capacity = header->capacity;
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        size_t(st.st_size) < RingSegmentSize(capacity))
+    {
+      error_msg = "corrupted ring header (bad capacity)";
+      ::munmap(base, size_t(st.st_size));
+      return false;
+    }
+
+    _base = base;
+    _mapped_size = size_t(st.st_size);
+    _header = header;
+    _slots = reinterpret_cast<const RingSlot*>(static_cast<const uint8_t*>(base) +
+                                               sizeof(RingHeader));
+    // start from the live edge: samples published before attaching are skipped
+    _next = _header->head.load(std::memory_order_acquire);
+    _overruns = 0;
+    return true;
+  }
+
+  void close()
+  {
+    if (_base)
+    {
+      ::munmap(_base, _mapped_size);
+      _base = nullptr;
+      _header = nullptr;
+      _slots = nullptr;
+    }
+  }
+
+  bool isOpen() const
+  {
+    return _header != nullptr;
+  }
+
+  /// Drain up to max_samples, invoking callback(const RingSample&) for each.
+  /// Returns the number of samples delivered.
+  template <typename Callback>
+  size_t drain(Callback&& callback, size_t max_samples)
+  {
+    const uint64_t head = _header->head.load(std::memory_order_acquire);
+    const uint32_t capacity = _header->capacity;
+
+    // fell behind by more than one ring: jump to the oldest intact sample
+    if (head - _next > capacity)
+    {
+      _overruns += (head - capacity) - _next;
+      _next = head - capacity;
+    }
+
+    size_t count = 0;
+    while (_next != head && count < max_samples)
+    {
+      const RingSlot& slot = _slots[_next & (capacity - 1)];
+
+      if (slot.sequence.load(std::memory_order_acquire) != _next * 2)
+      {
+        // the producer is overwriting this slot right now
+        _overruns++;
+        _next++;
+        continue;
+      }
+      RingSample sample;
+      memcpy(&sample, &slot.sample, sizeof(sample));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != _next * 2)
+      {
+        // overwritten while we were copying
+        _overruns++;
+        _next++;
+        continue;
+      }
+      callback(static_cast<const RingSample&>(sample));
+      _next++;
+      count++;
+    }
+    return count;
+  }
+
+  /// Samples lost because the producer lapped this reader
+  uint64_t overruns() const
+  {
+    return _overruns;
+  }
+
+private:
+  void* _base = nullptr;
+  size_t _mapped_size = 0;
+  const RingHeader* _header = nullptr;
+  const RingSlot* _slots = nullptr;
+  uint64_t _next = 0;
+  uint64_t _overruns = 0;
+};
+
+/**
+ * @brief Producer side of the ring. Not used by the plugin itself, but by
+ * test producers and as reference code for external applications.
+ */
+class RingWriter
+{
+public:
+  RingWriter() = default;
+
+  RingWriter(const RingWriter&) = delete;
+  RingWriter& operator=(const RingWriter&) = delete;
+
+  ~RingWriter()
+  {
+    close();
+  }
+
+  /// Create (or replace) a segment with the given slot count (power of two).
+  bool create(const std::string& segment_name, uint32_t capacity, std::string& error_msg)
+  {
+    close();
+
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+    {
+      error_msg = "capacity must be a power of two";
+      return false;
+    }
+
+    ::shm_unlink(segment_name.c_str());
+    int fd = ::shm_open(segment_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+      error_msg = "shm_open failed: " + std::string(strerror(errno));
+      return false;
+    }
+
+    const size_t segment_size = RingSegmentSize(capacity);
+    if (::ftruncate(fd, off_t(segment_size)) != 0)
+    {
+      error_msg = "ftruncate failed: " + std::string(strerror(errno));
+      ::close(fd);
+      ::shm_unlink(segment_name.c_str());
+      return false;
+    }
+
+    void* base = ::mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED)
+    {
+      error_msg = "mmap failed: " + std::string(strerror(errno));
+      ::shm_unlink(segment_name.c_str());
+      return false;
+    }
+
+    memset(base, 0, segment_size);
+    auto* header = static_cast<RingHeader*>(base);
+    header->capacity = capacity;
+    header->version = RING_VERSION;
+    header->head.store(0, std::memory_order_relaxed);
+    // write the magic last, so that a reader attaching concurrently never
+    // sees a valid magic over an uninitialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = RING_MAGIC;
+
+    _base = base;
+    _mapped_size = segment_size;
+    _header = header;
+    _slots = reinterpret_cast<RingSlot*>(static_cast<uint8_t*>(base) + sizeof(RingHeader));
+    _name = segment_name;
+    return true;
+  }
+
+  void close()
+  {
+    if (_base)
+    {
+      ::munmap(_base, _mapped_size);
+      ::shm_unlink(_name.c_str());
+      _base = nullptr;
+      _header = nullptr;
+      _slots = nullptr;
+    }
+  }
+
+  bool isOpen() const
+  {
+    return _header != nullptr;
+  }
+
+  /// Publish one sample. Wait-free: the oldest sample is overwritten when
+  /// the ring is full.
+  void push(const char* series_name, double timestamp, double value)
+  {
+    const uint64_t seq = _header->head.load(std::memory_order_relaxed);
+    RingSlot& slot = _slots[seq & (_header->capacity - 1)];
+
+    slot.sequence.store(seq * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.sample.timestamp = timestamp;
+    slot.sample.value = value;
+    strncpy(slot.sample.name, series_name, MAX_NAME_LENGTH - 1);
+    slot.sample.name[MAX_NAME_LENGTH - 1] = '\0';
+
+    slot.sequence.store(seq * 2, std::memory_order_release);
+    _header->head.store(seq + 1, std::memory_order_release);
+  }
+
+private:
+  void* _base = nullptr;
+  size_t _mapped_size = 0;
+  RingHeader* _header = nullptr;
+  RingSlot* _slots = nullptr;
+  std::string _name;
+};
+
+}  // namespace shm
+}  // namespace PJ
@@ -0,0 +1,259 @@
+#include "datastream_stress.h"
+
+#include <QDialog>
+#include <QIntValidator>
+#include <QSettings>
+#include <QDebug>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+
+#include "ui_datastream_stress.h"
+
+using namespace PJ;
+
+class StressGeneratorDialog : public QDialog
+{
+public:
+  StressGeneratorDialog() : QDialog(nullptr), ui(new Ui::DataStreamStress)
+  {
+    ui->setupUi(this);
+    setWindowTitle("Stress Generator");
+
+    connect(ui->buttonBox, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    connect(ui->buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+  }
+  ~StressGeneratorDialog()
+  {
+    delete ui;
+  }
+  Ui::DataStreamStress* ui;
+};
+
+DataStreamStress::~DataStreamStress()
+{
+  shutdown();
+}
+
+bool DataStreamStress::start(QStringList*)
+{
+  if (_running)
+  {
+    return _running;
+  }
+
+  // previous session values, unless a layout file already set _config
+  QSettings settings;
+  _config.num_series = settings.value("DataStreamStress::series", _config.num_series).toInt();
+  _config.rate = settings.value("DataStreamStress::rate", _config.rate).toInt();
+  _config.pattern = settings.value("DataStreamStress::pattern", _config.pattern).toInt();
+  _config.out_of_order_percent =
+      settings.value("DataStreamStress::out_of_order", _config.out_of_order_percent).toInt();
+  _config.string_percent =
+      settings.value("DataStreamStress::strings", _config.string_percent).toInt();
+
+  StressGeneratorDialog dialog;
+  dialog.ui->spinBoxSeries->setValue(_config.num_series);
+  dialog.ui->spinBoxRate->setValue(_config.rate);
+  dialog.ui->comboBoxPattern->setCurrentIndex(_config.pattern);
+  dialog.ui->spinBoxOutOfOrder->setValue(_config.out_of_order_percent);
+  dialog.ui->spinBoxStrings->setValue(_config.string_percent);
+
+  if (dialog.exec() == QDialog::Rejected)
+  {
+    return false;
+  }
+
+  _config.num_series = dialog.ui->spinBoxSeries->value();
+  _config.rate = dialog.ui->spinBoxRate->value();
+  _config.pattern = dialog.ui->comboBoxPattern->currentIndex();
+  _config.out_of_order_percent = dialog.ui->spinBoxOutOfOrder->value();
+  _config.string_percent = dialog.ui->spinBoxStrings->value();
+
+  settings.setValue("DataStreamStress::series", _config.num_series);
+  settings.setValue("DataStreamStress::rate", _config.rate);
+  settings.setValue("DataStreamStress::pattern", _config.pattern);
+  settings.setValue("DataStreamStress::out_of_order", _config.out_of_order_percent);
+  settings.setValue("DataStreamStress::strings", _config.string_percent);
+
+  const int num_strings = (_config.num_series * _config.string_percent) / 100;
+  const int num_numeric = _config.num_series - num_strings;
+
+  _numeric_names.clear();
+  _waveforms.clear();
+  _string_names.clear();
+
+  srand(0);  // same waveforms on every run, so two sessions are comparable
+  for (int i = 0; i < num_numeric; i++)
+  {
+    _numeric_names.push_back("stress/num_" + std::to_string(i));
+    Waveform param;
+    param.A = 6 * ((double)rand() / (double)RAND_MAX) - 3;
+    param.B = 3 * ((double)rand() / (double)RAND_MAX);
+    param.C = 3 * ((double)rand() / (double)RAND_MAX);
+    param.D = 20 * ((double)rand() / (double)RAND_MAX);
+    _waveforms.push_back(param);
+    dataMap().addNumeric(_numeric_names.back());
+  }
+  for (int i = 0; i < num_strings; i++)
+  {
+    _string_names.push_back("stress/str_" + std::to_string(i));
+    dataMap().addStringSeries(_string_names.back());
+  }
+
+  _running = true;
+  const auto thread_config = ingestThreadConfig();
+  _thread = std::thread([this, thread_config]() { generationLoop(thread_config); });
+  return true;
+}
+
+void DataStreamStress::shutdown()
+{
+  _running = false;
+  if (_thread.joinable())
+  {
+    _thread.join();
+  }
+}
+
+bool DataStreamStress::xmlSaveState(QDomDocument& doc, QDomElement& parent_element) const
+{
+  QDomElement elem = doc.createElement("config");
+  elem.setAttribute("series", _config.num_series);
+  elem.setAttribute("rate", _config.rate);
+  elem.setAttribute("pattern", _config.pattern);
+  elem.setAttribute("out_of_order", _config.out_of_order_percent);
+  elem.setAttribute("strings", _config.string_percent);
+  parent_element.appendChild(elem);
+  return true;
+}
+
+bool DataStreamStress::xmlLoadState(const QDomElement& parent_element)
+{
+  QDomElement elem = parent_element.firstChildElement("config");
+  if (!elem.isNull())
+  {
+    _config.num_series = elem.attribute("series", "100").toInt();
+    _config.rate = elem.attribute("rate", "1000").toInt();
+    _config.pattern = elem.attribute("pattern", "0").toInt();
+    _config.out_of_order_percent = elem.attribute("out_of_order", "0").toInt();
+    _config.string_percent = elem.attribute("strings", "0").toInt();
+  }
+  return true;
+}
+
+double DataStreamStress::patternFactor(int pattern, double t)
+{
+  switch (pattern)
+  {
+    case BURSTS:
+      // the whole per-second budget lands in the first 100 ms of each
+      // second: same average rate, 10x the instantaneous one
+      return (std::fmod(t, 1.0) < 0.1) ? 10.0 : 0.0;
+    case RAMP:
+      // sawtooth from 0 to 2x over a 4 second period
+      return 2.0 * std::fmod(t, 4.0) / 4.0;
+    case STEADY:
+    default:
+      return 1.0;
+  }
+}
+
+void DataStreamStress::generationLoop(PJ::DataStreamer::IngestThreadConfig thread_config)
+{
+  applyToCurrentThread(thread_config);
+
+  using namespace std::chrono;
+  const auto initial_time = high_resolution_clock::now();
+  const double offset = duration_cast<duration<double>>(initial_time.time_since_epoch()).count();
+
+  // more than half a second of backlog per tick means the consumer cannot
+  // keep up: shed the excess and count it, instead of growing without bound
+  const size_t shed_limit = std::max<size_t>(1, size_t(_config.rate) / 2);
+
+  std::vector<double> xs;
+  std::vector<double> ys;
+  xs.reserve(shed_limit);
+  ys.reserve(shed_limit);
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> chance(0.0, 100.0);
+  std::uniform_real_distribution<double> backward(0.001, 0.05);
+
+  static const std::string tokens[] = { "OK", "WARN", "FAIL" };
+
+  double budget = 0;
+  double prev_t = 0;
+  auto next_tick = initial_time;
+
+  while (_running)
+  {
+    next_tick += milliseconds(10);
+    std::this_thread::sleep_until(next_tick);
+
+    const double t = duration_cast<duration<double>>(high_resolution_clock::now() - initial_time)
+                         .count();
+    budget += double(_config.rate) * patternFactor(_config.pattern, t) * (t - prev_t);
+
+    size_t count = size_t(budget);
+    budget -= double(count);
+
+    if (count > shed_limit)
+    {
+      const uint64_t shed = count - shed_limit;
+      streamStats().messages_dropped.fetch_add(
+          shed * (_numeric_names.size() + _string_names.size()), std::memory_order_relaxed);
+      count = shed_limit;
+    }
+    if (count == 0)
+    {
+      prev_t = t;
+      continue;
+    }
+
+    // timestamps spread evenly over the tick; the configured fraction is
+    // pushed back in time, forcing the sorted-insertion path downstream
+    xs.resize(count);
+    ys.resize(count);
+    const double spacing = (t - prev_t) / double(count);
+    for (size_t i = 0; i < count; i++)
+    {
+      xs[i] = offset + prev_t + spacing * double(i + 1);
+      if (_config.out_of_order_percent > 0 && chance(rng) < double(_config.out_of_order_percent))
+      {
+        xs[i] -= backward(rng);
+      }
+    }
+    prev_t = t;
+
+    const auto gen_start = steady_clock::now();
+    {
+      std::lock_guard<std::mutex> lock(mutex());
+      for (size_t s = 0; s < _numeric_names.size(); s++)
+      {
+        const Waveform& param = _waveforms[s];
+        for (size_t i = 0; i < count; i++)
+        {
+          ys[i] = param.A * std::sin(param.B * xs[i] + param.C) + param.D;
+        }
+        dataMap().appendBatch(_numeric_names[s], xs.data(), ys.data(), count);
+      }
+      for (const auto& name : _string_names)
+      {
+        auto& series = dataMap().strings.find(name)->second;
+        for (size_t i = 0; i < count; i++)
+        {
+          series.pushBack({ xs[i], tokens[i % 3] });
+        }
+      }
+    }
+    const uint64_t total = uint64_t(count) * (_numeric_names.size() + _string_names.size());
+    streamStats().messages_received.fetch_add(total, std::memory_order_relaxed);
+    recordParseTime(duration_cast<nanoseconds>(steady_clock::now() - gen_start).count(), total);
+
+    emit dataReceived();
+  }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QtPlugin>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include "PlotJuggler/datastreamer_base.h"
+
+/**
+ * Synthetic load generator for the streaming pipeline. Unlike the Dummy
+ * Streamer, everything is configurable: number of series, per-series
+ * sample rate (up to millions of samples per second), the emission
+ * pattern (steady / bursts / sawtooth ramp), the fraction of samples
+ * pushed with an out-of-order timestamp, and the numeric / string series
+ * mix. It reproduces production ingest saturation on a dev box, and the
+ * usual stats series under "__plotjuggler/stats/" quantify the drop rate
+ * when the generator cannot keep up.
+ */
+class DataStreamStress : public PJ::DataStreamer
+{
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID "facontidavide.PlotJuggler3.DataStreamer")
+  Q_INTERFACES(PJ::DataStreamer)
+
+public:
+  DataStreamStress() = default;
+
+  virtual bool start(QStringList*) override;
+
+  virtual void shutdown() override;
+
+  virtual bool isRunning() const override
+  {
+    return _running;
+  }
+
+  virtual ~DataStreamStress() override;
+
+  virtual const char* name() const override
+  {
+    return "Stress Generator";
+  }
+
+  virtual bool isDebugPlugin() override
+  {
+    return true;
+  }
+
+  virtual bool xmlSaveState(QDomDocument& doc, QDomElement& parent_element) const override;
+
+  virtual bool xmlLoadState(const QDomElement& parent_element) override;
+
+private:
+  enum Pattern
+  {
+    STEADY = 0,
+    BURSTS = 1,
+    RAMP = 2
+  };
+
+  struct Config
+  {
+    int num_series = 100;
+    int rate = 1000;  ///< samples per second, per series
+    int pattern = STEADY;
+    int out_of_order_percent = 0;
+    int string_percent = 0;  ///< share of the series that carry strings
+  };
+
+  /// Emission rate multiplier of the configured pattern at time `t`
+  /// (seconds since start). Averages to ~1 over a period for all patterns.
+  static double patternFactor(int pattern, double t);
+
+  void generationLoop(PJ::DataStreamer::IngestThreadConfig thread_config);
+
+  Config _config;
+
+  std::thread _thread;
+  std::atomic<bool> _running{ false };
+
+  // per-series waveform parameters, like the Dummy Streamer
+  struct Waveform
+  {
+    double A, B, C, D;
+  };
+  std::vector<std::string> _numeric_names;
+  std::vector<Waveform> _waveforms;
+  std::vector<std::string> _string_names;
+};
@@ -32,6 +32,17 @@ THE SOFTWARE.
 
 #include "ui_udp_server.h"
 #include "PlotJuggler/dialog_utils.h"
+#include "PlotJuggler/util/coarse_clock.hpp"
+
+#ifdef __linux__
+#include <algorithm>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+#endif
 
 class UdpServerDialog : public QDialog
 {
@@ -153,13 +164,62 @@ bool UDP_Server::start(QStringList*)
   bool success = true;
   success &= !address.isNull();
 
-  _udp_socket = new QUdpSocket();
   int ip_version = 4;
   if (address.protocol() == QAbstractSocket::IPv6Protocol)
   {
     ip_version = 6;
   }
 
+#ifdef __linux__
+  // Unicast can be sharded over several SO_REUSEPORT sockets, each with
+  // its own drain thread: the kernel then steers each sender flow to one
+  // of the receive queues instead of funneling everything into a single
+  // socket buffer.
+  const int num_sockets = std::max(1, settings.value("UDP_Server::reuseport_sockets", 1).toInt());
+  if (success && !address.isMulticast() && num_sockets > 1)
+  {
+    success &= openShardedSockets(address, uint16_t(port), num_sockets);
+
+    _running = success;
+    if (success)
+    {
+      _stop_receiving = false;
+      const auto thread_config = ingestThreadConfig();
+      for (size_t i = 0; i < _sharded_fds.size(); i++)
+      {
+        auto shard_config = thread_config;
+        if (!thread_config.cpu_affinity.empty())
+        {
+          // one CPU per drain thread, round-robin over the configured list
+          const size_t cpu_index = i % thread_config.cpu_affinity.size();
+          shard_config.cpu_affinity = { thread_config.cpu_affinity[cpu_index] };
+        }
+        const int fd = _sharded_fds[i];
+        _receive_threads.emplace_back(
+            [this, fd, shard_config]() { receiveLoop(fd, shard_config); });
+      }
+      qDebug() << tr("IPv%3 UDP listening on (%1, %2) with %4 SO_REUSEPORT sockets")
+                      .arg(address_str)
+                      .arg(port)
+                      .arg(ip_version)
+                      .arg(num_sockets);
+    }
+    else
+    {
+      QMessageBox::warning(nullptr, tr("UDP Server"),
+                           tr("Couldn't bind %3 SO_REUSEPORT sockets at (%1, %2)")
+                               .arg(address_str)
+                               .arg(port)
+                               .arg(num_sockets),
+                           QMessageBox::Ok);
+      shutdown();
+    }
+    return _running;
+  }
+#endif
+
+  _udp_socket = new QUdpSocket();
+
   if (!address.isMulticast())
   {
     success &= _udp_socket->bind(address, port);
@@ -209,7 +269,18 @@ bool UDP_Server::start(QStringList*)
 
   _running = true;
 
+#ifdef __linux__
+  if (success)
+  {
+    _stop_receiving = false;
+    const int socket_fd = int(_udp_socket->socketDescriptor());
+    const auto thread_config = ingestThreadConfig();
+    _receive_threads.emplace_back(
+        [this, socket_fd, thread_config]() { receiveLoop(socket_fd, thread_config); });
+  }
+#else
   connect(_udp_socket, &QUdpSocket::readyRead, this, &UDP_Server::processMessage);
+#endif
 
   if (success)
   {
@@ -231,31 +302,197 @@ bool UDP_Server::start(QStringList*)
 
 void UDP_Server::shutdown()
 {
-  if (_running && _udp_socket)
+#ifdef __linux__
+  _stop_receiving = true;
+  for (auto& thread : _receive_threads)
+  {
+    if (thread.joinable())
+    {
+      thread.join();
+    }
+  }
+  _receive_threads.clear();
+  closeShardedSockets();
+#endif
+  if (_udp_socket)
   {
     _udp_socket->deleteLater();
-    _running = false;
+    _udp_socket = nullptr;
+  }
+  _running = false;
+}
+
+#ifdef __linux__
+bool UDP_Server::openShardedSockets(const QHostAddress& address, uint16_t port, int count)
+{
+  const bool ipv6 = (address.protocol() == QAbstractSocket::IPv6Protocol);
+
+  for (int i = 0; i < count; i++)
+  {
+    const int fd = ::socket(ipv6 ? AF_INET6 : AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+      closeShardedSockets();
+      return false;
+    }
+    _sharded_fds.push_back(fd);
+
+    // must be set on every socket of the group, before bind()
+    const int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+
+    sockaddr_storage bind_addr = {};
+    socklen_t addr_len = 0;
+    if (ipv6)
+    {
+      auto* addr6 = reinterpret_cast<sockaddr_in6*>(&bind_addr);
+      addr6->sin6_family = AF_INET6;
+      addr6->sin6_port = htons(port);
+      const Q_IPV6ADDR ip6 = address.toIPv6Address();
+      std::memcpy(&addr6->sin6_addr, &ip6, sizeof(addr6->sin6_addr));
+      addr_len = sizeof(sockaddr_in6);
+    }
+    else
+    {
+      auto* addr4 = reinterpret_cast<sockaddr_in*>(&bind_addr);
+      addr4->sin_family = AF_INET;
+      addr4->sin_port = htons(port);
+      addr4->sin_addr.s_addr = htonl(address.toIPv4Address());
+      addr_len = sizeof(sockaddr_in);
+    }
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&bind_addr), addr_len) != 0)
+    {
+      closeShardedSockets();
+      return false;
+    }
   }
+  return true;
 }
 
+void UDP_Server::closeShardedSockets()
+{
+  for (const int fd : _sharded_fds)
+  {
+    ::close(fd);
+  }
+  _sharded_fds.clear();
+}
+
+void UDP_Server::receiveLoop(int socket_fd, IngestThreadConfig thread_config)
+{
+  applyToCurrentThread(thread_config);
+  if (thread_config.busy_poll)
+  {
+    // also ask the kernel to busy-poll the receive queue, when allowed
+    const int busy_poll_usec = 50;
+    ::setsockopt(socket_fd, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_usec, sizeof(busy_poll_usec));
+  }
+
+  // pre-allocated buffers, reused for every batch
+  constexpr int BATCH_SIZE = 64;
+  constexpr size_t BUFFER_SIZE = 64 * 1024;  // maximum UDP payload
+
+  std::vector<std::vector<uint8_t>> buffers(BATCH_SIZE, std::vector<uint8_t>(BUFFER_SIZE));
+  iovec iovecs[BATCH_SIZE];
+  mmsghdr messages[BATCH_SIZE];
+  memset(messages, 0, sizeof(messages));
+
+  for (int i = 0; i < BATCH_SIZE; i++)
+  {
+    iovecs[i].iov_base = buffers[i].data();
+    iovecs[i].iov_len = BUFFER_SIZE;
+    messages[i].msg_hdr.msg_iov = &iovecs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  pollfd poll_fd = {};
+  poll_fd.fd = socket_fd;
+  poll_fd.events = POLLIN;
+
+  // one wall-clock read per recvmmsg() batch; the datagrams inside it
+  // get interpolated stamps instead of one clock call each
+  PJ::CoarseArrivalClock arrival_clock;
+
+  // with busy-poll the thread spins instead of sleeping in poll(): lowest
+  // latency, but it burns a core, so pair it with a dedicated CPU
+  const int poll_timeout_ms = thread_config.busy_poll ? 0 : 100;
+
+  while (!_stop_receiving)
+  {
+    // bounded wait so that shutdown() is noticed promptly
+    if (::poll(&poll_fd, 1, poll_timeout_ms) <= 0)
+    {
+      continue;
+    }
+
+    const int received = ::recvmmsg(socket_fd, messages, BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    if (received <= 0)
+    {
+      continue;
+    }
+
+    using namespace std::chrono;
+    arrival_clock.refresh();
+
+    streamStats().messages_received.fetch_add(received, std::memory_order_relaxed);
+
+    try
+    {
+      const auto parse_start = steady_clock::now();
+      std::lock_guard<std::mutex> lock(mutex());
+      // one lock per batch instead of one per datagram
+      for (int i = 0; i < received; i++)
+      {
+        MessageRef msg(buffers[i].data(), messages[i].msg_len);
+        parseOrSpool(*_parser, msg, arrival_clock.batchStamp(i, received));
+      }
+      if (!isUiPaused())
+      {
+        recordParseTime(duration_cast<nanoseconds>(steady_clock::now() - parse_start).count(),
+                        received);
+      }
+    }
+    catch (std::exception& err)
+    {
+      qWarning() << tr("UDP Server: problem parsing the message, stopping.\n%1").arg(err.what());
+      _stop_receiving = true;
+      // notify the GUI from its own thread; it will call shutdown()
+      emit closed();
+      return;
+    }
+
+    emit dataReceived();
+  }
+}
+#endif
+
 void UDP_Server::processMessage()
 {
+  // one wall-clock read per readyRead burst instead of one per datagram
+  PJ::CoarseArrivalClock arrival_clock;
+  const double timestamp = arrival_clock.time();
+
   while (_udp_socket->hasPendingDatagrams())
   {
     QNetworkDatagram datagram = _udp_socket->receiveDatagram();
 
     using namespace std::chrono;
-    auto ts = high_resolution_clock::now().time_since_epoch();
-    double timestamp = 1e-6 * double(duration_cast<microseconds>(ts).count());
-
     QByteArray m = datagram.data();
     MessageRef msg(reinterpret_cast<uint8_t*>(m.data()), m.count());
 
+    streamStats().messages_received.fetch_add(1, std::memory_order_relaxed);
+
     try
     {
+      const auto parse_start = steady_clock::now();
       std::lock_guard<std::mutex> lock(mutex());
       // important use the mutex to protect any access to the data
-      _parser->parseMessage(msg, timestamp);
+      parseOrSpool(*_parser, msg, timestamp);
+      if (!isUiPaused())
+      {
+        recordParseTime(duration_cast<nanoseconds>(steady_clock::now() - parse_start).count());
+      }
     }
     catch (std::exception& err)
     {
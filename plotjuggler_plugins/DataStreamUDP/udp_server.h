@@ -18,7 +18,9 @@ THE SOFTWARE.
 
 #include <QUdpSocket>
 #include <QtPlugin>
+#include <atomic>
 #include <thread>
+#include <vector>
 #include "PlotJuggler/datastreamer_base.h"
 #include "PlotJuggler/messageparser_base.h"
 
@@ -56,9 +58,27 @@ public:
 
 private:
   bool _running;
-  QUdpSocket* _udp_socket;
+  QUdpSocket* _udp_socket = nullptr;
   PJ::MessageParserPtr _parser;
 
+#ifdef __linux__
+  // Batch receive path: a dedicated thread drains the socket with
+  // recvmmsg() into pre-allocated buffers, bypassing the Qt event loop
+  // and the per-datagram QNetworkDatagram allocation.
+  void receiveLoop(int socket_fd, IngestThreadConfig thread_config);
+
+  // Sharded receive path for unicast: N sockets bound to the same port
+  // with SO_REUSEPORT, each drained by its own thread, so the kernel
+  // spreads multi-sender traffic over as many receive queues. Enabled by
+  // setting "UDP_Server::reuseport_sockets" to more than 1.
+  bool openShardedSockets(const QHostAddress& address, uint16_t port, int count);
+  void closeShardedSockets();
+
+  std::vector<std::thread> _receive_threads;
+  std::vector<int> _sharded_fds;
+  std::atomic<bool> _stop_receiving{ false };
+#endif
+
 private slots:
 
   void processMessage();
@@ -26,7 +26,10 @@ THE SOFTWARE.
 #include <QWebSocket>
 #include <QIntValidator>
 #include <QMessageBox>
+#include <QDateTime>
+#include <algorithm>
 #include <chrono>
+#include <vector>
 
 #include "ui_websocket_server.h"
 #include "PlotJuggler/dialog_utils.h"
@@ -59,6 +62,13 @@ WebsocketServer::WebsocketServer()
   : _running(false), _server("plotJuggler", QWebSocketServer::NonSecureMode)
 {
   connect(&_server, &QWebSocketServer::newConnection, this, &WebsocketServer::onNewConnection);
+
+  // zero-interval single-shot: fires once the event loop has delivered all
+  // the socket events currently queued, so one flush drains many frames
+  _flush_timer = new QTimer(this);
+  _flush_timer->setSingleShot(true);
+  _flush_timer->setInterval(0);
+  connect(_flush_timer, &QTimer::timeout, this, &WebsocketServer::flushPendingMessages);
 }
 
 WebsocketServer::~WebsocketServer()
@@ -104,8 +114,11 @@ bool WebsocketServer::start(QStringList*)
     protocol = parserFactories()->begin()->first;
   }
   int port = settings.value("WebsocketServer::port", 9871).toInt();
+  int max_rate = settings.value("WebsocketServer::max_rate", 0).toInt();
 
   dialog->ui->lineEditPort->setText(QString::number(port));
+  dialog->ui->lineEditMaxRate->setValidator(new QIntValidator());
+  dialog->ui->lineEditMaxRate->setText(QString::number(max_rate));
 
   ParserFactoryPlugin::Ptr parser_creator;
 
@@ -134,13 +147,21 @@ bool WebsocketServer::start(QStringList*)
 
   port = dialog->ui->lineEditPort->text().toUShort(&ok);
   protocol = dialog->ui->comboBoxProtocol->currentText();
+  max_rate = dialog->ui->lineEditMaxRate->text().toInt();
   dialog->deleteLater();
 
   _parser = parser_creator->createParser({}, {}, {}, dataMap());
 
+  _max_messages_per_sec = std::max(0, max_rate);
+  _messages_this_window = 0;
+  _window_start_ms = 0;
+  _dropped_messages = 0;
+  _pending_messages.clear();
+
   // save back to service
   settings.setValue("WebsocketServer::protocol", protocol);
   settings.setValue("WebsocketServer::port", port);
+  settings.setValue("WebsocketServer::max_rate", _max_messages_per_sec);
 
   if (_server.listen(QHostAddress::Any, port))
   {
@@ -161,6 +182,8 @@ void WebsocketServer::shutdown()
 {
   if (_running)
   {
+    _flush_timer->stop();
+    _pending_messages.clear();
     socketDisconnected();
     _server.close();
     _running = false;
@@ -177,21 +200,66 @@ void WebsocketServer::onNewConnection()
 
 void WebsocketServer::processMessage(QString message)
 {
-  std::lock_guard<std::mutex> lock(mutex());
+  // receive path stays cheap: no lock, no parse. Messages accumulate and
+  // are parsed together once the event loop has drained the socket events.
+  if (_max_messages_per_sec > 0)
+  {
+    const qint64 now_ms = QDateTime::currentMSecsSinceEpoch();
+    if (now_ms - _window_start_ms >= 1000)
+    {
+      if (_dropped_messages > 0)
+      {
+        qDebug() << "Websocket server: dropped" << _dropped_messages
+                 << "messages over the configured rate of" << _max_messages_per_sec << "msg/s";
+        _dropped_messages = 0;
+      }
+      _window_start_ms = now_ms;
+      _messages_this_window = 0;
+    }
+    if (_messages_this_window >= _max_messages_per_sec)
+    {
+      _dropped_messages++;
+      return;
+    }
+    _messages_this_window++;
+  }
+
+  _pending_messages.push_back(message.toLocal8Bit());
+  if (!_flush_timer->isActive())
+  {
+    _flush_timer->start();
+  }
+}
+
+void WebsocketServer::flushPendingMessages()
+{
+  if (_pending_messages.empty() || !_parser)
+  {
+    return;
+  }
 
   using namespace std::chrono;
   auto ts = high_resolution_clock::now().time_since_epoch();
-  double timestamp = 1e-6 * double(duration_cast<microseconds>(ts).count());
+  const double timestamp = 1e-6 * double(duration_cast<microseconds>(ts).count());
 
-  QByteArray bmsg = message.toLocal8Bit();
-  MessageRef msg(reinterpret_cast<uint8_t*>(bmsg.data()), bmsg.size());
+  std::vector<MessageRef> refs;
+  std::vector<double> timestamps;
+  refs.reserve(_pending_messages.size());
+  timestamps.reserve(_pending_messages.size());
+  for (const auto& bmsg : _pending_messages)
+  {
+    refs.emplace_back(reinterpret_cast<const uint8_t*>(bmsg.constData()), size_t(bmsg.size()));
+    timestamps.push_back(timestamp);
+  }
 
   try
   {
-    _parser->parseMessage(msg, timestamp);
+    std::lock_guard<std::mutex> lock(mutex());
+    parseOrSpoolBatch(*_parser, refs.data(), timestamps.data(), refs.size());
   }
   catch (std::exception& err)
   {
+    _pending_messages.clear();
     QMessageBox::warning(nullptr, tr("Websocket Server"),
                          tr("Problem parsing the message. Websocket Server will be "
                             "stopped.\n%1")
@@ -201,8 +269,8 @@ void WebsocketServer::processMessage(QString message)
     emit closed();
     return;
   }
+  _pending_messages.clear();
   emit dataReceived();
-  return;
 }
 
 void WebsocketServer::socketDisconnected()
@@ -19,9 +19,11 @@ THE SOFTWARE.
 #include <QWebSocketServer>
 #include <QWebSocket>
 #include <QList>
+#include <QTimer>
 
 #include <QtPlugin>
 #include <thread>
+#include <vector>
 #include "PlotJuggler/datastreamer_base.h"
 #include "PlotJuggler/messageparser_base.h"
 
@@ -63,6 +65,20 @@ private:
   QWebSocketServer _server;
   PJ::MessageParserPtr _parser;
 
+  /// Frames received since the last flush. They are parsed all at once per
+  /// event-loop wakeup (parseMessageBatch under a single mutex lock), instead
+  /// of paying lock + signal per frame.
+  std::vector<QByteArray> _pending_messages;
+  QTimer* _flush_timer = nullptr;
+
+  // message budget of the current 1-second window; 0 disables throttling
+  int _max_messages_per_sec = 0;
+  int _messages_this_window = 0;
+  qint64 _window_start_ms = 0;
+  uint64_t _dropped_messages = 0;
+
+  void flushPendingMessages();
+
 private slots:
   void onNewConnection();
   void processMessage(QString message);
@@ -10,6 +10,7 @@
 #include <QMessageBox>
 #include <QSettings>
 #include <QThread>
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 
@@ -141,8 +142,6 @@ bool DataStreamZMQ::start(QStringList*)
   topics = dialog->ui->lineEditTopics->text();
   _is_connect = dialog->ui->radioConnect->isChecked();
 
-  _parser = _parser_creator->createParser({}, {}, {}, dataMap());
-
   // save back to service
   settings.setValue("ZMQ_Subscriber::address", address);
   settings.setValue("ZMQ_Subscriber::protocol", protocol);
@@ -164,10 +163,29 @@ bool DataStreamZMQ::start(QStringList*)
   parseTopicFilters(topics);
   subscribeTopics();
 
-  // Add a parser for each topic
+  // Per-topic flow control for slow-consumer scenarios (see TopicFlowMode)
+  _conflate_prefixes = SplitTopicList(settings.value("ZMQ_Subscriber::conflate_topics").toString());
+  _decimate_prefixes = SplitTopicList(settings.value("ZMQ_Subscriber::decimate_topics").toString());
+  const double decimate_hz = settings.value("ZMQ_Subscriber::decimate_hz", 10.0).toDouble();
+  _decimate_period = (decimate_hz > 0) ? 1.0 / decimate_hz : 0.0;
+  _decimate_last_kept.clear();
+  _flow_mode_cache.clear();
+
+  // Parsing workers: topics are partitioned among them by hash. They share
+  // the process-wide thread pool, so size them like it instead of spawning
+  // our own threads.
+  const size_t num_workers = PJ::ThreadPool::instance().threadCount();
+  _workers.clear();
+  for (size_t i = 0; i < num_workers; i++)
+  {
+    _workers.push_back(std::make_unique<ParserWorker>(4096));
+  }
+
+  // Add a parser for each known topic (still on the GUI thread here)
   for (const auto& topic : _topic_filters)
   {
-    _parsers[topic] = _parser_creator->createParser(topic, {}, {}, dataMap());
+    auto& worker = *_workers[std::hash<std::string>{}(topic) % _workers.size()];
+    worker.parsers[topic] = _parser_creator->createParser(topic, {}, {}, worker.local_data);
   }
 
   _zmq_socket.set(zmq::sockopt::rcvtimeo, 100);
@@ -192,6 +210,14 @@ void DataStreamZMQ::shutdown()
       _receive_thread.join();
     }
 
+    // the receive thread is joined, so no new drain task can be scheduled:
+    // wait for the in-flight ones to empty the queues
+    while (_tasks_in_flight.load(std::memory_order_acquire) > 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    _workers.clear();
+
     unsubscribeTopics();
 
     if (_is_connect)
@@ -207,6 +233,8 @@ void DataStreamZMQ::shutdown()
 
 void DataStreamZMQ::receiveLoop()
 {
+  applyToCurrentThread(ingestThreadConfig());
+
   while (_running)
   {
     zmq::message_t recv_msg;
@@ -235,8 +263,9 @@ void DataStreamZMQ::receiveLoop()
       }
     }
 
-    PJ::MessageRef msg{ PJ::MessageRef(reinterpret_cast<uint8_t*>(recv_msg.data()),
-                                       recv_msg.size()) };
+    // Copy the payload now: receiving the (optional) timestamp part below
+    // rebuilds recv_msg and would invalidate the data pointer
+    std::string payload(reinterpret_cast<const char*>(recv_msg.data()), recv_msg.size());
 
     // If there are more parts, then it is the timestamp
     double timestamp = 0.0;
@@ -261,22 +290,7 @@ void DataStreamZMQ::receiveLoop()
                   1e-6;
     }
 
-    // Parse the message without a topic if it is empty
-    if (topic.empty())
-    {
-      if (parseMessage(msg, timestamp))
-      {
-        emit this->dataReceived();
-      }
-    }
-    // Otherwise, parse the message with the topic
-    else
-    {
-      if (parseMessage(topic, msg, timestamp))
-      {
-        emit this->dataReceived();
-      }
-    }
+    dispatchMessage(std::move(topic), std::move(payload), timestamp);
 
     // Extinguish remaining parts (if any)
     while (recv_msg.more())
@@ -287,43 +301,105 @@ void DataStreamZMQ::receiveLoop()
   }
 }
 
-bool DataStreamZMQ::parseMessage(const PJ::MessageRef& msg, double& timestamp)
+DataStreamZMQ::TopicFlowMode DataStreamZMQ::topicFlowMode(const std::string& topic)
 {
-  try
+  auto cached = _flow_mode_cache.find(topic);
+  if (cached != _flow_mode_cache.end())
   {
-    std::lock_guard<std::mutex> lock(mutex());
-    _parser->parseMessage(msg, timestamp);
-    return true;
+    return cached->second;
   }
-  catch (...)
-  {
+
+  auto matches = [&topic](const std::vector<std::string>& prefixes) {
+    for (const auto& prefix : prefixes)
+    {
+      if (prefix == "*" || topic.compare(0, prefix.size(), prefix) == 0)
+      {
+        return true;
+      }
+    }
     return false;
+  };
+
+  TopicFlowMode mode = TopicFlowMode::KEEP_ALL;
+  if (matches(_conflate_prefixes))
+  {
+    mode = TopicFlowMode::CONFLATE;
+  }
+  else if (matches(_decimate_prefixes))
+  {
+    mode = TopicFlowMode::DECIMATE;
   }
+  _flow_mode_cache[topic] = mode;
+  return mode;
 }
 
-PJ::MessageParserPtr DataStreamZMQ::ensureTopicParser(const std::string& topic)
+void DataStreamZMQ::dispatchMessage(std::string topic, std::string payload, double timestamp)
 {
+  const TopicFlowMode mode = topicFlowMode(topic);
+
+  if (mode == TopicFlowMode::DECIMATE && _decimate_period > 0)
   {
-    std::lock_guard<std::mutex> lock(mutex());
-    auto it = _parsers.find(topic);
-    if (it != _parsers.end())
+    double& last_kept = _decimate_last_kept[topic];
+    const double elapsed = timestamp - last_kept;
+    if (elapsed >= 0 && elapsed < _decimate_period)
     {
-      return it->second;
+      return;  // rate-limited: this sample is not plotted
     }
+    // accepted, or time jumped backwards (publisher restart): reset
+    last_kept = timestamp;
   }
 
-  PJ::MessageParserPtr parser;
+  auto& worker = *_workers[std::hash<std::string>{}(topic) % _workers.size()];
+
+  Job job;
+  job.topic = std::move(topic);
+  job.payload = std::move(payload);
+  job.timestamp = timestamp;
 
-  auto create_parser = [this, &parser, topic]() {
-    std::lock_guard<std::mutex> lock(mutex());
-    auto it = _parsers.find(topic);
-    if (it == _parsers.end())
+  if (mode == TopicFlowMode::CONFLATE)
+  {
+    // replace whatever is pending: a burst degrades to "latest value
+    // wins" instead of an ever-growing backlog
     {
-      it = _parsers.emplace(topic, _parser_creator->createParser(topic, {}, {}, dataMap())).first;
+      std::lock_guard<std::mutex> lock(worker.conflated_mutex);
+      worker.conflated[job.topic] = std::move(job);
     }
-    parser = it->second;
+    worker.has_conflated.store(true, std::memory_order_release);
+    scheduleDrain(worker);
+    return;
+  }
+
+  // apply backpressure instead of dropping when the worker is behind
+  while (_running && !worker.queue.push(job))
+  {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  scheduleDrain(worker);
+}
+
+void DataStreamZMQ::scheduleDrain(ParserWorker& worker)
+{
+  if (worker.task_scheduled.exchange(true))
+  {
+    return;  // a drain task for this worker is already queued or running
+  }
+  _tasks_in_flight.fetch_add(1, std::memory_order_relaxed);
+  PJ::ThreadPool::instance().submit(PJ::ThreadPool::Priority::INGEST, [this, &worker]() {
+    drainWorker(worker);
+    _tasks_in_flight.fetch_sub(1, std::memory_order_release);
+  });
+}
+
+PJ::MessageParserPtr DataStreamZMQ::createTopicParser(const std::string& topic,
+                                                      PJ::PlotDataMapRef& data)
+{
+  PJ::MessageParserPtr parser;
+
+  auto create_parser = [this, &parser, &data, topic]() {
+    parser = _parser_creator->createParser(topic, {}, {}, data);
   };
 
+  // some factories touch their options widget: create on the GUI thread
   if (QThread::currentThread() == thread())
   {
     create_parser();
@@ -336,36 +412,180 @@ PJ::MessageParserPtr DataStreamZMQ::ensureTopicParser(const std::string& topic)
   return parser;
 }
 
-bool DataStreamZMQ::parseMessage(const std::string& topic, const PJ::MessageRef& msg,
-                                 double& timestamp)
+// Append the points accumulated in a worker-local map to the shared one.
+// Must be called with the streamer mutex held.
+static void MergeParsedSamples(PJ::PlotDataMapRef& source, PJ::PlotDataMapRef& destination)
 {
-  try
+  auto copy_attributes = [](const auto& src, auto& dst) {
+    if (dst.size() == 0 && dst.attributes().empty())
+    {
+      dst.attributes() = src.attributes();
+    }
+  };
+
+  for (auto& it : source.numeric)
   {
-    auto parser = ensureTopicParser(topic);
-    std::lock_guard<std::mutex> lock(mutex());
-    parser->parseMessage(msg, timestamp);
-    return true;
+    auto& src = it.second;
+    if (src.size() == 0)
+    {
+      continue;
+    }
+    auto& dst = destination.getOrCreateNumeric(it.first);
+    copy_attributes(src, dst);
+    for (size_t i = 0; i < src.size(); i++)
+    {
+      dst.pushBack(src.at(i));
+    }
+    src.clear();
   }
-  catch (...)
+
+  for (auto& it : source.scatter_xy)
   {
-    return false;
+    auto& src = it.second;
+    if (src.size() == 0)
+    {
+      continue;
+    }
+    auto& dst = destination.getOrCreateScatterXY(it.first);
+    copy_attributes(src, dst);
+    for (size_t i = 0; i < src.size(); i++)
+    {
+      dst.pushBack(src.at(i));
+    }
+    src.clear();
+  }
+
+  for (auto& it : source.strings)
+  {
+    auto& src = it.second;
+    if (src.size() == 0)
+    {
+      continue;
+    }
+    auto& dst = destination.getOrCreateStringSeries(it.first);
+    copy_attributes(src, dst);
+    for (size_t i = 0; i < src.size(); i++)
+    {
+      const auto& point = src.at(i);
+      dst.pushBack({ point.x, src.getString(point.y) });
+    }
+    src.clear();
+  }
+
+  for (auto& it : source.user_defined)
+  {
+    auto& src = it.second;
+    if (src.size() == 0)
+    {
+      continue;
+    }
+    auto& dst = destination.getOrCreateUserDefined(it.first);
+    copy_attributes(src, dst);
+    for (size_t i = 0; i < src.size(); i++)
+    {
+      dst.pushBack(std::move(src.at(i)));
+    }
+    src.clear();
   }
 }
 
-void DataStreamZMQ::parseTopicFilters(const QString& topic_filters)
+void DataStreamZMQ::drainWorker(ParserWorker& worker)
 {
-  const QRegExp regex("(,{0,1}\\s+)|(;\\s*)");
+  // merge at most this many parsed messages per mutex acquisition
+  constexpr size_t MERGE_BATCH = 256;
 
-  if (topic_filters.trimmed().size() != 0)
+  auto parse_job = [this, &worker](Job& job) {
+    auto& parser = worker.parsers[job.topic];
+    if (!parser)
+    {
+      parser = createTopicParser(job.topic, worker.local_data);
+    }
+    try
+    {
+      PJ::MessageRef msg(reinterpret_cast<uint8_t*>(job.payload.data()), job.payload.size());
+      parser->parseMessage(msg, job.timestamp);
+      return true;
+    }
+    catch (...)
+    {
+      // malformed message: skip it, like the single-threaded path did
+      return false;
+    }
+  };
+
+  while (true)
   {
-    const auto splitted = topic_filters.split(regex);
+    Job job;
+    size_t parsed = 0;
+
+    while (parsed < MERGE_BATCH && worker.queue.pop(job))
+    {
+      if (parse_job(job))
+      {
+        parsed++;
+      }
+    }
+
+    if (worker.has_conflated.exchange(false))
+    {
+      // take the latest-value slots in one go; the receive thread may
+      // start refilling them right away
+      std::map<std::string, Job> latest;
+      {
+        std::lock_guard<std::mutex> lock(worker.conflated_mutex);
+        latest.swap(worker.conflated);
+      }
+      for (auto& it : latest)
+      {
+        if (parse_job(it.second))
+        {
+          parsed++;
+        }
+      }
+    }
+
+    if (parsed > 0)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex());
+        MergeParsedSamples(worker.local_data, dataMap());
+      }
+      emit dataReceived();
+      continue;
+    }
 
-    for (const auto& topic : splitted)
+    worker.task_scheduled.store(false);
+    // a message pushed between the last pop() and the store above saw
+    // task_scheduled still true and did not schedule: reclaim the flag
+    // and keep draining, unless another task took it first
+    const bool pending = worker.queue.sizeApprox() > 0 ||
+                         worker.has_conflated.load(std::memory_order_acquire);
+    if (!pending || worker.task_scheduled.exchange(true))
     {
-      _topic_filters.push_back(topic.toStdString());
+      return;
     }
   }
-  else
+}
+
+std::vector<std::string> DataStreamZMQ::SplitTopicList(const QString& topic_list)
+{
+  const QRegExp regex("(,{0,1}\\s+)|(;\\s*)");
+
+  std::vector<std::string> topics;
+  if (topic_list.trimmed().size() != 0)
+  {
+    for (const auto& topic : topic_list.split(regex))
+    {
+      topics.push_back(topic.toStdString());
+    }
+  }
+  return topics;
+}
+
+void DataStreamZMQ::parseTopicFilters(const QString& topic_filters)
+{
+  _topic_filters = SplitTopicList(topic_filters);
+  if (_topic_filters.empty())
   {
     _topic_filters.push_back("");
   }
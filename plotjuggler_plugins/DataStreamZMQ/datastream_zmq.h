@@ -3,10 +3,15 @@
 
 #include "PlotJuggler/datastreamer_base.h"
 #include "PlotJuggler/messageparser_base.h"
+#include "PlotJuggler/thread_pool.h"
+#include "PlotJuggler/util/spsc_queue.hpp"
 #include "ui_datastream_zmq.h"
 #include "zmq.hpp"
 #include <QtPlugin>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -52,20 +57,88 @@ public:
   }
 
 private:
+  /// A message waiting to be parsed by a worker
+  struct Job
+  {
+    std::string topic;
+    std::string payload;
+    double timestamp = 0;
+  };
+
+  /**
+   * Parsing pipeline stage: topics are assigned to workers by hash, each
+   * worker owns one parser instance per topic, all writing into a private
+   * PlotDataMapRef. Parsed samples are merged into dataMap() in batches,
+   * taking the streamer mutex once per batch instead of once per message.
+   *
+   * Workers do not own a thread: when a worker has pending messages, a
+   * drain task runs on the shared PJ::ThreadPool with INGEST priority.
+   * task_scheduled guarantees at most one drain task per worker, which
+   * keeps the queue single-consumer.
+   */
+  struct ParserWorker
+  {
+    explicit ParserWorker(size_t queue_capacity) : queue(queue_capacity)
+    {
+    }
+    PJ::SPSCQueue<Job> queue;
+    std::atomic<bool> task_scheduled{ false };
+    PJ::PlotDataMapRef local_data;
+    std::map<std::string, PJ::MessageParserPtr> parsers;
+
+    // keep-latest slot per conflated topic: the receive thread overwrites
+    // it instead of queueing, so a bursting publisher can never put the
+    // worker more than one message behind on those topics
+    std::mutex conflated_mutex;
+    std::map<std::string, Job> conflated;
+    std::atomic<bool> has_conflated{ false };
+  };
+
+  /**
+   * Flow control applied to a topic when the publisher outpaces the GUI:
+   *
+   * - KEEP_ALL: queue everything, applying backpressure (the default)
+   * - CONFLATE: keep only the latest message, older unparsed ones are
+   *   replaced ("ZMQ_Subscriber::conflate_topics")
+   * - DECIMATE: drop messages closer than 1/N seconds to the last kept
+   *   one ("ZMQ_Subscriber::decimate_topics", rate N from
+   *   "ZMQ_Subscriber::decimate_hz")
+   *
+   * Both settings hold topic prefixes, separated like the subscription
+   * filters; "*" matches every topic. Conflation wins when a topic
+   * matches both lists.
+   */
+  enum class TopicFlowMode
+  {
+    KEEP_ALL,
+    CONFLATE,
+    DECIMATE
+  };
+
+  TopicFlowMode topicFlowMode(const std::string& topic);
+
   bool _running;
   zmq::context_t _zmq_context;
   zmq::socket_t _zmq_socket;
-  PJ::MessageParserPtr _parser;
   std::string _socket_address;
   std::thread _receive_thread;
   std::vector<std::string> _topic_filters;
-  std::map<std::string, PJ::MessageParserPtr> _parsers;
+  std::vector<std::string> _conflate_prefixes;
+  std::vector<std::string> _decimate_prefixes;
+  double _decimate_period = 0;  // seconds between kept samples in DECIMATE
+  // touched by the receive thread only
+  std::map<std::string, double> _decimate_last_kept;
+  std::map<std::string, TopicFlowMode> _flow_mode_cache;
+  std::vector<std::unique_ptr<ParserWorker>> _workers;
+  std::atomic<int> _tasks_in_flight{ 0 };
   PJ::ParserFactoryPlugin::Ptr _parser_creator;
   bool _is_connect = false;
   void receiveLoop();
-  PJ::MessageParserPtr ensureTopicParser(const std::string& topic);
-  bool parseMessage(const PJ::MessageRef& msg, double& timestamp);
-  bool parseMessage(const std::string& topic, const PJ::MessageRef& msg, double& timestamp);
+  void scheduleDrain(ParserWorker& worker);
+  void drainWorker(ParserWorker& worker);
+  void dispatchMessage(std::string topic, std::string payload, double timestamp);
+  PJ::MessageParserPtr createTopicParser(const std::string& topic, PJ::PlotDataMapRef& data);
+  static std::vector<std::string> SplitTopicList(const QString& topic_list);
   void parseTopicFilters(const QString& filters);
   void subscribeTopics();
   void unsubscribeTopics();
@@ -0,0 +1,361 @@
+#include "dbc_parser.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QRegularExpression>
+#include <QSettings>
+
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+using namespace PJ;
+
+namespace
+{
+
+// SocketCAN framing constants, spelled out so that the plugin also builds
+// where <linux/can.h> is not available
+constexpr size_t CAN_FRAME_SIZE = 16;
+constexpr size_t CANFD_FRAME_SIZE = 72;
+constexpr size_t CAN_PAYLOAD_OFFSET = 8;
+constexpr uint32_t CAN_EFF_FLAG = 0x80000000u;
+constexpr uint32_t CAN_RTR_FLAG = 0x40000000u;
+constexpr uint32_t CAN_ERR_FLAG = 0x20000000u;
+
+/// One signal, compiled to a flat extraction plan. No strings are touched
+/// while decoding: the destination series is resolved on first use and
+/// cached as a pointer.
+struct SignalPlan
+{
+  std::string name;  // "<topic/><message>/<signal>"
+
+  uint16_t first_byte = 0;
+  uint8_t shift = 0;       // little endian: left-shift of the first byte
+  uint8_t drop = 0;        // big endian: bits discarded from the last byte
+  uint16_t last_byte = 0;  // big endian only
+  uint8_t length = 0;
+  uint16_t min_payload = 0;  // frames shorter than this skip the signal
+  uint64_t mask = 0;
+  uint64_t sign_bit = 0;  // 0 for unsigned signals
+  bool big_endian = false;
+  bool bit_loop = false;   // rare fallback: misaligned big endian > 8 bytes
+  uint16_t msb_start = 0;  // DBC start bit, used by the bit_loop fallback
+
+  double factor = 1.0;
+  double offset = 0.0;
+
+  int mux_value = -1;  // decode only when the multiplexer matches; -1: always
+  bool is_mux_switch = false;
+
+  PlotData* dest = nullptr;
+};
+
+struct MessagePlan
+{
+  std::string name;
+  std::vector<SignalPlan> sigs;
+  int mux_switch = -1;  // index in sigs, -1 when not multiplexed
+};
+
+uint64_t extractRaw(const SignalPlan& sig, const uint8_t* data)
+{
+  uint64_t raw = 0;
+  if (sig.bit_loop)
+  {
+    // Motorola signal spanning more than 8 bytes: walk the sawtooth bit
+    // order. Only misaligned 64 bit signals end up here.
+    int bit = sig.msb_start;
+    for (int i = 0; i < sig.length; i++)
+    {
+      raw = (raw << 1) | ((data[bit >> 3] >> (bit & 7)) & 1);
+      bit = ((bit & 7) == 0) ? bit + 15 : bit - 1;
+    }
+  }
+  else if (sig.big_endian)
+  {
+    for (size_t b = sig.first_byte; b <= sig.last_byte; b++)
+    {
+      raw = (raw << 8) | data[b];
+    }
+    raw >>= sig.drop;
+  }
+  else
+  {
+    size_t byte = sig.first_byte;
+    raw = data[byte++] >> sig.shift;
+    for (int bits_done = 8 - sig.shift; bits_done < sig.length; bits_done += 8)
+    {
+      raw |= uint64_t(data[byte++]) << bits_done;
+    }
+  }
+  return raw & sig.mask;
+}
+
+double convertRaw(const SignalPlan& sig, uint64_t raw)
+{
+  double value;
+  if (sig.sign_bit && (raw & sig.sign_bit))
+  {
+    value = double(int64_t(raw | ~sig.mask));
+  }
+  else
+  {
+    value = double(raw);
+  }
+  return value * sig.factor + sig.offset;
+}
+
+/// Parse the BO_ / SG_ sections of a DBC file into decode tables, keyed by
+/// the raw CAN id (extended ids keep the EFF bit, as in the DBC itself).
+std::unordered_map<uint32_t, MessagePlan> compileDBC(const std::string& dbc_text,
+                                                     const std::string& prefix)
+{
+  std::unordered_map<uint32_t, MessagePlan> plans;
+
+  static const QRegularExpression bo_re(R"(^BO_\s+(\d+)\s+(\w+)\s*:)");
+  static const QRegularExpression sg_re(R"(^\s*SG_\s+(\w+)\s*(M|m(\d+))?\s*:\s*)"
+                                        R"((\d+)\|(\d+)@([01])([+-])\s*)"
+                                        R"(\(\s*([^,\s]+)\s*,\s*([^)\s]+)\s*\))");
+
+  MessagePlan* current = nullptr;
+
+  const QString text = QString::fromStdString(dbc_text);
+  for (const QString& line : text.split('\n'))
+  {
+    auto bo = bo_re.match(line);
+    if (bo.hasMatch())
+    {
+      const uint32_t id = bo.captured(1).toUInt();
+      if ((id & CAN_EFF_FLAG) && (id & CAN_RTR_FLAG))
+      {
+        // VECTOR__INDEPENDENT_SIG_MSG pseudo-message
+        current = nullptr;
+        continue;
+      }
+      current = &plans[id];
+      current->name = bo.captured(2).toStdString();
+      continue;
+    }
+
+    auto sg = sg_re.match(line);
+    if (!sg.hasMatch() || !current)
+    {
+      continue;
+    }
+
+    SignalPlan sig;
+    sig.name = prefix + current->name + "/" + sg.captured(1).toStdString();
+
+    const int start = sg.captured(4).toInt();
+    const int length = sg.captured(5).toInt();
+    if (length < 1 || length > 64 || start < 0 || start >= 512)
+    {
+      continue;
+    }
+    sig.length = uint8_t(length);
+    sig.mask = (length == 64) ? ~uint64_t(0) : ((uint64_t(1) << length) - 1);
+    sig.big_endian = (sg.captured(6) == "0");
+    if (sg.captured(7) == "-")
+    {
+      sig.sign_bit = uint64_t(1) << (length - 1);
+    }
+    sig.factor = sg.captured(8).toDouble();
+    sig.offset = sg.captured(9).toDouble();
+
+    if (sig.big_endian)
+    {
+      // DBC gives the MSB position in sawtooth numbering: convert it to a
+      // position in the big-endian bit string of the payload
+      const int msb = 8 * (start / 8) + (7 - (start % 8));
+      const int lsb = msb + length - 1;
+      sig.first_byte = uint16_t(msb / 8);
+      sig.last_byte = uint16_t(lsb / 8);
+      sig.drop = uint8_t(7 - (lsb % 8));
+      sig.min_payload = sig.last_byte + 1;
+      if (sig.last_byte - sig.first_byte >= 8)
+      {
+        sig.bit_loop = true;
+        sig.msb_start = uint16_t(start);
+      }
+    }
+    else
+    {
+      sig.first_byte = uint16_t(start / 8);
+      sig.shift = uint8_t(start % 8);
+      sig.min_payload = uint16_t((start + length + 7) / 8);
+    }
+
+    if (sg.captured(2) == "M")
+    {
+      sig.is_mux_switch = true;
+      current->mux_switch = int(current->sigs.size());
+    }
+    else if (!sg.captured(3).isEmpty())
+    {
+      sig.mux_value = sg.captured(3).toInt();
+    }
+    current->sigs.push_back(std::move(sig));
+  }
+
+  return plans;
+}
+
+class DBCMessageParser : public MessageParser
+{
+public:
+  DBCMessageParser(const std::string& topic_name, const std::string& dbc_text,
+                   PlotDataMapRef& data)
+    : MessageParser(topic_name, data)
+  {
+    const std::string prefix = topic_name.empty() ? "" : topic_name + "/";
+    _plans = compileDBC(dbc_text, prefix);
+  }
+
+  bool parseMessage(const MessageRef msg, double& timestamp) override
+  {
+    const uint8_t* ptr = msg.data();
+    const size_t size = msg.size();
+
+    uint32_t can_id = 0;
+    const uint8_t* payload = nullptr;
+    size_t payload_size = 0;
+
+    if (size == CAN_FRAME_SIZE || size == CANFD_FRAME_SIZE)
+    {
+      // SocketCAN layout: id (host order, here LE), len, flags/pad, data
+      std::memcpy(&can_id, ptr, sizeof(can_id));
+      payload = ptr + CAN_PAYLOAD_OFFSET;
+      payload_size = std::min<size_t>(ptr[4], size - CAN_PAYLOAD_OFFSET);
+    }
+    else if (size > sizeof(can_id))
+    {
+      std::memcpy(&can_id, ptr, sizeof(can_id));
+      payload = ptr + sizeof(can_id);
+      payload_size = size - sizeof(can_id);
+    }
+    else
+    {
+      return false;
+    }
+
+    if (can_id & (CAN_RTR_FLAG | CAN_ERR_FLAG))
+    {
+      return true;  // remote / error frames carry no signals
+    }
+
+    auto it = _plans.find(can_id & (CAN_EFF_FLAG | 0x1FFFFFFFu));
+    if (it == _plans.end())
+    {
+      return true;  // id not in the database
+    }
+    MessagePlan& plan = it->second;
+
+    int64_t mux = -1;
+    if (plan.mux_switch >= 0)
+    {
+      const SignalPlan& sw = plan.sigs[plan.mux_switch];
+      if (payload_size >= sw.min_payload)
+      {
+        mux = int64_t(extractRaw(sw, payload));
+      }
+    }
+
+    for (auto& sig : plan.sigs)
+    {
+      if (payload_size < sig.min_payload)
+      {
+        continue;
+      }
+      if (sig.mux_value >= 0 && sig.mux_value != mux)
+      {
+        continue;
+      }
+      if (!sig.dest)
+      {
+        sig.dest = &getSeries(sig.name);
+      }
+      sig.dest->pushBack({ timestamp, convertRaw(sig, extractRaw(sig, payload)) });
+    }
+    return true;
+  }
+
+private:
+  std::unordered_map<uint32_t, MessagePlan> _plans;
+};
+
+}  // namespace
+
+ParserDBC::ParserDBC()
+{
+  _widget = new QWidget(nullptr);
+  auto layout = new QHBoxLayout(_widget);
+  layout->setMargin(0);
+
+  _file_edit = new QLineEdit(_widget);
+  _file_edit->setReadOnly(true);
+  _file_edit->setPlaceholderText(tr("No DBC file loaded"));
+  layout->addWidget(_file_edit);
+
+  auto button = new QPushButton(tr("Load DBC..."), _widget);
+  layout->addWidget(button);
+
+  connect(button, &QPushButton::clicked, this, [this]() {
+    QSettings settings;
+    QString directory =
+        settings.value("ParserDBC.lastDirectory", QDir::currentPath()).toString();
+    QString filename = QFileDialog::getOpenFileName(_widget, tr("Open DBC file"), directory,
+                                                    tr("DBC database (*.dbc);;All files (*)"));
+    if (!filename.isEmpty())
+    {
+      settings.setValue("ParserDBC.lastDirectory", QFileInfo(filename).absolutePath());
+      loadFile(filename);
+    }
+  });
+
+  QSettings settings;
+  QString previous = settings.value("ParserDBC.file").toString();
+  if (!previous.isEmpty() && QFile::exists(previous))
+  {
+    loadFile(previous);
+  }
+}
+
+ParserDBC::~ParserDBC()
+{
+  delete _widget;
+}
+
+void ParserDBC::loadFile(const QString& filename)
+{
+  QFile file(filename);
+  if (!file.open(QIODevice::ReadOnly))
+  {
+    QMessageBox::warning(nullptr, tr("Error loading file"),
+                         tr("Cannot open file %1").arg(filename), QMessageBox::Cancel);
+    return;
+  }
+  _dbc_text = file.readAll().toStdString();
+  _file_edit->setText(filename);
+
+  QSettings settings;
+  settings.setValue("ParserDBC.file", filename);
+}
+
+MessageParserPtr ParserDBC::createParser(const std::string& topic_name, const std::string&,
+                                         const std::string& schema, PlotDataMapRef& data)
+{
+  const std::string& dbc_text = schema.empty() ? _dbc_text : schema;
+  if (dbc_text.empty())
+  {
+    throw std::runtime_error("ParserDBC: no DBC file loaded");
+  }
+  return std::make_shared<DBCMessageParser>(topic_name, dbc_text, data);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "PlotJuggler/messageparser_base.h"
+
+#include <QWidget>
+
+class QLineEdit;
+
+/**
+ * @brief Parser factory that decodes raw CAN / CAN-FD frames using a DBC
+ * database.
+ *
+ * The DBC file is compiled once, when loaded, into a flat decode table per
+ * message ID: each signal becomes a precomputed byte offset, bit shift,
+ * mask, sign-extension and linear conversion. Decoding a frame is then a
+ * hash lookup on the ID followed by a handful of shifts per signal, with no
+ * string handling, so it keeps up with a fully loaded bus in-process.
+ *
+ * Accepted frame layouts (auto-detected from the message size):
+ *  - SocketCAN can_frame (16 bytes) and canfd_frame (72 bytes)
+ *  - a minimal [uint32 LE can_id][payload] concatenation
+ */
+class ParserDBC : public PJ::ParserFactoryPlugin
+{
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID "facontidavide.PlotJuggler3.ParserFactoryPlugin")
+  Q_INTERFACES(PJ::ParserFactoryPlugin)
+
+public:
+  ParserDBC();
+
+  ~ParserDBC() override;
+
+  const char* name() const override
+  {
+    return "ParserDBC";
+  }
+
+  const char* encoding() const override
+  {
+    return "can_dbc";
+  }
+
+  PJ::MessageParserPtr createParser(const std::string& topic_name, const std::string& type_name,
+                                    const std::string& schema, PJ::PlotDataMapRef& data) override;
+
+  QWidget* optionsWidget() override
+  {
+    return _widget;
+  }
+
+private:
+  void loadFile(const QString& filename);
+
+  QWidget* _widget = nullptr;
+  QLineEdit* _file_edit = nullptr;
+
+  // content of the loaded DBC file; used when createParser() receives an
+  // empty schema (the normal case with the UDP / serial streamers)
+  std::string _dbc_text;
+};
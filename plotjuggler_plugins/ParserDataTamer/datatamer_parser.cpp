@@ -2,6 +2,7 @@
 #include "datatamer_parser.h"
 #include "data_tamer_parser/data_tamer_parser.hpp"
 #include "fmt/core.h"
+#include <cstring>
 
 using namespace PJ;
 
@@ -13,20 +14,33 @@ public:
     : MessageParser(topic_name, data), topic_name_(topic_name)
   {
     schema_ = DataTamerParser::BuilSchemaFromText(schema);
+
+    // The layout of a snapshot is fixed once the schema is known: when all
+    // the fields are fixed-size scalars, compile a (type, size, series)
+    // table and decode each snapshot with a single linear pass instead of
+    // the generic per-field dispatch of ParseSnapshot().
+    fixed_layout_ = true;
+    for (const auto& field : schema_.fields)
+    {
+      if (field.is_vector || field.type == DataTamerParser::BasicType::OTHER)
+      {
+        fixed_layout_ = false;
+        break;
+      }
+      TimeSeries entry;
+      entry.name = fmt::format("{}/{}", topic_name_, field.field_name);
+      entry.type = field.type;
+      entry.size = DataTamerParser::SizeOf(field.type);
+      timeseries_.push_back(std::move(entry));
+    }
+    if (!fixed_layout_)
+    {
+      timeseries_.clear();
+    }
   }
 
   bool parseMessage(const MessageRef serialized_msg, double& timestamp) override
   {
-    auto callback = [this, timestamp](const std::string& series_name,
-                                      const DataTamerParser::VarNumber& var) {
-      auto name = fmt::format("{}/{}", topic_name_, series_name);
-      auto& plot_data = getSeries(name);
-
-      double value = std::visit([](auto&& v) { return static_cast<double>(v); }, var);
-
-      plot_data.pushBack({ timestamp, value });
-    };
-
     DataTamerParser::SnapshotView snapshot;
     snapshot.schema_hash = schema_.hash;
 
@@ -41,22 +55,119 @@ public:
     snapshot.payload.data = msg_buffer.data;
     snapshot.payload.size = payload_size;
 
+    if (fixed_layout_)
+    {
+      return parseFixedLayout(snapshot, timestamp);
+    }
+
+    // generic path, for schemas with vectors or custom types
+    auto callback = [this, timestamp](const std::string& series_name,
+                                      const DataTamerParser::VarNumber& var) {
+      auto name = fmt::format("{}/{}", topic_name_, series_name);
+      auto& plot_data = getSeries(name);
+
+      double value = std::visit([](auto&& v) { return static_cast<double>(v); }, var);
+
+      plot_data.pushBack({ timestamp, value });
+    };
+
     DataTamerParser::ParseSnapshot(schema_, snapshot, callback);
     return true;
   }
 
 private:
+  bool parseFixedLayout(const DataTamerParser::SnapshotView& snapshot, double timestamp)
+  {
+    const uint8_t* ptr = snapshot.payload.data;
+    size_t bytes_left = snapshot.payload.size;
+
+    for (size_t index = 0; index < timeseries_.size(); index++)
+    {
+      if (!DataTamerParser::GetBit(snapshot.active_mask, index))
+      {
+        continue;
+      }
+      auto& entry = timeseries_[index];
+      if (bytes_left < entry.size)
+      {
+        return false;
+      }
+      double value = 0;
+      switch (entry.type)
+      {
+        case DataTamerParser::BasicType::BOOL:
+          value = (*ptr != 0) ? 1.0 : 0.0;
+          break;
+        case DataTamerParser::BasicType::CHAR:
+          value = double(*reinterpret_cast<const char*>(ptr));
+          break;
+        case DataTamerParser::BasicType::INT8:
+          value = double(int8_t(*ptr));
+          break;
+        case DataTamerParser::BasicType::UINT8:
+          value = double(*ptr);
+          break;
+        case DataTamerParser::BasicType::INT16:
+          value = ReadAs<int16_t>(ptr);
+          break;
+        case DataTamerParser::BasicType::UINT16:
+          value = ReadAs<uint16_t>(ptr);
+          break;
+        case DataTamerParser::BasicType::INT32:
+          value = ReadAs<int32_t>(ptr);
+          break;
+        case DataTamerParser::BasicType::UINT32:
+          value = ReadAs<uint32_t>(ptr);
+          break;
+        case DataTamerParser::BasicType::INT64:
+          value = ReadAs<int64_t>(ptr);
+          break;
+        case DataTamerParser::BasicType::UINT64:
+          value = ReadAs<uint64_t>(ptr);
+          break;
+        case DataTamerParser::BasicType::FLOAT32:
+          value = ReadAs<float>(ptr);
+          break;
+        case DataTamerParser::BasicType::FLOAT64:
+          value = ReadAs<double>(ptr);
+          break;
+        default:
+          return false;
+      }
+      ptr += entry.size;
+      bytes_left -= entry.size;
+
+      // resolved on first use, a pointer dereference afterwards
+      if (!entry.plot_data)
+      {
+        entry.plot_data = &getSeries(entry.name);
+      }
+      entry.plot_data->pushBack({ timestamp, value });
+    }
+    return true;
+  }
+
+  template <typename T>
+  static double ReadAs(const uint8_t* ptr)
+  {
+    T tmp;
+    std::memcpy(&tmp, ptr, sizeof(T));
+    return static_cast<double>(tmp);
+  }
+
   DataTamerParser::Schema schema_;
 
   struct TimeSeries
   {
     std::string name;
     DataTamerParser::BasicType type;
+    size_t size = 0;
     PlotData* plot_data = nullptr;
   };
 
   std::string topic_name_;
   std::vector<TimeSeries> timeseries_;
+  bool fixed_layout_ = false;
 };
 
 MessageParserPtr ParserDataTamer::createParser(const std::string& topic_name,
@@ -1,6 +1,14 @@
 
 #include "line_parser.h"
 
+#include <PlotJuggler/util/fast_parse.hpp>
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <string_view>
+#include <unordered_map>
+
 using namespace PJ;
 
 class MsgParserImpl : public MessageParser
@@ -14,95 +22,203 @@ public:
 
   bool parseMessage(const MessageRef msg, double& timestamp) override
   {
-    auto ToChar = [](const auto* ptr) { return reinterpret_cast<const char*>(ptr); };
+    constexpr size_t npos = std::string_view::npos;
 
-    const auto str = QString::fromLocal8Bit(ToChar(msg.data()), msg.size());
+    std::string_view remaining(reinterpret_cast<const char*>(msg.data()), msg.size());
 
-    std::string key;
-    std::string prefix;
-    // Obtain the key name from measurement name and tags
-    for (auto line : str.splitRef('\n', PJ::SkipEmptyParts))
+    while (!remaining.empty())
     {
-      auto parts = line.split(' ', PJ::SkipEmptyParts);
-      if (parts.size() != 2 && parts.size() != 3)
+      std::string_view line;
+      const size_t newline = remaining.find('\n');
+      if (newline == npos)
+      {
+        line = remaining;
+        remaining = {};
+      }
+      else
+      {
+        line = remaining.substr(0, newline);
+        remaining.remove_prefix(newline + 1);
+      }
+      if (line.empty())
       {
         continue;
       }
-      const auto tags = parts[0].split(',', PJ::SkipEmptyParts);
-      const auto fields = parts[1].split(',', PJ::SkipEmptyParts);
-      if (tags.size() < 1 || fields.size() < 1)
+
+      // split into measurement+tag-set, field-set and optional timestamp
+      std::array<std::string_view, 3> parts;
+      size_t parts_count = 0;
+      bool too_many_parts = false;
+      for (size_t begin = 0; begin <= line.size();)
+      {
+        size_t end = line.find(' ', begin);
+        if (end == npos)
+        {
+          end = line.size();
+        }
+        if (end > begin)  // skip empty parts
+        {
+          if (parts_count == parts.size())
+          {
+            too_many_parts = true;
+            break;
+          }
+          parts[parts_count++] = line.substr(begin, end - begin);
+        }
+        begin = end + 1;
+      }
+      if (too_many_parts || parts_count < 2)
       {
         continue;
       }
-      uint64_t timestamp = 0;
-      if (parts.size() == 3)
+      const std::string_view tag_set = parts[0];
+      const std::string_view field_set = parts[1];
+
+      uint64_t ts_nanosec = 0;
+      if (parts_count == 3)
       {
-        timestamp = parts[2].toULongLong();
+        const auto res =
+            std::from_chars(parts[2].data(), parts[2].data() + parts[2].size(), ts_nanosec);
+        if (res.ec != std::errc() || res.ptr != parts[2].data() + parts[2].size())
+        {
+          ts_nanosec = 0;
+        }
       }
       else
       {
         using namespace std::chrono;
         auto now = steady_clock::now();
-        timestamp = duration_cast<nanoseconds>(now.time_since_epoch()).count();
+        ts_nanosec = duration_cast<nanoseconds>(now.time_since_epoch()).count();
       }
-      const double ts_sec = double(timestamp) * 1e-9;
+      const double ts_sec = double(ts_nanosec) * 1e-9;
 
-      prefix = topic_name_;
-      for (auto tag : tags)
-      {
-        prefix += '/';
-        auto tag_str = tag.toLocal8Bit();
-        prefix.append(tag_str.data(), tag_str.size());
-      }
-      for (auto field : fields)
+      // Resolve the destination series of this measurement+tag-set.
+      // A typical stream repeats a few hundred distinct tag-sets millions of
+      // times, so the flattened prefix and the series pointers are cached on
+      // the raw prefix bytes; per-line work reduces to field-value parsing.
+      tagset_key_.assign(tag_set.data(), tag_set.size());
+      auto cache_it = tagset_cache_.find(tagset_key_);
+      if (cache_it == tagset_cache_.end())
       {
-        const auto field_parts = field.split('=');
-        const auto name = field_parts[0].toLocal8Bit();
-        auto value = field_parts[1].toLocal8Bit();
-
-        key = prefix;
-        key += '/';
-        key.append(name.data(), name.size());
-
-        if (value.startsWith('"') && value.endsWith('"'))
+        SeriesTable table;
+        table.prefix = topic_name_;
+        bool any_tag = false;
+        for (size_t begin = 0; begin <= tag_set.size();)
         {
-          auto& data = getStringSeries(key);
-          data.pushBack({ ts_sec, StringRef(value.data() + 1, value.size() - 2) });
+          size_t end = tag_set.find(',', begin);
+          if (end == npos)
+          {
+            end = tag_set.size();
+          }
+          if (end > begin)
+          {
+            table.prefix += '/';
+            table.prefix.append(tag_set.data() + begin, end - begin);
+            any_tag = true;
+          }
+          begin = end + 1;
         }
-        else if (value == "t" || value == "T" || value == "true" || value == "True" ||
-                 value == "TRUE")
+        if (!any_tag)
         {
-          auto& data = getSeries(key);
-          data.pushBack({ ts_sec, 1.0 });
+          continue;
         }
-        else if (value == "f" || value == "F" || value == "false" || value == "False" ||
-                 value == "FALSE")
+        cache_it = tagset_cache_.emplace(tagset_key_, std::move(table)).first;
+      }
+      SeriesTable& table = cache_it->second;
+
+      for (size_t begin = 0; begin <= field_set.size();)
+      {
+        size_t end = field_set.find(',', begin);
+        if (end == npos)
         {
-          auto& data = getSeries(key);
-          data.pushBack({ ts_sec, 0.0 });
+          end = field_set.size();
         }
-        else
+        if (end > begin)
         {
-          bool ok = false;
-          // remove last character if there is an integer suffix
-          if (value.endsWith('i') || value.endsWith('u'))
-          {
-            value.chop(1);
-          }
-          double num = value.toDouble(&ok);
-          if (ok)
-          {
-            auto& data = getSeries(key);
-            data.pushBack({ ts_sec, num });
-          }
+          parseField(field_set.substr(begin, end - begin), table, ts_sec);
         }
+        begin = end + 1;
       }
     }
     return true;
   }
 
 private:
+  /// Destination series of one measurement+tag-set, resolved once.
+  /// The pointers remain valid because PlotDataMapRef stores the series in
+  /// node-based maps and this parser never outlives its destination map.
+  struct SeriesTable
+  {
+    std::string prefix;  // "<topic>/<measurement>/<tag>/..."
+    std::unordered_map<std::string, PJ::PlotData*> numeric;
+    std::unordered_map<std::string, PJ::StringSeries*> strings;
+  };
+
+  void parseField(std::string_view field, SeriesTable& table, double ts_sec)
+  {
+    const size_t eq = field.find('=');
+    if (eq == std::string_view::npos)
+    {
+      return;
+    }
+    const std::string_view name = field.substr(0, eq);
+    std::string_view value = field.substr(eq + 1);
+
+    field_key_.assign(name.data(), name.size());
+
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+    {
+      auto it = table.strings.find(field_key_);
+      if (it == table.strings.end())
+      {
+        const std::string key = table.prefix + '/' + field_key_;
+        it = table.strings.emplace(field_key_, &getStringSeries(key)).first;
+      }
+      it->second->pushBack({ ts_sec, StringRef(value.data() + 1, value.size() - 2) });
+      return;
+    }
+
+    double num = 0.0;
+    if (value == "t" || value == "T" || value == "true" || value == "True" || value == "TRUE")
+    {
+      num = 1.0;
+    }
+    else if (value == "f" || value == "F" || value == "false" || value == "False" ||
+             value == "FALSE")
+    {
+      num = 0.0;
+    }
+    else
+    {
+      // remove last character if there is an integer suffix
+      if (!value.empty() && (value.back() == 'i' || value.back() == 'u'))
+      {
+        value.remove_suffix(1);
+      }
+      auto parsed = FastParseDouble(value.data(), value.data() + value.size());
+      if (!parsed)
+      {
+        return;
+      }
+      num = *parsed;
+    }
+
+    auto it = table.numeric.find(field_key_);
+    if (it == table.numeric.end())
+    {
+      const std::string key = table.prefix + '/' + field_key_;
+      it = table.numeric.emplace(field_key_, &getSeries(key)).first;
+    }
+    it->second->pushBack({ ts_sec, num });
+  }
+
   std::string topic_name_;
+
+  std::unordered_map<std::string, SeriesTable> tagset_cache_;
+
+  // reused per line / per field to avoid allocating lookup keys
+  std::string tagset_key_;
+  std::string field_key_;
 };
 
 MessageParserPtr ParserLine::createParser(const std::string& topic_name,
@@ -1,5 +1,8 @@
 #include <QSettings>
 #include <QMessageBox>
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
 #include "protobuf_parser.h"
 #include "fmt/core.h"
 
@@ -32,18 +35,628 @@ ProtobufParser::ProtobufParser(const std::string& topic_name, const std::string
   }
 }
 
-bool ProtobufParser::parseMessage(const MessageRef serialized_msg, double& timestamp)
+//---------------- compiled wire-format decoding ----------------
+
+namespace
 {
-  const google::protobuf::Message* prototype_msg = _msg_factory.GetPrototype(_msg_descriptor);
+// Minimal cursor over the protobuf wire bytes
+struct WireReader
+{
+  const uint8_t* ptr;
+  const uint8_t* end;
 
-  google::protobuf::Message* mutable_msg = prototype_msg->New();
-  if (!mutable_msg->ParseFromArray(serialized_msg.data(), serialized_msg.size()))
+  bool readVarint(uint64_t& out)
   {
+    out = 0;
+    for (int shift = 0; ptr != end && shift < 64; shift += 7)
+    {
+      const uint8_t byte = *ptr++;
+      out |= uint64_t(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+      {
+        return true;
+      }
+    }
     return false;
   }
 
-  std::function<void(const google::protobuf::Message&, const std::string&, const bool)> ParseImpl;
+  bool readFixed32(uint32_t& out)
+  {
+    if (end - ptr < 4)
+    {
+      return false;
+    }
+    memcpy(&out, ptr, 4);
+    ptr += 4;
+    return true;
+  }
+
+  bool readFixed64(uint64_t& out)
+  {
+    if (end - ptr < 8)
+    {
+      return false;
+    }
+    memcpy(&out, ptr, 8);
+    ptr += 8;
+    return true;
+  }
+
+  bool readBytes(size_t length, const uint8_t*& out)
+  {
+    if (size_t(end - ptr) < length)
+    {
+      return false;
+    }
+    out = ptr;
+    ptr += length;
+    return true;
+  }
+
+  bool skip(uint32_t wire_type)
+  {
+    switch (wire_type)
+    {
+      case 0: {
+        uint64_t unused;
+        return readVarint(unused);
+      }
+      case 1: {
+        uint64_t unused;
+        return readFixed64(unused);
+      }
+      case 2: {
+        uint64_t length;
+        const uint8_t* unused;
+        return readVarint(length) && readBytes(size_t(length), unused);
+      }
+      case 5: {
+        uint32_t unused;
+        return readFixed32(unused);
+      }
+      default:
+        // groups (3/4) and invalid wire types
+        return false;
+    }
+  }
+};
+
+// wire type each field type is serialized with (when not packed)
+int ExpectedWireType(gp::FieldDescriptor::Type type)
+{
+  switch (type)
+  {
+    case gp::FieldDescriptor::TYPE_DOUBLE:
+    case gp::FieldDescriptor::TYPE_FIXED64:
+    case gp::FieldDescriptor::TYPE_SFIXED64:
+      return 1;
+    case gp::FieldDescriptor::TYPE_FLOAT:
+    case gp::FieldDescriptor::TYPE_FIXED32:
+    case gp::FieldDescriptor::TYPE_SFIXED32:
+      return 5;
+    case gp::FieldDescriptor::TYPE_STRING:
+    case gp::FieldDescriptor::TYPE_BYTES:
+    case gp::FieldDescriptor::TYPE_MESSAGE:
+      return 2;
+    case gp::FieldDescriptor::TYPE_GROUP:
+      return -1;
+    default:
+      return 0;  // all the varint types
+  }
+}
+
+double VarintToDouble(gp::FieldDescriptor::Type type, uint64_t raw)
+{
+  switch (type)
+  {
+    case gp::FieldDescriptor::TYPE_SINT32:
+      return double(int32_t((uint32_t(raw) >> 1) ^ (~(uint32_t(raw) & 1) + 1)));
+    case gp::FieldDescriptor::TYPE_SINT64:
+      return double(int64_t((raw >> 1) ^ (~(raw & 1) + 1)));
+    case gp::FieldDescriptor::TYPE_INT32:
+    case gp::FieldDescriptor::TYPE_INT64:
+      return double(int64_t(raw));
+    case gp::FieldDescriptor::TYPE_BOOL:
+      return (raw != 0) ? 1.0 : 0.0;
+    default:  // uint32, uint64, enum numbers
+      return double(raw);
+  }
+}
+
+// A plan can be compiled only when every field (recursively) has a fixed
+// series name layout. Maps and groups keep using the Reflection path.
+bool PlanSupported(const gp::Descriptor* descriptor,
+                   std::unordered_set<const gp::Descriptor*>& visited)
+{
+  if (!visited.insert(descriptor).second)
+  {
+    return true;
+  }
+  for (int i = 0; i < descriptor->field_count(); i++)
+  {
+    const auto* field = descriptor->field(i);
+    if (field->is_map() || field->type() == gp::FieldDescriptor::TYPE_GROUP)
+    {
+      return false;
+    }
+    if (field->cpp_type() == gp::FieldDescriptor::CPPTYPE_MESSAGE &&
+        !PlanSupported(field->message_type(), visited))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Structural pre-pass: walk every tag (recursing into known sub-messages)
+// before touching any series, so a malformed buffer never leaves
+// half-pushed samples behind.
+bool ValidateMessage(const gp::Descriptor* descriptor, WireReader reader)
+{
+  while (reader.ptr != reader.end)
+  {
+    uint64_t tag;
+    if (!reader.readVarint(tag) || (tag >> 3) == 0)
+    {
+      return false;
+    }
+    const uint32_t wire_type = uint32_t(tag) & 7;
+    if (wire_type != 2)
+    {
+      if (!reader.skip(wire_type))
+      {
+        return false;
+      }
+      continue;
+    }
+    uint64_t length;
+    const uint8_t* data;
+    if (!reader.readVarint(length) || !reader.readBytes(size_t(length), data))
+    {
+      return false;
+    }
+    const auto* field = descriptor->FindFieldByNumber(int(tag >> 3));
+    if (!field)
+    {
+      continue;
+    }
+    if (field->cpp_type() == gp::FieldDescriptor::CPPTYPE_MESSAGE)
+    {
+      if (!ValidateMessage(field->message_type(), WireReader{ data, data + length }))
+      {
+        return false;
+      }
+    }
+    else if (field->is_repeated() && ExpectedWireType(field->type()) != 2)
+    {
+      // packed repeated scalars
+      const int element_wire = ExpectedWireType(field->type());
+      if (element_wire == 1 || element_wire == 5)
+      {
+        const size_t element_size = (element_wire == 1) ? 8 : 4;
+        if (length % element_size != 0)
+        {
+          return false;
+        }
+      }
+      else
+      {
+        WireReader packed{ data, data + length };
+        uint64_t unused;
+        while (packed.ptr != packed.end)
+        {
+          if (!packed.readVarint(unused))
+          {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+struct ProtobufParser::DecodePlan
+{
+  struct ByteSpan
+  {
+    const uint8_t* data;
+    size_t size;
+  };
+
+  struct Entry
+  {
+    const gp::FieldDescriptor* field = nullptr;
+    std::string key;  // prefix + "/" + field name
+
+    // destinations, resolved lazily so series are only created for fields
+    // that actually appear on the wire
+    PlotData* num_series = nullptr;
+    StringSeries* str_series = nullptr;
+    std::vector<PlotData*> num_elements;
+    std::vector<StringSeries*> str_elements;
+
+    // sub-message plans, one per prefix
+    std::unique_ptr<DecodePlan> child;
+    std::vector<std::unique_ptr<DecodePlan>> child_elements;
+
+    // per-message scratch for repeated fields: flushed at the end of the
+    // message, where the large-array policy can be applied to the final count
+    std::vector<double> rep_numbers;
+    std::vector<std::string> rep_strings;
+    std::vector<ByteSpan> rep_messages;
+  };
+
+  DecodePlan(const gp::Descriptor* descriptor, std::string prefix_)
+    : prefix(std::move(prefix_))
+  {
+    for (int i = 0; i < descriptor->field_count(); i++)
+    {
+      const auto* field = descriptor->field(i);
+      Entry entry;
+      entry.field = field;
+      entry.key = prefix.empty() ? std::string(field->name()) :
+                                   fmt::format("{}/{}", prefix, field->name());
+      entries.push_back(std::move(entry));
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.field->number() < b.field->number(); });
+  }
+
+  // fields are serialized in increasing number order most of the time:
+  // resume the scan from the previous match instead of hashing
+  Entry* find(uint32_t number)
+  {
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+      const size_t pos = (_cursor + i) % entries.size();
+      if (uint32_t(entries[pos].field->number()) == number)
+      {
+        _cursor = pos;
+        return &entries[pos];
+      }
+    }
+    return nullptr;
+  }
+
+  std::string prefix;
+  std::vector<Entry> entries;
+
+private:
+  size_t _cursor = 0;
+};
 
+ProtobufParser::~ProtobufParser() = default;
+
+bool ProtobufParser::decodeWithPlan(DecodePlan& plan, const uint8_t* data, size_t size,
+                                    double timestamp)
+{
+  for (auto& entry : plan.entries)
+  {
+    entry.rep_numbers.clear();
+    entry.rep_strings.clear();
+    entry.rep_messages.clear();
+  }
+
+  auto storeNumber = [&](DecodePlan::Entry& entry, double value) {
+    if (entry.field->is_repeated())
+    {
+      entry.rep_numbers.push_back(value);
+    }
+    else
+    {
+      if (!entry.num_series)
+      {
+        entry.num_series = &getSeries(entry.key);
+      }
+      entry.num_series->pushBack({ timestamp, value });
+    }
+  };
+
+  auto storeString = [&](DecodePlan::Entry& entry, std::string value) {
+    if (entry.field->is_repeated())
+    {
+      entry.rep_strings.push_back(std::move(value));
+    }
+    else
+    {
+      if (!entry.str_series)
+      {
+        entry.str_series = &getStringSeries(entry.key);
+      }
+      entry.str_series->pushBack({ timestamp, std::move(value) });
+    }
+  };
+
+  auto enumToString = [](const gp::FieldDescriptor* field, int64_t number) {
+    const auto* enum_value = field->enum_type()->FindValueByNumber(int(number));
+    return enum_value ? std::string(enum_value->name()) : std::to_string(number);
+  };
+
+  WireReader reader{ data, data + size };
+  while (reader.ptr != reader.end)
+  {
+    uint64_t tag;
+    if (!reader.readVarint(tag))
+    {
+      return false;
+    }
+    const uint32_t wire_type = uint32_t(tag) & 7;
+    auto* entry = plan.find(uint32_t(tag >> 3));
+    if (!entry || (wire_type != 2 && wire_type != uint32_t(ExpectedWireType(entry->field->type()))))
+    {
+      if (!reader.skip(wire_type))
+      {
+        return false;
+      }
+      continue;
+    }
+    const auto* field = entry->field;
+    const auto field_type = field->type();
+
+    switch (wire_type)
+    {
+      case 0: {
+        uint64_t raw;
+        if (!reader.readVarint(raw))
+        {
+          return false;
+        }
+        if (field_type == gp::FieldDescriptor::TYPE_ENUM)
+        {
+          storeString(*entry, enumToString(field, int64_t(raw)));
+        }
+        else
+        {
+          storeNumber(*entry, VarintToDouble(field_type, raw));
+        }
+      }
+      break;
+      case 1: {
+        uint64_t raw;
+        if (!reader.readFixed64(raw))
+        {
+          return false;
+        }
+        if (field_type == gp::FieldDescriptor::TYPE_DOUBLE)
+        {
+          double value;
+          memcpy(&value, &raw, 8);
+          storeNumber(*entry, value);
+        }
+        else if (field_type == gp::FieldDescriptor::TYPE_SFIXED64)
+        {
+          storeNumber(*entry, double(int64_t(raw)));
+        }
+        else
+        {
+          storeNumber(*entry, double(raw));
+        }
+      }
+      break;
+      case 5: {
+        uint32_t raw;
+        if (!reader.readFixed32(raw))
+        {
+          return false;
+        }
+        if (field_type == gp::FieldDescriptor::TYPE_FLOAT)
+        {
+          float value;
+          memcpy(&value, &raw, 4);
+          storeNumber(*entry, double(value));
+        }
+        else if (field_type == gp::FieldDescriptor::TYPE_SFIXED32)
+        {
+          storeNumber(*entry, double(int32_t(raw)));
+        }
+        else
+        {
+          storeNumber(*entry, double(raw));
+        }
+      }
+      break;
+      case 2: {
+        uint64_t length;
+        const uint8_t* bytes;
+        if (!reader.readVarint(length) || !reader.readBytes(size_t(length), bytes))
+        {
+          return false;
+        }
+        if (field_type == gp::FieldDescriptor::TYPE_MESSAGE)
+        {
+          if (field->is_repeated())
+          {
+            entry->rep_messages.push_back({ bytes, size_t(length) });
+          }
+          else
+          {
+            if (!entry->child)
+            {
+              entry->child = std::make_unique<DecodePlan>(field->message_type(), entry->key);
+            }
+            if (!decodeWithPlan(*entry->child, bytes, size_t(length), timestamp))
+            {
+              return false;
+            }
+          }
+        }
+        else if (field_type == gp::FieldDescriptor::TYPE_STRING ||
+                 field_type == gp::FieldDescriptor::TYPE_BYTES)
+        {
+          if (length <= 100)  // longer ones are probably blobs, skip them
+          {
+            storeString(*entry, std::string(reinterpret_cast<const char*>(bytes), size_t(length)));
+          }
+        }
+        else  // packed repeated scalars
+        {
+          WireReader packed{ bytes, bytes + length };
+          const int element_wire = ExpectedWireType(field_type);
+          while (packed.ptr != packed.end)
+          {
+            if (element_wire == 1)
+            {
+              uint64_t raw;
+              if (!packed.readFixed64(raw))
+              {
+                return false;
+              }
+              if (field_type == gp::FieldDescriptor::TYPE_DOUBLE)
+              {
+                double value;
+                memcpy(&value, &raw, 8);
+                storeNumber(*entry, value);
+              }
+              else if (field_type == gp::FieldDescriptor::TYPE_SFIXED64)
+              {
+                storeNumber(*entry, double(int64_t(raw)));
+              }
+              else
+              {
+                storeNumber(*entry, double(raw));
+              }
+            }
+            else if (element_wire == 5)
+            {
+              uint32_t raw;
+              if (!packed.readFixed32(raw))
+              {
+                return false;
+              }
+              if (field_type == gp::FieldDescriptor::TYPE_FLOAT)
+              {
+                float value;
+                memcpy(&value, &raw, 4);
+                storeNumber(*entry, double(value));
+              }
+              else if (field_type == gp::FieldDescriptor::TYPE_SFIXED32)
+              {
+                storeNumber(*entry, double(int32_t(raw)));
+              }
+              else
+              {
+                storeNumber(*entry, double(raw));
+              }
+            }
+            else
+            {
+              uint64_t raw;
+              if (!packed.readVarint(raw))
+              {
+                return false;
+              }
+              if (field_type == gp::FieldDescriptor::TYPE_ENUM)
+              {
+                storeString(*entry, enumToString(field, int64_t(raw)));
+              }
+              else
+              {
+                storeNumber(*entry, VarintToDouble(field_type, raw));
+              }
+            }
+          }
+        }
+      }
+      break;
+      default:
+        return false;
+    }
+  }
+
+  // flush the repeated fields, applying the same policy as the
+  // Reflection path: a field larger than maxArraySize() is dropped
+  // entirely unless clamping is enabled
+  for (auto& entry : plan.entries)
+  {
+    const size_t count =
+        entry.rep_numbers.size() + entry.rep_strings.size() + entry.rep_messages.size();
+    if (count == 0)
+    {
+      continue;
+    }
+    if (count > maxArraySize() && !clampLargeArray())
+    {
+      continue;
+    }
+    for (size_t i = 0; i < entry.rep_numbers.size(); i++)
+    {
+      if (i >= entry.num_elements.size())
+      {
+        entry.num_elements.push_back(&getSeries(fmt::format("{}[{}]", entry.key, i)));
+      }
+      entry.num_elements[i]->pushBack({ timestamp, entry.rep_numbers[i] });
+    }
+    for (size_t i = 0; i < entry.rep_strings.size(); i++)
+    {
+      if (i >= entry.str_elements.size())
+      {
+        entry.str_elements.push_back(&getStringSeries(fmt::format("{}[{}]", entry.key, i)));
+      }
+      entry.str_elements[i]->pushBack({ timestamp, std::move(entry.rep_strings[i]) });
+    }
+    for (size_t i = 0; i < entry.rep_messages.size(); i++)
+    {
+      if (i >= entry.child_elements.size())
+      {
+        entry.child_elements.push_back(std::make_unique<DecodePlan>(
+            entry.field->message_type(), fmt::format("{}[{}]", entry.key, i)));
+      }
+      const auto& span = entry.rep_messages[i];
+      if (!decodeWithPlan(*entry.child_elements[i], span.data, span.size, timestamp))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ProtobufParser::parseWithPlan(const MessageRef& serialized_msg, double& timestamp)
+{
+  const auto* data = serialized_msg.data();
+  const size_t size = serialized_msg.size();
+
+  if (!ValidateMessage(_msg_descriptor, WireReader{ data, data + size }))
+  {
+    return false;
+  }
+
+  if (useEmbeddedTimestamp() && _timestamp_field_index)
+  {
+    // quick top-level scan for the timestamp field, before any value is
+    // pushed with the wrong time
+    const uint32_t ts_number =
+        uint32_t(_msg_descriptor->field(int(*_timestamp_field_index))->number());
+    WireReader reader{ data, data + size };
+    uint64_t tag;
+    while (reader.ptr != reader.end && reader.readVarint(tag))
+    {
+      if (uint32_t(tag >> 3) == ts_number && (tag & 7) == 1)
+      {
+        uint64_t raw;
+        if (reader.readFixed64(raw))
+        {
+          memcpy(&timestamp, &raw, 8);
+        }
+        break;
+      }
+      if (!reader.skip(uint32_t(tag) & 7))
+      {
+        break;
+      }
+    }
+  }
+
+  return decodeWithPlan(*_decode_plan, data, size, timestamp);
+}
+
+//---------------------------------------------------------------
+
+bool ProtobufParser::parseMessage(const MessageRef serialized_msg, double& timestamp)
+{
   if (useEmbeddedTimestamp())
   {
     // search the correct field the first time
@@ -61,6 +674,48 @@ bool ProtobufParser::parseMessage(const MessageRef serialized_msg, double& times
         }
       }
     }
+  }
+
+  // compile the decoding plan once; descriptors with maps or groups keep
+  // using the Reflection path below
+  if (!_decode_plan && !_plan_unsupported)
+  {
+    std::unordered_set<const gp::Descriptor*> visited;
+    if (PlanSupported(_msg_descriptor, visited))
+    {
+      _decode_plan = std::make_unique<DecodePlan>(_msg_descriptor, _topic_name);
+    }
+    else
+    {
+      _plan_unsupported = true;
+    }
+  }
+
+  if (_decode_plan && parseWithPlan(serialized_msg, timestamp))
+  {
+    return true;
+  }
+
+  const google::protobuf::Message* prototype_msg = _msg_factory.GetPrototype(_msg_descriptor);
+
+  // Callers that go message by message never reach the per-batch Reset() in
+  // parseMessageBatch(): recycle the arena here before it grows too large.
+  constexpr size_t ARENA_RESET_SIZE = 1024 * 1024;
+  if (_arena.SpaceAllocated() > ARENA_RESET_SIZE)
+  {
+    _arena.Reset();
+  }
+
+  google::protobuf::Message* mutable_msg = prototype_msg->New(&_arena);
+  if (!mutable_msg->ParseFromArray(serialized_msg.data(), serialized_msg.size()))
+  {
+    return false;
+  }
+
+  std::function<void(const google::protobuf::Message&, const std::string&, const bool)> ParseImpl;
+
+  if (useEmbeddedTimestamp())
+  {
     // if there is a field with the expected name, use that as timestamp
     if (_timestamp_field_index)
     {
@@ -256,6 +911,16 @@ bool ProtobufParser::parseMessage(const MessageRef serialized_msg, double& times
   // start recursion
   ParseImpl(*mutable_msg, _topic_name, false);
 
-  delete mutable_msg;
   return true;
 }
+
+void ProtobufParser::parseMessageBatch(const MessageRef* messages, double* timestamps,
+                                       size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    parseMessage(messages[i], timestamps[i]);
+  }
+  // recycle the fallback-path allocations of the whole batch at once
+  _arena.Reset();
+}
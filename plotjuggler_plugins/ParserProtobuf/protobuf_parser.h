@@ -3,6 +3,7 @@
 #include <QCheckBox>
 #include <QDebug>
 
+#include <google/protobuf/arena.h>
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/dynamic_message.h>
 #include <google/protobuf/reflection.h>
@@ -26,8 +27,12 @@ public:
   ProtobufParser(const std::string& topic_name, const std::string type_name,
                  const google::protobuf::FileDescriptorSet& descriptor_set, PlotDataMapRef& data);
 
+  ~ProtobufParser() override;
+
   bool parseMessage(const MessageRef serialized_msg, double& timestamp) override;
 
+  void parseMessageBatch(const MessageRef* messages, double* timestamps, size_t count) override;
+
 protected:
   google::protobuf::SimpleDescriptorDatabase _proto_database;
   google::protobuf::DescriptorPool _proto_pool;
@@ -37,4 +42,27 @@ protected:
 
   bool _first_message = true;
   std::optional<size_t> _timestamp_field_index;
+
+private:
+  // Compiled decoding plan: maps each field number of the descriptor to its
+  // wire format and destination series, so messages are decoded straight
+  // from the wire bytes without materializing a DynamicMessage.
+  // See protobuf_parser.cpp for the definition.
+  struct DecodePlan;
+
+  // Decode with the compiled plan. Returns false when the message cannot be
+  // handled (malformed bytes, unknown group fields): the caller falls back
+  // to the Reflection-based path.
+  bool parseWithPlan(const MessageRef& serialized_msg, double& timestamp);
+
+  bool decodeWithPlan(DecodePlan& plan, const uint8_t* data, size_t size, double timestamp);
+
+  std::unique_ptr<DecodePlan> _decode_plan;
+  bool _plan_unsupported = false;
+
+  // Backing store for the DynamicMessage instances of the Reflection
+  // fallback. Messages are allocated here and recycled in bulk (once per
+  // batch, or when the arena grows too large), instead of paying a heap
+  // round-trip per message.
+  google::protobuf::Arena _arena;
 };
@@ -3,6 +3,7 @@
 #include "fmt/core.h"
 #include <queue>
 #include <algorithm>
+#include <mutex>
 #include <unordered_map>
 #include <tuple>
 #include <vector>
@@ -17,17 +18,65 @@ constexpr double RAD_TO_DEG = 180.0 / M_PI;
 
 static std::unordered_map<uint64_t, DataTamerParser::Schema> _global_data_tamer_schemas;
 
+// Process-wide cache of compiled message schemas, keyed by topic, type and a
+// hash of the definition text. Compiling a schema (ParseMessageDefinitions +
+// BuildMessageSchema) costs orders of magnitude more than hashing it, and the
+// same topics come back identical on every reconnection or repeated bag load.
+static MessageSchema::Ptr getCompiledSchema(const std::string& topic_name,
+                                            const ROSType& msg_type, const std::string& definition)
+{
+  static std::mutex cache_mutex;
+  static std::unordered_map<std::string, MessageSchema::Ptr> cache;
+
+  const std::string key = fmt::format("{}|{}|{}:{}", topic_name, msg_type.baseName(),
+                                      definition.size(), std::hash<std::string>{}(definition));
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto it = cache.find(key);
+  if (it != cache.end())
+  {
+    return it->second;
+  }
+
+  auto parsed_msgs = ParseMessageDefinitions(definition, msg_type);
+  auto schema = BuildMessageSchema(topic_name, parsed_msgs);
+
+  // warm the per-field message memoization now: once every field has resolved
+  // its message pointer, shared use of the schema is strictly read-only
+  for (const auto& [type, msg] : schema->msg_library)
+  {
+    for (const auto& field : msg->fields())
+    {
+      field.getMessagePtr(schema->msg_library);
+    }
+  }
+
+  cache.emplace(key, schema);
+  return schema;
+}
+
+static Parser::MaxArrayPolicy ToRosxPolicy(MessageParser::LargeArrayPolicy policy)
+{
+  switch (policy)
+  {
+    case MessageParser::LargeArrayPolicy::CLAMP:
+      return Parser::KEEP_LARGE_ARRAYS;
+    case MessageParser::LargeArrayPolicy::DECIMATE:
+      return Parser::DECIMATE_LARGE_ARRAYS;
+    default:
+      return Parser::DISCARD_LARGE_ARRAYS;
+  }
+}
+
 ParserROS::ParserROS(const std::string& topic_name, const std::string& type_name,
                      const std::string& schema, RosMsgParser::Deserializer* deserializer,
                      PlotDataMapRef& data)
   : MessageParser(topic_name, data)
-  , _parser(topic_name, type_name, schema)
+  , _parser(topic_name, ROSType(type_name), getCompiledSchema(topic_name, type_name, schema))
   , _deserializer(deserializer)
   , _topic(topic_name)
 {
-  auto policy = clampLargeArray() ? Parser::KEEP_LARGE_ARRAYS : Parser::DISCARD_LARGE_ARRAYS;
-
-  _parser.setMaxArrayPolicy(policy, maxArraySize());
+  _parser.setMaxArrayPolicy(ToRosxPolicy(largeArrayPolicy()), maxArraySize());
 
   const auto& root_fields = _parser.getSchema()->root_msg->fields();
   _has_header = !root_fields.empty() && root_fields.front().type().baseName() == "std_"
@@ -131,19 +180,23 @@ bool ParserROS::parseMessage(const PJ::MessageRef serialized_msg, double& timest
     timestamp = (ts > 0) ? ts : timestamp;
   }
 
-  std::string series_name;
+  // The schema is fixed per topic: the series key strings only need to be
+  // built when the flattened layout changes (first message, or a
+  // variable-size array growing or shrinking).
+  if (!sameFlatLayout())
+  {
+    rebuildFlatSeriesTable();
+  }
 
-  for (const auto& [key, str] : _flat_msg.name)
+  for (size_t i = 0; i < _flat_msg.name.size(); i++)
   {
-    key.toStr(series_name);
-    StringSeries& data = getStringSeries(series_name);
-    data.pushBack({ timestamp, str });
+    _flat_series.name_series[i]->pushBack({ timestamp, _flat_msg.name[i].second });
   }
 
-  for (const auto& [key, value] : _flat_msg.value)
+  for (size_t i = 0; i < _flat_msg.value.size(); i++)
   {
-    key.toStr(series_name);
-    PlotData& data = getSeries(series_name);
+    const auto& value = _flat_msg.value[i].second;
+    PlotData& data = *_flat_series.value_series[i];
 
     if (!_strict_truncation_check)
     {
@@ -177,13 +230,66 @@ bool ParserROS::parseMessage(const PJ::MessageRef serialized_msg, double& timest
   return true;
 }
 
-void ParserROS::setLargeArraysPolicy(bool clamp, unsigned max_size)
+static bool SameLeaf(const FieldsVector& a, const FieldsVector& b)
 {
-  auto policy =
-      clamp ? RosMsgParser::Parser::KEEP_LARGE_ARRAYS : RosMsgParser::Parser::DISCARD_LARGE_ARRAYS;
+  // the ROSField pointers are owned by the schema, which never changes for
+  // a given parser: pointer equality is leaf identity
+  return a.fields.size() == b.fields.size() &&
+         a.index_array.size() == b.index_array.size() &&
+         std::equal(a.fields.begin(), a.fields.end(), b.fields.begin()) &&
+         std::equal(a.index_array.begin(), a.index_array.end(), b.index_array.begin());
+}
 
-  _parser.setMaxArrayPolicy(policy, max_size);
-  MessageParser::setLargeArraysPolicy(clamp, max_size);
+bool ParserROS::sameFlatLayout() const
+{
+  if (_flat_series.value_layout.size() != _flat_msg.value.size() ||
+      _flat_series.name_layout.size() != _flat_msg.name.size())
+  {
+    return false;
+  }
+  for (size_t i = 0; i < _flat_msg.value.size(); i++)
+  {
+    if (!SameLeaf(_flat_series.value_layout[i], _flat_msg.value[i].first))
+    {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < _flat_msg.name.size(); i++)
+  {
+    if (!SameLeaf(_flat_series.name_layout[i], _flat_msg.name[i].first))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ParserROS::rebuildFlatSeriesTable()
+{
+  _flat_series.value_layout.clear();
+  _flat_series.name_layout.clear();
+  _flat_series.value_series.clear();
+  _flat_series.name_series.clear();
+
+  std::string series_name;
+  for (const auto& [key, str] : _flat_msg.name)
+  {
+    key.toStr(series_name);
+    _flat_series.name_layout.push_back(key);
+    _flat_series.name_series.push_back(&getStringSeries(series_name));
+  }
+  for (const auto& [key, value] : _flat_msg.value)
+  {
+    key.toStr(series_name);
+    _flat_series.value_layout.push_back(key);
+    _flat_series.value_series.push_back(&getSeries(series_name));
+  }
+}
+
+void ParserROS::setLargeArraysPolicy(LargeArrayPolicy policy, unsigned max_size)
+{
+  _parser.setMaxArrayPolicy(ToRosxPolicy(policy), max_size);
+  MessageParser::setLargeArraysPolicy(policy, max_size);
 }
 
 //------------------------------------------------------------------------
@@ -458,21 +564,41 @@ void ParserROS::parseJointStateMsg(const std::string& prefix, double& timestamp)
     }
   }
   //---------------------------
-  std::string series_name;
+  // the joint names rarely (if ever) change: resolve the destination
+  // series once instead of formatting the key of every joint at 1 kHz
+  if (msg.name != _joint_series.names)
+  {
+    _joint_series.names = msg.name;
+    _joint_series.position.assign(name_size, nullptr);
+    _joint_series.velocity.assign(name_size, nullptr);
+    _joint_series.effort.assign(name_size, nullptr);
+  }
   for (size_t i = 0; i < std::min(name_size, pos_size); i++)
   {
-    series_name = fmt::format("{}/{}/position", _topic, msg.name[i]);
-    getSeries(series_name).pushBack({ timestamp, msg.position[i] });
+    auto& dest = _joint_series.position[i];
+    if (!dest)
+    {
+      dest = &getSeries(fmt::format("{}/{}/position", _topic, msg.name[i]));
+    }
+    dest->pushBack({ timestamp, msg.position[i] });
   }
   for (size_t i = 0; i < std::min(name_size, vel_size); i++)
   {
-    series_name = fmt::format("{}/{}/velocity", _topic, msg.name[i]);
-    getSeries(series_name).pushBack({ timestamp, msg.velocity[i] });
+    auto& dest = _joint_series.velocity[i];
+    if (!dest)
+    {
+      dest = &getSeries(fmt::format("{}/{}/velocity", _topic, msg.name[i]));
+    }
+    dest->pushBack({ timestamp, msg.velocity[i] });
   }
   for (size_t i = 0; i < std::min(name_size, eff_size); i++)
   {
-    series_name = fmt::format("{}/{}/effort", _topic, msg.name[i]);
-    getSeries(series_name).pushBack({ timestamp, msg.effort[i] });
+    auto& dest = _joint_series.effort[i];
+    if (!dest)
+    {
+      dest = &getSeries(fmt::format("{}/{}/effort", _topic, msg.name[i]));
+    }
+    dest->pushBack({ timestamp, msg.effort[i] });
   }
 }
 
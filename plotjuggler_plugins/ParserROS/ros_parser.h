@@ -14,7 +14,8 @@ public:
 
   bool parseMessage(const PJ::MessageRef serialized_msg, double& timestamp) override;
 
-  void setLargeArraysPolicy(bool clamp, unsigned max_size) override;
+  using PJ::MessageParser::setLargeArraysPolicy;
+  void setLargeArraysPolicy(LargeArrayPolicy policy, unsigned max_size) override;
 
   void enableTruncationCheck(bool enable)
   {
@@ -74,6 +75,42 @@ protected:
 
   bool _has_header = false;
   bool _strict_truncation_check = true;
+
+private:
+  /// Destination series of each flattened field, resolved once per layout.
+  /// The series key of a leaf depends only on its field path and array
+  /// indices, so while consecutive messages have the same flattened layout
+  /// (fixed schema, no resized arrays) values can be appended directly,
+  /// with no string formatting and no hash lookups.
+  /// The pointers remain valid because PlotDataMapRef stores the series in
+  /// node-based maps and this parser never outlives its destination map.
+  struct FlatSeriesTable
+  {
+    std::vector<RosMsgParser::FieldsVector> value_layout;
+    std::vector<RosMsgParser::FieldsVector> name_layout;
+    std::vector<PJ::PlotData*> value_series;
+    std::vector<PJ::StringSeries*> name_series;
+  };
+
+  bool sameFlatLayout() const;
+  void rebuildFlatSeriesTable();
+
+  FlatSeriesTable _flat_series;
+
+  /// Same idea for sensor_msgs/JointState: the joint names are fixed for
+  /// the lifetime of a topic, so the "<topic>/<joint>/position" keys are
+  /// formatted only when the name list changes. Entries are resolved
+  /// lazily, so series that a topic never publishes (e.g. effort) are not
+  /// created.
+  struct JointSeriesTable
+  {
+    std::vector<std::string> names;
+    std::vector<PJ::PlotData*> position;
+    std::vector<PJ::PlotData*> velocity;
+    std::vector<PJ::PlotData*> effort;
+  };
+
+  JointSeriesTable _joint_series;
 };
 
 template <size_t N>
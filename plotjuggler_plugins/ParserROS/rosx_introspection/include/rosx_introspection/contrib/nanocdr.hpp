@@ -211,6 +211,37 @@ public:
     buffer_.trim_front(offset);
   }
 
+  /**
+   * @brief Direct view over [count] contiguous elements of a fixed-size
+   * arithmetic type, advancing the cursor past the whole array.
+   *
+   * Elements of the same size are naturally aligned once the first one is,
+   * so after the initial alignment the array is a single contiguous block.
+   * Returns nullptr when the buffer endianness differs from the native one
+   * (multi-byte elements would need a swap): decode element by element
+   * in that case.
+   */
+  const uint8_t* decodeArrayView(size_t element_size, size_t count)
+  {
+    if (element_size > 1 && header_.endianness != getCurrentEndianness())
+    {
+      return nullptr;
+    }
+    const size_t align = alignment(element_size);
+    if (align > 0)
+    {
+      buffer_.trim_front(align);
+    }
+    const size_t total = element_size * count;
+    if (buffer_.size() < total)
+    {
+      throw std::runtime_error("Decode: not enough data to decode (array)");
+    }
+    const uint8_t* ptr = buffer_.data();
+    buffer_.trim_front(total);
+    return ptr;
+  }
+
   /// Get a view to the current buffer (bytes left to decode)
   ConstBuffer currentBuffer() const
   {
@@ -32,6 +32,18 @@ public:
   // deserialize the current pointer into a variant (not a string)
   [[nodiscard]] virtual Variant deserialize(BuiltinType type) = 0;
 
+  // Bulk access to [count] contiguous elements of a fixed-size scalar type.
+  // On success the read cursor is advanced past the entire array and a
+  // pointer to the first element is returned. A nullptr return means
+  // in-place access is not possible (e.g. non-native endianness) and the
+  // caller must fall back to element-wise deserialize().
+  [[nodiscard]] virtual const uint8_t* deserializeArrayView(BuiltinType type, size_t count)
+  {
+    (void)type;
+    (void)count;
+    return nullptr;
+  }
+
   [[nodiscard]] virtual Span<const uint8_t> deserializeByteSequence() = 0;
 
   // deserialize the current pointer into a string
@@ -72,6 +84,8 @@ public:
 
   Span<const uint8_t> deserializeByteSequence() override;
 
+  const uint8_t* deserializeArrayView(BuiltinType type, size_t count) override;
+
   const uint8_t* getCurrentPtr() const override;
 
   void jump(size_t bytes) override;
@@ -112,6 +126,8 @@ public:
 
   Span<const uint8_t> deserializeByteSequence() override;
 
+  const uint8_t* deserializeArrayView(BuiltinType type, size_t count) override;
+
   const uint8_t* getCurrentPtr() const override;
 
   void jump(size_t bytes) override;
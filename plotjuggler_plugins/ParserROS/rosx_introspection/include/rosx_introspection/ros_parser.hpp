@@ -63,17 +63,29 @@ public:
   Parser(const std::string& topic_name, const ROSType& msg_type,
          const std::string& definition);
 
-  enum MaxArrayPolicy : bool
+  /**
+   * Same as above, but reusing a schema compiled earlier from the same
+   * message definition (see ParseMessageDefinitions / BuildMessageSchema).
+   * Deserialization never modifies the schema, so a compiled schema can be
+   * shared between Parser instances of the same topic.
+   * */
+  Parser(const std::string& topic_name, const ROSType& msg_type, MessageSchema::Ptr schema);
+
+  enum MaxArrayPolicy
   {
-    DISCARD_LARGE_ARRAYS = true,
-    KEEP_LARGE_ARRAYS = false
+    KEEP_LARGE_ARRAYS = 0,
+    DISCARD_LARGE_ARRAYS = 1,
+    // store min/max pairs of max_array_size/2 buckets instead of the raw
+    // elements; only packed scalar arrays are decimated, the others are
+    // clamped to the first max_array_size elements as KEEP does
+    DECIMATE_LARGE_ARRAYS = 2
   };
 
   /// Default values are DISCARD_LARGE_ARRAYS and 100.
   /// The maximum permissible value of max_array_size is 10.000 (but don't)
-  void setMaxArrayPolicy(MaxArrayPolicy discard_entire_array, size_t max_array_size)
+  void setMaxArrayPolicy(MaxArrayPolicy policy, size_t max_array_size)
   {
-    _discard_large_array = discard_entire_array;
+    _discard_large_array = policy;
     _max_array_size = max_array_size;
     if (_max_array_size > 10000)
     {
@@ -95,6 +95,21 @@ Span<const uint8_t> ROS_Deserializer::deserializeByteSequence()
   return out;
 }
 
+const uint8_t* ROS_Deserializer::deserializeArrayView(BuiltinType type, size_t count)
+{
+  // ROS1 serialization is packed little-endian: fixed-size primitive arrays
+  // are always contiguous in the buffer
+  const size_t total = count * size_t(builtinSize(type));
+  if (total > _bytes_left)
+  {
+    throw std::runtime_error("Buffer overrun in ROS_Deserializer::deserializeArrayView");
+  }
+  const uint8_t* ptr = _ptr;
+  _ptr += total;
+  _bytes_left -= total;
+  return ptr;
+}
+
 const uint8_t* ROS_Deserializer::getCurrentPtr() const
 {
   return _ptr;
@@ -183,6 +198,11 @@ uint32_t NanoCDR_Deserializer::deserializeUInt32()
   return Deserialize<uint32_t>(*_cdr_decoder);
 }
 
+const uint8_t* NanoCDR_Deserializer::deserializeArrayView(BuiltinType type, size_t count)
+{
+  return _cdr_decoder->decodeArrayView(size_t(builtinSize(type)), count);
+}
+
 Span<const uint8_t> NanoCDR_Deserializer::deserializeByteSequence()
 {
   //  thread_local std::vector<uint8_t> tmp;
@@ -56,6 +56,17 @@ Parser::Parser(const std::string& topic_name, const ROSType& msg_type,
   _schema = BuildMessageSchema(topic_name, parsed_msgs);
 }
 
+Parser::Parser(const std::string& topic_name, const ROSType& msg_type, MessageSchema::Ptr schema)
+  : _global_warnings(&std::cerr)
+  , _topic_name(topic_name)
+  , _discard_large_array(DISCARD_LARGE_ARRAYS)
+  , _max_array_size(100)
+  , _blob_policy(STORE_BLOB_AS_COPY)
+  , _dummy_root_field(new ROSField(msg_type, topic_name))
+{
+  _schema = std::move(schema);
+}
+
 const std::shared_ptr<MessageSchema>& Parser::getSchema() const
 {
   return _schema;
@@ -83,6 +94,107 @@ inline void ExpandVectorIfNecessary(Container& container, size_t new_size)
   }
 }
 
+// Fixed-size scalar types stored on the wire as a packed array
+inline bool IsPackedScalar(BuiltinType type)
+{
+  switch (type)
+  {
+    case BOOL:
+    case BYTE:
+    case CHAR:
+    case INT8:
+    case UINT8:
+    case INT16:
+    case UINT16:
+    case INT32:
+    case UINT32:
+    case INT64:
+    case UINT64:
+    case FLOAT32:
+    case FLOAT64:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Extract [store_count] elements of type T from a contiguous array view.
+// The tight typed loop lets the compiler vectorize the load/convert and
+// removes the virtual deserialize() call per element.
+template <typename T>
+inline void StoreArraySlice(const uint8_t* data, size_t store_count, FieldLeaf& leaf,
+                            std::vector<std::pair<FieldsVector, Variant>>& values,
+                            size_t& value_index)
+{
+  for (size_t i = 0; i < store_count; i++)
+  {
+    T tmp;
+    std::memcpy(&tmp, data + i * sizeof(T), sizeof(T));
+    leaf.index_array.back() = static_cast<uint16_t>(i);
+    ExpandVectorIfNecessary(values, value_index);
+    values[value_index] = std::make_pair(FieldsVector(leaf), Variant(tmp));
+    value_index++;
+  }
+}
+
+// Min/max decimation of a large contiguous array: the input is divided
+// into max_count/2 buckets and each bucket contributes its minimum (at
+// output index 2*b) and its maximum (at 2*b+1). Output indexes depend
+// only on max_count, never on array_size, so every message of the topic
+// feeds the same max_count series even when its array length varies.
+template <typename T>
+inline void StoreArrayDecimated(const uint8_t* data, size_t array_size, size_t max_count,
+                                FieldLeaf& leaf,
+                                std::vector<std::pair<FieldsVector, Variant>>& values,
+                                size_t& value_index)
+{
+  const size_t bucket_count = std::max<size_t>(1, max_count / 2);
+  for (size_t b = 0; b < bucket_count; b++)
+  {
+    const size_t begin = (b * array_size) / bucket_count;
+    const size_t end = ((b + 1) * array_size) / bucket_count;
+    T min_value;
+    T max_value;
+    std::memcpy(&min_value, data + begin * sizeof(T), sizeof(T));
+    max_value = min_value;
+    for (size_t i = begin + 1; i < end; i++)
+    {
+      T tmp;
+      std::memcpy(&tmp, data + i * sizeof(T), sizeof(T));
+      min_value = std::min(min_value, tmp);
+      max_value = std::max(max_value, tmp);
+    }
+    leaf.index_array.back() = static_cast<uint16_t>(2 * b);
+    ExpandVectorIfNecessary(values, value_index);
+    values[value_index] = std::make_pair(FieldsVector(leaf), Variant(min_value));
+    value_index++;
+
+    leaf.index_array.back() = static_cast<uint16_t>(2 * b + 1);
+    ExpandVectorIfNecessary(values, value_index);
+    values[value_index] = std::make_pair(FieldsVector(leaf), Variant(max_value));
+    value_index++;
+  }
+}
+
+// Pick between the plain slice and the decimated one. Decimation only
+// applies when the array exceeds the limit: smaller arrays are stored
+// verbatim, exactly as with the other policies.
+template <typename T>
+inline void StoreArrayValues(const uint8_t* data, size_t array_size, size_t store_count,
+                             bool decimate, FieldLeaf& leaf,
+                             std::vector<std::pair<FieldsVector, Variant>>& values,
+                             size_t& value_index)
+{
+  if (decimate)
+  {
+    StoreArrayDecimated<T>(data, array_size, store_count, leaf, values, value_index);
+  }
+  else
+  {
+    StoreArraySlice<T>(data, store_count, leaf, values, value_index);
+  }
+}
+
 bool Parser::deserialize(Span<const uint8_t> buffer, FlatMessage* flat_container,
                          Deserializer* deserializer) const
 {
@@ -147,7 +259,7 @@ bool Parser::deserialize(Span<const uint8_t> buffer, FlatMessage* flat_container
         }
         else
         {
-          if (_discard_large_array)
+          if (_discard_large_array == DISCARD_LARGE_ARRAYS)
           {
             DO_STORE = false;
           }
@@ -190,6 +302,86 @@ bool Parser::deserialize(Span<const uint8_t> buffer, FlatMessage* flat_container
       }
       else  // NOT a BLOB
       {
+        // Contiguous primitive arrays (Float64MultiArray, laser scans...)
+        // are extracted with a single typed loop over the raw buffer
+        // instead of one deserialize() call per element. The fallback
+        // below is kept for non-native endianness and everything else.
+        const uint8_t* bulk_ptr = nullptr;
+        if (field.isArray() && IsPackedScalar(field_type.typeID()))
+        {
+          bulk_ptr = deserializer->deserializeArrayView(field_type.typeID(), array_size);
+        }
+        if (bulk_ptr != nullptr)
+        {
+          size_t store_count = DO_STORE ? size_t(array_size) : 0;
+          bool decimate = false;
+          if (store_count > _max_array_size)
+          {
+            // same clamp applied by the element-wise loop; under the
+            // DECIMATE policy the clamped budget is spent on min/max
+            // buckets covering the whole array instead
+            decimate = (_discard_large_array == DECIMATE_LARGE_ARRAYS);
+            store_count = _max_array_size;
+          }
+          auto& values = flat_container->value;
+          switch (field_type.typeID())
+          {
+            case BOOL:
+              StoreArrayValues<bool>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            case CHAR:
+              StoreArrayValues<char>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            case BYTE:
+            case UINT8:
+              StoreArrayValues<uint8_t>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            case INT8:
+              StoreArrayValues<int8_t>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            case UINT16:
+              StoreArrayValues<uint16_t>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            case INT16:
+              StoreArrayValues<int16_t>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            case UINT32:
+              StoreArrayValues<uint32_t>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            case INT32:
+              StoreArrayValues<int32_t>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            case UINT64:
+              StoreArrayValues<uint64_t>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            case INT64:
+              StoreArrayValues<int64_t>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            case FLOAT32:
+              StoreArrayValues<float>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            case FLOAT64:
+              StoreArrayValues<double>(bulk_ptr, array_size, store_count, decimate, new_tree_leaf,
+                                     values, value_index);
+              break;
+            default:
+              break;
+          }
+          index_s++;
+          continue;
+        }
+
         bool DO_STORE_ARRAY = DO_STORE;
         for (int i = 0; i < array_size; i++)
         {
@@ -12,7 +12,12 @@
 #include <QWidget>
 #include <QFileDialog>
 
+#include <QApplication>
+
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 #include <zcm/zcm-cpp.hpp>
 #include <zcm/tools/Introspection.hpp>
@@ -58,7 +63,7 @@ const vector<const char*>& DataLoadZcm::compatibleFileExtensions() const
 }
 
 static int processInputLog(const string& logpath,
-                           function<void(const zcm::LogEvent* evt)> processEvent)
+                           function<void(const zcm::LogEvent* evt, off64_t offset)> processEvent)
 {
   zcm::LogFile inlog(logpath, "r");
   if (!inlog.good())
@@ -67,7 +72,7 @@ static int processInputLog(const string& logpath,
     return 1;
   }
 
-  auto processLog = [&inlog](function<void(const zcm::LogEvent* evt)> processEvent) {
+  auto processLog = [&inlog](function<void(const zcm::LogEvent* evt, off64_t offset)> processEvent) {
     const zcm::LogEvent* evt;
     off64_t offset;
     static int lastPrintPercent = 0;
@@ -114,7 +119,7 @@ static int processInputLog(const string& logpath,
         break;
       }
 
-      processEvent(evt);
+      processEvent(evt, offset);
     }
     if (verbose)
     {
@@ -144,7 +149,7 @@ bool DataLoadZcm::refreshChannels(const string& filepath)
   _all_channels.clear();
   _all_channels_filepath = filepath;
 
-  auto processEvent = [&](const zcm::LogEvent* evt) { _all_channels.insert(evt->channel); };
+  auto processEvent = [&](const zcm::LogEvent* evt, off64_t) { _all_channels.insert(evt->channel); };
 
   return processInputLog(filepath, processEvent) == 0;
 }
@@ -244,6 +249,91 @@ static void processData(const string& name, zcm_field_type_t type, const void* d
   }
 };
 
+// Samples gathered by one decode worker, in log order. The channel is
+// kept per series so that the merge can recreate the right group.
+struct SeriesShard
+{
+  string channel;
+  vector<double> xs;
+  vector<double> ys;
+};
+
+struct StringShard
+{
+  string channel;
+  vector<pair<double, string>> samples;
+};
+
+struct DecodeShard
+{
+  unordered_map<string, SeriesShard> numerics;
+  unordered_map<string, StringShard> strings;
+};
+
+// Decode a contiguous range of indexed events with a private LogFile
+// handle and TypeDb, so workers never share mutable state.
+static void decodeEventRange(const string& logpath, const string& libraries,
+                             const vector<off64_t>& offsets, size_t begin, size_t end,
+                             DecodeShard& shard, atomic<size_t>& progress, atomic<bool>& failed,
+                             const atomic<bool>& canceled)
+{
+  zcm::LogFile log(logpath, "r");
+  zcm::TypeDb types(libraries);
+  if (!log.good() || !types.good())
+  {
+    failed = true;
+    return;
+  }
+
+  vector<pair<string, double>> numerics;
+  vector<pair<string, string>> strings;
+  ProcessUsr usr = { numerics, strings };
+
+  for (size_t i = begin; i < end && !canceled; i++)
+  {
+    const zcm::LogEvent* evt = log.readEventAtOffset(offsets[i]);
+    progress++;
+    if (evt == nullptr)
+    {
+      continue;
+    }
+    const double ts = (double)evt->timestamp / 1e6;
+
+    if (evt->datalen == 0)
+    {
+      auto& series = shard.numerics[evt->channel];
+      series.channel = evt->channel;
+      series.xs.push_back(ts);
+      series.ys.push_back(0);
+      continue;
+    }
+
+    zcm::Introspection::processEncodedType(evt->channel, evt->data, evt->datalen, "/", types,
+                                           processData, &usr);
+    for (auto& n : usr.numerics)
+    {
+      auto& series = shard.numerics[n.first];
+      if (series.channel.empty())
+      {
+        series.channel = evt->channel;
+      }
+      series.xs.push_back(ts);
+      series.ys.push_back(n.second);
+    }
+    for (auto& s : usr.strings)
+    {
+      auto& series = shard.strings[s.first];
+      if (series.channel.empty())
+      {
+        series.channel = evt->channel;
+      }
+      series.samples.emplace_back(ts, std::move(s.second));
+    }
+    usr.numerics.clear();
+    usr.strings.clear();
+  }
+}
+
 bool DataLoadZcm::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_data)
 {
   string filepath = info->filename.toStdString();
@@ -261,64 +351,118 @@ bool DataLoadZcm::readDataFromFile(FileLoadInfo* info, PlotDataMapRef& plot_data
     return false;
   }
 
-  zcm::TypeDb types(_config_widget->getLibraries().toStdString());
+  const string libraries = _config_widget->getLibraries().toStdString();
+  zcm::TypeDb types(libraries);
   if (!types.good())
   {
     QMessageBox::warning(nullptr, "Error", "Failed to load zcmtypes");
     return false;
   }
 
-  vector<pair<string, double>> numerics;
-  vector<pair<string, string>> strings;
-  ProcessUsr usr = { numerics, strings };
-
-  auto processEvent = [&](const zcm::LogEvent* evt) {
-    if (_selected_channels.find(evt->channel) == _selected_channels.end())
+  // First pass: index the offsets of the events we actually want,
+  // decoding nothing yet
+  vector<off64_t> offsets;
+  auto indexEvent = [&](const zcm::LogEvent* evt, off64_t offset) {
+    if (_selected_channels.find(evt->channel) != _selected_channels.end())
     {
-      return;
+      offsets.push_back(offset);
     }
+  };
+  if (processInputLog(filepath, indexEvent) != 0)
+  {
+    return false;
+  }
+  if (offsets.empty())
+  {
+    return true;
+  }
 
-    auto group = plot_data.getOrCreateGroup(evt->channel);
+  // Second pass: decode the indexed events in parallel chunks. Each
+  // worker fills its own shard; the log order is preserved by keeping
+  // the chunks contiguous and merging them in order.
+  size_t num_workers = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), 8);
+  // no point spawning workers for a handful of events each
+  num_workers = std::min(num_workers, 1 + offsets.size() / 1000);
 
-    if (evt->datalen == 0)
+  vector<DecodeShard> shards(num_workers);
+  atomic<size_t> progress{ 0 };
+  atomic<bool> failed{ false };
+  atomic<bool> canceled{ false };
+
+  {
+    QProgressDialog progress_dialog;
+    progress_dialog.setLabelText("Decoding... please wait");
+    progress_dialog.setWindowModality(Qt::ApplicationModal);
+    progress_dialog.setRange(0, int(offsets.size()));
+    progress_dialog.setAutoClose(true);
+    progress_dialog.setAutoReset(true);
+    progress_dialog.show();
+
+    vector<thread> workers;
+    const size_t chunk = (offsets.size() + num_workers - 1) / num_workers;
+    for (size_t w = 0; w < num_workers; w++)
     {
-      auto itr = plot_data.numeric.find(evt->channel);
-      if (itr == plot_data.numeric.end())
+      const size_t begin = w * chunk;
+      const size_t end = std::min(offsets.size(), begin + chunk);
+      workers.emplace_back(decodeEventRange, cref(filepath), cref(libraries), cref(offsets), begin,
+                           end, ref(shards[w]), ref(progress), ref(failed), cref(canceled));
+    }
+
+    while (progress < offsets.size() && !failed)
+    {
+      progress_dialog.setValue(int(progress));
+      QApplication::processEvents();
+      if (progress_dialog.wasCanceled())
       {
-        itr = plot_data.addNumeric(evt->channel, group);
+        canceled = true;
+        break;
       }
-      itr->second.pushBack({ (double)evt->timestamp / 1e6, 0 });
-      return;
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    for (auto& worker : workers)
+    {
+      worker.join();
     }
+    if (canceled)
+    {
+      progress_dialog.cancel();
+      return false;
+    }
+  }
 
-    zcm::Introspection::processEncodedType(evt->channel, evt->data, evt->datalen, "/", types,
-                                           processData, &usr);
-    for (auto& n : usr.numerics)
+  if (failed)
+  {
+    QMessageBox::warning(nullptr, "Error", "Failed to open the log or the zcmtypes in a worker");
+    return false;
+  }
+
+  // Merge the shards in chunk order: within a series the samples stay
+  // time-sorted, so appendBatch() takes the fast path
+  for (auto& shard : shards)
+  {
+    for (auto& [name, series] : shard.numerics)
     {
-      auto itr = plot_data.numeric.find(n.first);
+      auto group = plot_data.getOrCreateGroup(series.channel);
+      auto itr = plot_data.numeric.find(name);
       if (itr == plot_data.numeric.end())
       {
-        itr = plot_data.addNumeric(n.first, group);
+        itr = plot_data.addNumeric(name, group);
       }
-      itr->second.pushBack({ (double)evt->timestamp / 1e6, n.second });
+      itr->second.appendBatch(series.xs.data(), series.ys.data(), series.xs.size());
     }
-    for (auto& s : usr.strings)
+    for (auto& [name, series] : shard.strings)
     {
-      auto itr = plot_data.strings.find(s.first);
+      auto group = plot_data.getOrCreateGroup(series.channel);
+      auto itr = plot_data.strings.find(name);
       if (itr == plot_data.strings.end())
       {
-        itr = plot_data.addStringSeries(s.first, group);
+        itr = plot_data.addStringSeries(name, group);
+      }
+      for (auto& [ts, value] : series.samples)
+      {
+        itr->second.pushBack({ ts, std::move(value) });
       }
-      itr->second.pushBack({ (double)evt->timestamp / 1e6, s.second });
     }
-
-    usr.numerics.clear();
-    usr.strings.clear();
-  };
-
-  if (processInputLog(filepath, processEvent) != 0)
-  {
-    return false;
   }
 
   return true;
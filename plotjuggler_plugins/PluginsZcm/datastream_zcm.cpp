@@ -129,6 +129,7 @@ bool DataStreamZcm::start(QStringList*)
     }
   }
 
+  _last_flush = std::chrono::steady_clock::now();
   _zcm->start();
   _running = true;
   return true;
@@ -147,6 +148,9 @@ void DataStreamZcm::shutdown()
   }
   _zcm->stop();
   _zcm.reset(nullptr);
+  // the callback thread is gone: hand over whatever was still batched
+  flushBatches();
+  _batches.clear();
   _running = false;
 }
 
@@ -223,36 +227,79 @@ void DataStreamZcm::processData(const string& name, zcm_field_type_t type, const
 
 void DataStreamZcm::handler(const zcm::ReceiveBuffer* rbuf, const string& channel)
 {
+  const auto t_begin = std::chrono::steady_clock::now();
+
   zcm::Introspection::processEncodedType(channel, rbuf->data, rbuf->data_size, "/", *_types.get(),
                                          processData, this);
+
+  // stage the decoded samples in the per-channel batch: no lock is taken
+  // here, so a 30 kHz bus does not serialize on the streamer mutex
+  const double stamp = double(rbuf->recv_utime) / 1e6;
+  auto& batch = _batches[channel];
+  for (auto& n : _numerics)
   {
-    std::lock_guard<std::mutex> lock(mutex());
-    auto group = dataMap().getOrCreateGroup(channel);
+    auto& columns = batch.numerics[n.first];
+    columns.xs.push_back(stamp);
+    columns.ys.push_back(n.second);
+  }
+  for (auto& s : _strings)
+  {
+    batch.strings.push_back({ s.first, stamp, std::move(s.second) });
+  }
+  _pending_samples += _numerics.size() + _strings.size();
+  _numerics.clear();
+  _strings.clear();
+
+  streamStats().messages_received.fetch_add(1, std::memory_order_relaxed);
+  recordParseTime(std::chrono::nanoseconds(std::chrono::steady_clock::now() - t_begin).count());
+
+  // flush at frame cadence, or earlier if a burst piles up too much
+  constexpr auto FLUSH_PERIOD = std::chrono::milliseconds(25);
+  constexpr size_t MAX_PENDING_SAMPLES = 100 * 1024;
+  if (t_begin - _last_flush >= FLUSH_PERIOD || _pending_samples >= MAX_PENDING_SAMPLES)
+  {
+    flushBatches();
+  }
+}
 
-    for (auto& n : _numerics)
+void DataStreamZcm::flushBatches()
+{
+  if (_pending_samples == 0)
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex());
+    for (auto& [channel, batch] : _batches)
     {
-      auto itr = dataMap().numeric.find(n.first);
-      if (itr == dataMap().numeric.end())
+      auto group = dataMap().getOrCreateGroup(channel);
+
+      for (auto& [series, columns] : batch.numerics)
       {
-        itr = dataMap().addNumeric(n.first, group);
+        if (!columns.xs.empty())
+        {
+          dataMap().appendBatch(series, columns.xs.data(), columns.ys.data(), columns.xs.size(),
+                                group);
+          columns.xs.clear();
+          columns.ys.clear();
+        }
       }
-      itr->second.pushBack({ double(rbuf->recv_utime) / 1e6, n.second });
-    }
-    for (auto& s : _strings)
-    {
-      auto itr = dataMap().strings.find(s.first);
-      if (itr == dataMap().strings.end())
+      for (auto& s : batch.strings)
       {
-        itr = dataMap().addStringSeries(s.first, group);
+        auto itr = dataMap().strings.find(s.series);
+        if (itr == dataMap().strings.end())
+        {
+          itr = dataMap().addStringSeries(s.series, group);
+        }
+        itr->second.pushBack({ s.stamp, std::move(s.value) });
       }
-      itr->second.pushBack({ double(rbuf->recv_utime) / 1e6, s.second });
+      batch.strings.clear();
     }
   }
+  _pending_samples = 0;
+  _last_flush = std::chrono::steady_clock::now();
 
   emit dataReceived();
-
-  _numerics.clear();
-  _strings.clear();
 }
 
 void DataStreamZcm::on_pushButtonUrl_clicked()
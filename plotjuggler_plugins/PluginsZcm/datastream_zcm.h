@@ -1,7 +1,9 @@
 #pragma once
 
 #include <QtPlugin>
+#include <chrono>
 #include <thread>
+#include <unordered_map>
 #include "PlotJuggler/datastreamer_base.h"
 
 #include <zcm/zcm-cpp.hpp>
@@ -51,8 +53,36 @@ private:
   std::vector<std::pair<std::string, double>> _numerics;
   std::vector<std::pair<std::string, std::string>> _strings;
 
+  // Samples decoded by the subscription callback, batched per channel and
+  // flushed to dataMap() at frame cadence. Only the callback thread
+  // touches these; the streamer mutex is taken once per flush, not once
+  // per message.
+  struct NumericColumns
+  {
+    std::vector<double> xs;
+    std::vector<double> ys;
+  };
+  struct PendingString
+  {
+    std::string series;
+    double stamp;
+    std::string value;
+  };
+  struct ChannelBatch
+  {
+    std::unordered_map<std::string, NumericColumns> numerics;
+    std::vector<PendingString> strings;
+  };
+  std::unordered_map<std::string, ChannelBatch> _batches;
+  size_t _pending_samples = 0;
+  std::chrono::steady_clock::time_point _last_flush;
+
   void handler(const zcm::ReceiveBuffer* rbuf, const std::string& channel);
 
+  /// Merge the batched samples into dataMap() under a single lock, using
+  /// the bulk-append API for the numeric series.
+  void flushBatches();
+
   bool _running;
   QString _types_library;
   QString _subscribe_string;
@@ -9,14 +9,40 @@
 #include <QMessageBox>
 #include <QSettings>
 #include <QByteArray>
+#include <QtConcurrent/QtConcurrent>
+#include <fmt/format.h>
+#include <memory>
+#include "PlotJuggler/util/time_align.hpp"
 #include "publisher_csv.h"
 
 StatePublisherCSV::StatePublisherCSV()
 {
+  connect(&_export_watcher, &QFutureWatcher<QString>::finished, this, [this]() {
+    QString error = _export_watcher.result();
+    if (!error.isEmpty())
+    {
+      QMessageBox::warning(nullptr, "Error", error);
+    }
+    // the dialog may have been closed while the worker was running
+    if (_enabled && _ui)
+    {
+      _ui->buttonRangeFile->setEnabled(true);
+      if (error.isEmpty())
+      {
+        _ui->labelNotification->setText(tr("Range data saved"));
+      }
+      else
+      {
+        _ui->labelNotification->setText("");
+      }
+      _notification_timer->start(2000);
+    }
+  });
 }
 
 StatePublisherCSV::~StatePublisherCSV()
 {
+  _export_watcher.waitForFinished();
 }
 
 void StatePublisherCSV::setEnabled(bool enabled)
@@ -100,10 +126,8 @@ void StatePublisherCSV::setEnabled(bool enabled)
     });
 
     //--------------------
-    connect(_ui->buttonRangeFile, &QPushButton::clicked, this, [this]() {
-      auto csv_string = generateRangeCSV(_start_time, _end_time);
-      this->saveFile(csv_string);
-    });
+    connect(_ui->buttonRangeFile, &QPushButton::clicked, this,
+            [this]() { saveRangeFileAsync(); });
 
     //--------------------
     _dialog->setWindowFlag(Qt::WindowStaysOnTopHint);
@@ -212,10 +236,8 @@ void StatePublisherCSV::updateButtonsState()
   _ui->buttonStatisticsFile->setEnabled(enable);
 }
 
-void StatePublisherCSV::saveFile(QString text)
+QString StatePublisherCSV::getSaveFilename()
 {
-  // QFileDialog::getSaveFileName(nullptr, "Save as CSV file", );
-
   QSettings settings;
   QString directory_path =
       settings.value("StatePublisherCSV.saveDirectory", QDir::currentPath()).toString();
@@ -225,12 +247,23 @@ void StatePublisherCSV::saveFile(QString text)
 
   if (fileName.isEmpty())
   {
-    return;
+    return {};
   }
   if (!fileName.endsWith(".csv"))
   {
     fileName.append(".csv");
   }
+  settings.setValue("StatePublisherCSV.saveDirectory", QFileInfo(fileName).absolutePath());
+  return fileName;
+}
+
+void StatePublisherCSV::saveFile(QString text)
+{
+  QString fileName = getSaveFilename();
+  if (fileName.isEmpty())
+  {
+    return;
+  }
 
   QFile file(fileName);
   if (!file.open(QIODevice::WriteOnly))
@@ -241,16 +274,41 @@ void StatePublisherCSV::saveFile(QString text)
 
   file.write(text.toUtf8());
   file.close();
-
-  directory_path = QFileInfo(fileName).absolutePath();
-  settings.setValue("StatePublisherCSV.saveDirectory", directory_path);
 }
 
-QString StatePublisherCSV::generateRangeCSV(double time_start, double time_end)
+void StatePublisherCSV::saveRangeFileAsync()
 {
-  using PlotPair = std::pair<std::string, const PJ::PlotData*>;
+  QString fileName = getSaveFilename();
+  if (fileName.isEmpty())
+  {
+    return;
+  }
+
+  // copy the samples in the range now, on the GUI thread, while nothing can
+  // modify the data; the worker below only reads the snapshot
+  auto snapshot =
+      std::make_shared<std::vector<SeriesSnapshot>>(snapshotRange(_start_time, _end_time));
 
-  std::vector<PlotPair> ordered_plotdata;
+  _ui->buttonRangeFile->setEnabled(false);
+  _ui->labelNotification->setText(tr("Exporting..."));
+
+  _export_watcher.setFuture(QtConcurrent::run([snapshot, fileName]() -> QString {
+    const std::string csv = buildRangeCSV(*snapshot);
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+      return QString("Failed to open the file [%1]").arg(fileName);
+    }
+    file.write(csv.data(), qint64(csv.size()));
+    return {};
+  }));
+}
+
+std::vector<StatePublisherCSV::SeriesSnapshot> StatePublisherCSV::snapshotRange(double time_start,
+                                                                               double time_end)
+{
+  std::vector<SeriesSnapshot> snapshot;
 
   for (const auto& it : _datamap->numeric)
   {
@@ -258,94 +316,86 @@ QString StatePublisherCSV::generateRangeCSV(double time_start, double time_end)
     {
       continue;
     }
-    ordered_plotdata.push_back({ it.first, &it.second });
+    snapshot.push_back({ it.first, {} });
   }
-  const size_t plot_count = ordered_plotdata.size();
-
-  std::sort(ordered_plotdata.begin(), ordered_plotdata.end(),
-            [](const PlotPair& a, const PlotPair& b) { return a.first < b.first; });
-
-  // current index per plordata
-  std::vector<size_t> indices(plot_count, 0);
+  std::sort(snapshot.begin(), snapshot.end(),
+            [](const SeriesSnapshot& a, const SeriesSnapshot& b) { return a.name < b.name; });
 
-  const auto NaN = std::numeric_limits<double>::quiet_NaN();
-  std::vector<double> row_values(plot_count, NaN);
-
-  QString labels;
-  labels += "__time,";
-  for (size_t i = 0; i < plot_count; i++)
+  for (auto& series : snapshot)
   {
-    labels += QString::fromStdString(ordered_plotdata[i].first);
-    labels += (i + 1 < plot_count) ? "," : "\n";
-
-    const PJ::PlotData* plotdata = (ordered_plotdata[i].second);
-    int index = plotdata->getIndexFromX(time_start);
+    const auto& plotdata = _datamap->numeric.at(series.name);
+    int index = plotdata.getIndexFromX(time_start);
     if (index < 0)
     {
-      index = plotdata->size();
+      // keep the column in the header, but without samples
+      continue;
     }
-    indices[i] = index + 1;
-  }
-
-  bool done = false;
-  QStringList rows = { labels };
-
-  while (!done)
-  {
-    // done will become false if at least one plotdata is not completed
-    done = true;
-    double min_time = std::numeric_limits<double>::max();
-
-    for (size_t i = 0; i < plot_count; i++)
+    series.points.reserve(plotdata.size() - index);
+    for (size_t i = index + 1; i < plotdata.size(); i++)
     {
-      size_t index = indices[i];
-      const PJ::PlotData* plotdata = (ordered_plotdata[i].second);
-      row_values[i] = NaN;
-
-      if (index >= plotdata->size())
-      {
-        continue;
-      }
-      const auto& point = plotdata->at(index);
+      const auto& point = plotdata.at(i);
       if (point.x > time_end)
       {
-        continue;
+        break;
       }
+      series.points.push_back({ point.x, point.y });
+    }
+  }
+  return snapshot;
+}
 
-      done = false;
+std::string StatePublisherCSV::buildRangeCSV(const std::vector<SeriesSnapshot>& series)
+{
+  const size_t plot_count = series.size();
 
-      if (min_time > point.x)
-      {
-        min_time = point.x;  // new min_time
-        // reset previous flags
-        std::fill(row_values.begin(), row_values.begin() + i, NaN);
-        row_values[i] = point.y;
-      }
-      else if (std::abs(min_time - point.x) < std::numeric_limits<double>::epsilon())
-      {
-        row_values[i] = point.y;
-      }
-    }
+  size_t total_points = 0;
+  for (const auto& it : series)
+  {
+    total_points += it.points.size();
+  }
 
-    if (min_time > time_end || done)
-    {
-      break;
-    }
+  std::string out;
+  // rough guess (timestamp + value + separators per sample), to reduce
+  // the number of reallocations while the buffer grows
+  out.reserve(64 + total_points * 32);
 
-    // the row to append to the CSV file
-    QString row_str = QString::number(min_time, 'f', 6) + ",";
+  out += "__time,";
+  for (size_t i = 0; i < plot_count; i++)
+  {
+    out += series[i].name;
+    out += (i + 1 < plot_count) ? ',' : '\n';
+  }
+
+  // align all the series onto a merged time base in one linear pass,
+  // a NaN column entry becomes an empty CSV cell
+  std::vector<const std::vector<PJ::PlotData::Point>*> columns_in;
+  columns_in.reserve(plot_count);
+  for (const auto& it : series)
+  {
+    columns_in.push_back(&it.points);
+  }
+  const PJ::AlignedMatrix matrix = PJ::AlignSeries(columns_in, false);
+
+  for (size_t row = 0; row < matrix.timestamps.size(); row++)
+  {
+    // the row to append to the CSV file. fmt is considerably faster than
+    // QString::number and appends in place
+    fmt::format_to(std::back_inserter(out), "{:.6f},", matrix.timestamps[row]);
 
     for (size_t i = 0; i < plot_count; i++)
     {
-      if (!std::isnan(row_values[i]))
+      const double value = matrix.columns[i][row];
+      if (!std::isnan(value))
       {
-        row_str += QString::number(row_values[i], 'f', 9);
-        // value used, move to the nex index
-        indices[i]++;
+        fmt::format_to(std::back_inserter(out), "{:.9f}", value);
       }
-      row_str += (i + 1 < plot_count) ? "," : "\n";
+      out += (i + 1 < plot_count) ? ',' : '\n';
     }
-    rows.push_back(row_str);
   }
-  return rows.join("");
+  return out;
+}
+
+QString StatePublisherCSV::generateRangeCSV(double time_start, double time_end)
+{
+  return QString::fromStdString(buildRangeCSV(snapshotRange(time_start, time_end)));
 }
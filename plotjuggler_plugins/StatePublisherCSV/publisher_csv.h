@@ -4,9 +4,12 @@
 #include <QObject>
 #include <QtPlugin>
 #include <QDialog>
+#include <QFutureWatcher>
 #include <QTimer>
 #include <thread>
 #include <mutex>
+#include <string>
+#include <vector>
 #include "ui_publisher_csv_dialog.h"
 #include "PlotJuggler/statepublisher_base.h"
 
@@ -54,13 +57,29 @@ private:
   double _start_time = std::numeric_limits<double>::quiet_NaN();
   double _end_time = std::numeric_limits<double>::quiet_NaN();
 
-  QDialog* _dialog;
-  Ui::PublisherCSV_DIalog* _ui;
+  QDialog* _dialog = nullptr;
+  Ui::PublisherCSV_DIalog* _ui = nullptr;
 
-  QTimer* _notification_timer;
+  QTimer* _notification_timer = nullptr;
+
+  // worker writing the range CSV to file; the result is an error message,
+  // empty on success
+  QFutureWatcher<QString> _export_watcher;
+
+  /// Copy of the samples of one series inside the exported time range.
+  /// The export worker reads these, never _datamap.
+  struct SeriesSnapshot
+  {
+    std::string name;
+    std::vector<PJ::PlotData::Point> points;
+  };
 
   void delayedClearNotification();
 
+  std::vector<SeriesSnapshot> snapshotRange(double time_start, double time_end);
+
+  static std::string buildRangeCSV(const std::vector<SeriesSnapshot>& series);
+
   QString generateRangeCSV(double time_start, double time_end);
 
   QString generateStatisticsCSV(double time_start, double time_end);
@@ -69,7 +88,11 @@ private:
 
   void updateButtonsState();
 
+  QString getSaveFilename();
+
   void saveFile(QString text);
+
+  void saveRangeFileAsync();
 };
 
 #endif  // STATE_PUBLISHER_ZMQ_H
@@ -1,121 +1,189 @@
 #include "statepublisher_zmq.h"
-#include <QTextStream>
-#include <QFile>
-#include <QMessageBox>
+
+#include <QSettings>
+#include <cmath>
+#include <cstring>
 #include <zmq.hpp>
-#include <thread>
 
-StatePublisherZMQ::StatePublisherZMQ()
-  : _prev_dataplot(0), _thread(std::bind(&StatePublisherZMQ::run_thread, this)), _prev_time(0)
+// How many data messages between two periodic layout re-sends, so that a
+// subscriber joining mid-stream does not wait for a series change.
+static constexpr int LAYOUT_RESEND_PERIOD = 100;
+
+static constexpr char LAYOUT_TOPIC[] = "PJ/layout";
+static constexpr char DATA_TOPIC[] = "PJ/data";
+
+// Passed as "hint" to zmq_msg_init_data(): keeps the buffer of an in-flight
+// message alive until ZMQ has sent it, then returns it to the pool.
+struct InFlightBuffer
 {
+  std::shared_ptr<StatePublisherZMQ::BufferPool> pool;
+  std::vector<uint8_t> buffer;
+};
+
+extern "C" void statepublisher_zmq_free_fn(void*, void* hint)
+{
+  auto* in_flight = static_cast<InFlightBuffer*>(hint);
+  {
+    std::lock_guard<std::mutex> lock(in_flight->pool->mutex);
+    in_flight->pool->free_buffers.push_back(std::move(in_flight->buffer));
+  }
+  delete in_flight;
 }
 
-StatePublisherZMQ::~StatePublisherZMQ()
+template <typename T>
+static void AppendPOD(std::vector<uint8_t>& buffer, const T& value)
 {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
 }
 
-void StatePublisherZMQ::run_thread()
+StatePublisherZMQ::StatePublisherZMQ() : _pool(std::make_shared<BufferPool>())
 {
-  zmq::context_t context(1);
-  zmq::socket_t socket(context, ZMQ_REP);
-  socket.bind("tcp://*:6665");
+}
 
-  while (true)
-  {
-    zmq::message_t request;
+StatePublisherZMQ::~StatePublisherZMQ()
+{
+  setEnabled(false);
+}
 
-    //  Wait for next request from client
-    socket.recv(&request);
-    const char* request_data = (const char*)request.data();
+void StatePublisherZMQ::setEnabled(bool enabled)
+{
+  if (enabled == _enabled)
+  {
+    return;
+  }
+  _enabled = enabled;
 
-    if (strncmp(request_data, "[get_data_names]", 16) == 0)
-    {
-      QString string_reply;
+  if (_enabled)
+  {
+    QSettings settings;
+    const QString endpoint =
+        settings.value("StatePublisherZMQ/endpoint", "tcp://*:9872").toString();
+
+    _context = std::make_unique<zmq::context_t>(1);
+    _socket = std::make_unique<zmq::socket_t>(*_context, zmq::socket_type::pub);
+    // never block the GUI thread: drop instead of waiting on slow subscribers
+    _socket->set(zmq::sockopt::linger, 100);
+    _socket->bind(endpoint.toStdString());
+
+    _layout_series.clear();
+    _layout_names.clear();
+    _ticks_since_layout = 0;
+  }
+  else
+  {
+    _socket.reset();
+    _context.reset();
+  }
+}
 
-      _mutex.lock();
+void StatePublisherZMQ::updateState(double current_time)
+{
+  publish(current_time);
+}
 
-      std::map<QString, double>::iterator it;
-      for (it = _current_data.begin(); it != _current_data.end(); it++)
-      {
-        string_reply.append(it->first + QString(" "));
-      }
-      _mutex.unlock();
+void StatePublisherZMQ::play(double current_time)
+{
+  publish(current_time);
+}
 
-      zmq::message_t reply(string_reply.size());
-      socket.send(reply);
-    }
-    else if (strncmp(request_data, "[get_data]", 10) == 0)
-    {
-      bool abort = false;
-      QString string_request = QString::fromUtf8(&request_data[10], request.size() - 10);
-      QStringList names = string_request.split(';');
-
-      _mutex.lock();
-      QString string_reply;
-
-      for (int i = 0; i < names.count(); i++)
-      {
-        std::map<QString, double>::iterator it = _current_data.find(names.at(i));
-        if (it == _current_data.end())
-        {
-          abort = true;
-          break;
-        }
-        else
-        {
-          double value = it->second;
-          string_reply.append(QString::number(value) + QString(" "));
-        }
-      }
-      _mutex.unlock();
-
-      if (abort)
-      {
-        zmq::message_t reply(5);
-        memcpy(reply.data(), "Error", 5);
-        socket.send(reply);
-      }
-      else
-      {
-        zmq::message_t reply(string_reply.size());
-        socket.send(reply);
-      }
-    }
-    else
+bool StatePublisherZMQ::layoutChanged() const
+{
+  if (_datamap->numeric.size() != _layout_names.size())
+  {
+    return true;
+  }
+  size_t i = 0;
+  for (const auto& it : _datamap->numeric)
+  {
+    if (it.first != _layout_names[i++])
     {
-      zmq::message_t reply(5);
-      memcpy(reply.data(), "Error", 5);
-      socket.send(reply);
+      return true;
     }
   }
+  return false;
 }
 
-void StatePublisherZMQ::updateState(PlotDataMap* datamap, double current_time)
+void StatePublisherZMQ::rebuildLayout()
 {
-  if (datamap == 0)
+  _layout_series.clear();
+  _layout_names.clear();
+  _layout_series.reserve(_datamap->numeric.size());
+  _layout_names.reserve(_datamap->numeric.size());
+
+  for (const auto& it : _datamap->numeric)
+  {
+    _layout_names.push_back(it.first);
+    _layout_series.push_back(&it.second);
+  }
+  _layout_id++;
+}
+
+void StatePublisherZMQ::sendBuffer(const char* topic, size_t topic_size,
+                                   std::vector<uint8_t> payload)
+{
+  zmq::message_t topic_msg(topic, topic_size);
+
+  auto* in_flight = new InFlightBuffer{ _pool, std::move(payload) };
+  zmq::message_t payload_msg(in_flight->buffer.data(), in_flight->buffer.size(),
+                             statepublisher_zmq_free_fn, in_flight);
+
+  _socket->send(topic_msg, zmq::send_flags::sndmore | zmq::send_flags::dontwait);
+  _socket->send(payload_msg, zmq::send_flags::dontwait);
+}
+
+void StatePublisherZMQ::publish(double current_time)
+{
+  if (!_enabled || !_socket || !_datamap)
   {
-    _prev_dataplot = datamap;
-    _prev_time = current_time;
-    _mutex.lock();
-    _current_data.clear();
-    _mutex.unlock();
     return;
   }
 
-  PlotDataMap::iterator it;
+  const bool changed = layoutChanged();
+  if (changed)
+  {
+    rebuildLayout();
+  }
+  const bool send_layout = changed || (_ticks_since_layout == 0);
 
-  _mutex.lock();
-  if (datamap != _prev_dataplot || current_time != _prev_time)
+  auto takeBuffer = [this]() {
+    std::vector<uint8_t> buffer;
+    std::lock_guard<std::mutex> lock(_pool->mutex);
+    if (!_pool->free_buffers.empty())
+    {
+      buffer = std::move(_pool->free_buffers.back());
+      _pool->free_buffers.pop_back();
+      buffer.clear();
+    }
+    return buffer;
+  };
+
+  const auto series_count = static_cast<uint32_t>(_layout_series.size());
+
+  if (send_layout)
   {
-    for (it = datamap->begin(); it != datamap->end(); it++)
+    auto buffer = takeBuffer();
+    AppendPOD(buffer, _layout_id);
+    AppendPOD(buffer, series_count);
+    for (const auto& name : _layout_names)
     {
-      const QString& name = it->first;
-      PlotDataPtr Timeseries = it->second;
-      _current_data[name] = plotdata->getY(current_time);
+      AppendPOD(buffer, static_cast<uint16_t>(name.size()));
+      buffer.insert(buffer.end(), name.begin(), name.end());
     }
+    sendBuffer(LAYOUT_TOPIC, sizeof(LAYOUT_TOPIC) - 1, std::move(buffer));
+    _ticks_since_layout = LAYOUT_RESEND_PERIOD;
   }
-  _mutex.unlock();
-
-  _prev_dataplot = datamap;
-  _prev_time = current_time;
+  _ticks_since_layout--;
+
+  auto buffer = takeBuffer();
+  buffer.reserve(2 * sizeof(uint32_t) + (1 + series_count) * sizeof(double));
+  AppendPOD(buffer, _layout_id);
+  AppendPOD(buffer, series_count);
+  AppendPOD(buffer, current_time);
+  for (const auto* series : _layout_series)
+  {
+    const auto value = series->getYfromX(current_time);
+    AppendPOD(buffer, value ? *value : std::nan(""));
+  }
+  sendBuffer(DATA_TOPIC, sizeof(DATA_TOPIC) - 1, std::move(buffer));
 }
@@ -3,12 +3,49 @@
 
 #include <QObject>
 #include <QtPlugin>
-#include <zmq.hpp>
-#include <thread>
+#include <memory>
 #include <mutex>
-#include "../statepublisher_base.h"
+#include <string>
+#include <vector>
+#include "PlotJuggler/statepublisher_base.h"
 
-class StatePublisherZMQ : public QObject, StatePublisher
+namespace zmq
+{
+class context_t;
+class socket_t;
+}  // namespace zmq
+
+/**
+ * Publishes the value of every numeric series at the tracker position over a
+ * ZMQ PUB socket. The whole tick is batched into a single two-frame multipart
+ * message, sent zero-copy from pooled buffers, instead of one small send per
+ * series.
+ *
+ * Wire format (integers and doubles little-endian, names UTF-8):
+ *
+ * Layout message, sent when the set of series changes and periodically for
+ * late subscribers:
+ *   frame 0: "PJ/layout"
+ *   frame 1: uint32 layout_id
+ *            uint32 series_count
+ *            series_count x { uint16 name_length, name bytes }
+ *
+ * Data message, sent on every tick:
+ *   frame 0: "PJ/data"
+ *   frame 1: uint32 layout_id
+ *            uint32 series_count
+ *            double timestamp
+ *            series_count x double value   (same order as the layout,
+ *                                           NaN when a series has no sample
+ *                                           at or before the timestamp)
+ *
+ * Subscribers should drop data messages whose layout_id they have not seen
+ * yet and wait for the next layout message.
+ *
+ * The endpoint is read from the QSettings key "StatePublisherZMQ/endpoint"
+ * (default "tcp://*:9872").
+ */
+class StatePublisherZMQ : public PJ::StatePublisher
 {
   Q_OBJECT
   Q_PLUGIN_METADATA(IID "facontidavide.PlotJuggler3.StatePublisher")
@@ -17,20 +54,54 @@ class StatePublisherZMQ : public QObject, StatePublisher
 public:
   StatePublisherZMQ();
 
-  virtual void updateState(PlotDataMap* datamap, double current_time);
+  const char* name() const override
+  {
+    return "ZMQ Publisher";
+  }
+
+  ~StatePublisherZMQ() override;
+
+  bool enabled() const override
+  {
+    return _enabled;
+  }
 
-  virtual ~StatePublisherZMQ();
+  void updateState(double current_time) override;
+
+  void play(double current_time) override;
+
+public slots:
+  void setEnabled(bool enabled) override;
 
 private:
-  PlotDataMap* _prev_dataplot;
+  /// Recycles the serialization buffers of messages that ZMQ has finished
+  /// sending. Shared with the in-flight messages, so that disabling the
+  /// plugin while sends are pending remains safe.
+  struct BufferPool
+  {
+    std::mutex mutex;
+    std::vector<std::vector<uint8_t>> free_buffers;
+  };
+
+  void publish(double current_time);
+  bool layoutChanged() const;
+  void rebuildLayout();
+  void sendBuffer(const char* topic, size_t topic_size, std::vector<uint8_t> payload);
+
+  bool _enabled = false;
 
-  void run_thread();
+  std::unique_ptr<zmq::context_t> _context;
+  std::unique_ptr<zmq::socket_t> _socket;
 
-  std::thread _thread;
-  std::mutex _mutex;
+  std::shared_ptr<BufferPool> _pool;
 
-  std::map<QString, double> _current_data;
-  double _prev_time;
+  /// Series of the current layout, in wire order. The pointers stay valid
+  /// between layout rebuilds because PlotDataMapRef stores the series in
+  /// node-based maps.
+  std::vector<const PJ::PlotData*> _layout_series;
+  std::vector<std::string> _layout_names;
+  uint32_t _layout_id = 0;
+  int _ticks_since_layout = 0;
 };
 
 #endif  // STATE_PUBLISHER_ZMQ_H
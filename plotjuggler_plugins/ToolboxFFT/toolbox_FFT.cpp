@@ -7,11 +7,86 @@
 #include <QDebug>
 #include <QDragEnterEvent>
 #include <QSettings>
+#include <QtConcurrent/QtConcurrent>
+#include <map>
 
 #include "PlotJuggler/transform_function.h"
 #include "PlotJuggler/svg_util.h"
 #include "KissFFT/kiss_fftr.h"
 
+namespace
+{
+struct FftPlan
+{
+  kiss_fftr_cfg cfg = nullptr;
+  ~FftPlan()
+  {
+    free(cfg);
+  }
+};
+
+// The scratch buffers inside a kissfft configuration make it unsafe to share
+// between threads: keep one cache per worker thread instead. Plans outlive
+// the single calculation, so scrubbing a window of constant length reuses
+// the same configuration instead of re-allocating it.
+kiss_fftr_cfg CachedPlan(size_t N)
+{
+  thread_local std::map<size_t, FftPlan> plans;
+  auto& plan = plans[N];
+  if (!plan.cfg)
+  {
+    plan.cfg = kiss_fftr_alloc(N, false, nullptr, nullptr);
+  }
+  return plan.cfg;
+}
+
+struct FftJob
+{
+  std::string curve_id;
+  QColor color = Qt::transparent;
+  // detached from the live series: immutable, owned by this job
+  PJ::PlotDataMapRef::SeriesSnapshot snapshot;
+  size_t N = 0;
+  double dT = 0;
+  bool remove_average = false;
+  std::vector<PJ::PlotDataXY::Point> spectrum;
+};
+
+void CalculateSpectrum(FftJob& job)
+{
+  const auto& ys = job.snapshot.ys;
+  const size_t N = job.N;
+
+  double sum = 0;
+  if (job.remove_average)
+  {
+    for (size_t i = 0; i < N; i++)
+    {
+      sum += ys[i];
+    }
+  }
+  const double average = sum / double(N);
+
+  std::vector<kiss_fft_scalar> input;
+  input.reserve(N);
+  for (size_t i = 0; i < N; i++)
+  {
+    input.push_back(static_cast<kiss_fft_scalar>(ys[i] - average));
+  }
+
+  std::vector<kiss_fft_cpx> out(N / 2 + 1);
+  kiss_fftr(CachedPlan(N), input.data(), out.data());
+
+  job.spectrum.reserve(N / 2);
+  for (size_t i = 0; i < N / 2; i++)
+  {
+    kiss_fft_scalar Hz = i * (1.0 / job.dT) / double(N);
+    kiss_fft_scalar amplitude = std::hypot(out[i].r, out[i].i) / N;
+    job.spectrum.push_back({ Hz, amplitude });
+  }
+}
+}  // namespace
+
 ToolboxFFT::ToolboxFFT()
 {
   _widget = new QWidget(nullptr);
@@ -26,6 +101,12 @@ ToolboxFFT::ToolboxFFT()
   connect(ui->pushButtonSave, &QPushButton::clicked, this, &ToolboxFFT::onSaveCurve);
 
   connect(ui->pushButtonClear, &QPushButton::clicked, this, &ToolboxFFT::onClearCurves);
+
+  _recalc_timer.setSingleShot(true);
+  _recalc_timer.setInterval(100);
+  connect(&_recalc_timer, &QTimer::timeout, this, &ToolboxFFT::calculateCurveFFT);
+
+  connect(&_fft_watcher, &QFutureWatcherBase::finished, this, &ToolboxFFT::onFFTCompleted);
 }
 
 ToolboxFFT::~ToolboxFFT()
@@ -74,104 +155,111 @@ bool ToolboxFFT::onShowWidget()
 
 void ToolboxFFT::calculateCurveFFT()
 {
-  _plot_widget_B->removeAllCurves();
+  if (_fft_watcher.isRunning())
+  {
+    // snapshots must be taken on the GUI thread: serve this request when
+    // the running calculation completes
+    _recalc_pending = true;
+    return;
+  }
+
+  std::vector<FftJob> jobs;
+  jobs.reserve(_curve_names.size());
 
   for (const auto& curve_id : _curve_names)
   {
-    auto it = _plot_data->numeric.find(curve_id);
-    if (it == _plot_data->numeric.end())
+    PJ::RangeOpt range;
+    if (ui->radioZoomed->isChecked())
     {
-      return;
+      range = _zoom_range;
     }
-    PlotData& curve_data = it->second;
-
-    if (curve_data.size() == 0)
+    auto snapshot = _plot_data->snapshotNumeric(curve_id, range);
+    if (!snapshot)
     {
       return;
     }
 
-    size_t min_index = 0;
-    size_t max_index = curve_data.size() - 1;
-
-    if (ui->radioZoomed->isChecked())
-    {
-      min_index = curve_data.getIndexFromX(_zoom_range.min);
-      max_index = curve_data.getIndexFromX(_zoom_range.max);
-    }
-
-    size_t N = 1 + max_index - min_index;
-
+    size_t N = snapshot->size();
     if (N & 1)
     {  // if not even, make it even
       N--;
-      max_index--;
     }
-
     if (N < 8)
     {
       return;
     }
 
-    double dT = (curve_data.at(max_index).x - curve_data.at(min_index).x) / double(N - 1);
-
-    std::vector<kiss_fft_scalar> input;
-    input.reserve(curve_data.size());
-
-    double sum = 0;
-    if (ui->checkAverage->isChecked())
+    FftJob job;
+    job.curve_id = curve_id;
+    job.N = N;
+    job.dT = (snapshot->xs[N - 1] - snapshot->xs[0]) / double(N - 1);
+    job.remove_average = ui->checkAverage->isChecked();
+    auto it = _plot_data->numeric.find(curve_id);
+    auto colorHint = it->second.attribute(COLOR_HINT);
+    if (colorHint.isValid())
     {
-      for (size_t i = 0; i < N; i++)
-      {
-        sum += curve_data[i + min_index].y;
-      }
+      job.color = colorHint.value<QColor>();
     }
-    double average = sum / double(N);
+    job.snapshot = std::move(*snapshot);
+    jobs.push_back(std::move(job));
+  }
 
-    for (size_t i = 0; i < N; i++)
+  // the jobs own detached snapshots of the series: the FFT runs on the
+  // pool while streaming keeps appending to the live data, and the GUI
+  // stays responsive even with very large windows
+  _fft_watcher.setFuture(QtConcurrent::run([jobs = std::move(jobs)]() mutable {
+    if (jobs.size() > 1)
     {
-      size_t index = i + min_index;
-      const auto& p = curve_data[index];
-      input.push_back(static_cast<kiss_fft_scalar>(p.y - average));
-
-      if (i != 0)
+      QtConcurrent::blockingMap(jobs, CalculateSpectrum);
+    }
+    else
+    {
+      for (auto& job : jobs)
       {
-        double dTi = (p.x - curve_data[index - 1].x);
-        double diff = dTi - dT;
-        // std_dev += diff*diff;
+        CalculateSpectrum(job);
       }
     }
-    // std_dev = sqrt(std_dev / double(N-1) );
+    std::vector<ToolboxFFT::FftResult> results;
+    results.reserve(jobs.size());
+    for (auto& job : jobs)
+    {
+      results.push_back({ std::move(job.curve_id), job.color, std::move(job.spectrum) });
+    }
+    return results;
+  }));
+}
 
-    std::vector<kiss_fft_cpx> out(N / 2 + 1);
+void ToolboxFFT::onFFTCompleted()
+{
+  const auto results = _fft_watcher.result();
 
-    auto config = kiss_fftr_alloc(N, false, nullptr, nullptr);
+  // the curves were cleared while this calculation was in flight
+  if (_curve_names.empty())
+  {
+    return;
+  }
 
-    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-    kiss_fftr(config, input.data(), out.data());
-    QApplication::restoreOverrideCursor();
+  // the previous spectrum stayed visible until this one was ready
+  _plot_widget_B->removeAllCurves();
 
-    auto& curver_fft = _local_data.getOrCreateScatterXY(curve_id);
+  for (const auto& result : results)
+  {
+    auto& curver_fft = _local_data.getOrCreateScatterXY(result.curve_id);
     curver_fft.clear();
-    for (size_t i = 0; i < N / 2; i++)
-    {
-      kiss_fft_scalar Hz = i * (1.0 / dT) / double(N);
-      kiss_fft_scalar amplitude = std::hypot(out[i].r, out[i].i) / N;
-      curver_fft.pushBack({ Hz, amplitude });
-    }
-
-    QColor color = Qt::transparent;
-    auto colorHint = curve_data.attribute(COLOR_HINT);
-    if (colorHint.isValid())
+    for (const auto& point : result.spectrum)
     {
-      color = colorHint.value<QColor>();
+      curver_fft.pushBack(point);
     }
-
-    _plot_widget_B->addCurve(curve_id + "_FFT", curver_fft, color);
-
-    free(config);
+    _plot_widget_B->addCurve(result.curve_id + "_FFT", curver_fft, result.color);
   }
 
   _plot_widget_B->resetZoom();
+
+  if (_recalc_pending)
+  {
+    _recalc_pending = false;
+    calculateCurveFFT();
+  }
 }
 
 void ToolboxFFT::onClearCurves()
@@ -249,6 +337,13 @@ void ToolboxFFT::onViewResized(const QRectF& rect)
 {
   _zoom_range.min = rect.left();
   _zoom_range.max = rect.right();
+
+  // when the spectrum follows the zoomed area, recalculate it as soon as
+  // the user stops moving the view
+  if (ui->radioZoomed->isChecked() && ui->pushButtonCalculate->isEnabled())
+  {
+    _recalc_timer.start();
+  }
 }
 
 void ToolboxFFT::onSaveCurve()
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QtPlugin>
+#include <QTimer>
+#include <QFutureWatcher>
 #include <thread>
 #include "PlotJuggler/toolbox_base.h"
 #include "PlotJuggler/plotwidget_base.h"
@@ -54,6 +56,24 @@ private:
 
   std::vector<std::string> _curve_names;
 
+  // debounces the recalculations triggered by zooming the preview
+  QTimer _recalc_timer;
+
+  /// Spectrum of one curve, computed off the GUI thread.
+  struct FftResult
+  {
+    std::string curve_id;
+    QColor color;
+    std::vector<PJ::PlotDataXY::Point> spectrum;
+  };
+
+  // delivers the asynchronous FFT results back to the GUI thread
+  QFutureWatcher<std::vector<FftResult>> _fft_watcher;
+
+  // a Calculate request received while the previous one was still
+  // running: served when the watcher finishes
+  bool _recalc_pending = false;
+
 private slots:
 
   void onDragEnterEvent(QDragEnterEvent* event);
@@ -61,5 +81,6 @@ private slots:
   void onViewResized(const QRectF& rect);
   void onSaveCurve();
   void calculateCurveFFT();
+  void onFFTCompleted();
   void onClearCurves();
 };
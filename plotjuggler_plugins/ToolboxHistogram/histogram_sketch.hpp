@@ -0,0 +1,158 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Incrementally maintained histogram of a growing series.
+ *
+ * Appending a sample is O(1): the bin counters of the current block
+ * (1024 samples) and of the current superblock (64 blocks) are both
+ * incremented. Querying the counts over an arbitrary range of sample
+ * indexes then merges whole superblocks and whole blocks, and only the
+ * two partial blocks at the edges of the range need to be re-binned from
+ * the raw samples. This keeps re-queries instantaneous when the visible
+ * time window changes, even with a hundred million samples, at a cost of
+ * roughly (2 + 1/16) bytes per bin per kilosample.
+ *
+ * The value domain [range_min, range_max) is fixed when the sketch is
+ * reset; samples outside of it are clamped into the first / last bin.
+ */
+class HistogramSketch
+{
+public:
+  static constexpr size_t BLOCK_SIZE = 1024;
+  static constexpr size_t BLOCKS_PER_SUPER = 64;
+  static constexpr size_t SUPER_SIZE = BLOCK_SIZE * BLOCKS_PER_SUPER;
+
+  /// Discard all counters and fix the value domain and the bin count.
+  void reset(double range_min, double range_max, size_t bins)
+  {
+    _min = range_min;
+    _width = (range_max > range_min) ? (range_max - range_min) : 1.0;
+    _bins = std::max<size_t>(1, bins);
+    _count = 0;
+    _block_counts.clear();
+    _super_counts.clear();
+  }
+
+  size_t binCount() const
+  {
+    return _bins;
+  }
+
+  size_t sampleCount() const
+  {
+    return _count;
+  }
+
+  double binWidth() const
+  {
+    return _width / double(_bins);
+  }
+
+  /// Lower edge of a bin, in the units of the sampled values.
+  double binLowerEdge(size_t bin) const
+  {
+    return _min + _width * (double(bin) / double(_bins));
+  }
+
+  /// Bin of a value, clamped to the first / last bin.
+  size_t binOf(double value) const
+  {
+    if (std::isnan(value))
+    {
+      return 0;
+    }
+    const double normalized = std::clamp((value - _min) / _width, 0.0, 1.0);
+    const auto bin = size_t(normalized * double(_bins));
+    return std::min(bin, _bins - 1);
+  }
+
+  /// O(1): increment the counters of the current block and superblock.
+  void append(double value)
+  {
+    const size_t block = _count / BLOCK_SIZE;
+    const size_t super = block / BLOCKS_PER_SUPER;
+    if ((block + 1) * _bins > _block_counts.size())
+    {
+      _block_counts.resize((block + 1) * _bins, 0);
+    }
+    if ((super + 1) * _bins > _super_counts.size())
+    {
+      _super_counts.resize((super + 1) * _bins, 0);
+    }
+    const size_t bin = binOf(value);
+    _block_counts[block * _bins + bin]++;
+    _super_counts[super * _bins + bin]++;
+    _count++;
+  }
+
+  /**
+   * Accumulate into `counts` (resized to binCount() and zeroed) the bins
+   * of the samples with index in [first, last).
+   *
+   * `scan(begin, end, counts)` is invoked for the index sub-ranges not
+   * covered by a whole block — at most 2 * BLOCK_SIZE samples in total —
+   * and must bin the raw samples with binOf(), incrementing `counts`.
+   */
+  template <typename ScanFn>
+  void query(size_t first, size_t last, std::vector<uint64_t>& counts, const ScanFn& scan) const
+  {
+    counts.assign(_bins, 0);
+    first = std::min(first, _count);
+    last = std::min(last, _count);
+
+    size_t index = first;
+    while (index < last)
+    {
+      if (index % SUPER_SIZE == 0 && index + SUPER_SIZE <= last)
+      {
+        const uint32_t* src = &_super_counts[(index / SUPER_SIZE) * _bins];
+        for (size_t bin = 0; bin < _bins; bin++)
+        {
+          counts[bin] += src[bin];
+        }
+        index += SUPER_SIZE;
+      }
+      else if (index % BLOCK_SIZE == 0 && index + BLOCK_SIZE <= last)
+      {
+        const uint16_t* src = &_block_counts[(index / BLOCK_SIZE) * _bins];
+        for (size_t bin = 0; bin < _bins; bin++)
+        {
+          counts[bin] += src[bin];
+        }
+        index += BLOCK_SIZE;
+      }
+      else
+      {
+        // partial block at either edge of the range
+        const size_t block_end = (index / BLOCK_SIZE + 1) * BLOCK_SIZE;
+        const size_t end = std::min(last, block_end);
+        scan(index, end, counts);
+        index = end;
+      }
+    }
+  }
+
+private:
+  double _min = 0.0;
+  double _width = 1.0;
+  size_t _bins = 1;
+  size_t _count = 0;
+
+  // flattened [block][bin] and [superblock][bin] counters. A block holds
+  // at most 1024 samples, so uint16_t cannot overflow; a superblock holds
+  // at most 65536, well within uint32_t.
+  std::vector<uint16_t> _block_counts;
+  std::vector<uint32_t> _super_counts;
+};
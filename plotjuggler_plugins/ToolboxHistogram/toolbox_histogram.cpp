@@ -0,0 +1,323 @@
+#include "toolbox_histogram.h"
+#include "ui_toolbox_histogram.h"
+
+#include <QDialogButtonBox>
+#include <QEvent>
+#include <QMimeData>
+#include <QDebug>
+#include <QDragEnterEvent>
+#include <QSettings>
+
+#include "PlotJuggler/transform_function.h"
+#include "PlotJuggler/svg_util.h"
+
+ToolboxHistogram::ToolboxHistogram()
+{
+  _widget = new QWidget(nullptr);
+  ui = new Ui::toolbox_histogram;
+
+  ui->setupUi(_widget);
+
+  connect(ui->buttonBox, &QDialogButtonBox::rejected, this, &ToolboxPlugin::closed);
+
+  connect(ui->pushButtonCalculate, &QPushButton::clicked, this,
+          &ToolboxHistogram::calculateHistogram);
+
+  connect(ui->pushButtonSave, &QPushButton::clicked, this, &ToolboxHistogram::onSaveCurve);
+
+  connect(ui->pushButtonClear, &QPushButton::clicked, this, &ToolboxHistogram::onClearCurves);
+
+  connect(ui->checkNormalized, &QCheckBox::toggled, this, &ToolboxHistogram::calculateHistogram);
+
+  _recalc_timer.setSingleShot(true);
+  _recalc_timer.setInterval(100);
+  connect(&_recalc_timer, &QTimer::timeout, this, &ToolboxHistogram::calculateHistogram);
+
+  _refresh_timer.setInterval(1000);
+  connect(&_refresh_timer, &QTimer::timeout, this, &ToolboxHistogram::onRefreshTimeout);
+}
+
+ToolboxHistogram::~ToolboxHistogram()
+{
+  delete ui;
+}
+
+void ToolboxHistogram::init(PJ::PlotDataMapRef& src_data, PJ::TransformsMap& transform_map)
+{
+  _plot_data = &src_data;
+  _transforms = &transform_map;
+
+  _plot_widget_A = new PJ::PlotWidgetBase(ui->framePlotPreviewA);
+  _plot_widget_B = new PJ::PlotWidgetBase(ui->framePlotPreviewB);
+
+  auto preview_layout_A = new QHBoxLayout(ui->framePlotPreviewA);
+  preview_layout_A->setMargin(6);
+  preview_layout_A->addWidget(_plot_widget_A);
+
+  auto preview_layout_B = new QHBoxLayout(ui->framePlotPreviewB);
+  preview_layout_B->setMargin(6);
+  preview_layout_B->addWidget(_plot_widget_B);
+
+  _plot_widget_A->setAcceptDrops(true);
+
+  connect(_plot_widget_A, &PlotWidgetBase::dragEnterSignal, this,
+          &ToolboxHistogram::onDragEnterEvent);
+
+  connect(_plot_widget_A, &PlotWidgetBase::dropSignal, this, &ToolboxHistogram::onDropEvent);
+
+  connect(_plot_widget_A, &PlotWidgetBase::viewResized, this, &ToolboxHistogram::onViewResized);
+}
+
+std::pair<QWidget*, PJ::ToolboxPlugin::WidgetType> ToolboxHistogram::providedWidget() const
+{
+  return { _widget, PJ::ToolboxPlugin::FIXED };
+}
+
+bool ToolboxHistogram::onShowWidget()
+{
+  QSettings settings;
+  QString theme = settings.value("StyleSheet::theme", "light").toString();
+
+  ui->pushButtonClear->setIcon(LoadSvg(":/resources/svg/clear.svg", theme));
+  return true;
+}
+
+void ToolboxHistogram::updateSketch(const std::string& curve_id, const PJ::PlotData& curve_data)
+{
+  auto& state = _sketches[curve_id];
+  const size_t bins = size_t(ui->spinBoxBins->value());
+
+  // appending samples never invalidates the existing counters, but a
+  // trimmed front (streaming buffers discarding old data) shifts every
+  // sample index, and a new bin count changes the domain partition:
+  // both force a full rebuild.
+  const bool trimmed = state.samples_fed > curve_data.size() ||
+                       (state.samples_fed > 0 && curve_data.front().x != state.front_time);
+
+  if (trimmed || state.sketch.binCount() != bins || state.samples_fed == 0)
+  {
+    auto range = curve_data.rangeY();
+    if (!range)
+    {
+      return;
+    }
+    state.sketch.reset(range->min, range->max, bins);
+    state.samples_fed = 0;
+  }
+
+  for (size_t i = state.samples_fed; i < curve_data.size(); i++)
+  {
+    state.sketch.append(curve_data[i].y);
+  }
+  state.samples_fed = curve_data.size();
+  state.front_time = curve_data.size() > 0 ? curve_data.front().x : 0;
+}
+
+void ToolboxHistogram::calculateHistogram()
+{
+  _plot_widget_B->removeAllCurves();
+
+  for (const auto& curve_id : _curve_names)
+  {
+    auto it = _plot_data->numeric.find(curve_id);
+    if (it == _plot_data->numeric.end())
+    {
+      continue;
+    }
+    const PlotData& curve_data = it->second;
+
+    if (curve_data.size() == 0)
+    {
+      continue;
+    }
+
+    updateSketch(curve_id, curve_data);
+    const auto& sketch = _sketches[curve_id].sketch;
+
+    size_t min_index = 0;
+    size_t max_index = curve_data.size() - 1;
+
+    if (ui->radioZoomed->isChecked())
+    {
+      min_index = curve_data.getIndexFromX(_zoom_range.min);
+      max_index = curve_data.getIndexFromX(_zoom_range.max);
+    }
+
+    // merge the pre-computed block counters; only the two partial blocks
+    // at the edges of the range are re-binned from the raw samples
+    std::vector<uint64_t> counts;
+    sketch.query(min_index, max_index + 1, counts,
+                 [&](size_t begin, size_t end, std::vector<uint64_t>& out) {
+                   for (size_t i = begin; i < end; i++)
+                   {
+                     out[sketch.binOf(curve_data[i].y)]++;
+                   }
+                 });
+
+    uint64_t total = 0;
+    for (uint64_t count : counts)
+    {
+      total += count;
+    }
+    if (total == 0)
+    {
+      continue;
+    }
+
+    const bool normalized = ui->checkNormalized->isChecked();
+    const double scale = normalized ? 1.0 / (double(total) * sketch.binWidth()) : 1.0;
+
+    // two points per bin edge give the curve its staircase shape
+    auto& histogram = _local_data.getOrCreateScatterXY(curve_id);
+    histogram.clear();
+    for (size_t bin = 0; bin < counts.size(); bin++)
+    {
+      const double value = double(counts[bin]) * scale;
+      histogram.pushBack({ sketch.binLowerEdge(bin), value });
+      histogram.pushBack({ sketch.binLowerEdge(bin + 1), value });
+    }
+
+    QColor color = Qt::transparent;
+    auto colorHint = curve_data.attribute(COLOR_HINT);
+    if (colorHint.isValid())
+    {
+      color = colorHint.value<QColor>();
+    }
+
+    _plot_widget_B->addCurve(curve_id + "_HIST", histogram, color);
+  }
+
+  _plot_widget_B->resetZoom();
+}
+
+void ToolboxHistogram::onRefreshTimeout()
+{
+  // recalculate only when a source curve actually changed, to avoid
+  // resetting the zoom of the result preview for nothing
+  for (const auto& curve_id : _curve_names)
+  {
+    auto it = _plot_data->numeric.find(curve_id);
+    if (it == _plot_data->numeric.end())
+    {
+      continue;
+    }
+    auto sketch_it = _sketches.find(curve_id);
+    if (sketch_it == _sketches.end() ||
+        sketch_it->second.samples_fed != it->second.size())
+    {
+      calculateHistogram();
+      return;
+    }
+  }
+}
+
+void ToolboxHistogram::onClearCurves()
+{
+  _plot_widget_A->removeAllCurves();
+  _plot_widget_A->resetZoom();
+
+  _plot_widget_B->removeAllCurves();
+  _plot_widget_B->resetZoom();
+
+  ui->pushButtonSave->setEnabled(false);
+  ui->pushButtonCalculate->setEnabled(false);
+
+  ui->lineEditSuffix->setEnabled(false);
+  ui->lineEditSuffix->setText("_HIST");
+
+  _curve_names.clear();
+  _sketches.clear();
+  _refresh_timer.stop();
+}
+
+void ToolboxHistogram::onDragEnterEvent(QDragEnterEvent* event)
+{
+  const QMimeData* mimeData = event->mimeData();
+  QStringList mimeFormats = mimeData->formats();
+
+  for (const QString& format : mimeFormats)
+  {
+    QByteArray encoded = mimeData->data(format);
+    QDataStream stream(&encoded, QIODevice::ReadOnly);
+
+    if (format != "curveslist/add_curve")
+    {
+      return;
+    }
+
+    QStringList curves;
+    while (!stream.atEnd())
+    {
+      QString curve_name;
+      stream >> curve_name;
+      if (!curve_name.isEmpty())
+      {
+        curves.push_back(curve_name);
+      }
+    }
+    _dragging_curves = curves;
+    event->accept();
+  }
+}
+
+void ToolboxHistogram::onDropEvent(QDropEvent*)
+{
+  _zoom_range.min = std::numeric_limits<double>::lowest();
+  _zoom_range.max = std::numeric_limits<double>::max();
+
+  for (auto& curve : _dragging_curves)
+  {
+    std::string curve_id = curve.toStdString();
+    PlotData& curve_data = _plot_data->getOrCreateNumeric(curve_id);
+
+    _plot_widget_A->addCurve(curve_id, curve_data);
+    _curve_names.push_back(curve_id);
+    _zoom_range.min = std::min(_zoom_range.min, curve_data.front().x);
+    _zoom_range.max = std::max(_zoom_range.max, curve_data.back().x);
+  }
+
+  ui->pushButtonSave->setEnabled(true);
+  ui->pushButtonCalculate->setEnabled(true);
+  ui->lineEditSuffix->setEnabled(true);
+
+  _dragging_curves.clear();
+  _plot_widget_A->resetZoom();
+  _refresh_timer.start();
+}
+
+void ToolboxHistogram::onViewResized(const QRectF& rect)
+{
+  _zoom_range.min = rect.left();
+  _zoom_range.max = rect.right();
+
+  // when the histogram follows the zoomed area, requery it as soon as
+  // the user stops moving the view: the sketch makes this cheap
+  if (ui->radioZoomed->isChecked() && ui->pushButtonCalculate->isEnabled())
+  {
+    _recalc_timer.start();
+  }
+}
+
+void ToolboxHistogram::onSaveCurve()
+{
+  auto suffix = ui->lineEditSuffix->text().toStdString();
+  if (suffix.empty())
+  {
+    ui->lineEditSuffix->setText("_HIST");
+    suffix = "_HIST";
+  }
+  for (const auto& curve_id : _curve_names)
+  {
+    auto it = _local_data.scatter_xy.find(curve_id);
+    if (it == _local_data.scatter_xy.end())
+    {
+      continue;
+    }
+    auto& out_data = _plot_data->getOrCreateScatterXY(curve_id + suffix);
+    out_data.clonePoints(it->second);
+
+    emit plotCreated(curve_id + suffix);
+  }
+
+  emit closed();
+}
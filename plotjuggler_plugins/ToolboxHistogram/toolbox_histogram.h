@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QtPlugin>
+#include <QTimer>
+#include <map>
+#include "PlotJuggler/toolbox_base.h"
+#include "PlotJuggler/plotwidget_base.h"
+#include "histogram_sketch.hpp"
+
+namespace Ui
+{
+class toolbox_histogram;
+}
+
+class ToolboxHistogram : public PJ::ToolboxPlugin
+{
+  Q_OBJECT
+  Q_PLUGIN_METADATA(IID "facontidavide.PlotJuggler3.Toolbox")
+  Q_INTERFACES(PJ::ToolboxPlugin)
+
+public:
+  ToolboxHistogram();
+
+  ~ToolboxHistogram() override;
+
+  const char* name() const override
+  {
+    return "Histogram";
+  }
+
+  void init(PJ::PlotDataMapRef& src_data, PJ::TransformsMap& transform_map) override;
+
+  std::pair<QWidget*, WidgetType> providedWidget() const override;
+
+public slots:
+
+  bool onShowWidget() override;
+
+private:
+  // sketch of one source curve, plus enough bookkeeping to detect when it
+  // has to be rebuilt from scratch (trimmed front, changed bin count)
+  struct CurveSketch
+  {
+    HistogramSketch sketch;
+    size_t samples_fed = 0;
+    double front_time = 0;
+  };
+
+  // feed the sketch with the samples appended since the last call, or
+  // rebuild it entirely when the series was trimmed or the bins changed
+  void updateSketch(const std::string& curve_id, const PJ::PlotData& curve_data);
+
+  QWidget* _widget;
+  Ui::toolbox_histogram* ui;
+
+  QStringList _dragging_curves;
+
+  PJ::PlotWidgetBase* _plot_widget_A = nullptr;
+  PJ::PlotWidgetBase* _plot_widget_B = nullptr;
+
+  PJ::PlotDataMapRef* _plot_data = nullptr;
+  PJ::TransformsMap* _transforms = nullptr;
+
+  PJ::PlotDataMapRef _local_data;
+
+  Range _zoom_range;
+
+  std::vector<std::string> _curve_names;
+
+  std::map<std::string, CurveSketch> _sketches;
+
+  // debounces the recalculations triggered by zooming the preview
+  QTimer _recalc_timer;
+
+  // feeds newly streamed samples into the sketches while the toolbox is open
+  QTimer _refresh_timer;
+
+private slots:
+
+  void onDragEnterEvent(QDragEnterEvent* event);
+  void onDropEvent(QDropEvent* event);
+  void onViewResized(const QRectF& rect);
+  void onRefreshTimeout();
+  void onSaveCurve();
+  void calculateHistogram();
+  void onClearCurves();
+};
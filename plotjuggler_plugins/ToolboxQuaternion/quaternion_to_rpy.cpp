@@ -1,6 +1,65 @@
 #include "quaternion_to_rpy.h"
-#include <array>
 #include <math.h>
+#include <vector>
+
+namespace
+{
+constexpr size_t BATCH = 512;
+
+/** Convert up to BATCH quaternions (SoA layout) to roll/pitch/yaw.
+ *
+ * The quaternion algebra runs in plain loops over contiguous arrays so
+ * the compiler can vectorize them; atan2/asin stay libm calls, grouped
+ * in their own loops, so the angles match the old one-sample-at-a-time
+ * code instead of a lower-precision polynomial approximation.
+ */
+void ConvertBatch(const double* q_x, const double* q_y, const double* q_z, const double* q_w,
+                  double* roll, double* pitch, double* yaw, size_t count)
+{
+  double cos_roll[BATCH];
+  double sin_pitch[BATCH];
+  double cos_yaw[BATCH];
+
+  for (size_t n = 0; n < count; n++)
+  {
+    double x = q_x[n];
+    double y = q_y[n];
+    double z = q_z[n];
+    double w = q_w[n];
+
+    // 1/sqrt(1.0) is exactly 1.0, so normalizing unconditionally keeps
+    // the loop branch-free without changing already-normalized inputs
+    const double quat_norm2 = (w * w) + (x * x) + (y * y) + (z * z);
+    const double mult = 1.0 / std::sqrt(quat_norm2);
+    x *= mult;
+    y *= mult;
+    z *= mult;
+    w *= mult;
+
+    roll[n] = 2 * (w * x + y * z);
+    cos_roll[n] = 1 - 2 * (x * x + y * y);
+    sin_pitch[n] = 2 * (w * y - z * x);
+    yaw[n] = 2 * (w * z + x * y);
+    cos_yaw[n] = 1 - 2 * (y * y + z * z);
+  }
+  for (size_t n = 0; n < count; n++)
+  {
+    // roll (x-axis rotation)
+    roll[n] = std::atan2(roll[n], cos_roll[n]);
+  }
+  for (size_t n = 0; n < count; n++)
+  {
+    // pitch (y-axis rotation): use 90 degrees if out of range
+    const double sinp = sin_pitch[n];
+    pitch[n] = std::abs(sinp) >= 1 ? std::copysign(M_PI_2, sinp) : std::asin(sinp);
+  }
+  for (size_t n = 0; n < count; n++)
+  {
+    // yaw (z-axis rotation)
+    yaw[n] = std::atan2(yaw[n], cos_yaw[n]);
+  }
+}
+}  // namespace
 
 QuaternionToRollPitchYaw::QuaternionToRollPitchYaw()
 {
@@ -42,105 +101,85 @@ void QuaternionToRollPitchYaw::calculate()
   int pos = data_x.getIndexFromX(_last_timestamp);
   size_t index = pos < 0 ? 0 : static_cast<size_t>(pos);
 
+  std::vector<double> ts(BATCH);
+  std::vector<double> q_x(BATCH), q_y(BATCH), q_z(BATCH), q_w(BATCH);
+  std::vector<double> roll(BATCH), pitch(BATCH), yaw(BATCH);
+
   while (index < data_x.size())
   {
-    auto& point_x = data_x.at(index);
-    double timestamp = point_x.x;
-    double q_x = point_x.y;
-    double q_y = data_y.at(index).y;
-    double q_z = data_z.at(index).y;
-    double q_w = data_w.at(index).y;
-
-    if (timestamp > _last_timestamp)
+    // gather the samples newer than _last_timestamp into SoA scratch.
+    // The wrap logic is skipped on the very first sample of the series.
+    bool starts_at_first_sample = false;
+    size_t count = 0;
+    while (index < data_x.size() && count < BATCH)
     {
-      std::array<double, 3> RPY;
-      calculateNextPoint(index, { q_x, q_y, q_z, q_w }, RPY);
+      const auto& point_x = data_x.at(index);
+      if (point_x.x > _last_timestamp)
+      {
+        if (count == 0 && index == 0)
+        {
+          starts_at_first_sample = true;
+        }
+        ts[count] = point_x.x;
+        q_x[count] = point_x.y;
+        q_y[count] = data_y.at(index).y;
+        q_z[count] = data_z.at(index).y;
+        q_w[count] = data_w.at(index).y;
+        count++;
+        _last_timestamp = point_x.x;
+      }
+      index++;
+    }
 
-      data_roll.pushBack({ timestamp, _scale * (RPY[0] + _roll_offset) });
-      data_pitch.pushBack({ timestamp, _scale * (RPY[1] + _pitch_offset) });
-      data_yaw.pushBack({ timestamp, _scale * (RPY[2] + _yaw_offset) });
+    ConvertBatch(q_x.data(), q_y.data(), q_z.data(), q_w.data(),  //
+                 roll.data(), pitch.data(), yaw.data(), count);
 
-      _last_timestamp = timestamp;
+    for (size_t n = 0; n < count; n++)
+    {
+      if (_wrap && !(n == 0 && starts_at_first_sample))
+      {
+        applyWrap(roll[n], pitch[n], yaw[n]);
+      }
+      _prev_roll = roll[n];
+      _prev_pitch = pitch[n];
+      _prev_yaw = yaw[n];
+
+      data_roll.pushBack({ ts[n], _scale * (roll[n] + _roll_offset) });
+      data_pitch.pushBack({ ts[n], _scale * (pitch[n] + _pitch_offset) });
+      data_yaw.pushBack({ ts[n], _scale * (yaw[n] + _yaw_offset) });
     }
-    index++;
   }
 }
 
-void QuaternionToRollPitchYaw::calculateNextPoint(size_t index, const std::array<double, 4>& quat,
-                                                  std::array<double, 3>& rpy)
+void QuaternionToRollPitchYaw::applyWrap(double roll, double pitch, double yaw)
 {
-  double q_x = quat[0];
-  double q_y = quat[1];
-  double q_z = quat[2];
-  double q_w = quat[3];
+  const double WRAP_ANGLE = M_PI * 2.0;
+  const double WRAP_THRESHOLD = M_PI * 1.95;
 
-  double quat_norm2 = (q_w * q_w) + (q_x * q_x) + (q_y * q_y) + (q_z * q_z);
-  if (std::abs(quat_norm2 - 1.0) > std::numeric_limits<double>::epsilon())
+  if ((roll - _prev_roll) > WRAP_THRESHOLD)
   {
-    double mult = 1.0 / std::sqrt(quat_norm2);
-    q_x *= mult;
-    q_y *= mult;
-    q_z *= mult;
-    q_w *= mult;
+    _roll_offset -= WRAP_ANGLE;
   }
-  double roll, pitch, yaw;
-  // roll (x-axis rotation)
-  double sinr_cosp = 2 * (q_w * q_x + q_y * q_z);
-  double cosr_cosp = 1 - 2 * (q_x * q_x + q_y * q_y);
-  roll = std::atan2(sinr_cosp, cosr_cosp);
-
-  // pitch (y-axis rotation)
-  double sinp = 2 * (q_w * q_y - q_z * q_x);
-  if (std::abs(sinp) >= 1)
+  else if ((_prev_roll - roll) > WRAP_THRESHOLD)
   {
-    pitch = std::copysign(M_PI_2, sinp);  // use 90 degrees if out of range
+    _roll_offset += WRAP_ANGLE;
   }
-  else
+
+  if ((pitch - _prev_pitch) > WRAP_THRESHOLD)
   {
-    pitch = std::asin(sinp);
+    _pitch_offset -= WRAP_ANGLE;
   }
-  // yaw (z-axis rotation)
-  double siny_cosp = 2 * (q_w * q_z + q_x * q_y);
-  double cosy_cosp = 1 - 2 * (q_y * q_y + q_z * q_z);
-  yaw = std::atan2(siny_cosp, cosy_cosp);
-
-  const double WRAP_ANGLE = M_PI * 2.0;
-  const double WRAP_THRESHOLD = M_PI * 1.95;
-
-  //--------- wrap ------
-  if (index != 0 && _wrap)
+  else if ((_prev_pitch - pitch) > WRAP_THRESHOLD)
   {
-    if ((roll - _prev_roll) > WRAP_THRESHOLD)
-    {
-      _roll_offset -= WRAP_ANGLE;
-    }
-    else if ((_prev_roll - roll) > WRAP_THRESHOLD)
-    {
-      _roll_offset += WRAP_ANGLE;
-    }
-
-    if ((pitch - _prev_pitch) > WRAP_THRESHOLD)
-    {
-      _pitch_offset -= WRAP_ANGLE;
-    }
-    else if ((_prev_pitch - pitch) > WRAP_THRESHOLD)
-    {
-      _pitch_offset += WRAP_ANGLE;
-    }
-
-    if ((yaw - _prev_yaw) > WRAP_THRESHOLD)
-    {
-      _yaw_offset -= WRAP_ANGLE;
-    }
-    else if ((_prev_yaw - yaw) > WRAP_THRESHOLD)
-    {
-      _yaw_offset += WRAP_ANGLE;
-    }
+    _pitch_offset += WRAP_ANGLE;
   }
 
-  _prev_pitch = pitch;
-  _prev_roll = roll;
-  _prev_yaw = yaw;
-
-  rpy = { roll, pitch, yaw };
+  if ((yaw - _prev_yaw) > WRAP_THRESHOLD)
+  {
+    _yaw_offset -= WRAP_ANGLE;
+  }
+  else if ((_prev_yaw - yaw) > WRAP_THRESHOLD)
+  {
+    _yaw_offset += WRAP_ANGLE;
+  }
 }
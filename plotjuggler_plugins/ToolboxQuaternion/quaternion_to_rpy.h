@@ -37,10 +37,9 @@ public:
 
   void calculate() override;
 
-  void calculateNextPoint(size_t index, const std::array<double, 4>& quat,
-                          std::array<double, 3>& rpy);
-
 private:
+  void applyWrap(double roll, double pitch, double yaw);
+
   double _prev_roll = 0;
   double _prev_yaw = 0;
   double _prev_pitch = 0;
@@ -12,6 +12,7 @@
 #include <QPixmap>
 #include <QImage>
 #include <QProgressDialog>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include "PlotJuggler/svg_util.h"
 
@@ -81,6 +82,38 @@ VideoDialog::VideoDialog(QWidget* parent) : QDialog(parent), ui(new Ui::VideoDia
   QString theme = settings.value("Preferences::theme", "light").toString();
   ui->clearButton->setIcon(LoadSvg(":/resources/svg/trash.svg", theme));
 
+  // Prefer the hardware decoders of the platform: 4K footage decoded in
+  // software pegs two cores and drops frames while scrubbing. The
+  // software "FFmpeg" decoder stays last in the list, so unsupported
+  // codecs (or missing drivers) fall back to the old path per file.
+  // ZeroCopy keeps the decoded surfaces GPU-resident: the renderer
+  // blits them without a round trip through system memory.
+  // Set "VideoDialog.hwDecode" to false to force software decoding.
+  if (settings.value("VideoDialog.hwDecode", true).toBool())
+  {
+#if defined(Q_OS_WIN)
+    const QStringList decoders = { "DXVA", "CUDA", "FFmpeg" };
+#elif defined(Q_OS_MAC)
+    const QStringList decoders = { "VideoToolbox", "FFmpeg" };
+#else
+    // VAAPI covers Intel and AMD; "CUDA" is how QtAV names NVDEC
+    const QStringList decoders = { "VAAPI", "CUDA", "FFmpeg" };
+#endif
+    _media_player->setVideoDecoderPriority(decoders);
+
+    QVariantHash decoder_options;
+    for (const QString& name : decoders)
+    {
+      if (name != QLatin1String("FFmpeg"))
+      {
+        QVariantHash options;
+        options["copyMode"] = "ZeroCopy";
+        decoder_options[name.toLower()] = options;
+      }
+    }
+    _media_player->setOptionsForVideoCodec(decoder_options);
+  }
+
   _label = new ImageLabel(this);
   ui->verticalLayoutMain->addWidget(_label, 1.0);
   _label->setHidden(true);
@@ -88,9 +121,88 @@ VideoDialog::VideoDialog(QWidget* parent) : QDialog(parent), ui(new Ui::VideoDia
 
 VideoDialog::~VideoDialog()
 {
+  stopPrefetch();
   delete ui;
 }
 
+QImage VideoDialog::decodeFrame(int num) const
+{
+  const auto& frame = _compressed_frames[num];
+  qoi_desc info = frame.info;
+  void* data = qoi_decode(frame.data, frame.length, &info, 3);
+  if (!data)
+  {
+    return {};
+  }
+  // the QImage takes ownership of the decoded buffer
+  return QImage(static_cast<uchar*>(data), info.width, info.height, info.width * 3,
+                QImage::Format_RGB888, [](void* ptr) { free(ptr); }, data);
+}
+
+void VideoDialog::prefetchAround(int num)
+{
+  _cache_center = num;
+  if (_prefetch_future.isRunning())
+  {
+    // the worker re-reads _cache_center before every decode
+    return;
+  }
+  _prefetch_future = QtConcurrent::run([this]() {
+    while (true)
+    {
+      const int center = _cache_center.load();
+      if (center < 0)
+      {
+        return;
+      }
+      int missing = -1;
+      {
+        std::lock_guard<std::mutex> lock(_cache_mutex);
+        // nearest uncached frame in the window, preferring the ones ahead
+        for (int offset = 0; offset <= std::max(PREFETCH_AHEAD, PREFETCH_BEHIND); offset++)
+        {
+          const int ahead = center + offset;
+          if (offset <= PREFETCH_AHEAD && ahead < int(_compressed_frames.size()) &&
+              _frame_cache.count(ahead) == 0)
+          {
+            missing = ahead;
+            break;
+          }
+          const int behind = center - offset;
+          if (offset > 0 && offset <= PREFETCH_BEHIND && behind >= 0 &&
+              _frame_cache.count(behind) == 0)
+          {
+            missing = behind;
+            break;
+          }
+        }
+        if (missing < 0)
+        {
+          // window fully cached: drop the frames we scrubbed away from
+          for (auto it = _frame_cache.begin(); it != _frame_cache.end();)
+          {
+            const bool outside = it->first < center - 2 * PREFETCH_BEHIND ||
+                                 it->first > center + 2 * PREFETCH_AHEAD;
+            it = outside ? _frame_cache.erase(it) : std::next(it);
+          }
+          return;
+        }
+      }
+      QImage image = decodeFrame(missing);
+      std::lock_guard<std::mutex> lock(_cache_mutex);
+      _frame_cache[missing] = std::move(image);
+    }
+  });
+}
+
+void VideoDialog::stopPrefetch()
+{
+  _cache_center = -1;
+  _prefetch_future.waitForFinished();
+  std::lock_guard<std::mutex> lock(_cache_mutex);
+  _frame_cache.clear();
+}
+
 bool VideoDialog::loadFile(QString filename)
 {
   if (!filename.isEmpty() && QFileInfo::exists(filename))
@@ -101,6 +213,7 @@ bool VideoDialog::loadFile(QString filename)
 
     _frame_reader = std::make_unique<QtAV::FrameReader>();
     _frame_reader->setMedia(filename);
+    stopPrefetch();
     _compressed_frames.clear();
     ui->decodeButton->setEnabled(true);
 
@@ -190,17 +303,27 @@ void VideoDialog::on_timeSlider_valueChanged(int num)
     num = std::max(0, num);
     num = std::min(int(_compressed_frames.size() - 1), num);
 
-    auto& frame = _compressed_frames[num];
-    void* data = qoi_decode(frame.data, frame.length, &frame.info, 3);
-    QImage image(static_cast<uchar*>(data), frame.info.width, frame.info.height,
-                 QImage::Format_RGB888);
-
-    // qDebug() << "ratio: " << double(3*frame.info.width*frame.info.height) /
-    // double(frame.length);
+    QImage image;
+    {
+      std::lock_guard<std::mutex> lock(_cache_mutex);
+      auto it = _frame_cache.find(num);
+      if (it != _frame_cache.end())
+      {
+        image = it->second;
+      }
+    }
+    if (image.isNull())
+    {
+      // cold cache (first move, or scrubbing faster than the worker)
+      image = decodeFrame(num);
+      std::lock_guard<std::mutex> lock(_cache_mutex);
+      _frame_cache[num] = image;
+    }
 
     _label->setPixmap(QPixmap::fromImage(image));
     _label->repaint();
-    free(data);
+
+    prefetchAround(num);
   }
   else
   {
@@ -283,6 +406,7 @@ void VideoDialog::on_clearButton_clicked()
   _decoded = false;
   _video_output->widget()->setHidden(false);
   _label->setHidden(true);
+  stopPrefetch();
   _compressed_frames.clear();
 }
 
@@ -1,12 +1,16 @@
 #ifndef VIDEO_DIALOG_H
 #define VIDEO_DIALOG_H
 
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <QDialog>
 #include <QtAV>
 #include <QSlider>
 #include <QPushButton>
 #include <QCloseEvent>
+#include <QFuture>
 #include <QtAV/FrameReader.h>
 #include "ui_video_dialog.h"
 
@@ -112,6 +116,21 @@ private:
   ImageLabel* _label;
 
   bool _decoded = false;
+
+  // Decode-ahead cache: a background worker keeps a window of decoded
+  // frames around the tracker position, so scrubbing synchronized video
+  // does not pay one qoi_decode per tracker move.
+  static constexpr int PREFETCH_BEHIND = 8;
+  static constexpr int PREFETCH_AHEAD = 24;
+
+  QImage decodeFrame(int num) const;
+  void prefetchAround(int num);
+  void stopPrefetch();
+
+  std::map<int, QImage> _frame_cache;
+  std::mutex _cache_mutex;
+  std::atomic<int> _cache_center{ -1 };
+  QFuture<void> _prefetch_future;
 };
 
 #endif  // VIDEO_DIALOG_H